@@ -225,9 +225,58 @@ typedef struct TAOS_STMT2_BINDV {
   TAOS_STMT2_BIND **bind_cols;
 } TAOS_STMT2_BINDV;
 
+// Arrow C data interface, see https://arrow.apache.org/docs/format/CDataInterface.html
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE           2
+#define ARROW_FLAG_MAP_KEYS_SORTED    4
+
+struct ArrowSchema {
+  const char          *format;
+  const char          *name;
+  const char          *metadata;
+  int64_t              flags;
+  int64_t              n_children;
+  struct ArrowSchema **children;
+  struct ArrowSchema  *dictionary;
+  void (*release)(struct ArrowSchema *);
+  void *private_data;
+};
+
+struct ArrowArray {
+  int64_t             length;
+  int64_t             null_count;
+  int64_t             offset;
+  int64_t             n_buffers;
+  int64_t             n_children;
+  const void        **buffers;
+  struct ArrowArray **children;
+  struct ArrowArray  *dictionary;
+  void (*release)(struct ArrowArray *);
+  void *private_data;
+};
+
+#endif  // ARROW_C_DATA_INTERFACE
+
+/*
+ * Columnar bind of many child tables at once. `schema` is a struct schema whose children describe the bound
+ * columns in order, `arrays[i]` is the struct array holding the rows of `tbnames[i]`. The arrays are only read
+ * during the call and are never released by the client.
+ */
+typedef struct TAOS_STMT2_ARROW_BINDV {
+  int                  count;
+  char               **tbnames;
+  TAOS_STMT2_BIND    **tags;
+  struct ArrowSchema  *schema;
+  struct ArrowArray  **arrays;
+} TAOS_STMT2_ARROW_BINDV;
+
 DLL_EXPORT TAOS_STMT2 *taos_stmt2_init(TAOS *taos, TAOS_STMT2_OPTION *option);
 DLL_EXPORT int         taos_stmt2_prepare(TAOS_STMT2 *stmt, const char *sql, unsigned long length);
 DLL_EXPORT int         taos_stmt2_bind_param(TAOS_STMT2 *stmt, TAOS_STMT2_BINDV *bindv, int32_t col_idx);
+DLL_EXPORT int         taos_stmt2_bind_arrow(TAOS_STMT2 *stmt, TAOS_STMT2_ARROW_BINDV *bindv);
 DLL_EXPORT int         taos_stmt2_exec(TAOS_STMT2 *stmt, int *affected_rows);
 DLL_EXPORT int         taos_stmt2_close(TAOS_STMT2 *stmt);
 DLL_EXPORT int         taos_stmt2_is_insert(TAOS_STMT2 *stmt, int *insert);
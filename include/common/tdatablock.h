@@ -229,6 +229,10 @@ double blockDataGetSerialRowSize(const SSDataBlock* pBlock);
 size_t blockDataGetSerialMetaSize(uint32_t numOfCols);
 
 int32_t blockDataSort(SSDataBlock* pDataBlock, SArray* pOrderInfo);
+/**
+ * @brief copy the rows of pSrc into pDst, which has the same columns, so that the index[i]-th row becomes the i-th row.
+ */
+int32_t blockDataGather(SSDataBlock* pDst, const SSDataBlock* pSrc, const int32_t* index);
 /**
  * @brief find how many rows already in order start from first row
  */
@@ -269,6 +273,15 @@ int32_t blockGetEncodeSize(const SSDataBlock* pBlock);
 int32_t blockEncode(const SSDataBlock* pBlock, char* data, int32_t numOfCols);
 int32_t blockDecode(SSDataBlock* pBlock, const char* pData, const char** pEndPos);
 
+// the compression of the encoded blocks in a fetch response, requested by the compress field of the query message
+#define BLOCK_COMPRESS_NONE     0
+#define BLOCK_COMPRESS_LZ4      1
+#define BLOCK_COMPRESS_COLUMNAR 2
+
+// returns the compressed length, the block is not compressed if it is not less than rawLen
+int32_t blockCompressEncoded(int8_t compressType, const char* pEncoded, int32_t rawLen, char* pOut, int32_t outLen);
+int32_t blockDecompressEncoded(int8_t compressType, const char* pIn, int32_t compLen, char* pOut, int32_t rawLen);
+
 // for debug
 int32_t dumpBlockData(SSDataBlock* pDataBlock, const char* flag, char** dumpBuf, const char* taskIdStr);
 
@@ -161,12 +161,16 @@ extern int32_t tsCacheLazyLoadThreshold;  // cost threshold for last/last_row lo
 extern int32_t tsQueryPolicy;
 extern bool    tsQueryTbNotExistAsEmpty;
 extern int32_t tsQueryRspPolicy;
+extern int32_t tsQueryResultCacheSize;
+extern int32_t tsQueryTaskMemBudget;
+extern int32_t tsQueryNodeMemBudget;
 extern int64_t tsQueryMaxConcurrentTables;
 extern int32_t tsQuerySmaOptimize;
 extern int32_t tsQueryRsmaTolerance;
 extern bool    tsQueryPlannerTrace;
 extern int32_t tsQueryNodeChunkSize;
 extern bool    tsQueryUseNodeAllocator;
+extern int32_t tsQueryMaxFollowerLag;
 extern bool    tsKeepColumnName;
 extern bool    tsEnableQueryHb;
 extern bool    tsEnableScience;
@@ -190,6 +194,13 @@ extern bool    tsMultiResultFunctionStarReturnTags;
 extern int32_t tsMinSlidingTime;
 extern int32_t tsMinIntervalTime;
 extern int32_t tsMaxInsertBatchRows;
+extern int32_t tsInsertFileParseThreads;
+extern int32_t tsQuerySyntaxCacheSize;
+extern bool    tsStmtPlanCache;
+extern bool    tsQueryColumnarCompress;
+extern int32_t tsQueryVnodeParallelism;
+extern int32_t tsQueryPartTableShardSize;
+extern bool    tsQueryLowLatency;
 
 // build info
 extern char version[];
@@ -221,6 +232,7 @@ extern char tsSmlChildTableName[];
 extern char tsSmlAutoChildTableNameDelimiter[];
 extern char tsSmlTagName[];
 extern bool tsSmlDot2Underline;
+extern int32_t tsSmlParseThreads;
 extern char tsSmlTsDefaultName[];
 // extern bool    tsSmlDataFormat;
 // extern int32_t tsSmlBatchSize;
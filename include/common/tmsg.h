@@ -1693,6 +1693,9 @@ typedef struct {
   int64_t numOfBatchInsertReqs;
   int64_t numOfBatchInsertSuccessReqs;
   int64_t errors;
+  int64_t resCacheHit;
+  int64_t resCacheMiss;
+  int64_t resCacheSize;
 } SVnodesStat;
 
 typedef struct {
@@ -1716,6 +1719,9 @@ typedef struct {
   int64_t numOfBatchInsertSuccessReqs;
   int32_t numOfCachedTables;
   int32_t learnerProgress;  // use one reservered
+  int64_t resCacheHit;      // the result cache fields are reported to the monitor only, they are not in the status
+  int64_t resCacheMiss;
+  int64_t resCacheSize;
 } SVnodeLoad;
 
 typedef struct {
@@ -2218,6 +2224,13 @@ typedef struct {
 
 #define PAYLOAD_PREFIX_LEN ((sizeof(int32_t)) << 1)
 
+// The peak memory of the fetched task and its sources follows the data of a fetch rsp as a trailer, only if the
+// fetch req asks for it by withPeakMem. The fixed part of the rsp keeps its layout for older versions.
+#define FETCH_RSP_PEAK_MEM_LEN ((int32_t)sizeof(int64_t))
+
+void    tPutFetchRspPeakMem(SRetrieveTableRsp* pRsp, int32_t dataLen, int64_t peakMem);
+int64_t tGetFetchRspPeakMem(const SRetrieveTableRsp* pRsp, int32_t dataLen, int32_t msgLen);
+
 #define SET_PAYLOAD_LEN(_p, _compLen, _fullLen) \
   do {                                          \
     ((int32_t*)(_p))[0] = (_compLen);           \
@@ -2601,10 +2614,14 @@ typedef struct SSubQueryMsg {
   char*    sql;
   uint32_t msgLen;
   char*    msg;
+  int32_t  maxFollowerLag;  // -1: only leader can execute the task
+  int8_t   lowLatency;      // hand the first rows to the consumer at once instead of filling the sink
 } SSubQueryMsg;
 
 int32_t tSerializeSSubQueryMsg(void* buf, int32_t bufLen, SSubQueryMsg* pReq);
 int32_t tDeserializeSSubQueryMsg(void* buf, int32_t bufLen, SSubQueryMsg* pReq);
+// all fields but the sql and the plan, which are skipped and left NULL, nothing is to be freed
+int32_t tDeserializeSSubQueryMsgHead(void* buf, int32_t bufLen, SSubQueryMsg* pReq);
 void    tFreeSSubQueryMsg(SSubQueryMsg* pReq);
 
 typedef struct {
@@ -2655,6 +2672,10 @@ typedef struct {
   uint64_t        taskId;
   int32_t         execId;
   SOperatorParam* pOpParam;
+  int32_t         credit;  // max blocks in the fetch rsp, 0: decided by the worker
+  int8_t          hasRuntimeRange;
+  STimeWindow     runtimeRange;  // primary timestamp range the consumer still needs, pushed down by a join
+  int8_t          withPeakMem;   // the rsp carries the peak memory trailer, see FETCH_RSP_PEAK_MEM_LEN
 } SResFetchReq;
 
 int32_t tSerializeSResFetchReq(void* buf, int32_t bufLen, SResFetchReq* pReq);
@@ -3291,6 +3312,7 @@ typedef struct {
   char     fqdn[TSDB_FQDN_LEN];
   int32_t  subPlanNum;
   SArray*  subDesc;  // SArray<SQuerySubDesc>
+  int64_t  peakMem;  // peak memory of the query reported by the fetched tasks, encoded after the whole batch
 } SQueryDesc;
 
 typedef struct {
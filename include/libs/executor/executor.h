@@ -131,6 +131,8 @@ bool   qIsDynamicExecTask(qTaskInfo_t tinfo);
 
 void   qUpdateOperatorParam(qTaskInfo_t tinfo, void* pParam);
 
+void   qDestroyOperatorParam(void* pParam);
+
 /**
  * Create the exec task object according to task json
  * @param readHandle
@@ -144,6 +146,18 @@ int32_t qCreateExecTask(SReadHandle* readHandle, int32_t vgId, uint64_t taskId,
                         qTaskInfo_t* pTaskInfo, DataSinkHandle* handle, int8_t compressResult, char* sql,
                         EOPTR_EXEC_MODEL model);
 
+/**
+ * Create only the data sink of a subplan whose result is not produced by an exec task, e.g. replayed from a cache.
+ * Only the dispatch sink of a query is supported.
+ * @param readHandle
+ * @param pSubplan
+ * @param handle
+ * @param compressResult
+ * @return
+ */
+int32_t qCreateExecSink(SReadHandle* readHandle, struct SSubplan* pSubplan, DataSinkHandle* handle,
+                        int8_t compressResult);
+
 /**
  *
  * @param tinfo
@@ -181,6 +195,37 @@ int32_t qKillTask(qTaskInfo_t tinfo, int32_t rspCode);
 
 bool qTaskIsExecuting(qTaskInfo_t qinfo);
 
+/**
+ * the peak memory of the buffers kept by the task, including the peaks reported by the sources of its exchange
+ * operators
+ * @param tinfo
+ * @return
+ */
+int64_t qGetTaskPeakMem(qTaskInfo_t tinfo);
+
+/**
+ * narrow the primary timestamp range scanned by the task, as requested by its consumer, e.g. a join which knows the
+ * range of its build side, it is ignored unless the root of the task is a table scan
+ * @param tinfo
+ * @param pWin
+ * @return
+ */
+int32_t qUpdateTaskRuntimeRange(qTaskInfo_t tinfo, const STimeWindow* pWin);
+
+/**
+ * return the first rows of the task as soon as they exist, the rows returned by each execution then double until
+ * the usual batch size is reached. It must be called before the task is executed.
+ * @param tinfo
+ */
+void qSetTaskLowLatency(qTaskInfo_t tinfo);
+
+/**
+ * the memory of the buffers kept by all the query tasks of this node, and its limit, which is 0 if unlimited
+ * @param pUsed
+ * @param pLimit
+ */
+void qGetQueryMemUsage(int64_t* pUsed, int64_t* pLimit);
+
 /**
  * destroy query info structure
  * @param qHandle
@@ -189,6 +189,8 @@ typedef struct TsdReader {
 
   void         (*tsdSetFilesetDelimited)(void* pReader);
   void         (*tsdSetSetNotifyCb)(void* pReader, TsdReaderNotifyCbFn notifyFn, void* param);
+  int32_t      (*tsdGetHistoryDataVer)(void* pVnode, const STimeWindow* pWindow, int64_t* pVer);
+  void         (*tsdSetRuntimeRange)(void* pReader, const STimeWindow* pWindow);
 } TsdReader;
 
 typedef struct SStoreCacheReader {
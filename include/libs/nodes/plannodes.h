@@ -128,6 +128,8 @@ typedef struct SScanLogicNode {
   bool          paraTablesSort; // for table merge scan
   bool          smallDataTsSort; // disable row id sort for table merge scan
   bool          needSplit;
+  int32_t       tableSplitIdx;  // scan only the tables with uid % tableSplitNum == tableSplitIdx
+  int32_t       tableSplitNum;
 } SScanLogicNode;
 
 typedef struct SJoinLogicNode {
@@ -154,6 +156,7 @@ typedef struct SJoinLogicNode {
   bool           grpJoin;
   bool           hashJoinHint;
   bool           batchScanHint;
+  SQueryStat     inputStat[2];     // estimated by the planner
 
   // FOR HASH JOIN
   int32_t        timeRangeTarget;  //table onCond filter
@@ -475,6 +478,8 @@ typedef struct STableScanPhysiNode {
   bool           needCountEmptyTable;
   bool           paraTablesSort;
   bool           smallDataTsSort;
+  int32_t        tableSplitIdx;
+  int32_t        tableSplitNum;
 } STableScanPhysiNode;
 
 typedef STableScanPhysiNode STableSeqScanPhysiNode;
@@ -543,6 +543,9 @@ typedef struct SVnodeModifyOpStmt {
   SArray*               pVgDataBlocks;       // SArray<SVgroupDataCxt*>
   SVCreateTbReq*        pCreateTblReq;
   TdFilePtr             fp;
+  int64_t               fileSize;       // size of the csv file, for progress reporting
+  int64_t               fileReadBytes;  // bytes of the csv file read so far
+  int64_t               fileStartTs;    // us, when the csv file was opened
   FFreeTableBlockHash   freeHashFunc;
   FFreeVgourpBlockArray freeArrayFunc;
   bool                  usingTableProcessing;
@@ -109,6 +109,10 @@ bool    qParseDbName(const char* pStr, size_t length, char** pDbName);
 
 // for async mode
 int32_t qParseSqlSyntax(SParseContext* pCxt, SQuery** pQuery, struct SCatalogReq* pCatalogReq);
+// The syntax tree of a plain query can be cloned and reused for later requests of the same sql text and database,
+// qCloneSqlSyntax rebuilds the query and the catalog request from such a tree without parsing the sql again.
+bool    qIsReusableSqlSyntax(const SQuery* pQuery);
+int32_t qCloneSqlSyntax(SParseContext* pCxt, const SNode* pRoot, SQuery** pQuery, struct SCatalogReq* pCatalogReq);
 int32_t qAnalyseSqlSemantic(SParseContext* pCxt, const struct SCatalogReq* pCatalogReq,
                             const struct SMetaData* pMetaData, SQuery* pQuery);
 int32_t qContinueParseSql(SParseContext* pCxt, struct SCatalogReq* pCatalogReq, const struct SMetaData* pMetaData,
@@ -152,6 +156,9 @@ int32_t qBindStmtTagsValue(void* pBlock, void* boundTags, int64_t suid, const ch
                            TAOS_MULTI_BIND* bind, char* msgBuf, int32_t msgBufLen);
 
 int32_t qStmtBindParams2(SQuery* pQuery, TAOS_STMT2_BIND* pParams, int32_t colIdx);
+// whether the physical plan of the translated query only depends on the placeholder values through the filter
+// conditions, so that it can be rebuilt for other values with qBuildPlanFromTemplate
+bool    qStmtIsPlanReusable(const SQuery* pQuery);
 int32_t qBindStmtStbColsValue2(void* pBlock, SArray* pCols, TAOS_STMT2_BIND* bind, char* msgBuf, int32_t msgBufLen,
                                STSchema** pTSchema, SBindInfo2* pBindInfos);
 int32_t qBindStmtColsValue2(void* pBlock, SArray* pCols, TAOS_STMT2_BIND* bind, char* msgBuf, int32_t msgBufLen);
@@ -46,6 +46,8 @@ typedef struct SPlanContext {
   int64_t     allocatorId;
   bool        destHasPrimaryKey;
   bool        sourceHasPrimaryKey;
+  int32_t     vnodeParallelism;    // read once by qCreateQueryPlan, the option may change while planning
+  int32_t     partTableShardSize;  // as vnodeParallelism
 } SPlanContext;
 
 // Create the physical plan for the query, according to the AST.
@@ -72,6 +74,16 @@ SQueryPlan* qStringToQueryPlan(const char* pStr);
 
 void qDestroyQueryPlan(SQueryPlan* pPlan);
 
+// Plan of a parameterized query saved for later executions, only the placeholder values are rebound on rebuild.
+typedef struct SPlanTemplate SPlanTemplate;
+
+// *pTemplate is NULL if the plan can not be rebuilt for other placeholder values, e.g. a value was folded by the
+// planner. The SValueNode of @pPlaceholderValues are the bound values, in placeholder order.
+int32_t qCreatePlanTemplate(const SQueryPlan* pPlan, int32_t placeholderNum, SPlanTemplate** pTemplate);
+int32_t qBuildPlanFromTemplate(const SPlanTemplate* pTemplate, uint64_t queryId, const SArray* pPlaceholderValues,
+                               SQueryPlan** pPlan);
+void    qDestroyPlanTemplate(SPlanTemplate* pTemplate);
+
 #ifdef __cplusplus
 }
 #endif
@@ -391,6 +391,8 @@ void* getTaskPoolWorkerCb();
    (_type) == TDMT_MND_DROP_STB || (_type) == TDMT_MND_CREATE_VIEW || (_type) == TDMT_MND_DROP_VIEW ||     \
    (_type) == TDMT_MND_CREATE_TSMA || (_type) == TDMT_MND_DROP_TSMA || (_type) == TDMT_MND_DROP_TB_WITH_TSMA)
 
+#define QUERY_ADMISSION_RETRY_ERROR(_code) ((_code) == TSDB_CODE_QRY_MEMORY_PRESSURE)
+
 #define NEED_SCHEDULER_REDIRECT_ERROR(_code)                                              \
   (SYNC_UNKNOWN_LEADER_REDIRECT_ERROR(_code) || SYNC_SELF_LEADER_REDIRECT_ERROR(_code) || \
    SYNC_OTHER_LEADER_REDIRECT_ERROR(_code))
@@ -49,6 +49,11 @@ typedef struct {
   uint64_t hbProcessed;
   uint64_t deleteProcessed;
 
+  uint64_t resCacheHit;
+  uint64_t resCacheMiss;
+  uint64_t memRejected;
+  uint64_t resCacheSize;
+
   uint64_t numOfQueryInQueue;
   uint64_t numOfFetchInQueue;
   uint64_t timeInQueryQueue;
@@ -61,7 +66,13 @@ typedef struct SQWMsgInfo {
   int8_t taskType;
   int8_t explain;
   int8_t needFetch;
-  int8_t compressMsg;
+  int8_t  compressMsg;
+  int32_t fetchCredit;
+  int8_t      hasRuntimeRange;
+  STimeWindow runtimeRange;
+  int8_t      fetchPeakMem;
+  int8_t      lowLatency;
+  int32_t     maxFollowerLag;
 } SQWMsgInfo;
 
 typedef struct SQWMsg {
@@ -81,6 +92,11 @@ int32_t qWorkerAbortPreprocessQueryMsg(void *qWorkerMgmt, SRpcMsg *pMsg);
 
 int32_t qWorkerPreprocessQueryMsg(void *qWorkerMgmt, SRpcMsg *pMsg, bool chkGrant);
 
+int32_t qWorkerGetQueryMaxFollowerLag(SRpcMsg *pMsg, int32_t *pMaxLag);
+
+// whether the task a fetch is for was admitted on this node as a follower read, its results are kept here
+int32_t qWorkerIsFollowerFetch(void *qWorkerMgmt, SRpcMsg *pMsg, bool *pFollower);
+
 int32_t qWorkerProcessQueryMsg(void *node, void *qWorkerMgmt, SRpcMsg *pMsg, int64_t ts);
 
 int32_t qWorkerProcessCQueryMsg(void *node, void *qWorkerMgmt, SRpcMsg *pMsg, int64_t ts);
@@ -105,6 +121,9 @@ void qWorkerDestroy(void **qWorkerMgmt);
 
 int32_t qWorkerGetStat(SReadHandle *handle, void *qWorkerMgmt, SQWorkerStat *pStat);
 
+// only the result cache part of qWorkerGetStat, it takes no lock and reads no queue of the node
+void qWorkerGetResCacheStat(void *qWorkerMgmt, SQWorkerStat *pStat);
+
 int32_t qWorkerProcessLocalQuery(void *pMgmt, uint64_t sId, uint64_t qId, uint64_t tId, int64_t rId, int32_t eId,
                                  SQWMsg *qwMsg, SArray *explainRes);
 
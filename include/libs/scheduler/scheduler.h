@@ -80,6 +80,8 @@ void schedulerFetchRowsA(int64_t job, schedulerFetchFp fp, void* param);
 
 int32_t schedulerGetTasksStatus(int64_t job, SArray* pSub);
 
+int64_t schedulerGetJobPeakMem(int64_t jobId);
+
 void schedulerStopQueryHb(void* pTrans);
 
 int32_t schedulerUpdatePolicy(int32_t policy);
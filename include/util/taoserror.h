@@ -616,6 +616,7 @@ int32_t  taosGetErrSize();
 #define TSDB_CODE_QRY_FILTER_WRONG_OPTR_TYPE    TAOS_DEF_ERROR_CODE(0, 0x0735)
 #define TSDB_CODE_QRY_FILTER_RANGE_ERROR        TAOS_DEF_ERROR_CODE(0, 0x0736)
 #define TSDB_CODE_QRY_FILTER_INVALID_TYPE       TAOS_DEF_ERROR_CODE(0, 0x0737)
+#define TSDB_CODE_QRY_MEMORY_PRESSURE           TAOS_DEF_ERROR_CODE(0, 0x0738)
 
 // grant
 #define TSDB_CODE_GRANT_EXPIRED                 TAOS_DEF_ERROR_CODE(0, 0x0800)
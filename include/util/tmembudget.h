@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _TD_UTIL_MEMBUDGET_H_
+#define _TD_UTIL_MEMBUDGET_H_
+
+#include "os.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Memory accountant shared by the buffers of one owner (e.g. a query task). A budget may have a parent, every
+ * acquire/release is applied to the whole chain, so the parent sees the usage of all its children.
+ * A limit less than or equal to 0 means unlimited.
+ */
+typedef struct SMemBudget SMemBudget;
+struct SMemBudget {
+  int64_t     limit;
+  int64_t     used;
+  int64_t     peak;
+  SMemBudget *pParent;
+};
+
+void memBudgetInit(SMemBudget *pBudget, int64_t limit, SMemBudget *pParent);
+
+/**
+ * acquire size bytes only if neither the budget nor any of its parents exceeds its limit afterwards
+ * @param pBudget
+ * @param size
+ * @return false if the memory should not be allocated, the caller is expected to spill instead
+ */
+bool memBudgetTryAcquire(SMemBudget *pBudget, int64_t size);
+
+/**
+ * acquire size bytes unconditionally, for memory that can not be spilled
+ * @param pBudget
+ * @param size
+ */
+void memBudgetAcquire(SMemBudget *pBudget, int64_t size);
+
+void memBudgetRelease(SMemBudget *pBudget, int64_t size);
+
+int64_t memBudgetGetUsed(const SMemBudget *pBudget);
+int64_t memBudgetGetPeak(const SMemBudget *pBudget);
+
+/**
+ * the usage ratio of the budget, 0 for an unlimited budget
+ * @param pBudget
+ * @return
+ */
+double memBudgetGetUsage(const SMemBudget *pBudget);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // _TD_UTIL_MEMBUDGET_H_
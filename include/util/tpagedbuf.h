@@ -19,6 +19,7 @@
 #include "thash.h"
 #include "tlist.h"
 #include "tlockfree.h"
+#include "tmembudget.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -151,6 +152,14 @@ void setBufPageDirty(void* pPage, bool dirty);
  */
 int32_t setBufPageCompressOnDisk(SDiskbasedBuf* pBuf, bool comp);
 
+/**
+ * Charge the in-memory pages to the given budget, pages are flushed to disk once the budget is used up, even though
+ * the in-memory page limit is not reached yet.
+ * @param pBuf
+ * @param pBudget
+ */
+void setBufPageMemBudget(SDiskbasedBuf* pBuf, SMemBudget* pBudget);
+
 /**
  * Set the pageId page buffer is not need
  * @param pBuf
@@ -165,6 +165,7 @@ typedef struct STscObj {
   int32_t        authVer;
   SAppInstInfo*  pAppInfo;
   SHashObj*      pRequests;
+  SHashObj*      pSyntaxCache;  // sql text -> parsed syntax tree of the plain queries, see querySyntaxCacheSize
   SPassInfo      passInfo;
   SWhiteListInfo whiteListInfo;
   STscNotifyInfo userDroppedInfo;
@@ -276,6 +277,7 @@ typedef struct SRequestObj {
   int64_t              allocatorRefId;
   SQuery*              pQuery;
   void*                pPostPlan;
+  SQueryPlan*          pPreparedPlan;  // plan built before the execution, e.g. from the stmt2 plan cache
   SReqRelInfo          relation;
   void*                pWrapper;
   SMetaData            parseMeta;
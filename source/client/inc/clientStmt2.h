@@ -86,6 +86,34 @@ STableDataCxt *pCurrBlock;
 SSubmitTbData *pCurrTbData;
 } SStmtExecInfo;
 */
+typedef struct SStmtPlanTableVer {
+  SName    name;
+  uint64_t uid;
+  int32_t  sversion;
+  int32_t  tversion;
+} SStmtPlanTableVer;
+
+typedef struct SStmtPlanDbVer {
+  char    dbFName[TSDB_DB_FNAME_LEN];
+  int64_t dbId;
+  int32_t vgVersion;
+} SStmtPlanDbVer;
+
+// physical plan of a query kept across executions, it is dropped once a table, vgroup or privilege version changes
+typedef struct SStmtPlanCache {
+  SPlanTemplate *pTemplate;
+  SArray        *pParamTypes;  // SArray<int8_t>, types of the bound values the plan was built with
+  SArray        *pTableVers;   // SArray<SStmtPlanTableVer>
+  SArray        *pDbVers;      // SArray<SStmtPlanDbVer>
+  int32_t        authVer;
+  SSchema       *pResSchema;
+  int32_t        numOfResCols;
+  int8_t         precision;
+  SArray        *pDbList;
+  SArray        *pTableList;
+  int64_t        hits;  // executions planned from the template
+} SStmtPlanCache;
+
 typedef struct {
   bool              stbInterlaceMode;
   STMT_TYPE         type;
@@ -101,6 +129,7 @@ typedef struct {
   bool              autoCreateTbl;
   SHashObj         *pVgHash;
   SBindInfo2       *pBindInfo;
+  SStmtPlanCache   *pPlanCache;
 
   SStbInterlaceInfo siInfo;
 } SStmtSQLInfo2;
@@ -220,6 +249,7 @@ int         stmtPrepare2(TAOS_STMT2 *stmt, const char *sql, unsigned long length
 int         stmtSetTbName2(TAOS_STMT2 *stmt, const char *tbName);
 int         stmtSetTbTags2(TAOS_STMT2 *stmt, TAOS_STMT2_BIND *tags);
 int         stmtBindBatch2(TAOS_STMT2 *stmt, TAOS_STMT2_BIND *bind, int32_t colIdx);
+int         stmtBindArrow2(TAOS_STMT2 *stmt, struct ArrowSchema *pSchema, struct ArrowArray *pArray);
 int         stmtGetTagFields2(TAOS_STMT2 *stmt, int *nums, TAOS_FIELD_E **fields);
 int         stmtGetColFields2(TAOS_STMT2 *stmt, int *nums, TAOS_FIELD_E **fields);
 int         stmtGetParamNum2(TAOS_STMT2 *stmt, int *nums);
@@ -464,6 +464,7 @@ void destroyTscObj(void *pObj) {
 
   destroyAllRequests(pTscObj->pRequests);
   taosHashCleanup(pTscObj->pRequests);
+  taosHashCleanup(pTscObj->pSyntaxCache);
 
   schedulerStopQueryHb(pTscObj->pAppInfo->pTransporter);
   tscDebug("connObj 0x%" PRIx64 " p:%p destroyed, remain inst totalConn:%" PRId64, pTscObj->id, pTscObj,
@@ -717,6 +718,7 @@ void doDestroyRequest(void *p) {
   taosMemoryFree(pRequest->body.interParam);
 
   qDestroyQuery(pRequest->pQuery);
+  qDestroyQueryPlan(pRequest->pPreparedPlan);
   nodesDestroyAllocator(pRequest->allocatorRefId);
 
   taosMemoryFreeClear(pRequest->effectiveUser);
@@ -661,6 +661,7 @@ int32_t hbBuildQueryDesc(SQueryHbReqBasic *hbBasic, STscObj *pObj) {
     desc.reqRid = pRequest->self;
     desc.stableQuery = pRequest->stableQuery;
     desc.isSubQuery = pRequest->isSubReq;
+    desc.peakMem = schedulerGetJobPeakMem(pRequest->body.queryJob);
     code = taosGetFqdn(desc.fqdn);
     if (TSDB_CODE_SUCCESS != code) {
       (void)releaseRequest(*rid);
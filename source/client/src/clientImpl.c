@@ -498,6 +498,11 @@ int32_t getQnodeList(SRequestObj* pRequest, SArray** pNodeList) {
 
 int32_t getPlan(SRequestObj* pRequest, SQuery* pQuery, SQueryPlan** pPlan, SArray* pNodeList) {
   pRequest->type = pQuery->msgType;
+  if (NULL != pRequest->pPreparedPlan) {
+    *pPlan = pRequest->pPreparedPlan;
+    pRequest->pPreparedPlan = NULL;
+    return TSDB_CODE_SUCCESS;
+  }
   SAppInstInfo* pAppInfo = getAppInfo(pRequest);
 
   SPlanContext cxt = {.queryId = pRequest->requestId,
@@ -1362,7 +1367,9 @@ static int32_t asyncExecSchQuery(SRequestObj* pRequest, SQuery* pQuery, SMetaDat
                         .pUser = pRequest->pTscObj->user,
                         .sysInfo = pRequest->pTscObj->sysInfo,
                         .allocatorId = pRequest->allocatorRefId};
-    if (TSDB_CODE_SUCCESS == code) {
+    if (TSDB_CODE_SUCCESS == code && NULL != pRequest->pPreparedPlan) {
+      TSWAP(pDag, pRequest->pPreparedPlan);
+    } else if (TSDB_CODE_SUCCESS == code) {
       code = qCreateQueryPlan(&cxt, &pDag, pMnodeList);
     }
     if (code) {
@@ -2517,13 +2524,9 @@ int32_t setQueryResultFromRsp(SReqResultInfo* pResultInfo, const SRetrieveTableR
     char* pStart = (char*)pRsp->data + sizeof(int32_t) * 2;
 
     if (pRsp->compressed && compLen < rawLen) {
-      int32_t len = tsDecompressString(pStart, compLen, 1, pResultInfo->decompBuf, rawLen, ONE_STAGE_COMP, NULL, 0);
-      if (len < 0) {
-        tscError("tsDecompressString failed");
-        return terrno ? terrno : TSDB_CODE_FAILED;
-      }
-      if (len != rawLen) {
-        tscError("tsDecompressString failed, len:%d != rawLen:%d", len, rawLen);
+      int32_t code = blockDecompressEncoded(pRsp->compressed, pStart, compLen, pResultInfo->decompBuf, rawLen);
+      if (code != TSDB_CODE_SUCCESS) {
+        tscError("failed to decompress the result, compress type:%d, code:%s", pRsp->compressed, tstrerror(code));
         return TSDB_CODE_TSC_INTERNAL_ERROR;
       }
       pResultInfo->pData = pResultInfo->decompBuf;
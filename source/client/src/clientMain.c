@@ -1251,6 +1251,102 @@ int32_t createParseContext(const SRequestObj *pRequest, SParseContext **pCxt, SS
   return TSDB_CODE_SUCCESS;
 }
 
+#define SYNTAX_CACHE_MAX_SQL_LEN 4096
+
+// key of the syntax cache: db '\0' biMode sql, the result is 0 if the request can not use the cache
+static int32_t buildSyntaxCacheKey(const SRequestObj *pRequest, int8_t biMode, char *pKey) {
+  if (NULL == pRequest->pTscObj->pSyntaxCache || tsQuerySyntaxCacheSize <= 0 || pRequest->parseOnly ||
+      pRequest->isStmtBind || pRequest->sqlLen > SYNTAX_CACHE_MAX_SQL_LEN) {
+    return 0;
+  }
+
+  int32_t len = 0;
+  if (NULL != pRequest->pDb) {
+    len = strlen(pRequest->pDb);
+    (void)memcpy(pKey, pRequest->pDb, len);
+  }
+  pKey[len++] = '\0';
+  pKey[len++] = biMode;
+  (void)memcpy(pKey + len, pRequest->sqlstr, pRequest->sqlLen);
+  return len + pRequest->sqlLen;
+}
+
+// querySyntaxCacheSize is a dynamic option, the entries of a connection are dropped once they are more than it allows,
+// e.g. after it is lowered or set to 0. Entries in use by other requests are freed when they are released.
+static void shrinkSyntaxCache(SHashObj *pCache) {
+  if (NULL == pCache || taosHashGetSize(pCache) <= TMAX(tsQuerySyntaxCacheSize, 0)) {
+    return;
+  }
+
+  void *pIter = taosHashIterate(pCache, NULL);
+  while (NULL != pIter) {
+    size_t keyLen = 0;
+    void  *pKey = taosHashGetKey(pIter, &keyLen);
+    (void)taosHashRemove(pCache, pKey, keyLen);
+    pIter = taosHashIterate(pCache, pIter);
+  }
+}
+
+static void destroySyntaxCacheEntry(void *p) { nodesDestroyNode(*(SNode **)p); }
+
+// the cache of a connection is created by its first request once querySyntaxCacheSize is above 0, NULL: no cache
+static SHashObj *getSyntaxCache(STscObj *pTscObj) {
+  SHashObj *pCache = atomic_load_ptr(&pTscObj->pSyntaxCache);
+  if (NULL != pCache || tsQuerySyntaxCacheSize <= 0) {
+    return pCache;
+  }
+
+  pCache = taosHashInit(64, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), false, HASH_ENTRY_LOCK);
+  if (NULL == pCache) {
+    return NULL;
+  }
+  taosHashSetFreeFp(pCache, destroySyntaxCacheEntry);
+
+  // another request of this connection may have created it meanwhile
+  SHashObj *pOld = atomic_val_compare_exchange_ptr(&pTscObj->pSyntaxCache, NULL, pCache);
+  if (NULL != pOld) {
+    taosHashCleanup(pCache);
+    return pOld;
+  }
+  return pCache;
+}
+
+static int32_t parseSqlSyntaxWithCache(SRequestObj *pRequest, SParseContext *pParseCtx, SCatalogReq *pCatalogReq) {
+  SHashObj *pCache = getSyntaxCache(pRequest->pTscObj);
+  char      key[TSDB_DB_FNAME_LEN + 2 + SYNTAX_CACHE_MAX_SQL_LEN];
+  shrinkSyntaxCache(pCache);
+  int32_t keyLen = buildSyntaxCacheKey(pRequest, pParseCtx->biMode, key);
+  if (0 == keyLen) {
+    return qParseSqlSyntax(pParseCtx, &pRequest->pQuery, pCatalogReq);
+  }
+
+  SNode **ppRoot = taosHashAcquire(pCache, key, keyLen);
+  if (NULL != ppRoot) {
+    int32_t code = qCloneSqlSyntax(pParseCtx, *ppRoot, &pRequest->pQuery, pCatalogReq);
+    taosHashRelease(pCache, ppRoot);
+    tscDebug("req:0x%" PRIx64 ", syntax cache hit, code:%s, QID:0x%" PRIx64, pRequest->self, tstrerror(code),
+             pRequest->requestId);
+    return code;
+  }
+
+  int32_t code = qParseSqlSyntax(pParseCtx, &pRequest->pQuery, pCatalogReq);
+  if (TSDB_CODE_SUCCESS != code || taosHashGetSize(pCache) >= tsQuerySyntaxCacheSize ||
+      !qIsReusableSqlSyntax(pRequest->pQuery)) {
+    return code;
+  }
+
+  // the request releases its allocator after the parse, so the copy is made on the heap and lives with the connection
+  SNode *pRoot = NULL;
+  if (TSDB_CODE_SUCCESS != nodesCloneNode(pRequest->pQuery->pRoot, &pRoot)) {
+    return code;
+  }
+  if (TSDB_CODE_SUCCESS != taosHashPut(pCache, key, keyLen, &pRoot, POINTER_BYTES)) {
+    // another request of this connection may have put the same sql meanwhile
+    nodesDestroyNode(pRoot);
+  }
+  return code;
+}
+
 int32_t prepareAndParseSqlSyntax(SSqlCallbackWrapper **ppWrapper, SRequestObj *pRequest, bool updateMetaForce) {
   int32_t              code = TSDB_CODE_SUCCESS;
   STscObj             *pTscObj = pRequest->pTscObj;
@@ -1281,7 +1377,7 @@ int32_t prepareAndParseSqlSyntax(SSqlCallbackWrapper **ppWrapper, SRequestObj *p
     } else {
       pWrapper->pCatalogReq->forceUpdate = updateMetaForce;
       TSC_ERR_RET(qnodeRequired(pRequest, &pWrapper->pCatalogReq->qNodeRequired));
-      code = qParseSqlSyntax(pWrapper->pParseCtx, &pRequest->pQuery, pWrapper->pCatalogReq);
+      code = parseSqlSyntaxWithCache(pRequest, pWrapper->pParseCtx, pWrapper->pCatalogReq);
     }
 
     pRequest->metric.parseCostUs += taosGetTimestampUs() - syntaxStart;
@@ -2042,6 +2138,70 @@ int taos_stmt2_bind_param(TAOS_STMT2 *stmt, TAOS_STMT2_BINDV *bindv, int32_t col
   return TSDB_CODE_SUCCESS;
 }
 
+int taos_stmt2_bind_arrow(TAOS_STMT2 *stmt, TAOS_STMT2_ARROW_BINDV *bindv) {
+  if (stmt == NULL || bindv == NULL) {
+    tscError("NULL parameter for %s", __FUNCTION__);
+    terrno = TSDB_CODE_INVALID_PARA;
+    return terrno;
+  }
+
+  if (bindv->arrays && bindv->schema == NULL) {
+    tscError("arrow schema is required to bind arrow arrays");
+    terrno = TSDB_CODE_INVALID_PARA;
+    return terrno;
+  }
+
+  STscStmt2 *pStmt = (STscStmt2 *)stmt;
+  if (pStmt->options.asyncExecFn && !pStmt->semWaited) {
+    if (tsem_wait(&pStmt->asyncQuerySem) != 0) {
+      tscError("wait async query sem failed");
+    }
+    pStmt->semWaited = true;
+  }
+
+  int32_t insert = 0;
+  (void)stmtIsInsert2(stmt, &insert);
+  if (0 == insert) {
+    tscError("arrow bind is only available for insert statement");
+    terrno = TSDB_CODE_TSC_STMT_API_ERROR;
+    return terrno;
+  }
+
+  int32_t code = 0;
+  for (int i = 0; i < bindv->count; ++i) {
+    if (bindv->tbnames && bindv->tbnames[i]) {
+      code = stmtSetTbName2(stmt, bindv->tbnames[i]);
+      if (code) {
+        return code;
+      }
+    }
+
+    if (bindv->tags && bindv->tags[i]) {
+      code = stmtSetTbTags2(stmt, bindv->tags[i]);
+      if (code) {
+        return code;
+      }
+    }
+
+    if (bindv->arrays && bindv->arrays[i]) {
+      struct ArrowArray *pArray = bindv->arrays[i];
+
+      if (pArray->length <= 0 || pArray->length > INT16_MAX) {
+        tscError("invalid arrow array length %" PRId64, pArray->length);
+        terrno = TSDB_CODE_INVALID_PARA;
+        return terrno;
+      }
+
+      code = stmtBindArrow2(stmt, bindv->schema, pArray);
+      if (TSDB_CODE_SUCCESS != code) {
+        return code;
+      }
+    }
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
 int taos_stmt2_exec(TAOS_STMT2 *stmt, int *affected_rows) {
   if (stmt == NULL) {
     tscError("NULL parameter for %s", __FUNCTION__);
@@ -36,14 +36,17 @@
   kvVal->type = TSDB_DATA_TYPE_FLOAT;                                                          \
   kvVal->f = (float)result;
 
-#define SET_BIGINT                                                                                       \
-  errno = 0;                                                                                             \
-  int64_t tmp = taosStr2Int64(pVal, &endptr, 10);                                                        \
-  if (errno == ERANGE) {                                                                                 \
-    smlBuildInvalidDataMsg(msg, "big int out of range[-9223372036854775808,9223372036854775807]", pVal); \
-    return false;                                                                                        \
-  }                                                                                                      \
-  kvVal->type = TSDB_DATA_TYPE_BIGINT;                                                                   \
+#define SET_BIGINT                                                                                         \
+  int64_t tmp = intVal;                                                                                    \
+  if (!isInt) {                                                                                            \
+    errno = 0;                                                                                             \
+    tmp = taosStr2Int64(pVal, &endptr, 10);                                                                \
+    if (errno == ERANGE) {                                                                                 \
+      smlBuildInvalidDataMsg(msg, "big int out of range[-9223372036854775808,9223372036854775807]", pVal); \
+      return false;                                                                                        \
+    }                                                                                                      \
+  }                                                                                                        \
+  kvVal->type = TSDB_DATA_TYPE_BIGINT;                                                                     \
   kvVal->i = tmp;
 
 #define SET_INT                                                                    \
@@ -62,14 +65,17 @@
   kvVal->type = TSDB_DATA_TYPE_SMALLINT;                                       \
   kvVal->i = result;
 
-#define SET_UBIGINT                                                                             \
-  errno = 0;                                                                                    \
-  uint64_t tmp = taosStr2UInt64(pVal, &endptr, 10);                                             \
-  if (errno == ERANGE || result < 0) {                                                          \
-    smlBuildInvalidDataMsg(msg, "unsigned big int out of range[0,18446744073709551615]", pVal); \
-    return false;                                                                               \
-  }                                                                                             \
-  kvVal->type = TSDB_DATA_TYPE_UBIGINT;                                                         \
+#define SET_UBIGINT                                                                               \
+  uint64_t tmp = (uint64_t)intVal;                                                                \
+  errno = 0;                                                                                      \
+  if (!isInt) {                                                                                   \
+    tmp = taosStr2UInt64(pVal, &endptr, 10);                                                      \
+  }                                                                                               \
+  if (errno == ERANGE || result < 0) {                                                            \
+    smlBuildInvalidDataMsg(msg, "unsigned big int out of range[0,18446744073709551615]", pVal);   \
+    return false;                                                                                 \
+  }                                                                                               \
+  kvVal->type = TSDB_DATA_TYPE_UBIGINT;                                                           \
   kvVal->u = tmp;
 
 #define SET_UINT                                                                  \
@@ -146,11 +152,138 @@ void smlBuildInvalidDataMsg(SSmlMsgBuf *pBuf, const char *msg1, const char *msg2
   }
 }
 
+#define SML_MAX_FAST_DIGITS    19  // any 19 digits number fits in uint64, callers check the int64 range
+#define SML_MAX_EXACT_DIGITS   15  // any 15 digits mantissa is exact in a double
+#define SML_EIGHT_DIGITS_LEN   8
+#define SML_EIGHT_DIGITS_SCALE 100000000ULL
+
+static const double smlPow10[] = {1e0, 1e1, 1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                  1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15};
+
+// whether the 8 bytes of v, loaded in little endian order, are all '0'-'9'
+static FORCE_INLINE bool smlIsEightDigits(uint64_t v) {
+  return (((v & 0xF0F0F0F0F0F0F0F0ULL) | (((v + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) ==
+          0x3333333333333333ULL);
+}
+
+// value of the 8 digits in v, the digits are combined pairwise in 3 multiply steps instead of 8
+static FORCE_INLINE uint32_t smlEightDigitsValue(uint64_t v) {
+  const uint64_t mask = 0x000000FF000000FFULL;
+  const uint64_t mul1 = 0x000F424000000064ULL;  // 100 + (1000000 << 32)
+  const uint64_t mul2 = 0x0000271000000001ULL;  // 1 + (10000 << 32)
+  v -= 0x3030303030303030ULL;
+  v = (v * 10) + (v >> 8);
+  v = (((v & mask) * mul1) + (((v >> 16) & mask) * mul2)) >> 32;
+  return (uint32_t)v;
+}
+
+/*
+ * Parse the digits [p, p + len) without calling strtoll, 8 digits at a time. Returns false when the run has other
+ * characters or is too long to be sure it does not overflow, the caller falls back to the libc conversion then.
+ */
+static bool smlParseDigits(const char *p, int32_t len, uint64_t *pVal) {
+  if (len <= 0 || len > SML_MAX_FAST_DIGITS) {
+    return false;
+  }
+
+  uint64_t v = 0;
+  int32_t  i = 0;
+  for (; i + SML_EIGHT_DIGITS_LEN <= len; i += SML_EIGHT_DIGITS_LEN) {
+    uint64_t w = 0;
+    (void)memcpy(&w, p + i, SML_EIGHT_DIGITS_LEN);
+    if (!smlIsEightDigits(w)) {
+      return false;
+    }
+    v = v * SML_EIGHT_DIGITS_SCALE + smlEightDigitsValue(w);
+  }
+  for (; i < len; ++i) {
+    uint8_t d = (uint8_t)(p[i] - '0');
+    if (d > 9) {
+      return false;
+    }
+    v = v * 10 + d;
+  }
+  *pVal = v;
+  return true;
+}
+
+static int32_t smlDigitsLen(const char *p, const char *end) {
+  const char *start = p;
+  while (p < end && (uint8_t)(*p - '0') <= 9) {
+    p++;
+  }
+  return p - start;
+}
+
+/*
+ * Parse [-]digits[.digits] with at most SML_MAX_EXACT_DIGITS digits. The mantissa and the power of ten are both
+ * exact doubles, so one division gives the same correctly rounded result as strtod. Anything strtod would read
+ * further (exponent, hex, inf/nan, a sign or a trailing dot) returns false and is left to strtod.
+ */
+static bool smlParseDecimal(const char *pVal, int32_t len, double *pResult, int64_t *pInt, bool *pIsInt,
+                            const char **pEnd) {
+  const char *p = pVal;
+  const char *end = pVal + len;
+  bool        neg = (p < end && *p == '-');
+  if (neg) {
+    p++;
+  }
+
+  int32_t intLen = smlDigitsLen(p, end);
+  if (intLen == 0) {
+    return false;
+  }
+
+  uint64_t    mant = 0;
+  const char *fracStart = p + intLen;
+  int32_t     fracLen = 0;
+  if (fracStart < end && *fracStart == '.') {
+    fracStart++;
+    fracLen = smlDigitsLen(fracStart, end);
+    if (fracLen == 0) {
+      return false;
+    }
+  }
+
+  const char *numEnd = fracLen > 0 ? fracStart + fracLen : p + intLen;
+  if (numEnd < end && (*numEnd == 'e' || *numEnd == 'E' || *numEnd == 'x' || *numEnd == 'X')) {
+    return false;
+  }
+  if (intLen + fracLen > SML_MAX_EXACT_DIGITS || !smlParseDigits(p, intLen, &mant)) {
+    return false;
+  }
+
+  if (fracLen > 0) {
+    uint64_t frac = 0;
+    if (!smlParseDigits(fracStart, fracLen, &frac)) {
+      return false;
+    }
+    mant = mant * (uint64_t)smlPow10[fracLen] + frac;
+  }
+
+  double result = (double)mant;
+  if (fracLen > 0) {
+    result /= smlPow10[fracLen];
+  }
+  *pResult = neg ? -result : result;
+  *pInt = neg ? -(int64_t)mant : (int64_t)mant;
+  *pIsInt = (fracLen == 0);
+  *pEnd = numEnd;
+  return true;
+}
+
 int64_t smlGetTimeValue(const char *value, int32_t len, uint8_t fromPrecision, uint8_t toPrecision) {
-  char   *endPtr = NULL;
-  int64_t tsInt64 = taosStr2Int64(value, &endPtr, 10);
-  if (unlikely(value + len != endPtr)) {
-    return -1;
+  uint64_t digits = 0;
+  int64_t  tsInt64 = 0;
+  // a 19 digits nanosecond timestamp takes the fast path, one beyond INT64_MAX is left to the libc conversion
+  if (likely(smlParseDigits(value, len, &digits) && digits <= (uint64_t)INT64_MAX)) {
+    tsInt64 = (int64_t)digits;
+  } else {
+    char *endPtr = NULL;
+    tsInt64 = taosStr2Int64(value, &endPtr, 10);
+    if (unlikely(value + len != endPtr)) {
+      return -1;
+    }
   }
 
   if (unlikely(fromPrecision >= TSDB_TIME_PRECISION_HOURS)) {
@@ -650,7 +783,13 @@ int32_t smlParseNumber(SSmlKv *kvVal, SSmlMsgBuf *msg) {
   const char *pVal = kvVal->value;
   int32_t     len = kvVal->length;
   char       *endptr = NULL;
-  double      result = taosStr2Double(pVal, &endptr);
+  double      result = 0;
+  int64_t     intVal = 0;
+  bool        isInt = false;
+  if (!smlParseDecimal(pVal, len, &result, &intVal, &isInt, (const char **)&endptr)) {
+    isInt = false;
+    result = taosStr2Double(pVal, &endptr);
+  }
   if (pVal == endptr) {
     RETURN_FALSE
   }
@@ -1569,6 +1708,9 @@ static int32_t smlUpdateMeta(SHashObj *metaHash, SArray *metaArray, SArray *cols
 
 void smlDestroyTableInfo(void *para) {
   SSmlTableInfo *tag = *(SSmlTableInfo **)para;
+  if (tag == NULL) {
+    return;
+  }
   for (size_t i = 0; i < taosArrayGetSize(tag->cols); i++) {
     SHashObj *kvHash = (SHashObj *)taosArrayGetP(tag->cols, i);
     taosHashCleanup(kvHash);
@@ -1998,6 +2140,199 @@ static bool getLine(SSmlHandle *info, char *lines[], char **rawLine, char *rawLi
   return true;
 }
 
+#define SML_PARSE_MIN_LINES_PER_THREAD 4096
+
+typedef struct {
+  char   *data;
+  int32_t len;
+} SSmlLineSpan;
+
+/*
+ * One chunk of lines parsed on its own thread. The handle is a copy of the caller's one with private child table,
+ * uid and tag state, the parsed lines are written to the caller's info->lines at their own index.
+ */
+typedef struct {
+  SSmlHandle    handle;
+  SSmlLineSpan *spans;
+  int32_t       start;
+  int32_t       end;
+  int32_t       code;
+  int32_t       errLine;
+  char          msg[ERROR_MSG_BUF_DEFAULT_SIZE];
+} SSmlParseTask;
+
+static int32_t smlInitParseTask(SSmlHandle *info, SSmlParseTask *pTask, SSmlLineSpan *spans, int32_t start,
+                                int32_t end) {
+  SSmlHandle *pHandle = &pTask->handle;
+  *pHandle = *info;
+  pHandle->childTables = taosHashInit(16, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), true, HASH_NO_LOCK);
+  pHandle->tableUids = taosHashInit(16, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), true, HASH_NO_LOCK);
+  pHandle->preLineTagKV = taosArrayInit(8, sizeof(SSmlKv));
+  pHandle->escapedStringList = taosArrayInit(8, POINTER_BYTES);
+  if (pHandle->childTables == NULL || pHandle->tableUids == NULL || pHandle->preLineTagKV == NULL ||
+      pHandle->escapedStringList == NULL) {
+    return terrno;
+  }
+  taosHashSetFreeFp(pHandle->childTables, smlDestroyTableInfo);
+
+  (void)memset(&pHandle->preLine, 0, sizeof(SSmlLineInfo));
+  pHandle->msgBuf.buf = pTask->msg;
+  pHandle->msgBuf.len = sizeof(pTask->msg);
+  pHandle->uid = 0;
+  pTask->spans = spans;
+  pTask->start = start;
+  pTask->end = end;
+  return TSDB_CODE_SUCCESS;
+}
+
+static void smlDestroyParseTask(SSmlParseTask *pTask) {
+  taosHashCleanup(pTask->handle.childTables);
+  taosHashCleanup(pTask->handle.tableUids);
+  taosArrayDestroyEx(pTask->handle.preLineTagKV, freeSSmlKv);
+  taosArrayDestroyP(pTask->handle.escapedStringList, taosMemoryFree);
+}
+
+static void *smlParseTaskFp(void *param) {
+  SSmlParseTask *pTask = (SSmlParseTask *)param;
+  for (int32_t i = pTask->start; i < pTask->end; ++i) {
+    SSmlLineSpan *pSpan = pTask->spans + i;
+    int32_t code = smlParseInfluxString(&pTask->handle, pSpan->data, pSpan->data + pSpan->len, pTask->handle.lines + i);
+    if (code != TSDB_CODE_SUCCESS) {
+      pTask->code = code;
+      pTask->errLine = i;
+      break;
+    }
+  }
+  return NULL;
+}
+
+// move the child tables first seen by the task to the caller's handle, the uids are given by the caller's handle
+static int32_t smlMergeParseTask(SSmlHandle *info, SSmlParseTask *pTask) {
+  int32_t code = TSDB_CODE_SUCCESS;
+  void   *p = taosHashIterate(pTask->handle.childTables, NULL);
+  while (p != NULL) {
+    SSmlTableInfo **ppTable = (SSmlTableInfo **)p;
+    size_t          keyLen = 0;
+    void           *key = taosHashGetKey(p, &keyLen);
+    if (taosHashGet(info->childTables, key, keyLen) == NULL) {
+      SSmlTableInfo *tinfo = *ppTable;
+      code = taosHashPut(info->childTables, key, keyLen, &tinfo, POINTER_BYTES);
+      if (code == TSDB_CODE_SUCCESS) {
+        *ppTable = NULL;
+        SSmlLineInfo element = {.measure = (char *)tinfo->sTableName, .measureLen = tinfo->sTableNameLen};
+        code = getTableUid(info, &element, tinfo);
+      }
+      if (code != TSDB_CODE_SUCCESS) {
+        taosHashCancelIterate(pTask->handle.childTables, p);
+        return code;
+      }
+    }
+    p = taosHashIterate(pTask->handle.childTables, p);
+  }
+  return code;
+}
+
+/*
+ * Parse a large line protocol batch with up to numOfThreads threads. The lines go through the generic path
+ * (dataFormat false) that keeps every parsed line, so the chunks only share read-only state. The child tables of
+ * all chunks are merged afterwards, and the schema change and the per-vgroup submit then run once for the batch.
+ */
+int32_t smlParseLineParallel(SSmlHandle *info, char *lines[], char *rawLine, char *rawLineEnd, int numLines,
+                             int32_t numOfThreads) {
+  int32_t        code = TSDB_CODE_SUCCESS;
+  SSmlLineSpan  *spans = NULL;
+  SSmlParseTask *pTasks = NULL;
+  TdThread      *pThreads = NULL;
+  bool          *pStarted = NULL;
+
+  if (unlikely(info->lines != NULL)) {
+    uError("SML:0x%" PRIx64 " info->lines != NULL", info->id);
+    return TSDB_CODE_SML_INVALID_DATA;
+  }
+
+  numOfThreads = TMAX(TMIN(numOfThreads, numLines), 1);
+  info->dataFormat = false;
+  info->lines = (SSmlLineInfo *)taosMemoryCalloc(numLines, sizeof(SSmlLineInfo));
+  spans = (SSmlLineSpan *)taosMemoryCalloc(numLines, sizeof(SSmlLineSpan));
+  pTasks = (SSmlParseTask *)taosMemoryCalloc(numOfThreads, sizeof(SSmlParseTask));
+  pThreads = (TdThread *)taosMemoryCalloc(numOfThreads, sizeof(TdThread));
+  pStarted = (bool *)taosMemoryCalloc(numOfThreads, sizeof(bool));
+  if (info->lines == NULL || spans == NULL || pTasks == NULL || pThreads == NULL || pStarted == NULL) {
+    code = terrno;
+    goto _end;
+  }
+
+  for (int32_t i = 0; i < numLines;) {
+    char *tmp = NULL;
+    int   len = 0;
+    if (!getLine(info, lines, &rawLine, rawLineEnd, numLines, i, &tmp, &len)) {
+      continue;
+    }
+    spans[i].data = tmp;
+    spans[i].len = len;
+    i++;
+  }
+
+  int32_t linesPerThread = (numLines + numOfThreads - 1) / numOfThreads;
+  for (int32_t i = 0; i < numOfThreads; ++i) {
+    int32_t start = TMIN(i * linesPerThread, numLines);
+    code = smlInitParseTask(info, pTasks + i, spans, start, TMIN(start + linesPerThread, numLines));
+    if (code != TSDB_CODE_SUCCESS) {
+      goto _end;
+    }
+  }
+
+  // the calling thread parses the first chunk itself, a chunk whose thread can not start is parsed here as well
+  for (int32_t i = 1; i < numOfThreads; ++i) {
+    pStarted[i] = (taosThreadCreate(pThreads + i, NULL, smlParseTaskFp, pTasks + i) == 0);
+    if (!pStarted[i]) {
+      uWarn("SML:0x%" PRIx64 " failed to create parse thread, parse chunk %d on the calling thread", info->id, i);
+    }
+  }
+  (void)smlParseTaskFp(pTasks);
+  for (int32_t i = 1; i < numOfThreads; ++i) {
+    if (pStarted[i]) {
+      (void)taosThreadJoin(pThreads[i], NULL);
+    } else {
+      (void)smlParseTaskFp(pTasks + i);
+    }
+  }
+
+  for (int32_t i = 0; i < numOfThreads; ++i) {
+    SSmlParseTask *pTask = pTasks + i;
+    if (pTask->code != TSDB_CODE_SUCCESS) {
+      code = pTask->code;
+      if (info->msgBuf.buf != NULL) {
+        tstrncpy(info->msgBuf.buf, pTask->msg, info->msgBuf.len);
+      }
+      uError("SML:0x%" PRIx64 " smlParseLineParallel failed. line %d, code:%s", info->id, pTask->errLine,
+             tstrerror(code));
+      goto _end;
+    }
+  }
+
+  for (int32_t i = 0; i < numOfThreads; ++i) {
+    code = smlMergeParseTask(info, pTasks + i);
+    if (code != TSDB_CODE_SUCCESS) {
+      goto _end;
+    }
+  }
+  uDebug("SML:0x%" PRIx64 " smlParseLineParallel end, lines:%d, threads:%d, child tables:%d", info->id, numLines,
+         numOfThreads, taosHashGetSize(info->childTables));
+
+_end:
+  if (pTasks != NULL) {
+    for (int32_t i = 0; i < numOfThreads; ++i) {
+      smlDestroyParseTask(pTasks + i);
+    }
+  }
+  taosMemoryFree(pStarted);
+  taosMemoryFree(pThreads);
+  taosMemoryFree(pTasks);
+  taosMemoryFree(spans);
+  return code;
+}
+
 static int32_t smlParseLine(SSmlHandle *info, char *lines[], char *rawLine, char *rawLineEnd, int numLines) {
   uDebug("SML:0x%" PRIx64 " smlParseLine start", info->id);
   int32_t code = TSDB_CODE_SUCCESS;
@@ -2014,6 +2349,12 @@ static int32_t smlParseLine(SSmlHandle *info, char *lines[], char *rawLine, char
     return code;
   }
 
+  if (info->protocol == TSDB_SML_LINE_PROTOCOL && tsSmlParseThreads > 1 &&
+      numLines >= 2 * SML_PARSE_MIN_LINES_PER_THREAD) {
+    return smlParseLineParallel(info, lines, rawLine, rawLineEnd, numLines,
+                                TMIN(tsSmlParseThreads, numLines / SML_PARSE_MIN_LINES_PER_THREAD));
+  }
+
   char   *oldRaw = rawLine;
   int32_t i = 0;
   while (i < numLines) {
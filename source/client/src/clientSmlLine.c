@@ -48,6 +48,69 @@
 #define BINARY_ADD_LEN (sizeof("\"\"")-1)    // "binary"   2 means length of ("")
 #define NCHAR_ADD_LEN  (sizeof("L\"\"")-1)   // L"nchar"   3 means length of (L"")
 
+/*
+ * Structural scanner of a line, in the style of the simdjson structural index. The parse loops below only act on
+ * comma, space, equal, quote and backslash, every other byte just moves the cursor. The positions of these bytes are
+ * collected into a bitmask 64 bytes at a time, so the loops jump from one structural byte to the next and escapes
+ * are still handled by the loops themselves.
+ */
+#define SML_SCAN_BLOCK 64
+
+typedef struct {
+  const char *base;  // start of the block described by mask
+  const char *end;
+  uint64_t    mask;  // bit i is set when base[i] is a structural byte
+} SSmlScanner;
+
+static const uint8_t smlStructuralByte[256] = {[COMMA] = 1, [SPACE] = 1, [EQUAL] = 1, [QUOTE] = 1, [SLASH] = 1};
+
+static FORCE_INLINE void smlScanInit(SSmlScanner *pScan, const char *end) {
+  pScan->base = end;
+  pScan->end = end;
+  pScan->mask = 0;
+}
+
+#ifdef __AVX2__
+static FORCE_INLINE uint32_t smlScanStructural32(const char *p) {
+  __m256i v = _mm256_loadu_si256((const __m256i *)p);
+  __m256i m = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(COMMA)), _mm256_cmpeq_epi8(v, _mm256_set1_epi8(SPACE)));
+  m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8(EQUAL)));
+  m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8(QUOTE)));
+  m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8(SLASH)));
+  return (uint32_t)_mm256_movemask_epi8(m);
+}
+#endif
+
+static void smlScanLoad(SSmlScanner *pScan, const char *p) {
+  pScan->base = p;
+  pScan->mask = 0;
+  int64_t len = TMIN(pScan->end - p, SML_SCAN_BLOCK);
+#ifdef __AVX2__
+  if (len == SML_SCAN_BLOCK && tsSIMDEnable && tsAVX2Supported) {
+    pScan->mask = (uint64_t)smlScanStructural32(p) | ((uint64_t)smlScanStructural32(p + 32) << 32);
+    return;
+  }
+#endif
+  for (int64_t i = 0; i < len; ++i) {
+    pScan->mask |= ((uint64_t)smlStructuralByte[(uint8_t)p[i]]) << i;
+  }
+}
+
+// the first structural byte at or after p, or end when there is none
+static FORCE_INLINE char *smlScanNext(SSmlScanner *pScan, const char *p) {
+  while (p < pScan->end) {
+    if (p < pScan->base || p - pScan->base >= SML_SCAN_BLOCK) {
+      smlScanLoad(pScan, p);
+    }
+    uint64_t mask = pScan->mask & (~0ULL << (p - pScan->base));
+    if (mask != 0) {
+      return (char *)pScan->base + BUILDIN_CTZL(mask);
+    }
+    p = pScan->base + SML_SCAN_BLOCK;
+  }
+  return (char *)pScan->end;
+}
+
 uint8_t smlPrecisionConvert[] = {TSDB_TIME_PRECISION_NANO,    TSDB_TIME_PRECISION_HOURS, TSDB_TIME_PRECISION_MINUTES,
                                   TSDB_TIME_PRECISION_SECONDS, TSDB_TIME_PRECISION_MILLI, TSDB_TIME_PRECISION_MICRO,
                                   TSDB_TIME_PRECISION_NANO};
@@ -195,7 +258,7 @@ int32_t smlParseValue(SSmlKv *pVal, SSmlMsgBuf *msg) {
   return TSDB_CODE_TSC_INVALID_VALUE;
 }
 
-static int32_t smlProcessTagLine(SSmlHandle *info, char **sql, char *sqlEnd){
+static int32_t smlProcessTagLine(SSmlHandle *info, char **sql, char *sqlEnd, SSmlScanner *pScan){
   SArray *preLineKV = info->preLineTagKV;
   taosArrayClearEx(preLineKV, freeSSmlKv);
   int     cnt = 0;
@@ -213,6 +276,8 @@ static int32_t smlProcessTagLine(SSmlHandle *info, char **sql, char *sqlEnd){
     const char *escapeChar = NULL;
 
     while (*sql < sqlEnd) {
+      *sql = smlScanNext(pScan, *sql);
+      if (*sql >= sqlEnd) break;
       if (unlikely(IS_SPACE(*sql,escapeChar) || IS_COMMA(*sql,escapeChar))) {
         smlBuildInvalidDataMsg(&info->msgBuf, "invalid data", *sql);
         return TSDB_CODE_SML_INVALID_DATA;
@@ -242,6 +307,8 @@ static int32_t smlProcessTagLine(SSmlHandle *info, char **sql, char *sqlEnd){
     size_t      valueLenEscaped = 0;
     while (*sql < sqlEnd) {
       // parse value
+      *sql = smlScanNext(pScan, *sql);
+      if (*sql >= sqlEnd) break;
       if (unlikely(IS_SPACE(*sql,escapeChar) || IS_COMMA(*sql,escapeChar))) {
         break;
       } else if (unlikely(IS_EQUAL(*sql,escapeChar))) {
@@ -310,7 +377,8 @@ static int32_t smlProcessTagLine(SSmlHandle *info, char **sql, char *sqlEnd){
   return TSDB_CODE_SUCCESS;
 }
 
-static int32_t smlParseTagLine(SSmlHandle *info, char **sql, char *sqlEnd, SSmlLineInfo *elements) {
+static int32_t smlParseTagLine(SSmlHandle *info, char **sql, char *sqlEnd, SSmlLineInfo *elements,
+                               SSmlScanner *pScan) {
   bool isSameCTable = IS_SAME_CHILD_TABLE;
   if(isSameCTable){
     return TSDB_CODE_SUCCESS;
@@ -327,7 +395,7 @@ static int32_t smlParseTagLine(SSmlHandle *info, char **sql, char *sqlEnd, SSmlL
     }
   }
 
-  ret = smlProcessTagLine(info, sql, sqlEnd);
+  ret = smlProcessTagLine(info, sql, sqlEnd, pScan);
   if(ret != 0){
     if (info->reRun){
       return TSDB_CODE_SUCCESS;
@@ -338,7 +406,8 @@ static int32_t smlParseTagLine(SSmlHandle *info, char **sql, char *sqlEnd, SSmlL
   return smlProcessChildTable(info, elements);
 }
 
-static int32_t smlParseColLine(SSmlHandle *info, char **sql, char *sqlEnd, SSmlLineInfo *currElement) {
+static int32_t smlParseColLine(SSmlHandle *info, char **sql, char *sqlEnd, SSmlLineInfo *currElement,
+                               SSmlScanner *pScan) {
   int cnt = 0;
   while (*sql < sqlEnd) {
     if (unlikely(IS_SPACE(*sql,NULL))) {
@@ -352,6 +421,8 @@ static int32_t smlParseColLine(SSmlHandle *info, char **sql, char *sqlEnd, SSmlL
     size_t      keyLenEscaped = 0;
     const char *escapeChar = NULL;
     while (*sql < sqlEnd) {
+      *sql = smlScanNext(pScan, *sql);
+      if (*sql >= sqlEnd) break;
       if (unlikely(IS_SPACE(*sql,escapeChar) || IS_COMMA(*sql,escapeChar))) {
         smlBuildInvalidDataMsg(&info->msgBuf, "invalid data", *sql);
         return TSDB_CODE_SML_INVALID_DATA;
@@ -382,6 +453,8 @@ static int32_t smlParseColLine(SSmlHandle *info, char **sql, char *sqlEnd, SSmlL
     int         quoteNum = 0;
     while (*sql < sqlEnd) {
       // parse value
+      *sql = smlScanNext(pScan, *sql);
+      if (*sql >= sqlEnd) break;
       if (unlikely(*(*sql) == QUOTE && (*(*sql - 1) != SLASH || (*sql - 1) == escapeChar))) {
         quoteNum++;
         (*sql)++;
@@ -494,7 +567,11 @@ int32_t smlParseInfluxString(SSmlHandle *info, char *sql, char *sqlEnd, SSmlLine
   // parse measure
   size_t measureLenEscaped = 0;
   const char *escapeChar = NULL;
+  SSmlScanner scanner;
+  smlScanInit(&scanner, sqlEnd);
   while (sql < sqlEnd) {
+    sql = smlScanNext(&scanner, sql);
+    if (sql >= sqlEnd) break;
     if (unlikely(IS_COMMA(sql,escapeChar) || IS_SPACE(sql,escapeChar))) {
       break;
     }
@@ -517,6 +594,8 @@ int32_t smlParseInfluxString(SSmlHandle *info, char *sql, char *sqlEnd, SSmlLine
   // to get measureTagsLen before
   const char *tmp = sql;
   while (tmp < sqlEnd) {
+    tmp = smlScanNext(&scanner, tmp);
+    if (tmp >= sqlEnd) break;
     if (unlikely(IS_SPACE(tmp,escapeChar))) {
       break;
     }
@@ -531,7 +610,7 @@ int32_t smlParseInfluxString(SSmlHandle *info, char *sql, char *sqlEnd, SSmlLine
   if (*sql == COMMA) sql++;
   elements->tags = sql;
 
-  int ret = smlParseTagLine(info, &sql, sqlEnd, elements);
+  int ret = smlParseTagLine(info, &sql, sqlEnd, elements, &scanner);
   if (unlikely(ret != TSDB_CODE_SUCCESS)) {
     return ret;
   }
@@ -546,7 +625,7 @@ int32_t smlParseInfluxString(SSmlHandle *info, char *sql, char *sqlEnd, SSmlLine
   JUMP_SPACE(sql, sqlEnd)
   elements->cols = sql;
 
-  ret = smlParseColLine(info, &sql, sqlEnd, elements);
+  ret = smlParseColLine(info, &sql, sqlEnd, elements, &scanner);
   if (unlikely(ret != TSDB_CODE_SUCCESS)) {
     return ret;
   }
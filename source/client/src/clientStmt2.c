@@ -1,6 +1,8 @@
 #include "clientInt.h"
 #include "clientLog.h"
 #include "tdef.h"
+#include "ttime.h"
+#include "tglobal.h"
 
 #include "clientStmt.h"
 #include "clientStmt2.h"
@@ -408,6 +410,20 @@ static void stmtFreeTbCols(void* buf) {
   taosArrayDestroy(pCols);
 }
 
+static void stmtDestroyPlanCache(SStmtPlanCache* pCache) {
+  if (NULL == pCache) {
+    return;
+  }
+  qDestroyPlanTemplate(pCache->pTemplate);
+  taosArrayDestroy(pCache->pParamTypes);
+  taosArrayDestroy(pCache->pTableVers);
+  taosArrayDestroy(pCache->pDbVers);
+  taosMemoryFree(pCache->pResSchema);
+  taosArrayDestroy(pCache->pDbList);
+  taosArrayDestroy(pCache->pTableList);
+  taosMemoryFree(pCache);
+}
+
 static int32_t stmtCleanSQLInfo(STscStmt2* pStmt) {
   STMT_DLOG_E("start to free SQL info");
 
@@ -419,6 +435,7 @@ static int32_t stmtCleanSQLInfo(STscStmt2* pStmt) {
   taosArrayDestroy(pStmt->sql.nodeList);
   taosHashCleanup(pStmt->sql.pVgHash);
   pStmt->sql.pVgHash = NULL;
+  stmtDestroyPlanCache(pStmt->sql.pPlanCache);
 
   void* pIter = taosHashIterate(pStmt->sql.pTableCache, NULL);
   while (pIter) {
@@ -1264,6 +1281,203 @@ static int32_t stmtRestoreQueryFields(STscStmt2* pStmt) {
   return TSDB_CODE_SUCCESS;
 }
 */
+static bool stmtIsPlanCacheValid(STscStmt2* pStmt, SCatalog* pCatalog) {
+  SStmtPlanCache* pCache = pStmt->sql.pPlanCache;
+  SArray*         pValues = pStmt->sql.pQuery->pPlaceholderValues;
+  if (NULL == pCache || pCache->authVer != pStmt->taos->authVer ||
+      taosArrayGetSize(pValues) != taosArrayGetSize(pCache->pParamTypes)) {
+    return false;
+  }
+
+  for (int32_t i = 0; i < taosArrayGetSize(pValues); ++i) {
+    if (((SValueNode*)taosArrayGetP(pValues, i))->node.resType.type != *(int8_t*)taosArrayGet(pCache->pParamTypes, i)) {
+      return false;
+    }
+  }
+
+  for (int32_t i = 0; i < taosArrayGetSize(pCache->pDbVers); ++i) {
+    SStmtPlanDbVer* pDb = taosArrayGet(pCache->pDbVers, i);
+    int32_t         vgVersion = -1, tableNum = 0;
+    int64_t         dbId = 0, stateTs = 0;
+    if (TSDB_CODE_SUCCESS != catalogGetDBVgVersion(pCatalog, pDb->dbFName, &vgVersion, &dbId, &tableNum, &stateTs) ||
+        vgVersion != pDb->vgVersion || dbId != pDb->dbId) {
+      return false;
+    }
+  }
+
+  for (int32_t i = 0; i < taosArrayGetSize(pCache->pTableVers); ++i) {
+    SStmtPlanTableVer* pTb = taosArrayGet(pCache->pTableVers, i);
+    STableMeta*        pMeta = NULL;
+    bool same = (TSDB_CODE_SUCCESS == catalogGetCachedTableMeta(pCatalog, &pTb->name, &pMeta) && NULL != pMeta &&
+                 pMeta->uid == pTb->uid && pMeta->sversion == pTb->sversion && pMeta->tversion == pTb->tversion);
+    taosMemoryFree(pMeta);
+    if (!same) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// the query is not translated again, the outputs of the translation are restored from the cache
+static int32_t stmtUseCachedPlan(STscStmt2* pStmt, SCatalog* pCatalog, bool* pUsed) {
+  *pUsed = false;
+  if (!stmtIsPlanCacheValid(pStmt, pCatalog)) {
+    stmtDestroyPlanCache(pStmt->sql.pPlanCache);
+    pStmt->sql.pPlanCache = NULL;
+    return TSDB_CODE_SUCCESS;
+  }
+
+  SStmtPlanCache* pCache = pStmt->sql.pPlanCache;
+  SQuery*         pQuery = pStmt->sql.pQuery;
+  SRequestObj*    pRequest = pStmt->exec.pRequest;
+  STMT_ERR_RET(qBuildPlanFromTemplate(pCache->pTemplate, pRequest->requestId, pQuery->pPlaceholderValues,
+                                      &pRequest->pPreparedPlan));
+
+  taosMemoryFreeClear(pQuery->pResSchema);
+  if (pCache->numOfResCols > 0) {
+    pQuery->pResSchema = taosMemoryMalloc(pCache->numOfResCols * sizeof(SSchema));
+    if (NULL == pQuery->pResSchema) {
+      STMT_ERR_RET(terrno);
+    }
+    (void)memcpy(pQuery->pResSchema, pCache->pResSchema, pCache->numOfResCols * sizeof(SSchema));
+  }
+  pQuery->numOfResCols = pCache->numOfResCols;
+  pQuery->precision = pCache->precision;
+
+  taosArrayDestroy(pQuery->pDbList);
+  taosArrayDestroy(pQuery->pTableList);
+  pQuery->pDbList = taosArrayDup(pCache->pDbList, NULL);
+  pQuery->pTableList = taosArrayDup(pCache->pTableList, NULL);
+  if (NULL == pQuery->pDbList || NULL == pQuery->pTableList) {
+    STMT_ERR_RET(terrno);
+  }
+
+  ++pCache->hits;
+  STMT_DLOG("query plan built from the cache, hits:%" PRId64, pCache->hits);
+  *pUsed = true;
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t stmtCollectPlanVersions(STscStmt2* pStmt, SCatalog* pCatalog, SStmtPlanCache* pCache, bool* pValid) {
+  SQuery* pQuery = pStmt->sql.pQuery;
+  *pValid = false;
+
+  for (int32_t i = 0; i < taosArrayGetSize(pQuery->pDbList); ++i) {
+    SStmtPlanDbVer dbVer = {0};
+    int32_t        tableNum = 0;
+    int64_t        stateTs = 0;
+    tstrncpy(dbVer.dbFName, taosArrayGet(pQuery->pDbList, i), sizeof(dbVer.dbFName));
+    STMT_ERR_RET(
+        catalogGetDBVgVersion(pCatalog, dbVer.dbFName, &dbVer.vgVersion, &dbVer.dbId, &tableNum, &stateTs));
+    if (dbVer.vgVersion < 0) {
+      return TSDB_CODE_SUCCESS;
+    }
+    if (NULL == taosArrayPush(pCache->pDbVers, &dbVer)) {
+      STMT_ERR_RET(terrno);
+    }
+  }
+
+  for (int32_t i = 0; i < taosArrayGetSize(pQuery->pTableList); ++i) {
+    SStmtPlanTableVer tbVer = {.name = *(SName*)taosArrayGet(pQuery->pTableList, i)};
+    STableMeta*       pMeta = NULL;
+    STMT_ERR_RET(catalogGetCachedTableMeta(pCatalog, &tbVer.name, &pMeta));
+    if (NULL == pMeta) {
+      return TSDB_CODE_SUCCESS;
+    }
+    tbVer.uid = pMeta->uid;
+    tbVer.sversion = pMeta->sversion;
+    tbVer.tversion = pMeta->tversion;
+    taosMemoryFree(pMeta);
+    if (NULL == taosArrayPush(pCache->pTableVers, &tbVer)) {
+      STMT_ERR_RET(terrno);
+    }
+  }
+
+  *pValid = true;
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t stmtBuildPlanCache(STscStmt2* pStmt, SCatalog* pCatalog, SQueryPlan* pPlan, SStmtPlanCache* pCache,
+                                  bool* pValid) {
+  SQuery* pQuery = pStmt->sql.pQuery;
+  *pValid = false;
+
+  STMT_ERR_RET(qCreatePlanTemplate(pPlan, pQuery->placeholderNum, &pCache->pTemplate));
+  if (NULL == pCache->pTemplate) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  pCache->pParamTypes = taosArrayInit(pQuery->placeholderNum, sizeof(int8_t));
+  pCache->pTableVers = taosArrayInit(4, sizeof(SStmtPlanTableVer));
+  pCache->pDbVers = taosArrayInit(2, sizeof(SStmtPlanDbVer));
+  pCache->pDbList = taosArrayDup(pQuery->pDbList, NULL);
+  pCache->pTableList = taosArrayDup(pQuery->pTableList, NULL);
+  if (NULL == pCache->pParamTypes || NULL == pCache->pTableVers || NULL == pCache->pDbVers ||
+      NULL == pCache->pDbList || NULL == pCache->pTableList) {
+    STMT_ERR_RET(terrno);
+  }
+
+  for (int32_t i = 0; i < taosArrayGetSize(pQuery->pPlaceholderValues); ++i) {
+    int8_t type = ((SValueNode*)taosArrayGetP(pQuery->pPlaceholderValues, i))->node.resType.type;
+    if (NULL == taosArrayPush(pCache->pParamTypes, &type)) {
+      STMT_ERR_RET(terrno);
+    }
+  }
+
+  if (pQuery->numOfResCols > 0) {
+    pCache->pResSchema = taosMemoryMalloc(pQuery->numOfResCols * sizeof(SSchema));
+    if (NULL == pCache->pResSchema) {
+      STMT_ERR_RET(terrno);
+    }
+    (void)memcpy(pCache->pResSchema, pQuery->pResSchema, pQuery->numOfResCols * sizeof(SSchema));
+  }
+  pCache->numOfResCols = pQuery->numOfResCols;
+  pCache->precision = pQuery->precision;
+  pCache->authVer = pStmt->taos->authVer;
+
+  return stmtCollectPlanVersions(pStmt, pCatalog, pCache, pValid);
+}
+
+// plans the translated query ahead of the execution and keeps the plan for the next executions if it is reusable
+static int32_t stmtCachePlan(STscStmt2* pStmt, SCatalog* pCatalog) {
+  SRequestObj* pRequest = pStmt->exec.pRequest;
+  stmtDestroyPlanCache(pStmt->sql.pPlanCache);
+  pStmt->sql.pPlanCache = NULL;
+  if (!qStmtIsPlanReusable(pStmt->sql.pQuery)) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  SArray* pMnodeList = taosArrayInit(4, sizeof(SQueryNodeLoad));
+  if (NULL == pMnodeList) {
+    STMT_ERR_RET(terrno);
+  }
+  SQueryPlan* pPlan = NULL;
+  int32_t     code = getPlan(pRequest, pStmt->sql.pQuery, &pPlan, pMnodeList);
+  // a plan that also runs on the mnode needs the node list of the execution, it is planned again there
+  bool onMnode = taosArrayGetSize(pMnodeList) > 0;
+  taosArrayDestroy(pMnodeList);
+  STMT_ERR_RET(code);
+  if (onMnode) {
+    qDestroyQueryPlan(pPlan);
+    return TSDB_CODE_SUCCESS;
+  }
+  pRequest->pPreparedPlan = pPlan;
+
+  SStmtPlanCache* pCache = taosMemoryCalloc(1, sizeof(SStmtPlanCache));
+  if (NULL == pCache) {
+    STMT_ERR_RET(terrno);
+  }
+  bool valid = false;
+  code = stmtBuildPlanCache(pStmt, pCatalog, pPlan, pCache, &valid);
+  if (TSDB_CODE_SUCCESS == code && valid) {
+    pStmt->sql.pPlanCache = pCache;
+    STMT_DLOG("query plan cached, subplans:%d", pPlan->numOfSubplans);
+  } else {
+    stmtDestroyPlanCache(pCache);
+  }
+  STMT_RET(code);
+}
+
 int stmtBindBatch2(TAOS_STMT2* stmt, TAOS_STMT2_BIND* bind, int32_t colIdx) {
   STscStmt2* pStmt = (STscStmt2*)stmt;
   int32_t    code = 0;
@@ -1311,7 +1525,19 @@ int stmtBindBatch2(TAOS_STMT2* stmt, TAOS_STMT2_BIND* bind, int32_t colIdx) {
     ctx.mgmtEpSet = getEpSet_s(&pStmt->taos->pAppInfo->mgmtEp);
     STMT_ERR_RET(catalogGetHandle(pStmt->taos->pAppInfo->clusterId, &ctx.pCatalog));
 
-    STMT_ERR_RET(qStmtParseQuerySql(&ctx, pStmt->sql.pQuery));
+    // the plan cache needs all the values, binding column by column always translates
+    bool planCached = false;
+    qDestroyQueryPlan(pStmt->exec.pRequest->pPreparedPlan);
+    pStmt->exec.pRequest->pPreparedPlan = NULL;
+    if (tsStmtPlanCache && colIdx < 0) {
+      STMT_ERR_RET(stmtUseCachedPlan(pStmt, ctx.pCatalog, &planCached));
+    }
+    if (!planCached) {
+      STMT_ERR_RET(qStmtParseQuerySql(&ctx, pStmt->sql.pQuery));
+      if (tsStmtPlanCache && colIdx < 0) {
+        STMT_ERR_RET(stmtCachePlan(pStmt, ctx.pCatalog));
+      }
+    }
 
     if (pStmt->sql.pQuery->haveResultSet) {
       STMT_ERR_RET(setResSchemaInfo(&pStmt->exec.pRequest->body.resInfo, pStmt->sql.pQuery->pResSchema,
@@ -1427,6 +1653,301 @@ int stmtBindBatch2(TAOS_STMT2* stmt, TAOS_STMT2_BIND* bind, int32_t colIdx) {
 
   return TSDB_CODE_SUCCESS;
 }
+
+typedef struct SStmtArrowCol {
+  const struct ArrowSchema* pSchema;
+  const struct ArrowArray*  pArray;
+  int64_t                   offset;  // offset of the first row in the buffers of pArray
+  int32_t                   numOfRows;
+} SStmtArrowCol;
+
+static void* stmtArrowAlloc(SArray* pBufs, int64_t size) {
+  void* p = taosMemoryMalloc(TMAX(size, 1));
+  if (NULL == p) {
+    return NULL;
+  }
+  if (NULL == taosArrayPush(pBufs, &p)) {
+    taosMemoryFree(p);
+    return NULL;
+  }
+  return p;
+}
+
+static bool stmtArrowIsFixedFormat(const char* format, int8_t type) {
+  switch (type) {
+    case TSDB_DATA_TYPE_BOOL:
+      return 0 == strcmp(format, "b");
+    case TSDB_DATA_TYPE_TINYINT:
+      return 0 == strcmp(format, "c");
+    case TSDB_DATA_TYPE_UTINYINT:
+      return 0 == strcmp(format, "C");
+    case TSDB_DATA_TYPE_SMALLINT:
+      return 0 == strcmp(format, "s");
+    case TSDB_DATA_TYPE_USMALLINT:
+      return 0 == strcmp(format, "S");
+    case TSDB_DATA_TYPE_INT:
+      return 0 == strcmp(format, "i");
+    case TSDB_DATA_TYPE_UINT:
+      return 0 == strcmp(format, "I");
+    case TSDB_DATA_TYPE_BIGINT:
+      return 0 == strcmp(format, "l");
+    case TSDB_DATA_TYPE_UBIGINT:
+      return 0 == strcmp(format, "L");
+    case TSDB_DATA_TYPE_FLOAT:
+      return 0 == strcmp(format, "f");
+    case TSDB_DATA_TYPE_DOUBLE:
+      return 0 == strcmp(format, "g");
+    default:
+      return false;
+  }
+}
+
+// "tsm:", "tsu:" and "tsn:" carry the unit of the timestamp, a plain int64 is taken in the table precision
+static int32_t stmtArrowTsPrecision(const char* format, int32_t precision, int32_t* pFrom) {
+  if (0 == strcmp(format, "l")) {
+    *pFrom = precision;
+    return TSDB_CODE_SUCCESS;
+  }
+
+  if (strlen(format) < 4 || 0 != strncmp(format, "ts", 2) || format[3] != ':') {
+    return TSDB_CODE_INVALID_PARA;
+  }
+
+  switch (format[2]) {
+    case 'm':
+      *pFrom = TSDB_TIME_PRECISION_MILLI;
+      return TSDB_CODE_SUCCESS;
+    case 'u':
+      *pFrom = TSDB_TIME_PRECISION_MICRO;
+      return TSDB_CODE_SUCCESS;
+    case 'n':
+      *pFrom = TSDB_TIME_PRECISION_NANO;
+      return TSDB_CODE_SUCCESS;
+    default:
+      return TSDB_CODE_INVALID_PARA;
+  }
+}
+
+static int32_t stmtArrowBuildNull(const SStmtArrowCol* pCol, TAOS_STMT2_BIND* pBind, SArray* pBufs) {
+  const struct ArrowArray* pArray = pCol->pArray;
+  const uint8_t*           validity = (pArray->n_buffers > 0) ? (const uint8_t*)pArray->buffers[0] : NULL;
+
+  pBind->is_null = NULL;
+  if (NULL == validity || 0 == pArray->null_count) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  char* isNull = stmtArrowAlloc(pBufs, pCol->numOfRows);
+  if (NULL == isNull) {
+    return terrno;
+  }
+
+  // the validity bitmap is least significant bit first and a set bit means a value
+  for (int32_t i = 0; i < pCol->numOfRows; ++i) {
+    int64_t row = pCol->offset + i;
+    isNull[i] = ((validity[row >> 3] >> (row & 7)) & 1) ? 0 : 1;
+  }
+  pBind->is_null = isNull;
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t stmtArrowBuildFixed(const SStmtArrowCol* pCol, const TAOS_FIELD_E* pField, TAOS_STMT2_BIND* pBind,
+                                   SArray* pBufs) {
+  const struct ArrowArray* pArray = pCol->pArray;
+  const char*              format = pCol->pSchema->format;
+  int32_t                  bytes = tDataTypes[pField->type].bytes;
+
+  if (pArray->n_buffers < 2 || NULL == pArray->buffers[1]) {
+    return TSDB_CODE_INVALID_PARA;
+  }
+
+  if (TSDB_DATA_TYPE_BOOL == pField->type) {
+    if (!stmtArrowIsFixedFormat(format, pField->type)) {
+      return TSDB_CODE_INVALID_PARA;
+    }
+
+    // arrow keeps booleans as bits, they are expanded to one byte per row
+    const uint8_t* bits = (const uint8_t*)pArray->buffers[1];
+    int8_t*        pData = stmtArrowAlloc(pBufs, pCol->numOfRows);
+    if (NULL == pData) {
+      return terrno;
+    }
+    for (int32_t i = 0; i < pCol->numOfRows; ++i) {
+      int64_t row = pCol->offset + i;
+      pData[i] = (bits[row >> 3] >> (row & 7)) & 1;
+    }
+    pBind->buffer = pData;
+    return TSDB_CODE_SUCCESS;
+  }
+
+  const char* pSrc = (const char*)pArray->buffers[1] + pCol->offset * bytes;
+  if (TSDB_DATA_TYPE_TIMESTAMP == pField->type) {
+    int32_t from = 0;
+    if (TSDB_CODE_SUCCESS != stmtArrowTsPrecision(format, pField->precision, &from)) {
+      return TSDB_CODE_INVALID_PARA;
+    }
+
+    if (from != pField->precision) {
+      int64_t* pData = stmtArrowAlloc(pBufs, (int64_t)pCol->numOfRows * sizeof(int64_t));
+      if (NULL == pData) {
+        return terrno;
+      }
+      for (int32_t i = 0; i < pCol->numOfRows; ++i) {
+        pData[i] = convertTimePrecision(((const int64_t*)pSrc)[i], from, pField->precision);
+      }
+      pSrc = (const char*)pData;
+    }
+  } else if (!stmtArrowIsFixedFormat(format, pField->type)) {
+    return TSDB_CODE_INVALID_PARA;
+  }
+
+  // the values are bound in place, nothing is copied before the column data is built
+  pBind->buffer = (void*)pSrc;
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t stmtArrowBuildVar(const SStmtArrowCol* pCol, TAOS_STMT2_BIND* pBind, SArray* pBufs) {
+  const struct ArrowArray* pArray = pCol->pArray;
+  const char*              format = pCol->pSchema->format;
+  bool                     large = (0 == strcmp(format, "U") || 0 == strcmp(format, "Z"));
+
+  if (!large && 0 != strcmp(format, "u") && 0 != strcmp(format, "z")) {
+    return TSDB_CODE_INVALID_PARA;
+  }
+  if (pArray->n_buffers < 3 || NULL == pArray->buffers[1]) {
+    return TSDB_CODE_INVALID_PARA;
+  }
+
+  int32_t* pLength = stmtArrowAlloc(pBufs, (int64_t)pCol->numOfRows * sizeof(int32_t));
+  if (NULL == pLength) {
+    return terrno;
+  }
+
+#define STMT_ARROW_VAR_OFFSET(_i)                                                   \
+  (large ? ((const int64_t*)pArray->buffers[1])[pCol->offset + (_i)] \
+         : (int64_t)((const int32_t*)pArray->buffers[1])[pCol->offset + (_i)])
+
+  // a null slot may own bytes in arrow, the values are compacted only in that case
+  const char* pData = (const char*)pArray->buffers[2];
+  int64_t     first = STMT_ARROW_VAR_OFFSET(0);
+  int64_t     cursor = first;
+  int64_t     total = 0;
+  bool        compact = true;
+  for (int32_t i = 0; i < pCol->numOfRows; ++i) {
+    int64_t start = STMT_ARROW_VAR_OFFSET(i);
+    int64_t len = STMT_ARROW_VAR_OFFSET(i + 1) - start;
+    if (len < 0 || len > INT32_MAX) {
+      return TSDB_CODE_INVALID_PARA;
+    }
+
+    if (pBind->is_null && pBind->is_null[i]) {
+      pLength[i] = 0;
+      compact = compact && (0 == len);
+      continue;
+    }
+
+    pLength[i] = (int32_t)len;
+    compact = compact && (start == cursor);
+    cursor = start + len;
+    total += len;
+  }
+
+  if (compact || 0 == total) {
+    pBind->buffer = (void*)(pData + first);
+  } else {
+    char* pDst = stmtArrowAlloc(pBufs, total);
+    if (NULL == pDst) {
+      return terrno;
+    }
+    pBind->buffer = pDst;
+    for (int32_t i = 0; i < pCol->numOfRows; ++i) {
+      if (pBind->is_null && pBind->is_null[i]) {
+        continue;
+      }
+      (void)memcpy(pDst, pData + STMT_ARROW_VAR_OFFSET(i), pLength[i]);
+      pDst += pLength[i];
+    }
+  }
+
+#undef STMT_ARROW_VAR_OFFSET
+
+  pBind->length = pLength;
+  return TSDB_CODE_SUCCESS;
+}
+
+int stmtBindArrow2(TAOS_STMT2* stmt, struct ArrowSchema* pSchema, struct ArrowArray* pArray) {
+  STscStmt2*       pStmt = (STscStmt2*)stmt;
+  int32_t          code = 0;
+  int32_t          fieldNum = 0;
+  TAOS_FIELD_E*    pFields = NULL;
+  TAOS_STMT2_BIND* pBinds = NULL;
+  SArray*          pBufs = NULL;
+
+  STMT_DLOG("start to bind arrow array, rows:%" PRId64, pArray->length);
+
+  if (pStmt->errCode != TSDB_CODE_SUCCESS) {
+    return pStmt->errCode;
+  }
+
+  if (NULL == pSchema->format || 0 != strcmp(pSchema->format, "+s") || pSchema->n_children != pArray->n_children) {
+    tscError("arrow bind requires a struct array with one child for each bound column");
+    terrno = TSDB_CODE_INVALID_PARA;
+    return terrno;
+  }
+
+  STMT_ERR_RET(stmtFetchColFields2(pStmt, &fieldNum, &pFields));
+  if (fieldNum != pSchema->n_children) {
+    tscError("arrow children num %" PRId64 " mis-match with bound columns num %d", pSchema->n_children, fieldNum);
+    STMT_ERRI_JRET(TSDB_CODE_INVALID_PARA);
+  }
+
+  pBinds = taosMemoryCalloc(fieldNum, sizeof(TAOS_STMT2_BIND));
+  pBufs = taosArrayInit(fieldNum * 2, POINTER_BYTES);
+  if (NULL == pBinds || NULL == pBufs) {
+    STMT_ERRI_JRET(terrno);
+  }
+
+  for (int32_t c = 0; c < fieldNum; ++c) {
+    SStmtArrowCol col = {.pSchema = pSchema->children[c],
+                         .pArray = pArray->children[c],
+                         .offset = pArray->offset + pArray->children[c]->offset,
+                         .numOfRows = (int32_t)pArray->length};
+    TAOS_STMT2_BIND* pBind = &pBinds[c];
+
+    if (col.pArray->length < pArray->length || NULL == col.pSchema->format) {
+      STMT_ERRI_JRET(TSDB_CODE_INVALID_PARA);
+    }
+
+    pBind->buffer_type = pFields[c].type;
+    pBind->num = col.numOfRows;
+    STMT_ERRI_JRET(stmtArrowBuildNull(&col, pBind, pBufs));
+
+    if (IS_VAR_DATA_TYPE(pFields[c].type)) {
+      code = stmtArrowBuildVar(&col, pBind, pBufs);
+    } else {
+      code = stmtArrowBuildFixed(&col, &pFields[c], pBind, pBufs);
+    }
+    if (code) {
+      tscError("arrow format %s of column %s can not be bound to type %s", col.pSchema->format, pFields[c].name,
+               tDataTypes[pFields[c].type].name);
+      terrno = code;
+      goto _return;
+    }
+  }
+
+  code = stmtBindBatch2(stmt, pBinds, -1);
+
+_return:
+
+  for (int32_t i = 0; i < taosArrayGetSize(pBufs); ++i) {
+    taosMemoryFree(*(void**)taosArrayGet(pBufs, i));
+  }
+  taosArrayDestroy(pBufs);
+  taosMemoryFree(pBinds);
+  taosMemoryFree(pFields);
+
+  return code;
+}
 /*
 int stmtUpdateTableUid(STscStmt2* pStmt, SSubmitRsp* pRsp) {
   tscDebug("stmt start to update tbUid, blockNum: %d", pRsp->nBlocks);
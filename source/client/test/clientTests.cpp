@@ -15,7 +15,10 @@
 
 #include <gtest/gtest.h>
 #include <iostream>
+#include <vector>
 #include "clientInt.h"
+#include "clientStmt.h"
+#include "clientStmt2.h"
 #include "osSemaphore.h"
 #include "taoserror.h"
 #include "tglobal.h"
@@ -1610,4 +1613,289 @@ TEST(clientCase, timezone_Test) {
   }
 }
 
+namespace {
+
+int32_t syntaxCacheSize(TAOS* pConn) {
+  int64_t  rid = *(int64_t*)pConn;
+  STscObj* pTscObj = acquireTscObj(rid);
+  if (pTscObj == NULL) {
+    return -1;
+  }
+  int32_t size = (pTscObj->pSyntaxCache == NULL) ? -1 : taosHashGetSize(pTscObj->pSyntaxCache);
+  releaseTscObj(rid);
+  return size;
+}
+
+void execSql(TAOS* pConn, const char* sql) {
+  TAOS_RES* pRes = taos_query(pConn, sql);
+  ASSERT_EQ(taos_errno(pRes), TSDB_CODE_SUCCESS) << sql << ": " << taos_errstr(pRes);
+  taos_free_result(pRes);
+}
+
+// the first int column of every row and the number of columns
+void queryInts(TAOS* pConn, const char* sql, std::vector<int32_t>* pValues, int32_t* pNumOfFields) {
+  TAOS_RES* pRes = taos_query(pConn, sql);
+  ASSERT_EQ(taos_errno(pRes), TSDB_CODE_SUCCESS) << sql << ": " << taos_errstr(pRes);
+  *pNumOfFields = taos_num_fields(pRes);
+  pValues->clear();
+  TAOS_ROW pRow = NULL;
+  while ((pRow = taos_fetch_row(pRes)) != NULL) {
+    pValues->push_back(pRow[0] == NULL ? -1 : *(int32_t*)pRow[0]);
+  }
+  taos_free_result(pRes);
+}
+
+}  // namespace
+
+// queries served from the syntax cache of the connection see new rows and new columns, the cache is bounded by
+// querySyntaxCacheSize and dropped when the option is lowered
+TEST(clientCase, syntax_cache_Test) {
+  int32_t savedSize = tsQuerySyntaxCacheSize;
+  tsQuerySyntaxCacheSize = 0;
+  TAOS* pConn = taos_connect("localhost", "root", "taosdata", NULL, 0);
+  ASSERT_NE(pConn, nullptr);
+
+  // a connection made while the option is 0 gets its cache once the option is raised
+  execSql(pConn, "drop database if exists db_syntax_cache");
+  ASSERT_EQ(syntaxCacheSize(pConn), -1);
+  tsQuerySyntaxCacheSize = 2;
+  execSql(pConn, "create database db_syntax_cache");
+  execSql(pConn, "create table db_syntax_cache.t1 (ts timestamp, v int)");
+  execSql(pConn, "insert into db_syntax_cache.t1 values(1700000000000, 1)(1700000000001, 2)(1700000000002, 3)");
+  ASSERT_EQ(syntaxCacheSize(pConn), 0);
+
+  const char*          sql = "select v from db_syntax_cache.t1 order by ts";
+  std::vector<int32_t> values;
+  int32_t              numOfFields = 0;
+  queryInts(pConn, sql, &values, &numOfFields);
+  ASSERT_EQ(values, std::vector<int32_t>({1, 2, 3}));
+  ASSERT_EQ(syntaxCacheSize(pConn), 1);
+
+  // hit, the rows are read again
+  execSql(pConn, "insert into db_syntax_cache.t1 values(1700000000003, 4)");
+  queryInts(pConn, sql, &values, &numOfFields);
+  ASSERT_EQ(values, std::vector<int32_t>({1, 2, 3, 4}));
+  ASSERT_EQ(syntaxCacheSize(pConn), 1);
+
+  // the cached tree holds no meta, a new column is seen by the next hit
+  const char* starSql = "select * from db_syntax_cache.t1 order by ts";
+  queryInts(pConn, starSql, &values, &numOfFields);
+  ASSERT_EQ(numOfFields, 2);
+  ASSERT_EQ(syntaxCacheSize(pConn), 2);
+  execSql(pConn, "alter table db_syntax_cache.t1 add column c2 int");
+  queryInts(pConn, starSql, &values, &numOfFields);
+  ASSERT_EQ(numOfFields, 3);
+  ASSERT_EQ(values.size(), 4);
+
+  // the cache is full, a new sql is parsed but not cached
+  queryInts(pConn, "select v from db_syntax_cache.t1 where v > 2", &values, &numOfFields);
+  ASSERT_EQ(values, std::vector<int32_t>({3, 4}));
+  ASSERT_EQ(syntaxCacheSize(pConn), 2);
+
+  // the same text under another current database is another entry, lowering the option drops the entries
+  tsQuerySyntaxCacheSize = 1;
+  execSql(pConn, "use db_syntax_cache");
+  queryInts(pConn, "select v from t1 order by ts", &values, &numOfFields);
+  ASSERT_EQ(values, std::vector<int32_t>({1, 2, 3, 4}));
+  ASSERT_EQ(syntaxCacheSize(pConn), 1);
+
+  tsQuerySyntaxCacheSize = 0;
+  queryInts(pConn, sql, &values, &numOfFields);
+  ASSERT_EQ(values, std::vector<int32_t>({1, 2, 3, 4}));
+  ASSERT_EQ(syntaxCacheSize(pConn), 0);
+
+  tsQuerySyntaxCacheSize = savedSize;
+  execSql(pConn, "drop database db_syntax_cache");
+  taos_close(pConn);
+}
+
+namespace {
+
+// bind one value, execute the query and read the int column `col` of the result
+int32_t stmt2QueryInts(TAOS_STMT2* stmt, TAOS_STMT2_BIND* pBind, int32_t col, std::vector<int32_t>* pValues,
+                       int32_t* pNumOfFields) {
+  TAOS_STMT2_BINDV bindv = {1, NULL, NULL, &pBind};
+  int32_t          code = taos_stmt2_bind_param(stmt, &bindv, -1);
+  if (code == 0) {
+    code = taos_stmt2_exec(stmt, NULL);
+  }
+  if (code != 0) {
+    return code;
+  }
+
+  TAOS_RES* pRes = taos_stmt2_result(stmt);
+  *pNumOfFields = taos_num_fields(pRes);
+  pValues->clear();
+  TAOS_ROW pRow = NULL;
+  while ((pRow = taos_fetch_row(pRes)) != NULL) {
+    pValues->push_back(pRow[col] == NULL ? -1 : *(int32_t*)pRow[col]);
+  }
+  return 0;
+}
+
+SStmtPlanCache* stmt2PlanCache(TAOS_STMT2* stmt) { return ((STscStmt2*)stmt)->sql.pPlanCache; }
+
+int32_t dbVgVersion(TAOS* pConn, const char* dbFName) {
+  STscObj*  pTscObj = acquireTscObj(*(int64_t*)pConn);
+  SCatalog* pCatalog = NULL;
+  int32_t   vgVersion = -1, tableNum = 0;
+  int64_t   dbId = 0, stateTs = 0;
+  if (pTscObj != NULL && 0 == catalogGetHandle(pTscObj->pAppInfo->clusterId, &pCatalog)) {
+    (void)catalogGetDBVgVersion(pCatalog, dbFName, &vgVersion, &dbId, &tableNum, &stateTs);
+  }
+  releaseTscObj(*(int64_t*)pConn);
+  return vgVersion;
+}
+
+int32_t connAuthVer(TAOS* pConn) {
+  STscObj* pTscObj = acquireTscObj(*(int64_t*)pConn);
+  int32_t  authVer = (pTscObj == NULL) ? -1 : pTscObj->authVer;
+  releaseTscObj(*(int64_t*)pConn);
+  return authVer;
+}
+
+}  // namespace
+
+// a stmt2 query is planned once, the later executions bind their values into the saved plan until the types of the
+// values, the table schema, the vgroups of the db or the privileges of the user change
+TEST(clientCase, stmt2_plan_cache_Test) {
+  bool savedPlanCache = tsStmtPlanCache;
+  tsStmtPlanCache = true;
+  TAOS* pConn = taos_connect("localhost", "root", "taosdata", NULL, 0);
+  ASSERT_NE(pConn, nullptr);
+
+  execSql(pConn, "drop database if exists db_plan_cache");
+  execSql(pConn, "drop user if exists u_plan_cache");
+  execSql(pConn, "create database db_plan_cache vgroups 1");
+  execSql(pConn, "create table db_plan_cache.t1 (ts timestamp, v int)");
+  execSql(pConn,
+          "insert into db_plan_cache.t1 values(1700000000000, 1)(1700000000001, 2)(1700000000002, 3)"
+          "(1700000000003, 4)(1700000000004, 5)");
+
+  TAOS_STMT2_OPTION option = {0};
+  TAOS_STMT2*       stmt = taos_stmt2_init(pConn, &option);
+  ASSERT_NE(stmt, nullptr);
+  ASSERT_EQ(taos_stmt2_prepare(stmt, "select * from db_plan_cache.t1 where v > ?", 0), 0);
+
+  int32_t              iv = 2;
+  int64_t              bv = 0;
+  int32_t              ivLen = sizeof(iv), bvLen = sizeof(bv);
+  TAOS_STMT2_BIND      intBind = {TSDB_DATA_TYPE_INT, &iv, &ivLen, NULL, 1};
+  TAOS_STMT2_BIND      bigintBind = {TSDB_DATA_TYPE_BIGINT, &bv, &bvLen, NULL, 1};
+  std::vector<int32_t> values;
+  int32_t              numOfFields = 0;
+
+  // planned and saved, then served from the saved plan with the new values
+  ASSERT_EQ(stmt2QueryInts(stmt, &intBind, 1, &values, &numOfFields), 0);
+  ASSERT_EQ(values, std::vector<int32_t>({3, 4, 5}));
+  ASSERT_NE(stmt2PlanCache(stmt), nullptr);
+  ASSERT_EQ(stmt2PlanCache(stmt)->hits, 0);
+  iv = 3;
+  ASSERT_EQ(stmt2QueryInts(stmt, &intBind, 1, &values, &numOfFields), 0);
+  ASSERT_EQ(values, std::vector<int32_t>({4, 5}));
+  ASSERT_EQ(stmt2PlanCache(stmt)->hits, 1);
+
+  // another parameter type plans again
+  bv = 1;
+  ASSERT_EQ(stmt2QueryInts(stmt, &bigintBind, 1, &values, &numOfFields), 0);
+  ASSERT_EQ(values, std::vector<int32_t>({2, 3, 4, 5}));
+  ASSERT_NE(stmt2PlanCache(stmt), nullptr);
+  ASSERT_EQ(stmt2PlanCache(stmt)->hits, 0);
+  bv = 4;
+  ASSERT_EQ(stmt2QueryInts(stmt, &bigintBind, 1, &values, &numOfFields), 0);
+  ASSERT_EQ(values, std::vector<int32_t>({5}));
+  ASSERT_EQ(stmt2PlanCache(stmt)->hits, 1);
+
+  // a new schema version plans again and returns the new column
+  ASSERT_EQ(numOfFields, 2);
+  execSql(pConn, "alter table db_plan_cache.t1 add column c2 int");
+  iv = 0;
+  ASSERT_EQ(stmt2QueryInts(stmt, &intBind, 1, &values, &numOfFields), 0);
+  ASSERT_EQ(values, std::vector<int32_t>({1, 2, 3, 4, 5}));
+  ASSERT_EQ(numOfFields, 3);
+  ASSERT_EQ(stmt2PlanCache(stmt)->hits, 0);
+  ASSERT_EQ(stmt2QueryInts(stmt, &intBind, 1, &values, &numOfFields), 0);
+  ASSERT_EQ(stmt2PlanCache(stmt)->hits, 1);
+
+  // a new vgroup version of the db plans again, the table may have moved to another vgroup
+  {
+    TAOS_RES* pRes = taos_query(pConn, "show db_plan_cache.vgroups");
+    ASSERT_EQ(taos_errno(pRes), TSDB_CODE_SUCCESS);
+    TAOS_ROW pRow = taos_fetch_row(pRes);
+    ASSERT_NE(pRow, nullptr);
+    char sql[64] = {0};
+    (void)snprintf(sql, sizeof(sql), "split vgroup %d", *(int32_t*)pRow[0]);
+    taos_free_result(pRes);
+
+    int32_t vgVersion = dbVgVersion(pConn, "1.db_plan_cache");
+    execSql(pConn, sql);
+    for (int32_t i = 0; i < 60 && dbVgVersion(pConn, "1.db_plan_cache") == vgVersion; ++i) {
+      taosMsleep(500);
+      execSql(pConn, "select count(*) from db_plan_cache.t1");  // refreshes the vgroups of the db
+    }
+    ASSERT_NE(dbVgVersion(pConn, "1.db_plan_cache"), vgVersion);
+  }
+  iv = 1;
+  ASSERT_EQ(stmt2QueryInts(stmt, &intBind, 1, &values, &numOfFields), 0);
+  ASSERT_EQ(values, std::vector<int32_t>({2, 3, 4, 5}));
+  ASSERT_EQ(stmt2PlanCache(stmt)->hits, 0);
+  taos_stmt2_close(stmt);
+
+  // a new auth version of the connection plans again
+  execSql(pConn, "create user u_plan_cache pass 'taosdata'");
+  execSql(pConn, "grant read on db_plan_cache.* to u_plan_cache");
+  TAOS* pUserConn = taos_connect("localhost", "u_plan_cache", "taosdata", NULL, 0);
+  ASSERT_NE(pUserConn, nullptr);
+  stmt = taos_stmt2_init(pUserConn, &option);
+  ASSERT_NE(stmt, nullptr);
+  ASSERT_EQ(taos_stmt2_prepare(stmt, "select * from db_plan_cache.t1 where v > ?", 0), 0);
+  ASSERT_EQ(stmt2QueryInts(stmt, &intBind, 1, &values, &numOfFields), 0);
+  ASSERT_EQ(stmt2QueryInts(stmt, &intBind, 1, &values, &numOfFields), 0);
+  ASSERT_EQ(stmt2PlanCache(stmt)->hits, 1);
+  int32_t authVer = connAuthVer(pUserConn);
+  execSql(pConn, "grant write on db_plan_cache.* to u_plan_cache");
+  for (int32_t i = 0; i < 60 && connAuthVer(pUserConn) == authVer; ++i) {
+    taosMsleep(500);
+  }
+  ASSERT_NE(connAuthVer(pUserConn), authVer);
+  ASSERT_EQ(stmt2QueryInts(stmt, &intBind, 1, &values, &numOfFields), 0);
+  ASSERT_EQ(values, std::vector<int32_t>({2, 3, 4, 5}));
+  ASSERT_EQ(stmt2PlanCache(stmt)->hits, 0);
+  taos_stmt2_close(stmt);
+  taos_close(pUserConn);
+
+  // placeholders on the timestamp, the primary key or the table name are planned every time
+  execSql(pConn, "create table db_plan_cache.t2 (ts timestamp, pk int primary key, v int)");
+  execSql(pConn, "insert into db_plan_cache.t2 values(1700000000000, 1, 10)(1700000000000, 2, 20)");
+  execSql(pConn, "create stable db_plan_cache.st (ts timestamp, v int) tags (t int)");
+  execSql(pConn, "insert into db_plan_cache.ct1 using db_plan_cache.st tags(1) values(1700000000000, 1)");
+  int64_t     ts = 1700000000002LL;
+  int32_t     tsLen = sizeof(ts);
+  char        tbname[] = "ct1";
+  int32_t     tbnameLen = strlen(tbname);
+  const char* sqls[] = {"select * from db_plan_cache.t1 where ts > ?", "select v from db_plan_cache.t2 where pk = ?",
+                        "select v from db_plan_cache.st where tbname = ?"};
+  TAOS_STMT2_BIND binds[] = {{TSDB_DATA_TYPE_TIMESTAMP, &ts, &tsLen, NULL, 1},
+                             {TSDB_DATA_TYPE_INT, &iv, &ivLen, NULL, 1},
+                             {TSDB_DATA_TYPE_VARCHAR, tbname, &tbnameLen, NULL, 1}};
+  const std::vector<int32_t> expects[] = {{4, 5}, {20}, {1}};
+  iv = 2;
+  for (int32_t i = 0; i < sizeof(sqls) / sizeof(sqls[0]); ++i) {
+    stmt = taos_stmt2_init(pConn, &option);
+    ASSERT_NE(stmt, nullptr);
+    ASSERT_EQ(taos_stmt2_prepare(stmt, sqls[i], 0), 0) << sqls[i];
+    for (int32_t j = 0; j < 2; ++j) {
+      ASSERT_EQ(stmt2QueryInts(stmt, binds + i, i == 0 ? 1 : 0, &values, &numOfFields), 0) << sqls[i];
+      ASSERT_EQ(values, expects[i]) << sqls[i];
+      ASSERT_EQ(stmt2PlanCache(stmt), nullptr) << sqls[i];
+    }
+    taos_stmt2_close(stmt);
+  }
+
+  tsStmtPlanCache = savedPlanCache;
+  execSql(pConn, "drop user u_plan_cache");
+  execSql(pConn, "drop database db_plan_cache");
+  taos_close(pConn);
+}
+
 #pragma GCC diagnostic pop
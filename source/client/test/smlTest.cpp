@@ -591,6 +591,166 @@ TEST(testCase, smlParseTelnetLine_Test) {
 //  smlDestroyInfo(info);
 //}
 
+TEST(testCase, smlParseLineParallel_Test) {
+  SSmlHandle *info = nullptr;
+  int32_t     code = smlBuildSmlInfo(nullptr, &info);
+  ASSERT_EQ(code, 0);
+  info->protocol = TSDB_SML_LINE_PROTOCOL;
+
+  const int32_t numOfLines = 1000;
+  const int32_t numOfCTables = 7;
+  char        **lines = (char **)taosMemoryCalloc(numOfLines, POINTER_BYTES);
+  ASSERT_NE(lines, nullptr);
+  for (int32_t i = 0; i < numOfLines; ++i) {
+    lines[i] = (char *)taosMemoryCalloc(128, 1);
+    ASSERT_NE(lines[i], nullptr);
+    (void)snprintf(lines[i], 128, "st,t1=%d,t2=abc c1=%di64,c2=%d.5,c3=\"str\" %" PRId64, i % numOfCTables, i, i,
+                   1626006833639000000LL + i);
+  }
+  info->lineNum = numOfLines;
+
+  code = smlParseLineParallel(info, lines, nullptr, nullptr, numOfLines, 4);
+  ASSERT_EQ(code, 0);
+  ASSERT_EQ(info->dataFormat, false);
+  ASSERT_EQ(taosHashGetSize(info->childTables), numOfCTables);
+  for (int32_t i = 0; i < numOfLines; ++i) {
+    ASSERT_EQ(taosArrayGetSize(info->lines[i].colArray), 4);
+    SSmlKv *kv = (SSmlKv *)taosArrayGet(info->lines[i].colArray, 1);
+    ASSERT_EQ(kv->i, i);
+  }
+
+  // the uids are given again by the caller's handle, one per child table
+  SHashObj *uids = taosHashInit(16, taosGetDefaultHashFunction(TSDB_DATA_TYPE_UBIGINT), true, HASH_NO_LOCK);
+  ASSERT_NE(uids, nullptr);
+  void *p = taosHashIterate(info->childTables, NULL);
+  while (p != NULL) {
+    SSmlTableInfo *tinfo = *(SSmlTableInfo **)p;
+    ASSERT_EQ(taosHashPut(uids, &tinfo->uid, sizeof(tinfo->uid), &tinfo->uid, sizeof(tinfo->uid)), 0);
+    p = taosHashIterate(info->childTables, p);
+  }
+  ASSERT_EQ(taosHashGetSize(uids), numOfCTables);
+  taosHashCleanup(uids);
+
+  smlDestroyInfo(info);
+  for (int32_t i = 0; i < numOfLines; ++i) {
+    taosMemoryFree(lines[i]);
+  }
+  taosMemoryFree(lines);
+}
+
+TEST(testCase, smlParseNumber_fastPath_Test) {
+  SSmlKv     kv = {0};
+  char       buf[64] = {0};
+  SSmlMsgBuf msg = {0};
+  msg.buf = buf;
+  msg.len = 64;
+
+  // short decimals are converted without strtod and must give the same value
+  const char *str[] = {"23", "-23.125", "0.1", "123456789012.345", "1e3", "0x10", "12345678901234567890"};
+  for (int32_t i = 0; i < sizeof(str) / sizeof(str[0]); ++i) {
+    kv.value = str[i];
+    kv.length = strlen(str[i]);
+    ASSERT_TRUE(smlParseNumber(&kv, &msg));
+    ASSERT_EQ(kv.type, TSDB_DATA_TYPE_DOUBLE);
+    ASSERT_EQ(kv.d, strtod(str[i], NULL));
+  }
+
+  kv.value = "-9823i64";
+  kv.length = strlen(kv.value);
+  ASSERT_TRUE(smlParseNumber(&kv, &msg));
+  ASSERT_EQ(kv.type, TSDB_DATA_TYPE_BIGINT);
+  ASSERT_EQ(kv.i, -9823);
+
+  kv.value = "9223372036854775807i";
+  kv.length = strlen(kv.value);
+  ASSERT_TRUE(smlParseNumber(&kv, &msg));
+  ASSERT_EQ(kv.type, TSDB_DATA_TYPE_BIGINT);
+  ASSERT_EQ(kv.i, INT64_MAX);
+
+  kv.value = "3.7i";
+  kv.length = strlen(kv.value);
+  ASSERT_TRUE(smlParseNumber(&kv, &msg));
+  ASSERT_EQ(kv.i, 3);
+
+  kv.value = "-5u";
+  kv.length = strlen(kv.value);
+  ASSERT_FALSE(smlParseNumber(&kv, &msg));
+
+  kv.value = "8989323u64";
+  kv.length = strlen(kv.value);
+  ASSERT_TRUE(smlParseNumber(&kv, &msg));
+  ASSERT_EQ(kv.type, TSDB_DATA_TYPE_UBIGINT);
+  ASSERT_EQ(kv.u, 8989323);
+
+  ASSERT_EQ(smlGetTimeValue("1626006833639", 13, TSDB_TIME_PRECISION_MILLI, TSDB_TIME_PRECISION_MILLI),
+            1626006833639LL);
+  ASSERT_EQ(smlGetTimeValue("1626006833639000000", 19, TSDB_TIME_PRECISION_NANO, TSDB_TIME_PRECISION_MILLI),
+            1626006833639LL);
+  ASSERT_EQ(smlGetTimeValue("16260068a3639", 13, TSDB_TIME_PRECISION_MILLI, TSDB_TIME_PRECISION_MILLI), -1);
+
+  // 19 digits take the fast path up to INT64_MAX, a larger value must not wrap around
+  ASSERT_EQ(smlGetTimeValue("1626006833639123456", 19, TSDB_TIME_PRECISION_NANO, TSDB_TIME_PRECISION_NANO),
+            1626006833639123456LL);
+  ASSERT_EQ(smlGetTimeValue("9223372036854775807", 19, TSDB_TIME_PRECISION_NANO, TSDB_TIME_PRECISION_NANO),
+            INT64_MAX);
+  ASSERT_GE(smlGetTimeValue("9999999999999999999", 19, TSDB_TIME_PRECISION_NANO, TSDB_TIME_PRECISION_NANO), 0);
+  ASSERT_EQ(smlGetTimeValue("16260068336391234x6", 19, TSDB_TIME_PRECISION_NANO, TSDB_TIME_PRECISION_NANO), -1);
+}
+
+// parse telegraf like lines with the structural scanner on and off
+TEST(testCase, smlParseInfluxString_performance_Test) {
+  const char *lines[] = {
+      "cpu,cpu=cpu-total,host=telegraf-node-0042,region=us-west-2 usage_guest=0,usage_guest_nice=0,usage_idle="
+      "93.6734693877551,usage_iowait=0.10204081632653061,usage_irq=0,usage_nice=0,usage_softirq=0.20408163265306123,"
+      "usage_steal=0,usage_system=1.9387755102040816,usage_user=4.081632653061225 1626006833639000000",
+      "mem,host=telegraf-node-0042,region=us-west-2 active=2966847488i,available=12741615616i,available_percent="
+      "74.3194,buffered=345751552i,cached=6117195776i,free=6584029184i,total=17144279040i,used=4097302528i,"
+      "used_percent=23.898915 1626006833639000000",
+      "disk,device=nvme0n1p2,fstype=ext4,host=telegraf-node-0042,mode=rw,path=/ free=170268049408i,inodes_free="
+      "14468853i,inodes_total=15261696i,inodes_used=792843i,total=249809457152i,used=66781036544i,used_percent="
+      "28.17 1626006833639000000",
+      "syslog,appname=sshd,facility=auth,host=telegraf-node-0042,severity=info message=\"Accepted publickey for ops "
+      "from 10.0.0.8 port 51122\",procid=\"2231\",timestamp=1626006833639000000i 1626006833639000000"};
+  int32_t numOfLines = sizeof(lines) / sizeof(lines[0]);
+  int32_t loops = 200000;
+
+  SSmlHandle *info = nullptr;
+  int32_t     code = smlBuildSmlInfo(nullptr, &info);
+  ASSERT_EQ(code, 0);
+  info->protocol = TSDB_SML_LINE_PROTOCOL;
+  info->dataFormat = false;
+
+  // the parsed elements point into the line, so every line keeps its own buffer
+  char *sql[sizeof(lines) / sizeof(lines[0])] = {0};
+  for (int32_t i = 0; i < numOfLines; ++i) {
+    sql[i] = taosStrdup(lines[i]);
+    ASSERT_NE(sql[i], nullptr);
+  }
+
+  char simdEnable = tsSIMDEnable;
+  for (int32_t simd = 0; simd < 2; ++simd) {
+    tsSIMDEnable = simd;
+    int64_t bytes = 0;
+    int64_t t1 = taosGetTimestampUs();
+    for (int32_t i = 0; i < loops; ++i) {
+      char        *line = sql[i % numOfLines];
+      int32_t      len = strlen(line);
+      SSmlLineInfo elements = {0};
+      ASSERT_EQ(smlParseInfluxString(info, line, line + len, &elements), 0);
+      taosArrayDestroy(elements.colArray);
+      bytes += len;
+    }
+    int64_t cost = taosGetTimestampUs() - t1;
+    printf("smlParseInfluxString simd:%d lines:%d cost:%" PRId64 "us, %.2f MB/s\n", simd, loops, cost,
+           cost > 0 ? (double)bytes / cost : 0.0);
+  }
+  tsSIMDEnable = simdEnable;
+  smlDestroyInfo(info);
+  for (int32_t i = 0; i < numOfLines; ++i) {
+    taosMemoryFree(sql[i]);
+  }
+}
+
 TEST(testCase, smlParseNumber_performance_Test) {
   char       msg[256] = {0};
   SSmlMsgBuf msgBuf;
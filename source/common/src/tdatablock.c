@@ -1363,6 +1363,130 @@ static int32_t* createTupleIndex(size_t rows) {
 
 static void destroyTupleIndex(int32_t* index) { taosMemoryFreeClear(index); }
 
+#define BLOCK_SORT_NORM_KEY_MAX_LEN 32
+
+static bool blockDataSortKeyNormalizable(const SSDataBlock* pDataBlock, const SArray* pOrderInfo, int32_t* pKeyLen) {
+  int32_t keyLen = 0;
+  for (int32_t i = 0; i < taosArrayGetSize(pOrderInfo); ++i) {
+    SBlockOrderInfo* pInfo = taosArrayGet(pOrderInfo, i);
+    SColumnInfoData* pCol = (pInfo == NULL) ? NULL : taosArrayGet(pDataBlock->pDataBlock, pInfo->slotId);
+    if (pCol == NULL) {
+      return false;
+    }
+
+    switch (pCol->info.type) {
+      case TSDB_DATA_TYPE_BOOL:
+      case TSDB_DATA_TYPE_TINYINT:
+      case TSDB_DATA_TYPE_SMALLINT:
+      case TSDB_DATA_TYPE_INT:
+      case TSDB_DATA_TYPE_BIGINT:
+      case TSDB_DATA_TYPE_TIMESTAMP:
+      case TSDB_DATA_TYPE_UTINYINT:
+      case TSDB_DATA_TYPE_USMALLINT:
+      case TSDB_DATA_TYPE_UINT:
+      case TSDB_DATA_TYPE_UBIGINT:
+        break;
+      default:
+        return false;
+    }
+
+    keyLen += pCol->info.bytes + (pCol->hasNull ? 1 : 0);
+  }
+
+  *pKeyLen = keyLen;
+  return keyLen > 0 && keyLen <= BLOCK_SORT_NORM_KEY_MAX_LEN;
+}
+
+/*
+ * Encode the sort columns of each row into a byte string that orders the same way under memcmp as the
+ * column comparators do: signed values get their sign bit flipped and are stored big-endian, desc
+ * columns are bit-inverted, and a leading byte places nulls according to nullFirst.
+ */
+static void blockDataBuildNormKeys(const SSDataBlock* pDataBlock, const SArray* pOrderInfo, int32_t recSize,
+                                   char* pKeys) {
+  int32_t rows = pDataBlock->info.rows;
+  int32_t offset = 0;
+  for (int32_t i = 0; i < taosArrayGetSize(pOrderInfo); ++i) {
+    SBlockOrderInfo* pInfo = taosArrayGet(pOrderInfo, i);
+    SColumnInfoData* pCol = taosArrayGet(pDataBlock->pDataBlock, pInfo->slotId);
+    int32_t          bytes = pCol->info.bytes;
+    bool             isSigned = IS_CONVERT_AS_SIGNED(pCol->info.type);
+    uint64_t         mask = (bytes == sizeof(uint64_t)) ? UINT64_MAX : ((1ULL << (bytes * 8)) - 1);
+    uint64_t         signBit = 1ULL << (bytes * 8 - 1);
+
+    for (int32_t r = 0; r < rows; ++r) {
+      uint8_t* pKey = (uint8_t*)pKeys + (int64_t)r * recSize + offset;
+      if (pCol->hasNull) {
+        if (colDataIsNull_f(pCol->nullbitmap, r)) {
+          pKey[0] = pInfo->nullFirst ? 0 : 2;
+          memset(pKey + 1, 0, bytes);
+          continue;
+        }
+        pKey[0] = 1;
+        pKey += 1;
+      }
+
+      uint64_t v = 0;
+      char*    pData = pCol->pData + (int64_t)r * bytes;
+      switch (bytes) {
+        case sizeof(int8_t):
+          v = (uint8_t)*(int8_t*)pData;
+          break;
+        case sizeof(int16_t):
+          v = (uint16_t)*(int16_t*)pData;
+          break;
+        case sizeof(int32_t):
+          v = (uint32_t)*(int32_t*)pData;
+          break;
+        default:
+          v = (uint64_t)*(int64_t*)pData;
+          break;
+      }
+
+      if (isSigned) {
+        v ^= signBit;
+      }
+      if (pInfo->order == TSDB_ORDER_DESC) {
+        v = ~v & mask;
+      }
+      for (int32_t b = bytes - 1; b >= 0; --b) {
+        pKey[b] = (uint8_t)(v & 0xFF);
+        v >>= 8;
+      }
+    }
+
+    offset += bytes + (pCol->hasNull ? 1 : 0);
+  }
+
+  for (int32_t r = 0; r < rows; ++r) {
+    *(int32_t*)(pKeys + (int64_t)r * recSize + recSize - sizeof(int32_t)) = r;
+  }
+}
+
+static int32_t blockDataNormKeyCompar(const void* p1, const void* p2, const void* param) {
+  return memcmp(p1, p2, *(const int32_t*)param);
+}
+
+static int32_t blockDataSortIndexByNormKey(const SSDataBlock* pDataBlock, const SArray* pOrderInfo, int32_t keyLen,
+                                           int32_t* index) {
+  int32_t rows = pDataBlock->info.rows;
+  int32_t recSize = ALIGN_NUM(keyLen, sizeof(int32_t)) + sizeof(int32_t);
+  char*   pKeys = taosMemoryMalloc((int64_t)rows * recSize);
+  if (pKeys == NULL) {
+    return terrno;
+  }
+
+  blockDataBuildNormKeys(pDataBlock, pOrderInfo, recSize, pKeys);
+  taosqsort_r(pKeys, rows, recSize, &keyLen, blockDataNormKeyCompar);
+
+  for (int32_t r = 0; r < rows; ++r) {
+    index[r] = *(int32_t*)(pKeys + (int64_t)r * recSize + recSize - sizeof(int32_t));
+  }
+
+  taosMemoryFree(pKeys);
+  return TSDB_CODE_SUCCESS;
+}
+
 int32_t blockDataSort(SSDataBlock* pDataBlock, SArray* pOrderInfo) {
   if (pDataBlock->info.rows <= 1) {
     return TSDB_CODE_SUCCESS;
@@ -1426,29 +1550,42 @@ int32_t blockDataSort(SSDataBlock* pDataBlock, SArray* pOrderInfo) {
   }
 
   int64_t p0 = taosGetTimestampUs();
+  int32_t code = TSDB_CODE_SUCCESS;
+  int32_t keyLen = 0;
 
-  SSDataBlockSortHelper helper = {.pDataBlock = pDataBlock, .orderInfo = pOrderInfo};
-  for (int32_t i = 0; i < taosArrayGetSize(helper.orderInfo); ++i) {
-    struct SBlockOrderInfo* pInfo = taosArrayGet(helper.orderInfo, i);
-    if (pInfo == NULL) {
-      continue;
+  if (blockDataSortKeyNormalizable(pDataBlock, pOrderInfo, &keyLen)) {
+    code = blockDataSortIndexByNormKey(pDataBlock, pOrderInfo, keyLen, index);
+    if (code != 0) {
+      destroyTupleIndex(index);
+      return code;
     }
+  } else {
+    SSDataBlockSortHelper helper = {.pDataBlock = pDataBlock, .orderInfo = pOrderInfo};
+    for (int32_t i = 0; i < taosArrayGetSize(helper.orderInfo); ++i) {
+      struct SBlockOrderInfo* pInfo = taosArrayGet(helper.orderInfo, i);
+      if (pInfo == NULL) {
+        continue;
+      }
 
-    pInfo->pColData = taosArrayGet(pDataBlock->pDataBlock, pInfo->slotId);
-    if (pInfo->pColData == NULL) {
-      continue;
+      pInfo->pColData = taosArrayGet(pDataBlock->pDataBlock, pInfo->slotId);
+      if (pInfo->pColData == NULL) {
+        continue;
+      }
+      pInfo->compFn = getKeyComparFunc(pInfo->pColData->info.type, pInfo->order);
     }
-    pInfo->compFn = getKeyComparFunc(pInfo->pColData->info.type, pInfo->order);
-  }
 
-  terrno = 0;
-  taosqsort_r(index, rows, sizeof(int32_t), &helper, dataBlockCompar);
-  if (terrno) return terrno;
+    terrno = 0;
+    taosqsort_r(index, rows, sizeof(int32_t), &helper, dataBlockCompar);
+    if (terrno) {
+      destroyTupleIndex(index);
+      return terrno;
+    }
+  }
 
   int64_t p1 = taosGetTimestampUs();
 
   SColumnInfoData* pCols = NULL;
-  int32_t code = createHelpColInfoData(pDataBlock, &pCols);
+  code = createHelpColInfoData(pDataBlock, &pCols);
   if (code != 0) {
     destroyTupleIndex(index);
     return code;
@@ -1469,6 +1606,44 @@ int32_t blockDataSort(SSDataBlock* pDataBlock, SArray* pOrderInfo) {
   return TSDB_CODE_SUCCESS;
 }
 
+int32_t blockDataGather(SSDataBlock* pDst, const SSDataBlock* pSrc, const int32_t* index) {
+  size_t numOfCols = taosArrayGetSize(pSrc->pDataBlock);
+  if (taosArrayGetSize(pDst->pDataBlock) != numOfCols) {
+    return TSDB_CODE_INVALID_PARA;
+  }
+
+  blockDataCleanup(pDst);
+  int32_t code = blockDataEnsureCapacity(pDst, pSrc->info.rows);
+  if (code != TSDB_CODE_SUCCESS) {
+    return code;
+  }
+
+  for (int32_t i = 0; i < numOfCols; ++i) {
+    SColumnInfoData* pSrcCol = taosArrayGet(pSrc->pDataBlock, i);
+    SColumnInfoData* pDstCol = taosArrayGet(pDst->pDataBlock, i);
+    if (pSrcCol == NULL || pDstCol == NULL || pSrcCol->info.type != pDstCol->info.type ||
+        pSrcCol->info.bytes != pDstCol->info.bytes) {
+      return TSDB_CODE_INVALID_PARA;
+    }
+
+    // the var data payload is copied as a whole, only the offsets are reordered
+    code = colDataReserve(pDstCol, pSrcCol->varmeta.length);
+    if (code != TSDB_CODE_SUCCESS) {
+      return code;
+    }
+    pDstCol->hasNull = pSrcCol->hasNull;
+  }
+
+  blockDataAssign(TARRAY_DATA(pDst->pDataBlock), pSrc, index);
+  pDst->info.rows = pSrc->info.rows;
+  pDst->info.id = pSrc->info.id;
+  pDst->info.scanFlag = pSrc->info.scanFlag;
+  pDst->info.window = pSrc->info.window;
+  pDst->info.version = pSrc->info.version;
+  pDst->info.dataLoad = pSrc->info.dataLoad;
+  return TSDB_CODE_SUCCESS;
+}
+
 void blockDataCleanup(SSDataBlock* pDataBlock) {
   blockDataEmpty(pDataBlock);
   SDataBlockInfo* pInfo = &pDataBlock->info;
@@ -3291,6 +3466,209 @@ int32_t blockDecode(SSDataBlock* pBlock, const char* pData, const char** pEndPos
   return code;
 }
 
+/*
+ * Columnar compression of a buffer produced by blockEncode. The header of the encoded block is kept as it is, the
+ * null bitmap/offsets and the data of each column are stored as segments | codec:int8 | len:int32 | payload |, the
+ * offsets of var data columns are compressed as int, the data with the codec of the column type.
+ */
+#define BLOCK_SEG_RAW      0
+#define BLOCK_SEG_TYPED    1
+#define BLOCK_SEG_HEAD_LEN (sizeof(int8_t) + sizeof(int32_t))
+
+static bool blockIsLossyType(int8_t type) {
+#ifdef TD_TSZ
+  return (TSDB_DATA_TYPE_FLOAT == type && lossyFloat) || (TSDB_DATA_TYPE_DOUBLE == type && lossyDouble);
+#else
+  return false;
+#endif
+}
+
+// returns the length of the segment, or -1 if the output buffer is too small
+static int32_t blockCompressSegment(int8_t type, int32_t nEle, const char* pIn, int32_t nIn, char* pOut,
+                                    int32_t outLen) {
+  if (outLen < (int32_t)BLOCK_SEG_HEAD_LEN + nIn + COMP_OVERFLOW_BYTES) {
+    return -1;
+  }
+
+  char*   pPayload = pOut + BLOCK_SEG_HEAD_LEN;
+  int32_t len = -1;
+  if (nIn > 0 && NULL != tDataTypes[type].compFunc && !blockIsLossyType(type)) {
+    len = tDataTypes[type].compFunc((void*)pIn, nIn, nEle, pPayload, nIn + COMP_OVERFLOW_BYTES, ONE_STAGE_COMP, NULL,
+                                    0);
+  }
+
+  if (len > 0 && len < nIn) {
+    *(int8_t*)pOut = BLOCK_SEG_TYPED;
+  } else {
+    *(int8_t*)pOut = BLOCK_SEG_RAW;
+    len = nIn;
+    if (nIn > 0) {
+      (void)memcpy(pPayload, pIn, nIn);
+    }
+  }
+  *(int32_t*)(pOut + sizeof(int8_t)) = len;
+  return BLOCK_SEG_HEAD_LEN + len;
+}
+
+static int32_t blockDecompressSegment(int8_t type, int32_t nEle, const char* pIn, int32_t inLen, char* pOut,
+                                      int32_t nOut) {
+  if (inLen < (int32_t)BLOCK_SEG_HEAD_LEN) {
+    return -1;
+  }
+
+  int8_t      codec = *(int8_t*)pIn;
+  int32_t     len = *(int32_t*)(pIn + sizeof(int8_t));
+  const char* pPayload = pIn + BLOCK_SEG_HEAD_LEN;
+  if (len < 0 || len > inLen - (int32_t)BLOCK_SEG_HEAD_LEN) {
+    return -1;
+  }
+
+  if (BLOCK_SEG_RAW == codec) {
+    if (len != nOut) {
+      return -1;
+    }
+    if (len > 0) {
+      (void)memcpy(pOut, pPayload, len);
+    }
+  } else if (BLOCK_SEG_TYPED == codec && NULL != tDataTypes[type].decompFunc) {
+    if (tDataTypes[type].decompFunc((void*)pPayload, len, nEle, pOut, nOut, ONE_STAGE_COMP, NULL, 0) != nOut) {
+      return -1;
+    }
+  } else {
+    return -1;
+  }
+  return BLOCK_SEG_HEAD_LEN + len;
+}
+
+static int32_t blockCompressColumnar(const char* pEncoded, int32_t rawLen, char* pOut, int32_t outLen) {
+  int32_t numOfRows = *(int32_t*)(pEncoded + sizeof(int32_t) * 2);
+  int32_t numOfCols = *(int32_t*)(pEncoded + sizeof(int32_t) * 3);
+  int32_t headLen = blockDataGetSerialMetaSize(numOfCols) - sizeof(bool);
+  if (outLen < headLen + (int32_t)sizeof(bool) || rawLen < headLen + (int32_t)sizeof(bool)) {
+    return rawLen;
+  }
+
+  const char* pSchema = pEncoded + sizeof(int32_t) * 5 + sizeof(uint64_t);
+  const int32_t* colSizes = (const int32_t*)(pSchema + numOfCols * (sizeof(int8_t) + sizeof(int32_t)));
+  const char*    pIn = pEncoded + headLen;
+  char*          pPos = pOut + headLen;
+  char*          pEnd = pOut + outLen;
+  (void)memcpy(pOut, pEncoded, headLen);
+
+  for (int32_t i = 0; i < numOfCols; ++i) {
+    int8_t  type = *(int8_t*)(pSchema + i * (sizeof(int8_t) + sizeof(int32_t)));
+    int32_t colSize = ntohl(colSizes[i]);
+    bool    isVar = IS_VAR_DATA_TYPE(type);
+    int32_t metaLen = isVar ? numOfRows * sizeof(int32_t) : BitmapLen(numOfRows);
+
+    // the offsets of var data columns are ascending except the null rows, the bitmap is kept as it is
+    int32_t len = blockCompressSegment(isVar ? TSDB_DATA_TYPE_INT : TSDB_DATA_TYPE_NULL, numOfRows, pIn, metaLen, pPos,
+                                       pEnd - pPos);
+    if (len < 0) {
+      return rawLen;
+    }
+    pIn += metaLen;
+    pPos += len;
+
+    len = blockCompressSegment(type, isVar ? 1 : numOfRows, pIn, colSize, pPos, pEnd - pPos);
+    if (len < 0) {
+      return rawLen;
+    }
+    pIn += colSize;
+    pPos += len;
+
+    if (pPos - pOut >= rawLen) {
+      return rawLen;
+    }
+  }
+
+  if (pPos - pOut + (int32_t)sizeof(bool) >= rawLen) {
+    return rawLen;
+  }
+  *(bool*)pPos = *(bool*)pIn;
+  pPos += sizeof(bool);
+  return pPos - pOut;
+}
+
+static int32_t blockDecompressColumnar(const char* pIn, int32_t compLen, char* pOut, int32_t rawLen) {
+  int32_t numOfRows = *(int32_t*)(pIn + sizeof(int32_t) * 2);
+  int32_t numOfCols = *(int32_t*)(pIn + sizeof(int32_t) * 3);
+  int32_t headLen = blockDataGetSerialMetaSize(numOfCols) - sizeof(bool);
+  if (numOfCols < 0 || compLen < headLen + (int32_t)sizeof(bool) || rawLen < headLen + (int32_t)sizeof(bool)) {
+    return -1;
+  }
+
+  const char*    pSchema = pIn + sizeof(int32_t) * 5 + sizeof(uint64_t);
+  const int32_t* colSizes = (const int32_t*)(pSchema + numOfCols * (sizeof(int8_t) + sizeof(int32_t)));
+  const char*    pPos = pIn + headLen;
+  const char*    pEnd = pIn + compLen;
+  char*          pDst = pOut + headLen;
+  char*          pDstEnd = pOut + rawLen;
+  (void)memcpy(pOut, pIn, headLen);
+
+  for (int32_t i = 0; i < numOfCols; ++i) {
+    int8_t  type = *(int8_t*)(pSchema + i * (sizeof(int8_t) + sizeof(int32_t)));
+    int32_t colSize = ntohl(colSizes[i]);
+    bool    isVar = IS_VAR_DATA_TYPE(type);
+    int32_t metaLen = isVar ? numOfRows * sizeof(int32_t) : BitmapLen(numOfRows);
+    if (colSize < 0 || pDstEnd - pDst < metaLen + colSize) {
+      return -1;
+    }
+
+    int32_t len = blockDecompressSegment(isVar ? TSDB_DATA_TYPE_INT : TSDB_DATA_TYPE_NULL, numOfRows, pPos,
+                                         pEnd - pPos, pDst, metaLen);
+    if (len < 0) {
+      return -1;
+    }
+    pPos += len;
+    pDst += metaLen;
+
+    len = blockDecompressSegment(type, isVar ? 1 : numOfRows, pPos, pEnd - pPos, pDst, colSize);
+    if (len < 0) {
+      return -1;
+    }
+    pPos += len;
+    pDst += colSize;
+  }
+
+  if (pEnd - pPos != sizeof(bool) || pDstEnd - pDst != sizeof(bool)) {
+    return -1;
+  }
+  *(bool*)pDst = *(bool*)pPos;
+  return rawLen;
+}
+
+int32_t blockCompressEncoded(int8_t compressType, const char* pEncoded, int32_t rawLen, char* pOut, int32_t outLen) {
+  switch (compressType) {
+    case BLOCK_COMPRESS_LZ4:
+      return tsCompressString((void*)pEncoded, rawLen, 1, pOut, outLen, ONE_STAGE_COMP, NULL, 0);
+    case BLOCK_COMPRESS_COLUMNAR:
+      return blockCompressColumnar(pEncoded, rawLen, pOut, outLen);
+    default:
+      return rawLen;
+  }
+}
+
+int32_t blockDecompressEncoded(int8_t compressType, const char* pIn, int32_t compLen, char* pOut, int32_t rawLen) {
+  int32_t len = -1;
+  switch (compressType) {
+    case BLOCK_COMPRESS_LZ4:
+      len = tsDecompressString((void*)pIn, compLen, 1, pOut, rawLen, ONE_STAGE_COMP, NULL, 0);
+      break;
+    case BLOCK_COMPRESS_COLUMNAR:
+      len = blockDecompressColumnar(pIn, compLen, pOut, rawLen);
+      break;
+    default:
+      break;
+  }
+
+  if (len != rawLen) {
+    uError("failed to decompress block, compress type:%d, len:%d, rawLen:%d", compressType, len, rawLen);
+    return TSDB_CODE_QRY_EXECUTOR_INTERNAL_ERROR;
+  }
+  return TSDB_CODE_SUCCESS;
+}
+
 int32_t trimDataBlock(SSDataBlock* pBlock, int32_t totalRows, const bool* pBoolList) {
   //  int32_t totalRows = pBlock->info.rows;
   int32_t code = 0;
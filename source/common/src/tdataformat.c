@@ -3108,6 +3108,60 @@ _exit:
   return code;
 }
 
+static bool tBindHasNone(const char *isNull, int32_t num) {
+  for (int32_t i = 0; i < num; ++i) {
+    if ((uint8_t)isNull[i] > 1) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/* append a run of fixed-length values with one copy
+ * `isNull` is NULL when all rows are values, otherwise the column must be empty and `isNull` holds only 0 and 1
+ */
+static int32_t tColDataPutFixedValues(SColData *pColData, const uint8_t *pData, const char *isNull, int32_t num) {
+  int32_t code = 0;
+  int32_t bytes = TYPE_BYTES[pColData->type];
+  int64_t size = (int64_t)bytes * num;
+
+  code = tRealloc(&pColData->pData, pColData->nData + size);
+  if (code) return code;
+
+  uint8_t *pDst = pColData->pData + pColData->nData;
+  (void)memcpy(pDst, pData, size);
+  if (TSDB_DATA_TYPE_BOOL == pColData->type) {
+    for (int32_t i = 0; i < num; ++i) {
+      if (pDst[i] > 1) {
+        pDst[i] = 1;
+      }
+    }
+  }
+
+  int32_t numOfNull = 0;
+  if (isNull) {
+    code = tRealloc(&pColData->pBitMap, BIT1_SIZE(num));
+    if (code) return code;
+
+    (void)memset(pColData->pBitMap, 0, BIT1_SIZE(num));
+    for (int32_t i = 0; i < num; ++i) {
+      if (isNull[i]) {
+        (void)memset(pDst + (int64_t)bytes * i, 0, bytes);
+        numOfNull++;
+      } else {
+        pColData->pBitMap[DIV_8(i)] |= (ONE << MOD_8(i));
+      }
+    }
+  }
+
+  pColData->flag = (numOfNull > 0) ? (HAS_VALUE | HAS_NULL) : HAS_VALUE;
+  pColData->nData += size;
+  pColData->nVal += num;
+  pColData->numOfValue += num - numOfNull;
+  pColData->numOfNull += numOfNull;
+  return code;
+}
+
 int32_t tColDataAddValueByBind2(SColData *pColData, TAOS_STMT2_BIND *pBind, int32_t buffMaxLen) {
   int32_t code = 0;
 
@@ -3160,8 +3214,9 @@ int32_t tColDataAddValueByBind2(SColData *pColData, TAOS_STMT2_BIND *pBind, int3
       goto _exit;
     }
 
-    if (allValue) {
-      // optimize (todo)
+    if (allValue && (0 == pColData->flag || HAS_VALUE == pColData->flag)) {
+      code = tColDataPutFixedValues(pColData, (uint8_t *)pBind->buffer, NULL, pBind->num);
+    } else if (allValue) {
       for (int32_t i = 0; i < pBind->num; ++i) {
         uint8_t *val = (uint8_t *)pBind->buffer + TYPE_BYTES[pColData->type] * i;
         if (TSDB_DATA_TYPE_BOOL == pColData->type && *val > 1) {
@@ -3182,6 +3237,8 @@ int32_t tColDataAddValueByBind2(SColData *pColData, TAOS_STMT2_BIND *pBind, int3
         code = tColDataAppendValueImpl[pColData->flag][CV_FLAG_NONE](pColData, NULL, 0);
         if (code) goto _exit;
       }
+    } else if (0 == pColData->flag && !tBindHasNone(pBind->is_null, pBind->num)) {
+      code = tColDataPutFixedValues(pColData, (uint8_t *)pBind->buffer, pBind->is_null, pBind->num);
     } else {
       for (int32_t i = 0; i < pBind->num; ++i) {
         if (pBind->is_null[i]) {
@@ -141,6 +141,7 @@ char *tsSvrCrashReportUri = "/dcrashreport";
 // schemaless
 bool tsSmlDot2Underline = true;
 char tsSmlTsDefaultName[TSDB_COL_NAME_LEN] = "_ts";
+int32_t tsSmlParseThreads = 1;  // threads parsing one large line protocol batch, 1: parse on the calling thread
 char tsSmlTagName[TSDB_COL_NAME_LEN] = "_tag_null";
 char tsSmlChildTableName[TSDB_TABLE_NAME_LEN] = "";  // user defined child table name can be specified in tag value.
 char tsSmlAutoChildTableNameDelimiter[TSDB_TABLE_NAME_LEN] = "";
@@ -165,6 +166,9 @@ int32_t tmqRowSize = 4096;
 int32_t tsQueryPolicy = 1;
 bool    tsQueryTbNotExistAsEmpty = false;
 int32_t tsQueryRspPolicy = 0;
+int32_t tsQueryResultCacheSize = 0;  // MB of the results of historical subplans cached by each vnode, 0: disabled
+int32_t tsQueryTaskMemBudget = 0;    // MB of buffers a query task keeps in memory before spilling, 0: unlimited
+int32_t tsQueryNodeMemBudget = 0;    // MB of buffers all query tasks of a dnode keep in memory, 0: unlimited
 int64_t tsQueryMaxConcurrentTables = 200;  // unit is TSDB_TABLE_NUM_UNIT
 bool    tsEnableQueryHb = true;
 bool    tsEnableScience = false;  // on taos-cli show float and doulbe with scientific notation if true
@@ -173,6 +177,7 @@ int32_t tsQueryRsmaTolerance = 1000;  // the tolerance time (ms) to judge from w
 bool    tsQueryPlannerTrace = false;
 int32_t tsQueryNodeChunkSize = 32 * 1024;
 bool    tsQueryUseNodeAllocator = true;
+int32_t tsQueryMaxFollowerLag = -1;  // max wal versions a follower may lag behind to serve queries, -1: leader only
 bool    tsKeepColumnName = false;
 int32_t tsRedirectPeriod = 10;
 int32_t tsRedirectFactor = 2;
@@ -210,6 +215,15 @@ int32_t tsMinIntervalTime = 1;
 
 // maximum batch rows numbers imported from a single csv load
 int32_t tsMaxInsertBatchRows = 1000000;
+int32_t tsInsertFileParseThreads = 1;  // threads parsing the csv file of INSERT ... FILE, 1: parse on the calling thread
+int32_t tsQuerySyntaxCacheSize = 0;    // parsed queries cached per connection, 0: disabled
+bool    tsStmtPlanCache = false;       // reuse the physical plan of stmt2 queries across executions
+bool    tsQueryColumnarCompress = false;  // request the per column compression of the result blocks of remote tasks
+int32_t tsQueryVnodeParallelism = 1;   // number of tasks a super table scan is split into on each vgroup
+// Every shard of a vgroup still lists all the child tables and runs the tag filter before it keeps its own uid % N
+// share, so N shards repeat that work N times unless tagFilterCache is on. Size the shards for heavy aggregations.
+int32_t tsQueryPartTableShardSize = 0;  // child tables per task of an aggregation partitioned by table, 0: off
+bool    tsQueryLowLatency = false;  // return the first rows of queries at once, growing the batches afterwards
 
 float   tsSelectivityRatio = 1.0;
 int32_t tsTagFilterResCacheSize = 1024 * 10;
@@ -581,6 +595,8 @@ static int32_t taosAddClientCfg(SConfig *pCfg) {
                                 CFG_DYN_CLIENT));
   TAOS_CHECK_RETURN(
       cfgAddBool(pCfg, "queryUseNodeAllocator", tsQueryUseNodeAllocator, CFG_SCOPE_CLIENT, CFG_DYN_CLIENT));
+  TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "queryMaxFollowerLag", tsQueryMaxFollowerLag, -1, INT32_MAX, CFG_SCOPE_CLIENT,
+                                CFG_DYN_CLIENT));
   TAOS_CHECK_RETURN(cfgAddBool(pCfg, "keepColumnName", tsKeepColumnName, CFG_SCOPE_CLIENT, CFG_DYN_CLIENT));
   TAOS_CHECK_RETURN(cfgAddString(pCfg, "smlChildTableName", tsSmlChildTableName, CFG_SCOPE_CLIENT, CFG_DYN_CLIENT));
   TAOS_CHECK_RETURN(cfgAddString(pCfg, "smlAutoChildTableNameDelimiter", tsSmlAutoChildTableNameDelimiter,
@@ -588,9 +604,22 @@ static int32_t taosAddClientCfg(SConfig *pCfg) {
   TAOS_CHECK_RETURN(cfgAddString(pCfg, "smlTagName", tsSmlTagName, CFG_SCOPE_CLIENT, CFG_DYN_CLIENT));
   TAOS_CHECK_RETURN(cfgAddString(pCfg, "smlTsDefaultName", tsSmlTsDefaultName, CFG_SCOPE_CLIENT, CFG_DYN_CLIENT));
   TAOS_CHECK_RETURN(cfgAddBool(pCfg, "smlDot2Underline", tsSmlDot2Underline, CFG_SCOPE_CLIENT, CFG_DYN_CLIENT));
+  TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "smlParseThreads", tsSmlParseThreads, 1, 64, CFG_SCOPE_CLIENT, CFG_DYN_CLIENT));
   TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "maxShellConns", tsMaxShellConns, 10, 50000000, CFG_SCOPE_CLIENT, CFG_DYN_NONE));
   TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "maxInsertBatchRows", tsMaxInsertBatchRows, 1, INT32_MAX, CFG_SCOPE_CLIENT,
                                 CFG_DYN_CLIENT) != 0);
+  TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "insertFileParseThreads", tsInsertFileParseThreads, 1, 64, CFG_SCOPE_CLIENT,
+                                CFG_DYN_CLIENT));
+  TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "querySyntaxCacheSize", tsQuerySyntaxCacheSize, 0, 100000, CFG_SCOPE_CLIENT,
+                                CFG_DYN_CLIENT));
+  TAOS_CHECK_RETURN(cfgAddBool(pCfg, "stmtPlanCache", tsStmtPlanCache, CFG_SCOPE_CLIENT, CFG_DYN_CLIENT));
+  TAOS_CHECK_RETURN(
+      cfgAddBool(pCfg, "queryColumnarCompress", tsQueryColumnarCompress, CFG_SCOPE_CLIENT, CFG_DYN_CLIENT));
+  TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "queryVnodeParallelism", tsQueryVnodeParallelism, 1, 64, CFG_SCOPE_CLIENT,
+                                CFG_DYN_CLIENT));
+  TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "queryPartTableShardSize", tsQueryPartTableShardSize, 0, INT32_MAX,
+                                CFG_SCOPE_CLIENT, CFG_DYN_CLIENT));
+  TAOS_CHECK_RETURN(cfgAddBool(pCfg, "queryLowLatency", tsQueryLowLatency, CFG_SCOPE_CLIENT, CFG_DYN_CLIENT));
   TAOS_CHECK_RETURN(
       cfgAddInt32(pCfg, "maxRetryWaitTime", tsMaxRetryWaitTime, 0, 86400000, CFG_SCOPE_BOTH, CFG_DYN_CLIENT));
   TAOS_CHECK_RETURN(cfgAddBool(pCfg, "useAdapter", tsUseAdapter, CFG_SCOPE_CLIENT, CFG_DYN_CLIENT));
@@ -621,7 +650,7 @@ static int32_t taosAddClientCfg(SConfig *pCfg) {
   tsNumOfTaskQueueThreads = TMAX(tsNumOfTaskQueueThreads, 16);
 
   TAOS_CHECK_RETURN(
-      cfgAddInt32(pCfg, "numOfTaskQueueThreads", tsNumOfTaskQueueThreads, 4, 1024, CFG_SCOPE_CLIENT, CFG_DYN_NONE));
+      cfgAddInt32(pCfg, "numOfTaskQueueThreads", tsNumOfTaskQueueThreads, 4, 1024, CFG_SCOPE_BOTH, CFG_DYN_NONE));
   TAOS_CHECK_RETURN(cfgAddBool(pCfg, "experimental", tsExperimental, CFG_SCOPE_BOTH, CFG_DYN_BOTH));
 
   TAOS_CHECK_RETURN(cfgAddBool(pCfg, "multiResultFunctionStarReturnTags", tsMultiResultFunctionStarReturnTags,
@@ -716,6 +745,12 @@ static int32_t taosAddServerCfg(SConfig *pCfg) {
 
   TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "queryBufferSize", tsQueryBufferSize, -1, 500000000000, CFG_SCOPE_SERVER, CFG_DYN_NONE));
   TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "queryRspPolicy", tsQueryRspPolicy, 0, 1, CFG_SCOPE_SERVER, CFG_DYN_ENT_SERVER));
+  TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "queryResultCacheSize", tsQueryResultCacheSize, 0, 65536, CFG_SCOPE_SERVER,
+                                CFG_DYN_ENT_SERVER));
+  TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "queryTaskMemBudget", tsQueryTaskMemBudget, 0, 1048576, CFG_SCOPE_SERVER,
+                                CFG_DYN_ENT_SERVER));
+  TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "queryNodeMemBudget", tsQueryNodeMemBudget, 0, 1048576, CFG_SCOPE_SERVER,
+                                CFG_DYN_ENT_SERVER));
   TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "numOfCommitThreads", tsNumOfCommitThreads, 1, 1024, CFG_SCOPE_SERVER, CFG_DYN_NONE));
   TAOS_CHECK_RETURN(cfgAddInt32(pCfg, "retentionSpeedLimitMB", tsRetentionSpeedLimitMB, 0, 1024, CFG_SCOPE_SERVER, CFG_DYN_NONE));
 
@@ -1180,9 +1215,33 @@ static int32_t taosSetClientCfg(SConfig *pCfg) {
   TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "smlDot2Underline");
   tsSmlDot2Underline = pItem->bval;
 
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "smlParseThreads");
+  tsSmlParseThreads = pItem->i32;
+
   TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "maxInsertBatchRows");
   tsMaxInsertBatchRows = pItem->i32;
 
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "insertFileParseThreads");
+  tsInsertFileParseThreads = pItem->i32;
+
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "querySyntaxCacheSize");
+  tsQuerySyntaxCacheSize = pItem->i32;
+
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "stmtPlanCache");
+  tsStmtPlanCache = pItem->bval;
+
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "queryColumnarCompress");
+  tsQueryColumnarCompress = pItem->bval;
+
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "queryVnodeParallelism");
+  tsQueryVnodeParallelism = pItem->i32;
+
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "queryPartTableShardSize");
+  tsQueryPartTableShardSize = pItem->i32;
+
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "queryLowLatency");
+  tsQueryLowLatency = pItem->bval;
+
   TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "shellActivityTimer");
   tsShellActivityTimer = pItem->i32;
 
@@ -1216,6 +1275,9 @@ static int32_t taosSetClientCfg(SConfig *pCfg) {
   TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "queryUseNodeAllocator");
   tsQueryUseNodeAllocator = pItem->bval;
 
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "queryMaxFollowerLag");
+  tsQueryMaxFollowerLag = pItem->i32;
+
   TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "keepColumnName");
   tsKeepColumnName = pItem->bval;
 
@@ -1436,6 +1498,15 @@ static int32_t taosSetServerCfg(SConfig *pCfg) {
   TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "queryRspPolicy");
   tsQueryRspPolicy = pItem->i32;
 
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "queryResultCacheSize");
+  tsQueryResultCacheSize = pItem->i32;
+
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "queryTaskMemBudget");
+  tsQueryTaskMemBudget = pItem->i32;
+
+  TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "queryNodeMemBudget");
+  tsQueryNodeMemBudget = pItem->i32;
+
   TAOS_CHECK_GET_CFG_ITEM(pCfg, pItem, "monitorLogProtocol");
   tsMonitorLogProtocol = pItem->bval;
 
@@ -1986,6 +2057,9 @@ static int32_t taosCfgDynamicOptionsForServer(SConfig *pCfg, const char *name) {
                                          {"mqRebalanceInterval", &tsMqRebalanceInterval},
                                          {"numOfLogLines", &tsNumOfLogLines},
                                          {"queryRspPolicy", &tsQueryRspPolicy},
+                                         {"queryResultCacheSize", &tsQueryResultCacheSize},
+                                         {"queryTaskMemBudget", &tsQueryTaskMemBudget},
+                                         {"queryNodeMemBudget", &tsQueryNodeMemBudget},
                                          {"timeseriesThreshold", &tsTimeSeriesThreshold},
                                          {"tmqMaxTopicNum", &tmqMaxTopicNum},
                                          {"tmqRowSize", &tmqRowSize},
@@ -2240,6 +2314,13 @@ static int32_t taosCfgDynamicOptionsForClient(SConfig *pCfg, const char *name) {
                                          {"keepAliveIdle", &tsKeepAliveIdle},
                                          {"logKeepDays", &tsLogKeepDays},
                                          {"maxInsertBatchRows", &tsMaxInsertBatchRows},
+                                         {"insertFileParseThreads", &tsInsertFileParseThreads},
+                                         {"querySyntaxCacheSize", &tsQuerySyntaxCacheSize},
+                                         {"stmtPlanCache", &tsStmtPlanCache},
+                                         {"queryColumnarCompress", &tsQueryColumnarCompress},
+                                         {"queryVnodeParallelism", &tsQueryVnodeParallelism},
+                                         {"queryPartTableShardSize", &tsQueryPartTableShardSize},
+                                         {"queryLowLatency", &tsQueryLowLatency},
                                          {"maxRetryWaitTime", &tsMaxRetryWaitTime},
                                          {"minSlidingTime", &tsMinSlidingTime},
                                          {"minIntervalTime", &tsMinIntervalTime},
@@ -2250,10 +2331,12 @@ static int32_t taosCfgDynamicOptionsForClient(SConfig *pCfg, const char *name) {
                                          {"queryPlannerTrace", &tsQueryPlannerTrace},
                                          {"queryNodeChunkSize", &tsQueryNodeChunkSize},
                                          {"queryUseNodeAllocator", &tsQueryUseNodeAllocator},
+                                         {"queryMaxFollowerLag", &tsQueryMaxFollowerLag},
                                          {"randErrorChance", &tsRandErrChance},
                                          {"randErrorDivisor", &tsRandErrDivisor},
                                          {"randErrorScope", &tsRandErrScope},
                                          {"smlDot2Underline", &tsSmlDot2Underline},
+                                         {"smlParseThreads", &tsSmlParseThreads},
                                          {"shellActivityTimer", &tsShellActivityTimer},
                                          {"useAdapter", &tsUseAdapter},
                                          {"experimental", &tsExperimental},
@@ -499,6 +499,20 @@ int32_t tSerializeSClientHbBatchReq(void *buf, int32_t bufLen, const SClientHbBa
   }
 
   TAOS_CHECK_EXIT(tEncodeI64(&encoder, pBatchReq->ipWhiteList));
+
+  // peak memory of the queries, appended to keep the batch compatible with the old version
+  for (int32_t i = 0; i < reqNum; i++) {
+    SClientHbReq *pReq = taosArrayGet(pBatchReq->reqs, i);
+    if (pReq->connKey.connType != CONN_TYPE__QUERY || NULL == pReq->query) {
+      continue;
+    }
+
+    int32_t num = taosArrayGetSize(pReq->query->queryDesc);
+    for (int32_t j = 0; j < num; ++j) {
+      SQueryDesc *desc = taosArrayGet(pReq->query->queryDesc, j);
+      TAOS_CHECK_EXIT(tEncodeI64(&encoder, desc->peakMem));
+    }
+  }
   tEndEncode(&encoder);
 
 _exit:
@@ -540,6 +554,19 @@ int32_t tDeserializeSClientHbBatchReq(void *buf, int32_t bufLen, SClientHbBatchR
     TAOS_CHECK_EXIT(tDecodeI64(&decoder, &pBatchReq->ipWhiteList));
   }
 
+  for (int32_t i = 0; i < reqNum && !tDecodeIsEnd(&decoder); i++) {
+    SClientHbReq *pReq = taosArrayGet(pBatchReq->reqs, i);
+    if (pReq->connKey.connType != CONN_TYPE__QUERY || NULL == pReq->query) {
+      continue;
+    }
+
+    int32_t num = taosArrayGetSize(pReq->query->queryDesc);
+    for (int32_t j = 0; j < num; ++j) {
+      SQueryDesc *desc = taosArrayGet(pReq->query->queryDesc, j);
+      TAOS_CHECK_EXIT(tDecodeI64(&decoder, &desc->peakMem));
+    }
+  }
+
   tEndDecode(&decoder);
 
 _exit:
@@ -8382,6 +8409,8 @@ int32_t tSerializeSSubQueryMsg(void *buf, int32_t bufLen, SSubQueryMsg *pReq) {
   TAOS_CHECK_EXIT(tEncodeCStrWithLen(&encoder, pReq->sql, pReq->sqlLen));
   TAOS_CHECK_EXIT(tEncodeU32(&encoder, pReq->msgLen));
   TAOS_CHECK_EXIT(tEncodeBinary(&encoder, (uint8_t *)pReq->msg, pReq->msgLen));
+  TAOS_CHECK_EXIT(tEncodeI32(&encoder, pReq->maxFollowerLag));
+  TAOS_CHECK_EXIT(tEncodeI8(&encoder, pReq->lowLatency));
 
   tEndEncode(&encoder);
 
@@ -8403,13 +8432,10 @@ _exit:
   }
 }
 
-int32_t tDeserializeSSubQueryMsg(void *buf, int32_t bufLen, SSubQueryMsg *pReq) {
-  int32_t   code = 0;
-  int32_t   lino;
-  int32_t   headLen = sizeof(SMsgHead);
-  SMsgHead *pHead = buf;
-  pHead->vgId = pReq->header.vgId;
-  pHead->contLen = pReq->header.contLen;
+static int32_t tDecodeSSubQueryMsg(void *buf, int32_t bufLen, SSubQueryMsg *pReq, bool withBody) {
+  int32_t code = 0;
+  int32_t lino;
+  int32_t headLen = sizeof(SMsgHead);
 
   SDecoder decoder = {0};
   tDecoderInit(&decoder, (char *)buf + headLen, bufLen - headLen);
@@ -8427,9 +8453,29 @@ int32_t tDeserializeSSubQueryMsg(void *buf, int32_t bufLen, SSubQueryMsg *pReq)
   TAOS_CHECK_EXIT(tDecodeI8(&decoder, &pReq->needFetch));
   TAOS_CHECK_EXIT(tDecodeI8(&decoder, &pReq->compress));
   TAOS_CHECK_EXIT(tDecodeU32(&decoder, &pReq->sqlLen));
-  TAOS_CHECK_EXIT(tDecodeCStrAlloc(&decoder, &pReq->sql));
+  if (withBody) {
+    TAOS_CHECK_EXIT(tDecodeCStrAlloc(&decoder, &pReq->sql));
+  } else {
+    char *sql = NULL;
+    TAOS_CHECK_EXIT(tDecodeCStr(&decoder, &sql));
+  }
   TAOS_CHECK_EXIT(tDecodeU32(&decoder, &pReq->msgLen));
-  TAOS_CHECK_EXIT(tDecodeBinaryAlloc(&decoder, (void **)&pReq->msg, NULL));
+  if (withBody) {
+    TAOS_CHECK_EXIT(tDecodeBinaryAlloc(&decoder, (void **)&pReq->msg, NULL));
+  } else {
+    uint8_t *msg = NULL;
+    TAOS_CHECK_EXIT(tDecodeBinary(&decoder, &msg, NULL));
+  }
+  if (!tDecodeIsEnd(&decoder)) {
+    TAOS_CHECK_EXIT(tDecodeI32(&decoder, &pReq->maxFollowerLag));
+  } else {
+    pReq->maxFollowerLag = -1;
+  }
+  if (!tDecodeIsEnd(&decoder)) {
+    TAOS_CHECK_EXIT(tDecodeI8(&decoder, &pReq->lowLatency));
+  } else {
+    pReq->lowLatency = 0;
+  }
 
   tEndDecode(&decoder);
 
@@ -8438,6 +8484,18 @@ _exit:
   return code;
 }
 
+int32_t tDeserializeSSubQueryMsg(void *buf, int32_t bufLen, SSubQueryMsg *pReq) {
+  SMsgHead *pHead = buf;
+  pHead->vgId = pReq->header.vgId;
+  pHead->contLen = pReq->header.contLen;
+
+  return tDecodeSSubQueryMsg(buf, bufLen, pReq, true);
+}
+
+int32_t tDeserializeSSubQueryMsgHead(void *buf, int32_t bufLen, SSubQueryMsg *pReq) {
+  return tDecodeSSubQueryMsg(buf, bufLen, pReq, false);
+}
+
 void tFreeSSubQueryMsg(SSubQueryMsg *pReq) {
   if (NULL == pReq) {
     return;
@@ -8536,6 +8594,22 @@ int32_t tDeserializeSOperatorParam(SDecoder *pDecoder, SOperatorParam *pOpParam)
   return 0;
 }
 
+void tPutFetchRspPeakMem(SRetrieveTableRsp *pRsp, int32_t dataLen, int64_t peakMem) {
+  int64_t val = htobe64(peakMem);
+  (void)memcpy(pRsp->data + dataLen, &val, FETCH_RSP_PEAK_MEM_LEN);
+}
+
+// 0 if the rsp has no trailer, e.g. it is sent by an older version
+int64_t tGetFetchRspPeakMem(const SRetrieveTableRsp *pRsp, int32_t dataLen, int32_t msgLen) {
+  if (msgLen < (int32_t)sizeof(SRetrieveTableRsp) + dataLen + FETCH_RSP_PEAK_MEM_LEN) {
+    return 0;
+  }
+
+  int64_t val = 0;
+  (void)memcpy(&val, pRsp->data + dataLen, FETCH_RSP_PEAK_MEM_LEN);
+  return (int64_t)htobe64(val);
+}
+
 int32_t tSerializeSResFetchReq(void *buf, int32_t bufLen, SResFetchReq *pReq) {
   int32_t code = 0;
   int32_t lino;
@@ -8559,6 +8633,13 @@ int32_t tSerializeSResFetchReq(void *buf, int32_t bufLen, SResFetchReq *pReq) {
   } else {
     TAOS_CHECK_EXIT(tEncodeI32(&encoder, 0));
   }
+  TAOS_CHECK_EXIT(tEncodeI32(&encoder, pReq->credit));
+  TAOS_CHECK_EXIT(tEncodeI8(&encoder, pReq->hasRuntimeRange));
+  if (pReq->hasRuntimeRange) {
+    TAOS_CHECK_EXIT(tEncodeI64(&encoder, pReq->runtimeRange.skey));
+    TAOS_CHECK_EXIT(tEncodeI64(&encoder, pReq->runtimeRange.ekey));
+  }
+  TAOS_CHECK_EXIT(tEncodeI8(&encoder, pReq->withPeakMem));
 
   tEndEncode(&encoder);
 
@@ -8608,6 +8689,19 @@ int32_t tDeserializeSResFetchReq(void *buf, int32_t bufLen, SResFetchReq *pReq)
     }
     TAOS_CHECK_EXIT(tDeserializeSOperatorParam(&decoder, pReq->pOpParam));
   }
+  if (!tDecodeIsEnd(&decoder)) {
+    TAOS_CHECK_EXIT(tDecodeI32(&decoder, &pReq->credit));
+  }
+  if (!tDecodeIsEnd(&decoder)) {
+    TAOS_CHECK_EXIT(tDecodeI8(&decoder, &pReq->hasRuntimeRange));
+    if (pReq->hasRuntimeRange) {
+      TAOS_CHECK_EXIT(tDecodeI64(&decoder, &pReq->runtimeRange.skey));
+      TAOS_CHECK_EXIT(tDecodeI64(&decoder, &pReq->runtimeRange.ekey));
+    }
+  }
+  if (!tDecodeIsEnd(&decoder)) {
+    TAOS_CHECK_EXIT(tDecodeI8(&decoder, &pReq->withPeakMem));
+  }
 
   tEndDecode(&decoder);
 
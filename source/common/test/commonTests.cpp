@@ -304,6 +304,190 @@ TEST(testCase, Datablock_test) {
   taosArrayDestroy(pOrderInfo);
 }
 
+TEST(testCase, Datablock_gather_test) {
+  SSDataBlock* b = NULL;
+  int32_t      code = createDataBlock(&b);
+  ASSERT(code == 0);
+
+  SColumnInfoData infoData = createColumnInfoData(TSDB_DATA_TYPE_INT, 4, 1);
+  blockDataAppendColInfo(b, &infoData);
+
+  SColumnInfoData infoData1 = createColumnInfoData(TSDB_DATA_TYPE_BINARY, 40, 2);
+  blockDataAppendColInfo(b, &infoData1);
+  blockDataEnsureCapacity(b, 10);
+
+  char buf[128] = {0};
+  char varbuf[128] = {0};
+
+  SColumnInfoData* p0 = (SColumnInfoData*)taosArrayGet(b->pDataBlock, 0);
+  SColumnInfoData* p1 = (SColumnInfoData*)taosArrayGet(b->pDataBlock, 1);
+  for (int32_t i = 0; i < 10; ++i) {
+    sprintf(buf, "row %d", i);
+    STR_TO_VARSTR(varbuf, buf)
+    colDataSetVal(p0, i, (const char*)&i, (i == 3));
+    colDataSetVal(p1, i, (const char*)varbuf, false);
+    b->info.rows++;
+  }
+  b->info.id.groupId = 7;
+
+  SSDataBlock* d = NULL;
+  ASSERT_EQ(createOneDataBlock(b, false, &d), 0);
+
+  int32_t index[10] = {9, 3, 0, 8, 1, 7, 2, 6, 4, 5};
+  ASSERT_EQ(blockDataGather(d, b, index), 0);
+  ASSERT_EQ(blockDataGetNumOfRows(d), 10);
+  ASSERT_EQ(d->info.id.groupId, 7);
+
+  SColumnInfoData* d0 = (SColumnInfoData*)taosArrayGet(d->pDataBlock, 0);
+  SColumnInfoData* d1 = (SColumnInfoData*)taosArrayGet(d->pDataBlock, 1);
+  for (int32_t i = 0; i < 10; ++i) {
+    if (index[i] == 3) {
+      ASSERT_EQ(colDataIsNull_f(d0->nullbitmap, i), true);
+    } else {
+      ASSERT_EQ(colDataIsNull_f(d0->nullbitmap, i), false);
+      ASSERT_EQ(*(int32_t*)colDataGetData(d0, i), index[i]);
+    }
+
+    sprintf(buf, "row %d", index[i]);
+    char* pData = colDataGetData(d1, i);
+    ASSERT_EQ(varDataLen(pData), strlen(buf));
+    ASSERT_EQ(strncmp(varDataVal(pData), buf, varDataLen(pData)), 0);
+  }
+
+  // the source block is left untouched
+  for (int32_t i = 0; i < 10; ++i) {
+    ASSERT_EQ(colDataIsNull_f(p0->nullbitmap, i), i == 3);
+    if (i != 3) {
+      ASSERT_EQ(*(int32_t*)colDataGetData(p0, i), i);
+    }
+
+    sprintf(buf, "row %d", i);
+    char* pData = colDataGetData(p1, i);
+    ASSERT_EQ(strncmp(varDataVal(pData), buf, varDataLen(pData)), 0);
+  }
+
+  // gathering again reuses the destination
+  int32_t rev[10] = {9, 8, 7, 6, 5, 4, 3, 2, 1, 0};
+  ASSERT_EQ(blockDataGather(d, b, rev), 0);
+  ASSERT_EQ(blockDataGetNumOfRows(d), 10);
+  for (int32_t i = 0; i < 10; ++i) {
+    ASSERT_EQ(colDataIsNull_f(d0->nullbitmap, i), rev[i] == 3);
+  }
+
+  blockDataDestroy(d);
+  blockDataDestroy(b);
+}
+
+TEST(testCase, Datablock_columnar_compress_test) {
+  SSDataBlock* b = NULL;
+  int32_t      code = createDataBlock(&b);
+  ASSERT(code == 0);
+
+  SColumnInfoData infoData = createColumnInfoData(TSDB_DATA_TYPE_TIMESTAMP, 8, 1);
+  blockDataAppendColInfo(b, &infoData);
+  SColumnInfoData infoData1 = createColumnInfoData(TSDB_DATA_TYPE_DOUBLE, 8, 2);
+  blockDataAppendColInfo(b, &infoData1);
+  SColumnInfoData infoData2 = createColumnInfoData(TSDB_DATA_TYPE_BINARY, 40, 3);
+  blockDataAppendColInfo(b, &infoData2);
+
+  int32_t numOfRows = 1000;
+  blockDataEnsureCapacity(b, numOfRows);
+
+  char buf[128] = {0};
+  char varbuf[128] = {0};
+
+  SColumnInfoData* p0 = (SColumnInfoData*)taosArrayGet(b->pDataBlock, 0);
+  SColumnInfoData* p1 = (SColumnInfoData*)taosArrayGet(b->pDataBlock, 1);
+  SColumnInfoData* p2 = (SColumnInfoData*)taosArrayGet(b->pDataBlock, 2);
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    int64_t ts = 1700000000000 + i * 1000;
+    double  v = 20.5 + (i % 7) * 0.25;
+    sprintf(buf, "device %d", i % 4);
+    STR_TO_VARSTR(varbuf, buf)
+    colDataSetVal(p0, i, (const char*)&ts, false);
+    colDataSetVal(p1, i, (const char*)&v, (i % 10 == 3));
+    colDataSetVal(p2, i, (const char*)varbuf, (i % 10 == 5));
+    b->info.rows++;
+  }
+
+  int32_t rawLen = blockGetEncodeSize(b);
+  char*   pRaw = (char*)taosMemoryCalloc(1, rawLen);
+  char*   pComp = (char*)taosMemoryCalloc(1, rawLen);
+  char*   pDecomp = (char*)taosMemoryCalloc(1, rawLen);
+  int32_t dataLen = blockEncode(b, pRaw, 3);
+  ASSERT_GT(dataLen, 0);
+
+  int32_t compLen = blockCompressEncoded(BLOCK_COMPRESS_COLUMNAR, pRaw, dataLen, pComp, rawLen);
+  ASSERT_GT(compLen, 0);
+  ASSERT_LT(compLen, dataLen / 2);
+  ASSERT_EQ(blockDecompressEncoded(BLOCK_COMPRESS_COLUMNAR, pComp, compLen, pDecomp, dataLen), 0);
+  ASSERT_EQ(memcmp(pRaw, pDecomp, dataLen), 0);
+
+  ASSERT_NE(blockDecompressEncoded(BLOCK_COMPRESS_COLUMNAR, pComp, compLen - 1, pDecomp, dataLen), 0);
+
+  taosMemoryFree(pRaw);
+  taosMemoryFree(pComp);
+  taosMemoryFree(pDecomp);
+  blockDataDestroy(b);
+}
+
+TEST(testCase, Datablock_normkey_sort_test) {
+  SSDataBlock* b = NULL;
+  int32_t      code = createDataBlock(&b);
+  ASSERT(code == 0);
+
+  SColumnInfoData infoData = createColumnInfoData(TSDB_DATA_TYPE_INT, 4, 1);
+  blockDataAppendColInfo(b, &infoData);
+
+  SColumnInfoData infoData1 = createColumnInfoData(TSDB_DATA_TYPE_BIGINT, 8, 2);
+  blockDataAppendColInfo(b, &infoData1);
+  blockDataEnsureCapacity(b, 100);
+
+  SColumnInfoData* p0 = (SColumnInfoData*)taosArrayGet(b->pDataBlock, 0);
+  SColumnInfoData* p1 = (SColumnInfoData*)taosArrayGet(b->pDataBlock, 1);
+  for (int32_t i = 0; i < 100; ++i) {
+    int32_t v0 = (i % 7) - 3;
+    int64_t v1 = (int64_t)i * ((i & 0x01) ? -1 : 1);
+    colDataSetVal(p0, i, (const char*)&v0, (i % 10 == 0));
+    colDataSetVal(p1, i, (const char*)&v1, false);
+    b->info.rows++;
+  }
+
+  SArray*         pOrderInfo = taosArrayInit(2, sizeof(SBlockOrderInfo));
+  SBlockOrderInfo order0 = {true, TSDB_ORDER_ASC, 0, NULL};
+  SBlockOrderInfo order1 = {false, TSDB_ORDER_DESC, 1, NULL};
+  taosArrayPush(pOrderInfo, &order0);
+  taosArrayPush(pOrderInfo, &order1);
+
+  ASSERT_EQ(blockDataSort(b, pOrderInfo), 0);
+  ASSERT_EQ(blockDataGetNumOfRows(b), 100);
+
+  p0 = (SColumnInfoData*)taosArrayGet(b->pDataBlock, 0);
+  p1 = (SColumnInfoData*)taosArrayGet(b->pDataBlock, 1);
+  for (int32_t i = 0; i < 10; ++i) {
+    ASSERT_EQ(colDataIsNull_f(p0->nullbitmap, i), true);
+  }
+  for (int32_t i = 1; i < 100; ++i) {
+    if (i < 10) {
+      ASSERT_GE(*(int64_t*)colDataGetData(p1, i - 1), *(int64_t*)colDataGetData(p1, i));
+      continue;
+    }
+    ASSERT_EQ(colDataIsNull_f(p0->nullbitmap, i), false);
+    if (i == 10) {
+      continue;
+    }
+    int32_t prev = *(int32_t*)colDataGetData(p0, i - 1);
+    int32_t cur = *(int32_t*)colDataGetData(p0, i);
+    ASSERT_LE(prev, cur);
+    if (prev == cur) {
+      ASSERT_GE(*(int64_t*)colDataGetData(p1, i - 1), *(int64_t*)colDataGetData(p1, i));
+    }
+  }
+
+  blockDataDestroy(b);
+  taosArrayDestroy(pOrderInfo);
+}
+
 #if 0
 TEST(testCase, non_var_dataBlock_split_test) {
   SSDataBlock* b = static_cast<SSDataBlock*>(taosMemoryCalloc(1, sizeof(SSDataBlock)));
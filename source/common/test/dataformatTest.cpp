@@ -619,3 +619,74 @@ for (int r = 0; r < nRows; ++r) {
   taosMemoryFree(pTSchema);
 }
 #endif
+
+TEST(testCase, ColDataAddValueByBind2) {
+  SColData colData = {0};
+  tColDataInit(&colData, 2, TSDB_DATA_TYPE_INT, 0);
+
+  int32_t         values[5] = {1, 2, 3, 4, 5};
+  char            isNull[5] = {0, 1, 0, 0, 1};
+  TAOS_STMT2_BIND bind = {TSDB_DATA_TYPE_INT, values, NULL, isNull, 5};
+  ASSERT_EQ(tColDataAddValueByBind2(&colData, &bind, -1), 0);
+  ASSERT_EQ(colData.flag, HAS_VALUE | HAS_NULL);
+  ASSERT_EQ(colData.nVal, 5);
+  ASSERT_EQ(colData.numOfNull, 2);
+  ASSERT_EQ(colData.numOfValue, 3);
+
+  // the second batch is appended row by row behind the bitmap of the first one
+  TAOS_STMT2_BIND valueBind = {TSDB_DATA_TYPE_INT, values, NULL, NULL, 5};
+  ASSERT_EQ(tColDataAddValueByBind2(&colData, &valueBind, -1), 0);
+  ASSERT_EQ(colData.nVal, 10);
+
+  for (int32_t i = 0; i < colData.nVal; ++i) {
+    SColVal cv;
+    tColDataGetValue(&colData, i, &cv);
+    if (i < 5 && isNull[i]) {
+      ASSERT_TRUE(COL_VAL_IS_NULL(&cv));
+    } else {
+      ASSERT_TRUE(COL_VAL_IS_VALUE(&cv));
+      ASSERT_EQ(*(int32_t *)&cv.value.val, values[i % 5]);
+    }
+  }
+
+  tColDataDestroy(&colData);
+
+  // all values of an empty column are copied at once, bool values are normalized
+  int8_t boolValues[4] = {0, 1, 2, 0};
+  colData = {0};
+  tColDataInit(&colData, 3, TSDB_DATA_TYPE_BOOL, 0);
+  TAOS_STMT2_BIND boolBind = {TSDB_DATA_TYPE_BOOL, boolValues, NULL, NULL, 4};
+  ASSERT_EQ(tColDataAddValueByBind2(&colData, &boolBind, -1), 0);
+  ASSERT_EQ(colData.flag, HAS_VALUE);
+  ASSERT_EQ(colData.nVal, 4);
+  ASSERT_EQ(colData.pData[2], 1);
+  ASSERT_EQ(boolValues[2], 2);
+  tColDataDestroy(&colData);
+
+  // a bind of nulls only, as an arrow column without values is bound, is appended as nulls without any data
+  char allNull[5] = {1, 1, 1, 1, 1};
+  colData = {0};
+  tColDataInit(&colData, 4, TSDB_DATA_TYPE_INT, 0);
+  TAOS_STMT2_BIND nullBind = {TSDB_DATA_TYPE_INT, values, NULL, allNull, 5};
+  ASSERT_EQ(tColDataAddValueByBind2(&colData, &nullBind, -1), 0);
+  ASSERT_EQ(colData.flag, HAS_NULL);
+  ASSERT_EQ(colData.nVal, 5);
+  ASSERT_EQ(colData.numOfNull, 5);
+  ASSERT_EQ(colData.numOfValue, 0);
+  ASSERT_EQ(colData.nData, 0);
+
+  ASSERT_EQ(tColDataAddValueByBind2(&colData, &bind, -1), 0);
+  ASSERT_EQ(colData.flag, HAS_VALUE | HAS_NULL);
+  ASSERT_EQ(colData.nVal, 10);
+  for (int32_t i = 0; i < colData.nVal; ++i) {
+    SColVal cv;
+    tColDataGetValue(&colData, i, &cv);
+    if (i < 5 || isNull[i - 5]) {
+      ASSERT_TRUE(COL_VAL_IS_NULL(&cv));
+    } else {
+      ASSERT_TRUE(COL_VAL_IS_VALUE(&cv));
+      ASSERT_EQ(*(int32_t *)&cv.value.val, values[i - 5]);
+    }
+  }
+  tColDataDestroy(&colData);
+}
@@ -228,6 +228,50 @@ TEST(td_msg_test, msg_type_compatibility_test) {
 }
 
 
+// a follower reads the allowed lag of a sub query before the task is admitted, the plan is not copied for it
+TEST(td_msg_test, sub_query_msg_head_test) {
+  char         sql[] = "select * from st1";
+  char         plan[] = "{\"NodeType\":\"1000\"}";
+  SSubQueryMsg req = {0};
+  req.header.vgId = 2;
+  req.sId = 1;
+  req.queryId = 2;
+  req.taskId = 3;
+  req.execId = 4;
+  req.taskType = 1;
+  req.sqlLen = strlen(sql);
+  req.sql = sql;
+  req.msgLen = strlen(plan) + 1;
+  req.msg = plan;
+  req.maxFollowerLag = 1000;
+
+  int32_t len = tSerializeSSubQueryMsg(NULL, 0, &req);
+  ASSERT_GT(len, 0);
+  vector<char> buf(len);
+  ASSERT_EQ(tSerializeSSubQueryMsg(buf.data(), len, &req), len);
+  vector<char> sent(buf);
+
+  SSubQueryMsg head = {0};
+  ASSERT_EQ(tDeserializeSSubQueryMsgHead(buf.data(), len, &head), 0);
+  ASSERT_EQ(head.queryId, req.queryId);
+  ASSERT_EQ(head.taskId, req.taskId);
+  ASSERT_EQ(head.execId, req.execId);
+  ASSERT_EQ(head.sqlLen, req.sqlLen);
+  ASSERT_EQ(head.msgLen, req.msgLen);
+  ASSERT_EQ(head.sql, nullptr);
+  ASSERT_EQ(head.msg, nullptr);
+  ASSERT_EQ(head.maxFollowerLag, 1000);
+  // the msg is processed afterwards as it was received
+  ASSERT_TRUE(buf == sent);
+
+  SSubQueryMsg full = {0};
+  ASSERT_EQ(tDeserializeSSubQueryMsg(buf.data(), len, &full), 0);
+  ASSERT_STREQ(full.sql, sql);
+  ASSERT_STREQ(full.msg, plan);
+  ASSERT_EQ(full.maxFollowerLag, 1000);
+  tFreeSSubQueryMsg(&full);
+}
+
 size_t maxLengthOfMsgType() {
   size_t maxLen = 0;
   for (const auto& info : tMsgTypeInfo) {
@@ -261,6 +305,325 @@ void generateConfigFile(const string& filePath) {
 }
 
 
+// the fetch req of older versions, without the credit or, withCredit, without the runtime range
+static int32_t serializeOldResFetchReq(void *buf, int32_t bufLen, SResFetchReq *pReq, bool withCredit = false) {
+  SEncoder encoder = {0};
+  tEncoderInit(&encoder, (uint8_t *)buf + sizeof(SMsgHead), bufLen - sizeof(SMsgHead));
+  if (tStartEncode(&encoder) != 0 || tEncodeU64(&encoder, pReq->sId) != 0 ||
+      tEncodeU64(&encoder, pReq->queryId) != 0 || tEncodeU64(&encoder, pReq->taskId) != 0 ||
+      tEncodeI32(&encoder, pReq->execId) != 0 || tEncodeI32(&encoder, 0) != 0 ||
+      (withCredit && tEncodeI32(&encoder, pReq->credit) != 0)) {
+    tEncoderClear(&encoder);
+    return -1;
+  }
+  tEndEncode(&encoder);
+
+  int32_t tlen = encoder.pos + sizeof(SMsgHead);
+  tEncoderClear(&encoder);
+  SMsgHead *pHead = (SMsgHead *)buf;
+  pHead->vgId = htonl(pReq->header.vgId);
+  pHead->contLen = htonl(tlen);
+  return tlen;
+}
+
+TEST(td_msg_test, res_fetch_req_credit_test) {
+  for (int32_t credit : {0, 1, 8}) {
+    SResFetchReq req = {0};
+    req.header.vgId = 2;
+    req.sId = 11;
+    req.queryId = 12;
+    req.taskId = 13;
+    req.execId = 1;
+    req.credit = credit;
+
+    int32_t len = tSerializeSResFetchReq(NULL, 0, &req);
+    ASSERT_GT(len, 0);
+    vector<char> buf(len);
+    ASSERT_EQ(tSerializeSResFetchReq(buf.data(), len, &req), len);
+
+    SResFetchReq out = {0};
+    ASSERT_EQ(tDeserializeSResFetchReq(buf.data(), len, &out), 0);
+    ASSERT_EQ(out.sId, req.sId);
+    ASSERT_EQ(out.queryId, req.queryId);
+    ASSERT_EQ(out.taskId, req.taskId);
+    ASSERT_EQ(out.execId, req.execId);
+    ASSERT_EQ(out.pOpParam, nullptr);
+    ASSERT_EQ(out.credit, credit);
+  }
+
+  // an old consumer grants no credit, the worker falls back to its own batching
+  SResFetchReq req = {0};
+  req.sId = 21;
+  req.queryId = 22;
+  req.taskId = 23;
+  req.execId = 2;
+  vector<char> buf(256);
+  int32_t      len = serializeOldResFetchReq(buf.data(), buf.size(), &req);
+  ASSERT_GT(len, 0);
+
+  SResFetchReq out = {0};
+  ASSERT_EQ(tDeserializeSResFetchReq(buf.data(), len, &out), 0);
+  ASSERT_EQ(out.sId, req.sId);
+  ASSERT_EQ(out.queryId, req.queryId);
+  ASSERT_EQ(out.taskId, req.taskId);
+  ASSERT_EQ(out.execId, req.execId);
+  ASSERT_EQ(out.credit, 0);
+  ASSERT_EQ(out.hasRuntimeRange, 0);
+}
+
+TEST(td_msg_test, res_fetch_req_peak_mem_test) {
+  SResFetchReq req = {0};
+  req.header.vgId = 2;
+  req.sId = 31;
+  req.queryId = 32;
+  req.taskId = 33;
+  req.execId = 3;
+  req.withPeakMem = 1;
+
+  int32_t len = tSerializeSResFetchReq(NULL, 0, &req);
+  ASSERT_GT(len, 0);
+  vector<char> buf(len);
+  ASSERT_EQ(tSerializeSResFetchReq(buf.data(), len, &req), len);
+
+  SResFetchReq out = {0};
+  ASSERT_EQ(tDeserializeSResFetchReq(buf.data(), len, &out), 0);
+  ASSERT_EQ(out.withPeakMem, 1);
+
+  // an old consumer never asks for the trailer
+  vector<char> oldBuf(256);
+  len = serializeOldResFetchReq(oldBuf.data(), oldBuf.size(), &req);
+  ASSERT_GT(len, 0);
+
+  SResFetchReq oldOut = {0};
+  ASSERT_EQ(tDeserializeSResFetchReq(oldBuf.data(), len, &oldOut), 0);
+  ASSERT_EQ(oldOut.execId, req.execId);
+  ASSERT_EQ(oldOut.withPeakMem, 0);
+}
+
+TEST(td_msg_test, fetch_rsp_peak_mem_trailer_test) {
+  const int32_t dataLen = 100;
+  const int32_t msgLen = sizeof(SRetrieveTableRsp) + dataLen + FETCH_RSP_PEAK_MEM_LEN;
+  vector<char>  buf(msgLen, 0);
+
+  SRetrieveTableRsp *pRsp = (SRetrieveTableRsp *)buf.data();
+  tPutFetchRspPeakMem(pRsp, dataLen, 123456789);
+  ASSERT_EQ(tGetFetchRspPeakMem(pRsp, dataLen, msgLen), 123456789);
+
+  // the rsp of an older version ends with the data
+  ASSERT_EQ(tGetFetchRspPeakMem(pRsp, dataLen, msgLen - FETCH_RSP_PEAK_MEM_LEN), 0);
+  ASSERT_EQ(tGetFetchRspPeakMem(pRsp, dataLen, 0), 0);
+}
+
+static void buildQueryHbBatchReq(SClientHbBatchReq *pBatch, const vector<int64_t> &peakMems) {
+  pBatch->reqId = 41;
+  pBatch->reqs = taosArrayInit(1, sizeof(SClientHbReq));
+  ASSERT_NE(pBatch->reqs, nullptr);
+
+  SClientHbReq req = {0};
+  req.connKey.tscRid = 42;
+  req.connKey.connType = CONN_TYPE__QUERY;
+  req.query = (SQueryHbReqBasic *)taosMemoryCalloc(1, sizeof(SQueryHbReqBasic));
+  ASSERT_NE(req.query, nullptr);
+  req.query->connId = 43;
+  req.query->queryDesc = taosArrayInit(peakMems.size(), sizeof(SQueryDesc));
+  ASSERT_NE(req.query->queryDesc, nullptr);
+
+  for (size_t i = 0; i < peakMems.size(); ++i) {
+    SQueryDesc desc = {0};
+    tstrncpy(desc.sql, "select * from t", sizeof(desc.sql));
+    desc.queryId = 100 + i;
+    desc.peakMem = peakMems[i];
+    ASSERT_NE(taosArrayPush(req.query->queryDesc, &desc), nullptr);
+  }
+  ASSERT_NE(taosArrayPush(pBatch->reqs, &req), nullptr);
+}
+
+TEST(td_msg_test, client_hb_peak_mem_test) {
+  vector<int64_t>   peakMems = {123456789, 0, 4096};
+  SClientHbBatchReq batch = {0};
+  buildQueryHbBatchReq(&batch, peakMems);
+
+  int32_t len = tSerializeSClientHbBatchReq(NULL, 0, &batch);
+  ASSERT_GT(len, 0);
+  vector<char> buf(len);
+  ASSERT_EQ(tSerializeSClientHbBatchReq(buf.data(), len, &batch), len);
+
+  SClientHbBatchReq out = {0};
+  ASSERT_EQ(tDeserializeSClientHbBatchReq(buf.data(), len, &out), 0);
+  ASSERT_EQ(taosArrayGetSize(out.reqs), 1);
+  SClientHbReq *pReq = (SClientHbReq *)taosArrayGet(out.reqs, 0);
+  ASSERT_NE(pReq->query, nullptr);
+  ASSERT_EQ(taosArrayGetSize(pReq->query->queryDesc), peakMems.size());
+  for (size_t i = 0; i < peakMems.size(); ++i) {
+    SQueryDesc *desc = (SQueryDesc *)taosArrayGet(pReq->query->queryDesc, i);
+    ASSERT_EQ(desc->queryId, 100 + i);
+    ASSERT_EQ(desc->peakMem, peakMems[i]);
+  }
+  taosArrayDestroyEx(out.reqs, tFreeClientHbReq);
+
+  // an older client ends the batch with the ip white list, cut the trailer and fix the length of the batch
+  int32_t oldLen = len - (int32_t)(peakMems.size() * sizeof(int64_t));
+  int32_t bodyLen = oldLen - (int32_t)sizeof(int32_t);
+  memcpy(buf.data(), &bodyLen, sizeof(bodyLen));
+
+  SClientHbBatchReq oldOut = {0};
+  ASSERT_EQ(tDeserializeSClientHbBatchReq(buf.data(), oldLen, &oldOut), 0);
+  ASSERT_EQ(oldOut.reqId, batch.reqId);
+  pReq = (SClientHbReq *)taosArrayGet(oldOut.reqs, 0);
+  ASSERT_EQ(taosArrayGetSize(pReq->query->queryDesc), peakMems.size());
+  for (size_t i = 0; i < peakMems.size(); ++i) {
+    SQueryDesc *desc = (SQueryDesc *)taosArrayGet(pReq->query->queryDesc, i);
+    ASSERT_EQ(desc->queryId, 100 + i);
+    ASSERT_EQ(desc->peakMem, 0);
+  }
+  taosArrayDestroyEx(oldOut.reqs, tFreeClientHbReq);
+  taosArrayDestroyEx(batch.reqs, tFreeClientHbReq);
+}
+
+TEST(td_msg_test, res_fetch_req_runtime_range_test) {
+  for (int8_t hasRange : {0, 1}) {
+    SResFetchReq req = {0};
+    req.header.vgId = 2;
+    req.sId = 31;
+    req.queryId = 32;
+    req.taskId = 33;
+    req.execId = 3;
+    req.credit = 4;
+    req.hasRuntimeRange = hasRange;
+    req.runtimeRange.skey = 1700000000000LL;
+    req.runtimeRange.ekey = 1700000086400LL;
+
+    int32_t len = tSerializeSResFetchReq(NULL, 0, &req);
+    ASSERT_GT(len, 0);
+    vector<char> buf(len);
+    ASSERT_EQ(tSerializeSResFetchReq(buf.data(), len, &req), len);
+
+    SResFetchReq out = {0};
+    ASSERT_EQ(tDeserializeSResFetchReq(buf.data(), len, &out), 0);
+    ASSERT_EQ(out.taskId, req.taskId);
+    ASSERT_EQ(out.credit, req.credit);
+    ASSERT_EQ(out.hasRuntimeRange, hasRange);
+    if (hasRange) {
+      ASSERT_EQ(out.runtimeRange.skey, req.runtimeRange.skey);
+      ASSERT_EQ(out.runtimeRange.ekey, req.runtimeRange.ekey);
+    }
+  }
+
+  // a consumer that grants credits but pushes no range
+  SResFetchReq req = {0};
+  req.sId = 41;
+  req.queryId = 42;
+  req.taskId = 43;
+  req.execId = 4;
+  req.credit = 6;
+  vector<char> buf(256);
+  int32_t      len = serializeOldResFetchReq(buf.data(), buf.size(), &req, true);
+  ASSERT_GT(len, 0);
+
+  SResFetchReq out = {0};
+  ASSERT_EQ(tDeserializeSResFetchReq(buf.data(), len, &out), 0);
+  ASSERT_EQ(out.taskId, req.taskId);
+  ASSERT_EQ(out.execId, req.execId);
+  ASSERT_EQ(out.credit, 6);
+  ASSERT_EQ(out.hasRuntimeRange, 0);
+}
+
+// the sub query msg of older versions, without the low latency flag or, withoutLag, without the follower lag either
+static int32_t serializeOldSubQueryMsg(void *buf, int32_t bufLen, SSubQueryMsg *pReq, bool withoutLag = false) {
+  SEncoder encoder = {0};
+  tEncoderInit(&encoder, (uint8_t *)buf + sizeof(SMsgHead), bufLen - sizeof(SMsgHead));
+  if (tStartEncode(&encoder) != 0 || tEncodeU64(&encoder, pReq->sId) != 0 ||
+      tEncodeU64(&encoder, pReq->queryId) != 0 || tEncodeU64(&encoder, pReq->taskId) != 0 ||
+      tEncodeI64(&encoder, pReq->refId) != 0 || tEncodeI32(&encoder, pReq->execId) != 0 ||
+      tEncodeI32(&encoder, pReq->msgMask) != 0 || tEncodeI8(&encoder, pReq->taskType) != 0 ||
+      tEncodeI8(&encoder, pReq->explain) != 0 || tEncodeI8(&encoder, pReq->needFetch) != 0 ||
+      tEncodeI8(&encoder, pReq->compress) != 0 || tEncodeU32(&encoder, pReq->sqlLen) != 0 ||
+      tEncodeCStrWithLen(&encoder, pReq->sql, pReq->sqlLen) != 0 || tEncodeU32(&encoder, pReq->msgLen) != 0 ||
+      tEncodeBinary(&encoder, (uint8_t *)pReq->msg, pReq->msgLen) != 0 ||
+      (!withoutLag && tEncodeI32(&encoder, pReq->maxFollowerLag) != 0)) {
+    tEncoderClear(&encoder);
+    return -1;
+  }
+  tEndEncode(&encoder);
+
+  int32_t tlen = encoder.pos + sizeof(SMsgHead);
+  tEncoderClear(&encoder);
+  SMsgHead *pHead = (SMsgHead *)buf;
+  pHead->vgId = htonl(pReq->header.vgId);
+  pHead->contLen = htonl(tlen);
+  return tlen;
+}
+
+static void initSubQueryMsg(SSubQueryMsg *pReq, char *sql, char *msg) {
+  pReq->header.vgId = 2;
+  pReq->sId = 51;
+  pReq->queryId = 52;
+  pReq->taskId = 53;
+  pReq->refId = 54;
+  pReq->execId = 5;
+  pReq->taskType = 1;
+  pReq->needFetch = 1;
+  pReq->sqlLen = strlen(sql);
+  pReq->sql = sql;
+  pReq->msgLen = strlen(msg) + 1;
+  pReq->msg = msg;
+  pReq->maxFollowerLag = 100;
+}
+
+static void assertSameSubQueryMsg(const SSubQueryMsg *pExpected, const SSubQueryMsg *pActual) {
+  ASSERT_EQ(pActual->sId, pExpected->sId);
+  ASSERT_EQ(pActual->queryId, pExpected->queryId);
+  ASSERT_EQ(pActual->taskId, pExpected->taskId);
+  ASSERT_EQ(pActual->refId, pExpected->refId);
+  ASSERT_EQ(pActual->execId, pExpected->execId);
+  ASSERT_EQ(pActual->taskType, pExpected->taskType);
+  ASSERT_EQ(pActual->needFetch, pExpected->needFetch);
+  ASSERT_STREQ(pActual->sql, pExpected->sql);
+  ASSERT_EQ(pActual->msgLen, pExpected->msgLen);
+  ASSERT_STREQ(pActual->msg, pExpected->msg);
+}
+
+TEST(td_msg_test, sub_query_msg_low_latency_test) {
+  char sql[] = "select * from st1";
+  char msg[] = "{\"NodeType\":\"1000\"}";
+
+  for (int8_t lowLatency : {0, 1}) {
+    SSubQueryMsg req = {0};
+    initSubQueryMsg(&req, sql, msg);
+    req.lowLatency = lowLatency;
+
+    int32_t len = tSerializeSSubQueryMsg(NULL, 0, &req);
+    ASSERT_GT(len, 0);
+    vector<char> buf(len);
+    ASSERT_EQ(tSerializeSSubQueryMsg(buf.data(), len, &req), len);
+
+    SSubQueryMsg out = {0};
+    ASSERT_EQ(tDeserializeSSubQueryMsg(buf.data(), len, &out), 0);
+    assertSameSubQueryMsg(&req, &out);
+    ASSERT_EQ(out.maxFollowerLag, req.maxFollowerLag);
+    ASSERT_EQ(out.lowLatency, lowLatency);
+    tFreeSSubQueryMsg(&out);
+  }
+
+  // an old scheduler never asks for the low latency mode
+  for (bool withoutLag : {false, true}) {
+    SSubQueryMsg req = {0};
+    initSubQueryMsg(&req, sql, msg);
+    req.lowLatency = 1;
+    vector<char> buf(512);
+    int32_t      len = serializeOldSubQueryMsg(buf.data(), buf.size(), &req, withoutLag);
+    ASSERT_GT(len, 0);
+
+    SSubQueryMsg out = {0};
+    out.lowLatency = 1;
+    ASSERT_EQ(tDeserializeSSubQueryMsg(buf.data(), len, &out), 0);
+    assertSameSubQueryMsg(&req, &out);
+    ASSERT_EQ(out.maxFollowerLag, withoutLag ? -1 : req.maxFollowerLag);
+    ASSERT_EQ(out.lowLatency, 0);
+    tFreeSSubQueryMsg(&out);
+  }
+}
+
 void processCommandArgs(int argc, char** argv) {
   for (int i = 1; i < argc; ++i) {
     if (string(argv[i]) == "--output-config") {
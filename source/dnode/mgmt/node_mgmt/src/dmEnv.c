@@ -17,6 +17,7 @@
 // clang-format off
 #include "dmMgmt.h"
 #include "audit.h"
+#include "query.h"
 #include "libs/function/tudf.h"
 #include "tgrant.h"
 #include "tcompare.h"
@@ -183,6 +184,8 @@ int32_t dmInit() {
   if ((code = dmInitSystem()) != 0) return code;
   if ((code = dmInitMonitor()) != 0) return code;
   if ((code = dmInitAudit()) != 0) return code;
+  // the task queue takes the sort runs split off a query, see sortAndFlushParallelRuns
+  if ((code = initTaskQueue()) != 0) return code;
   if ((code = dmInitDnode(dmInstance())) != 0) return code;
   if ((code = InitRegexCache() != 0)) return code;
 #if defined(USE_S3)
@@ -206,6 +209,7 @@ void dmCleanup() {
   SDnode *pDnode = dmInstance();
   if (dmCheckRepeatCleanup(pDnode) != 0) return;
   dmCleanupDnode(pDnode);
+  (void)cleanupTaskQueue();
   monCleanup();
   auditCleanup();
   syncCleanUp();
@@ -49,6 +49,7 @@ class Testbase {
  public:
   int32_t SendShowReq(int8_t showType, const char* tb, const char* db);
   int32_t GetShowRows();
+  int64_t GetShowInt64(int32_t row, int32_t col);
 
 #if 0
   int32_t     GetMetaNum();
@@ -60,7 +61,6 @@ class Testbase {
   int8_t      GetShowInt8(int32_t row, int32_t col);
   int16_t     GetShowInt16(int32_t row, int32_t col);
   int32_t     GetShowInt32(int32_t row, int32_t col);
-  int64_t     GetShowInt64(int32_t row, int32_t col);
   int64_t     GetShowTimestamp(int32_t row, int32_t col);
   const char* GetShowBinary(int32_t row, int32_t col);
 #endif
@@ -14,6 +14,7 @@
  */
 
 #include "sut.h"
+#include "tdatablock.h"
 
 void Testbase::InitLog(const char* path) {
   dDebugFlag = 143;
@@ -127,3 +128,29 @@ int32_t Testbase::GetShowRows() {
     return 0;
   }
 }
+
+// the data of a show rsp is the number of columns, their schemas and then the encoded block
+int64_t Testbase::GetShowInt64(int32_t row, int32_t col) {
+  if (showRsp == NULL || row >= showRsp->numOfRows) {
+    return 0;
+  }
+
+  const char* pStart = showRsp->data;
+  int32_t     numOfCols = htonl(*(int32_t*)pStart);
+  pStart += sizeof(int32_t) + sizeof(SSysTableSchema) * numOfCols;
+
+  SSDataBlock* pBlock = NULL;
+  if (createDataBlock(&pBlock) != 0) {
+    return 0;
+  }
+
+  int64_t     val = 0;
+  const char* pEnd = NULL;
+  if (blockDecode(pBlock, pStart, &pEnd) == 0 && col < taosArrayGetSize(pBlock->pDataBlock)) {
+    SColumnInfoData* pCol = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, col);
+    val = *(int64_t*)colDataGetData(pCol, row);
+  }
+
+  blockDataDestroy(pBlock);
+  return val;
+}
@@ -312,3 +312,37 @@ TEST_F(MndTestProfile, 09_KillQueryMsg) {
   test.SendShowReq(TSDB_MGMT_TABLE_QUERIES, "perf_queries", "");
   EXPECT_EQ(test.GetShowRows(), 0);
 }
+
+TEST_F(MndTestProfile, 10_QueryHbPeakMem) {
+  SClientHbBatchReq batchReq = {0};
+  batchReq.reqs = taosArrayInit(0, sizeof(SClientHbReq));
+  SClientHbReq req = {0};
+  req.connKey.tscRid = 124;
+  req.connKey.connType = CONN_TYPE__QUERY;
+  req.query = (SQueryHbReqBasic*)taosMemoryCalloc(1, sizeof(SQueryHbReqBasic));
+  req.query->connId = connId;
+  req.query->queryDesc = taosArrayInit(1, sizeof(SQueryDesc));
+
+  SQueryDesc desc = {0};
+  strcpy(desc.sql, "select * from db.stb");
+  desc.queryId = 1234;
+  desc.stime = taosGetTimestampMs();
+  strcpy(desc.fqdn, "localhost");
+  desc.peakMem = 123456789;
+  taosArrayPush(req.query->queryDesc, &desc);
+  taosArrayPush(batchReq.reqs, &req);
+
+  int32_t tlen = tSerializeSClientHbBatchReq(NULL, 0, &batchReq);
+  void*   buf = rpcMallocCont(tlen);
+  tSerializeSClientHbBatchReq(buf, tlen, &batchReq);
+  taosArrayDestroyEx(batchReq.reqs, tFreeClientHbReq);
+
+  SRpcMsg* pMsg = test.SendReq(TDMT_MND_HEARTBEAT, buf, tlen);
+  ASSERT_NE(pMsg, nullptr);
+  ASSERT_EQ(pMsg->code, 0);
+
+  // the peak memory reported by the hb shows up in perf_queries
+  test.SendShowReq(TSDB_MGMT_TABLE_QUERIES, "perf_queries", "");
+  EXPECT_EQ(test.GetShowRows(), 1);
+  EXPECT_EQ(test.GetShowInt64(0, 14), 123456789);
+}
@@ -179,7 +179,9 @@ uint64_t     tsdbGetReaderMaxVersion2(STsdbReader *pReader);
 void         tsdbReaderSetCloseFlag(STsdbReader *pReader);
 int64_t      tsdbGetLastTimestamp2(SVnode *pVnode, void *pTableList, int32_t numOfTables, const char *pIdStr);
 void         tsdbSetFilesetDelimited(STsdbReader *pReader);
+void         tsdbReaderSetRuntimeRange(STsdbReader *pReader, const STimeWindow *pWindow);
 void         tsdbReaderSetNotifyCb(STsdbReader *pReader, TsdReaderNotifyCbFn notifyFn, void *param);
+int32_t      tsdbGetHistoryDataVer(SVnode *pVnode, const STimeWindow *pWindow, int64_t *pVer);
 
 int32_t tsdbReuseCacherowsReader(void *pReader, void *pTableIdList, int32_t numOfTables);
 int32_t tsdbCacherowsReaderOpen(void *pVnode, int32_t type, void *pTableIdList, int32_t numOfTables, int32_t numOfCols,
@@ -105,6 +105,7 @@ struct SMeta {
   SMetaIdx* pIdx;
 
   SMetaCache* pCache;
+  int64_t     changeVer;  // renewed by every write lock
 };
 
 typedef struct {
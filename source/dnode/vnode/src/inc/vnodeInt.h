@@ -136,6 +136,9 @@ int   vnodeDecodeInfo(uint8_t* pData, SVnodeInfo* pInfo);
 void vnodeBufPoolRegisterQuery(SVBufPool* pPool, SQueryNode* pQNode);
 void vnodeBufPoolDeregisterQuery(SVBufPool* pPool, SQueryNode* pQNode, bool proactive);
 
+// change versions of the file sets and metas, drawn from one counter so that they never go back even if reopened
+int64_t vnodeNewChangeVer();
+
 // meta
 typedef struct SMStbCursor SMStbCursor;
 typedef struct STbUidStore STbUidStore;
@@ -195,6 +198,7 @@ void*         metaGetIdx(SMeta* pMeta);
 void*         metaGetIvtIdx(SMeta* pMeta);
 
 int64_t metaGetTbNum(SMeta* pMeta);
+int64_t metaGetChangeVer(SMeta* pMeta);
 void    metaReaderDoInit(SMetaReader* pReader, SMeta* pMeta, int32_t flags);
 
 int32_t metaCreateTSma(SMeta* pMeta, int64_t version, SSmaCfg* pCfg);
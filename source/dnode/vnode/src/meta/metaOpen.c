@@ -161,6 +161,7 @@ static int32_t metaOpenImpl(SVnode *pVnode, SMeta **ppMeta, const char *metaDir,
   int32_t ret = taosRealPath(pMeta->path, NULL, strlen(path) + 1);
 
   pMeta->pVnode = pVnode;
+  pMeta->changeVer = vnodeNewChangeVer();
 
   // create path if not created yet
   code = taosMkDir(pMeta->path);
@@ -484,8 +485,11 @@ void metaWLock(SMeta *pMeta) {
   if (taosThreadRwlockWrlock(&pMeta->lock) != 0) {
     metaError("vgId:%d failed to lock %p", TD_VID(pMeta->pVnode), &pMeta->lock);
   }
+  atomic_store_64(&pMeta->changeVer, vnodeNewChangeVer());
 }
 
+int64_t metaGetChangeVer(SMeta *pMeta) { return atomic_load_64(&pMeta->changeVer); }
+
 void metaULock(SMeta *pMeta) {
   metaTrace("meta ulock %p", &pMeta->lock);
   if (taosThreadRwlockUnlock(&pMeta->lock) != 0) {
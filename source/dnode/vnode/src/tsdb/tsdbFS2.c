@@ -52,6 +52,7 @@ static int32_t create_fs(STsdb *pTsdb, STFileSystem **fs) {
 
   fs[0]->fsstate = TSDB_FS_STATE_NORMAL;
   fs[0]->neid = 0;
+  fs[0]->version = vnodeNewChangeVer();
   TARRAY2_INIT(fs[0]->fSetArr);
   TARRAY2_INIT(fs[0]->fSetArrTmp);
 
@@ -317,6 +318,8 @@ static int32_t commit_edit(STFileSystem *fs) {
   code = apply_commit(fs);
   TSDB_CHECK_CODE(code, lino, _exit);
 
+  fs->version = vnodeNewChangeVer();
+
 _exit:
   if (code) {
     tsdbError("vgId:%d %s failed at %s:%d since %s", TD_VID(fs->tsdb->pVnode), __func__, __FILE__, lino,
@@ -74,6 +74,7 @@ struct STFileSystem {
   int32_t       fsstate;
   int64_t       neid;
   EFEditT       etype;
+  int64_t       version;  // renewed by every committed edit
   TFileSetArray fSetArr[1];
   TFileSetArray fSetArrTmp[1];
 };
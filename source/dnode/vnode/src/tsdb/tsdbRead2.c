@@ -349,15 +349,19 @@ static int32_t filesetIteratorNext(SFilesetIter* pIter, STsdbReader* pReader, bo
     int32_t fid = pReader->status.pCurrentFileset->fid;
     tsdbFidKeyRange(fid, pReader->pTsdb->keepCfg.days, pReader->pTsdb->keepCfg.precision, &win.skey, &win.ekey);
 
+    STimeWindow qwin = pReader->info.window;
+    qwin.skey = TMAX(qwin.skey, pReader->info.rtWindow.skey);
+    qwin.ekey = TMIN(qwin.ekey, pReader->info.rtWindow.ekey);
+
     // current file are no longer overlapped with query time window, ignore remain files
-    if ((asc && win.skey > pReader->info.window.ekey) || (!asc && win.ekey < pReader->info.window.skey)) {
+    if ((asc && win.skey > qwin.ekey) || (!asc && win.ekey < qwin.skey)) {
       tsdbDebug("%p remain files are not qualified for qrange:%" PRId64 "-%" PRId64 ", ignore, %s", pReader,
-                pReader->info.window.skey, pReader->info.window.ekey, pReader->idStr);
+                qwin.skey, qwin.ekey, pReader->idStr);
       *hasNext = false;
       return TSDB_CODE_SUCCESS;
     }
 
-    if ((asc && (win.ekey < pReader->info.window.skey)) || ((!asc) && (win.skey > pReader->info.window.ekey))) {
+    if ((asc && (win.ekey < qwin.skey)) || ((!asc) && (win.skey > qwin.ekey))) {
       pIter->index += step;
       if ((asc && pIter->index >= pIter->numOfFiles) || ((!asc) && pIter->index < 0)) {
         *hasNext = false;
@@ -553,6 +557,7 @@ static int32_t tsdbReaderCreate(SVnode* pVnode, SQueryTableDataCond* pCond, void
   pReader->info.order = pCond->order;
   pReader->info.verRange = getQueryVerRange(pVnode, pCond, level);
   pReader->info.window = updateQueryTimeWindow(pReader->pTsdb, &pCond->twindows);
+  pReader->info.rtWindow = TSWINDOW_INITIALIZER;
 
   pReader->idStr = (idstr != NULL) ? taosStrdup(idstr) : NULL;
   if (idstr != NULL && pReader->idStr == NULL) {
@@ -796,6 +801,12 @@ static int32_t loadFileBlockBrinInfo(STsdbReader* pReader, SArray* pIndexList, S
       continue;
     }
 
+    STimeWindow* pRtWin = &pReader->info.rtWindow;
+    if (pRecord->firstKey.key.ts > pRtWin->ekey || pRecord->lastKey.key.ts < pRtWin->skey) {
+      pReader->cost.rtSkipBlocks += 1;
+      continue;
+    }
+
     if (asc) {
       if (pkCompEx(&pRecord->lastKey.key, &pScanInfo->lastProcKey) <= 0) {
         continue;
@@ -4936,12 +4947,12 @@ void tsdbReaderClose2(STsdbReader* pReader) {
       " SMA-time:%.2f ms, fileBlocks:%" PRId64
       ", fileBlocks-load-time:%.2f ms, "
       "build in-memory-block-time:%.2f ms, sttBlocks:%" PRId64 ", sttBlocks-time:%.2f ms, sttStatisBlock:%" PRId64
-      ", stt-statis-Block-time:%.2f ms, composed-blocks:%" PRId64
+      ", stt-statis-Block-time:%.2f ms, composed-blocks:%" PRId64 ", runtime-range-skipped-blocks:%" PRId64
       ", composed-blocks-time:%.2fms, STableBlockScanInfo size:%.2f Kb, createTime:%.2f ms,createSkylineIterTime:%.2f "
       "ms, initSttBlockReader:%.2fms, %s",
       pReader, pCost->headFileLoad, pCost->headFileLoadTime, pCost->smaDataLoad, pCost->smaLoadTime, pCost->numOfBlocks,
       pCost->blockLoadTime, pCost->buildmemBlock, pCost->sttCost.loadBlocks, pCost->sttCost.blockElapsedTime,
-      pCost->sttCost.loadStatisBlocks, pCost->sttCost.statisElapsedTime, pCost->composedBlocks,
+      pCost->sttCost.loadStatisBlocks, pCost->sttCost.statisElapsedTime, pCost->composedBlocks, pCost->rtSkipBlocks,
       pCost->buildComposedBlockTime, numOfTables * sizeof(STableBlockScanInfo) / 1000.0, pCost->createScanInfoList,
       pCost->createSkylineIterTime, pCost->initSttBlockReader, pReader->idStr);
 
@@ -5607,6 +5618,7 @@ int32_t tsdbReaderReset2(STsdbReader* pReader, SQueryTableDataCond* pCond) {
   pReader->info.order = pCond->order;
   pReader->type = TIMEWINDOW_RANGE_CONTAINED;
   pReader->info.window = updateQueryTimeWindow(pReader->pTsdb, &pCond->twindows);
+  pReader->info.rtWindow = TSWINDOW_INITIALIZER;
   pStatus->loadFromFile = true;
   pStatus->pTableIter = NULL;
 
@@ -6054,7 +6066,50 @@ void tsdbReaderSetCloseFlag(STsdbReader* pReader) { /*pReader->code = TSDB_CODE_
 
 void tsdbSetFilesetDelimited(STsdbReader* pReader) { pReader->bFilesetDelimited = true; }
 
+// the range only narrows, file sets and blocks out of it are skipped from now on, the rows already returned are kept
+void tsdbReaderSetRuntimeRange(STsdbReader* pReader, const STimeWindow* pWindow) {
+  STimeWindow* pRtWin = &pReader->info.rtWindow;
+  if (pWindow->skey <= pRtWin->skey && pWindow->ekey >= pRtWin->ekey) {
+    return;
+  }
+
+  pRtWin->skey = TMAX(pRtWin->skey, pWindow->skey);
+  pRtWin->ekey = TMIN(pRtWin->ekey, pWindow->ekey);
+  tsdbDebug("%p runtime range narrowed to %" PRId64 "-%" PRId64 ", %s", pReader, pRtWin->skey, pRtWin->ekey,
+            pReader->idStr);
+}
+
 void tsdbReaderSetNotifyCb(STsdbReader* pReader, TsdReaderNotifyCbFn notifyFn, void* param) {
   pReader->notifyFn = notifyFn;
   pReader->notifyParam = param;
 }
+
+static bool tsdbMemOverlapWindow(const SMemTable* pMem, const STimeWindow* pWindow) {
+  if (pMem == NULL) {
+    return false;
+  }
+  return pMem->nDel > 0 || (pMem->minKey <= pWindow->ekey && pMem->maxKey >= pWindow->skey);
+}
+
+// The version of the data read by a query on pWindow, it changes with every edit of the file sets or the metas. It is
+// -1 if the rows or deletes in the memtables fall in pWindow, the results of such a query can not be reused.
+int32_t tsdbGetHistoryDataVer(SVnode* pVnode, const STimeWindow* pWindow, int64_t* pVer) {
+  STsdb* pTsdb = pVnode->pTsdb;
+  *pVer = -1;
+
+  if (VND_IS_RSMA(pVnode) || pTsdb == NULL) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  int32_t code = taosThreadMutexLock(&pTsdb->mutex);
+  if (code != TSDB_CODE_SUCCESS) {
+    return code;
+  }
+
+  if (!tsdbMemOverlapWindow(pTsdb->mem, pWindow) && !tsdbMemOverlapWindow(pTsdb->imem, pWindow)) {
+    *pVer = TMAX(pTsdb->pFS->version, metaGetChangeVer(pVnode->pMeta));
+  }
+
+  (void)taosThreadMutexUnlock(&pTsdb->mutex);
+  return TSDB_CODE_SUCCESS;
+}
@@ -67,6 +67,7 @@ typedef struct STsdbReaderInfo {
   STSchema*     pSchema;
   EExecMode     execMode;
   STimeWindow   window;
+  STimeWindow   rtWindow;  // narrowed by the consumer during the scan, only used to skip file sets and blocks
   SVersionRange verRange;
   int16_t       order;
 } STsdbReaderInfo;
@@ -147,6 +148,7 @@ typedef struct SReadCostSummary {
   double  smaLoadTime;
   SSttBlockLoadCostInfo sttCost;
   int64_t composedBlocks;
+  int64_t rtSkipBlocks;  // blocks skipped by the runtime range
   double  buildComposedBlockTime;
   double  createScanInfoList;
   double  createSkylineIterTime;
@@ -63,6 +63,8 @@ void initTsdbReaderAPI(TsdReader* pReader) {
 
   pReader->tsdSetFilesetDelimited = (void (*)(void*))tsdbSetFilesetDelimited;
   pReader->tsdSetSetNotifyCb = (void (*)(void*, TsdReaderNotifyCbFn, void*))tsdbReaderSetNotifyCb;
+  pReader->tsdGetHistoryDataVer = (int32_t (*)(void*, const STimeWindow*, int64_t*))tsdbGetHistoryDataVer;
+  pReader->tsdSetRuntimeRange = (void (*)(void*, const STimeWindow*))tsdbReaderSetRuntimeRange;
 }
 
 void initMetadataAPI(SStoreMeta* pMeta) {
@@ -24,6 +24,10 @@
     }                                                                                                         \
   } while (0)
 
+static int64_t vnodeChangeVer = 0;
+
+int64_t vnodeNewChangeVer() { return atomic_add_fetch_64(&vnodeChangeVer, 1); }
+
 int vnodeQueryOpen(SVnode *pVnode) {
   return qWorkerInit(NODE_TYPE_VNODE, TD_VID(pVnode), (void **)&pVnode->pQuery, &pVnode->msgCb);
 }
@@ -514,6 +518,14 @@ int32_t vnodeGetLoad(SVnode *pVnode, SVnodeLoad *pLoad) {
   pLoad->numOfInsertSuccessReqs = atomic_load_64(&pVnode->statis.nInsertSuccess);
   pLoad->numOfBatchInsertReqs = atomic_load_64(&pVnode->statis.nBatchInsert);
   pLoad->numOfBatchInsertSuccessReqs = atomic_load_64(&pVnode->statis.nBatchInsertSuccess);
+
+  SQWorkerStat qstat = {0};
+  if (pVnode->pQuery) {
+    qWorkerGetResCacheStat(pVnode->pQuery, &qstat);
+  }
+  pLoad->resCacheHit = (int64_t)qstat.resCacheHit;
+  pLoad->resCacheMiss = (int64_t)qstat.resCacheMiss;
+  pLoad->resCacheSize = (int64_t)qstat.resCacheSize;
   return 0;
 }
 
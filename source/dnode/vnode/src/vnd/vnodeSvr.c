@@ -761,11 +761,42 @@ int32_t vnodePreprocessQueryMsg(SVnode *pVnode, SRpcMsg *pMsg) {
   return qWorkerPreprocessQueryMsg(pVnode->pQuery, pMsg, TDMT_SCH_QUERY == pMsg->msgType);
 }
 
+static bool vnodeIsReadyForFollowerQuery(SVnode *pVnode, SRpcMsg *pMsg) {
+  int32_t maxLag = -1;
+  if (pMsg->msgType != TDMT_SCH_QUERY || !pVnode->restored) {
+    return false;
+  }
+
+  if (qWorkerGetQueryMaxFollowerLag(pMsg, &maxLag) != TSDB_CODE_SUCCESS || maxLag < 0) {
+    return false;
+  }
+
+  return syncIsReadyForStaleRead(pVnode->sync, maxLag);
+}
+
+// the staleness bound applies when a task is admitted, a running task is fetched from whatever the lag is now
+static bool vnodeIsReadyForFollowerFetch(SVnode *pVnode, SRpcMsg *pMsg) {
+  bool follower = false;
+  if (pMsg->msgType != TDMT_SCH_FETCH) {
+    return false;
+  }
+
+  if (qWorkerIsFollowerFetch(pVnode->pQuery, pMsg, &follower) != TSDB_CODE_SUCCESS) {
+    return false;
+  }
+
+  return follower;
+}
+
 int32_t vnodeProcessQueryMsg(SVnode *pVnode, SRpcMsg *pMsg, SQueueInfo *pInfo) {
   vTrace("message in vnode query queue is processing");
   if ((pMsg->msgType == TDMT_SCH_QUERY || pMsg->msgType == TDMT_VND_TMQ_CONSUME) && !syncIsReadyForRead(pVnode->sync)) {
-    vnodeRedirectRpcMsg(pVnode, pMsg, terrno);
-    return 0;
+    int32_t code = terrno;
+    if (!vnodeIsReadyForFollowerQuery(pVnode, pMsg)) {
+      vnodeRedirectRpcMsg(pVnode, pMsg, code);
+      return 0;
+    }
+    vTrace("vgId:%d, msg:%p is processed by follower", TD_VID(pVnode), pMsg);
   }
 
   if (pMsg->msgType == TDMT_VND_TMQ_CONSUME && !pVnode->restored) {
@@ -797,8 +828,12 @@ int32_t vnodeProcessFetchMsg(SVnode *pVnode, SRpcMsg *pMsg, SQueueInfo *pInfo) {
   if ((pMsg->msgType == TDMT_SCH_FETCH || pMsg->msgType == TDMT_VND_TABLE_META || pMsg->msgType == TDMT_VND_TABLE_CFG ||
        pMsg->msgType == TDMT_VND_BATCH_META || pMsg->msgType == TDMT_VND_TABLE_NAME) &&
       !syncIsReadyForRead(pVnode->sync)) {
-    vnodeRedirectRpcMsg(pVnode, pMsg, terrno);
-    return 0;
+    int32_t code = terrno;
+    // results of a task are kept where it was executed, which may be a follower
+    if (!vnodeIsReadyForFollowerFetch(pVnode, pMsg)) {
+      vnodeRedirectRpcMsg(pVnode, pMsg, code);
+      return 0;
+    }
   }
 
   switch (pMsg->msgType) {
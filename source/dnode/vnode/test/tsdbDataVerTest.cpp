@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "meta.h"
+#include "tsdbFS2.h"
+#include "vnodeInt.h"
+
+namespace {
+
+/*
+ * tsdbGetHistoryDataVer only reads the memtables, the file system and the meta of a vnode, so the test builds just
+ * these parts: a real file system in a temporary directory, a meta with its lock and memtables set by hand.
+ */
+class TsdbDataVerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    (void)snprintf(path, sizeof(path), "%s%stsdb_data_ver_test", TD_TMP_DIR_PATH, TD_DIRSEP);
+    taosRemoveDir(path);
+    ASSERT_EQ(taosMkDir(path), 0);
+
+    pVnode = (SVnode *)taosMemoryCalloc(1, sizeof(SVnode));
+    pTsdb = (STsdb *)taosMemoryCalloc(1, sizeof(STsdb));
+    pMeta = (SMeta *)taosMemoryCalloc(1, sizeof(SMeta));
+    ASSERT_TRUE(pVnode && pTsdb && pMeta);
+
+    pVnode->config.vgId = 2;
+    pVnode->config.sttTrigger = 1;
+    pVnode->pTsdb = pTsdb;
+    pVnode->pMeta = pMeta;
+
+    pTsdb->path = path;
+    pTsdb->pVnode = pVnode;
+    ASSERT_EQ(taosThreadMutexInit(&pTsdb->mutex, NULL), 0);
+    ASSERT_EQ(tsdbOpenFS(pTsdb, &pTsdb->pFS, 0), 0);
+
+    pMeta->pVnode = pVnode;
+    ASSERT_EQ(taosThreadRwlockInit(&pMeta->lock, NULL), 0);
+    pMeta->changeVer = vnodeNewChangeVer();
+  }
+
+  void TearDown() override {
+    tsdbCloseFS(&pTsdb->pFS);
+    (void)taosThreadMutexDestroy(&pTsdb->mutex);
+    (void)taosThreadRwlockDestroy(&pMeta->lock);
+    taosMemoryFree(pMeta);
+    taosMemoryFree(pTsdb);
+    taosMemoryFree(pVnode);
+    taosRemoveDir(path);
+  }
+
+  int64_t getVer(TSKEY skey, TSKEY ekey) {
+    STimeWindow window = {.skey = skey, .ekey = ekey};
+    int64_t     ver = -2;
+    EXPECT_EQ(tsdbGetHistoryDataVer(pVnode, &window, &ver), 0);
+    return ver;
+  }
+
+  // an edit of the file system with no file operations, as a commit of an empty memtable does
+  void commit() {
+    TFileOpArray opArray[1];
+    TARRAY2_INIT(opArray);
+    ASSERT_EQ(tsdbFSEditBegin(pTsdb->pFS, opArray, TSDB_FEDIT_COMMIT), 0);
+    (void)taosThreadMutexLock(&pTsdb->mutex);
+    int32_t code = tsdbFSEditCommit(pTsdb->pFS);
+    (void)taosThreadMutexUnlock(&pTsdb->mutex);
+    ASSERT_EQ(code, 0);
+    TARRAY2_DESTROY(opArray, NULL);
+  }
+
+  char    path[PATH_MAX] = {0};
+  SVnode *pVnode = NULL;
+  STsdb  *pTsdb = NULL;
+  SMeta  *pMeta = NULL;
+};
+
+}  // namespace
+
+TEST_F(TsdbDataVerTest, stableWithoutWrites) {
+  int64_t ver = getVer(1000, 2000);
+  ASSERT_GE(ver, 0);
+  ASSERT_EQ(getVer(1000, 2000), ver);
+  ASSERT_EQ(getVer(INT64_MIN, INT64_MAX), ver);
+}
+
+TEST_F(TsdbDataVerTest, commitRenews) {
+  int64_t ver = getVer(1000, 2000);
+  commit();
+  int64_t ver1 = getVer(1000, 2000);
+  ASSERT_GT(ver1, ver);
+  commit();
+  ASSERT_GT(getVer(1000, 2000), ver1);
+}
+
+TEST_F(TsdbDataVerTest, metaWriteRenews) {
+  int64_t ver = getVer(1000, 2000);
+  metaWLock(pMeta);
+  metaULock(pMeta);
+  int64_t ver1 = getVer(1000, 2000);
+  ASSERT_GT(ver1, ver);
+
+  // readers leave it as it is
+  metaRLock(pMeta);
+  metaULock(pMeta);
+  ASSERT_EQ(getVer(1000, 2000), ver1);
+}
+
+TEST_F(TsdbDataVerTest, memTableOverlap) {
+  SMemTable mem = {0};
+  mem.minKey = 1500;
+  mem.maxKey = 3000;
+  mem.nRow = 10;
+
+  int64_t ver = getVer(1000, 1499);
+  ASSERT_GE(ver, 0);
+
+  pTsdb->mem = &mem;
+  ASSERT_EQ(getVer(1000, 1500), -1);
+  ASSERT_EQ(getVer(2000, 2500), -1);
+  ASSERT_EQ(getVer(3000, 4000), -1);
+  ASSERT_EQ(getVer(1000, 1499), ver);
+  ASSERT_EQ(getVer(3001, 4000), ver);
+
+  // a delete may cover any range
+  mem.nDel = 1;
+  ASSERT_EQ(getVer(1000, 1499), -1);
+  pTsdb->mem = NULL;
+
+  // the memtable being committed counts too
+  mem.nDel = 0;
+  pTsdb->imem = &mem;
+  ASSERT_EQ(getVer(2000, 2500), -1);
+  ASSERT_EQ(getVer(1000, 1499), ver);
+  pTsdb->imem = NULL;
+
+  ASSERT_EQ(getVer(2000, 2500), ver);
+}
+
+TEST_F(TsdbDataVerTest, rsmaNeverReused) {
+  pVnode->config.isRsma = 1;
+  ASSERT_EQ(getVer(1000, 2000), -1);
+}
@@ -123,6 +123,7 @@ extern "C" {
 #define EXPLAIN_SEQ_WIN_GRP_FORMAT "seq_win_grp=%d"
 #define EXPLAIN_GRP_JOIN_FORMAT "group_join=%d"
 #define EXPLAIN_JOIN_ALGO "algo=%s"
+#define EXPLAIN_JOIN_EST_ROWS_FORMAT "est_rows=%" PRId64 ",%" PRId64
 
 #define COMMAND_RESET_LOG "resetLog"
 #define COMMAND_SCHEDULE_POLICY "schedulePolicy"
@@ -203,6 +203,8 @@ typedef struct SExchangeInfo {
   int64_t             openedTs;  // start exec time stamp, todo: move to SLoadRemoteDataInfo
   char*               pTaskId;
   SArray*             pFetchRpcHandles;
+  bool                hasRtRange;
+  STimeWindow         rtRange;  // primary timestamp range the sources are asked to narrow their scans to
 } SExchangeInfo;
 
 typedef struct SScanInfo {
@@ -233,6 +235,8 @@ typedef struct SAggSupporter {
   SDiskbasedBuf* pResultBuf;           // query result buffer based on blocked-wised disk file
   int32_t        resultRowSize;  // the result buffer size for each result row, with the meta data size for each row
   int32_t        currentPageId;  // current write page id
+  SMemBudget*    pBudget;        // the result buffer and the hash table are charged to it
+  int64_t        hashMemSize;    // hash table memory charged to pBudget
 } SAggSupporter;
 
 typedef struct {
@@ -264,6 +268,7 @@ typedef struct STableScanBase {
   // there are more than one table list exists in one task, if only one vnode exists.
   STableListInfo* pTableListInfo;
   TsdReader       readerAPI;
+  STimeWindow     rtRange;  // primary timestamp range pushed down at runtime, each bound is accessed atomically
 } STableScanBase;
 
 typedef struct STableScanInfo {
@@ -562,6 +567,11 @@ typedef struct SIntervalAggOperatorInfo {
   uint64_t      curGroupId;  // initialize to UINT64_MAX
   uint64_t      handledGroupNum;
   BoundedQueue* pBQ;
+  // for the time ordered input of a single table, windows are emitted once closed instead of kept in the hash
+  bool          sortedAgg;
+  bool          sortedWinOpen;
+  STimeWindow   sortedWin;
+  SResultRow*   pSortedRow;
 } SIntervalAggOperatorInfo;
 
 typedef struct SMergeAlignedIntervalAggOperatorInfo {
@@ -839,6 +849,8 @@ void     cleanupResultInfoWithoutHash(SExecTaskInfo* pTaskInfo, SExprSupp* pSup,
 int32_t initAggSup(SExprSupp* pSup, SAggSupporter* pAggSup, SExprInfo* pExprInfo, int32_t numOfCols, size_t keyBufSize,
                    const char* pkey, void* pState, SFunctionStateStore* pStore);
 void    cleanupAggSup(SAggSupporter* pAggSup);
+void    aggSupSetMemBudget(SAggSupporter* pAggSup, SMemBudget* pBudget);
+void    aggSupUpdateMemUsage(SAggSupporter* pAggSup);
 
 void initResultSizeInfo(SResultInfo* pResultInfo, int32_t numOfRows);
 
@@ -24,6 +24,14 @@ extern "C" {
 #define HJOIN_BLK_SIZE_LIMIT 10485760
 #define HJOIN_ROW_BITMAP_SIZE (2 * 1048576)
 #define HJOIN_BLK_THRESHOLD_RATIO 0.9
+#define HJOIN_MAX_MEM_PAGE_NUM 32
+#define HJOIN_SPILL_PAGE_SIZE 1048576
+#define HJOIN_SPILL_MEM_BUF_SIZE (16 * 1048576)
+#define HJOIN_BLOOM_MIN_KEY_NUM 65536
+#define HJOIN_BLOOM_ERROR_RATE 0.01
+#define HJOIN_BLOOM_SAMPLE_ROWS 8192
+#define HJOIN_BLOOM_MIN_FILTER_RATIO 0.3
+#define HJOIN_MAX_INIT_HASH_CAP 262144  // the estimated build rows only preset the key hash up to this
 
 typedef int32_t (*hJoinImplFp)(SOperatorInfo*);
 
@@ -71,7 +79,8 @@ typedef struct SHJoinColInfo {
 typedef struct SBufPageInfo {
   int32_t pageSize;
   int32_t offset;
-  char*   data;
+  char*   data;         // NULL if the page is held by the spill buffer
+  int32_t spillPageId;
 } SBufPageInfo;
 
 
@@ -126,6 +135,10 @@ typedef struct SHJoinExecInfo {
   int64_t probeBlkRows;
   int64_t resRows;
   int64_t expectRows;
+  int64_t spillPageNum;
+  int64_t bloomCheckRows;
+  int64_t bloomFilterRows;
+  bool    rangePushed;
 } SHJoinExecInfo;
 
 
@@ -143,8 +156,17 @@ typedef struct SHJoinOperatorInfo {
   int32_t          pResColNum;
   int8_t*          pResColMap;
   SArray*          pRowBufs;
+  SDiskbasedBuf*   pSpillBuf;
+  void*            pSpillPage;
   SSHashObj*       pKeyHash;
+  SBloomFilter*    pKeyBloom;
+  int32_t          bloomMinKeyNum;  // build keys needed before pKeyBloom is built
   bool             keyHashBuilt;
+  SMemBudget*      pBudget;
+  int64_t          rowPageMemSize;  // in-memory row pages charged to pBudget
+  int64_t          keyHashMemSize;  // key hash charged to pBudget once the build side is done
+  bool             buildRangeOn;    // both primary keys are join keys, see hJoinPushdownBuildRange
+  STimeWindow      buildKeyRange;   // primary timestamp range of the build rows
   SHJoinCtx        ctx;
   SHJoinExecInfo   execInfo;
   int32_t          blkThreshold;
@@ -173,6 +195,7 @@ typedef struct SHJoinOperatorInfo {
 int32_t hInnerJoinDo(struct SOperatorInfo* pOperator);
 int32_t hLeftJoinDo(struct SOperatorInfo* pOperator);
 void hJoinSetDone(struct SOperatorInfo* pOperator);
+SGroupData* hJoinGetProbeGroup(SHJoinOperatorInfo* pJoin, char* pKey, size_t keyLen);
 void hJoinAppendResToBlock(struct SOperatorInfo* pOperator, SSDataBlock* pRes, bool* allFetched);
 bool hJoinCopyKeyColsDataToBuf(SHJoinTableCtx* pTable, int32_t rowIdx, size_t *pBufLen);
 int32_t hJoinCopyMergeMidBlk(SHJoinCtx* pCtx, SSDataBlock** ppMid, SSDataBlock** ppFin);
@@ -187,6 +187,12 @@ void           destroyOperatorAndDownstreams(SOperatorInfo* pOperator, SOperator
 int32_t        extractOperatorInTree(SOperatorInfo* pOperator, int32_t type, const char* id, SOperatorInfo** pOptrInfo);
 int32_t        getTableScanInfo(SOperatorInfo* pOperator, int32_t* order, int32_t* scanFlag, bool inheritUsOrder);
 int32_t        stopTableScanOperator(SOperatorInfo* pOperator, const char* pIdStr, SStorageAPI* pAPI);
+/**
+ * narrow the primary timestamp range read by a table scan operator, or requested by an exchange operator from its
+ * sources if allowRemote, the rows out of the range are skipped before they are returned
+ * @return TSDB_CODE_OPS_NOT_SUPPORT if the operator can not drop rows this way
+ */
+int32_t        setOperatorRuntimeRange(SOperatorInfo* pOperator, const STimeWindow* pWin, bool allowRemote);
 int32_t        getOperatorExplainExecInfo(struct SOperatorInfo* operatorInfo, SArray* pExecInfoList);
 void *         getOperatorParam(int32_t opType, SOperatorParam* param, int32_t idx);
 
@@ -96,8 +96,14 @@ struct SExecTaskInfo {
   SOperatorParam*       pOpParam;
   bool                  paramSet;
   SQueryAutoQWorkerPoolCB* pWorkerCb;
+  SMemBudget            memBudget;     // buffers of the operators kept in memory, its parent is gQueryMemBudget
+  int64_t               sourcePeakMem; // sum of the peak memory reported by the sources of the exchange operators
+  int32_t               flushRows;     // low latency mode: rows returned by one execution at most, 0: not limited
+  int32_t               rootThreshold; // the threshold of the root operator before the low latency mode
 };
 
+extern SMemBudget gQueryMemBudget;
+
 void    buildTaskId(uint64_t taskId, uint64_t queryId, char* dst);
 int32_t doCreateTask(uint64_t queryId, uint64_t taskId, int32_t vgId, EOPTR_EXEC_MODEL model, SStorageAPI* pAPI,
                      SExecTaskInfo** pTaskInfo);
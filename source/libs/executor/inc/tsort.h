@@ -22,6 +22,7 @@ extern "C" {
 
 #include "os.h"
 #include "tcommon.h"
+#include "tmembudget.h"
 
 enum {
   SORT_MULTISOURCE_MERGE = 0x1,
@@ -83,6 +84,14 @@ int32_t tsortCreateSortHandle(SArray* pOrderInfo, int32_t type, int32_t pageSize
 
 void tsortSetForceUsePQSort(SSortHandle* pHandle);
 
+/**
+ * The in-memory pages and the rows of the run being accumulated are charged to the budget, runs are flushed to disk
+ * earlier once it is used up.
+ * @param pHandle
+ * @param pBudget
+ */
+void tsortSetMemBudget(SSortHandle* pHandle, SMemBudget* pBudget);
+
 /**
  *
  * @param pSortHandle
@@ -102,6 +102,7 @@ int32_t createAggregateOperatorInfo(SOperatorInfo* downstream, SAggPhysiNode* pA
   code = initAggSup(&pOperator->exprSupp, &pInfo->aggSup, pExprInfo, num, keyBufSize, pTaskInfo->id.str,
                                pTaskInfo->streamInfo.pState, &pTaskInfo->storageAPI.functionStore);
   TSDB_CHECK_CODE(code, lino, _error);
+  aggSupSetMemBudget(&pInfo->aggSup, &pTaskInfo->memBudget);
 
   if (pAggNode->pExprs != NULL) {
     code = createExprInfo(pAggNode->pExprs, NULL, &pScalarExprInfo, &numOfScalarExpr);
@@ -253,6 +254,7 @@ static bool nextGroupedResult(SOperatorInfo* pOperator) {
       T_LONG_JMP(pTaskInfo->env, code);
     }
 
+    aggSupUpdateMemUsage(&pAggInfo->aggSup);
     destroyDataBlockForEmptyInput(blockAllocated, &pBlock);
   }
 
@@ -702,11 +704,36 @@ void cleanupResultInfo(SExecTaskInfo* pTaskInfo, SExprSupp* pSup, SDiskbasedBuf*
 }
 
 void cleanupAggSup(SAggSupporter* pAggSup) {
+  memBudgetRelease(pAggSup->pBudget, pAggSup->hashMemSize);
+  pAggSup->hashMemSize = 0;
   taosMemoryFreeClear(pAggSup->keyBuf);
   tSimpleHashCleanup(pAggSup->pResultRowHashTable);
   destroyDiskbasedBuf(pAggSup->pResultBuf);
 }
 
+void aggSupSetMemBudget(SAggSupporter* pAggSup, SMemBudget* pBudget) {
+  pAggSup->pBudget = pBudget;
+  setBufPageMemBudget(pAggSup->pResultBuf, pBudget);
+}
+
+/*
+ * The result rows are spilled by the paged buffer, while the hash table locating them can not be spilled, its growth
+ * is charged unconditionally, so that the following result pages are spilled earlier.
+ */
+void aggSupUpdateMemUsage(SAggSupporter* pAggSup) {
+  if (pAggSup->pBudget == NULL) {
+    return;
+  }
+
+  int64_t size = (int64_t)tSimpleHashGetMemSize(pAggSup->pResultRowHashTable);
+  if (size > pAggSup->hashMemSize) {
+    memBudgetAcquire(pAggSup->pBudget, size - pAggSup->hashMemSize);
+  } else if (size < pAggSup->hashMemSize) {
+    memBudgetRelease(pAggSup->pBudget, pAggSup->hashMemSize - size);
+  }
+  pAggSup->hashMemSize = size;
+}
+
 int32_t initAggSup(SExprSupp* pSup, SAggSupporter* pAggSup, SExprInfo* pExprInfo, int32_t numOfCols, size_t keyBufSize,
                    const char* pkey, void* pState, SFunctionStateStore* pStore) {
   int32_t code = initExprSupp(pSup, pExprInfo, numOfCols, pStore);
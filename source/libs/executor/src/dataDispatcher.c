@@ -110,10 +110,10 @@ static int32_t toDataCacheEntry(SDataDispatchHandle* pHandle, const SInputData*
         qError("failed to encode data block, code: %d", dataLen);
         return terrno;
       }
-      int32_t len =
-          tsCompressString(pHandle->pCompressBuf, dataLen, 1, pEntry->data, pBuf->allocSize, ONE_STAGE_COMP, NULL, 0);
-      if (len < dataLen) {
-        pEntry->compressed = 1;
+      int8_t  compressType = pHandle->pManager->cfg.compress;
+      int32_t len = blockCompressEncoded(compressType, pHandle->pCompressBuf, dataLen, pEntry->data, pBuf->allocSize);
+      if (len > 0 && len < dataLen) {
+        pEntry->compressed = compressType;
         pEntry->dataLen = len;
         pEntry->rawLen = dataLen;
       } else {  // no need to compress data
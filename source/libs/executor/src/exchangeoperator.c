@@ -25,6 +25,9 @@
 #include "tref.h"
 #include "trpc.h"
 
+// the blocks the exchange operator is willing to buffer, shared by the sources as fetch credits
+#define EXCHANGE_BUFFERED_BLOCKS_LIMIT 32
+
 typedef struct SFetchRspHandleWrapper {
   uint32_t exchangeId;
   int32_t  sourceIndex;
@@ -43,6 +46,8 @@ typedef struct SSourceDataInfo {
   bool               tableSeq;
   char*              decompBuf;
   int32_t            decompBufSize;
+  int64_t            peakMem;     // latest peak memory reported by the source
+  int64_t            rspPeakMem;  // peak memory in the trailer of pRsp, 0 if there is none
 } SSourceDataInfo;
 
 static void destroyExchangeOperatorInfo(void* param);
@@ -58,10 +63,19 @@ static int32_t seqLoadRemoteData(SOperatorInfo* pOperator);
 static int32_t prepareLoadRemoteData(SOperatorInfo* pOperator);
 static int32_t handleLimitOffset(SOperatorInfo* pOperator, SLimitInfo* pLimitInfo, SSDataBlock* pBlock,
                                  bool holdDataInBuf);
-static int32_t doExtractResultBlocks(SExchangeInfo* pExchangeInfo, SSourceDataInfo* pDataInfo);
+static int32_t doExtractResultBlocks(SExchangeInfo* pExchangeInfo, SSourceDataInfo* pDataInfo,
+                                     SRetrieveTableRsp* pRetrieveRsp);
 
 static int32_t exchangeWait(SOperatorInfo* pOperator, SExchangeInfo* pExchangeInfo);
 
+// the peak memory reported by a source only grows, so the task keeps the sum of the latest peak of each source
+static void updateSourcePeakMem(SExecTaskInfo* pTaskInfo, SSourceDataInfo* pDataInfo) {
+  if (pDataInfo->rspPeakMem > pDataInfo->peakMem) {
+    (void)atomic_add_fetch_64(&pTaskInfo->sourcePeakMem, pDataInfo->rspPeakMem - pDataInfo->peakMem);
+    pDataInfo->peakMem = pDataInfo->rspPeakMem;
+  }
+}
+
 static void concurrentlyLoadRemoteDataImpl(SOperatorInfo* pOperator, SExchangeInfo* pExchangeInfo,
                                            SExecTaskInfo* pTaskInfo) {
   int32_t code = 0;
@@ -108,6 +122,7 @@ static void concurrentlyLoadRemoteDataImpl(SOperatorInfo* pOperator, SExchangeIn
       SRetrieveTableRsp*     pRsp = pDataInfo->pRsp;
       SDownstreamSourceNode* pSource = taosArrayGet(pExchangeInfo->pSources, pDataInfo->index);
       QUERY_CHECK_NULL(pSource, code, lino, _error, terrno);
+      updateSourcePeakMem(pTaskInfo, pDataInfo);
 
       // todo
       SLoadRemoteDataInfo* pLoadInfo = &pExchangeInfo->loadInfo;
@@ -130,17 +145,33 @@ static void concurrentlyLoadRemoteDataImpl(SOperatorInfo* pOperator, SExchangeIn
         break;
       }
 
-      code = doExtractResultBlocks(pExchangeInfo, pDataInfo);
+      // ask the source for the next blocks before decoding these ones, so that the source keeps producing and
+      // sending while this rsp is consumed, the rsp is detached since the next one is delivered to the same slot
+      int64_t startTs = pDataInfo->startTime;
+      pDataInfo->pRsp = NULL;
+      if (pRsp->completed == 1) {
+        pDataInfo->status = EX_SOURCE_DATA_EXHAUSTED;
+      }
+
+      if (pDataInfo->status != EX_SOURCE_DATA_EXHAUSTED || NULL != pDataInfo->pSrcUidList) {
+        pDataInfo->status = EX_SOURCE_DATA_NOT_READY;
+        code = doSendFetchDataRequest(pExchangeInfo, pTaskInfo, i);
+        if (code != TSDB_CODE_SUCCESS) {
+          taosMemoryFree(pRsp);
+          goto _error;
+        }
+      }
+
+      code = doExtractResultBlocks(pExchangeInfo, pDataInfo, pRsp);
       if (code != TSDB_CODE_SUCCESS) {
+        taosMemoryFree(pRsp);
         goto _error;
       }
 
-      SRetrieveTableRsp* pRetrieveRsp = pDataInfo->pRsp;
-      updateLoadRemoteInfo(pLoadInfo, pRetrieveRsp->numOfRows, pRetrieveRsp->compLen, pDataInfo->startTime, pOperator);
-      pDataInfo->totalRows += pRetrieveRsp->numOfRows;
+      updateLoadRemoteInfo(pLoadInfo, pRsp->numOfRows, pRsp->compLen, startTs, pOperator);
+      pDataInfo->totalRows += pRsp->numOfRows;
 
       if (pRsp->completed == 1) {
-        pDataInfo->status = EX_SOURCE_DATA_EXHAUSTED;
         qDebug("%s fetch msg rsp from vgId:%d, taskId:0x%" PRIx64
                " execId:%d index:%d completed, blocks:%d, numOfRows:%" PRId64 ", rowsOfSource:%" PRIu64
                ", totalRows:%" PRIu64 ", total:%.2f Kb, try next %d/%" PRIzu,
@@ -154,16 +185,7 @@ static void concurrentlyLoadRemoteDataImpl(SOperatorInfo* pOperator, SExchangeIn
                pRsp->numOfRows, pLoadInfo->totalRows, pLoadInfo->totalSize / 1024.0);
       }
 
-      taosMemoryFreeClear(pDataInfo->pRsp);
-
-      if (pDataInfo->status != EX_SOURCE_DATA_EXHAUSTED || NULL != pDataInfo->pSrcUidList) {
-        pDataInfo->status = EX_SOURCE_DATA_NOT_READY;
-        code = doSendFetchDataRequest(pExchangeInfo, pTaskInfo, i);
-        if (code != TSDB_CODE_SUCCESS) {
-          taosMemoryFreeClear(pDataInfo->pRsp);
-          goto _error;
-        }
-      }
+      taosMemoryFree(pRsp);
       return;
     }  // end loop
 
@@ -544,6 +566,7 @@ int32_t loadRemoteDataCallback(void* param, SDataBuf* pMsg, int32_t code) {
     pRsp->numOfCols = htonl(pRsp->numOfCols);
     pRsp->useconds = htobe64(pRsp->useconds);
     pRsp->numOfBlocks = htonl(pRsp->numOfBlocks);
+    pSourceDataInfo->rspPeakMem = tGetFetchRspPeakMem(pRsp, pRsp->compLen, (int32_t)pMsg->len);
 
     qDebug("%s fetch rsp received, index:%d, blocks:%d, rows:%" PRId64 ", %p", pSourceDataInfo->taskId, index,
            pRsp->numOfBlocks, pRsp->numOfRows, pExchangeInfo);
@@ -602,6 +625,13 @@ int32_t buildTableScanOperatorParam(SOperatorParam** ppRes, SArray* pUidList, in
   return TSDB_CODE_SUCCESS;
 }
 
+// the number of blocks a source may pack into one fetch rsp, the blocks not consumed yet are taken out of the credit
+static int32_t getFetchCredit(SExchangeInfo* pExchangeInfo) {
+  int32_t numOfSources = pExchangeInfo->seqLoadData ? 1 : taosArrayGetSize(pExchangeInfo->pSources);
+  int32_t available = EXCHANGE_BUFFERED_BLOCKS_LIMIT - (int32_t)taosArrayGetSize(pExchangeInfo->pResultBlockList);
+  return TMAX(1, available / TMAX(1, numOfSources));
+}
+
 int32_t doSendFetchDataRequest(SExchangeInfo* pExchangeInfo, SExecTaskInfo* pTaskInfo, int32_t sourceIndex) {
   int32_t          code = TSDB_CODE_SUCCESS;
   int32_t          lino = 0;
@@ -643,6 +673,10 @@ int32_t doSendFetchDataRequest(SExchangeInfo* pExchangeInfo, SExecTaskInfo* pTas
     req.taskId = pSource->taskId;
     req.queryId = pTaskInfo->id.queryId;
     req.execId = pSource->execId;
+    req.credit = getFetchCredit(pExchangeInfo);
+    req.hasRuntimeRange = pExchangeInfo->hasRtRange;
+    req.runtimeRange = pExchangeInfo->rtRange;
+    req.withPeakMem = 1;
     if (pDataInfo->pSrcUidList) {
       int32_t code =
           buildTableScanOperatorParam(&req.pOpParam, pDataInfo->pSrcUidList, pDataInfo->srcOpType, pDataInfo->tableSeq);
@@ -850,11 +884,11 @@ int32_t prepareConcurrentlyLoad(SOperatorInfo* pOperator) {
   return TSDB_CODE_SUCCESS;
 }
 
-int32_t doExtractResultBlocks(SExchangeInfo* pExchangeInfo, SSourceDataInfo* pDataInfo) {
-  int32_t            code = TSDB_CODE_SUCCESS;
-  int32_t            lino = 0;
-  SRetrieveTableRsp* pRetrieveRsp = pDataInfo->pRsp;
-  SSDataBlock*       pb = NULL;
+int32_t doExtractResultBlocks(SExchangeInfo* pExchangeInfo, SSourceDataInfo* pDataInfo,
+                              SRetrieveTableRsp* pRetrieveRsp) {
+  int32_t      code = TSDB_CODE_SUCCESS;
+  int32_t      lino = 0;
+  SSDataBlock* pb = NULL;
 
   char* pNextStart = pRetrieveRsp->data;
   char* pStart = pNextStart;
@@ -898,16 +932,13 @@ int32_t doExtractResultBlocks(SExchangeInfo* pExchangeInfo, SSourceDataInfo* pDa
 
     pNextStart = pStart + compLen;
     if (pRetrieveRsp->compressed && (compLen < rawLen)) {
-      int32_t t = tsDecompressString(pStart, compLen, 1, pDataInfo->decompBuf, rawLen, ONE_STAGE_COMP, NULL, 0);
-      QUERY_CHECK_CONDITION((t == rawLen), code, lino, _end, TSDB_CODE_QRY_EXECUTOR_INTERNAL_ERROR);
+      code = blockDecompressEncoded(pRetrieveRsp->compressed, pStart, compLen, pDataInfo->decompBuf, rawLen);
+      QUERY_CHECK_CODE(code, lino, _end);
       pStart = pDataInfo->decompBuf;
     }
 
     code = extractDataBlockFromFetchRsp(pb, pStart, NULL, &pStart);
-    if (code != 0) {
-      taosMemoryFreeClear(pDataInfo->pRsp);
-      goto _end;
-    }
+    QUERY_CHECK_CODE(code, lino, _end);
 
     void* tmp = taosArrayPush(pExchangeInfo->pResultBlockList, &pb);
     QUERY_CHECK_NULL(tmp, code, lino, _end, terrno);
@@ -972,6 +1003,7 @@ int32_t seqLoadRemoteData(SOperatorInfo* pOperator) {
 
     SRetrieveTableRsp*   pRsp = pDataInfo->pRsp;
     SLoadRemoteDataInfo* pLoadInfo = &pExchangeInfo->loadInfo;
+    updateSourcePeakMem(pTaskInfo, pDataInfo);
 
     if (pRsp->numOfRows == 0) {
       qDebug("%s vgId:%d, taskID:0x%" PRIx64 " execId:%d %d of total completed, rowsOfSource:%" PRIu64
@@ -985,8 +1017,9 @@ int32_t seqLoadRemoteData(SOperatorInfo* pOperator) {
       continue;
     }
 
-    code = doExtractResultBlocks(pExchangeInfo, pDataInfo);
+    code = doExtractResultBlocks(pExchangeInfo, pDataInfo, pRsp);
     if (code != TSDB_CODE_SUCCESS) {
+      taosMemoryFreeClear(pDataInfo->pRsp);
       goto _error;
     }
 
@@ -2746,6 +2746,33 @@ int32_t buildGroupIdMapForAllTables(STableListInfo* pTableListInfo, SReadHandle*
   return code;
 }
 
+// keep the tables of this split of the super table scan, the other splits of the vgroup scan the rest
+static void splitScanTableList(STableListInfo* pTableListInfo, int32_t splitIdx, int32_t splitNum, uint8_t* digest) {
+  SArray* pList = pTableListInfo->pTableList;
+  int32_t numOfTables = taosArrayGetSize(pList);
+  int32_t num = 0;
+  for (int32_t i = 0; i < numOfTables; ++i) {
+    STableKeyInfo* pInfo = taosArrayGet(pList, i);
+    if ((uint64_t)pInfo->uid % splitNum == splitIdx) {
+      if (num != i) {
+        *(STableKeyInfo*)taosArrayGet(pList, num) = *pInfo;
+      }
+      ++num;
+    }
+  }
+  taosArrayPopTailBatch(pList, numOfTables - num);
+
+  // the cached group list is keyed by the digest, keep the lists of the splits apart from the whole one
+  T_MD5_CTX context = {0};
+  tMD5Init(&context);
+  tMD5Update(&context, digest, tListLen(context.digest) + 1);
+  tMD5Update(&context, (uint8_t*)&splitIdx, sizeof(splitIdx));
+  tMD5Update(&context, (uint8_t*)&splitNum, sizeof(splitNum));
+  tMD5Final(&context);
+  digest[0] = 1;
+  memcpy(digest + 1, context.digest, tListLen(context.digest));
+}
+
 int32_t createScanTableListInfo(SScanPhysiNode* pScanNode, SNodeList* pGroupTags, bool groupSort, SReadHandle* pHandle,
                                 STableListInfo* pTableListInfo, SNode* pTagCond, SNode* pTagIndexCond,
                                 SExecTaskInfo* pTaskInfo) {
@@ -2765,6 +2792,13 @@ int32_t createScanTableListInfo(SScanPhysiNode* pScanNode, SNodeList* pGroupTags
     return code;
   }
 
+  if ((QUERY_NODE_PHYSICAL_PLAN_TABLE_SCAN == nodeType(pScanNode) ||
+       QUERY_NODE_PHYSICAL_PLAN_TABLE_MERGE_SCAN == nodeType(pScanNode)) &&
+      ((STableScanPhysiNode*)pScanNode)->tableSplitNum > 1) {
+    STableScanPhysiNode* pTableScanNode = (STableScanPhysiNode*)pScanNode;
+    splitScanTableList(pTableListInfo, pTableScanNode->tableSplitIdx, pTableScanNode->tableSplitNum, digest);
+  }
+
   int32_t numOfTables = taosArrayGetSize(pTableListInfo->pTableList);
 
   int64_t st1 = taosGetTimestampUs();
@@ -598,6 +598,13 @@ void qUpdateOperatorParam(qTaskInfo_t tinfo, void* pParam) {
   ((SExecTaskInfo*)tinfo)->paramSet = false;
 }
 
+void qDestroyOperatorParam(void* pParam) { destroyOperatorParam(pParam); }
+
+static SDataSinkMgtCfg initDataSinkMgtCfg(int8_t compressResult) {
+  SDataSinkMgtCfg cfg = {.maxDataBlockNum = 500, .maxDataBlockNumPerQuery = 50, .compress = compressResult};
+  return cfg;
+}
+
 int32_t qCreateExecTask(SReadHandle* readHandle, int32_t vgId, uint64_t taskId, SSubplan* pSubplan,
                         qTaskInfo_t* pTaskInfo, DataSinkHandle* handle, int8_t compressResult, char* sql,
                         EOPTR_EXEC_MODEL model) {
@@ -613,7 +620,7 @@ int32_t qCreateExecTask(SReadHandle* readHandle, int32_t vgId, uint64_t taskId,
   }
 
   if (handle) {
-    SDataSinkMgtCfg cfg = {.maxDataBlockNum = 500, .maxDataBlockNumPerQuery = 50, .compress = compressResult};
+    SDataSinkMgtCfg cfg = initDataSinkMgtCfg(compressResult);
     void*           pSinkManager = NULL;
     code = dsDataSinkMgtInit(&cfg, &(*pTask)->storageAPI, &pSinkManager);
     if (code != TSDB_CODE_SUCCESS) {
@@ -644,11 +651,51 @@ _error:
   return code;
 }
 
+int32_t qCreateExecSink(SReadHandle* readHandle, SSubplan* pSubplan, DataSinkHandle* handle, int8_t compressResult) {
+  if (NULL == pSubplan->pDataSink || QUERY_NODE_PHYSICAL_PLAN_DISPATCH != nodeType(pSubplan->pDataSink)) {
+    return TSDB_CODE_QRY_INVALID_INPUT;
+  }
+
+  SDataSinkMgtCfg cfg = initDataSinkMgtCfg(compressResult);
+  void*           pSinkManager = NULL;
+  int32_t         code = dsDataSinkMgtInit(&cfg, &readHandle->api, &pSinkManager);
+  if (code != TSDB_CODE_SUCCESS) {
+    qError("failed to dsDataSinkMgtInit, code:%s, QID:0x%" PRIx64, tstrerror(code), pSubplan->id.queryId);
+    return code;
+  }
+
+  code = dsCreateDataSinker(pSinkManager, pSubplan->pDataSink, handle, NULL, "");
+  if (code) {
+    qError("failed to create data sinker, code:%s, QID:0x%" PRIx64, tstrerror(code), pSubplan->id.queryId);
+  }
+  return code;
+}
+
 static void freeBlock(void* param) {
   SSDataBlock* pBlock = *(SSDataBlock**)param;
   blockDataDestroy(pBlock);
 }
 
+// only a projection at the root accumulates its input up to the threshold before returning it
+static void setTaskFlushThreshold(SExecTaskInfo* pTaskInfo) {
+  SOperatorInfo* pRoot = pTaskInfo->pRoot;
+  if (QUERY_NODE_PHYSICAL_PLAN_PROJECT != pRoot->operatorType) {
+    return;
+  }
+
+  pRoot->resultInfo.threshold =
+      (pTaskInfo->flushRows > 0) ? TMIN(pTaskInfo->rootThreshold, pTaskInfo->flushRows) : pTaskInfo->rootThreshold;
+}
+
+static void growTaskFlushThreshold(SExecTaskInfo* pTaskInfo, int32_t maxRows) {
+  pTaskInfo->flushRows <<= 1;
+  if (pTaskInfo->flushRows >= TMAX(maxRows, pTaskInfo->rootThreshold)) {
+    pTaskInfo->flushRows = 0;
+    qDebug("%s low latency mode ends, usual batches are returned", GET_TASKID(pTaskInfo));
+  }
+  setTaskFlushThreshold(pTaskInfo);
+}
+
 int32_t qExecTaskOpt(qTaskInfo_t tinfo, SArray* pResList, uint64_t* useconds, bool* hasMore, SLocalFetch* pLocal) {
   int32_t        code = TSDB_CODE_SUCCESS;
   int32_t        lino = 0;
@@ -715,6 +762,9 @@ int32_t qExecTaskOpt(qTaskInfo_t tinfo, SArray* pResList, uint64_t* useconds, bo
   if (!pTaskInfo->pSubplan->dynamicRowThreshold || 4096 <= pTaskInfo->pSubplan->rowsThreshold) {
     rowsThreshold = 4096;
   }
+  if (pTaskInfo->flushRows > 0) {
+    rowsThreshold = TMIN(rowsThreshold, pTaskInfo->flushRows);
+  }
 
   int32_t blockIndex = 0;
   while (pRes != NULL) {
@@ -756,6 +806,9 @@ int32_t qExecTaskOpt(qTaskInfo_t tinfo, SArray* pResList, uint64_t* useconds, bo
   if (pTaskInfo->pSubplan->dynamicRowThreshold) {
     pTaskInfo->pSubplan->rowsThreshold -= current;
   }
+  if (pTaskInfo->flushRows > 0 && current > 0) {
+    growTaskFlushThreshold(pTaskInfo, 4096);
+  }
 
   *hasMore = (pRes != NULL);
   uint64_t el = (taosGetTimestampUs() - st);
@@ -974,6 +1027,47 @@ bool qTaskIsExecuting(qTaskInfo_t qinfo) {
   return 0 != atomic_load_64(&pTaskInfo->owner);
 }
 
+int64_t qGetTaskPeakMem(qTaskInfo_t tinfo) {
+  SExecTaskInfo* pTaskInfo = (SExecTaskInfo*)tinfo;
+  if (NULL == pTaskInfo) {
+    return 0;
+  }
+
+  return memBudgetGetPeak(&pTaskInfo->memBudget) + atomic_load_64(&pTaskInfo->sourcePeakMem);
+}
+
+void qSetTaskLowLatency(qTaskInfo_t tinfo) {
+  SExecTaskInfo* pTaskInfo = (SExecTaskInfo*)tinfo;
+  if (NULL == pTaskInfo || NULL == pTaskInfo->pRoot || pTaskInfo->pSubplan->dynamicRowThreshold) {
+    return;
+  }
+
+  pTaskInfo->rootThreshold = pTaskInfo->pRoot->resultInfo.threshold;
+  pTaskInfo->flushRows = 1;
+  setTaskFlushThreshold(pTaskInfo);
+  qDebug("%s low latency mode, root threshold:%d", GET_TASKID(pTaskInfo), pTaskInfo->rootThreshold);
+}
+
+int32_t qUpdateTaskRuntimeRange(qTaskInfo_t tinfo, const STimeWindow* pWin) {
+  SExecTaskInfo* pTaskInfo = (SExecTaskInfo*)tinfo;
+  if (NULL == pTaskInfo || NULL == pTaskInfo->pRoot) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  // the caller is not the thread executing the task, so only the scans at the root, whose range is updated
+  // atomically, are narrowed
+  int32_t code = setOperatorRuntimeRange(pTaskInfo->pRoot, pWin, false);
+  if (code == TSDB_CODE_SUCCESS) {
+    qDebug("%s runtime range %" PRId64 "-%" PRId64 " applied", GET_TASKID(pTaskInfo), pWin->skey, pWin->ekey);
+  }
+  return TSDB_CODE_SUCCESS;
+}
+
+void qGetQueryMemUsage(int64_t* pUsed, int64_t* pLimit) {
+  *pUsed = memBudgetGetUsed(&gQueryMemBudget);
+  *pLimit = atomic_load_64(&gQueryMemBudget.limit);
+}
+
 static void printTaskExecCostInLog(SExecTaskInfo* pTaskInfo) {
   STaskCostInfo* pSummary = &pTaskInfo->cost;
   int64_t        idleTime = pSummary->start - pSummary->created;
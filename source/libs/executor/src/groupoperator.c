@@ -29,17 +29,38 @@
 #include "thash.h"
 #include "ttypes.h"
 
+#define GROUPBY_VEC_MIN_ROWS 256
+
+// buffers for grouping a whole data block at a time, only used when all group by columns are fixed-width.
+typedef struct SGroupKeyVecBuf {
+  bool         enabled;
+  int32_t      keyWidth;      // null flags + values of all group by columns in a packed key
+  int32_t      capacity;      // number of rows the buffers can hold
+  int32_t      numOfSlots;    // size of the open addressing table, power of 2
+  char*        pKeys;         // packed keys of all rows, row by row
+  uint32_t*    pHash;         // hash value of each packed key
+  int32_t*     pRowGroup;     // group index in current block of each row
+  int32_t*     pGroupRow;     // first row of each group
+  uint32_t*    pGroupHash;    // hash value of each group
+  int32_t*     pGroupSize;    // number of rows of each group
+  int32_t*     pGroupOffset;  // start position of each group after rows are clustered by group
+  int32_t*     pSlots;        // linear probing table, group index or -1
+  int32_t*     pOrder;        // rows clustered by group, in the order of first appearance
+  SSDataBlock* pClustered;    // private copy of current block with rows clustered by group
+} SGroupKeyVecBuf;
+
 typedef struct SGroupbyOperatorInfo {
-  SOptrBasicInfo binfo;
-  SAggSupporter  aggSup;
-  SArray*        pGroupCols;     // group by columns, SArray<SColumn>
-  SArray*        pGroupColVals;  // current group column values, SArray<SGroupKeys>
-  bool           isInit;         // denote if current val is initialized or not
-  char*          keyBuf;         // group by keys for hash
-  int32_t        groupKeyLen;    // total group by column width
-  SGroupResInfo  groupResInfo;
-  SExprSupp      scalarSup;
+  SOptrBasicInfo  binfo;
+  SAggSupporter   aggSup;
+  SArray*         pGroupCols;     // group by columns, SArray<SColumn>
+  SArray*         pGroupColVals;  // current group column values, SArray<SGroupKeys>
+  bool            isInit;         // denote if current val is initialized or not
+  char*           keyBuf;         // group by keys for hash
+  int32_t         groupKeyLen;    // total group by column width
+  SGroupResInfo   groupResInfo;
+  SExprSupp       scalarSup;
   SOperatorInfo  *pOperator;
+  SGroupKeyVecBuf vecBuf;
 } SGroupbyOperatorInfo;
 
 // The sort in partition may be needed later.
@@ -75,6 +96,22 @@ static void freeGroupKey(void* param) {
   taosMemoryFree(pKey->pData);
 }
 
+static void cleanupGroupKeyVecBuf(SGroupKeyVecBuf* pVec) {
+  taosMemoryFreeClear(pVec->pKeys);
+  taosMemoryFreeClear(pVec->pHash);
+  taosMemoryFreeClear(pVec->pRowGroup);
+  taosMemoryFreeClear(pVec->pGroupRow);
+  taosMemoryFreeClear(pVec->pGroupHash);
+  taosMemoryFreeClear(pVec->pGroupSize);
+  taosMemoryFreeClear(pVec->pGroupOffset);
+  taosMemoryFreeClear(pVec->pSlots);
+  taosMemoryFreeClear(pVec->pOrder);
+  blockDataDestroy(pVec->pClustered);
+  pVec->pClustered = NULL;
+  pVec->capacity = 0;
+  pVec->numOfSlots = 0;
+}
+
 static void destroyGroupOperatorInfo(void* param) {
   if (param == NULL) {
     return;
@@ -82,6 +119,7 @@ static void destroyGroupOperatorInfo(void* param) {
   SGroupbyOperatorInfo* pInfo = (SGroupbyOperatorInfo*)param;
 
   cleanupBasicInfo(&pInfo->binfo);
+  cleanupGroupKeyVecBuf(&pInfo->vecBuf);
   taosMemoryFreeClear(pInfo->keyBuf);
   taosArrayDestroy(pInfo->pGroupCols);
   taosArrayDestroyEx(pInfo->pGroupColVals, freeGroupKey);
@@ -366,6 +404,256 @@ static void doHashGroupbyAgg(SOperatorInfo* pOperator, SSDataBlock* pBlock) {
   }
 }
 
+static void initGroupKeyVecBuf(SGroupKeyVecBuf* pVec, const SArray* pGroupCols) {
+  int32_t numOfGroupCols = taosArrayGetSize(pGroupCols);
+
+  pVec->enabled = (numOfGroupCols > 0);
+  pVec->keyWidth = numOfGroupCols;
+  for (int32_t i = 0; i < numOfGroupCols; ++i) {
+    SColumn* pCol = taosArrayGet(pGroupCols, i);
+    if (IS_VAR_DATA_TYPE(pCol->type) || pCol->type == TSDB_DATA_TYPE_JSON) {
+      pVec->enabled = false;
+      break;
+    }
+    pVec->keyWidth += pCol->bytes;
+  }
+}
+
+static int32_t ensureGroupKeyVecBuf(SGroupKeyVecBuf* pVec, int32_t rows) {
+  if (rows <= pVec->capacity) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  cleanupGroupKeyVecBuf(pVec);
+
+  int32_t numOfSlots = 1;
+  while (numOfSlots < rows * 2) {
+    numOfSlots <<= 1;
+  }
+
+  pVec->pKeys = taosMemoryMalloc((int64_t)rows * pVec->keyWidth);
+  pVec->pHash = taosMemoryMalloc(rows * sizeof(uint32_t));
+  pVec->pRowGroup = taosMemoryMalloc(rows * sizeof(int32_t));
+  pVec->pGroupRow = taosMemoryMalloc(rows * sizeof(int32_t));
+  pVec->pGroupHash = taosMemoryMalloc(rows * sizeof(uint32_t));
+  pVec->pGroupSize = taosMemoryMalloc(rows * sizeof(int32_t));
+  pVec->pGroupOffset = taosMemoryMalloc(rows * sizeof(int32_t));
+  pVec->pOrder = taosMemoryMalloc(rows * sizeof(int32_t));
+  pVec->pSlots = taosMemoryMalloc(numOfSlots * sizeof(int32_t));
+  if (pVec->pKeys == NULL || pVec->pHash == NULL || pVec->pRowGroup == NULL || pVec->pGroupRow == NULL ||
+      pVec->pGroupHash == NULL || pVec->pGroupSize == NULL || pVec->pGroupOffset == NULL || pVec->pOrder == NULL ||
+      pVec->pSlots == NULL) {
+    cleanupGroupKeyVecBuf(pVec);
+    return terrno;
+  }
+
+  pVec->capacity = rows;
+  pVec->numOfSlots = numOfSlots;
+  return TSDB_CODE_SUCCESS;
+}
+
+#define PACK_GROUP_KEY_COL(_bytes)                                          \
+  do {                                                                      \
+    for (int32_t j = 0; j < rows; ++j) {                                    \
+      char* pDst = pVec->pKeys + (int64_t)j * pVec->keyWidth;               \
+      if (hasNull && colDataIsNull_f(pColInfoData->nullbitmap, j)) {        \
+        pDst[i] = 1;                                                        \
+        memset(pDst + offset, 0, (_bytes));                                 \
+      } else {                                                              \
+        pDst[i] = 0;                                                        \
+        memcpy(pDst + offset, pColInfoData->pData + j * (_bytes), (_bytes)); \
+      }                                                                     \
+    }                                                                       \
+  } while (0)
+
+// pack the group by columns of all rows into fixed-width keys, one column at a time
+static void packGroupKeys(SGroupKeyVecBuf* pVec, SArray* pGroupCols, SSDataBlock* pBlock) {
+  int32_t rows = pBlock->info.rows;
+  int32_t numOfGroupCols = taosArrayGetSize(pGroupCols);
+  int32_t offset = numOfGroupCols;
+
+  for (int32_t i = 0; i < numOfGroupCols; ++i) {
+    SColumn*         pCol = taosArrayGet(pGroupCols, i);
+    SColumnInfoData* pColInfoData = taosArrayGet(pBlock->pDataBlock, pCol->slotId);
+    bool             hasNull = pColInfoData->hasNull;
+    int32_t          bytes = pCol->bytes;
+
+    switch (bytes) {
+      case 1:
+        PACK_GROUP_KEY_COL(1);
+        break;
+      case 2:
+        PACK_GROUP_KEY_COL(2);
+        break;
+      case 4:
+        PACK_GROUP_KEY_COL(4);
+        break;
+      case 8:
+        PACK_GROUP_KEY_COL(8);
+        break;
+      default:
+        PACK_GROUP_KEY_COL(bytes);
+        break;
+    }
+
+    offset += bytes;
+  }
+
+  for (int32_t j = 0; j < rows; ++j) {
+    pVec->pHash[j] = MurmurHash3_32(pVec->pKeys + (int64_t)j * pVec->keyWidth, pVec->keyWidth);
+  }
+}
+
+// assign each row to a group of current block with a linear probing table, return the number of groups
+static int32_t probeGroupKeys(SGroupKeyVecBuf* pVec, int32_t rows, int32_t* pNumOfRuns) {
+  int32_t numOfGroups = 0;
+  int32_t numOfRuns = 0;
+  int32_t mask = pVec->numOfSlots - 1;
+  int32_t width = pVec->keyWidth;
+
+  memset(pVec->pSlots, 0xFF, pVec->numOfSlots * sizeof(int32_t));
+
+  for (int32_t j = 0; j < rows; ++j) {
+    uint32_t    hashVal = pVec->pHash[j];
+    const char* pKey = pVec->pKeys + (int64_t)j * width;
+    int32_t     slot = hashVal & mask;
+    int32_t     groupIdx = -1;
+
+    while (pVec->pSlots[slot] != -1) {
+      int32_t g = pVec->pSlots[slot];
+      if (pVec->pGroupHash[g] == hashVal &&
+          memcmp(pVec->pKeys + (int64_t)pVec->pGroupRow[g] * width, pKey, width) == 0) {
+        groupIdx = g;
+        break;
+      }
+      slot = (slot + 1) & mask;
+    }
+
+    if (groupIdx == -1) {
+      groupIdx = numOfGroups++;
+      pVec->pSlots[slot] = groupIdx;
+      pVec->pGroupRow[groupIdx] = j;
+      pVec->pGroupHash[groupIdx] = hashVal;
+      pVec->pGroupSize[groupIdx] = 0;
+    }
+
+    if (j == 0 || pVec->pRowGroup[j - 1] != groupIdx) {
+      numOfRuns += 1;
+    }
+
+    pVec->pRowGroup[j] = groupIdx;
+    pVec->pGroupSize[groupIdx] += 1;
+  }
+
+  *pNumOfRuns = numOfRuns;
+  return numOfGroups;
+}
+
+static void doAggregateGroupRows(SOperatorInfo* pOperator, SSDataBlock* pBlock, int32_t rowIndex, int32_t num) {
+  SExecTaskInfo*        pTaskInfo = pOperator->pTaskInfo;
+  SGroupbyOperatorInfo* pInfo = pOperator->info;
+  SqlFunctionCtx*       pCtx = pOperator->exprSupp.pCtx;
+
+  recordNewGroupKeys(pInfo->pGroupCols, pInfo->pGroupColVals, pBlock, rowIndex);
+  int32_t len = buildGroupKeys(pInfo->keyBuf, pInfo->pGroupColVals);
+  int32_t ret = setGroupResultOutputBuf(pOperator, &(pInfo->binfo), pOperator->exprSupp.numOfExprs, pInfo->keyBuf, len,
+                                        pBlock->info.id.groupId, pInfo->aggSup.pResultBuf, &pInfo->aggSup);
+  if (ret != TSDB_CODE_SUCCESS) {
+    T_LONG_JMP(pTaskInfo->env, ret);
+  }
+
+  ret = applyAggFunctionOnPartialTuples(pTaskInfo, pCtx, NULL, rowIndex, num, pBlock->info.rows,
+                                        pOperator->exprSupp.numOfExprs);
+  if (ret != TSDB_CODE_SUCCESS) {
+    T_LONG_JMP(pTaskInfo->env, ret);
+  }
+
+  doAssignGroupKeys(pCtx, pOperator->exprSupp.numOfExprs, pBlock->info.rows, rowIndex);
+}
+
+/*
+ * Group a whole block at a time: the fixed-width group keys are packed and hashed column by column, and each row is
+ * assigned to a group of the block with a flat linear probing table. When the rows of a group are scattered over the
+ * block, they are gathered into a private copy of the block so that each group is contiguous (the relative order of
+ * the rows in a group is kept), then the result row of each group is located only once and its aggregates are updated
+ * with one call. The input block belongs to the downstream operator and is never modified.
+ * Return false if the block is not eligible, and the row-wise path should be used.
+ */
+static bool doVecHashGroupbyAgg(SOperatorInfo* pOperator, SSDataBlock* pBlock) {
+  SExecTaskInfo*        pTaskInfo = pOperator->pTaskInfo;
+  SGroupbyOperatorInfo* pInfo = pOperator->info;
+  SGroupKeyVecBuf*      pVec = &pInfo->vecBuf;
+  int32_t               rows = pBlock->info.rows;
+
+  if (!pVec->enabled || rows < GROUPBY_VEC_MIN_ROWS || pBlock->pBlockAgg != NULL) {
+    return false;
+  }
+
+  for (int32_t i = 0; i < taosArrayGetSize(pInfo->pGroupCols); ++i) {
+    SColumn*         pCol = taosArrayGet(pInfo->pGroupCols, i);
+    SColumnInfoData* pColInfoData = taosArrayGet(pBlock->pDataBlock, pCol->slotId);
+    if (pColInfoData == NULL || pColInfoData->info.bytes != pCol->bytes) {
+      return false;
+    }
+  }
+
+  int32_t code = ensureGroupKeyVecBuf(pVec, rows);
+  if (code != TSDB_CODE_SUCCESS) {
+    T_LONG_JMP(pTaskInfo->env, code);
+  }
+
+  packGroupKeys(pVec, pInfo->pGroupCols, pBlock);
+
+  int32_t numOfRuns = 0;
+  int32_t numOfGroups = probeGroupKeys(pVec, rows, &numOfRuns);
+
+  // the rows of each group are already adjacent, or reordering costs more than it saves
+  if (numOfRuns == numOfGroups || (numOfRuns - numOfGroups) * 8 < rows) {
+    int32_t start = 0;
+    for (int32_t j = 1; j <= rows; ++j) {
+      if (j == rows || pVec->pRowGroup[j] != pVec->pRowGroup[start]) {
+        doAggregateGroupRows(pOperator, pBlock, start, j - start);
+        start = j;
+      }
+    }
+  } else {
+    int32_t offset = 0;
+    for (int32_t g = 0; g < numOfGroups; ++g) {
+      pVec->pGroupOffset[g] = offset;
+      offset += pVec->pGroupSize[g];
+    }
+
+    for (int32_t j = 0; j < rows; ++j) {
+      pVec->pOrder[pVec->pGroupOffset[pVec->pRowGroup[j]]++] = j;
+    }
+
+    if (pVec->pClustered == NULL) {
+      code = createOneDataBlock(pBlock, false, &pVec->pClustered);
+      if (code != TSDB_CODE_SUCCESS) {
+        T_LONG_JMP(pTaskInfo->env, code);
+      }
+    }
+
+    code = blockDataGather(pVec->pClustered, pBlock, pVec->pOrder);
+    if (code == TSDB_CODE_SUCCESS) {
+      code = setInputDataBlock(&pOperator->exprSupp, pVec->pClustered, pInfo->binfo.inputTsOrder,
+                               pBlock->info.scanFlag, true);
+    }
+    if (code != TSDB_CODE_SUCCESS) {
+      T_LONG_JMP(pTaskInfo->env, code);
+    }
+
+    int32_t start = 0;
+    for (int32_t g = 0; g < numOfGroups; ++g) {
+      doAggregateGroupRows(pOperator, pVec->pClustered, start, pVec->pGroupSize[g]);
+      start += pVec->pGroupSize[g];
+    }
+  }
+
+  pInfo->isInit = true;
+  return true;
+}
+
 bool hasRemainResultByHash(SOperatorInfo* pOperator) {
   SGroupbyOperatorInfo* pInfo = pOperator->info;
   SSHashObj*            pHashmap = pInfo->aggSup.pResultRowHashTable;
@@ -481,7 +769,10 @@ static int32_t hashGroupbyAggregateNext(SOperatorInfo* pOperator, SSDataBlock**
       QUERY_CHECK_CODE(code, lino, _end);
     }
 
-    doHashGroupbyAgg(pOperator, pBlock);
+    if (!doVecHashGroupbyAgg(pOperator, pBlock)) {
+      doHashGroupbyAgg(pOperator, pBlock);
+    }
+    aggSupUpdateMemUsage(&pInfo->aggSup);
   }
 
   pOperator->status = OP_RES_TO_RETURN;
@@ -556,6 +847,7 @@ int32_t createGroupOperatorInfo(SOperatorInfo* downstream, SAggPhysiNode* pAggNo
 
   code = initGroupOptrInfo(&pInfo->pGroupColVals, &pInfo->groupKeyLen, &pInfo->keyBuf, pInfo->pGroupCols);
   QUERY_CHECK_CODE(code, lino, _error);
+  initGroupKeyVecBuf(&pInfo->vecBuf, pInfo->pGroupCols);
 
   int32_t    num = 0;
   SExprInfo* pExprInfo = NULL;
@@ -566,6 +858,7 @@ int32_t createGroupOperatorInfo(SOperatorInfo* downstream, SAggPhysiNode* pAggNo
   code = initAggSup(&pOperator->exprSupp, &pInfo->aggSup, pExprInfo, num, pInfo->groupKeyLen, pTaskInfo->id.str,
                     pTaskInfo->streamInfo.pState, &pTaskInfo->storageAPI.functionStore);
   QUERY_CHECK_CODE(code, lino, _error);
+  aggSupSetMemBudget(&pInfo->aggSup, &pTaskInfo->memBudget);
 
   code = filterInitFromNode((SNode*)pAggNode->node.pConditions, &pOperator->exprSupp.pFilterInfo, 0);
   QUERY_CHECK_CODE(code, lino, _error);
@@ -1180,6 +1473,7 @@ int32_t createPartitionOperatorInfo(SOperatorInfo* downstream, SPartitionPhysiNo
   if (code != TSDB_CODE_SUCCESS) {
     goto _error;
   }
+  setBufPageMemBudget(pInfo->pBuf, &pTaskInfo->memBudget);
 
   pInfo->rowCapacity =
       blockDataGetCapacityInRow(pInfo->binfo.pRes, getBufPageSize(pInfo->pBuf),
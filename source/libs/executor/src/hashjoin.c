@@ -25,6 +25,7 @@
 #include "thash.h"
 #include "tmsg.h"
 #include "ttypes.h"
+#include "tbloomfilter.h"
 #include "hashjoin.h"
 
 
@@ -56,7 +57,7 @@ int32_t hInnerJoinDo(struct SOperatorInfo* pOperator) {
       continue;
     }
     
-    SGroupData* pGroup = tSimpleHashGet(pJoin->pKeyHash, pProbe->keyData, bufLen);
+    SGroupData* pGroup = hJoinGetProbeGroup(pJoin, pProbe->keyData, bufLen);
 /*
     size_t keySize = 0;
     int32_t* pKey = tSimpleHashGetKey(pGroup, &keySize);
@@ -141,7 +142,7 @@ int32_t hLeftJoinHandleSeqProbeRows(struct SOperatorInfo* pOperator, SHJoinOpera
       continue;
     }
     
-    SGroupData* pGroup = tSimpleHashGet(pJoin->pKeyHash, pProbe->keyData, bufLen);
+    SGroupData* pGroup = hJoinGetProbeGroup(pJoin, pProbe->keyData, bufLen);
 /*
     size_t keySize = 0;
     int32_t* pKey = tSimpleHashGetKey(pGroup, &keySize);
@@ -244,7 +245,7 @@ int32_t hLeftJoinHandleProbeRows(struct SOperatorInfo* pOperator, SHJoinOperator
       continue;
     }
     
-    SGroupData* pGroup = tSimpleHashGet(pJoin->pKeyHash, pProbe->keyData, bufLen);
+    SGroupData* pGroup = hJoinGetProbeGroup(pJoin, pProbe->keyData, bufLen);
 /*
     size_t keySize = 0;
     int32_t* pKey = tSimpleHashGetKey(pGroup, &keySize);
@@ -25,6 +25,7 @@
 #include "thash.h"
 #include "tmsg.h"
 #include "ttypes.h"
+#include "tbloomfilter.h"
 #include "hashjoin.h"
 #include "functionMgt.h"
 
@@ -339,6 +340,11 @@ static int32_t hJoinInitTableInfo(SHJoinOperatorInfo* pJoin, SHashJoinPhysiNode*
   return TSDB_CODE_SUCCESS;
 }
 
+// the estimated memory of a table, the row number alone when the row size is unknown
+static double hJoinGetEstimatedSize(SHJoinTableCtx* pTable) {
+  return (double)pTable->inputStat.inputRowNum * TMAX(1, pTable->inputStat.inputRowSize);
+}
+
 static void hJoinSetBuildAndProbeTable(SHJoinOperatorInfo* pInfo, SHashJoinPhysiNode* pJoinNode) {
   int32_t buildIdx = 0;
   int32_t probeIdx = 1;
@@ -349,7 +355,7 @@ static void hJoinSetBuildAndProbeTable(SHJoinOperatorInfo* pInfo, SHashJoinPhysi
   switch (pInfo->joinType) {
     case JOIN_TYPE_INNER:
     case JOIN_TYPE_FULL:
-      if (pInfo->tbs[0].inputStat.inputRowNum <= pInfo->tbs[1].inputStat.inputRowNum) {
+      if (hJoinGetEstimatedSize(&pInfo->tbs[0]) <= hJoinGetEstimatedSize(&pInfo->tbs[1])) {
         buildIdx = 0;
         probeIdx = 1;
       } else {
@@ -371,6 +377,8 @@ static void hJoinSetBuildAndProbeTable(SHJoinOperatorInfo* pInfo, SHashJoinPhysi
   
   pInfo->pBuild = &pInfo->tbs[buildIdx];
   pInfo->pProbe = &pInfo->tbs[probeIdx];
+  qDebug("hash join build side:%d, estimated input rows:%" PRId64 "/%" PRId64, buildIdx,
+         pInfo->tbs[0].inputStat.inputRowNum, pInfo->tbs[1].inputStat.inputRowNum);
   
   pInfo->pBuild->downStreamIdx = buildIdx;
   pInfo->pProbe->downStreamIdx = probeIdx;
@@ -407,18 +415,71 @@ static int32_t hJoinBuildResColsMap(SHJoinOperatorInfo* pInfo, SHashJoinPhysiNod
 }
 
 
-static FORCE_INLINE int32_t hJoinAddPageToBufs(SArray* pRowBufs) {
+// the page must have been charged to pJoin->pBudget by the caller
+static FORCE_INLINE int32_t hJoinAddPageToBufs(SHJoinOperatorInfo* pJoin) {
   SBufPageInfo page;
   page.pageSize = HASH_JOIN_DEFAULT_PAGE_SIZE;
   page.offset = 0;
+  page.spillPageId = -1;
   page.data = taosMemoryMalloc(page.pageSize);
   if (NULL == page.data) {
+    memBudgetRelease(pJoin->pBudget, page.pageSize);
+    return terrno;
+  }
+
+  if (NULL == taosArrayPush(pJoin->pRowBufs, &page)) {
+    memBudgetRelease(pJoin->pBudget, page.pageSize);
+    taosMemoryFree(page.data);
+    return terrno;
+  }
+
+  pJoin->rowPageMemSize += page.pageSize;
+  return TSDB_CODE_SUCCESS;
+}
+
+static void hJoinReleaseSpillPage(SHJoinOperatorInfo* pJoin) {
+  if (NULL == pJoin->pSpillPage) {
+    return;
+  }
+
+  setBufPageDirty(pJoin->pSpillPage, true);
+  releaseBufPage(pJoin->pSpillBuf, pJoin->pSpillPage);
+  pJoin->pSpillPage = NULL;
+}
+
+/*
+ * Once the build side has used up HJOIN_MAX_MEM_PAGE_NUM in-memory pages, or the memory budget of the task, the
+ * following row pages are allocated from a disk based buffer, which keeps only HJOIN_SPILL_MEM_BUF_SIZE bytes
+ * resident and flushes the rest to tsTempDir. The key hash itself is always kept in memory.
+ */
+static int32_t hJoinAddSpillPageToBufs(SHJoinOperatorInfo* pJoin, const char* idStr) {
+  if (NULL == pJoin->pSpillBuf) {
+    int32_t code = createDiskbasedBuf(&pJoin->pSpillBuf, HJOIN_SPILL_PAGE_SIZE, HJOIN_SPILL_MEM_BUF_SIZE, idStr, tsTempDir);
+    if (code) {
+      qError("%s hash join failed to create spill buf since %s", idStr, tstrerror(code));
+      return code;
+    }
+    setBufPageMemBudget(pJoin->pSpillBuf, pJoin->pBudget);
+    qDebug("%s hash join build side exceeds %d mem pages or its memory budget, start to spill", idStr,
+           (int32_t)taosArrayGetSize(pJoin->pRowBufs));
+  }
+
+  hJoinReleaseSpillPage(pJoin);
+
+  SBufPageInfo page;
+  page.pageSize = HJOIN_SPILL_PAGE_SIZE;
+  page.offset = 0;
+  page.data = NULL;
+  pJoin->pSpillPage = getNewBufPage(pJoin->pSpillBuf, &page.spillPageId);
+  if (NULL == pJoin->pSpillPage) {
     return terrno;
   }
 
-  if (NULL == taosArrayPush(pRowBufs, &page)) {
+  if (NULL == taosArrayPush(pJoin->pRowBufs, &page)) {
     return terrno;
   }
+
+  pJoin->execInfo.spillPageNum++;
   return TSDB_CODE_SUCCESS;
 }
 
@@ -428,7 +489,8 @@ static int32_t hJoinInitBufPages(SHJoinOperatorInfo* pInfo) {
     return terrno;
   }
 
-  return hJoinAddPageToBufs(pInfo->pRowBufs);
+  memBudgetAcquire(pInfo->pBudget, HASH_JOIN_DEFAULT_PAGE_SIZE);
+  return hJoinAddPageToBufs(pInfo);
 }
 
 static void hJoinFreeTableInfo(SHJoinTableCtx* pTable) {
@@ -466,19 +528,31 @@ static void hJoinDestroyKeyHash(SSHashObj** ppHash) {
   *ppHash = NULL;
 }
 
-static FORCE_INLINE int32_t hJoinRetrieveColDataFromRowBufs(SArray* pRowBufs, SBufRowInfo* pRow, char** ppData) {
+static FORCE_INLINE int32_t hJoinRetrieveColDataFromRowBufs(SHJoinOperatorInfo* pJoin, SBufRowInfo* pRow, char** ppData, void** ppSpillPage) {
   *ppData = NULL;
+  *ppSpillPage = NULL;
   
   if ((uint16_t)-1 == pRow->pageId) {
     return TSDB_CODE_SUCCESS;
   }
-  SBufPageInfo *pPage = taosArrayGet(pRowBufs, pRow->pageId);
+  SBufPageInfo *pPage = taosArrayGet(pJoin->pRowBufs, pRow->pageId);
   if (NULL == pPage) {
-    qError("fail to get %d page, total:%d", pRow->pageId, (int32_t)taosArrayGetSize(pRowBufs));
+    qError("fail to get %d page, total:%d", pRow->pageId, (int32_t)taosArrayGetSize(pJoin->pRowBufs));
     QRY_ERR_RET(TSDB_CODE_QRY_EXECUTOR_INTERNAL_ERROR);
   }
+
+  if (pPage->data) {
+    *ppData = pPage->data + pRow->offset;
+    return TSDB_CODE_SUCCESS;
+  }
+
+  *ppSpillPage = getBufPage(pJoin->pSpillBuf, pPage->spillPageId);
+  if (NULL == *ppSpillPage) {
+    qError("fail to load spilled page %d, rowPage:%d", pPage->spillPageId, pRow->pageId);
+    QRY_ERR_RET(terrno);
+  }
   
-  *ppData = pPage->data + pRow->offset;
+  *ppData = (char*)*ppSpillPage + pRow->offset;
 
   return TSDB_CODE_SUCCESS;
 }
@@ -491,9 +565,10 @@ static int32_t hJoinCopyResRowsToBlock(SHJoinOperatorInfo* pJoin, int32_t rowNum
   SBufRowInfo* pRow = pStart;
   int32_t code = 0;
   char* pData = NULL;
+  void* pSpillPage = NULL;
 
   for (int32_t r = 0; r < rowNum; ++r) {
-    HJ_ERR_RET(hJoinRetrieveColDataFromRowBufs(pJoin->pRowBufs, pRow, &pData));
+    HJ_ERR_RET(hJoinRetrieveColDataFromRowBufs(pJoin, pRow, &pData, &pSpillPage));
     
     char* pValData = pData + pBuild->valBitMapSize;
     char* pKeyData = pProbe->keyData;
@@ -504,19 +579,19 @@ static int32_t hJoinCopyResRowsToBlock(SHJoinOperatorInfo* pJoin, int32_t rowNum
         if (pBuild->valCols[buildIdx].keyCol) {
           code = colDataSetVal(pDst, pRes->info.rows + r, pKeyData, false);
           if (code) {
-            return code;
+            goto _return;
           }
           pKeyData += pBuild->valCols[buildIdx].vardata ? varDataTLen(pKeyData) : pBuild->valCols[buildIdx].bytes;
         } else {
           if (colDataIsNull_f(pData, buildValIdx)) {
             code = colDataSetVal(pDst, pRes->info.rows + r, NULL, true);
             if (code) {
-              return code;
+              goto _return;
             }
           } else {
             code = colDataSetVal(pDst, pRes->info.rows + r, pValData, false);
             if (code) {
-              return code;
+              goto _return;
             }
             pValData += pBuild->valCols[buildIdx].vardata ? varDataTLen(pValData) : pBuild->valCols[buildIdx].bytes;
           }
@@ -529,15 +604,26 @@ static int32_t hJoinCopyResRowsToBlock(SHJoinOperatorInfo* pJoin, int32_t rowNum
     
         code = colDataCopyNItems(pDst, pRes->info.rows, colDataGetData(pSrc, pJoin->ctx.probeStartIdx), rowNum, colDataIsNull_s(pSrc, pJoin->ctx.probeStartIdx));
         if (code) {
-          return code;
+          goto _return;
         }
         probeIdx++;
       }
     }
+    if (pSpillPage) {
+      releaseBufPage(pJoin->pSpillBuf, pSpillPage);
+      pSpillPage = NULL;
+    }
     pRow = pRow->next;
   }
 
   return TSDB_CODE_SUCCESS;
+
+_return:
+
+  if (pSpillPage) {
+    releaseBufPage(pJoin->pSpillBuf, pSpillPage);
+  }
+  return code;
 }
 
 int32_t hJoinCopyNMatchRowsToBlock(SHJoinOperatorInfo* pJoin, SSDataBlock* pRes, int32_t startIdx, int32_t rows) {
@@ -731,13 +817,14 @@ static FORCE_INLINE void hJoinCopyValColsDataToBuf(SHJoinTableCtx* pTable, int32
 }
 
 
-static FORCE_INLINE int32_t hJoinGetValBufFromPages(SArray* pPages, int32_t bufSize, char** pBuf, SBufRowInfo* pRow) {
+static FORCE_INLINE int32_t hJoinGetValBufFromPages(SHJoinOperatorInfo* pJoin, int32_t bufSize, char** pBuf, SBufRowInfo* pRow, const char* idStr) {
+  SArray* pPages = pJoin->pRowBufs;
   if (0 == bufSize) {
     pRow->pageId = -1;
     return TSDB_CODE_SUCCESS;
   }
 
-  if (bufSize > HASH_JOIN_DEFAULT_PAGE_SIZE) {
+  if (bufSize > HJOIN_SPILL_PAGE_SIZE) {
     qError("invalid join value buf size:%d", bufSize);
     return TSDB_CODE_INVALID_PARA;
   }
@@ -745,14 +832,22 @@ static FORCE_INLINE int32_t hJoinGetValBufFromPages(SArray* pPages, int32_t bufS
   do {
     SBufPageInfo* page = taosArrayGetLast(pPages);
     if ((page->pageSize - page->offset) >= bufSize) {
-      *pBuf = page->data + page->offset;
+      *pBuf = (page->data ? page->data : (char*)pJoin->pSpillPage) + page->offset;
       pRow->pageId = taosArrayGetSize(pPages) - 1;
       pRow->offset = page->offset;
       page->offset += bufSize;
       return TSDB_CODE_SUCCESS;
     }
 
-    int32_t code = hJoinAddPageToBufs(pPages);
+    if (taosArrayGetSize(pPages) >= UINT16_MAX) {
+      qError("%s hash join build side exceeds max page num %d", idStr, UINT16_MAX);
+      return TSDB_CODE_QRY_EXECUTOR_INTERNAL_ERROR;
+    }
+
+    int32_t code = (taosArrayGetSize(pPages) < HJOIN_MAX_MEM_PAGE_NUM &&
+                    memBudgetTryAcquire(pJoin->pBudget, HASH_JOIN_DEFAULT_PAGE_SIZE))
+                       ? hJoinAddPageToBufs(pJoin)
+                       : hJoinAddSpillPageToBufs(pJoin, idStr);
     if (code) {
       return code;
     }
@@ -777,7 +872,7 @@ static FORCE_INLINE int32_t hJoinGetValBufSize(SHJoinTableCtx* pTable, int32_t r
 }
 
 
-static int32_t hJoinAddRowToHashImpl(SHJoinOperatorInfo* pJoin, SGroupData* pGroup, SHJoinTableCtx* pTable, size_t keyLen, int32_t rowIdx) {
+static int32_t hJoinAddRowToHashImpl(SHJoinOperatorInfo* pJoin, SGroupData* pGroup, SHJoinTableCtx* pTable, size_t keyLen, int32_t rowIdx, const char* idStr) {
   SGroupData group = {0};
   SBufRowInfo* pRow = NULL;
 
@@ -794,7 +889,7 @@ static int32_t hJoinAddRowToHashImpl(SHJoinOperatorInfo* pJoin, SGroupData* pGro
     }
   }
 
-  int32_t code = hJoinGetValBufFromPages(pJoin->pRowBufs, hJoinGetValBufSize(pTable, rowIdx), &pTable->valData, pRow);
+  int32_t code = hJoinGetValBufFromPages(pJoin, hJoinGetValBufSize(pTable, rowIdx), &pTable->valData, pRow, idStr);
   if (code) {
     taosMemoryFree(pRow);
     return code;
@@ -814,7 +909,7 @@ static int32_t hJoinAddRowToHashImpl(SHJoinOperatorInfo* pJoin, SGroupData* pGro
   return TSDB_CODE_SUCCESS;
 }
 
-static int32_t hJoinAddRowToHash(SHJoinOperatorInfo* pJoin, SSDataBlock* pBlock, size_t keyLen, int32_t rowIdx) {
+static int32_t hJoinAddRowToHash(SHJoinOperatorInfo* pJoin, SSDataBlock* pBlock, size_t keyLen, int32_t rowIdx, const char* idStr) {
   SHJoinTableCtx* pBuild = pJoin->pBuild;
   int32_t code = hJoinSetValColsData(pBlock, pBuild);
   if (code) {
@@ -822,7 +917,7 @@ static int32_t hJoinAddRowToHash(SHJoinOperatorInfo* pJoin, SSDataBlock* pBlock,
   }
 
   SGroupData* pGroup = tSimpleHashGet(pJoin->pKeyHash, pBuild->keyData, keyLen);
-  code = hJoinAddRowToHashImpl(pJoin, pGroup, pBuild, keyLen, rowIdx);
+  code = hJoinAddRowToHashImpl(pJoin, pGroup, pBuild, keyLen, rowIdx, idStr);
   if (code) {
     return code;
   }
@@ -874,7 +969,26 @@ static bool hJoinFilterTimeRange(SSDataBlock* pBlock, STimeWindow* pRange, int32
   return true;
 }
 
-static int32_t hJoinAddBlockRowsToHash(SSDataBlock* pBlock, SHJoinOperatorInfo* pJoin) {
+static void hJoinUpdateBuildKeyRange(SSDataBlock* pBlock, SHJoinOperatorInfo* pJoin, int32_t startIdx, int32_t endIdx) {
+  SColumnInfoData* pCol = taosArrayGet(pBlock->pDataBlock, pJoin->pBuild->primCol->srcSlot);
+  if (NULL == pCol) {
+    pJoin->buildRangeOn = false;
+    return;
+  }
+
+  STimeWindow* pRange = &pJoin->buildKeyRange;
+  for (int32_t i = startIdx; i <= endIdx; ++i) {
+    if (colDataIsNull_s(pCol, i)) {
+      continue;
+    }
+
+    TSKEY ts = *(TSKEY*)colDataGetData(pCol, i);
+    pRange->skey = TMIN(pRange->skey, ts);
+    pRange->ekey = TMAX(pRange->ekey, ts);
+  }
+}
+
+static int32_t hJoinAddBlockRowsToHash(SSDataBlock* pBlock, SHJoinOperatorInfo* pJoin, const char* idStr) {
   SHJoinTableCtx* pBuild = pJoin->pBuild;
   int32_t startIdx = 0, endIdx = pBlock->info.rows - 1;
   if (pBuild->hasTimeRange && !hJoinFilterTimeRange(pBlock, &pJoin->tblTimeRange, pBuild->primCol->srcSlot, &startIdx, &endIdx)) {
@@ -883,6 +997,10 @@ static int32_t hJoinAddBlockRowsToHash(SSDataBlock* pBlock, SHJoinOperatorInfo*
 
   HJ_ERR_RET(hJoinLaunchPrimExpr(pBlock, pBuild, startIdx, endIdx));
 
+  if (pJoin->buildRangeOn) {
+    hJoinUpdateBuildKeyRange(pBlock, pJoin, startIdx, endIdx);
+  }
+
   int32_t code = hJoinSetKeyColsData(pBlock, pBuild);
   if (code) {
     return code;
@@ -893,7 +1011,7 @@ static int32_t hJoinAddBlockRowsToHash(SSDataBlock* pBlock, SHJoinOperatorInfo*
     if (hJoinCopyKeyColsDataToBuf(pBuild, i, &bufLen)) {
       continue;
     }
-    code = hJoinAddRowToHash(pJoin, pBlock, bufLen, i);
+    code = hJoinAddRowToHash(pJoin, pBlock, bufLen, i, idStr);
     if (code) {
       return code;
     }
@@ -902,6 +1020,84 @@ static int32_t hJoinAddBlockRowsToHash(SSDataBlock* pBlock, SHJoinOperatorInfo*
   return code;
 }
 
+static int32_t hJoinBuildKeyBloomFilter(SHJoinOperatorInfo* pJoin) {
+  int32_t keyNum = tSimpleHashGetSize(pJoin->pKeyHash);
+  if (keyNum < pJoin->bloomMinKeyNum) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  int32_t code = tBloomFilterInit(keyNum, HJOIN_BLOOM_ERROR_RATE, &pJoin->pKeyBloom);
+  if (code) {
+    return code;
+  }
+
+  void*   pIte = NULL;
+  int32_t iter = 0;
+  size_t  keyLen = 0;
+  while ((pIte = tSimpleHashIterate(pJoin->pKeyHash, pIte, &iter)) != NULL) {
+    void* pKey = tSimpleHashGetKey(pIte, &keyLen);
+    // a duplicated bit pattern is not an error here
+    (void)tBloomFilterPut(pJoin->pKeyBloom, pKey, keyLen);
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
+/*
+ * Probe side rows are checked against a bloom filter on the build keys before the hash lookup, which
+ * saves the cache misses of a large key hash when most probe rows have no match. The filter is
+ * dropped after HJOIN_BLOOM_SAMPLE_ROWS checks if it rejects too few rows to pay for itself.
+ */
+SGroupData* hJoinGetProbeGroup(SHJoinOperatorInfo* pJoin, char* pKey, size_t keyLen) {
+  SBloomFilter* pBloom = pJoin->pKeyBloom;
+  if (pBloom) {
+    bool filtered =
+        (TSDB_CODE_SUCCESS == tBloomFilterNoContain(pBloom, pBloom->hashFn1(pKey, keyLen), pBloom->hashFn2(pKey, keyLen)));
+    pJoin->execInfo.bloomCheckRows++;
+    if (filtered) {
+      pJoin->execInfo.bloomFilterRows++;
+    }
+
+    // checked before a filtered row returns, the last sample row may be filtered itself
+    if (pJoin->execInfo.bloomCheckRows == HJOIN_BLOOM_SAMPLE_ROWS &&
+        pJoin->execInfo.bloomFilterRows < HJOIN_BLOOM_SAMPLE_ROWS * HJOIN_BLOOM_MIN_FILTER_RATIO) {
+      qDebug("hash join bloom filter disabled, filtered %" PRId64 " of %" PRId64 " rows", pJoin->execInfo.bloomFilterRows,
+             pJoin->execInfo.bloomCheckRows);
+      tBloomFilterDestroy(pJoin->pKeyBloom);
+      pJoin->pKeyBloom = NULL;
+    }
+
+    if (filtered) {
+      return NULL;
+    }
+  }
+
+  return tSimpleHashGet(pJoin->pKeyHash, pKey, keyLen);
+}
+
+/*
+ * A probe row can only match when its primary timestamp is in the range of the build rows. The range narrows the
+ * time range of the probe rows filtered before the lookup, and is pushed down to the probe side scan, local or behind
+ * an exchange, which skips the file sets, blocks and rows out of it.
+ */
+static void hJoinPushdownBuildRange(struct SOperatorInfo* pOperator) {
+  SHJoinOperatorInfo* pJoin = pOperator->info;
+  STimeWindow*        pRange = &pJoin->buildKeyRange;
+  if (!pJoin->buildRangeOn || pRange->skey > pRange->ekey) {
+    return;
+  }
+
+  if (pJoin->pProbe->hasTimeRange) {
+    pJoin->tblTimeRange.skey = TMAX(pJoin->tblTimeRange.skey, pRange->skey);
+    pJoin->tblTimeRange.ekey = TMIN(pJoin->tblTimeRange.ekey, pRange->ekey);
+  }
+
+  int32_t code = setOperatorRuntimeRange(pJoin->pProbe->downStream, pRange, true);
+  pJoin->execInfo.rangePushed = (TSDB_CODE_SUCCESS == code);
+  qDebug("%s hash join build range %" PRId64 "-%" PRId64 " %s", GET_TASKID(pOperator->pTaskInfo), pRange->skey,
+         pRange->ekey, pJoin->execInfo.rangePushed ? "pushed down" : "not pushed down");
+}
+
 static int32_t hJoinBuildHash(struct SOperatorInfo* pOperator, bool* queryDone) {
   SHJoinOperatorInfo* pJoin = pOperator->info;
   SSDataBlock* pBlock = NULL;
@@ -916,16 +1112,29 @@ static int32_t hJoinBuildHash(struct SOperatorInfo* pOperator, bool* queryDone)
     pJoin->execInfo.buildBlkNum++;
     pJoin->execInfo.buildBlkRows += pBlock->info.rows;
 
-    code = hJoinAddBlockRowsToHash(pBlock, pJoin);
+    code = hJoinAddBlockRowsToHash(pBlock, pJoin, GET_TASKID(pOperator->pTaskInfo));
     if (code) {
       return code;
     }
   }
 
+  hJoinReleaseSpillPage(pJoin);
+
+  pJoin->keyHashMemSize = (int64_t)tSimpleHashGetMemSize(pJoin->pKeyHash);
+  memBudgetAcquire(pJoin->pBudget, pJoin->keyHashMemSize);
+
+  code = hJoinBuildKeyBloomFilter(pJoin);
+  if (code) {
+    return code;
+  }
+
   if (IS_INNER_NONE_JOIN(pJoin->joinType, pJoin->subType) && tSimpleHashGetSize(pJoin->pKeyHash) <= 0) {
     hJoinSetDone(pOperator);
     *queryDone = true;
+    return TSDB_CODE_SUCCESS;
   }
+
+  hJoinPushdownBuildRange(pOperator);
   
   //qTrace("build table rows:%" PRId64, hJoinGetRowsNumOfKeyHash(pJoin->pKeyHash));
 
@@ -985,6 +1194,10 @@ void hJoinSetDone(struct SOperatorInfo* pOperator) {
 
   SHJoinOperatorInfo* pInfo = pOperator->info;
   hJoinDestroyKeyHash(&pInfo->pKeyHash);
+  memBudgetRelease(pInfo->pBudget, pInfo->keyHashMemSize);
+  pInfo->keyHashMemSize = 0;
+  tBloomFilterDestroy(pInfo->pKeyBloom);
+  pInfo->pKeyBloom = NULL;
 
   qDebug("hash Join done");  
 }
@@ -1081,11 +1294,15 @@ _end:
 
 static void destroyHashJoinOperator(void* param) {
   SHJoinOperatorInfo* pJoinOperator = (SHJoinOperatorInfo*)param;
-  qDebug("hashJoin exec info, buildBlk:%" PRId64 ", buildRows:%" PRId64 ", probeBlk:%" PRId64 ", probeRows:%" PRId64 ", resRows:%" PRId64, 
+  qDebug("hashJoin exec info, buildBlk:%" PRId64 ", buildRows:%" PRId64 ", probeBlk:%" PRId64 ", probeRows:%" PRId64 ", resRows:%" PRId64
+         ", spillPages:%" PRId64 ", bloomFiltered:%" PRId64 ", rangePushed:%d",
          pJoinOperator->execInfo.buildBlkNum, pJoinOperator->execInfo.buildBlkRows, pJoinOperator->execInfo.probeBlkNum, 
-         pJoinOperator->execInfo.probeBlkRows, pJoinOperator->execInfo.resRows);
+         pJoinOperator->execInfo.probeBlkRows, pJoinOperator->execInfo.resRows, pJoinOperator->execInfo.spillPageNum,
+         pJoinOperator->execInfo.bloomFilterRows, pJoinOperator->execInfo.rangePushed);
 
   hJoinDestroyKeyHash(&pJoinOperator->pKeyHash);
+  tBloomFilterDestroy(pJoinOperator->pKeyBloom);
+  memBudgetRelease(pJoinOperator->pBudget, pJoinOperator->keyHashMemSize + pJoinOperator->rowPageMemSize);
 
   hJoinFreeTableInfo(&pJoinOperator->tbs[0]);
   hJoinFreeTableInfo(&pJoinOperator->tbs[1]);
@@ -1093,6 +1310,7 @@ static void destroyHashJoinOperator(void* param) {
   pJoinOperator->finBlk = NULL;
   taosMemoryFreeClear(pJoinOperator->pResColMap);
   taosArrayDestroyEx(pJoinOperator->pRowBufs, hJoinFreeBufPage);
+  destroyDiskbasedBuf(pJoinOperator->pSpillBuf);
 
   taosMemoryFreeClear(param);
 }
@@ -1170,6 +1388,23 @@ int32_t hJoinInitResBlocks(SHJoinOperatorInfo* pJoin, SHashJoinPhysiNode* pJoinN
 }
 
 
+// the primary timestamps of both sides are compared by the join keys as they are
+static bool hJoinPrimKeyIsJoinKey(SHJoinOperatorInfo* pJoin) {
+  SHJoinTableCtx* pBuild = pJoin->pBuild;
+  SHJoinTableCtx* pProbe = pJoin->pProbe;
+  if (!IS_INNER_NONE_JOIN(pJoin->joinType, pJoin->subType) || pBuild->primExpr || pProbe->primExpr) {
+    return false;
+  }
+
+  for (int32_t i = 0; i < pBuild->keyNum; ++i) {
+    if (pBuild->keyCols[i].srcSlot == pBuild->primCol->srcSlot && pProbe->keyCols[i].srcSlot == pProbe->primCol->srcSlot) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
 int32_t createHashJoinOperatorInfo(SOperatorInfo** pDownstream, int32_t numOfDownstream,
                                            SHashJoinPhysiNode* pJoinNode, SExecTaskInfo* pTaskInfo, SOperatorInfo** pOptrInfo) {
   QRY_PARAM_CHECK(pOptrInfo);
@@ -1193,12 +1428,20 @@ int32_t createHashJoinOperatorInfo(SOperatorInfo** pDownstream, int32_t numOfDow
   HJ_ERR_JRET(hJoinInitTableInfo(pInfo, pJoinNode, pDownstream, 1, &pJoinNode->inputStat[1]));
 
   hJoinSetBuildAndProbeTable(pInfo, pJoinNode);
+
+  pInfo->buildRangeOn = hJoinPrimKeyIsJoinKey(pInfo);
+  pInfo->buildKeyRange = TSWINDOW_DESC_INITIALIZER;
   
   HJ_ERR_JRET(hJoinBuildResColsMap(pInfo, pJoinNode));
 
+  pInfo->pBudget = &pTaskInfo->memBudget;
   HJ_ERR_JRET(hJoinInitBufPages(pInfo));
 
-  size_t hashCap = pInfo->pBuild->inputStat.inputRowNum > 0 ? (pInfo->pBuild->inputStat.inputRowNum * 1.5) : 1024;
+  pInfo->bloomMinKeyNum = HJOIN_BLOOM_MIN_KEY_NUM;
+
+  size_t hashCap = pInfo->pBuild->inputStat.inputRowNum > 0
+                       ? TMIN(pInfo->pBuild->inputStat.inputRowNum * 1.5, HJOIN_MAX_INIT_HASH_CAP)
+                       : 1024;
   pInfo->pKeyHash = tSimpleHashInit(hashCap, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY));
   if (pInfo->pKeyHash == NULL) {
     code = TSDB_CODE_OUT_OF_MEMORY;
@@ -280,6 +280,72 @@ int32_t stopTableScanOperator(SOperatorInfo* pOperator, const char* pIdStr, SSto
   return p.code;
 }
 
+static bool limitInfoIsSet(const SLimitInfo* pLimitInfo) {
+  return pLimitInfo->limit.limit >= 0 || pLimitInfo->limit.offset > 0 || pLimitInfo->slimit.limit >= 0 ||
+         pLimitInfo->slimit.offset > 0;
+}
+
+static void narrowRuntimeRange(STimeWindow* pRange, const STimeWindow* pWin) {
+  int64_t skey = atomic_load_64(&pRange->skey);
+  while (pWin->skey > skey) {
+    int64_t old = atomic_val_compare_exchange_64(&pRange->skey, skey, pWin->skey);
+    if (old == skey) {
+      break;
+    }
+    skey = old;
+  }
+
+  int64_t ekey = atomic_load_64(&pRange->ekey);
+  while (pWin->ekey < ekey) {
+    int64_t old = atomic_val_compare_exchange_64(&pRange->ekey, ekey, pWin->ekey);
+    if (old == ekey) {
+      break;
+    }
+    ekey = old;
+  }
+}
+
+int32_t setOperatorRuntimeRange(SOperatorInfo* pOperator, const STimeWindow* pWin, bool allowRemote) {
+  STableScanBase* pBase = NULL;
+  switch (pOperator->operatorType) {
+    case QUERY_NODE_PHYSICAL_PLAN_TABLE_SCAN: {
+      STableScanInfo* pInfo = pOperator->info;
+      if (pInfo->needCountEmptyTable) {
+        return TSDB_CODE_OPS_NOT_SUPPORT;
+      }
+      pBase = &pInfo->base;
+      break;
+    }
+    case QUERY_NODE_PHYSICAL_PLAN_TABLE_MERGE_SCAN: {
+      STableMergeScanInfo* pInfo = pOperator->info;
+      pBase = &pInfo->base;
+      break;
+    }
+    case QUERY_NODE_PHYSICAL_PLAN_EXCHANGE: {
+      SExchangeInfo* pInfo = pOperator->info;
+      if (!allowRemote || pInfo->dynamicOp || limitInfoIsSet(&pInfo->limitInfo)) {
+        return TSDB_CODE_OPS_NOT_SUPPORT;
+      }
+      if (!pInfo->hasRtRange) {
+        pInfo->rtRange = TSWINDOW_INITIALIZER;
+        pInfo->hasRtRange = true;
+      }
+      narrowRuntimeRange(&pInfo->rtRange, pWin);
+      return TSDB_CODE_SUCCESS;
+    }
+    default:
+      return TSDB_CODE_OPS_NOT_SUPPORT;
+  }
+
+  // the rows dropped by the range must not change the rows kept by a limit
+  if (limitInfoIsSet(&pBase->limitInfo)) {
+    return TSDB_CODE_OPS_NOT_SUPPORT;
+  }
+
+  narrowRuntimeRange(&pBase->rtRange, pWin);
+  return TSDB_CODE_SUCCESS;
+}
+
 int32_t createOperator(SPhysiNode* pPhyNode, SExecTaskInfo* pTaskInfo, SReadHandle* pHandle, SNode* pTagCond,
                               SNode* pTagIndexCond, const char* pUser, const char* dbname, SOperatorInfo** pOptrInfo) {
   QRY_PARAM_CHECK(pOptrInfo);
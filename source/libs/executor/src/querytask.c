@@ -35,6 +35,8 @@
 
 #define CLEAR_QUERY_STATUS(q, st) ((q)->status &= (~(st)))
 
+SMemBudget gQueryMemBudget = {0};
+
 int32_t doCreateTask(uint64_t queryId, uint64_t taskId, int32_t vgId, EOPTR_EXEC_MODEL model, SStorageAPI* pAPI,
                      SExecTaskInfo** pTaskInfo) {
   if (pTaskInfo == NULL) {
@@ -60,6 +62,10 @@ int32_t doCreateTask(uint64_t queryId, uint64_t taskId, int32_t vgId, EOPTR_EXEC
   p->storageAPI = *pAPI;
   taosInitRWLatch(&p->lock);
 
+  // both limits are dynamic options, they take effect on the tasks created afterwards
+  atomic_store_64(&gQueryMemBudget.limit, (int64_t)tsQueryNodeMemBudget * 1048576);
+  memBudgetInit(&p->memBudget, (int64_t)tsQueryTaskMemBudget * 1048576, &gQueryMemBudget);
+
   p->id.vgId = vgId;
   p->id.queryId = queryId;
   p->id.taskId = taskId;
@@ -276,6 +282,13 @@ void doDestroyTask(SExecTaskInfo* pTaskInfo) {
 
   taosArrayDestroyEx(pTaskInfo->pResultBlockList, freeBlock);
   taosArrayDestroy(pTaskInfo->stopInfo.pStopInfo);
+
+  int64_t leftMem = memBudgetGetUsed(&pTaskInfo->memBudget);
+  if (leftMem != 0) {
+    qWarn("%s %" PRId64 " bytes still charged to the task memory budget, release them", GET_TASKID(pTaskInfo), leftMem);
+    memBudgetRelease(&pTaskInfo->memBudget, leftMem);
+  }
+
   taosMemoryFreeClear(pTaskInfo->sql);
   taosMemoryFreeClear(pTaskInfo->id.str);
   taosMemoryFreeClear(pTaskInfo);
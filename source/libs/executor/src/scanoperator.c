@@ -330,6 +330,49 @@ bool applyLimitOffset(SLimitInfo* pLimitInfo, SSDataBlock* pBlock, SExecTaskInfo
   return false;
 }
 
+static bool getScanRuntimeRange(STableScanBase* pTableScanInfo, STimeWindow* pWin) {
+  pWin->skey = atomic_load_64(&pTableScanInfo->rtRange.skey);
+  pWin->ekey = atomic_load_64(&pTableScanInfo->rtRange.ekey);
+  return pWin->skey != INT64_MIN || pWin->ekey != INT64_MAX;
+}
+
+static int32_t doRuntimeRangeFilter(STableScanBase* pTableScanInfo, SSDataBlock* pBlock, const STimeWindow* pWin) {
+  int32_t tsSlot = -1;
+  for (int32_t i = 0; i < taosArrayGetSize(pTableScanInfo->matchInfo.pList); ++i) {
+    SColMatchItem* pItem = taosArrayGet(pTableScanInfo->matchInfo.pList, i);
+    if (pItem->colId == PRIMARYKEY_TIMESTAMP_COL_ID) {
+      tsSlot = pItem->dstSlotId;
+      break;
+    }
+  }
+
+  SColumnInfoData* pCol = taosArrayGet(pBlock->pDataBlock, tsSlot);
+  if (pCol == NULL || pBlock->info.rows == 0) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  // rows of a block are ordered by the timestamp in either direction
+  TSKEY* pts = (TSKEY*)pCol->pData;
+  TSKEY  skey = TMIN(pts[0], pts[pBlock->info.rows - 1]);
+  TSKEY  ekey = TMAX(pts[0], pts[pBlock->info.rows - 1]);
+  if (skey >= pWin->skey && ekey <= pWin->ekey) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  bool* p = taosMemoryMalloc(pBlock->info.rows * sizeof(bool));
+  if (p == NULL) {
+    return terrno;
+  }
+
+  for (int32_t i = 0; i < pBlock->info.rows; ++i) {
+    p[i] = (pts[i] >= pWin->skey && pts[i] <= pWin->ekey);
+  }
+
+  int32_t code = trimDataBlock(pBlock, pBlock->info.rows, p);
+  taosMemoryFree(p);
+  return code;
+}
+
 static int32_t loadDataBlock(SOperatorInfo* pOperator, STableScanBase* pTableScanInfo, SSDataBlock* pBlock,
                              uint32_t* status) {
   int32_t        code = TSDB_CODE_SUCCESS;
@@ -361,6 +404,26 @@ static int32_t loadDataBlock(SOperatorInfo* pOperator, STableScanBase* pTableSca
   SDataBlockInfo* pBlockInfo = &pBlock->info;
   taosMemoryFreeClear(pBlock->pBlockAgg);
 
+  STimeWindow rtRange = {0};
+  bool        hasRtRange = getScanRuntimeRange(pTableScanInfo, &rtRange);
+  if (hasRtRange) {
+    // let the reader skip the remaining file sets and blocks out of the range as well
+    if (pAPI->tsdReader.tsdSetRuntimeRange != NULL) {
+      pAPI->tsdReader.tsdSetRuntimeRange(pTableScanInfo->dataReader, &rtRange);
+    }
+
+    if (pBlockInfo->window.skey > rtRange.ekey || pBlockInfo->window.ekey < rtRange.skey) {
+      qDebug("%s data block filter out by runtime range %" PRId64 "-%" PRId64 ", brange:%" PRId64 "-%" PRId64
+             ", rows:%" PRId64,
+             GET_TASKID(pTaskInfo), rtRange.skey, rtRange.ekey, pBlockInfo->window.skey, pBlockInfo->window.ekey,
+             pBlockInfo->rows);
+      pCost->filterOutBlocks += 1;
+      *status = FUNC_DATA_REQUIRED_FILTEROUT;
+      pAPI->tsdReader.tsdReaderReleaseDataBlock(pTableScanInfo->dataReader);
+      return TSDB_CODE_SUCCESS;
+    }
+  }
+
   if (*status == FUNC_DATA_REQUIRED_FILTEROUT) {
     qDebug("%s data block filter out, brange:%" PRId64 "-%" PRId64 ", rows:%" PRId64, GET_TASKID(pTaskInfo),
            pBlockInfo->window.skey, pBlockInfo->window.ekey, pBlockInfo->rows);
@@ -480,6 +543,11 @@ static int32_t loadDataBlock(SOperatorInfo* pOperator, STableScanBase* pTableSca
   // restore the previous value
   pCost->totalRows -= pBlock->info.rows;
 
+  if (hasRtRange) {
+    code = doRuntimeRangeFilter(pTableScanInfo, pBlock, &rtRange);
+    QUERY_CHECK_CODE(code, lino, _end);
+  }
+
   if (pOperator->exprSupp.pFilterInfo != NULL) {
     code = doFilter(pBlock, pOperator->exprSupp.pFilterInfo, &pTableScanInfo->matchInfo);
     QUERY_CHECK_CODE(code, lino, _end);
@@ -1509,6 +1577,7 @@ int32_t createTableScanOperatorInfo(STableScanPhysiNode* pTableScanNode, SReadHa
   pInfo->sample.seed = taosGetTimestampSec();
 
   pInfo->base.readerAPI = pTaskInfo->storageAPI.tsdReader;
+  pInfo->base.rtRange = TSWINDOW_INITIALIZER;
   initResultSizeInfo(&pOperator->resultInfo, 4096);
   pInfo->pResBlock = createDataBlockFromDescNode(pDescNode);
   QUERY_CHECK_NULL(pInfo->pResBlock, code, lino, _error, terrno);
@@ -5696,6 +5765,7 @@ int32_t startDurationForGroupTableMergeScan(SOperatorInfo* pOperator) {
     return code;
   }
 
+  tsortSetMemBudget(pInfo->pSortHandle, &pTaskInfo->memBudget);
   if (pInfo->bSortRowId && numOfTable != 1) {
     int32_t memSize = 512 * 1024 * 1024;
     code = tsortSetSortByRowId(pInfo->pSortHandle, memSize);
@@ -6072,6 +6142,7 @@ int32_t createTableMergeScanOperatorInfo(STableScanPhysiNode* pTableScanNode, SR
   QUERY_CHECK_NULL(pInfo->base.metaCache.pTableMetaEntryCache, code, lino, _error, terrno);
 
   pInfo->base.readerAPI = pTaskInfo->storageAPI.tsdReader;
+  pInfo->base.rtRange = TSWINDOW_INITIALIZER;
   pInfo->base.dataBlockLoadFlag = FUNC_DATA_REQUIRED_DATA_LOAD;
   pInfo->base.scanFlag = MAIN_SCAN;
   pInfo->base.readHandle = *readHandle;
@@ -374,6 +374,7 @@ int32_t doOpenSortOperator(SOperatorInfo* pOperator) {
                             pInfo->maxTupleLength, tsPQSortMemThreshold * 1024 * 1024, &pInfo->pSortHandle);
   QUERY_CHECK_CODE(code, lino, _end);
 
+  tsortSetMemBudget(pInfo->pSortHandle, &pTaskInfo->memBudget);
   tsortSetFetchRawDataFp(pInfo->pSortHandle, loadNextDataBlock, applyScalarFunction, pOperator);
 
   pSource = taosMemoryCalloc(1, sizeof(SSortSource));
@@ -664,6 +665,7 @@ int32_t beginSortGroup(SOperatorInfo* pOperator) {
     return code;
   }
 
+  tsortSetMemBudget(pInfo->pCurrSortHandle, &pTaskInfo->memBudget);
   tsortSetFetchRawDataFp(pInfo->pCurrSortHandle, fetchNextGroupSortDataBlock, applyScalarFunction, pOperator);
 
   SSortSource*           ps = taosMemoryCalloc(1, sizeof(SSortSource));
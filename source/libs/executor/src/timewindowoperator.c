@@ -69,6 +69,7 @@ static int64_t* extractTsCol(SSDataBlock* pBlock, const SIntervalAggOperatorInfo
 static SResultRowPosition addToOpenWindowList(SResultRowInfo* pResultRowInfo, const SResultRow* pResult,
                                               uint64_t groupId, SExecTaskInfo* pTaskInfo);
 static void doCloseWindow(SResultRowInfo* pResultRowInfo, const SIntervalAggOperatorInfo* pInfo, SResultRow* pResult);
+static int32_t doSortedIntervalAggNext(SOperatorInfo* pOperator, SSDataBlock** ppRes);
 
 static int32_t setTimeWindowOutputBuf(SResultRowInfo* pResultRowInfo, STimeWindow* win, bool masterscan,
                                       SResultRow** pResult, int64_t tableGroupId, SqlFunctionCtx* pCtx,
@@ -960,7 +961,9 @@ static int32_t doOpenIntervalAgg(SOperatorInfo* pOperator) {
     // the pDataBlock are always the same one, no need to call this again
     code = setInputDataBlock(pSup, pBlock, pInfo->binfo.inputTsOrder, scanFlag, true);
     QUERY_CHECK_CODE(code, lino, _end);
-    if (hashIntervalAgg(pOperator, &pInfo->binfo.resultRowInfo, pBlock, scanFlag)) break;
+    bool limitReached = hashIntervalAgg(pOperator, &pInfo->binfo.resultRowInfo, pBlock, scanFlag);
+    aggSupUpdateMemUsage(&pInfo->aggSup);
+    if (limitReached) break;
   }
 
   code = initGroupedResultInfo(&pInfo->groupResInfo, pInfo->aggSup.pResultRowHashTable, pInfo->binfo.outputTsOrder);
@@ -1353,6 +1356,33 @@ _end:
   return code;
 }
 
+/*
+ * A single table read by a plain table scan arrives in timestamp order, so non-overlapping windows are closed one
+ * after another. Such input is aggregated into one result row and each window is emitted as soon as it is closed.
+ */
+static bool intervalInputIsSorted(SIntervalAggOperatorInfo* pInfo, SOperatorInfo* downstream) {
+  SInterval* pInterval = &pInfo->interval;
+  if (pInfo->timeWindowInterpo || pInfo->limited || pInfo->slimited || pInterval->interval != pInterval->sliding ||
+      pInterval->intervalUnit != pInterval->slidingUnit) {
+    return false;
+  }
+
+  if (pInfo->binfo.inputTsOrder != TSDB_ORDER_ASC || pInfo->binfo.outputTsOrder != TSDB_ORDER_ASC ||
+      downstream->operatorType != QUERY_NODE_PHYSICAL_PLAN_TABLE_SCAN) {
+    return false;
+  }
+
+  STableScanInfo* pScanInfo = downstream->info;
+  int32_t         numOfTables = 0;
+  if (pScanInfo->scanInfo.numOfAsc != 1 || pScanInfo->scanInfo.numOfDesc != 0 ||
+      pScanInfo->base.cond.order != TSDB_ORDER_ASC ||
+      tableListGetSize(pScanInfo->base.pTableListInfo, &numOfTables) != TSDB_CODE_SUCCESS) {
+    return false;
+  }
+
+  return numOfTables == 1;
+}
+
 int32_t createIntervalOperatorInfo(SOperatorInfo* downstream, SIntervalPhysiNode* pPhyNode, SExecTaskInfo* pTaskInfo,
                                    SOperatorInfo** pOptrInfo) {
   QRY_PARAM_CHECK(pOptrInfo);
@@ -1389,6 +1419,7 @@ int32_t createIntervalOperatorInfo(SOperatorInfo* downstream, SIntervalPhysiNode
   code = initAggSup(pSup, &pInfo->aggSup, pExprInfo, num, keyBufSize, pTaskInfo->id.str, pTaskInfo->streamInfo.pState,
                     &pTaskInfo->storageAPI.functionStore);
   QUERY_CHECK_CODE(code, lino, _error);
+  aggSupSetMemBudget(&pInfo->aggSup, &pTaskInfo->memBudget);
 
   SInterval interval = {.interval = pPhyNode->interval,
                         .sliding = pPhyNode->sliding,
@@ -1453,11 +1484,19 @@ int32_t createIntervalOperatorInfo(SOperatorInfo* downstream, SIntervalPhysiNode
 
   pInfo->pOperator = pOperator;
   initResultRowInfo(&pInfo->binfo.resultRowInfo);
-  setOperatorInfo(pOperator, "TimeIntervalAggOperator", QUERY_NODE_PHYSICAL_PLAN_HASH_INTERVAL, true, OP_NOT_OPENED,
-                  pInfo, pTaskInfo);
-
-  pOperator->fpSet = createOperatorFpSet(doOpenIntervalAgg, doBuildIntervalResultNext, NULL, destroyIntervalOperatorInfo,
-                                         optrDefaultBufFn, NULL, optrDefaultGetNextExtFn, NULL);
+  pInfo->sortedAgg = intervalInputIsSorted(pInfo, downstream);
+  setOperatorInfo(pOperator, "TimeIntervalAggOperator", QUERY_NODE_PHYSICAL_PLAN_HASH_INTERVAL, !pInfo->sortedAgg,
+                  OP_NOT_OPENED, pInfo, pTaskInfo);
+
+  if (pInfo->sortedAgg) {
+    qDebug("%s interval aggregates the time ordered input of a single table", GET_TASKID(pTaskInfo));
+    pOperator->fpSet = createOperatorFpSet(optrDummyOpenFn, doSortedIntervalAggNext, NULL, destroyIntervalOperatorInfo,
+                                           optrDefaultBufFn, NULL, optrDefaultGetNextExtFn, NULL);
+  } else {
+    pOperator->fpSet = createOperatorFpSet(doOpenIntervalAgg, doBuildIntervalResultNext, NULL,
+                                           destroyIntervalOperatorInfo, optrDefaultBufFn, NULL,
+                                           optrDefaultGetNextExtFn, NULL);
+  }
 
   code = appendDownstream(pOperator, &downstream, 1);
   if (code != TSDB_CODE_SUCCESS) {
@@ -1882,6 +1921,136 @@ static int32_t setSingleOutputTupleBuf(SResultRowInfo* pResultRowInfo, STimeWind
   return setResultRowInitCtx((*pResult), pExprSup->pCtx, pExprSup->numOfExprs, pExprSup->rowEntryInfoOffset);
 }
 
+// the first row after startPos out of the window ending at ekey, found by a galloping search as most windows are short
+static int32_t getSortedWindowEndPos(const TSKEY* tsCols, int32_t startPos, int32_t rows, TSKEY ekey) {
+  if (tsCols[rows - 1] <= ekey) {
+    return rows;
+  }
+
+  int32_t lo = startPos;
+  int32_t step = 1;
+  while (lo + step < rows && tsCols[lo + step] <= ekey) {
+    lo += step;
+    step <<= 1;
+  }
+
+  int32_t hi = TMIN(lo + step, rows - 1);
+  while (lo < hi) {
+    int32_t mid = lo + ((hi - lo) >> 1);
+    if (tsCols[mid] <= ekey) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+
+  return lo;
+}
+
+static void closeSortedIntervalWindow(SOperatorInfo* pOperator, SSDataBlock* pRes) {
+  SIntervalAggOperatorInfo* pInfo = pOperator->info;
+
+  finalizeResultRows(pInfo->aggSup.pResultBuf, &pInfo->binfo.resultRowInfo.cur, &pOperator->exprSupp, pRes,
+                     pOperator->pTaskInfo);
+  resetResultRow(pInfo->pSortedRow, pInfo->aggSup.resultRowSize - sizeof(SResultRow));
+  pInfo->sortedWinOpen = false;
+}
+
+static void doSortedIntervalAggImpl(SOperatorInfo* pOperator, SSDataBlock* pBlock, SSDataBlock* pRes) {
+  SIntervalAggOperatorInfo* pInfo = pOperator->info;
+  SExecTaskInfo*            pTaskInfo = pOperator->pTaskInfo;
+  SExprSupp*                pSup = &pOperator->exprSupp;
+  int64_t*                  tsCols = extractTsCol(pBlock, pInfo, pTaskInfo);
+  int32_t                   rows = pBlock->info.rows;
+  int32_t                   startPos = 0;
+
+  if (tsCols == NULL || rows <= 0) {
+    return;
+  }
+
+  if (pInfo->sortedWinOpen && pInfo->curGroupId != pBlock->info.id.groupId) {
+    closeSortedIntervalWindow(pOperator, pRes);
+  }
+  pInfo->curGroupId = pBlock->info.id.groupId;
+  pRes->info.id.groupId = pBlock->info.id.groupId;
+
+  while (startPos < rows) {
+    if (!pInfo->sortedWinOpen || tsCols[startPos] > pInfo->sortedWin.ekey) {
+      if (pInfo->sortedWinOpen) {
+        closeSortedIntervalWindow(pOperator, pRes);
+      }
+
+      pInfo->sortedWin.skey = taosTimeTruncate(tsCols[startPos], &pInfo->interval);
+      pInfo->sortedWin.ekey = taosTimeGetIntervalEnd(pInfo->sortedWin.skey, &pInfo->interval);
+      int32_t code = setSingleOutputTupleBuf(&pInfo->binfo.resultRowInfo, &pInfo->sortedWin, &pInfo->pSortedRow, pSup,
+                                             &pInfo->aggSup);
+      if (code != TSDB_CODE_SUCCESS || pInfo->pSortedRow == NULL) {
+        T_LONG_JMP(pTaskInfo->env, code);
+      }
+      pInfo->sortedWinOpen = true;
+    }
+
+    int32_t endPos = getSortedWindowEndPos(tsCols, startPos, rows, pInfo->sortedWin.ekey);
+    updateTimeWindowInfo(&pInfo->twAggSup.timeWindowData, &pInfo->sortedWin, 1);
+    int32_t code = applyAggFunctionOnPartialTuples(pTaskInfo, pSup->pCtx, &pInfo->twAggSup.timeWindowData, startPos,
+                                                   endPos - startPos, rows, pSup->numOfExprs);
+    if (code != TSDB_CODE_SUCCESS) {
+      T_LONG_JMP(pTaskInfo->env, code);
+    }
+
+    startPos = endPos;
+  }
+}
+
+static int32_t doSortedIntervalAggNext(SOperatorInfo* pOperator, SSDataBlock** ppRes) {
+  int32_t                   code = TSDB_CODE_SUCCESS;
+  int32_t                   lino = 0;
+  SIntervalAggOperatorInfo* pInfo = pOperator->info;
+  SExecTaskInfo*            pTaskInfo = pOperator->pTaskInfo;
+  SSDataBlock*              pRes = pInfo->binfo.pRes;
+
+  (*ppRes) = NULL;
+  blockDataCleanup(pRes);
+
+  while (pOperator->status != OP_EXEC_DONE && pRes->info.rows == 0) {
+    while (pRes->info.rows < pOperator->resultInfo.threshold) {
+      SSDataBlock* pBlock = getNextBlockFromDownstream(pOperator, 0);
+      if (pBlock == NULL) {
+        if (pInfo->sortedWinOpen) {
+          closeSortedIntervalWindow(pOperator, pRes);
+        }
+        setOperatorCompleted(pOperator);
+        break;
+      }
+
+      pRes->info.scanFlag = pBlock->info.scanFlag;
+      if (pInfo->scalarSupp.pExprInfo != NULL) {
+        SExprSupp* pExprSup = &pInfo->scalarSupp;
+        code = projectApplyFunctions(pExprSup->pExprInfo, pBlock, pBlock, pExprSup->pCtx, pExprSup->numOfExprs, NULL);
+        QUERY_CHECK_CODE(code, lino, _end);
+      }
+
+      code = setInputDataBlock(&pOperator->exprSupp, pBlock, pInfo->binfo.inputTsOrder, pBlock->info.scanFlag, true);
+      QUERY_CHECK_CODE(code, lino, _end);
+      doSortedIntervalAggImpl(pOperator, pBlock, pRes);
+    }
+
+    code = doFilter(pRes, pOperator->exprSupp.pFilterInfo, NULL);
+    QUERY_CHECK_CODE(code, lino, _end);
+  }
+
+  pOperator->resultInfo.totalRows += pRes->info.rows;
+  (*ppRes) = (pRes->info.rows == 0) ? NULL : pRes;
+
+_end:
+  if (code != TSDB_CODE_SUCCESS) {
+    qError("%s failed at line %d since %s", __func__, lino, tstrerror(code));
+    pTaskInfo->code = code;
+    T_LONG_JMP(pTaskInfo->env, code);
+  }
+  return code;
+}
+
 static void doMergeAlignedIntervalAggImpl(SOperatorInfo* pOperatorInfo, SResultRowInfo* pResultRowInfo,
                                           SSDataBlock* pBlock, SSDataBlock* pResultBlock) {
   SMergeAlignedIntervalAggOperatorInfo* miaInfo = pOperatorInfo->info;
@@ -28,6 +28,8 @@
 #include "executil.h"
 
 #define AllocatedTupleType 0
+#define SORT_MAX_PARALLEL_RUNS 8
+#define SORT_PARALLEL_MIN_ROWS 65536
 #define ReferencedTupleType 1 // tuple references to one row in pDataBlock
 
 struct STupleHandle {
@@ -78,6 +80,7 @@ struct SSortHandle {
   uint32_t      pqSortBufSize;
   bool          forceUsePQSort;
   BoundedQueue* pBoundedQueue;
+  int64_t       pqSkippedBlocks;
   uint32_t      tmpRowIdx;
   int64_t       mergeLimit;
   int64_t       currMergeLimitTs;
@@ -114,6 +117,9 @@ struct SSortHandle {
   bool          bSortPk;
   void (*mergeLimitReachedFn)(uint64_t tableUid, void* param);
   void* mergeLimitReachedParam;
+
+  SMemBudget* pBudget;
+  int64_t     runMemSize;  // size of the rows of the next run in pDataBlock charged to pBudget
 };
 
 static void destroySortMemFile(SSortHandle* pHandle);
@@ -123,6 +129,27 @@ void tsortSetSingleTableMerge(SSortHandle* pHandle) {
   pHandle->singleTableMerge = true;
 }
 
+void tsortSetMemBudget(SSortHandle* pHandle, SMemBudget* pBudget) {
+  pHandle->pBudget = pBudget;
+  setBufPageMemBudget(pHandle->pBuf, pBudget);
+}
+
+// false if the budget is used up, and the rows accumulated so far should be flushed as a run
+static bool tsortAcquireRunMem(SSortHandle* pHandle, int64_t size) {
+  if (size > pHandle->runMemSize) {
+    if (!memBudgetTryAcquire(pHandle->pBudget, size - pHandle->runMemSize)) {
+      return false;
+    }
+    pHandle->runMemSize = size;
+  }
+  return true;
+}
+
+static void tsortReleaseRunMem(SSortHandle* pHandle) {
+  memBudgetRelease(pHandle->pBudget, pHandle->runMemSize);
+  pHandle->runMemSize = 0;
+}
+
 void tsortSetAbortCheckFn(SSortHandle *pHandle, bool (*checkFn)(void *), void* param) {
   pHandle->abortCheckFn = checkFn;
   pHandle->abortCheckParam = param;
@@ -412,6 +439,7 @@ void tsortDestroySortHandle(SSortHandle* pSortHandle) {
   destroyDiskbasedBuf(pSortHandle->pBuf);
   taosMemoryFreeClear(pSortHandle->idStr);
   blockDataDestroy(pSortHandle->pDataBlock);
+  tsortReleaseRunMem(pSortHandle);
 
   if (pSortHandle->pBoundedQueue) destroyBoundedQueue(pSortHandle->pBoundedQueue);
 
@@ -485,6 +513,7 @@ static int32_t doAddToBuf(SSDataBlock* pDataBlock, SSortHandle* pHandle) {
       return code;
     }
     dBufSetPrintInfo(pHandle->pBuf);
+    setBufPageMemBudget(pHandle->pBuf, pHandle->pBudget);
   }
 
   SArray* pPageIdList = taosArrayInit(4, sizeof(int32_t));
@@ -586,6 +615,7 @@ static int32_t sortComparInit(SMsortComparParam* pParam, SArray* pSources, int32
       return code;
     } else {
       dBufSetPrintInfo(pHandle->pBuf);
+      setBufPageMemBudget(pHandle->pBuf, pHandle->pBudget);
     }
   }
 
@@ -1143,6 +1173,7 @@ static int32_t createPageBuf(SSortHandle* pHandle) {
       return code;
     } else {
       dBufSetPrintInfo(pHandle->pBuf);
+      setBufPageMemBudget(pHandle->pBuf, pHandle->pBudget);
     }
   }
   return 0;
@@ -2413,6 +2444,168 @@ static void freeSortSource(void* p) {
   taosMemoryFreeClear(*pSource);
 }
 
+typedef struct SSortRunTask {
+  SSDataBlock* pBlock;
+  SArray*      pSortInfo;
+  int32_t      code;
+  int8_t       claimed;  // the run is sorted by whoever claims it first, a queued item or the caller
+} SSortRunTask;
+
+typedef struct SSortRunCtx {
+  int32_t       ref;  // the caller and every queued item that has not run yet
+  tsem_t        ready;
+  SSortRunTask* pTasks;
+} SSortRunCtx;
+
+typedef struct SSortRunParam {
+  SSortRunCtx* pCtx;
+  int32_t      idx;
+} SSortRunParam;
+
+static bool claimAndSortRun(SSortRunTask* pTask) {
+  if (atomic_val_compare_exchange_8(&pTask->claimed, 0, 1) != 0) {
+    return false;
+  }
+  pTask->code = blockDataSort(pTask->pBlock, pTask->pSortInfo);
+  return true;
+}
+
+static void releaseSortRunCtx(SSortRunCtx* pCtx) {
+  if (atomic_sub_fetch_32(&pCtx->ref, 1) == 0) {
+    (void)tsem_destroy(&pCtx->ready);
+    taosMemoryFree(pCtx->pTasks);
+    taosMemoryFree(pCtx);
+  }
+}
+
+static int32_t sortRunAsyncFn(void* param) {
+  SSortRunParam* pParam = param;
+  SSortRunCtx*   pCtx = pParam->pCtx;
+  if (claimAndSortRun(&pCtx->pTasks[pParam->idx])) {
+    (void)tsem_post(&pCtx->ready);
+  }
+  releaseSortRunCtx(pCtx);
+  taosMemoryFree(pParam);
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t getParallelSortRunNum(const SSDataBlock* pBlock) {
+  int32_t numOfRuns = TMIN((int32_t)tsNumOfCores, SORT_MAX_PARALLEL_RUNS);
+  return TMAX(TMIN(numOfRuns, pBlock->info.rows / SORT_PARALLEL_MIN_ROWS), 1);
+}
+
+/*
+ * Split the buffered block into several slices, sort them on the workers of the query task queue and flush every
+ * slice as an individual run. The loser tree merge afterwards does not care how many runs there are.
+ * The caller sorts every slice no worker has started yet, so it never waits on a busy or missing task queue, only on
+ * the slices being sorted.
+ */
+static int32_t sortAndFlushParallelRuns(SSortHandle* pHandle, int32_t numOfRuns) {
+  int32_t      code = 0;
+  int32_t      lino = 0;
+  SSDataBlock* pDataBlock = pHandle->pDataBlock;
+  SSortRunCtx* pCtx = taosMemoryCalloc(1, sizeof(SSortRunCtx));
+  if (pCtx == NULL) {
+    return terrno;
+  }
+  pCtx->ref = 1;
+  code = tsem_init(&pCtx->ready, 0, 0);
+  if (code != TSDB_CODE_SUCCESS) {
+    taosMemoryFree(pCtx);
+    return code;
+  }
+
+  SSortRunTask* pTasks = taosMemoryCalloc(numOfRuns, sizeof(SSortRunTask));
+  pCtx->pTasks = pTasks;
+  QUERY_CHECK_NULL(pTasks, code, lino, _end, terrno);
+
+  int32_t rowsPerRun = pDataBlock->info.rows / numOfRuns;
+  for (int32_t i = 0, start = 0; i < numOfRuns; ++i) {
+    int32_t rows = (i == numOfRuns - 1) ? (pDataBlock->info.rows - start) : rowsPerRun;
+    code = blockDataExtractBlock(pDataBlock, start, rows, &pTasks[i].pBlock);
+    QUERY_CHECK_CODE(code, lino, _end);
+
+    // blockDataSort caches column info in the order info, so each run needs its own copy
+    pTasks[i].pSortInfo = taosArrayDup(pHandle->pSortInfo, NULL);
+    QUERY_CHECK_NULL(pTasks[i].pSortInfo, code, lino, _end, terrno);
+    start += rows;
+  }
+  blockDataCleanup(pDataBlock);
+
+  int64_t st = taosGetTimestampUs();
+  for (int32_t i = 1; i < numOfRuns; ++i) {
+    SSortRunParam* pParam = taosMemoryMalloc(sizeof(SSortRunParam));
+    if (pParam == NULL) {
+      break;
+    }
+    pParam->pCtx = pCtx;
+    pParam->idx = i;
+    (void)atomic_add_fetch_32(&pCtx->ref, 1);
+    if (taosAsyncExec(sortRunAsyncFn, pParam, NULL) != TSDB_CODE_SUCCESS) {
+      // the rest is sorted on the current thread
+      qWarn("%s failed to queue sort run %d since %s", pHandle->idStr, i, tstrerror(terrno));
+      (void)atomic_sub_fetch_32(&pCtx->ref, 1);
+      taosMemoryFree(pParam);
+      break;
+    }
+  }
+
+  int32_t numOfWorkerRuns = numOfRuns;
+  for (int32_t i = 0; i < numOfRuns; ++i) {
+    if (claimAndSortRun(&pTasks[i])) {
+      --numOfWorkerRuns;
+    }
+  }
+  for (int32_t i = 0; i < numOfWorkerRuns; ++i) {
+    (void)tsem_wait(&pCtx->ready);
+  }
+  pHandle->sortElapsed += (taosGetTimestampUs() - st);
+
+  for (int32_t i = 0; i < numOfRuns; ++i) {
+    code = pTasks[i].code;
+    QUERY_CHECK_CODE(code, lino, _end);
+
+    if (pHandle->pqMaxRows > 0) blockDataKeepFirstNRows(pTasks[i].pBlock, pHandle->pqMaxRows);
+    code = doAddToBuf(pTasks[i].pBlock, pHandle);
+    QUERY_CHECK_CODE(code, lino, _end);
+  }
+
+  qDebug("%s sort %d runs in parallel, %d of them on the task queue", pHandle->idStr, numOfRuns, numOfWorkerRuns);
+
+_end:
+  if (code != TSDB_CODE_SUCCESS) {
+    qError("%s failed at line %d since %s", __func__, lino, tstrerror(code));
+  }
+  // a queued item that runs after this only finds its run claimed
+  for (int32_t i = 0; pTasks != NULL && i < numOfRuns; ++i) {
+    blockDataDestroy(pTasks[i].pBlock);
+    pTasks[i].pBlock = NULL;
+    taosArrayDestroy(pTasks[i].pSortInfo);
+    pTasks[i].pSortInfo = NULL;
+  }
+  releaseSortRunCtx(pCtx);
+  return code;
+}
+
+static int32_t sortAndFlushRuns(SSortHandle* pHandle) {
+  int32_t numOfRuns = getParallelSortRunNum(pHandle->pDataBlock);
+  if (numOfRuns > 1) {
+    return sortAndFlushParallelRuns(pHandle, numOfRuns);
+  }
+
+  // Perform the in-memory sort and then flush data in the buffer into disk.
+  int64_t st = taosGetTimestampUs();
+  int32_t code = blockDataSort(pHandle->pDataBlock, pHandle->pSortInfo);
+  if (code) {
+    return code;
+  }
+
+  pHandle->sortElapsed += (taosGetTimestampUs() - st);
+
+  if (pHandle->pqMaxRows > 0) blockDataKeepFirstNRows(pHandle->pDataBlock, pHandle->pqMaxRows);
+  return doAddToBuf(pHandle->pDataBlock, pHandle);
+}
+
 static int32_t createBlocksQuickSortInitialSources(SSortHandle* pHandle) {
   int32_t       code = 0;
   int32_t       lino = 0;
@@ -2452,17 +2645,11 @@ static int32_t createBlocksQuickSortInitialSources(SSortHandle* pHandle) {
     code = blockDataMerge(pHandle->pDataBlock, pBlock);
     QUERY_CHECK_CODE(code, lino, _end);
 
+    // the run is flushed earlier if the memory budget of the task is used up
     size_t size = blockDataGetSize(pHandle->pDataBlock);
-    if (size > sortBufSize) {
-      // Perform the in-memory sort and then flush data in the buffer into disk.
-      int64_t st = taosGetTimestampUs();
-      code = blockDataSort(pHandle->pDataBlock, pHandle->pSortInfo);
-      QUERY_CHECK_CODE(code, lino, _end);
-
-      pHandle->sortElapsed += (taosGetTimestampUs() - st);
-
-      if (pHandle->pqMaxRows > 0) blockDataKeepFirstNRows(pHandle->pDataBlock, pHandle->pqMaxRows);
-      code = doAddToBuf(pHandle->pDataBlock, pHandle);
+    if (size > sortBufSize || !tsortAcquireRunMem(pHandle, size)) {
+      code = sortAndFlushRuns(pHandle);
+      tsortReleaseRunMem(pHandle);
       QUERY_CHECK_CODE(code, lino, _end);
     }
   }
@@ -2470,16 +2657,15 @@ static int32_t createBlocksQuickSortInitialSources(SSortHandle* pHandle) {
   if (pHandle->pDataBlock != NULL && pHandle->pDataBlock->info.rows > 0) {
     size_t size = blockDataGetSize(pHandle->pDataBlock);
 
-    // Perform the in-memory sort and then flush data in the buffer into disk.
-    int64_t st = taosGetTimestampUs();
-    code = blockDataSort(pHandle->pDataBlock, pHandle->pSortInfo);
-    QUERY_CHECK_CODE(code, lino, _end);
+    // All data can fit in memory, external memory sort is not needed. Sort in place and return directly
+    if (size <= sortBufSize && pHandle->pBuf == NULL) {
+      int64_t st = taosGetTimestampUs();
+      code = blockDataSort(pHandle->pDataBlock, pHandle->pSortInfo);
+      QUERY_CHECK_CODE(code, lino, _end);
 
-    if (pHandle->pqMaxRows > 0) blockDataKeepFirstNRows(pHandle->pDataBlock, pHandle->pqMaxRows);
-    pHandle->sortElapsed += (taosGetTimestampUs() - st);
+      if (pHandle->pqMaxRows > 0) blockDataKeepFirstNRows(pHandle->pDataBlock, pHandle->pqMaxRows);
+      pHandle->sortElapsed += (taosGetTimestampUs() - st);
 
-    // All sorted data can fit in memory, external memory sort is not needed. Return to directly
-    if (size <= sortBufSize && pHandle->pBuf == NULL) {
       pHandle->cmpParam.numOfSources = 1;
       pHandle->inMemSort = true;
 
@@ -2487,7 +2673,7 @@ static int32_t createBlocksQuickSortInitialSources(SSortHandle* pHandle) {
       pHandle->tupleHandle.rowIndex = -1;
       pHandle->tupleHandle.pBlock = pHandle->pDataBlock;
     } else {
-      code = doAddToBuf(pHandle->pDataBlock, pHandle);
+      code = sortAndFlushRuns(pHandle);
     }
   }
 
@@ -2713,6 +2899,63 @@ static int32_t tupleComparFn(const void* pLeft, const void* pRight, void* param)
   return 0;
 }
 
+typedef struct SPQSortThreshold {
+  SBlockOrderInfo* pOrder;
+  __compar_fn_t    fn;
+  void*            pVal;
+} SPQSortThreshold;
+
+/*
+ * Once the bounded queue is full, its top is the worst row kept so far. A row whose first sort key is
+ * strictly worse than the top can never get into the queue.
+ */
+static int32_t tsortPQGetThreshold(SSortHandle* pHandle, SSDataBlock* pBlock, SPQSortThreshold* pThreshold) {
+  pThreshold->pVal = NULL;
+  if (taosBQSize(pHandle->pBoundedQueue) < taosBQMaxSize(pHandle->pBoundedQueue)) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  pThreshold->pOrder = taosArrayGet(pHandle->pSortInfo, 0);
+  if (pThreshold->pOrder == NULL) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  SColumnInfoData* pCol = taosArrayGet(pBlock->pDataBlock, pThreshold->pOrder->slotId);
+  if (pCol == NULL || IS_VAR_DATA_TYPE(pCol->info.type) || pCol->info.type == TSDB_DATA_TYPE_DECIMAL) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  PriorityQueueNode* pTop = taosBQTop(pHandle->pBoundedQueue);
+  TAOS_CHECK_RETURN(tupleDescGetField(pTop->data, pThreshold->pOrder->slotId, blockDataGetNumOfCols(pBlock),
+                                      &pThreshold->pVal));
+  pThreshold->fn = getKeyComparFunc(pCol->info.type, pThreshold->pOrder->order);
+  return TSDB_CODE_SUCCESS;
+}
+
+static bool tsortPQRowCanBeSkipped(SPQSortThreshold* pThreshold, SColumnInfoData* pCol, int32_t rowIdx) {
+  if (colDataIsNull_f(pCol->nullbitmap, rowIdx)) {
+    return !pThreshold->pOrder->nullFirst;
+  }
+  return pThreshold->fn(colDataGetData(pCol, rowIdx), pThreshold->pVal) > 0;
+}
+
+static bool tsortPQBlockCanBeSkipped(SPQSortThreshold* pThreshold, SSDataBlock* pBlock, SColumnInfoData* pCol) {
+  if (pBlock->pBlockAgg == NULL || !IS_CONVERT_AS_SIGNED(pCol->info.type)) {
+    return false;
+  }
+
+  SColumnDataAgg* pAgg = &pBlock->pBlockAgg[pThreshold->pOrder->slotId];
+  if (pAgg->colId == -1 || (pAgg->numOfNull > 0 && pThreshold->pOrder->nullFirst) || pAgg->numOfNull == pBlock->info.rows) {
+    return false;
+  }
+
+  // the best value of the block is the min for asc order and the max for desc order
+  int64_t best = (pThreshold->pOrder->order == TSDB_ORDER_ASC) ? pAgg->min : pAgg->max;
+  int64_t threshold = 0;
+  GET_TYPED_DATA(threshold, int64_t, pCol->info.type, pThreshold->pVal);
+  return (pThreshold->pOrder->order == TSDB_ORDER_ASC) ? (best > threshold) : (best < threshold);
+}
+
 static int32_t tsortOpenForPQSort(SSortHandle* pHandle) {
   pHandle->pBoundedQueue = createBoundedQueue(pHandle->pqMaxRows, tsortPQCompFn, destroyTuple, pHandle);
   if (NULL == pHandle->pBoundedQueue) {
@@ -2766,8 +3009,22 @@ static int32_t tsortOpenForPQSort(SSortHandle* pHandle) {
       }
     }
 
+    SPQSortThreshold threshold = {0};
+    SColumnInfoData* pKeyCol = NULL;
+    TAOS_CHECK_RETURN(tsortPQGetThreshold(pHandle, pBlock, &threshold));
+    if (threshold.pVal != NULL) {
+      pKeyCol = taosArrayGet(pBlock->pDataBlock, threshold.pOrder->slotId);
+      if (tsortPQBlockCanBeSkipped(&threshold, pBlock, pKeyCol)) {
+        pHandle->pqSkippedBlocks++;
+        continue;
+      }
+    }
+
     ReferencedTuple refTuple = {.desc.data = (char*)pBlock, .desc.type = ReferencedTupleType, .rowIndex = 0};
     for (size_t rowIdx = 0; rowIdx < pBlock->info.rows; ++rowIdx) {
+      if (pKeyCol != NULL && tsortPQRowCanBeSkipped(&threshold, pKeyCol, rowIdx)) {
+        continue;
+      }
       refTuple.rowIndex = rowIdx;
       pqNode.data = &refTuple;
       PriorityQueueNode* pPushedNode = taosBQPush(pHandle->pBoundedQueue, &pqNode);
@@ -2779,10 +3036,18 @@ static int32_t tsortOpenForPQSort(SSortHandle* pHandle) {
         if (code) {
           return code;
         }
+
+        // the top of the queue has changed, refresh the threshold once the queue is full
+        if (pKeyCol != NULL || taosBQSize(pHandle->pBoundedQueue) == taosBQMaxSize(pHandle->pBoundedQueue)) {
+          TAOS_CHECK_RETURN(tsortPQGetThreshold(pHandle, pBlock, &threshold));
+          pKeyCol = (threshold.pVal != NULL) ? taosArrayGet(pBlock->pDataBlock, threshold.pOrder->slotId) : NULL;
+        }
       }
     }
   }
 
+  qDebug("%s pq sort skipped %" PRId64 " blocks by sma", pHandle->idStr, pHandle->pqSkippedBlocks);
+
   return TSDB_CODE_SUCCESS;
 }
 
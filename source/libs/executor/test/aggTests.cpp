@@ -0,0 +1,523 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <map>
+#include <tuple>
+#include <vector>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+#include "os.h"
+
+#include "executil.h"
+#include "executor.h"
+#include "executorInt.h"
+#include "functionMgt.h"
+#include "operator.h"
+#include "querytask.h"
+#include "tdatablock.h"
+
+namespace {
+
+#define AT_INPUT_BLK_ID  1
+#define AT_OUTPUT_BLK_ID 2
+#define AT_BLOCK_ROWS    1000
+
+// unlike assert, the expression is evaluated in release builds too
+#define AT_CHECK(_expr)                                                     \
+  do {                                                                      \
+    if (!(_expr)) {                                                         \
+      (void)printf("%s:%d check failed: %s\n", __FILE__, __LINE__, #_expr); \
+      abort();                                                              \
+    }                                                                       \
+  } while (0)
+
+typedef struct {
+  SArray* pBlocks;  // SArray<SSDataBlock*>, owned by the test
+  int32_t readIdx;
+} SAggTestSource;
+
+int32_t aggTestSourceNext(SOperatorInfo* pOperator, SSDataBlock** ppRes) {
+  SAggTestSource* pSource = (SAggTestSource*)pOperator->info;
+  *ppRes = NULL;
+  if (pSource->readIdx < taosArrayGetSize(pSource->pBlocks)) {
+    *ppRes = (SSDataBlock*)taosArrayGetP(pSource->pBlocks, pSource->readIdx++);
+  }
+  return TSDB_CODE_SUCCESS;
+}
+
+SOperatorInfo* createAggTestSource(SAggTestSource* pSource, SExecTaskInfo* pTask) {
+  SOperatorInfo* p = (SOperatorInfo*)taosMemoryCalloc(1, sizeof(SOperatorInfo));
+  AT_CHECK(p != NULL);
+  p->name = "AggTestSource";
+  p->info = pSource;
+  p->pTaskInfo = pTask;
+  p->resultDataBlockId = AT_INPUT_BLK_ID;
+  p->fpSet.getNextFn = aggTestSourceNext;
+  return p;
+}
+
+SExecTaskInfo* createAggTestTask() {
+  SStorageAPI    api = {0};
+  SExecTaskInfo* pTask = NULL;
+  AT_CHECK(0 == doCreateTask(1, 1, 1, OPTR_EXEC_MODEL_BATCH, &api, &pTask));
+  return pTask;
+}
+
+SSDataBlock* createAggTestBlock(const int8_t* types, int32_t numOfCols, int32_t rows) {
+  SSDataBlock* p = NULL;
+  AT_CHECK(0 == createDataBlock(&p));
+  p->info.id.blockId = AT_INPUT_BLK_ID;
+  for (int32_t i = 0; i < numOfCols; ++i) {
+    SColumnInfoData col = createColumnInfoData(types[i], tDataTypes[types[i]].bytes, i);
+    AT_CHECK(0 == blockDataAppendColInfo(p, &col));
+  }
+  AT_CHECK(0 == blockDataEnsureCapacity(p, rows));
+  return p;
+}
+
+SSDataBlock* cloneAggTestBlock(SSDataBlock* pBlock) {
+  SSDataBlock* p = NULL;
+  AT_CHECK(0 == createOneDataBlock(pBlock, true, &p));
+  return p;
+}
+
+void assertSameBlock(SSDataBlock* pExpected, SSDataBlock* pActual) {
+  ASSERT_EQ(pExpected->info.rows, pActual->info.rows);
+  ASSERT_EQ(taosArrayGetSize(pExpected->pDataBlock), taosArrayGetSize(pActual->pDataBlock));
+  for (int32_t c = 0; c < taosArrayGetSize(pExpected->pDataBlock); ++c) {
+    SColumnInfoData* pE = (SColumnInfoData*)taosArrayGet(pExpected->pDataBlock, c);
+    SColumnInfoData* pA = (SColumnInfoData*)taosArrayGet(pActual->pDataBlock, c);
+    for (int32_t r = 0; r < pExpected->info.rows; ++r) {
+      bool isNull = colDataIsNull_s(pE, r);
+      ASSERT_EQ(isNull, colDataIsNull_s(pA, r));
+      if (!isNull) {
+        ASSERT_EQ(0, memcmp(colDataGetData(pE, r), colDataGetData(pA, r), pE->info.bytes));
+      }
+    }
+  }
+}
+
+SColumnNode* createAggTestCol(int16_t blkId, int16_t slotId, int8_t type) {
+  SColumnNode* pCol = NULL;
+  AT_CHECK(0 == nodesMakeNode(QUERY_NODE_COLUMN, (SNode**)&pCol));
+  pCol->dataBlockId = blkId;
+  pCol->slotId = slotId;
+  pCol->colId = slotId + 1;
+  pCol->colType = COLUMN_TYPE_COLUMN;
+  pCol->node.resType.type = type;
+  pCol->node.resType.bytes = tDataTypes[type].bytes;
+  (void)snprintf(pCol->colName, sizeof(pCol->colName), "c%d", slotId);
+  return pCol;
+}
+
+SFunctionNode* createAggTestFunc(const char* pName, SNode* pParam) {
+  SNodeList* pParams = NULL;
+  if (pParam != NULL) {
+    AT_CHECK(0 == nodesListMakeStrictAppend(&pParams, pParam));
+  }
+  SFunctionNode* pFunc = NULL;
+  AT_CHECK(0 == createFunction(pName, pParams, &pFunc));
+  (void)snprintf(pFunc->node.aliasName, sizeof(pFunc->node.aliasName), "%s", pName);
+  return pFunc;
+}
+
+void appendAggTestTarget(SNodeList** ppList, int16_t slotId, SNode* pExpr) {
+  STargetNode* pTarget = NULL;
+  AT_CHECK(0 == nodesMakeNode(QUERY_NODE_TARGET, (SNode**)&pTarget));
+  pTarget->dataBlockId = AT_OUTPUT_BLK_ID;
+  pTarget->slotId = slotId;
+  pTarget->pExpr = pExpr;
+  AT_CHECK(0 == nodesListMakeStrictAppend(ppList, (SNode*)pTarget));
+}
+
+SDataBlockDescNode* createAggTestOutputDesc(const int8_t* types, int32_t numOfCols) {
+  SDataBlockDescNode* pDesc = NULL;
+  AT_CHECK(0 == nodesMakeNode(QUERY_NODE_DATABLOCK_DESC, (SNode**)&pDesc));
+  pDesc->dataBlockId = AT_OUTPUT_BLK_ID;
+  for (int32_t i = 0; i < numOfCols; ++i) {
+    SSlotDescNode* pSlot = NULL;
+    AT_CHECK(0 == nodesMakeNode(QUERY_NODE_SLOT_DESC, (SNode**)&pSlot));
+    pSlot->slotId = i;
+    pSlot->dataType.type = types[i];
+    pSlot->dataType.bytes = tDataTypes[types[i]].bytes;
+    pSlot->output = true;
+    pDesc->totalRowSize += pSlot->dataType.bytes;
+    AT_CHECK(0 == nodesListMakeStrictAppend(&pDesc->pSlots, (SNode*)pSlot));
+  }
+  pDesc->outputRowSize = pDesc->totalRowSize;
+  return pDesc;
+}
+
+void destroyAggTestBlocks(SArray* pBlocks) {
+  for (int32_t i = 0; i < taosArrayGetSize(pBlocks); ++i) {
+    blockDataDestroy((SSDataBlock*)taosArrayGetP(pBlocks, i));
+  }
+  taosArrayDestroy(pBlocks);
+}
+
+/*
+ * group by test: input (k1 INT, k2 BIGINT, v INT), select count(v), sum(v), k1, k2 group by k1, k2
+ */
+typedef std::tuple<bool, int32_t, bool, int64_t> SGroupTestKey;
+typedef std::pair<int64_t, int64_t>              SGroupTestRes;  // count(v), sum(v)
+
+const int8_t gtInputTypes[] = {TSDB_DATA_TYPE_INT, TSDB_DATA_TYPE_BIGINT, TSDB_DATA_TYPE_INT};
+const int8_t gtOutputTypes[] = {TSDB_DATA_TYPE_BIGINT, TSDB_DATA_TYPE_BIGINT, TSDB_DATA_TYPE_INT,
+                                TSDB_DATA_TYPE_BIGINT};
+
+SAggPhysiNode* createGroupTestPhysiNode() {
+  SAggPhysiNode* pNode = NULL;
+  AT_CHECK(0 == nodesMakeNode(QUERY_NODE_PHYSICAL_PLAN_HASH_AGG, (SNode**)&pNode));
+  pNode->node.inputTsOrder = ORDER_ASC;
+  pNode->node.outputTsOrder = ORDER_ASC;
+  pNode->mergeDataBlock = true;
+
+  appendAggTestTarget(&pNode->pAggFuncs, 0,
+                      (SNode*)createAggTestFunc("count", (SNode*)createAggTestCol(AT_INPUT_BLK_ID, 2, TSDB_DATA_TYPE_INT)));
+  appendAggTestTarget(&pNode->pAggFuncs, 1,
+                      (SNode*)createAggTestFunc("sum", (SNode*)createAggTestCol(AT_INPUT_BLK_ID, 2, TSDB_DATA_TYPE_INT)));
+  appendAggTestTarget(&pNode->pGroupKeys, 2, (SNode*)createAggTestCol(AT_INPUT_BLK_ID, 0, TSDB_DATA_TYPE_INT));
+  appendAggTestTarget(&pNode->pGroupKeys, 3, (SNode*)createAggTestCol(AT_INPUT_BLK_ID, 1, TSDB_DATA_TYPE_BIGINT));
+  pNode->node.pOutputDataBlockDesc = createAggTestOutputDesc(gtOutputTypes, 4);
+  return pNode;
+}
+
+// keys of the rows are either scattered over the block, or sorted so that each group is one run
+void fillGroupTestBlock(SSDataBlock* pBlock, int32_t blk, bool sorted, std::map<SGroupTestKey, SGroupTestRes>& expect) {
+  SColumnInfoData* pK1 = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 0);
+  SColumnInfoData* pK2 = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 1);
+  SColumnInfoData* pV = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 2);
+
+  for (int32_t r = 0; r < AT_BLOCK_ROWS; ++r) {
+    int32_t k1 = sorted ? r / 100 : (r * 7 + blk) % 13;
+    bool    k1Null = (!sorted && r % 29 == 0);
+    bool    k2Null = sorted ? (k1 % 2 == 0) : (r % 3 == 0);
+    int64_t k2 = (int64_t)(k1 % 4) * 1000000007LL;
+    bool    vNull = (r % 17 == 0);
+    int32_t v = r + blk;
+
+    AT_CHECK(0 == colDataSetVal(pK1, r, (const char*)&k1, k1Null));
+    AT_CHECK(0 == colDataSetVal(pK2, r, (const char*)&k2, k2Null));
+    AT_CHECK(0 == colDataSetVal(pV, r, (const char*)&v, vNull));
+
+    SGroupTestRes& res = expect[SGroupTestKey(k1Null, k1Null ? 0 : k1, k2Null, k2Null ? 0 : k2)];
+    if (!vNull) {
+      res.first += 1;
+      res.second += v;
+    }
+  }
+  pBlock->info.rows = AT_BLOCK_ROWS;
+}
+
+void runGroupTest(int32_t numOfBlocks, bool (*isSorted)(int32_t blk)) {
+  std::map<SGroupTestKey, SGroupTestRes> expect;
+  SArray*                                pBlocks = taosArrayInit(numOfBlocks, POINTER_BYTES);
+  SArray*                                pSnapshots = taosArrayInit(numOfBlocks, POINTER_BYTES);
+  for (int32_t b = 0; b < numOfBlocks; ++b) {
+    SSDataBlock* pBlock = createAggTestBlock(gtInputTypes, 3, AT_BLOCK_ROWS);
+    fillGroupTestBlock(pBlock, b, isSorted(b), expect);
+    AT_CHECK(NULL != taosArrayPush(pBlocks, &pBlock));
+    SSDataBlock* pSnapshot = cloneAggTestBlock(pBlock);
+    AT_CHECK(NULL != taosArrayPush(pSnapshots, &pSnapshot));
+  }
+
+  SExecTaskInfo* pTask = createAggTestTask();
+  SAggTestSource source = {.pBlocks = pBlocks, .readIdx = 0};
+  SAggPhysiNode* pNode = createGroupTestPhysiNode();
+  SOperatorInfo* pOp = NULL;
+  ASSERT_EQ(0, createGroupOperatorInfo(createAggTestSource(&source, pTask), pNode, pTask, &pOp));
+
+  std::map<SGroupTestKey, SGroupTestRes> actual;
+  while (true) {
+    SSDataBlock* pRes = NULL;
+    ASSERT_EQ(0, pOp->fpSet.getNextFn(pOp, &pRes));
+    if (pRes == NULL) {
+      break;
+    }
+
+    SColumnInfoData* pCnt = (SColumnInfoData*)taosArrayGet(pRes->pDataBlock, 0);
+    SColumnInfoData* pSum = (SColumnInfoData*)taosArrayGet(pRes->pDataBlock, 1);
+    SColumnInfoData* pK1 = (SColumnInfoData*)taosArrayGet(pRes->pDataBlock, 2);
+    SColumnInfoData* pK2 = (SColumnInfoData*)taosArrayGet(pRes->pDataBlock, 3);
+    for (int32_t r = 0; r < pRes->info.rows; ++r) {
+      bool          k1Null = colDataIsNull_s(pK1, r);
+      bool          k2Null = colDataIsNull_s(pK2, r);
+      SGroupTestKey key(k1Null, k1Null ? 0 : *(int32_t*)colDataGetData(pK1, r), k2Null,
+                        k2Null ? 0 : *(int64_t*)colDataGetData(pK2, r));
+      ASSERT_EQ(actual.count(key), 0);
+
+      int64_t cnt = *(int64_t*)colDataGetData(pCnt, r);
+      int64_t sum = colDataIsNull_s(pSum, r) ? 0 : *(int64_t*)colDataGetData(pSum, r);
+      actual[key] = SGroupTestRes(cnt, sum);
+    }
+  }
+
+  ASSERT_EQ(expect.size(), actual.size());
+  for (auto& it : expect) {
+    ASSERT_EQ(actual.count(it.first), 1);
+    ASSERT_EQ(it.second.first, actual[it.first].first);
+    ASSERT_EQ(it.second.second, actual[it.first].second);
+  }
+
+  // the input blocks belong to the downstream operator and must be left as they were
+  for (int32_t b = 0; b < numOfBlocks; ++b) {
+    assertSameBlock((SSDataBlock*)taosArrayGetP(pSnapshots, b), (SSDataBlock*)taosArrayGetP(pBlocks, b));
+  }
+
+  destroyOperator(pOp);
+  nodesDestroyNode((SNode*)pNode);
+  doDestroyTask(pTask);
+  destroyAggTestBlocks(pSnapshots);
+  destroyAggTestBlocks(pBlocks);
+}
+
+/*
+ * interval test: input (ts TIMESTAMP, v INT), select _wstart, count(v), sum(v) interval(...) [having count(v) >= ...]
+ * The input read through a table scan of one table is aggregated window after window, the same input read from any
+ * other operator goes through the window hash. Both must give the same rows.
+ */
+typedef std::tuple<int64_t, int64_t, bool, int64_t> SIntervalTestRow;  // _wstart, count(v), sum(v) is null, sum(v)
+
+const int8_t itInputTypes[] = {TSDB_DATA_TYPE_TIMESTAMP, TSDB_DATA_TYPE_INT};
+const int8_t itOutputTypes[] = {TSDB_DATA_TYPE_TIMESTAMP, TSDB_DATA_TYPE_BIGINT, TSDB_DATA_TYPE_BIGINT};
+
+typedef struct {
+  int64_t interval;
+  int64_t sliding;
+  int64_t offset;
+  int8_t  unit;
+  int64_t step;          // between the timestamps of two rows
+  int32_t numOfBlocks;
+  int64_t havingCount;   // having count(v) >= havingCount, 0: no having
+} SIntervalTestCfg;
+
+// a table scan of one table in ascending order, as the interval operator checks it
+typedef struct {
+  STableScanInfo scan;  // must be the first member
+  SAggTestSource src;
+} SIntervalTestScan;
+
+int32_t intervalTestScanNext(SOperatorInfo* pOperator, SSDataBlock** ppRes) {
+  SIntervalTestScan* pScan = (SIntervalTestScan*)pOperator->info;
+  *ppRes = NULL;
+  if (pScan->src.readIdx < taosArrayGetSize(pScan->src.pBlocks)) {
+    *ppRes = (SSDataBlock*)taosArrayGetP(pScan->src.pBlocks, pScan->src.readIdx++);
+  }
+  return TSDB_CODE_SUCCESS;
+}
+
+SArray* createIntervalTestBlocks(const SIntervalTestCfg* pCfg) {
+  SArray* pBlocks = taosArrayInit(pCfg->numOfBlocks, POINTER_BYTES);
+  int64_t t0 = 1704067200000LL;  // 2024-01-01 00:00:00 UTC
+  for (int32_t b = 0; b < pCfg->numOfBlocks; ++b) {
+    SSDataBlock*     pBlock = createAggTestBlock(itInputTypes, 2, AT_BLOCK_ROWS);
+    SColumnInfoData* pTs = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 0);
+    SColumnInfoData* pV = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 1);
+    for (int32_t r = 0; r < AT_BLOCK_ROWS; ++r) {
+      int64_t i = (int64_t)b * AT_BLOCK_ROWS + r;
+      int64_t ts = t0 + i * pCfg->step;
+      int32_t v = (int32_t)(i % 97);
+      AT_CHECK(0 == colDataSetVal(pTs, r, (const char*)&ts, false));
+      AT_CHECK(0 == colDataSetVal(pV, r, (const char*)&v, i % 7 == 0));
+    }
+    pBlock->info.rows = AT_BLOCK_ROWS;
+    pBlock->info.window.skey = *(int64_t*)colDataGetData(pTs, 0);
+    pBlock->info.window.ekey = *(int64_t*)colDataGetData(pTs, AT_BLOCK_ROWS - 1);
+    AT_CHECK(NULL != taosArrayPush(pBlocks, &pBlock));
+  }
+  return pBlocks;
+}
+
+SIntervalPhysiNode* createIntervalTestPhysiNode(const SIntervalTestCfg* pCfg) {
+  SIntervalPhysiNode* pNode = NULL;
+  AT_CHECK(0 == nodesMakeNode(QUERY_NODE_PHYSICAL_PLAN_HASH_INTERVAL, (SNode**)&pNode));
+  pNode->window.node.inputTsOrder = ORDER_ASC;
+  pNode->window.node.outputTsOrder = ORDER_ASC;
+  pNode->window.mergeDataBlock = true;
+  pNode->window.pTspk = (SNode*)createAggTestCol(AT_INPUT_BLK_ID, 0, TSDB_DATA_TYPE_TIMESTAMP);
+  ((SColumnNode*)pNode->window.pTspk)->node.resType.precision = TSDB_TIME_PRECISION_MILLI;
+  pNode->interval = pCfg->interval;
+  pNode->sliding = pCfg->sliding;
+  pNode->offset = pCfg->offset;
+  pNode->intervalUnit = pCfg->unit;
+  pNode->slidingUnit = pCfg->unit;
+
+  appendAggTestTarget(&pNode->window.pFuncs, 0, (SNode*)createAggTestFunc("_wstart", NULL));
+  appendAggTestTarget(&pNode->window.pFuncs, 1,
+                      (SNode*)createAggTestFunc("count", (SNode*)createAggTestCol(AT_INPUT_BLK_ID, 1, TSDB_DATA_TYPE_INT)));
+  appendAggTestTarget(&pNode->window.pFuncs, 2,
+                      (SNode*)createAggTestFunc("sum", (SNode*)createAggTestCol(AT_INPUT_BLK_ID, 1, TSDB_DATA_TYPE_INT)));
+  pNode->window.node.pOutputDataBlockDesc = createAggTestOutputDesc(itOutputTypes, 3);
+
+  if (pCfg->havingCount > 0) {
+    SValueNode* pVal = NULL;
+    AT_CHECK(0 == nodesMakeNode(QUERY_NODE_VALUE, (SNode**)&pVal));
+    pVal->node.resType.type = TSDB_DATA_TYPE_BIGINT;
+    pVal->node.resType.bytes = tDataTypes[TSDB_DATA_TYPE_BIGINT].bytes;
+    int64_t count = pCfg->havingCount;
+    AT_CHECK(0 == nodesSetValueNodeValue(pVal, &count));
+
+    SOperatorNode* pOp = NULL;
+    AT_CHECK(0 == nodesMakeNode(QUERY_NODE_OPERATOR, (SNode**)&pOp));
+    pOp->opType = OP_TYPE_GREATER_EQUAL;
+    pOp->node.resType.type = TSDB_DATA_TYPE_BOOL;
+    pOp->node.resType.bytes = tDataTypes[TSDB_DATA_TYPE_BOOL].bytes;
+    pOp->pLeft = (SNode*)createAggTestCol(AT_OUTPUT_BLK_ID, 1, TSDB_DATA_TYPE_BIGINT);
+    pOp->pRight = (SNode*)pVal;
+    pNode->window.node.pConditions = (SNode*)pOp;
+  }
+  return pNode;
+}
+
+std::vector<SIntervalTestRow> runIntervalTest(const SIntervalTestCfg* pCfg, SArray* pBlocks, bool fromScan,
+                                              bool* pSortedAgg) {
+  SExecTaskInfo*     pTask = createAggTestTask();
+  SIntervalTestScan* pScan = (SIntervalTestScan*)taosMemoryCalloc(1, sizeof(SIntervalTestScan));
+  AT_CHECK(pScan != NULL);
+  pScan->src.pBlocks = pBlocks;
+  SOperatorInfo* pDownstream = createAggTestSource(&pScan->src, pTask);
+  if (fromScan) {
+    pScan->scan.scanInfo.numOfAsc = 1;
+    pScan->scan.base.cond.order = TSDB_ORDER_ASC;
+    pScan->scan.base.pTableListInfo = tableListCreate();
+    AT_CHECK(pScan->scan.base.pTableListInfo != NULL);
+    AT_CHECK(0 == tableListAddTableInfo(pScan->scan.base.pTableListInfo, 1001, 0));
+    pDownstream->info = pScan;
+    pDownstream->operatorType = QUERY_NODE_PHYSICAL_PLAN_TABLE_SCAN;
+    pDownstream->fpSet.getNextFn = intervalTestScanNext;
+  }
+
+  SIntervalPhysiNode* pNode = createIntervalTestPhysiNode(pCfg);
+  SOperatorInfo*      pOp = NULL;
+  AT_CHECK(0 == createIntervalOperatorInfo(pDownstream, pNode, pTask, &pOp));
+  *pSortedAgg = ((SIntervalAggOperatorInfo*)pOp->info)->sortedAgg;
+
+  std::vector<SIntervalTestRow> rows;
+  while (true) {
+    SSDataBlock* pRes = NULL;
+    AT_CHECK(0 == pOp->fpSet.getNextFn(pOp, &pRes));
+    if (pRes == NULL) {
+      break;
+    }
+
+    SColumnInfoData* pWstart = (SColumnInfoData*)taosArrayGet(pRes->pDataBlock, 0);
+    SColumnInfoData* pCnt = (SColumnInfoData*)taosArrayGet(pRes->pDataBlock, 1);
+    SColumnInfoData* pSum = (SColumnInfoData*)taosArrayGet(pRes->pDataBlock, 2);
+    for (int32_t r = 0; r < pRes->info.rows; ++r) {
+      bool sumNull = colDataIsNull_s(pSum, r);
+      rows.push_back(SIntervalTestRow(*(int64_t*)colDataGetData(pWstart, r), *(int64_t*)colDataGetData(pCnt, r),
+                                      sumNull, sumNull ? 0 : *(int64_t*)colDataGetData(pSum, r)));
+    }
+  }
+
+  destroyOperator(pOp);
+  nodesDestroyNode((SNode*)pNode);
+  doDestroyTask(pTask);
+  tableListDestroy(pScan->scan.base.pTableListInfo);
+  taosMemoryFree(pScan);
+  return rows;
+}
+
+// the rows of the sorted aggregation equal those of the window hash, row for row
+void checkSortedInterval(const SIntervalTestCfg* pCfg, bool expectSorted) {
+  SArray* pBlocks = createIntervalTestBlocks(pCfg);
+  bool    sorted = false;
+  bool    hashSorted = true;
+
+  std::vector<SIntervalTestRow> actual = runIntervalTest(pCfg, pBlocks, true, &sorted);
+  std::vector<SIntervalTestRow> expect = runIntervalTest(pCfg, pBlocks, false, &hashSorted);
+  ASSERT_EQ(sorted, expectSorted);
+  ASSERT_FALSE(hashSorted);
+
+  ASSERT_GT(expect.size(), 1);
+  ASSERT_EQ(expect.size(), actual.size());
+  for (size_t i = 0; i < expect.size(); ++i) {
+    ASSERT_TRUE(expect[i] == actual[i]) << "row " << i << ", _wstart " << std::get<0>(expect[i]) << " vs "
+                                        << std::get<0>(actual[i]);
+  }
+
+  // every row with a value is counted once unless windows overlap or having drops some
+  if (pCfg->havingCount == 0 && pCfg->interval == pCfg->sliding) {
+    int64_t total = 0;
+    for (auto& row : actual) {
+      total += std::get<1>(row);
+    }
+    int64_t rows = (int64_t)pCfg->numOfBlocks * AT_BLOCK_ROWS;
+    ASSERT_EQ(total, rows - (rows + 6) / 7);
+  }
+
+  destroyAggTestBlocks(pBlocks);
+}
+
+bool allScattered(int32_t blk) { return false; }
+bool someSorted(int32_t blk) { return blk % 3 == 1; }
+
+}  // namespace
+
+TEST(groupbyTest, scatteredKeysAcrossBlocks) { runGroupTest(6, allScattered); }
+
+TEST(groupbyTest, mixedScatteredAndSortedBlocks) { runGroupTest(7, someSorted); }
+
+// 6000 rows per window, a window goes over 6 blocks
+TEST(intervalTest, sortedWindowsSpanBlocks) {
+  SIntervalTestCfg cfg = {.interval = 60000, .sliding = 60000, .unit = 's', .step = 10, .numOfBlocks = 20};
+  checkSortedInterval(&cfg, true);
+}
+
+// 10 rows per window, 100 windows in a block
+TEST(intervalTest, sortedManyWindowsInBlock) {
+  SIntervalTestCfg cfg = {.interval = 10000, .sliding = 10000, .unit = 's', .step = 1000, .numOfBlocks = 5};
+  checkSortedInterval(&cfg, true);
+}
+
+// months of different lengths, a row per hour
+TEST(intervalTest, sortedNaturalUnit) {
+  SIntervalTestCfg cfg = {.interval = 1, .sliding = 1, .unit = 'n', .step = 3600000, .numOfBlocks = 9};
+  checkSortedInterval(&cfg, true);
+}
+
+TEST(intervalTest, sortedWithOffset) {
+  SIntervalTestCfg cfg = {
+      .interval = 10000, .sliding = 10000, .offset = 3000, .unit = 's', .step = 700, .numOfBlocks = 4};
+  checkSortedInterval(&cfg, true);
+}
+
+// overlapping windows are not closed one after another, they stay on the window hash
+TEST(intervalTest, slidingUsesHash) {
+  SIntervalTestCfg cfg = {.interval = 10000, .sliding = 5000, .unit = 's', .step = 700, .numOfBlocks = 4};
+  checkSortedInterval(&cfg, false);
+}
+
+// some windows have fewer values as every 7th value is null
+TEST(intervalTest, sortedWithHaving) {
+  SIntervalTestCfg cfg = {
+      .interval = 10000, .sliding = 10000, .unit = 's', .step = 1000, .numOfBlocks = 5, .havingCount = 9};
+  checkSortedInterval(&cfg, true);
+}
+
+int main(int argc, char** argv) {
+  tstrncpy(tsTempDir, TD_TMP_DIR_PATH, PATH_MAX);
+  AT_CHECK(0 == fmFuncMgtInit());
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <numeric>
+#include <vector>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+#include "os.h"
+
+#include "executor.h"
+#include "executorInt.h"
+#include "operator.h"
+#include "querytask.h"
+#include "tdatablock.h"
+
+namespace {
+
+#define ET_BATCH_ROWS 4096  // the rows an execution of a task returns at most
+
+// unlike assert, the expression is evaluated in release builds too
+#define ET_CHECK(_expr)                                                     \
+  do {                                                                      \
+    if (!(_expr)) {                                                         \
+      (void)printf("%s:%d check failed: %s\n", __FILE__, __LINE__, #_expr); \
+      abort();                                                              \
+    }                                                                       \
+  } while (0)
+
+// the root of the task, which returns blocks of one row without end
+typedef struct {
+  SSDataBlock* pBlock;
+  int64_t      rows;
+} SExecTestRoot;
+
+int32_t execTestRootNext(SOperatorInfo* pOperator, SSDataBlock** ppRes) {
+  SExecTestRoot* pRoot = (SExecTestRoot*)pOperator->info;
+  pRoot->rows += pRoot->pBlock->info.rows;
+  *ppRes = pRoot->pBlock;
+  return TSDB_CODE_SUCCESS;
+}
+
+class ExecTaskTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ET_CHECK(0 == createDataBlock(&root.pBlock));
+    SColumnInfoData col = createColumnInfoData(TSDB_DATA_TYPE_BIGINT, sizeof(int64_t), 1);
+    ET_CHECK(0 == blockDataAppendColInfo(root.pBlock, &col));
+    ET_CHECK(0 == blockDataEnsureCapacity(root.pBlock, 1));
+    int64_t v = 1;
+    ET_CHECK(0 == colDataSetVal((SColumnInfoData*)taosArrayGet(root.pBlock->pDataBlock, 0), 0, (const char*)&v, false));
+    root.pBlock->info.rows = 1;
+    pResList = taosArrayInit(4, POINTER_BYTES);
+    ET_CHECK(pResList != NULL);
+  }
+
+  void TearDown() override {
+    if (pTask != NULL) {
+      doDestroyTask(pTask);
+    }
+    taosArrayDestroy(pResList);
+    blockDataDestroy(root.pBlock);
+  }
+
+  void createTask(int32_t rootType, int32_t rootThreshold, bool dynamicRowThreshold = false) {
+    SStorageAPI api = {0};
+    ET_CHECK(0 == doCreateTask(1, 1, 1, OPTR_EXEC_MODEL_BATCH, &api, &pTask));
+    ET_CHECK(0 == nodesMakeNode(QUERY_NODE_PHYSICAL_SUBPLAN, (SNode**)&pTask->pSubplan));
+    pTask->pSubplan->dynamicRowThreshold = dynamicRowThreshold;
+    pTask->pSubplan->rowsThreshold = ET_BATCH_ROWS;
+
+    SOperatorInfo* p = (SOperatorInfo*)taosMemoryCalloc(1, sizeof(SOperatorInfo));
+    ET_CHECK(p != NULL);
+    p->name = "ExecTestRoot";
+    p->operatorType = rootType;
+    p->info = &root;
+    p->pTaskInfo = pTask;
+    p->resultInfo.threshold = rootThreshold;
+    p->fpSet.getNextFn = execTestRootNext;
+    pTask->pRoot = p;
+  }
+
+  // the rows returned by one execution of the task
+  int64_t exec() {
+    uint64_t useconds = 0;
+    bool     hasMore = false;
+    EXPECT_EQ(qExecTaskOpt(pTask, pResList, &useconds, &hasMore, NULL), 0);
+    EXPECT_TRUE(hasMore);
+
+    int64_t rows = 0;
+    for (int32_t i = 0; i < taosArrayGetSize(pResList); ++i) {
+      rows += ((SSDataBlock*)taosArrayGetP(pResList, i))->info.rows;
+    }
+    return rows;
+  }
+
+  SExecTestRoot  root = {0};
+  SExecTaskInfo* pTask = NULL;
+  SArray*        pResList = NULL;
+};
+
+}  // namespace
+
+// the first execution returns one row, each next one twice as many, until the usual batch is reached
+TEST_F(ExecTaskTest, lowLatencyDoubles) {
+  createTask(QUERY_NODE_PHYSICAL_PLAN_PROJECT, ET_BATCH_ROWS);
+  qSetTaskLowLatency(pTask);
+
+  std::vector<int32_t> thresholds;
+  std::vector<int64_t> rows;
+  for (int32_t i = 0; i < 15; ++i) {
+    thresholds.push_back(pTask->pRoot->resultInfo.threshold);
+    rows.push_back(exec());
+  }
+
+  std::vector<int32_t> expectThresholds;
+  std::vector<int64_t> expectRows;
+  for (int32_t n = 1; n < ET_BATCH_ROWS; n *= 2) {
+    expectThresholds.push_back(n);
+    expectRows.push_back(n);
+  }
+  while (expectRows.size() < rows.size()) {
+    expectThresholds.push_back(ET_BATCH_ROWS);
+    expectRows.push_back(ET_BATCH_ROWS);
+  }
+  ASSERT_EQ(rows, expectRows);
+  ASSERT_EQ(thresholds, expectThresholds);
+  ASSERT_EQ(pTask->flushRows, 0);
+  ASSERT_EQ(root.rows, std::accumulate(rows.begin(), rows.end(), (int64_t)0));
+}
+
+TEST_F(ExecTaskTest, normalBatches) {
+  createTask(QUERY_NODE_PHYSICAL_PLAN_PROJECT, ET_BATCH_ROWS);
+  for (int32_t i = 0; i < 3; ++i) {
+    ASSERT_EQ(pTask->pRoot->resultInfo.threshold, ET_BATCH_ROWS);
+    ASSERT_EQ(exec(), ET_BATCH_ROWS);
+  }
+}
+
+// a smaller threshold of the root projection caps the doubling and is restored when the mode ends
+TEST_F(ExecTaskTest, lowLatencyKeepsRootThreshold) {
+  const int32_t rootThreshold = 100;
+  createTask(QUERY_NODE_PHYSICAL_PLAN_PROJECT, rootThreshold);
+  qSetTaskLowLatency(pTask);
+  ASSERT_EQ(pTask->pRoot->resultInfo.threshold, 1);
+
+  int32_t n = 1;
+  while (pTask->flushRows > 0) {
+    ASSERT_EQ(pTask->pRoot->resultInfo.threshold, TMIN(n, rootThreshold));
+    ASSERT_EQ(exec(), n);
+    n *= 2;
+  }
+  ASSERT_EQ(n, ET_BATCH_ROWS);
+  ASSERT_EQ(pTask->pRoot->resultInfo.threshold, rootThreshold);
+  ASSERT_EQ(exec(), ET_BATCH_ROWS);
+}
+
+// only the root projection has its threshold lowered, any other root keeps it
+TEST_F(ExecTaskTest, lowLatencyOtherRoot) {
+  createTask(QUERY_NODE_PHYSICAL_PLAN_HASH_AGG, ET_BATCH_ROWS);
+  qSetTaskLowLatency(pTask);
+  ASSERT_EQ(pTask->pRoot->resultInfo.threshold, ET_BATCH_ROWS);
+  ASSERT_EQ(exec(), 1);
+  ASSERT_EQ(exec(), 2);
+  ASSERT_EQ(pTask->pRoot->resultInfo.threshold, ET_BATCH_ROWS);
+}
+
+// the rows of a task with a dynamic row threshold are set by its consumer
+TEST_F(ExecTaskTest, lowLatencyIgnoredByDynamicTask) {
+  createTask(QUERY_NODE_PHYSICAL_PLAN_PROJECT, ET_BATCH_ROWS, true);
+  qSetTaskLowLatency(pTask);
+  ASSERT_EQ(pTask->flushRows, 0);
+  ASSERT_EQ(pTask->pRoot->resultInfo.threshold, ET_BATCH_ROWS);
+  ASSERT_EQ(exec(), ET_BATCH_ROWS);
+}
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,573 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+#include "os.h"
+
+#include "executor.h"
+#include "executorInt.h"
+#include "hashjoin.h"
+#include "operator.h"
+#include "querytask.h"
+#include "tdatablock.h"
+
+namespace {
+
+#define HT_LEFT_BLK_ID   1
+#define HT_RIGHT_BLK_ID  2
+#define HT_OUTPUT_BLK_ID 3
+#define HT_BLOCK_ROWS    4096
+#define HT_MAX_VAL_LEN   1000
+
+// unlike assert, the expression is evaluated in release builds too
+#define HT_CHECK(_expr)                                                     \
+  do {                                                                      \
+    if (!(_expr)) {                                                         \
+      (void)printf("%s:%d check failed: %s\n", __FILE__, __LINE__, #_expr); \
+      abort();                                                              \
+    }                                                                       \
+  } while (0)
+
+/*
+ * left (build) table: (ts TIMESTAMP, k INT, v VARCHAR(1000)), right (probe) table: (ts TIMESTAMP, k INT)
+ * select l.ts, l.v, r.ts, r.k from l, r where l.k = r.k
+ */
+typedef struct {
+  SArray* pBlocks;  // SArray<SSDataBlock*>, owned by the test
+  int32_t readIdx;
+} SHJoinTestSource;
+
+typedef struct {
+  int32_t buildRows;
+  int32_t buildKeyNum;  // build keys are row % buildKeyNum
+  int32_t probeRows;
+  int32_t probeKeyStep;  // probe keys are row * probeKeyStep
+  int64_t buildTs;       // build timestamps are buildTs + row
+  int64_t probeTs;       // probe timestamps are probeTs + row
+  bool    joinOnTs;      // l.ts = r.ts instead of l.k = r.k
+} SHJoinTestData;
+
+typedef enum {
+  HT_PROBE_SOURCE = 0,
+  HT_PROBE_SCAN,
+  HT_PROBE_SCAN_WITH_LIMIT,
+  HT_PROBE_SCAN_COUNT_EMPTY,
+} EHJoinTestProbe;
+
+typedef struct {
+  int32_t         memBudgetMB;     // tsQueryTaskMemBudget of the task, 0: unlimited
+  int32_t         bloomMinKeyNum;  // INT32_MAX: no bloom filter
+  EHJoinTestProbe probe;
+} SHJoinTestCfg;
+
+typedef struct {
+  std::vector<std::string> rows;
+  int64_t                  spillPageNum;
+  int64_t                  bloomFilterRows;
+  bool                     rangePushed;
+  int64_t                  skippedProbeBlocks;
+} SHJoinTestRes;
+
+int32_t hJoinTestSourceNext(SOperatorInfo* pOperator, SSDataBlock** ppRes) {
+  SHJoinTestSource* pSource = (SHJoinTestSource*)pOperator->info;
+  *ppRes = NULL;
+  if (pSource->readIdx < taosArrayGetSize(pSource->pBlocks)) {
+    *ppRes = (SSDataBlock*)taosArrayGetP(pSource->pBlocks, pSource->readIdx++);
+  }
+  return TSDB_CODE_SUCCESS;
+}
+
+/*
+ * A table scan as setOperatorRuntimeRange sees it. Like the real scan, it skips the blocks out of the runtime range
+ * pushed down to it.
+ */
+typedef struct {
+  STableScanInfo   scan;  // must be the first member
+  SHJoinTestSource src;
+  int64_t          skippedBlocks;
+} SHJoinTestScan;
+
+int32_t hJoinTestScanNext(SOperatorInfo* pOperator, SSDataBlock** ppRes) {
+  SHJoinTestScan* pScan = (SHJoinTestScan*)pOperator->info;
+  while (true) {
+    *ppRes = NULL;
+    if (pScan->src.readIdx >= taosArrayGetSize(pScan->src.pBlocks)) {
+      return TSDB_CODE_SUCCESS;
+    }
+
+    SSDataBlock*     pBlock = (SSDataBlock*)taosArrayGetP(pScan->src.pBlocks, pScan->src.readIdx++);
+    SColumnInfoData* pTs = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 0);
+    int64_t          skey = *(int64_t*)colDataGetData(pTs, 0);
+    int64_t          ekey = *(int64_t*)colDataGetData(pTs, pBlock->info.rows - 1);
+    STimeWindow*     pRange = &pScan->scan.base.rtRange;
+    if (skey > atomic_load_64(&pRange->ekey) || ekey < atomic_load_64(&pRange->skey)) {
+      pScan->skippedBlocks++;
+      continue;
+    }
+
+    *ppRes = pBlock;
+    return TSDB_CODE_SUCCESS;
+  }
+}
+
+SOperatorInfo* createHJoinTestSource(SHJoinTestSource* pSource, int32_t blkId, SExecTaskInfo* pTask) {
+  SOperatorInfo* p = (SOperatorInfo*)taosMemoryCalloc(1, sizeof(SOperatorInfo));
+  HT_CHECK(p != NULL);
+  p->name = "HJoinTestSource";
+  p->info = pSource;
+  p->pTaskInfo = pTask;
+  p->resultDataBlockId = blkId;
+  p->fpSet.getNextFn = hJoinTestSourceNext;
+  return p;
+}
+
+int32_t hJoinTestTypeBytes(int8_t type) {
+  return IS_VAR_DATA_TYPE(type) ? HT_MAX_VAL_LEN + VARSTR_HEADER_SIZE : tDataTypes[type].bytes;
+}
+
+SSDataBlock* createHJoinTestBlock(int16_t blkId, const int8_t* types, int32_t numOfCols) {
+  SSDataBlock* p = NULL;
+  HT_CHECK(0 == createDataBlock(&p));
+  p->info.id.blockId = blkId;
+  for (int32_t i = 0; i < numOfCols; ++i) {
+    SColumnInfoData col = createColumnInfoData(types[i], hJoinTestTypeBytes(types[i]), i);
+    HT_CHECK(0 == blockDataAppendColInfo(p, &col));
+  }
+  HT_CHECK(0 == blockDataEnsureCapacity(p, HT_BLOCK_ROWS));
+  return p;
+}
+
+void destroyHJoinTestBlocks(SArray* pBlocks) {
+  for (int32_t i = 0; i < taosArrayGetSize(pBlocks); ++i) {
+    blockDataDestroy((SSDataBlock*)taosArrayGetP(pBlocks, i));
+  }
+  taosArrayDestroy(pBlocks);
+}
+
+std::string hJoinTestVal(int32_t row) {
+  return std::to_string(row) + std::string(HT_MAX_VAL_LEN - 100 + row % 100, (char)('a' + row % 26));
+}
+
+std::string hJoinTestResRow(int64_t buildTs, const std::string& v, int64_t probeTs, int32_t probeKey) {
+  return std::to_string(buildTs) + "|" + v + "|" + std::to_string(probeTs) + "|" + std::to_string(probeKey);
+}
+
+const int8_t htLeftTypes[] = {TSDB_DATA_TYPE_TIMESTAMP, TSDB_DATA_TYPE_INT, TSDB_DATA_TYPE_VARCHAR};
+const int8_t htRightTypes[] = {TSDB_DATA_TYPE_TIMESTAMP, TSDB_DATA_TYPE_INT};
+const int8_t htOutputTypes[] = {TSDB_DATA_TYPE_TIMESTAMP, TSDB_DATA_TYPE_VARCHAR, TSDB_DATA_TYPE_TIMESTAMP,
+                                TSDB_DATA_TYPE_INT};
+
+SArray* createHJoinTestBuildBlocks(const SHJoinTestData* pData) {
+  SArray* pBlocks = taosArrayInit(4, POINTER_BYTES);
+  char    buf[HT_MAX_VAL_LEN + VARSTR_HEADER_SIZE];
+  for (int32_t r = 0; r < pData->buildRows;) {
+    SSDataBlock*     pBlock = createHJoinTestBlock(HT_LEFT_BLK_ID, htLeftTypes, 3);
+    SColumnInfoData* pTs = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 0);
+    SColumnInfoData* pK = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 1);
+    SColumnInfoData* pV = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 2);
+    int32_t          i = 0;
+    for (; i < HT_BLOCK_ROWS && r < pData->buildRows; ++i, ++r) {
+      int64_t     ts = pData->buildTs + r;
+      int32_t     k = r % pData->buildKeyNum;
+      std::string v = hJoinTestVal(r);
+      STR_WITH_SIZE_TO_VARSTR(buf, v.c_str(), v.size());
+      HT_CHECK(0 == colDataSetVal(pTs, i, (const char*)&ts, false));
+      HT_CHECK(0 == colDataSetVal(pK, i, (const char*)&k, false));
+      HT_CHECK(0 == colDataSetVal(pV, i, buf, false));
+    }
+    pBlock->info.rows = i;
+    HT_CHECK(NULL != taosArrayPush(pBlocks, &pBlock));
+  }
+  return pBlocks;
+}
+
+SArray* createHJoinTestProbeBlocks(const SHJoinTestData* pData) {
+  SArray* pBlocks = taosArrayInit(4, POINTER_BYTES);
+  for (int32_t r = 0; r < pData->probeRows;) {
+    SSDataBlock*     pBlock = createHJoinTestBlock(HT_RIGHT_BLK_ID, htRightTypes, 2);
+    SColumnInfoData* pTs = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 0);
+    SColumnInfoData* pK = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 1);
+    int32_t          i = 0;
+    for (; i < HT_BLOCK_ROWS && r < pData->probeRows; ++i, ++r) {
+      int64_t ts = pData->probeTs + r;
+      int32_t k = r * pData->probeKeyStep;
+      HT_CHECK(0 == colDataSetVal(pTs, i, (const char*)&ts, false));
+      HT_CHECK(0 == colDataSetVal(pK, i, (const char*)&k, false));
+    }
+    pBlock->info.rows = i;
+    HT_CHECK(NULL != taosArrayPush(pBlocks, &pBlock));
+  }
+  return pBlocks;
+}
+
+// the join result computed without the operator
+std::vector<std::string> hJoinTestExpectedRows(const SHJoinTestData* pData) {
+  std::multimap<int64_t, int32_t> buildRows;
+  for (int32_t r = 0; r < pData->buildRows; ++r) {
+    buildRows.insert(std::make_pair(pData->joinOnTs ? pData->buildTs + r : r % pData->buildKeyNum, r));
+  }
+
+  std::vector<std::string> rows;
+  for (int32_t r = 0; r < pData->probeRows; ++r) {
+    int32_t k = r * pData->probeKeyStep;
+    auto    range = buildRows.equal_range(pData->joinOnTs ? pData->probeTs + r : k);
+    for (auto it = range.first; it != range.second; ++it) {
+      rows.push_back(hJoinTestResRow(pData->buildTs + it->second, hJoinTestVal(it->second), pData->probeTs + r, k));
+    }
+  }
+  std::sort(rows.begin(), rows.end());
+  return rows;
+}
+
+SColumnNode* createHJoinTestCol(int16_t blkId, int16_t slotId, int8_t type) {
+  SColumnNode* pCol = NULL;
+  HT_CHECK(0 == nodesMakeNode(QUERY_NODE_COLUMN, (SNode**)&pCol));
+  pCol->dataBlockId = blkId;
+  pCol->slotId = slotId;
+  pCol->colId = slotId + 1;
+  pCol->colType = COLUMN_TYPE_COLUMN;
+  pCol->node.resType.type = type;
+  pCol->node.resType.bytes = hJoinTestTypeBytes(type);
+  (void)snprintf(pCol->colName, sizeof(pCol->colName), "c%d", slotId);
+  return pCol;
+}
+
+void appendHJoinTestTarget(SNodeList** ppList, int16_t slotId, SNode* pExpr) {
+  STargetNode* pTarget = NULL;
+  HT_CHECK(0 == nodesMakeNode(QUERY_NODE_TARGET, (SNode**)&pTarget));
+  pTarget->dataBlockId = HT_OUTPUT_BLK_ID;
+  pTarget->slotId = slotId;
+  pTarget->pExpr = pExpr;
+  HT_CHECK(0 == nodesListMakeStrictAppend(ppList, (SNode*)pTarget));
+}
+
+SDataBlockDescNode* createHJoinTestOutputDesc() {
+  SDataBlockDescNode* pDesc = NULL;
+  HT_CHECK(0 == nodesMakeNode(QUERY_NODE_DATABLOCK_DESC, (SNode**)&pDesc));
+  pDesc->dataBlockId = HT_OUTPUT_BLK_ID;
+  for (int32_t i = 0; i < sizeof(htOutputTypes) / sizeof(htOutputTypes[0]); ++i) {
+    SSlotDescNode* pSlot = NULL;
+    HT_CHECK(0 == nodesMakeNode(QUERY_NODE_SLOT_DESC, (SNode**)&pSlot));
+    pSlot->slotId = i;
+    pSlot->dataType.type = htOutputTypes[i];
+    pSlot->dataType.bytes = hJoinTestTypeBytes(htOutputTypes[i]);
+    pSlot->output = true;
+    pDesc->totalRowSize += pSlot->dataType.bytes;
+    HT_CHECK(0 == nodesListMakeStrictAppend(&pDesc->pSlots, (SNode*)pSlot));
+  }
+  pDesc->outputRowSize = pDesc->totalRowSize;
+  return pDesc;
+}
+
+SHashJoinPhysiNode* createHJoinTestPhysiNode(const SHJoinTestData* pData) {
+  SHashJoinPhysiNode* pNode = NULL;
+  HT_CHECK(0 == nodesMakeNode(QUERY_NODE_PHYSICAL_PLAN_HASH_JOIN, (SNode**)&pNode));
+  pNode->joinType = JOIN_TYPE_INNER;
+  pNode->subType = JOIN_STYPE_NONE;
+  pNode->leftPrimSlotId = 0;
+  pNode->rightPrimSlotId = 0;
+  pNode->timeRange = TSWINDOW_INITIALIZER;
+  int16_t keySlot = pData->joinOnTs ? 0 : 1;
+  int8_t  keyType = pData->joinOnTs ? TSDB_DATA_TYPE_TIMESTAMP : TSDB_DATA_TYPE_INT;
+  HT_CHECK(0 == nodesListMakeStrictAppend(&pNode->pOnLeft,
+                                          (SNode*)createHJoinTestCol(HT_LEFT_BLK_ID, keySlot, keyType)));
+  HT_CHECK(0 == nodesListMakeStrictAppend(&pNode->pOnRight,
+                                          (SNode*)createHJoinTestCol(HT_RIGHT_BLK_ID, keySlot, keyType)));
+  appendHJoinTestTarget(&pNode->pTargets, 0, (SNode*)createHJoinTestCol(HT_LEFT_BLK_ID, 0, TSDB_DATA_TYPE_TIMESTAMP));
+  appendHJoinTestTarget(&pNode->pTargets, 1, (SNode*)createHJoinTestCol(HT_LEFT_BLK_ID, 2, TSDB_DATA_TYPE_VARCHAR));
+  appendHJoinTestTarget(&pNode->pTargets, 2, (SNode*)createHJoinTestCol(HT_RIGHT_BLK_ID, 0, TSDB_DATA_TYPE_TIMESTAMP));
+  appendHJoinTestTarget(&pNode->pTargets, 3, (SNode*)createHJoinTestCol(HT_RIGHT_BLK_ID, 1, TSDB_DATA_TYPE_INT));
+  // the left table is estimated as the smaller one, so it is the build side
+  pNode->inputStat[0].inputRowNum = pData->buildRows;
+  pNode->inputStat[0].inputRowSize = 1;
+  pNode->inputStat[1].inputRowNum = (int64_t)pData->buildRows * HT_MAX_VAL_LEN;
+  pNode->inputStat[1].inputRowSize = 1;
+  pNode->node.pOutputDataBlockDesc = createHJoinTestOutputDesc();
+  return pNode;
+}
+
+void runHJoinTest(const SHJoinTestData* pData, SArray* pBuildBlocks, SArray* pProbeBlocks, const SHJoinTestCfg* pCfg,
+                  SHJoinTestRes* pRes) {
+  int32_t budget = tsQueryTaskMemBudget;
+  tsQueryTaskMemBudget = pCfg->memBudgetMB;
+
+  SStorageAPI    api = {0};
+  SExecTaskInfo* pTask = NULL;
+  HT_CHECK(0 == doCreateTask(1, 1, 1, OPTR_EXEC_MODEL_BATCH, &api, &pTask));
+  tsQueryTaskMemBudget = budget;
+
+  SHJoinTestSource    build = {.pBlocks = pBuildBlocks, .readIdx = 0};
+  SHJoinTestSource    probe = {.pBlocks = pProbeBlocks, .readIdx = 0};
+  SOperatorInfo*      pDownstream[2] = {createHJoinTestSource(&build, HT_LEFT_BLK_ID, pTask),
+                                        createHJoinTestSource(&probe, HT_RIGHT_BLK_ID, pTask)};
+  SHJoinTestScan*     pScan = (SHJoinTestScan*)taosMemoryCalloc(1, sizeof(SHJoinTestScan));
+  HT_CHECK(pScan != NULL);
+  if (pCfg->probe != HT_PROBE_SOURCE) {
+    pScan->src = probe;
+    pScan->scan.base.rtRange = TSWINDOW_INITIALIZER;
+    pScan->scan.base.limitInfo.limit.limit = (pCfg->probe == HT_PROBE_SCAN_WITH_LIMIT) ? 100 : -1;
+    pScan->scan.base.limitInfo.slimit.limit = -1;
+    pScan->scan.needCountEmptyTable = (pCfg->probe == HT_PROBE_SCAN_COUNT_EMPTY);
+    pDownstream[1]->info = pScan;
+    pDownstream[1]->operatorType = QUERY_NODE_PHYSICAL_PLAN_TABLE_SCAN;
+    pDownstream[1]->fpSet.getNextFn = hJoinTestScanNext;
+  }
+  SHashJoinPhysiNode* pNode = createHJoinTestPhysiNode(pData);
+  SOperatorInfo*      pOp = NULL;
+  HT_CHECK(0 == createHashJoinOperatorInfo(pDownstream, 2, pNode, pTask, &pOp));
+
+  SHJoinOperatorInfo* pJoin = (SHJoinOperatorInfo*)pOp->info;
+  HT_CHECK(pJoin->pBuild == &pJoin->tbs[0]);
+  pJoin->bloomMinKeyNum = pCfg->bloomMinKeyNum;
+
+  pRes->rows.clear();
+  while (true) {
+    SSDataBlock* pBlock = NULL;
+    HT_CHECK(0 == pOp->fpSet.getNextFn(pOp, &pBlock));
+    if (pBlock == NULL) {
+      break;
+    }
+
+    SColumnInfoData* pBuildTs = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 0);
+    SColumnInfoData* pV = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 1);
+    SColumnInfoData* pProbeTs = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 2);
+    SColumnInfoData* pProbeK = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 3);
+    for (int32_t r = 0; r < pBlock->info.rows; ++r) {
+      char* v = colDataGetData(pV, r);
+      pRes->rows.push_back(hJoinTestResRow(*(int64_t*)colDataGetData(pBuildTs, r), std::string(varDataVal(v), varDataLen(v)),
+                                           *(int64_t*)colDataGetData(pProbeTs, r),
+                                           *(int32_t*)colDataGetData(pProbeK, r)));
+    }
+  }
+  std::sort(pRes->rows.begin(), pRes->rows.end());
+  pRes->spillPageNum = pJoin->execInfo.spillPageNum;
+  pRes->bloomFilterRows = pJoin->execInfo.bloomFilterRows;
+  pRes->rangePushed = pJoin->execInfo.rangePushed;
+  pRes->skippedProbeBlocks = pScan->skippedBlocks;
+  taosMemoryFree(pScan);
+
+  destroyOperator(pOp);
+  nodesDestroyNode((SNode*)pNode);
+  doDestroyTask(pTask);
+}
+
+// more than one HASH_JOIN_DEFAULT_PAGE_SIZE of build rows, most of the probe rows have no match
+const SHJoinTestData htData = {.buildRows = 14000,
+                               .buildKeyNum = 4000,
+                               .probeRows = 20000,
+                               .probeKeyStep = 3,
+                               .buildTs = 1700000000000LL,
+                               .probeTs = 1800000000000LL,
+                               .joinOnTs = false};
+
+// on the primary timestamps, the build rows only cover a small part of the probe time range
+const SHJoinTestData htTsData = {.buildRows = 4000,
+                                 .buildKeyNum = 4000,
+                                 .probeRows = 20 * HT_BLOCK_ROWS,
+                                 .probeKeyStep = 1,
+                                 .buildTs = 1700000000000LL + 9 * HT_BLOCK_ROWS + 100,
+                                 .probeTs = 1700000000000LL,
+                                 .joinOnTs = true};
+
+class HashJoinTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    pBuildBlocks = createHJoinTestBuildBlocks(&htData);
+    pProbeBlocks = createHJoinTestProbeBlocks(&htData);
+    expected = hJoinTestExpectedRows(&htData);
+    ASSERT_GT(expected.size(), 0);
+  }
+
+  void TearDown() override {
+    destroyHJoinTestBlocks(pBuildBlocks);
+    destroyHJoinTestBlocks(pProbeBlocks);
+  }
+
+  void run(int32_t memBudgetMB, int32_t bloomMinKeyNum, SHJoinTestRes* pRes, EHJoinTestProbe probe = HT_PROBE_SOURCE) {
+    SHJoinTestCfg cfg = {.memBudgetMB = memBudgetMB, .bloomMinKeyNum = bloomMinKeyNum, .probe = probe};
+    runHJoinTest(pData, pBuildBlocks, pProbeBlocks, &cfg, pRes);
+  }
+
+  const SHJoinTestData*    pData = &htData;
+  SArray*                  pBuildBlocks = NULL;
+  SArray*                  pProbeBlocks = NULL;
+  std::vector<std::string> expected;
+};
+
+class HashJoinRangeTest : public HashJoinTest {
+ protected:
+  void SetUp() override {
+    pData = &htTsData;
+    pBuildBlocks = createHJoinTestBuildBlocks(pData);
+    pProbeBlocks = createHJoinTestProbeBlocks(pData);
+    expected = hJoinTestExpectedRows(pData);
+    ASSERT_EQ(expected.size(), pData->buildRows);
+  }
+};
+
+}  // namespace
+
+TEST_F(HashJoinTest, inMemory) {
+  SHJoinTestRes res;
+  run(0, INT32_MAX, &res);
+  ASSERT_EQ(res.spillPageNum, 0);
+  ASSERT_EQ(res.bloomFilterRows, 0);
+  ASSERT_TRUE(res.rows == expected);
+}
+
+// the budget is used up by the first row page, the rest of the build rows go to the spill buffer
+TEST_F(HashJoinTest, spillBuildRows) {
+  SHJoinTestRes res;
+  run(1, INT32_MAX, &res);
+  ASSERT_GT(res.spillPageNum, 0);
+  ASSERT_EQ(res.bloomFilterRows, 0);
+  ASSERT_TRUE(res.rows == expected);
+}
+
+TEST_F(HashJoinTest, bloomFilterProbeRows) {
+  SHJoinTestRes res;
+  run(0, 1, &res);
+  ASSERT_EQ(res.spillPageNum, 0);
+  ASSERT_GT(res.bloomFilterRows, 0);
+  ASSERT_TRUE(res.rows == expected);
+}
+
+TEST_F(HashJoinTest, spillAndBloomFilter) {
+  SHJoinTestRes res;
+  run(1, 1, &res);
+  ASSERT_GT(res.spillPageNum, 0);
+  ASSERT_GT(res.bloomFilterRows, 0);
+  ASSERT_TRUE(res.rows == expected);
+}
+
+// all of the sample rows but the last one match, the filter is dropped though that last row is filtered
+TEST(HashJoinBloomTest, dropFilterOnFilteredSampleRow) {
+  const SHJoinTestData data = {.buildRows = HJOIN_BLOOM_SAMPLE_ROWS - 1,
+                               .buildKeyNum = HJOIN_BLOOM_SAMPLE_ROWS - 1,
+                               .probeRows = 3 * HT_BLOCK_ROWS,
+                               .probeKeyStep = 1};
+  SArray*       pBuildBlocks = createHJoinTestBuildBlocks(&data);
+  SArray*       pProbeBlocks = createHJoinTestProbeBlocks(&data);
+  SHJoinTestCfg cfg = {.memBudgetMB = 0, .bloomMinKeyNum = 1};
+  SHJoinTestRes res;
+  runHJoinTest(&data, pBuildBlocks, pProbeBlocks, &cfg, &res);
+  destroyHJoinTestBlocks(pBuildBlocks);
+  destroyHJoinTestBlocks(pProbeBlocks);
+
+  ASSERT_LE(res.bloomFilterRows, 1);
+  ASSERT_TRUE(res.rows == hJoinTestExpectedRows(&data));
+}
+
+// the keys are not the primary timestamps, there is no range to push down
+TEST_F(HashJoinTest, noRangeOnOtherKeys) {
+  SHJoinTestRes res;
+  run(0, INT32_MAX, &res, HT_PROBE_SCAN);
+  ASSERT_FALSE(res.rangePushed);
+  ASSERT_EQ(res.skippedProbeBlocks, 0);
+  ASSERT_TRUE(res.rows == expected);
+}
+
+// the build rows are in probe blocks 9 and 10, the scan skips the other blocks and the result stays the same
+TEST_F(HashJoinRangeTest, pushdownToScan) {
+  SHJoinTestRes res;
+  run(0, INT32_MAX, &res);
+  ASSERT_FALSE(res.rangePushed);
+  ASSERT_TRUE(res.rows == expected);
+
+  run(0, INT32_MAX, &res, HT_PROBE_SCAN);
+  ASSERT_TRUE(res.rangePushed);
+  ASSERT_EQ(res.skippedProbeBlocks, taosArrayGetSize(pProbeBlocks) - 2);
+  ASSERT_TRUE(res.rows == expected);
+
+  run(1, 1, &res, HT_PROBE_SCAN);
+  ASSERT_TRUE(res.rangePushed);
+  ASSERT_EQ(res.skippedProbeBlocks, taosArrayGetSize(pProbeBlocks) - 2);
+  ASSERT_TRUE(res.rows == expected);
+}
+
+// dropping rows of a scan with a limit or of a scan counting empty tables would change its result
+TEST_F(HashJoinRangeTest, noPushdownToLimitOrCountEmpty) {
+  SHJoinTestRes res;
+  run(0, INT32_MAX, &res, HT_PROBE_SCAN_WITH_LIMIT);
+  ASSERT_FALSE(res.rangePushed);
+  ASSERT_EQ(res.skippedProbeBlocks, 0);
+  ASSERT_TRUE(res.rows == expected);
+
+  run(0, INT32_MAX, &res, HT_PROBE_SCAN_COUNT_EMPTY);
+  ASSERT_FALSE(res.rangePushed);
+  ASSERT_EQ(res.skippedProbeBlocks, 0);
+  ASSERT_TRUE(res.rows == expected);
+}
+
+TEST(HashJoinRuntimeRange, narrowOnly) {
+  STableScanInfo scan = {0};
+  scan.base.rtRange = TSWINDOW_INITIALIZER;
+  scan.base.limitInfo.limit.limit = -1;
+  scan.base.limitInfo.slimit.limit = -1;
+  SOperatorInfo scanOp = {0};
+  scanOp.operatorType = QUERY_NODE_PHYSICAL_PLAN_TABLE_SCAN;
+  scanOp.info = &scan;
+
+  STimeWindow w1 = {.skey = 100, .ekey = 1000};
+  STimeWindow w2 = {.skey = 500, .ekey = 2000};
+  ASSERT_EQ(setOperatorRuntimeRange(&scanOp, &w1, false), 0);
+  ASSERT_EQ(setOperatorRuntimeRange(&scanOp, &w2, false), 0);
+  ASSERT_EQ(scan.base.rtRange.skey, 500);
+  ASSERT_EQ(scan.base.rtRange.ekey, 1000);
+
+  // a wider range never widens it again
+  STimeWindow all = TSWINDOW_INITIALIZER;
+  ASSERT_EQ(setOperatorRuntimeRange(&scanOp, &all, false), 0);
+  ASSERT_EQ(scan.base.rtRange.skey, 500);
+  ASSERT_EQ(scan.base.rtRange.ekey, 1000);
+
+  // an exchange only takes it from a local join, and not with a limit
+  SExchangeInfo exchange = {0};
+  exchange.limitInfo.limit.limit = -1;
+  exchange.limitInfo.slimit.limit = -1;
+  SOperatorInfo exchangeOp = {0};
+  exchangeOp.operatorType = QUERY_NODE_PHYSICAL_PLAN_EXCHANGE;
+  exchangeOp.info = &exchange;
+  ASSERT_NE(setOperatorRuntimeRange(&exchangeOp, &w1, false), 0);
+  ASSERT_FALSE(exchange.hasRtRange);
+  ASSERT_EQ(setOperatorRuntimeRange(&exchangeOp, &w1, true), 0);
+  ASSERT_TRUE(exchange.hasRtRange);
+  ASSERT_EQ(exchange.rtRange.skey, 100);
+  ASSERT_EQ(exchange.rtRange.ekey, 1000);
+
+  exchange.hasRtRange = false;
+  exchange.limitInfo.limit.limit = 10;
+  ASSERT_NE(setOperatorRuntimeRange(&exchangeOp, &w1, true), 0);
+  ASSERT_FALSE(exchange.hasRtRange);
+}
+
+int main(int argc, char** argv) {
+  tstrncpy(tsTempDir, TD_TMP_DIR_PATH, PATH_MAX);
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <tuple>
+#include <vector>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+#include "os.h"
+
+#include "executor.h"
+#include "executorInt.h"
+#include "tdatablock.h"
+#include "tglobal.h"
+#include "tsort.h"
+
+namespace {
+
+#define PT_BLOCK_ROWS 500
+#define PT_NUM_BLOCKS 24
+
+// unlike assert, the expression is evaluated in release builds too
+#define PT_CHECK(_expr)                                                     \
+  do {                                                                      \
+    if (!(_expr)) {                                                         \
+      (void)printf("%s:%d check failed: %s\n", __FILE__, __LINE__, #_expr); \
+      abort();                                                              \
+    }                                                                       \
+  } while (0)
+
+/*
+ * input (k1 INT, k2 INT, v BIGINT), order by k1 [asc|desc] [nulls first|last], k2 limit ... offset ...
+ * k2 is unique, so the order of the rows is total. The values of k1 repeat within and across blocks, and the
+ * blocks carry the sma of k1 so that whole blocks can be skipped by the bounded queue.
+ */
+typedef std::tuple<bool, int32_t, int32_t, int64_t> SPQTestRow;  // k1 is null, k1, k2, v
+
+typedef struct {
+  SArray* pBlocks;  // SArray<SSDataBlock*>, owned by the test
+  int32_t readIdx;
+} SPQTestSource;
+
+int32_t pqTestFetch(void* param, SSDataBlock** ppBlock) {
+  SPQTestSource* pSource = (SPQTestSource*)param;
+  *ppBlock = NULL;
+  if (pSource->readIdx < taosArrayGetSize(pSource->pBlocks)) {
+    *ppBlock = (SSDataBlock*)taosArrayGetP(pSource->pBlocks, pSource->readIdx++);
+  }
+  return TSDB_CODE_SUCCESS;
+}
+
+SSDataBlock* createPQTestBlock(int32_t blk) {
+  const int8_t types[] = {TSDB_DATA_TYPE_INT, TSDB_DATA_TYPE_INT, TSDB_DATA_TYPE_BIGINT};
+  SSDataBlock* p = NULL;
+  PT_CHECK(0 == createDataBlock(&p));
+  for (int32_t i = 0; i < 3; ++i) {
+    SColumnInfoData col = createColumnInfoData(types[i], tDataTypes[types[i]].bytes, i + 1);
+    PT_CHECK(0 == blockDataAppendColInfo(p, &col));
+  }
+  PT_CHECK(0 == blockDataEnsureCapacity(p, PT_BLOCK_ROWS));
+
+  SColumnInfoData* pK1 = (SColumnInfoData*)taosArrayGet(p->pDataBlock, 0);
+  SColumnInfoData* pK2 = (SColumnInfoData*)taosArrayGet(p->pDataBlock, 1);
+  SColumnInfoData* pV = (SColumnInfoData*)taosArrayGet(p->pDataBlock, 2);
+
+  // the k1 ranges of the blocks overlap and come in no particular order, one block has no k1 at all
+  int32_t base = ((blk * 7) % PT_NUM_BLOCKS) * 40 - 300;
+  bool    allNull = (blk == PT_NUM_BLOCKS / 2);
+  int32_t numOfNull = 0;
+  int64_t min = INT64_MAX, max = INT64_MIN;
+  for (int32_t r = 0; r < PT_BLOCK_ROWS; ++r) {
+    bool    k1Null = allNull || (blk % 3 == 1 && r % 23 == 0);
+    int32_t k1 = base + (r * 13) % 100;
+    int32_t k2 = blk * PT_BLOCK_ROWS + (r * 17) % PT_BLOCK_ROWS;
+    int64_t v = (int64_t)k2 * 1000 + blk;
+    PT_CHECK(0 == colDataSetVal(pK1, r, (const char*)&k1, k1Null));
+    PT_CHECK(0 == colDataSetVal(pK2, r, (const char*)&k2, false));
+    PT_CHECK(0 == colDataSetVal(pV, r, (const char*)&v, false));
+    if (k1Null) {
+      numOfNull++;
+    } else {
+      min = TMIN(min, k1);
+      max = TMAX(max, k1);
+    }
+  }
+  p->info.rows = PT_BLOCK_ROWS;
+
+  p->pBlockAgg = (SColumnDataAgg*)taosMemoryCalloc(3, sizeof(SColumnDataAgg));
+  PT_CHECK(p->pBlockAgg != NULL);
+  p->pBlockAgg[0].colId = 1;
+  p->pBlockAgg[0].numOfNull = numOfNull;
+  p->pBlockAgg[0].min = allNull ? 0 : min;
+  p->pBlockAgg[0].max = allNull ? 0 : max;
+  p->pBlockAgg[1].colId = -1;
+  p->pBlockAgg[2].colId = -1;
+  return p;
+}
+
+// pqMaxRows 0: all rows are sorted by the buffered merge sort, without any skipping, within pBudget if given
+std::vector<SPQTestRow> runPQTestSort(SArray* pBlocks, int32_t order, bool nullFirst, uint64_t pqMaxRows,
+                                      SMemBudget* pBudget = NULL, SSortExecInfo* pExecInfo = NULL) {
+  SArray*         pOrderInfo = taosArrayInit(2, sizeof(SBlockOrderInfo));
+  SBlockOrderInfo k1Order = {.nullFirst = nullFirst, .order = order, .slotId = 0};
+  SBlockOrderInfo k2Order = {.nullFirst = true, .order = TSDB_ORDER_ASC, .slotId = 1};
+  PT_CHECK(NULL != taosArrayPush(pOrderInfo, &k1Order));
+  PT_CHECK(NULL != taosArrayPush(pOrderInfo, &k2Order));
+
+  SSortHandle* pHandle = NULL;
+  PT_CHECK(0 == tsortCreateSortHandle(pOrderInfo, SORT_SINGLESOURCE_SORT, -1, -1, NULL, "pq_sort_test", pqMaxRows,
+                                      sizeof(SPQTestRow), 1048576, &pHandle));
+  if (pqMaxRows > 0) {
+    tsortSetForceUsePQSort(pHandle);
+  }
+  if (pBudget != NULL) {
+    tsortSetMemBudget(pHandle, pBudget);
+  }
+
+  SPQTestSource src = {.pBlocks = pBlocks, .readIdx = 0};
+  tsortSetFetchRawDataFp(pHandle, pqTestFetch, NULL, &src);
+  SSortSource* pSource = (SSortSource*)taosMemoryCalloc(1, sizeof(SSortSource));
+  PT_CHECK(pSource != NULL);
+  pSource->param = &src;
+  pSource->onlyRef = true;
+  PT_CHECK(0 == tsortAddSource(pHandle, pSource));
+  PT_CHECK(0 == tsortOpen(pHandle));
+
+  std::vector<SPQTestRow> rows;
+  while (true) {
+    STupleHandle* pTuple = NULL;
+    PT_CHECK(0 == tsortNextTuple(pHandle, &pTuple));
+    if (pTuple == NULL) {
+      break;
+    }
+
+    void* k1 = NULL;
+    void* k2 = NULL;
+    void* v = NULL;
+    bool  k1Null = tsortIsNullVal(pTuple, 0);
+    if (!k1Null) {
+      tsortGetValue(pTuple, 0, &k1);
+    }
+    tsortGetValue(pTuple, 1, &k2);
+    tsortGetValue(pTuple, 2, &v);
+    rows.push_back(SPQTestRow(k1Null, k1Null ? 0 : *(int32_t*)k1, *(int32_t*)k2, *(int64_t*)v));
+  }
+
+  if (pExecInfo != NULL) {
+    *pExecInfo = tsortGetSortExecInfo(pHandle);
+  }
+  tsortDestroySortHandle(pHandle);
+  taosArrayDestroy(pOrderInfo);
+  return rows;
+}
+
+class PQSortTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    pBlocks = taosArrayInit(PT_NUM_BLOCKS, POINTER_BYTES);
+    for (int32_t b = 0; b < PT_NUM_BLOCKS; ++b) {
+      SSDataBlock* pBlock = createPQTestBlock(b);
+      PT_CHECK(NULL != taosArrayPush(pBlocks, &pBlock));
+    }
+  }
+
+  void TearDown() override {
+    for (int32_t i = 0; i < taosArrayGetSize(pBlocks); ++i) {
+      blockDataDestroy((SSDataBlock*)taosArrayGetP(pBlocks, i));
+    }
+    taosArrayDestroy(pBlocks);
+  }
+
+  // order by ... limit `limit` offset `offset` gives the same rows with and without the bounded queue
+  void check(int32_t order, bool nullFirst, int32_t limit, int32_t offset) {
+    std::vector<SPQTestRow> all = runPQTestSort(pBlocks, order, nullFirst, 0);
+    std::vector<SPQTestRow> top = runPQTestSort(pBlocks, order, nullFirst, limit + offset);
+    ASSERT_EQ(all.size(), PT_NUM_BLOCKS * PT_BLOCK_ROWS);
+    ASSERT_EQ(top.size(), limit + offset);
+    for (int32_t i = offset; i < limit + offset; ++i) {
+      ASSERT_TRUE(all[i] == top[i]) << "row " << i;
+    }
+  }
+
+  SArray* pBlocks = NULL;
+};
+
+}  // namespace
+
+TEST_F(PQSortTest, ascNullsFirst) {
+  check(TSDB_ORDER_ASC, true, 10, 0);
+  check(TSDB_ORDER_ASC, true, 300, 0);
+}
+
+TEST_F(PQSortTest, ascNullsLast) {
+  check(TSDB_ORDER_ASC, false, 10, 0);
+  check(TSDB_ORDER_ASC, false, 300, 0);
+}
+
+TEST_F(PQSortTest, descNullsFirst) {
+  check(TSDB_ORDER_DESC, true, 10, 0);
+  check(TSDB_ORDER_DESC, true, 300, 0);
+}
+
+TEST_F(PQSortTest, descNullsLast) {
+  check(TSDB_ORDER_DESC, false, 10, 0);
+  check(TSDB_ORDER_DESC, false, 300, 0);
+}
+
+// every k1 value appears on several rows, the limit cuts inside a run of rows of the same k1
+TEST_F(PQSortTest, tiesOnFirstKey) {
+  check(TSDB_ORDER_ASC, false, 7, 0);
+  check(TSDB_ORDER_DESC, false, 7, 0);
+  check(TSDB_ORDER_ASC, false, 123, 0);
+}
+
+TEST_F(PQSortTest, limitWithOffset) {
+  check(TSDB_ORDER_ASC, false, 20, 100);
+  check(TSDB_ORDER_DESC, true, 20, 700);
+  check(TSDB_ORDER_ASC, true, 50, 1000);
+}
+
+// a budget far below the input makes the sort flush runs to disk and merge them, the rows do not change
+TEST_F(PQSortTest, spillUnderMemBudget) {
+  std::vector<SPQTestRow> all = runPQTestSort(pBlocks, TSDB_ORDER_ASC, false, 0);
+
+  SMemBudget budget = {0};
+  memBudgetInit(&budget, 32 * 1024, NULL);
+  SSortExecInfo           info = {0};
+  std::vector<SPQTestRow> spilled = runPQTestSort(pBlocks, TSDB_ORDER_ASC, false, 0, &budget, &info);
+
+  ASSERT_EQ(all.size(), PT_NUM_BLOCKS * PT_BLOCK_ROWS);
+  ASSERT_EQ(spilled.size(), all.size());
+  for (int32_t i = 0; i < all.size(); ++i) {
+    ASSERT_TRUE(all[i] == spilled[i]) << "row " << i;
+  }
+  ASSERT_EQ(info.sortMethod, SORT_SPILLED_MERGE_SORT_T);
+  ASSERT_GT(info.writeBytes, 0);
+  ASSERT_GT(memBudgetGetPeak(&budget), 0);
+  ASSERT_EQ(memBudgetGetUsed(&budget), 0);
+}
+
+int main(int argc, char** argv) {
+  tstrncpy(tsTempDir, TD_TMP_DIR_PATH, PATH_MAX);
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+
+#pragma GCC diagnostic pop
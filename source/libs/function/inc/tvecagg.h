@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TDENGINE_TVECAGG_H
+#define TDENGINE_TVECAGG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "tcommon.h"
+
+/*
+ * Aggregate kernels over the rows [start, start + numOfRows) of a fixed width column. Null rows are skipped by
+ * reading the null bitmap 64 rows at a time, the non-null runs are handed to AVX2/AVX512 kernels when available.
+ * All kernels return the number of non-null rows.
+ */
+bool    vecAggIsSupportedType(int32_t type);
+int32_t vecAggCountNotNull(const SColumnInfoData* pCol, int32_t start, int32_t numOfRows);
+
+// integer sum in int64, the unsigned types are zero extended and the result wraps the same way as the row loop
+int32_t vecAggSumInt(const SColumnInfoData* pCol, int32_t start, int32_t numOfRows, int64_t* pSum);
+
+// float/double sum with Kahan compensation
+int32_t vecAggSumFloat(const SColumnInfoData* pCol, int32_t start, int32_t numOfRows, double* pSum);
+
+// sum and sum of squares, the squares of integers are computed in 64 bits
+int32_t vecAggSumSquareInt(const SColumnInfoData* pCol, int32_t start, int32_t numOfRows, int64_t* pSum,
+                           int64_t* pSquareSum);
+int32_t vecAggSumSquareFloat(const SColumnInfoData* pCol, int32_t start, int32_t numOfRows, double* pSum,
+                             double* pSquareSum);
+
+// min/max converted to double, NaN is ignored
+int32_t vecAggMinMax(const SColumnInfoData* pCol, int32_t start, int32_t numOfRows, double* pMin, double* pMax);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // TDENGINE_TVECAGG_H
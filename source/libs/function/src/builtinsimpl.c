@@ -26,6 +26,7 @@
 #include "tglobal.h"
 #include "thistogram.h"
 #include "tpercentile.h"
+#include "tvecagg.h"
 
 bool ignoreNegative(int8_t ignoreOption){
   return (ignoreOption & 0x1) == 0x1;
@@ -96,18 +97,6 @@ typedef enum {
     }                                                                    \
   } while (0)
 
-#define LIST_ADD_N(_res, _col, _start, _rows, _t, numOfElem)             \
-  do {                                                                   \
-    _t* d = (_t*)(_col->pData);                                          \
-    for (int32_t i = (_start); i < (_rows) + (_start); ++i) {            \
-      if (((_col)->hasNull) && colDataIsNull_f((_col)->nullbitmap, i)) { \
-        continue;                                                        \
-      };                                                                 \
-      (_res) += (d)[i];                                                  \
-      (numOfElem)++;                                                     \
-    }                                                                    \
-  } while (0)
-
 #define LIST_SUB_N(_res, _col, _start, _rows, _t, numOfElem)             \
   do {                                                                   \
     _t* d = (_t*)(_col->pData);                                          \
@@ -539,7 +528,9 @@ static int64_t getNumOfElems(SqlFunctionCtx* pCtx) {
   if (pInput->colDataSMAIsSet && pInput->totalRows == pInput->numOfRows) {
     numOfElem = pInput->numOfRows - pInput->pColumnDataAgg[0]->numOfNull;
   } else {
-    if (pInputCol->hasNull) {
+    if (pInputCol->hasNull && vecAggIsSupportedType(pInputCol->info.type)) {
+      numOfElem = vecAggCountNotNull(pInputCol, pInput->startRowIndex, pInput->numOfRows);
+    } else if (pInputCol->hasNull) {
       for (int32_t i = pInput->startRowIndex; i < pInput->startRowIndex + pInput->numOfRows; ++i) {
         if (colDataIsNull(pInputCol, pInput->totalRows, i, NULL)) {
           continue;
@@ -643,30 +634,18 @@ int32_t sumFunction(SqlFunctionCtx* pCtx) {
     int32_t start = pInput->startRowIndex;
     int32_t numOfRows = pInput->numOfRows;
 
-    if (IS_SIGNED_NUMERIC_TYPE(type) || type == TSDB_DATA_TYPE_BOOL) {
-      if (type == TSDB_DATA_TYPE_TINYINT || type == TSDB_DATA_TYPE_BOOL) {
-        LIST_ADD_N(pSumRes->isum, pCol, start, numOfRows, int8_t, numOfElem);
-      } else if (type == TSDB_DATA_TYPE_SMALLINT) {
-        LIST_ADD_N(pSumRes->isum, pCol, start, numOfRows, int16_t, numOfElem);
-      } else if (type == TSDB_DATA_TYPE_INT) {
-        LIST_ADD_N(pSumRes->isum, pCol, start, numOfRows, int32_t, numOfElem);
-      } else if (type == TSDB_DATA_TYPE_BIGINT) {
-        LIST_ADD_N(pSumRes->isum, pCol, start, numOfRows, int64_t, numOfElem);
-      }
+    if (IS_FLOAT_TYPE(type)) {
+      double dsum = 0;
+      numOfElem = vecAggSumFloat(pCol, start, numOfRows, &dsum);
+      pSumRes->dsum += dsum;
     } else if (IS_UNSIGNED_NUMERIC_TYPE(type)) {
-      if (type == TSDB_DATA_TYPE_UTINYINT) {
-        LIST_ADD_N(pSumRes->usum, pCol, start, numOfRows, uint8_t, numOfElem);
-      } else if (type == TSDB_DATA_TYPE_USMALLINT) {
-        LIST_ADD_N(pSumRes->usum, pCol, start, numOfRows, uint16_t, numOfElem);
-      } else if (type == TSDB_DATA_TYPE_UINT) {
-        LIST_ADD_N(pSumRes->usum, pCol, start, numOfRows, uint32_t, numOfElem);
-      } else if (type == TSDB_DATA_TYPE_UBIGINT) {
-        LIST_ADD_N(pSumRes->usum, pCol, start, numOfRows, uint64_t, numOfElem);
-      }
-    } else if (type == TSDB_DATA_TYPE_DOUBLE) {
-      LIST_ADD_N(pSumRes->dsum, pCol, start, numOfRows, double, numOfElem);
-    } else if (type == TSDB_DATA_TYPE_FLOAT) {
-      LIST_ADD_N(pSumRes->dsum, pCol, start, numOfRows, float, numOfElem);
+      int64_t isum = 0;
+      numOfElem = vecAggSumInt(pCol, start, numOfRows, &isum);
+      pSumRes->usum += (uint64_t)isum;
+    } else if (IS_SIGNED_NUMERIC_TYPE(type) || type == TSDB_DATA_TYPE_BOOL) {
+      int64_t isum = 0;
+      numOfElem = vecAggSumInt(pCol, start, numOfRows, &isum);
+      pSumRes->isum += isum;
     }
   }
 
@@ -1116,164 +1095,23 @@ int32_t stdFunction(SqlFunctionCtx* pCtx) {
     goto _stddev_over;
   }
 
-  switch (type) {
-    case TSDB_DATA_TYPE_TINYINT: {
-      int8_t* plist = (int8_t*)pCol->pData;
-      for (int32_t i = start; i < numOfRows + start; ++i) {
-        if (pCol->hasNull && colDataIsNull_f(pCol->nullbitmap, i)) {
-          continue;
-        }
-
-        numOfElem += 1;
-        pStdRes->count += 1;
-        pStdRes->isum += plist[i];
-        pStdRes->quadraticISum += plist[i] * plist[i];
-      }
-
-      break;
-    }
-
-    case TSDB_DATA_TYPE_SMALLINT: {
-      int16_t* plist = (int16_t*)pCol->pData;
-      for (int32_t i = start; i < numOfRows + pInput->startRowIndex; ++i) {
-        if (pCol->hasNull && colDataIsNull_f(pCol->nullbitmap, i)) {
-          continue;
-        }
-
-        numOfElem += 1;
-        pStdRes->count += 1;
-        pStdRes->isum += plist[i];
-        pStdRes->quadraticISum += plist[i] * plist[i];
-      }
-      break;
-    }
-
-    case TSDB_DATA_TYPE_INT: {
-      int32_t* plist = (int32_t*)pCol->pData;
-      for (int32_t i = start; i < numOfRows + pInput->startRowIndex; ++i) {
-        if (pCol->hasNull && colDataIsNull_f(pCol->nullbitmap, i)) {
-          continue;
-        }
-
-        numOfElem += 1;
-        pStdRes->count += 1;
-        pStdRes->isum += plist[i];
-        pStdRes->quadraticISum += plist[i] * plist[i];
-      }
-
-      break;
-    }
-
-    case TSDB_DATA_TYPE_BIGINT: {
-      int64_t* plist = (int64_t*)pCol->pData;
-      for (int32_t i = start; i < numOfRows + pInput->startRowIndex; ++i) {
-        if (pCol->hasNull && colDataIsNull_f(pCol->nullbitmap, i)) {
-          continue;
-        }
-
-        numOfElem += 1;
-        pStdRes->count += 1;
-        pStdRes->isum += plist[i];
-        pStdRes->quadraticISum += plist[i] * plist[i];
-      }
-      break;
-    }
-
-    case TSDB_DATA_TYPE_UTINYINT: {
-      uint8_t* plist = (uint8_t*)pCol->pData;
-      for (int32_t i = start; i < numOfRows + start; ++i) {
-        if (pCol->hasNull && colDataIsNull_f(pCol->nullbitmap, i)) {
-          continue;
-        }
-
-        numOfElem += 1;
-        pStdRes->count += 1;
-        pStdRes->usum += plist[i];
-        pStdRes->quadraticUSum += plist[i] * plist[i];
-      }
-
-      break;
-    }
-
-    case TSDB_DATA_TYPE_USMALLINT: {
-      uint16_t* plist = (uint16_t*)pCol->pData;
-      for (int32_t i = start; i < numOfRows + pInput->startRowIndex; ++i) {
-        if (pCol->hasNull && colDataIsNull_f(pCol->nullbitmap, i)) {
-          continue;
-        }
-
-        numOfElem += 1;
-        pStdRes->count += 1;
-        pStdRes->usum += plist[i];
-        pStdRes->quadraticUSum += plist[i] * plist[i];
-      }
-      break;
-    }
-
-    case TSDB_DATA_TYPE_UINT: {
-      uint32_t* plist = (uint32_t*)pCol->pData;
-      for (int32_t i = start; i < numOfRows + pInput->startRowIndex; ++i) {
-        if (pCol->hasNull && colDataIsNull_f(pCol->nullbitmap, i)) {
-          continue;
-        }
-
-        numOfElem += 1;
-        pStdRes->count += 1;
-        pStdRes->usum += plist[i];
-        pStdRes->quadraticUSum += plist[i] * plist[i];
-      }
-
-      break;
-    }
-
-    case TSDB_DATA_TYPE_UBIGINT: {
-      uint64_t* plist = (uint64_t*)pCol->pData;
-      for (int32_t i = start; i < numOfRows + pInput->startRowIndex; ++i) {
-        if (pCol->hasNull && colDataIsNull_f(pCol->nullbitmap, i)) {
-          continue;
-        }
-
-        numOfElem += 1;
-        pStdRes->count += 1;
-        pStdRes->usum += plist[i];
-        pStdRes->quadraticUSum += plist[i] * plist[i];
-      }
-      break;
-    }
-
-    case TSDB_DATA_TYPE_FLOAT: {
-      float* plist = (float*)pCol->pData;
-      for (int32_t i = start; i < numOfRows + pInput->startRowIndex; ++i) {
-        if (pCol->hasNull && colDataIsNull_f(pCol->nullbitmap, i)) {
-          continue;
-        }
-
-        numOfElem += 1;
-        pStdRes->count += 1;
-        pStdRes->dsum += plist[i];
-        pStdRes->quadraticDSum += plist[i] * plist[i];
-      }
-      break;
-    }
-
-    case TSDB_DATA_TYPE_DOUBLE: {
-      double* plist = (double*)pCol->pData;
-      for (int32_t i = start; i < numOfRows + pInput->startRowIndex; ++i) {
-        if (pCol->hasNull && colDataIsNull_f(pCol->nullbitmap, i)) {
-          continue;
-        }
-
-        numOfElem += 1;
-        pStdRes->count += 1;
-        pStdRes->dsum += plist[i];
-        pStdRes->quadraticDSum += plist[i] * plist[i];
-      }
-      break;
-    }
-
-    default:
-      break;
+  if (IS_FLOAT_TYPE(type)) {
+    double sum = 0, squareSum = 0;
+    numOfElem = vecAggSumSquareFloat(pCol, start, numOfRows, &sum, &squareSum);
+    pStdRes->dsum += sum;
+    pStdRes->quadraticDSum += squareSum;
+  } else if (IS_SIGNED_NUMERIC_TYPE(type)) {
+    int64_t sum = 0, squareSum = 0;
+    numOfElem = vecAggSumSquareInt(pCol, start, numOfRows, &sum, &squareSum);
+    pStdRes->isum += sum;
+    pStdRes->quadraticISum += squareSum;
+  } else if (IS_UNSIGNED_NUMERIC_TYPE(type)) {
+    int64_t sum = 0, squareSum = 0;
+    numOfElem = vecAggSumSquareInt(pCol, start, numOfRows, &sum, &squareSum);
+    pStdRes->usum += (uint64_t)sum;
+    pStdRes->quadraticUSum += (uint64_t)squareSum;
   }
+  pStdRes->count += numOfElem;
 
 _stddev_over:
   // data in the check operation are all null, not output
@@ -4093,6 +3931,19 @@ int32_t spreadFunction(SqlFunctionCtx* pCtx) {
     SColumnInfoData* pCol = pInput->pData[0];
 
     int32_t start = pInput->startRowIndex;
+    if (vecAggIsSupportedType(type)) {
+      double tmin = 0.0, tmax = 0.0;
+      numOfElems = vecAggMinMax(pCol, start, pInput->numOfRows, &tmin, &tmax);
+      if (GET_DOUBLE_VAL(&pInfo->min) > tmin) {
+        SET_DOUBLE_VAL(&pInfo->min, tmin);
+      }
+
+      if (GET_DOUBLE_VAL(&pInfo->max) < tmax) {
+        SET_DOUBLE_VAL(&pInfo->max, tmax);
+      }
+      goto _spread_over;
+    }
+
     // check the valid data one by one
     for (int32_t i = start; i < pInput->numOfRows + start; ++i) {
       if (colDataIsNull_f(pCol->nullbitmap, i)) {
@@ -18,6 +18,7 @@
 #include "tdatablock.h"
 #include "tfunctionInt.h"
 #include "tglobal.h"
+#include "tvecagg.h"
 
 #define SET_VAL(_info, numOfElem, res) \
   do {                                 \
@@ -285,6 +286,33 @@ static int32_t doAddNumericVector(SColumnInfoData* pCol, int32_t type, SInputCol
   return numOfElems;
 }
 
+// the sum of a block of integers up to 32 bits never overflows int64, so the overflow is checked once per block
+static bool canAddNumericBlock(int32_t type) {
+  return IS_FLOAT_TYPE(type) || (IS_INTEGER_TYPE(type) && tDataTypes[type].bytes <= (int32_t)sizeof(int32_t));
+}
+
+static int32_t doAddNumericBlock(SColumnInfoData* pCol, int32_t type, int32_t start, int32_t numOfRows, SAvgRes* pRes) {
+  int32_t numOfElems = 0;
+
+  if (IS_FLOAT_TYPE(type)) {
+    double dsum = 0;
+    numOfElems = vecAggSumFloat(pCol, start, numOfRows, &dsum);
+    pRes->sum.dsum += dsum;
+  } else {
+    int64_t isum = 0;
+    numOfElems = vecAggSumInt(pCol, start, numOfRows, &isum);
+    if (IS_SIGNED_NUMERIC_TYPE(type)) {
+      CHECK_OVERFLOW_SUM_SIGNED(pRes, isum)
+    } else {
+      uint64_t usum = (uint64_t)isum;
+      CHECK_OVERFLOW_SUM_UNSIGNED(pRes, usum)
+    }
+  }
+
+  pRes->count += numOfElems;
+  return numOfElems;
+}
+
 int32_t avgFunction(SqlFunctionCtx* pCtx) {
   int32_t       numOfElem = 0;
   const int32_t THRESHOLD_SIZE = 8;
@@ -309,6 +337,8 @@ int32_t avgFunction(SqlFunctionCtx* pCtx) {
 
   if (pInput->colDataSMAIsSet) {  // try to use SMA if available
     numOfElem = calculateAvgBySMAInfo(pAvgRes, numOfRows, type, pAgg);
+  } else if (canAddNumericBlock(type)) {  // null rows are skipped by the bitmap, the block is summed by simd kernels
+    numOfElem = doAddNumericBlock(pCol, type, start, numOfRows, pAvgRes);
   } else if (!pCol->hasNull) {  // try to employ the simd instructions to speed up the loop
     numOfElem = pInput->numOfRows;
     pAvgRes->count += pInput->numOfRows;
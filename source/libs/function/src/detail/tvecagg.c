@@ -0,0 +1,778 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "os.h"
+#include "tdatablock.h"
+#include "tglobal.h"
+#include "ttypes.h"
+#include "tvecagg.h"
+
+#define VEC_AGG_WORD_BITS 64
+
+typedef struct SVecAggAcc {
+  int64_t isum;
+  int64_t isquare;
+  double  dsum;
+  double  dcomp;  // running compensation of the Kahan sum
+  double  dsquare;
+  double  min;
+  double  max;
+} SVecAggAcc;
+
+// kernel over the dense rows [start, start + numOfRows), no null check inside
+typedef void (*FVecAggDense)(int32_t type, const char* pData, int32_t start, int32_t numOfRows, SVecAggAcc* pAcc);
+
+static FORCE_INLINE int32_t vecAggPopcount(uint64_t v) {
+  v = v - ((v >> 1) & 0x5555555555555555ULL);
+  v = (v & 0x3333333333333333ULL) + ((v >> 2) & 0x3333333333333333ULL);
+  v = (v + (v >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+  return (int32_t)((v * 0x0101010101010101ULL) >> 56);
+}
+
+static FORCE_INLINE void vecAggKahanAdd(SVecAggAcc* pAcc, double v) {
+  double y = v - pAcc->dcomp;
+  double t = pAcc->dsum + y;
+  pAcc->dcomp = (t - pAcc->dsum) - y;
+  pAcc->dsum = t;
+}
+
+/*
+ * Valid (not null) mask of the 64 rows starting at base, bit i stands for row base + i. Only the rows inside
+ * [start, end) are reported. The null bitmap keeps row r in bit (7 - r % 8) of byte r / 8, so a full word is
+ * assembled from 8 bytes and the bits of every byte are reversed.
+ */
+static FORCE_INLINE uint64_t vecAggValidMask(const char* nullBitmap, int32_t base, int32_t start, int32_t end) {
+  int32_t lo = TMAX(start, base) - base;
+  int32_t hi = TMIN(end, base + VEC_AGG_WORD_BITS) - base;
+
+  if (lo == 0 && hi == VEC_AGG_WORD_BITS) {
+    const uint8_t* p = (const uint8_t*)nullBitmap + (base >> 3);
+    uint64_t       w = 0;
+    for (int32_t k = 0; k < 8; ++k) {
+      w |= ((uint64_t)p[k]) << (k << 3);
+    }
+
+    w = ((w >> 1) & 0x5555555555555555ULL) | ((w & 0x5555555555555555ULL) << 1);
+    w = ((w >> 2) & 0x3333333333333333ULL) | ((w & 0x3333333333333333ULL) << 2);
+    w = ((w >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((w & 0x0F0F0F0F0F0F0F0FULL) << 4);
+    return ~w;
+  }
+
+  uint64_t mask = 0;
+  for (int32_t i = lo; i < hi; ++i) {
+    if (!colDataIsNull_f(nullBitmap, base + i)) {
+      mask |= (1ULL << i);
+    }
+  }
+  return mask;
+}
+
+/*
+ * Split the rows into runs of non-null values and hand every run to the dense kernel. Adjacent runs of
+ * neighbouring words are merged, so a column with sparse nulls is processed in long dense stretches.
+ */
+static int32_t vecAggForEachRun(const SColumnInfoData* pCol, int32_t start, int32_t numOfRows, FVecAggDense fp,
+                                SVecAggAcc* pAcc) {
+  int32_t type = pCol->info.type;
+  if (!pCol->hasNull) {
+    if (numOfRows > 0) {
+      fp(type, pCol->pData, start, numOfRows, pAcc);
+    }
+    return numOfRows;
+  }
+
+  int32_t end = start + numOfRows;
+  int32_t runStart = 0;
+  int32_t runEnd = 0;
+  int32_t numOfElem = 0;
+
+  for (int32_t base = start & ~(VEC_AGG_WORD_BITS - 1); base < end; base += VEC_AGG_WORD_BITS) {
+    uint64_t mask = vecAggValidMask(pCol->nullbitmap, base, start, end);
+    numOfElem += vecAggPopcount(mask);
+
+    while (mask != 0) {
+      int32_t  first = BUILDIN_CTZL(mask);
+      uint64_t rest = ~(mask >> first);
+      int32_t  len = (rest == 0) ? VEC_AGG_WORD_BITS - first : BUILDIN_CTZL(rest);
+
+      if (base + first == runEnd) {
+        runEnd += len;
+      } else {
+        if (runEnd > runStart) {
+          fp(type, pCol->pData, runStart, runEnd - runStart, pAcc);
+        }
+        runStart = base + first;
+        runEnd = runStart + len;
+      }
+
+      mask = (first + len >= VEC_AGG_WORD_BITS) ? 0 : (mask & ~(((1ULL << len) - 1) << first));
+    }
+  }
+
+  if (runEnd > runStart) {
+    fp(type, pCol->pData, runStart, runEnd - runStart, pAcc);
+  }
+  return numOfElem;
+}
+
+#define VEC_AGG_LOOP(_t, _p, _s, _e, _stmt) \
+  do {                                      \
+    const _t* d = (const _t*)(_p);          \
+    for (int32_t j = (_s); j < (_e); ++j) { \
+      _stmt;                                \
+    }                                       \
+  } while (0)
+
+#ifdef __AVX2__
+static FORCE_INLINE int64_t vecAggHsumEpi64(__m256i v) {
+  __m128i s = _mm_add_epi64(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+  return _mm_cvtsi128_si64(s) + _mm_extract_epi64(s, 1);
+}
+
+static FORCE_INLINE double vecAggHsumPd(__m256d v) {
+  double a[4];
+  _mm256_storeu_pd(a, v);
+  return (a[0] + a[1]) + (a[2] + a[3]);
+}
+
+static FORCE_INLINE bool vecAggUseAVX2(int32_t numOfRows, int32_t bytes) {
+  return tsSIMDEnable && tsAVX2Supported && numOfRows * bytes >= (int32_t)sizeof(__m256i);
+}
+#endif
+
+#if defined(__AVX512F__)
+static FORCE_INLINE bool vecAggUseAVX512(int32_t numOfRows, int32_t bytes) {
+  return tsSIMDEnable && tsAVX512Supported && tsAVX512Enable && numOfRows * bytes >= (int32_t)sizeof(__m512i);
+}
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------
+// integer sum
+static int32_t vecAggSumIntSIMD(int32_t type, const char* pData, int32_t numOfRows, int64_t* pSum) {
+  int32_t i = 0;
+#if defined(__AVX512F__)
+  if (vecAggUseAVX512(numOfRows, tDataTypes[type].bytes)) {
+    __m512i acc = _mm512_setzero_si512();
+    switch (type) {
+      case TSDB_DATA_TYPE_INT:
+        for (; i + 8 <= numOfRows; i += 8) {
+          __m256i x = _mm256_loadu_si256((const __m256i*)((const int32_t*)pData + i));
+          acc = _mm512_add_epi64(acc, _mm512_cvtepi32_epi64(x));
+        }
+        break;
+      case TSDB_DATA_TYPE_UINT:
+        for (; i + 8 <= numOfRows; i += 8) {
+          __m256i x = _mm256_loadu_si256((const __m256i*)((const int32_t*)pData + i));
+          acc = _mm512_add_epi64(acc, _mm512_cvtepu32_epi64(x));
+        }
+        break;
+      case TSDB_DATA_TYPE_BIGINT:
+      case TSDB_DATA_TYPE_UBIGINT:
+      case TSDB_DATA_TYPE_TIMESTAMP:
+        for (; i + 8 <= numOfRows; i += 8) {
+          acc = _mm512_add_epi64(acc, _mm512_loadu_si512((const void*)((const int64_t*)pData + i)));
+        }
+        break;
+      default:
+        break;
+    }
+    *pSum += _mm512_reduce_add_epi64(acc);
+    if (i > 0) {
+      return i;
+    }
+  }
+#endif
+
+#ifdef __AVX2__
+  if (vecAggUseAVX2(numOfRows, tDataTypes[type].bytes)) {
+    __m256i acc = _mm256_setzero_si256();
+    int64_t bias = 0;
+    switch (type) {
+      case TSDB_DATA_TYPE_BOOL:
+      case TSDB_DATA_TYPE_UTINYINT: {
+        for (; i + 32 <= numOfRows; i += 32) {
+          __m256i x = _mm256_loadu_si256((const __m256i*)((const uint8_t*)pData + i));
+          acc = _mm256_add_epi64(acc, _mm256_sad_epu8(x, _mm256_setzero_si256()));
+        }
+        break;
+      }
+      case TSDB_DATA_TYPE_TINYINT: {
+        // flip the sign bit to get v + 128 as unsigned, sum it with sad and remove the bias
+        const __m256i sign = _mm256_set1_epi8((char)0x80);
+        for (; i + 32 <= numOfRows; i += 32) {
+          __m256i x = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)((const int8_t*)pData + i)), sign);
+          acc = _mm256_add_epi64(acc, _mm256_sad_epu8(x, _mm256_setzero_si256()));
+        }
+        bias = -128LL * i;
+        break;
+      }
+      case TSDB_DATA_TYPE_SMALLINT:
+      case TSDB_DATA_TYPE_USMALLINT: {
+        // the unsigned values are moved into the signed range, the pairwise sums of madd fit in int32
+        const __m256i ones = _mm256_set1_epi16(1);
+        const __m256i sign = _mm256_set1_epi16((type == TSDB_DATA_TYPE_USMALLINT) ? (short)0x8000 : 0);
+        for (; i + 16 <= numOfRows; i += 16) {
+          __m256i x = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)((const int16_t*)pData + i)), sign);
+          __m256i s = _mm256_madd_epi16(x, ones);
+          acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(s)));
+          acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(s, 1)));
+        }
+        bias = (type == TSDB_DATA_TYPE_USMALLINT) ? 32768LL * i : 0;
+        break;
+      }
+      case TSDB_DATA_TYPE_INT:
+        for (; i + 4 <= numOfRows; i += 4) {
+          __m128i x = _mm_loadu_si128((const __m128i*)((const int32_t*)pData + i));
+          acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(x));
+        }
+        break;
+      case TSDB_DATA_TYPE_UINT:
+        for (; i + 4 <= numOfRows; i += 4) {
+          __m128i x = _mm_loadu_si128((const __m128i*)((const uint32_t*)pData + i));
+          acc = _mm256_add_epi64(acc, _mm256_cvtepu32_epi64(x));
+        }
+        break;
+      case TSDB_DATA_TYPE_BIGINT:
+      case TSDB_DATA_TYPE_UBIGINT:
+      case TSDB_DATA_TYPE_TIMESTAMP:
+        for (; i + 4 <= numOfRows; i += 4) {
+          acc = _mm256_add_epi64(acc, _mm256_loadu_si256((const __m256i*)((const int64_t*)pData + i)));
+        }
+        break;
+      default:
+        break;
+    }
+    *pSum += vecAggHsumEpi64(acc) + bias;
+  }
+#endif
+  return i;
+}
+
+static void vecAggSumIntDense(int32_t type, const char* pData, int32_t start, int32_t numOfRows, SVecAggAcc* pAcc) {
+  int32_t bytes = tDataTypes[type].bytes;
+  int32_t i = start + vecAggSumIntSIMD(type, pData + start * bytes, numOfRows, &pAcc->isum);
+  int32_t end = start + numOfRows;
+
+  switch (type) {
+    case TSDB_DATA_TYPE_BOOL:
+    case TSDB_DATA_TYPE_TINYINT:
+      VEC_AGG_LOOP(int8_t, pData, i, end, pAcc->isum += d[j]);
+      break;
+    case TSDB_DATA_TYPE_UTINYINT:
+      VEC_AGG_LOOP(uint8_t, pData, i, end, pAcc->isum += d[j]);
+      break;
+    case TSDB_DATA_TYPE_SMALLINT:
+      VEC_AGG_LOOP(int16_t, pData, i, end, pAcc->isum += d[j]);
+      break;
+    case TSDB_DATA_TYPE_USMALLINT:
+      VEC_AGG_LOOP(uint16_t, pData, i, end, pAcc->isum += d[j]);
+      break;
+    case TSDB_DATA_TYPE_INT:
+      VEC_AGG_LOOP(int32_t, pData, i, end, pAcc->isum += d[j]);
+      break;
+    case TSDB_DATA_TYPE_UINT:
+      VEC_AGG_LOOP(uint32_t, pData, i, end, pAcc->isum += d[j]);
+      break;
+    case TSDB_DATA_TYPE_BIGINT:
+    case TSDB_DATA_TYPE_UBIGINT:
+    case TSDB_DATA_TYPE_TIMESTAMP:
+      // wrap in uint64 as the sum of the row loop does, the signed overflow is avoided
+      VEC_AGG_LOOP(uint64_t, pData, i, end, pAcc->isum = (int64_t)((uint64_t)pAcc->isum + d[j]));
+      break;
+    default:
+      break;
+  }
+}
+
+// ---------------------------------------------------------------------------------------------------------------
+// float sum with Kahan compensation, every lane keeps its own compensation and the lanes are merged at the end
+static void vecAggSumFloatDense(int32_t type, const char* pData, int32_t start, int32_t numOfRows, SVecAggAcc* pAcc) {
+  int32_t i = start;
+  int32_t end = start + numOfRows;
+
+#if defined(__AVX512F__)
+  if (vecAggUseAVX512(numOfRows, tDataTypes[type].bytes)) {
+    __m512d s = _mm512_setzero_pd();
+    __m512d c = _mm512_setzero_pd();
+    for (; i + 8 <= end; i += 8) {
+      __m512d x = (type == TSDB_DATA_TYPE_FLOAT) ? _mm512_cvtps_pd(_mm256_loadu_ps((const float*)pData + i))
+                                                 : _mm512_loadu_pd((const double*)pData + i);
+      __m512d y = _mm512_sub_pd(x, c);
+      __m512d t = _mm512_add_pd(s, y);
+      c = _mm512_sub_pd(_mm512_sub_pd(t, s), y);
+      s = t;
+    }
+
+    double ls[8], lc[8];
+    _mm512_storeu_pd(ls, s);
+    _mm512_storeu_pd(lc, c);
+    for (int32_t k = 0; k < 8; ++k) {
+      vecAggKahanAdd(pAcc, ls[k]);
+      vecAggKahanAdd(pAcc, -lc[k]);
+    }
+  }
+#endif
+
+#ifdef __AVX2__
+  if (vecAggUseAVX2(end - i, tDataTypes[type].bytes)) {
+    __m256d s = _mm256_setzero_pd();
+    __m256d c = _mm256_setzero_pd();
+    for (; i + 4 <= end; i += 4) {
+      __m256d x = (type == TSDB_DATA_TYPE_FLOAT) ? _mm256_cvtps_pd(_mm_loadu_ps((const float*)pData + i))
+                                                 : _mm256_loadu_pd((const double*)pData + i);
+      __m256d y = _mm256_sub_pd(x, c);
+      __m256d t = _mm256_add_pd(s, y);
+      c = _mm256_sub_pd(_mm256_sub_pd(t, s), y);
+      s = t;
+    }
+
+    double ls[4], lc[4];
+    _mm256_storeu_pd(ls, s);
+    _mm256_storeu_pd(lc, c);
+    for (int32_t k = 0; k < 4; ++k) {
+      vecAggKahanAdd(pAcc, ls[k]);
+      vecAggKahanAdd(pAcc, -lc[k]);
+    }
+  }
+#endif
+
+  if (type == TSDB_DATA_TYPE_FLOAT) {
+    VEC_AGG_LOOP(float, pData, i, end, vecAggKahanAdd(pAcc, d[j]));
+  } else {
+    VEC_AGG_LOOP(double, pData, i, end, vecAggKahanAdd(pAcc, d[j]));
+  }
+}
+
+// ---------------------------------------------------------------------------------------------------------------
+// sum and sum of squares, the types up to 32 bits are widened to 64 bits lanes before the multiplication
+#ifdef __AVX2__
+static FORCE_INLINE __m256i vecAggLoad4Epi64(int32_t type, const char* p) {
+  int32_t v32 = 0;
+  switch (type) {
+    case TSDB_DATA_TYPE_BOOL:
+    case TSDB_DATA_TYPE_TINYINT:
+      (void)memcpy(&v32, p, sizeof(int32_t));
+      return _mm256_cvtepi8_epi64(_mm_cvtsi32_si128(v32));
+    case TSDB_DATA_TYPE_UTINYINT:
+      (void)memcpy(&v32, p, sizeof(int32_t));
+      return _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(v32));
+    case TSDB_DATA_TYPE_SMALLINT:
+      return _mm256_cvtepi16_epi64(_mm_loadl_epi64((const __m128i*)p));
+    case TSDB_DATA_TYPE_USMALLINT:
+      return _mm256_cvtepu16_epi64(_mm_loadl_epi64((const __m128i*)p));
+    case TSDB_DATA_TYPE_INT:
+      return _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i*)p));
+    default:
+      return _mm256_cvtepu32_epi64(_mm_loadu_si128((const __m128i*)p));
+  }
+}
+#endif
+
+static void vecAggSumSquareIntDense(int32_t type, const char* pData, int32_t start, int32_t numOfRows,
+                                    SVecAggAcc* pAcc) {
+  int32_t bytes = tDataTypes[type].bytes;
+  int32_t i = start;
+  int32_t end = start + numOfRows;
+
+#ifdef __AVX2__
+  if (bytes <= (int32_t)sizeof(int32_t) && vecAggUseAVX2(numOfRows, bytes)) {
+    __m256i s = _mm256_setzero_si256();
+    __m256i q = _mm256_setzero_si256();
+    if (type == TSDB_DATA_TYPE_UINT) {
+      for (; i + 4 <= end; i += 4) {
+        __m256i x = vecAggLoad4Epi64(type, pData + i * bytes);
+        s = _mm256_add_epi64(s, x);
+        q = _mm256_add_epi64(q, _mm256_mul_epu32(x, x));
+      }
+    } else {
+      for (; i + 4 <= end; i += 4) {
+        __m256i x = vecAggLoad4Epi64(type, pData + i * bytes);
+        s = _mm256_add_epi64(s, x);
+        q = _mm256_add_epi64(q, _mm256_mul_epi32(x, x));
+      }
+    }
+    pAcc->isum += vecAggHsumEpi64(s);
+    pAcc->isquare = (int64_t)((uint64_t)pAcc->isquare + (uint64_t)vecAggHsumEpi64(q));
+  }
+#endif
+
+#define VEC_AGG_SQUARE_STMT                                                              \
+  do {                                                                                   \
+    pAcc->isum = (int64_t)((uint64_t)pAcc->isum + (uint64_t)d[j]);                       \
+    pAcc->isquare = (int64_t)((uint64_t)pAcc->isquare + (uint64_t)d[j] * (uint64_t)d[j]); \
+  } while (0)
+
+  switch (type) {
+    case TSDB_DATA_TYPE_BOOL:
+    case TSDB_DATA_TYPE_TINYINT:
+      VEC_AGG_LOOP(int8_t, pData, i, end, VEC_AGG_SQUARE_STMT);
+      break;
+    case TSDB_DATA_TYPE_UTINYINT:
+      VEC_AGG_LOOP(uint8_t, pData, i, end, VEC_AGG_SQUARE_STMT);
+      break;
+    case TSDB_DATA_TYPE_SMALLINT:
+      VEC_AGG_LOOP(int16_t, pData, i, end, VEC_AGG_SQUARE_STMT);
+      break;
+    case TSDB_DATA_TYPE_USMALLINT:
+      VEC_AGG_LOOP(uint16_t, pData, i, end, VEC_AGG_SQUARE_STMT);
+      break;
+    case TSDB_DATA_TYPE_INT:
+      VEC_AGG_LOOP(int32_t, pData, i, end, VEC_AGG_SQUARE_STMT);
+      break;
+    case TSDB_DATA_TYPE_UINT:
+      VEC_AGG_LOOP(uint32_t, pData, i, end, VEC_AGG_SQUARE_STMT);
+      break;
+    case TSDB_DATA_TYPE_BIGINT:
+    case TSDB_DATA_TYPE_TIMESTAMP:
+      VEC_AGG_LOOP(int64_t, pData, i, end, VEC_AGG_SQUARE_STMT);
+      break;
+    case TSDB_DATA_TYPE_UBIGINT:
+      VEC_AGG_LOOP(uint64_t, pData, i, end, VEC_AGG_SQUARE_STMT);
+      break;
+    default:
+      break;
+  }
+
+#undef VEC_AGG_SQUARE_STMT
+}
+
+static void vecAggSumSquareFloatDense(int32_t type, const char* pData, int32_t start, int32_t numOfRows,
+                                      SVecAggAcc* pAcc) {
+  int32_t i = start;
+  int32_t end = start + numOfRows;
+
+#ifdef __AVX2__
+  if (vecAggUseAVX2(numOfRows, tDataTypes[type].bytes)) {
+    __m256d s = _mm256_setzero_pd();
+    __m256d q = _mm256_setzero_pd();
+    for (; i + 4 <= end; i += 4) {
+      __m256d x = (type == TSDB_DATA_TYPE_FLOAT) ? _mm256_cvtps_pd(_mm_loadu_ps((const float*)pData + i))
+                                                 : _mm256_loadu_pd((const double*)pData + i);
+      s = _mm256_add_pd(s, x);
+      q = _mm256_add_pd(q, _mm256_mul_pd(x, x));
+    }
+    pAcc->dsum += vecAggHsumPd(s);
+    pAcc->dsquare += vecAggHsumPd(q);
+  }
+#endif
+
+  if (type == TSDB_DATA_TYPE_FLOAT) {
+    VEC_AGG_LOOP(float, pData, i, end, {
+      double v = d[j];
+      pAcc->dsum += v;
+      pAcc->dsquare += v * v;
+    });
+  } else {
+    VEC_AGG_LOOP(double, pData, i, end, {
+      pAcc->dsum += d[j];
+      pAcc->dsquare += d[j] * d[j];
+    });
+  }
+}
+
+// ---------------------------------------------------------------------------------------------------------------
+// min/max, NaN is never picked since the SIMD min/max return the second operand (the accumulator) for it
+#define VEC_AGG_MINMAX_LOOP(_t, _s, _e)                           \
+  do {                                                            \
+    const _t* d = (const _t*)pData;                               \
+    for (int32_t j = (_s); j < (_e); ++j) {                       \
+      if (pAcc->min > (double)d[j]) pAcc->min = (double)d[j];     \
+      if (pAcc->max < (double)d[j]) pAcc->max = (double)d[j];     \
+    }                                                             \
+  } while (0)
+
+#ifdef __AVX2__
+#define VEC_AGG_MINMAX_AVX2_INT(_t, _w, _minop, _maxop)                            \
+  do {                                                                             \
+    __m256i vmin = _mm256_loadu_si256((const __m256i*)((const _t*)pData + i));     \
+    __m256i vmax = vmin;                                                           \
+    for (i += (_w); i + (_w) <= end; i += (_w)) {                                  \
+      __m256i x = _mm256_loadu_si256((const __m256i*)((const _t*)pData + i));      \
+      vmin = _minop(vmin, x);                                                      \
+      vmax = _maxop(vmax, x);                                                      \
+    }                                                                              \
+    _t lmin[_w], lmax[_w];                                                         \
+    _mm256_storeu_si256((__m256i*)lmin, vmin);                                     \
+    _mm256_storeu_si256((__m256i*)lmax, vmax);                                     \
+    for (int32_t k = 0; k < (_w); ++k) {                                           \
+      if (pAcc->min > (double)lmin[k]) pAcc->min = (double)lmin[k];                \
+      if (pAcc->max < (double)lmax[k]) pAcc->max = (double)lmax[k];                \
+    }                                                                              \
+  } while (0)
+
+static FORCE_INLINE __m256i vecAggMinEpi64(__m256i a, __m256i b) {
+  return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b));
+}
+
+static FORCE_INLINE __m256i vecAggMaxEpi64(__m256i a, __m256i b) {
+  return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(b, a));
+}
+
+static FORCE_INLINE __m256i vecAggMinEpu64(__m256i a, __m256i b) {
+  const __m256i bias = _mm256_set1_epi64x((int64_t)0x8000000000000000ULL);
+  __m256i       gt = _mm256_cmpgt_epi64(_mm256_xor_si256(a, bias), _mm256_xor_si256(b, bias));
+  return _mm256_blendv_epi8(a, b, gt);
+}
+
+static FORCE_INLINE __m256i vecAggMaxEpu64(__m256i a, __m256i b) {
+  const __m256i bias = _mm256_set1_epi64x((int64_t)0x8000000000000000ULL);
+  __m256i       gt = _mm256_cmpgt_epi64(_mm256_xor_si256(b, bias), _mm256_xor_si256(a, bias));
+  return _mm256_blendv_epi8(a, b, gt);
+}
+#endif
+
+static void vecAggMinMaxDense(int32_t type, const char* pData, int32_t start, int32_t numOfRows, SVecAggAcc* pAcc) {
+  int32_t i = start;
+  int32_t end = start + numOfRows;
+
+#if defined(__AVX512F__)
+  if (vecAggUseAVX512(numOfRows, tDataTypes[type].bytes)) {
+    switch (type) {
+      case TSDB_DATA_TYPE_FLOAT: {
+        __m512 vmin = _mm512_set1_ps(INFINITY), vmax = _mm512_set1_ps(-INFINITY);
+        for (; i + 16 <= end; i += 16) {
+          __m512 x = _mm512_loadu_ps((const float*)pData + i);
+          vmin = _mm512_min_ps(x, vmin);
+          vmax = _mm512_max_ps(x, vmax);
+        }
+        pAcc->min = TMIN(pAcc->min, (double)_mm512_reduce_min_ps(vmin));
+        pAcc->max = TMAX(pAcc->max, (double)_mm512_reduce_max_ps(vmax));
+        break;
+      }
+      case TSDB_DATA_TYPE_DOUBLE: {
+        __m512d vmin = _mm512_set1_pd(INFINITY), vmax = _mm512_set1_pd(-INFINITY);
+        for (; i + 8 <= end; i += 8) {
+          __m512d x = _mm512_loadu_pd((const double*)pData + i);
+          vmin = _mm512_min_pd(x, vmin);
+          vmax = _mm512_max_pd(x, vmax);
+        }
+        pAcc->min = TMIN(pAcc->min, _mm512_reduce_min_pd(vmin));
+        pAcc->max = TMAX(pAcc->max, _mm512_reduce_max_pd(vmax));
+        break;
+      }
+      case TSDB_DATA_TYPE_INT: {
+        __m512i vmin = _mm512_set1_epi32(INT32_MAX), vmax = _mm512_set1_epi32(INT32_MIN);
+        for (; i + 16 <= end; i += 16) {
+          __m512i x = _mm512_loadu_si512((const void*)((const int32_t*)pData + i));
+          vmin = _mm512_min_epi32(vmin, x);
+          vmax = _mm512_max_epi32(vmax, x);
+        }
+        pAcc->min = TMIN(pAcc->min, (double)_mm512_reduce_min_epi32(vmin));
+        pAcc->max = TMAX(pAcc->max, (double)_mm512_reduce_max_epi32(vmax));
+        break;
+      }
+      case TSDB_DATA_TYPE_UINT: {
+        __m512i vmin = _mm512_set1_epi32(-1), vmax = _mm512_setzero_si512();
+        for (; i + 16 <= end; i += 16) {
+          __m512i x = _mm512_loadu_si512((const void*)((const uint32_t*)pData + i));
+          vmin = _mm512_min_epu32(vmin, x);
+          vmax = _mm512_max_epu32(vmax, x);
+        }
+        pAcc->min = TMIN(pAcc->min, (double)_mm512_reduce_min_epu32(vmin));
+        pAcc->max = TMAX(pAcc->max, (double)_mm512_reduce_max_epu32(vmax));
+        break;
+      }
+      case TSDB_DATA_TYPE_BIGINT:
+      case TSDB_DATA_TYPE_TIMESTAMP: {
+        __m512i vmin = _mm512_set1_epi64(INT64_MAX), vmax = _mm512_set1_epi64(INT64_MIN);
+        for (; i + 8 <= end; i += 8) {
+          __m512i x = _mm512_loadu_si512((const void*)((const int64_t*)pData + i));
+          vmin = _mm512_min_epi64(vmin, x);
+          vmax = _mm512_max_epi64(vmax, x);
+        }
+        pAcc->min = TMIN(pAcc->min, (double)_mm512_reduce_min_epi64(vmin));
+        pAcc->max = TMAX(pAcc->max, (double)_mm512_reduce_max_epi64(vmax));
+        break;
+      }
+      case TSDB_DATA_TYPE_UBIGINT: {
+        __m512i vmin = _mm512_set1_epi64(-1), vmax = _mm512_setzero_si512();
+        for (; i + 8 <= end; i += 8) {
+          __m512i x = _mm512_loadu_si512((const void*)((const uint64_t*)pData + i));
+          vmin = _mm512_min_epu64(vmin, x);
+          vmax = _mm512_max_epu64(vmax, x);
+        }
+        pAcc->min = TMIN(pAcc->min, (double)_mm512_reduce_min_epu64(vmin));
+        pAcc->max = TMAX(pAcc->max, (double)_mm512_reduce_max_epu64(vmax));
+        break;
+      }
+      default:
+        break;
+    }
+  }
+#endif
+
+#ifdef __AVX2__
+  if (vecAggUseAVX2(end - i, tDataTypes[type].bytes)) {
+    switch (type) {
+      case TSDB_DATA_TYPE_BOOL:
+      case TSDB_DATA_TYPE_TINYINT:
+        VEC_AGG_MINMAX_AVX2_INT(int8_t, 32, _mm256_min_epi8, _mm256_max_epi8);
+        break;
+      case TSDB_DATA_TYPE_UTINYINT:
+        VEC_AGG_MINMAX_AVX2_INT(uint8_t, 32, _mm256_min_epu8, _mm256_max_epu8);
+        break;
+      case TSDB_DATA_TYPE_SMALLINT:
+        VEC_AGG_MINMAX_AVX2_INT(int16_t, 16, _mm256_min_epi16, _mm256_max_epi16);
+        break;
+      case TSDB_DATA_TYPE_USMALLINT:
+        VEC_AGG_MINMAX_AVX2_INT(uint16_t, 16, _mm256_min_epu16, _mm256_max_epu16);
+        break;
+      case TSDB_DATA_TYPE_INT:
+        VEC_AGG_MINMAX_AVX2_INT(int32_t, 8, _mm256_min_epi32, _mm256_max_epi32);
+        break;
+      case TSDB_DATA_TYPE_UINT:
+        VEC_AGG_MINMAX_AVX2_INT(uint32_t, 8, _mm256_min_epu32, _mm256_max_epu32);
+        break;
+      case TSDB_DATA_TYPE_BIGINT:
+      case TSDB_DATA_TYPE_TIMESTAMP:
+        VEC_AGG_MINMAX_AVX2_INT(int64_t, 4, vecAggMinEpi64, vecAggMaxEpi64);
+        break;
+      case TSDB_DATA_TYPE_UBIGINT:
+        VEC_AGG_MINMAX_AVX2_INT(uint64_t, 4, vecAggMinEpu64, vecAggMaxEpu64);
+        break;
+      case TSDB_DATA_TYPE_FLOAT: {
+        __m256 vmin = _mm256_set1_ps(INFINITY), vmax = _mm256_set1_ps(-INFINITY);
+        for (; i + 8 <= end; i += 8) {
+          __m256 x = _mm256_loadu_ps((const float*)pData + i);
+          vmin = _mm256_min_ps(x, vmin);
+          vmax = _mm256_max_ps(x, vmax);
+        }
+        float lmin[8], lmax[8];
+        _mm256_storeu_ps(lmin, vmin);
+        _mm256_storeu_ps(lmax, vmax);
+        for (int32_t k = 0; k < 8; ++k) {
+          if (pAcc->min > lmin[k]) pAcc->min = lmin[k];
+          if (pAcc->max < lmax[k]) pAcc->max = lmax[k];
+        }
+        break;
+      }
+      case TSDB_DATA_TYPE_DOUBLE: {
+        __m256d vmin = _mm256_set1_pd(INFINITY), vmax = _mm256_set1_pd(-INFINITY);
+        for (; i + 4 <= end; i += 4) {
+          __m256d x = _mm256_loadu_pd((const double*)pData + i);
+          vmin = _mm256_min_pd(x, vmin);
+          vmax = _mm256_max_pd(x, vmax);
+        }
+        double lmin[4], lmax[4];
+        _mm256_storeu_pd(lmin, vmin);
+        _mm256_storeu_pd(lmax, vmax);
+        for (int32_t k = 0; k < 4; ++k) {
+          if (pAcc->min > lmin[k]) pAcc->min = lmin[k];
+          if (pAcc->max < lmax[k]) pAcc->max = lmax[k];
+        }
+        break;
+      }
+      default:
+        break;
+    }
+  }
+#endif
+
+  switch (type) {
+    case TSDB_DATA_TYPE_BOOL:
+    case TSDB_DATA_TYPE_TINYINT:
+      VEC_AGG_MINMAX_LOOP(int8_t, i, end);
+      break;
+    case TSDB_DATA_TYPE_UTINYINT:
+      VEC_AGG_MINMAX_LOOP(uint8_t, i, end);
+      break;
+    case TSDB_DATA_TYPE_SMALLINT:
+      VEC_AGG_MINMAX_LOOP(int16_t, i, end);
+      break;
+    case TSDB_DATA_TYPE_USMALLINT:
+      VEC_AGG_MINMAX_LOOP(uint16_t, i, end);
+      break;
+    case TSDB_DATA_TYPE_INT:
+      VEC_AGG_MINMAX_LOOP(int32_t, i, end);
+      break;
+    case TSDB_DATA_TYPE_UINT:
+      VEC_AGG_MINMAX_LOOP(uint32_t, i, end);
+      break;
+    case TSDB_DATA_TYPE_BIGINT:
+    case TSDB_DATA_TYPE_TIMESTAMP:
+      VEC_AGG_MINMAX_LOOP(int64_t, i, end);
+      break;
+    case TSDB_DATA_TYPE_UBIGINT:
+      VEC_AGG_MINMAX_LOOP(uint64_t, i, end);
+      break;
+    case TSDB_DATA_TYPE_FLOAT:
+      VEC_AGG_MINMAX_LOOP(float, i, end);
+      break;
+    case TSDB_DATA_TYPE_DOUBLE:
+      VEC_AGG_MINMAX_LOOP(double, i, end);
+      break;
+    default:
+      break;
+  }
+}
+
+// ---------------------------------------------------------------------------------------------------------------
+bool vecAggIsSupportedType(int32_t type) {
+  return type == TSDB_DATA_TYPE_BOOL || IS_INTEGER_TYPE(type) || IS_FLOAT_TYPE(type) ||
+         type == TSDB_DATA_TYPE_TIMESTAMP;
+}
+
+int32_t vecAggCountNotNull(const SColumnInfoData* pCol, int32_t start, int32_t numOfRows) {
+  if (!pCol->hasNull) {
+    return numOfRows;
+  }
+
+  int32_t end = start + numOfRows;
+  int32_t numOfElem = 0;
+  for (int32_t base = start & ~(VEC_AGG_WORD_BITS - 1); base < end; base += VEC_AGG_WORD_BITS) {
+    numOfElem += vecAggPopcount(vecAggValidMask(pCol->nullbitmap, base, start, end));
+  }
+  return numOfElem;
+}
+
+int32_t vecAggSumInt(const SColumnInfoData* pCol, int32_t start, int32_t numOfRows, int64_t* pSum) {
+  SVecAggAcc acc = {0};
+  int32_t    numOfElem = vecAggForEachRun(pCol, start, numOfRows, vecAggSumIntDense, &acc);
+  *pSum = acc.isum;
+  return numOfElem;
+}
+
+int32_t vecAggSumFloat(const SColumnInfoData* pCol, int32_t start, int32_t numOfRows, double* pSum) {
+  SVecAggAcc acc = {0};
+  int32_t    numOfElem = vecAggForEachRun(pCol, start, numOfRows, vecAggSumFloatDense, &acc);
+  *pSum = acc.dsum;
+  return numOfElem;
+}
+
+int32_t vecAggSumSquareInt(const SColumnInfoData* pCol, int32_t start, int32_t numOfRows, int64_t* pSum,
+                           int64_t* pSquareSum) {
+  SVecAggAcc acc = {0};
+  int32_t    numOfElem = vecAggForEachRun(pCol, start, numOfRows, vecAggSumSquareIntDense, &acc);
+  *pSum = acc.isum;
+  *pSquareSum = acc.isquare;
+  return numOfElem;
+}
+
+int32_t vecAggSumSquareFloat(const SColumnInfoData* pCol, int32_t start, int32_t numOfRows, double* pSum,
+                             double* pSquareSum) {
+  SVecAggAcc acc = {0};
+  int32_t    numOfElem = vecAggForEachRun(pCol, start, numOfRows, vecAggSumSquareFloatDense, &acc);
+  *pSum = acc.dsum;
+  *pSquareSum = acc.dsquare;
+  return numOfElem;
+}
+
+int32_t vecAggMinMax(const SColumnInfoData* pCol, int32_t start, int32_t numOfRows, double* pMin, double* pMax) {
+  SVecAggAcc acc = {.min = DBL_MAX, .max = -DBL_MAX};
+  int32_t    numOfElem = vecAggForEachRun(pCol, start, numOfRows, vecAggMinMaxDense, &acc);
+  *pMin = acc.min;
+  *pMax = acc.max;
+  return numOfElem;
+}
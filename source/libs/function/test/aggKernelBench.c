@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Micro benchmark of the aggregate kernels in tvecagg.c against the row by row loops they replace.
+ *   aggKernelBench [-r rows] [-n nullPercent] [-l loops]
+ */
+
+#include "os.h"
+#include "tdatablock.h"
+#include "tglobal.h"
+#include "tvecagg.h"
+
+#define TAOSPRINTF(format, ...) ((void)printf(format, ##__VA_ARGS__))
+
+static int32_t  gRows = 4096;
+static int32_t  gNullPercent = 10;
+static int32_t  gLoops = 2000;
+static uint64_t gSeed = 0x9E3779B97F4A7C15ULL;
+
+static uint64_t benchRand() {
+  gSeed ^= gSeed << 13;
+  gSeed ^= gSeed >> 7;
+  gSeed ^= gSeed << 17;
+  return gSeed;
+}
+
+static int32_t parseArgs(int32_t argc, char* argv[]) {
+  for (int32_t i = 1; i < argc - 1; i += 2) {
+    if (strcmp(argv[i], "-r") == 0) {
+      gRows = atoi(argv[i + 1]);
+    } else if (strcmp(argv[i], "-n") == 0) {
+      gNullPercent = atoi(argv[i + 1]);
+    } else if (strcmp(argv[i], "-l") == 0) {
+      gLoops = atoi(argv[i + 1]);
+    } else {
+      TAOSPRINTF("unknown option %s\n", argv[i]);
+      return -1;
+    }
+  }
+  return (gRows > 0 && gLoops > 0) ? 0 : -1;
+}
+
+static int32_t createColumn(SColumnInfoData* pCol, int32_t type) {
+  int32_t bytes = tDataTypes[type].bytes;
+  pCol->info.type = type;
+  pCol->info.bytes = bytes;
+  pCol->pData = taosMemoryMalloc((int64_t)gRows * bytes);
+  pCol->nullbitmap = taosMemoryCalloc(1, BitmapLen(gRows));
+  if (pCol->pData == NULL || pCol->nullbitmap == NULL) {
+    return terrno;
+  }
+
+  for (int32_t i = 0; i < gRows; ++i) {
+    uint64_t v = benchRand();
+    if (IS_FLOAT_TYPE(type)) {
+      double d = (double)(int32_t)v / 1000.0;
+      if (type == TSDB_DATA_TYPE_FLOAT) {
+        *(float*)(pCol->pData + i * bytes) = (float)d;
+      } else {
+        *(double*)(pCol->pData + i * bytes) = d;
+      }
+    } else {
+      // keep the 64 bits sums away from the wrap around, so the naive double sum can be compared
+      v = (bytes == sizeof(int64_t)) ? (v >> 20) : v;
+      (void)memcpy(pCol->pData + i * bytes, &v, bytes);
+    }
+
+    if ((int32_t)(benchRand() % 100) < gNullPercent) {
+      colDataSetNull_f(pCol->nullbitmap, i);
+      pCol->hasNull = true;
+    }
+  }
+  return TSDB_CODE_SUCCESS;
+}
+
+static void destroyColumn(SColumnInfoData* pCol) {
+  taosMemoryFreeClear(pCol->pData);
+  taosMemoryFreeClear(pCol->nullbitmap);
+}
+
+// the row by row loop the aggregate functions used before the kernels
+static int32_t naiveSum(const SColumnInfoData* pCol, double* pSum) {
+  int32_t numOfElem = 0;
+  double  sum = 0;
+  for (int32_t i = 0; i < gRows; ++i) {
+    if (pCol->hasNull && colDataIsNull_f(pCol->nullbitmap, i)) {
+      continue;
+    }
+
+    double v = 0;
+    GET_TYPED_DATA(v, double, pCol->info.type, pCol->pData + i * pCol->info.bytes);
+    sum += v;
+    numOfElem += 1;
+  }
+  *pSum = sum;
+  return numOfElem;
+}
+
+static int32_t kernelSum(const SColumnInfoData* pCol, double* pSum) {
+  if (IS_FLOAT_TYPE(pCol->info.type)) {
+    return vecAggSumFloat(pCol, 0, gRows, pSum);
+  }
+
+  int64_t isum = 0;
+  int32_t numOfElem = vecAggSumInt(pCol, 0, gRows, &isum);
+  *pSum = IS_UNSIGNED_NUMERIC_TYPE(pCol->info.type) ? (double)(uint64_t)isum : (double)isum;
+  return numOfElem;
+}
+
+static void benchType(int32_t type) {
+  SColumnInfoData col = {0};
+  if (createColumn(&col, type) != TSDB_CODE_SUCCESS) {
+    TAOSPRINTF("failed to create column\n");
+    destroyColumn(&col);
+    return;
+  }
+
+  double  naive = 0, vec = 0, lo = 0, hi = 0;
+  int32_t naiveElem = 0, vecElem = 0;
+
+  int64_t st = taosGetTimestampUs();
+  for (int32_t k = 0; k < gLoops; ++k) {
+    naiveElem = naiveSum(&col, &naive);
+  }
+  int64_t naiveUs = taosGetTimestampUs() - st;
+
+  st = taosGetTimestampUs();
+  for (int32_t k = 0; k < gLoops; ++k) {
+    vecElem = kernelSum(&col, &vec);
+  }
+  int64_t sumUs = taosGetTimestampUs() - st;
+
+  st = taosGetTimestampUs();
+  for (int32_t k = 0; k < gLoops; ++k) {
+    (void)vecAggMinMax(&col, 0, gRows, &lo, &hi);
+  }
+  int64_t minmaxUs = taosGetTimestampUs() - st;
+
+  st = taosGetTimestampUs();
+  for (int32_t k = 0; k < gLoops; ++k) {
+    (void)vecAggCountNotNull(&col, 0, gRows);
+  }
+  int64_t countUs = taosGetTimestampUs() - st;
+
+  bool same = (naiveElem == vecElem) && (fabs(naive - vec) <= 1e-9 * fabs(naive) + 1e-6);
+  TAOSPRINTF("%-18s naive sum:%8" PRId64 "us  kernel sum:%8" PRId64 "us  minmax:%8" PRId64 "us  count:%8" PRId64
+             "us  speedup:%6.2fx  %s\n",
+             tDataTypes[type].name, naiveUs, sumUs, minmaxUs, countUs, sumUs > 0 ? (double)naiveUs / sumUs : 0.0,
+             same ? "ok" : "MISMATCH");
+  destroyColumn(&col);
+}
+
+int main(int argc, char* argv[]) {
+  if (parseArgs(argc, argv) != 0) {
+    TAOSPRINTF("usage: %s [-r rows] [-n nullPercent] [-l loops]\n", argv[0]);
+    return -1;
+  }
+
+  char sse42 = 0, avx = 0, fma = 0;
+  (void)taosGetCpuInstructions(&sse42, &avx, &tsAVX2Supported, &fma, &tsAVX512Supported);
+  tsSIMDEnable = 1;
+  tsAVX512Enable = tsAVX512Supported;
+
+  TAOSPRINTF("rows:%d null:%d%% loops:%d avx2:%d avx512:%d\n", gRows, gNullPercent, gLoops, tsAVX2Supported,
+             tsAVX512Supported);
+
+  int32_t types[] = {TSDB_DATA_TYPE_TINYINT,  TSDB_DATA_TYPE_UTINYINT, TSDB_DATA_TYPE_SMALLINT,
+                     TSDB_DATA_TYPE_USMALLINT, TSDB_DATA_TYPE_INT,      TSDB_DATA_TYPE_UINT,
+                     TSDB_DATA_TYPE_BIGINT,   TSDB_DATA_TYPE_UBIGINT,  TSDB_DATA_TYPE_FLOAT,
+                     TSDB_DATA_TYPE_DOUBLE};
+  for (int32_t i = 0; i < tListLen(types); ++i) {
+    benchType(types[i]);
+  }
+  return 0;
+}
@@ -0,0 +1,281 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <float.h>
+#include <math.h>
+#include <string>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+#include "os.h"
+#include "tdatablock.h"
+#include "tglobal.h"
+#include "tvecagg.h"
+
+namespace {
+
+#define VA_ROWS 1000
+
+const int32_t vaTypes[] = {TSDB_DATA_TYPE_BOOL,     TSDB_DATA_TYPE_TINYINT, TSDB_DATA_TYPE_UTINYINT,
+                           TSDB_DATA_TYPE_SMALLINT, TSDB_DATA_TYPE_USMALLINT, TSDB_DATA_TYPE_INT,
+                           TSDB_DATA_TYPE_UINT,     TSDB_DATA_TYPE_BIGINT,  TSDB_DATA_TYPE_UBIGINT,
+                           TSDB_DATA_TYPE_TIMESTAMP, TSDB_DATA_TYPE_FLOAT,  TSDB_DATA_TYPE_DOUBLE};
+
+// the starts are off the 64 rows words of the null bitmap and off the SIMD widths, so are the lengths
+const int32_t vaStarts[] = {0, 1, 3, 63, 64, 65, 100};
+const int32_t vaLens[] = {0, 1, 7, 31, 64, 129, 333};
+
+// 0: no null bitmap at all, -1: a null bitmap without any null
+const int32_t vaNullPercents[] = {0, -1, 10, 50, 100};
+
+uint64_t vaRand(uint64_t* pSeed) {
+  *pSeed ^= *pSeed << 13;
+  *pSeed ^= *pSeed >> 7;
+  *pSeed ^= *pSeed << 17;
+  return *pSeed;
+}
+
+void createVaCol(SColumnInfoData* pCol, int32_t type, int32_t nullPercent, uint64_t seed) {
+  int32_t bytes = tDataTypes[type].bytes;
+  (void)memset(pCol, 0, sizeof(SColumnInfoData));
+  pCol->info.type = type;
+  pCol->info.bytes = bytes;
+  pCol->pData = (char*)taosMemoryMalloc((int64_t)VA_ROWS * bytes);
+  pCol->nullbitmap = (char*)taosMemoryCalloc(1, BitmapLen(VA_ROWS));
+  ASSERT_NE(pCol->pData, nullptr);
+  ASSERT_NE(pCol->nullbitmap, nullptr);
+  pCol->hasNull = (nullPercent != 0);
+
+  for (int32_t i = 0; i < VA_ROWS; ++i) {
+    uint64_t v = vaRand(&seed);
+    if (type == TSDB_DATA_TYPE_BOOL) {
+      *(int8_t*)(pCol->pData + i) = (int8_t)(v & 1);
+    } else if (type == TSDB_DATA_TYPE_FLOAT) {
+      *(float*)(pCol->pData + i * bytes) = (float)((double)(int32_t)v / 1000.0);
+    } else if (type == TSDB_DATA_TYPE_DOUBLE) {
+      *(double*)(pCol->pData + i * bytes) = (double)(int32_t)v / 1000.0;
+    } else {
+      // all the bits are random, the 64 bits sums and squares wrap
+      (void)memcpy(pCol->pData + i * bytes, &v, bytes);
+    }
+
+    if (nullPercent > 0 && (int32_t)(vaRand(&seed) % 100) < nullPercent) {
+      colDataSetNull_f(pCol->nullbitmap, i);
+    }
+  }
+}
+
+void destroyVaCol(SColumnInfoData* pCol) {
+  taosMemoryFreeClear(pCol->pData);
+  taosMemoryFreeClear(pCol->nullbitmap);
+}
+
+bool vaIsNull(const SColumnInfoData* pCol, int32_t row) {
+  return pCol->hasNull && colDataIsNull_f(pCol->nullbitmap, row);
+}
+
+// signed types are sign extended, unsigned ones zero extended
+int64_t vaIntVal(const SColumnInfoData* pCol, int32_t row) {
+  const char* p = pCol->pData + row * pCol->info.bytes;
+  switch (pCol->info.type) {
+    case TSDB_DATA_TYPE_BOOL:
+    case TSDB_DATA_TYPE_TINYINT:
+      return *(int8_t*)p;
+    case TSDB_DATA_TYPE_UTINYINT:
+      return *(uint8_t*)p;
+    case TSDB_DATA_TYPE_SMALLINT:
+      return *(int16_t*)p;
+    case TSDB_DATA_TYPE_USMALLINT:
+      return *(uint16_t*)p;
+    case TSDB_DATA_TYPE_INT:
+      return *(int32_t*)p;
+    case TSDB_DATA_TYPE_UINT:
+      return *(uint32_t*)p;
+    default:
+      return *(int64_t*)p;
+  }
+}
+
+double vaDoubleVal(const SColumnInfoData* pCol, int32_t row) {
+  const char* p = pCol->pData + row * pCol->info.bytes;
+  if (pCol->info.type == TSDB_DATA_TYPE_FLOAT) {
+    return *(float*)p;
+  } else if (pCol->info.type == TSDB_DATA_TYPE_DOUBLE) {
+    return *(double*)p;
+  } else if (pCol->info.type == TSDB_DATA_TYPE_UBIGINT) {
+    return (double)(uint64_t)vaIntVal(pCol, row);
+  }
+  return (double)vaIntVal(pCol, row);
+}
+
+// the plain row loop the kernels replace, the integer sums wrap in 64 bits
+typedef struct {
+  int32_t  count;
+  uint64_t isum;
+  uint64_t isquare;
+  double   dsum;
+  double   dsquare;
+  double   absSum;     // tolerance base of the float sums
+  double   absSquare;  // tolerance base of the float squares
+  double   min;
+  double   max;
+} SVaRef;
+
+SVaRef vaScalarRef(const SColumnInfoData* pCol, int32_t start, int32_t numOfRows) {
+  SVaRef ref = {0};
+  ref.min = DBL_MAX;
+  ref.max = -DBL_MAX;
+  for (int32_t i = start; i < start + numOfRows; ++i) {
+    if (vaIsNull(pCol, i)) {
+      continue;
+    }
+
+    ref.count += 1;
+    if (IS_FLOAT_TYPE(pCol->info.type)) {
+      double v = vaDoubleVal(pCol, i);
+      ref.dsum += v;
+      ref.dsquare += v * v;
+      ref.absSum += fabs(v);
+      ref.absSquare += v * v;
+    } else {
+      uint64_t v = (uint64_t)vaIntVal(pCol, i);
+      ref.isum += v;
+      ref.isquare += v * v;
+    }
+
+    double d = vaDoubleVal(pCol, i);
+    if (ref.min > d) ref.min = d;
+    if (ref.max < d) ref.max = d;
+  }
+  return ref;
+}
+
+void checkVaKernels(const SColumnInfoData* pCol, int32_t start, int32_t numOfRows) {
+  SVaRef ref = vaScalarRef(pCol, start, numOfRows);
+
+  // count
+  ASSERT_EQ(vecAggCountNotNull(pCol, start, numOfRows), ref.count);
+
+  // sum and avg
+  if (IS_FLOAT_TYPE(pCol->info.type)) {
+    double sum = 0;
+    ASSERT_EQ(vecAggSumFloat(pCol, start, numOfRows, &sum), ref.count);
+    ASSERT_NEAR(sum, ref.dsum, 1e-12 * ref.absSum + 1e-9);
+  } else {
+    int64_t sum = 0;
+    ASSERT_EQ(vecAggSumInt(pCol, start, numOfRows, &sum), ref.count);
+    ASSERT_EQ((uint64_t)sum, ref.isum);
+  }
+
+  // stddev
+  if (IS_FLOAT_TYPE(pCol->info.type)) {
+    double sum = 0, square = 0;
+    ASSERT_EQ(vecAggSumSquareFloat(pCol, start, numOfRows, &sum, &square), ref.count);
+    ASSERT_NEAR(sum, ref.dsum, 1e-12 * ref.absSum + 1e-9);
+    ASSERT_NEAR(square, ref.dsquare, 1e-12 * ref.absSquare + 1e-9);
+  } else {
+    int64_t sum = 0, square = 0;
+    ASSERT_EQ(vecAggSumSquareInt(pCol, start, numOfRows, &sum, &square), ref.count);
+    ASSERT_EQ((uint64_t)sum, ref.isum);
+    ASSERT_EQ((uint64_t)square, ref.isquare);
+  }
+
+  // spread
+  double min = 0, max = 0;
+  ASSERT_EQ(vecAggMinMax(pCol, start, numOfRows, &min, &max), ref.count);
+  ASSERT_EQ(min, ref.min);
+  ASSERT_EQ(max, ref.max);
+}
+
+class VecAggTest : public ::testing::TestWithParam<bool> {
+ protected:
+  void SetUp() override {
+    simdEnable = tsSIMDEnable;
+    tsSIMDEnable = GetParam() ? 1 : 0;
+  }
+
+  void TearDown() override { tsSIMDEnable = simdEnable; }
+
+  char simdEnable = 0;
+};
+
+}  // namespace
+
+TEST_P(VecAggTest, sameAsScalarLoop) {
+  for (int32_t t = 0; t < tListLen(vaTypes); ++t) {
+    for (int32_t n = 0; n < tListLen(vaNullPercents); ++n) {
+      SColumnInfoData col;
+      createVaCol(&col, vaTypes[t], vaNullPercents[n], 0x9E3779B97F4A7C15ULL + t * 131 + n);
+      for (int32_t s = 0; s < tListLen(vaStarts); ++s) {
+        for (int32_t l = 0; l < tListLen(vaLens); ++l) {
+          SCOPED_TRACE(std::string(tDataTypes[vaTypes[t]].name) + " null:" + std::to_string(vaNullPercents[n]) +
+                       " start:" + std::to_string(vaStarts[s]) + " rows:" + std::to_string(vaLens[l]));
+          checkVaKernels(&col, vaStarts[s], vaLens[l]);
+        }
+      }
+      // up to the last row, the tail is shorter than any SIMD width
+      SCOPED_TRACE(std::string(tDataTypes[vaTypes[t]].name) + " null:" + std::to_string(vaNullPercents[n]) + " tail");
+      checkVaKernels(&col, 5, VA_ROWS - 5);
+      destroyVaCol(&col);
+    }
+  }
+}
+
+// the squares of the integers are summed in int64, which is exact past the 53 bits of a double
+TEST_P(VecAggTest, exactIntSquareSum) {
+  const int64_t v = 3037000499LL;  // the largest value whose square fits in int64
+  const int64_t square = 9223372030926249001LL;
+  ASSERT_NE((int64_t)((double)v * (double)v), square);
+
+  SColumnInfoData col;
+  createVaCol(&col, TSDB_DATA_TYPE_BIGINT, 0, 1);
+  (void)memset(col.pData, 0, VA_ROWS * sizeof(int64_t));
+  *(int64_t*)(col.pData + 50 * sizeof(int64_t)) = -v;
+
+  int64_t sum = 0, squareSum = 0;
+  ASSERT_EQ(vecAggSumSquareInt(&col, 3, 129, &sum, &squareSum), 129);
+  ASSERT_EQ(sum, -v);
+  ASSERT_EQ(squareSum, square);
+  destroyVaCol(&col);
+
+  // the 32 bits types are widened before the multiplication, two squares of them are beyond a double already
+  createVaCol(&col, TSDB_DATA_TYPE_INT, 0, 1);
+  (void)memset(col.pData, 0, VA_ROWS * sizeof(int32_t));
+  *(int32_t*)(col.pData + 37 * sizeof(int32_t)) = INT32_MAX;
+  *(int32_t*)(col.pData + 38 * sizeof(int32_t)) = INT32_MIN + 1;
+
+  ASSERT_EQ(vecAggSumSquareInt(&col, 1, 129, &sum, &squareSum), 129);
+  ASSERT_EQ(sum, 0);
+  ASSERT_EQ(squareSum, 2 * (int64_t)INT32_MAX * INT32_MAX);
+  destroyVaCol(&col);
+}
+
+INSTANTIATE_TEST_CASE_P(simd, VecAggTest, ::testing::Values(true, false));
+
+int main(int argc, char** argv) {
+  char sse42 = 0, avx = 0, fma = 0;
+  (void)taosGetCpuInstructions(&sse42, &avx, &tsAVX2Supported, &fma, &tsAVX512Supported);
+  tsAVX512Enable = tsAVX512Supported;
+
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+
+#pragma GCC diagnostic pop
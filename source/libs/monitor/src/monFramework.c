@@ -77,6 +77,9 @@ extern char* tsMonFwUri;
 #define HAS_MNODE DNODE_TABLE":has_mnode"
 #define HAS_QNODE DNODE_TABLE":has_qnode"
 #define HAS_SNODE DNODE_TABLE":has_snode"
+#define RES_CACHE_HIT DNODE_TABLE":res_cache_hit"
+#define RES_CACHE_MISS DNODE_TABLE":res_cache_miss"
+#define RES_CACHE_SIZE DNODE_TABLE":res_cache_size"
 #define DNODE_LOG_ERROR DNODE_TABLE":error_log_count"
 #define DNODE_LOG_INFO DNODE_TABLE":info_log_count"
 #define DNODE_LOG_DEBUG DNODE_TABLE":debug_log_count"
@@ -111,8 +114,9 @@ void monInitMonitorFW(){
                            MEM_TOTAL, DISK_ENGINE, DISK_USED, DISK_TOTAL, NET_IN,
                            NET_OUT, IO_READ, IO_WRITE, IO_READ_DISK, IO_WRITE_DISK, /*ERRORS,*/
                            VNODES_NUM, MASTERS, HAS_MNODE, HAS_QNODE, HAS_SNODE,
-                           DNODE_LOG_ERROR, DNODE_LOG_INFO, DNODE_LOG_DEBUG, DNODE_LOG_TRACE};
-  for(int32_t i = 0; i < 25; i++){
+                           DNODE_LOG_ERROR, DNODE_LOG_INFO, DNODE_LOG_DEBUG, DNODE_LOG_TRACE,
+                           RES_CACHE_HIT, RES_CACHE_MISS, RES_CACHE_SIZE};
+  for(int32_t i = 0; i < 28; i++){
     gauge= taos_gauge_new(dnodes_gauges[i], "",  dnodes_label_count, dnodes_sample_labels);
     if(taos_collector_registry_register_metric(gauge) == 1){
       if (taos_counter_destroy(gauge) != 0) {
@@ -484,6 +488,15 @@ void monGenDnodeInfoTable(SMonInfo *pMonitor) {
   metric = taosHashGet(tsMonitor.metrics, MASTERS, strlen(MASTERS));
   if (metric != NULL) (void)taos_gauge_set(*metric, pStat->masterNum, sample_labels);
 
+  metric = taosHashGet(tsMonitor.metrics, RES_CACHE_HIT, strlen(RES_CACHE_HIT));
+  if (metric != NULL) (void)taos_gauge_set(*metric, pStat->resCacheHit, sample_labels);
+
+  metric = taosHashGet(tsMonitor.metrics, RES_CACHE_MISS, strlen(RES_CACHE_MISS));
+  if (metric != NULL) (void)taos_gauge_set(*metric, pStat->resCacheMiss, sample_labels);
+
+  metric = taosHashGet(tsMonitor.metrics, RES_CACHE_SIZE, strlen(RES_CACHE_SIZE));
+  if (metric != NULL) (void)taos_gauge_set(*metric, pStat->resCacheSize, sample_labels);
+
   metric = taosHashGet(tsMonitor.metrics, HAS_MNODE, strlen(HAS_MNODE));
   if (metric != NULL) (void)taos_gauge_set(*metric, pInfo->has_mnode, sample_labels);
 
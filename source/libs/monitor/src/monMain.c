@@ -494,6 +494,9 @@ static void monGenDnodeJson(SMonInfo *pMonitor) {
     uError("failed to add req_insert_batch_success");
   if (tjsonAddDoubleToObject(pJson, "req_insert_batch_rate", req_insert_batch_rate) != 0)
     uError("failed to add req_insert_batch_rate");
+  if (tjsonAddDoubleToObject(pJson, "res_cache_hit", pStat->resCacheHit) != 0) uError("failed to add res_cache_hit");
+  if (tjsonAddDoubleToObject(pJson, "res_cache_miss", pStat->resCacheMiss) != 0) uError("failed to add res_cache_miss");
+  if (tjsonAddDoubleToObject(pJson, "res_cache_size", pStat->resCacheSize) != 0) uError("failed to add res_cache_size");
   if (tjsonAddDoubleToObject(pJson, "errors", pStat->errors) != 0) uError("failed to add errors");
   if (tjsonAddDoubleToObject(pJson, "vnodes_num", pStat->totalVnodes) != 0) uError("failed to add vnodes_num");
   if (tjsonAddDoubleToObject(pJson, "masters", pStat->masterNum) != 0) uError("failed to add masters");
@@ -102,6 +102,9 @@ static int32_t exprNodeCopy(const SExprNode* pSrc, SExprNode* pDst) {
   COPY_OBJECT_FIELD(resType, sizeof(SDataType));
   COPY_CHAR_ARRAY_FIELD(aliasName);
   COPY_CHAR_ARRAY_FIELD(userAlias);
+  COPY_SCALAR_FIELD(asAlias);
+  COPY_SCALAR_FIELD(asParam);
+  COPY_SCALAR_FIELD(asPosition);
   COPY_SCALAR_FIELD(projIdx);
   return TSDB_CODE_SUCCESS;
 }
@@ -227,6 +230,8 @@ static int32_t functionNodeCopy(const SFunctionNode* pSrc, SFunctionNode* pDst)
   COPY_SCALAR_FIELD(pkBytes);
   COPY_SCALAR_FIELD(hasOriginalFunc);
   COPY_SCALAR_FIELD(originalFuncId);
+  COPY_SCALAR_FIELD(trimType);
+  COPY_SCALAR_FIELD(dual);
   return TSDB_CODE_SUCCESS;
 }
 
@@ -499,6 +504,8 @@ static int32_t logicScanCopy(const SScanLogicNode* pSrc, SScanLogicNode* pDst) {
   COPY_SCALAR_FIELD(paraTablesSort);
   COPY_SCALAR_FIELD(smallDataTsSort);
   COPY_SCALAR_FIELD(needSplit);
+  COPY_SCALAR_FIELD(tableSplitIdx);
+  COPY_SCALAR_FIELD(tableSplitNum);
   return TSDB_CODE_SUCCESS;
 }
 
@@ -526,6 +533,7 @@ static int32_t logicJoinCopy(const SJoinLogicNode* pSrc, SJoinLogicNode* pDst) {
   COPY_SCALAR_FIELD(grpJoin);
   COPY_SCALAR_FIELD(hashJoinHint);
   COPY_SCALAR_FIELD(batchScanHint);
+  COPY_OBJECT_FIELD(inputStat, sizeof(pSrc->inputStat));
   CLONE_NODE_FIELD(pLeftOnCond);
   CLONE_NODE_FIELD(pRightOnCond);
   COPY_SCALAR_FIELD(timeRangeTarget);
@@ -752,6 +760,8 @@ static int32_t physiTableScanCopy(const STableScanPhysiNode* pSrc, STableScanPhy
   COPY_SCALAR_FIELD(needCountEmptyTable);
   COPY_SCALAR_FIELD(paraTablesSort);
   COPY_SCALAR_FIELD(smallDataTsSort);
+  COPY_SCALAR_FIELD(tableSplitIdx);
+  COPY_SCALAR_FIELD(tableSplitNum);
   return TSDB_CODE_SUCCESS;
 }
 
@@ -846,21 +856,49 @@ static int32_t selectStmtCopy(const SSelectStmt* pSrc, SSelectStmt* pDst) {
   CLONE_NODE_FIELD(pFromTable);
   CLONE_NODE_FIELD(pWhere);
   CLONE_NODE_LIST_FIELD(pPartitionByList);
+  CLONE_NODE_LIST_FIELD(pTags);
+  CLONE_NODE_FIELD(pSubtable);
   CLONE_NODE_FIELD(pWindow);
   CLONE_NODE_LIST_FIELD(pGroupByList);
   CLONE_NODE_FIELD(pHaving);
+  CLONE_NODE_FIELD(pRange);
+  CLONE_NODE_FIELD(pEvery);
+  CLONE_NODE_FIELD(pFill);
   CLONE_NODE_LIST_FIELD(pOrderByList);
   CLONE_NODE_FIELD_EX(pLimit, SLimitNode*);
-  CLONE_NODE_FIELD_EX(pLimit, SLimitNode*);
+  CLONE_NODE_FIELD_EX(pSlimit, SLimitNode*);
+  COPY_OBJECT_FIELD(timeRange, sizeof(STimeWindow));
   COPY_CHAR_ARRAY_FIELD(stmtName);
   COPY_SCALAR_FIELD(precision);
+  COPY_SCALAR_FIELD(selectFuncNum);
+  COPY_SCALAR_FIELD(returnRows);
   COPY_SCALAR_FIELD(isSubquery);
   COPY_SCALAR_FIELD(isEmptyResult);
   COPY_SCALAR_FIELD(timeLineResMode);
   COPY_SCALAR_FIELD(timeLineFromOrderBy);
   COPY_SCALAR_FIELD(timeLineCurMode);
+  COPY_SCALAR_FIELD(lastProcessByRowFuncId);
   COPY_SCALAR_FIELD(hasAggFuncs);
   COPY_SCALAR_FIELD(hasRepeatScanFuncs);
+  COPY_SCALAR_FIELD(hasIndefiniteRowsFunc);
+  COPY_SCALAR_FIELD(hasMultiRowsFunc);
+  COPY_SCALAR_FIELD(hasSelectFunc);
+  COPY_SCALAR_FIELD(hasSelectValFunc);
+  COPY_SCALAR_FIELD(hasOtherVectorFunc);
+  COPY_SCALAR_FIELD(hasUniqueFunc);
+  COPY_SCALAR_FIELD(hasTailFunc);
+  COPY_SCALAR_FIELD(hasInterpFunc);
+  COPY_SCALAR_FIELD(hasInterpPseudoColFunc);
+  COPY_SCALAR_FIELD(hasLastRowFunc);
+  COPY_SCALAR_FIELD(hasLastFunc);
+  COPY_SCALAR_FIELD(hasTimeLineFunc);
+  COPY_SCALAR_FIELD(hasCountFunc);
+  COPY_SCALAR_FIELD(hasUdaf);
+  COPY_SCALAR_FIELD(hasStateKey);
+  COPY_SCALAR_FIELD(onlyHasKeepOrderFunc);
+  COPY_SCALAR_FIELD(groupSort);
+  COPY_SCALAR_FIELD(tagScan);
+  COPY_SCALAR_FIELD(joinContains);
   CLONE_NODE_LIST_FIELD(pHint);
   return TSDB_CODE_SUCCESS;
 }
@@ -31,6 +31,10 @@ typedef struct SInsertParseContext {
   bool           needTableTagVal;
   bool           needRequest;  // whether or not request server
   bool           isStmtBind;    // whether is stmt bind
+  // super table of the last USING clause, reused by the following child tables of the same statement
+  SName          lastUsingTableName;
+  STableMeta*    pLastUsingTableMeta;
+  SNode*         pLastUsingTagCond;
 } SInsertParseContext;
 
 typedef int32_t (*_row_append_fn_t)(SMsgBuf* pMsgBuf, const void* value, int32_t len, void* param);
@@ -1284,16 +1288,55 @@ static int32_t preParseUsingTableName(SInsertParseContext* pCxt, SVnodeModifyOpS
   return insCreateSName(&pStmt->usingTableName, pTbName, pCxt->pComCxt->acctId, pCxt->pComCxt->db, &pCxt->msg);
 }
 
+static bool isLastUsingTable(SInsertParseContext* pCxt, const SName* pName) {
+  const SName* pLast = &pCxt->lastUsingTableName;
+  return NULL != pCxt->pLastUsingTableMeta && pLast->acctId == pName->acctId &&
+         0 == strcmp(pLast->tname, pName->tname) && 0 == strcmp(pLast->dbname, pName->dbname);
+}
+
+static int32_t getLastUsingTableSchema(SInsertParseContext* pCxt, SVnodeModifyOpStmt* pStmt) {
+  int32_t code = cloneTableMeta(pCxt->pLastUsingTableMeta, &pStmt->pTableMeta);
+  if (TSDB_CODE_SUCCESS == code) {
+    code = nodesCloneNode(pCxt->pLastUsingTagCond, &pStmt->pTagCond);
+  }
+  return code;
+}
+
+static int32_t saveLastUsingTableSchema(SInsertParseContext* pCxt, SVnodeModifyOpStmt* pStmt) {
+  taosMemoryFreeClear(pCxt->pLastUsingTableMeta);
+  nodesDestroyNode(pCxt->pLastUsingTagCond);
+  pCxt->pLastUsingTagCond = NULL;
+
+  int32_t code = nodesCloneNode(pStmt->pTagCond, &pCxt->pLastUsingTagCond);
+  if (TSDB_CODE_SUCCESS == code) {
+    code = cloneTableMeta(pStmt->pTableMeta, &pCxt->pLastUsingTableMeta);
+  }
+  if (TSDB_CODE_SUCCESS == code) {
+    pCxt->lastUsingTableName = pStmt->usingTableName;
+  }
+  return code;
+}
+
 static int32_t getUsingTableSchema(SInsertParseContext* pCxt, SVnodeModifyOpStmt* pStmt) {
   if (pCxt->forceUpdate) {
     pCxt->missCache = true;
     return TSDB_CODE_SUCCESS;
   }
 
-  int32_t code = checkAuth(pCxt->pComCxt, &pStmt->usingTableName, &pCxt->missCache, &pStmt->pTagCond);
-  if (TSDB_CODE_SUCCESS == code && !pCxt->missCache) {
-    bool bUsingTable = true;
-    code = getTableMeta(pCxt, &pStmt->usingTableName, &pStmt->pTableMeta, &pCxt->missCache, bUsingTable);
+  int32_t code = TSDB_CODE_SUCCESS;
+  if (isLastUsingTable(pCxt, &pStmt->usingTableName)) {
+    // the auth and the meta of the super table do not change within one statement, only the vgroup of the child
+    // table has to be looked up again
+    code = getLastUsingTableSchema(pCxt, pStmt);
+  } else {
+    code = checkAuth(pCxt->pComCxt, &pStmt->usingTableName, &pCxt->missCache, &pStmt->pTagCond);
+    if (TSDB_CODE_SUCCESS == code && !pCxt->missCache) {
+      bool bUsingTable = true;
+      code = getTableMeta(pCxt, &pStmt->usingTableName, &pStmt->pTableMeta, &pCxt->missCache, bUsingTable);
+    }
+    if (TSDB_CODE_SUCCESS == code && !pCxt->missCache) {
+      code = saveLastUsingTableSchema(pCxt, pStmt);
+    }
   }
   if (TSDB_CODE_SUCCESS == code && !pCxt->missCache) {
     code = getTargetTableVgroup(pCxt->pComCxt, pStmt, true, &pCxt->missCache);
@@ -2018,6 +2061,163 @@ static int32_t parseOneStbRow(SInsertParseContext* pCxt, SVnodeModifyOpStmt* pSt
   return code;
 }
 
+static FORCE_INLINE const char* skipValueSpace(const char* p) {
+  while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r' || *p == '\f') {
+    ++p;
+  }
+  return p;
+}
+
+// the fast path only takes a value that is directly followed by the column separator or the end of the row
+static FORCE_INLINE bool isPlainValueEnd(const char* p) {
+  p = skipValueSpace(p);
+  return *p == ',' || *p == ')';
+}
+
+// decimal digits without a leading zero, at most 18 of them so the value always fits in int64
+static int32_t scanPlainDigits(const char* p, uint64_t* pVal) {
+  uint64_t v = 0;
+  int32_t  n = 0;
+  while (p[n] >= '0' && p[n] <= '9') {
+    if (n == 18) {
+      return 0;
+    }
+    v = v * 10 + (p[n] - '0');
+    ++n;
+  }
+  if (n > 1 && p[0] == '0') {
+    return 0;
+  }
+  *pVal = v;
+  return n;
+}
+
+static bool isPlainIntegerInRange(int8_t type, int64_t v) {
+  switch (type) {
+    case TSDB_DATA_TYPE_TINYINT:
+      return IS_VALID_TINYINT(v);
+    case TSDB_DATA_TYPE_SMALLINT:
+      return IS_VALID_SMALLINT(v);
+    case TSDB_DATA_TYPE_INT:
+      return IS_VALID_INT(v);
+    case TSDB_DATA_TYPE_UTINYINT:
+      return v <= UINT8_MAX;
+    case TSDB_DATA_TYPE_USMALLINT:
+      return v <= UINT16_MAX;
+    case TSDB_DATA_TYPE_UINT:
+      return v <= UINT32_MAX;
+    default:
+      return true;
+  }
+}
+
+// Parse the next value of a VALUES row straight from the sql text when it is a plain literal: null, a decimal
+// integer or timestamp, a float without exponent, or a quoted string without escapes. Such values make up almost
+// all of the bulk inserts and do not need the tokenizer. Anything else, including every value that would raise an
+// error, is left to parseValueToken with *pSql untouched, so both paths accept and reject the same input.
+static int32_t parsePlainValue(SInsertParseContext* pCxt, const char** pSql, SSchema* pSchema, int16_t timePrec,
+                               SColVal* pVal, bool* pParsed) {
+  const char* p = skipValueSpace(*pSql);
+  const char* pEnd = NULL;
+  int8_t      type = pSchema->type;
+
+  *pParsed = false;
+  if ((p[0] == 'n' || p[0] == 'N') && 0 == strncasecmp(p, "null", 4) && isPlainValueEnd(p + 4)) {
+    if (TSDB_DATA_TYPE_TIMESTAMP == type && PRIMARYKEY_TIMESTAMP_COL_ID == pSchema->colId) {
+      return TSDB_CODE_SUCCESS;
+    }
+    pVal->flag = CV_FLAG_NULL;
+    *pSql = p + 4;
+    *pParsed = true;
+    return TSDB_CODE_SUCCESS;
+  }
+
+  switch (type) {
+    case TSDB_DATA_TYPE_TINYINT:
+    case TSDB_DATA_TYPE_SMALLINT:
+    case TSDB_DATA_TYPE_INT:
+    case TSDB_DATA_TYPE_BIGINT:
+    case TSDB_DATA_TYPE_UTINYINT:
+    case TSDB_DATA_TYPE_USMALLINT:
+    case TSDB_DATA_TYPE_UINT:
+    case TSDB_DATA_TYPE_UBIGINT:
+    case TSDB_DATA_TYPE_TIMESTAMP: {
+      bool     neg = (p[0] == '-' && IS_SIGNED_NUMERIC_TYPE(type));
+      uint64_t uv = 0;
+      int32_t  n = scanPlainDigits(p + neg, &uv);
+      int64_t  v = neg ? -(int64_t)uv : (int64_t)uv;
+      if (0 == n || !isPlainValueEnd(p + neg + n) || !isPlainIntegerInRange(type, v)) {
+        return TSDB_CODE_SUCCESS;
+      }
+      pVal->value.val = v;
+      pEnd = p + neg + n;
+      break;
+    }
+    case TSDB_DATA_TYPE_FLOAT:
+    case TSDB_DATA_TYPE_DOUBLE: {
+      const char* q = p + (p[0] == '-');
+      const char* pDigits = q;
+      while (*q >= '0' && *q <= '9') ++q;
+      if (q == pDigits) {
+        return TSDB_CODE_SUCCESS;
+      }
+      if (*q == '.') {
+        ++q;
+        while (*q >= '0' && *q <= '9') ++q;
+      }
+      if (!isPlainValueEnd(q)) {
+        return TSDB_CODE_SUCCESS;
+      }
+
+      char* pConvEnd = NULL;
+      errno = 0;
+      double dv = taosStr2Double(p, &pConvEnd);
+      if (pConvEnd != q || errno == ERANGE || isinf(dv) || isnan(dv)) {
+        return TSDB_CODE_SUCCESS;
+      }
+      if (TSDB_DATA_TYPE_FLOAT == type) {
+        if (dv > FLT_MAX || dv < -FLT_MAX) {
+          return TSDB_CODE_SUCCESS;
+        }
+        float f = dv;
+        memcpy(&pVal->value.val, &f, sizeof(f));
+      } else {
+        memcpy(&pVal->value.val, &dv, sizeof(dv));
+      }
+      pEnd = q;
+      break;
+    }
+    case TSDB_DATA_TYPE_BINARY:
+    case TSDB_DATA_TYPE_NCHAR: {
+      char delim = p[0];
+      if (delim != '\'' && delim != '"') {
+        return TSDB_CODE_SUCCESS;
+      }
+      const char* q = p + 1;
+      while (*q != delim && *q != '\\' && *q != '\0') ++q;
+      if (*q != delim || q[1] == delim || q + 1 - p >= TSDB_MAX_BYTES_PER_ROW || !isPlainValueEnd(q + 1)) {
+        return TSDB_CODE_SUCCESS;
+      }
+
+      SToken token = {.z = (char*)p + 1, .n = q - p - 1, .type = TK_NK_STRING};
+      int32_t code = parseValueTokenImpl(pCxt, pSql, &token, pSchema, timePrec, pVal);
+      if (TSDB_CODE_SUCCESS != code) {
+        return code;
+      }
+      *pSql = q + 1;
+      *pParsed = true;
+      return TSDB_CODE_SUCCESS;
+    }
+    default:
+      return TSDB_CODE_SUCCESS;
+  }
+
+  pVal->flag = CV_FLAG_VALUE;
+  *pSql = pEnd;
+  *pParsed = true;
+  return TSDB_CODE_SUCCESS;
+}
+
 static int parseOneRow(SInsertParseContext* pCxt, const char** pSql, STableDataCxt* pTableCxt, bool* pGotRow,
                        SToken* pToken) {
   SBoundColInfo* pCols = &pTableCxt->boundColsInfo;
@@ -2026,36 +2226,46 @@ static int parseOneRow(SInsertParseContext* pCxt, const char** pSql, STableDataC
   int32_t code = TSDB_CODE_SUCCESS;
   // 1. set the parsed value from sql string
   for (int i = 0; i < pCols->numOfBound && TSDB_CODE_SUCCESS == code; ++i) {
-    const char* pOrigSql = *pSql;
-    bool        ignoreComma = false;
-    NEXT_TOKEN_WITH_PREV_EXT(*pSql, *pToken, &ignoreComma);
-    if (ignoreComma) {
-      code = buildSyntaxErrMsg(&pCxt->msg, "invalid data or symbol", pOrigSql);
-      break;
-    }
-
     SSchema* pSchema = &pSchemas[pCols->pColIndex[i]];
     SColVal* pVal = taosArrayGet(pTableCxt->pValues, pCols->pColIndex[i]);
+    bool     parsed = false;
 
-    if (pToken->type == TK_NK_QUESTION) {
-      pCxt->isStmtBind = true;
-      if (NULL == pCxt->pComCxt->pStmtCb) {
-        code = buildSyntaxErrMsg(&pCxt->msg, "? only used in stmt", pToken->z);
-        break;
-      }
-    } else {
-      if (TK_NK_RP == pToken->type) {
-        code = generateSyntaxErrMsg(&pCxt->msg, TSDB_CODE_PAR_INVALID_COLUMNS_NUM);
+    if (!pCxt->isStmtBind) {
+      code = parsePlainValue(pCxt, pSql, pSchema, getTableInfo(pTableCxt->pMeta).precision, pVal, &parsed);
+      if (TSDB_CODE_SUCCESS != code) {
         break;
       }
+    }
 
-      if (pCxt->isStmtBind) {
-        code = buildInvalidOperationMsg(&pCxt->msg, "stmt bind param does not support normal value in sql");
+    if (!parsed) {
+      const char* pOrigSql = *pSql;
+      bool        ignoreComma = false;
+      NEXT_TOKEN_WITH_PREV_EXT(*pSql, *pToken, &ignoreComma);
+      if (ignoreComma) {
+        code = buildSyntaxErrMsg(&pCxt->msg, "invalid data or symbol", pOrigSql);
         break;
       }
 
-      if (TSDB_CODE_SUCCESS == code) {
-        code = parseValueToken(pCxt, pSql, pToken, pSchema, getTableInfo(pTableCxt->pMeta).precision, pVal);
+      if (pToken->type == TK_NK_QUESTION) {
+        pCxt->isStmtBind = true;
+        if (NULL == pCxt->pComCxt->pStmtCb) {
+          code = buildSyntaxErrMsg(&pCxt->msg, "? only used in stmt", pToken->z);
+          break;
+        }
+      } else {
+        if (TK_NK_RP == pToken->type) {
+          code = generateSyntaxErrMsg(&pCxt->msg, TSDB_CODE_PAR_INVALID_COLUMNS_NUM);
+          break;
+        }
+
+        if (pCxt->isStmtBind) {
+          code = buildInvalidOperationMsg(&pCxt->msg, "stmt bind param does not support normal value in sql");
+          break;
+        }
+
+        if (TSDB_CODE_SUCCESS == code) {
+          code = parseValueToken(pCxt, pSql, pToken, pSchema, getTableInfo(pTableCxt->pMeta).precision, pVal);
+        }
       }
     }
 
@@ -2144,15 +2354,265 @@ static int32_t parseValuesClause(SInsertParseContext* pCxt, SVnodeModifyOpStmt*
   return code;
 }
 
-static int32_t parseCsvFile(SInsertParseContext* pCxt, SVnodeModifyOpStmt* pStmt, SRowsDataContext rowsDataCxt,
-                            int32_t* pNumOfRows) {
+#define CSV_PARSE_BLOCK_LINES      (64 * 1024)
+#define CSV_MIN_LINES_PER_THREAD   1024
+
+// the lines of the csv file read in one round, kept in one buffer so that they can be parsed by several threads
+typedef struct SCsvBlock {
+  char*   pBuf;
+  int64_t len;
+  int64_t cap;
+  SArray* pOffsets;    // SArray<int64_t>, offset of each line in pBuf
+  bool    firstLine;   // line 0 is the first line of the file, it is skipped if it can not be parsed
+} SCsvBlock;
+
+// one chunk of lines parsed into private row and value arrays, meta, schema and bound columns are shared
+typedef struct SCsvParseTask {
+  SInsertParseContext* pCxt;
+  STableDataCxt        tableCxt;
+  SSubmitTbData        tbData;
+  char**               pLines;
+  int32_t              numOfLines;
+  int32_t              numOfRows;
+  bool                 firstLine;
+  int32_t              code;
+} SCsvParseTask;
+
+static int32_t readCsvBlock(SVnodeModifyOpStmt* pStmt, int32_t maxLines, SCsvBlock* pBlock, bool* pFirstLine,
+                            bool* pEof) {
+  char*   pLine = NULL;
+  int64_t readLen = 0;
+  int32_t code = TSDB_CODE_SUCCESS;
+
+  pBlock->len = 0;
+  pBlock->firstLine = false;
+  taosArrayClear(pBlock->pOffsets);
+  while (taosArrayGetSize(pBlock->pOffsets) < maxLines && (readLen = taosGetLineFile(pStmt->fp, &pLine)) != -1) {
+    pStmt->fileReadBytes += readLen;
+    if (('\r' == pLine[readLen - 1]) || ('\n' == pLine[readLen - 1])) {
+      pLine[--readLen] = '\0';
+    }
+    if (readLen == 0) {
+      *pFirstLine = false;
+      continue;
+    }
+
+    if (pBlock->len + readLen + 1 > pBlock->cap) {
+      int64_t cap = TMAX(pBlock->cap * 2, pBlock->len + readLen + 1);
+      char*   pBuf = taosMemoryRealloc(pBlock->pBuf, cap);
+      if (NULL == pBuf) {
+        code = terrno;
+        break;
+      }
+      pBlock->pBuf = pBuf;
+      pBlock->cap = cap;
+    }
+    if (NULL == taosArrayPush(pBlock->pOffsets, &pBlock->len)) {
+      code = terrno;
+      break;
+    }
+    (void)memcpy(pBlock->pBuf + pBlock->len, pLine, readLen + 1);
+    pBlock->len += readLen + 1;
+    if (*pFirstLine) {
+      pBlock->firstLine = true;
+      *pFirstLine = false;
+    }
+  }
+  *pEof = (readLen == -1);
+  taosMemoryFree(pLine);
+  return code;
+}
+
+static void* csvParseTaskFp(void* param) {
+  SCsvParseTask* pTask = (SCsvParseTask*)param;
+  for (int32_t i = 0; i < pTask->numOfLines && TSDB_CODE_SUCCESS == pTask->code; ++i) {
+    SToken token;
+    bool   gotRow = false;
+    char*  pLine = pTask->pLines[i];
+    (void)strtolower(pLine, pLine);
+    const char* pRow = pLine;
+    int32_t     code = parseOneRow(pTask->pCxt, &pRow, &pTask->tableCxt, &gotRow, &token);
+    if (TSDB_CODE_SUCCESS != code && 0 == i && pTask->firstLine) {
+      continue;
+    }
+    pTask->code = code;
+    if (TSDB_CODE_SUCCESS == code && gotRow) {
+      pTask->numOfRows++;
+    }
+  }
+  return NULL;
+}
+
+static int32_t initCsvParseTask(SInsertParseContext* pCxt, STableDataCxt* pTableCxt, SCsvParseTask* pTask) {
+  pTask->pCxt = taosMemoryMalloc(sizeof(SInsertParseContext) + pCxt->msg.len + 1);
+  if (NULL == pTask->pCxt) {
+    return terrno;
+  }
+  *pTask->pCxt = *pCxt;
+  pTask->pCxt->msg.buf = (char*)(pTask->pCxt + 1);
+  pTask->pCxt->msg.buf[0] = '\0';
+  pTask->pCxt->pLastUsingTableMeta = NULL;
+  pTask->pCxt->pLastUsingTagCond = NULL;
+
+  pTask->tableCxt = *pTableCxt;
+  pTask->tableCxt.pData = &pTask->tbData;
+  pTask->tableCxt.lastKey = (SRowKey){.ts = INT64_MIN};
+  pTask->tableCxt.ordered = true;
+  pTask->tableCxt.duplicateTs = false;
+  pTask->tableCxt.pValues = taosArrayInit(pTableCxt->pMeta->tableInfo.numOfColumns, sizeof(SColVal));
+  pTask->tbData.aRowP = taosArrayInit(CSV_MIN_LINES_PER_THREAD, POINTER_BYTES);
+  if (NULL == pTask->tableCxt.pValues || NULL == pTask->tbData.aRowP) {
+    return terrno;
+  }
+  return insInitColValues(pTableCxt->pMeta, pTask->tableCxt.pValues);
+}
+
+static void destroyCsvParseTask(SCsvParseTask* pTask) {
+  taosMemoryFreeClear(pTask->pCxt);
+  taosArrayDestroy(pTask->tableCxt.pValues);
+  taosArrayDestroyP(pTask->tbData.aRowP, (FDelete)tRowDestroy);
+}
+
+// append the rows of one chunk to the table in chunk order, the order flags are combined as if the rows had been
+// parsed one by one
+static int32_t mergeCsvParseTask(STableDataCxt* pTableCxt, SCsvParseTask* pTask) {
+  int32_t numOfRows = taosArrayGetSize(pTask->tbData.aRowP);
+  if (0 == numOfRows) {
+    return TSDB_CODE_SUCCESS;
+  }
+  if (NULL == taosArrayAddBatch(pTableCxt->pData->aRowP, TARRAY_DATA(pTask->tbData.aRowP), numOfRows)) {
+    return terrno;
+  }
+
+  SRowKey firstKey;
+  tRowGetKey(*(SRow**)TARRAY_DATA(pTask->tbData.aRowP), &firstKey);
+  taosArrayClear(pTask->tbData.aRowP);
+  if (pTableCxt->ordered) {
+    insCheckTableDataOrder(pTableCxt, &firstKey);
+    pTableCxt->ordered = pTableCxt->ordered && pTask->tableCxt.ordered;
+    pTableCxt->duplicateTs = pTableCxt->duplicateTs || pTask->tableCxt.duplicateTs;
+    pTableCxt->lastKey = pTask->tableCxt.lastKey;
+  }
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t parseCsvBlockParallel(SInsertParseContext* pCxt, SCsvBlock* pBlock, STableDataCxt* pTableCxt,
+                                     int32_t numOfThreads, int32_t* pNumOfRows) {
+  int32_t        numOfLines = taosArrayGetSize(pBlock->pOffsets);
+  int32_t        code = TSDB_CODE_SUCCESS;
+  char**         pLines = taosMemoryMalloc(numOfLines * POINTER_BYTES);
+  SCsvParseTask* pTasks = NULL;
+  TdThread*      pThreads = NULL;
+  bool*          pStarted = NULL;
+
+  numOfThreads = TMAX(TMIN(numOfThreads, numOfLines / CSV_MIN_LINES_PER_THREAD), 1);
+  pTasks = taosMemoryCalloc(numOfThreads, sizeof(SCsvParseTask));
+  pThreads = taosMemoryCalloc(numOfThreads, sizeof(TdThread));
+  pStarted = taosMemoryCalloc(numOfThreads, sizeof(bool));
+  if (NULL == pLines || NULL == pTasks || NULL == pThreads || NULL == pStarted) {
+    code = terrno;
+    goto _end;
+  }
+
+  for (int32_t i = 0; i < numOfLines; ++i) {
+    pLines[i] = pBlock->pBuf + *(int64_t*)taosArrayGet(pBlock->pOffsets, i);
+  }
+
+  int32_t linesPerThread = (numOfLines + numOfThreads - 1) / numOfThreads;
+  for (int32_t i = 0; i < numOfThreads && TSDB_CODE_SUCCESS == code; ++i) {
+    int32_t start = TMIN(i * linesPerThread, numOfLines);
+    pTasks[i].pLines = pLines + start;
+    pTasks[i].numOfLines = TMIN(start + linesPerThread, numOfLines) - start;
+    pTasks[i].firstLine = (0 == i && pBlock->firstLine);
+    code = initCsvParseTask(pCxt, pTableCxt, pTasks + i);
+  }
+  if (TSDB_CODE_SUCCESS != code) {
+    goto _end;
+  }
+
+  // the calling thread parses the first chunk itself, a chunk whose thread can not start is parsed here as well
+  for (int32_t i = 1; i < numOfThreads; ++i) {
+    pStarted[i] = (taosThreadCreate(pThreads + i, NULL, csvParseTaskFp, pTasks + i) == 0);
+    if (!pStarted[i]) {
+      parserWarn("0x%" PRIx64 " failed to create csv parse thread, parse chunk %d on the calling thread",
+                 pCxt->pComCxt->requestId, i);
+    }
+  }
+  (void)csvParseTaskFp(pTasks);
+  for (int32_t i = 1; i < numOfThreads; ++i) {
+    if (pStarted[i]) {
+      (void)taosThreadJoin(pThreads[i], NULL);
+    } else {
+      (void)csvParseTaskFp(pTasks + i);
+    }
+  }
+
+  for (int32_t i = 0; i < numOfThreads && TSDB_CODE_SUCCESS == code; ++i) {
+    if (TSDB_CODE_SUCCESS != pTasks[i].code) {
+      code = pTasks[i].code;
+      if (NULL != pCxt->msg.buf) {
+        tstrncpy(pCxt->msg.buf, pTasks[i].pCxt->msg.buf, pCxt->msg.len);
+      }
+      break;
+    }
+    code = mergeCsvParseTask(pTableCxt, pTasks + i);
+    if (TSDB_CODE_SUCCESS == code) {
+      *pNumOfRows += pTasks[i].numOfRows;
+    }
+  }
+
+_end:
+  if (NULL != pTasks) {
+    for (int32_t i = 0; i < numOfThreads; ++i) {
+      destroyCsvParseTask(pTasks + i);
+    }
+  }
+  taosMemoryFree(pStarted);
+  taosMemoryFree(pThreads);
+  taosMemoryFree(pTasks);
+  taosMemoryFree(pLines);
+  return code;
+}
+
+// The csv file of a normal or child table is read in blocks of lines, each block is split on line boundaries and
+// parsed by several threads, the rows are appended to the table in file order.
+static int32_t parseCsvFileParallel(SInsertParseContext* pCxt, SVnodeModifyOpStmt* pStmt, STableDataCxt* pTableCxt,
+                                    int32_t numOfThreads, int32_t* pNumOfRows) {
+  SCsvBlock block = {.pOffsets = taosArrayInit(CSV_PARSE_BLOCK_LINES, sizeof(int64_t))};
+  if (NULL == block.pOffsets) {
+    return terrno;
+  }
+
+  int32_t code = TSDB_CODE_SUCCESS;
+  bool    firstLine = (pStmt->fileProcessing == false);
+  bool    eof = false;
+  pStmt->fileProcessing = false;
+  while (TSDB_CODE_SUCCESS == code && !eof) {
+    int32_t maxLines = TMIN(CSV_PARSE_BLOCK_LINES, tsMaxInsertBatchRows - (*pNumOfRows));
+    code = readCsvBlock(pStmt, maxLines, &block, &firstLine, &eof);
+    if (TSDB_CODE_SUCCESS == code && taosArrayGetSize(block.pOffsets) > 0) {
+      code = parseCsvBlockParallel(pCxt, &block, pTableCxt, numOfThreads, pNumOfRows);
+    }
+    if (TSDB_CODE_SUCCESS == code && (*pNumOfRows) >= tsMaxInsertBatchRows) {
+      pStmt->fileProcessing = true;
+      break;
+    }
+  }
+
+  taosArrayDestroy(block.pOffsets);
+  taosMemoryFree(block.pBuf);
+  return code;
+}
+
+static int32_t parseCsvFileSerial(SInsertParseContext* pCxt, SVnodeModifyOpStmt* pStmt, SRowsDataContext rowsDataCxt,
+                                  int32_t* pNumOfRows) {
   int32_t code = TSDB_CODE_SUCCESS;
-  (*pNumOfRows) = 0;
   char*   pLine = NULL;
   int64_t readLen = 0;
   bool    firstLine = (pStmt->fileProcessing == false);
   pStmt->fileProcessing = false;
   while (TSDB_CODE_SUCCESS == code && (readLen = taosGetLineFile(pStmt->fp, &pLine)) != -1) {
+    pStmt->fileReadBytes += readLen;
     if (('\r' == pLine[readLen - 1]) || ('\n' == pLine[readLen - 1])) {
       pLine[--readLen] = '\0';
     }
@@ -2202,6 +2662,18 @@ static int32_t parseCsvFile(SInsertParseContext* pCxt, SVnodeModifyOpStmt* pStmt
     firstLine = false;
   }
   taosMemoryFree(pLine);
+  return code;
+}
+
+static int32_t parseCsvFile(SInsertParseContext* pCxt, SVnodeModifyOpStmt* pStmt, SRowsDataContext rowsDataCxt,
+                            int32_t* pNumOfRows) {
+  int32_t code = TSDB_CODE_SUCCESS;
+  (*pNumOfRows) = 0;
+  if (!pStmt->stbSyntax && tsInsertFileParseThreads > 1) {
+    code = parseCsvFileParallel(pCxt, pStmt, rowsDataCxt.pTableDataCxt, tsInsertFileParseThreads, pNumOfRows);
+  } else {
+    code = parseCsvFileSerial(pCxt, pStmt, rowsDataCxt, pNumOfRows);
+  }
 
   parserDebug("0x%" PRIx64 " %d rows have been parsed", pCxt->pComCxt->requestId, *pNumOfRows);
 
@@ -2212,6 +2684,14 @@ static int32_t parseCsvFile(SInsertParseContext* pCxt, SVnodeModifyOpStmt* pStmt
   return code;
 }
 
+static void reportCsvProgress(SInsertParseContext* pCxt, SVnodeModifyOpStmt* pStmt) {
+  int64_t elapsed = taosGetTimestampUs() - pStmt->fileStartTs;
+  double  percent = pStmt->fileSize > 0 ? 100.0 * pStmt->fileReadBytes / pStmt->fileSize : 100.0;
+  double  speed = elapsed > 0 ? (double)pStmt->fileReadBytes / elapsed : 0;  // bytes per us is MB per second
+  parserInfo("0x%" PRIx64 " insert from csv, %" PRId64 " of %" PRId64 " bytes (%.1f%%) read, %d rows parsed, %.2f MB/s",
+             pCxt->pComCxt->requestId, pStmt->fileReadBytes, pStmt->fileSize, percent, pStmt->totalRowsNum, speed);
+}
+
 static int32_t parseDataFromFileImpl(SInsertParseContext* pCxt, SVnodeModifyOpStmt* pStmt,
                                      SRowsDataContext rowsDataCxt) {
   // init only for file
@@ -2230,6 +2710,7 @@ static int32_t parseDataFromFileImpl(SInsertParseContext* pCxt, SVnodeModifyOpSt
     if (rowsDataCxt.pTableDataCxt && rowsDataCxt.pTableDataCxt->pData) {
       rowsDataCxt.pTableDataCxt->pData->flags |= SUBMIT_REQ_FROM_FILE;
     }
+    reportCsvProgress(pCxt, pStmt);
     if (!pStmt->fileProcessing) {
       code = taosCloseFile(&pStmt->fp);
       if (TSDB_CODE_SUCCESS != code) {
@@ -2273,6 +2754,11 @@ static int32_t parseDataFromFile(SInsertParseContext* pCxt, SVnodeModifyOpStmt*
   if (NULL == pStmt->fp) {
     return terrno;
   }
+  if (TSDB_CODE_SUCCESS != taosStatFile(filePathStr, &pStmt->fileSize, NULL, NULL)) {
+    pStmt->fileSize = 0;
+  }
+  pStmt->fileReadBytes = 0;
+  pStmt->fileStartTs = taosGetTimestampUs();
 
   return parseDataFromFileImpl(pCxt, pStmt, rowsDataCxt);
 }
@@ -3077,6 +3563,8 @@ int32_t parseInsertSql(SParseContext* pCxt, SQuery** pQuery, SCatalogReq* pCatal
     code = setRefreshMeta(*pQuery);
   }
   insDestroyBoundColInfo(&context.tags);
+  taosMemoryFree(context.pLastUsingTableMeta);
+  nodesDestroyNode(context.pLastUsingTagCond);
 
   // if no data to insert, set emptyMode to avoid request server
   if (!context.needRequest) {
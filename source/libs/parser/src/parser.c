@@ -16,6 +16,7 @@
 #include "parser.h"
 #include "os.h"
 
+#include "functionMgt.h"
 #include "parInt.h"
 #include "parToken.h"
 
@@ -288,6 +289,122 @@ int32_t qParseSqlSyntax(SParseContext* pCxt, SQuery** pQuery, struct SCatalogReq
   return code;
 }
 
+// only the node types whose clone keeps every field set by the parser
+static bool isReusableSyntaxNode(const SNode* pNode);
+
+static bool isReusableSyntaxList(const SNodeList* pList) {
+  const SNode* pNode = NULL;
+  FOREACH(pNode, pList) {
+    if (!isReusableSyntaxNode(pNode)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool isReusableSyntaxNode(const SNode* pNode) {
+  if (NULL == pNode) {
+    return true;
+  }
+
+  switch (nodeType(pNode)) {
+    case QUERY_NODE_COLUMN:
+    case QUERY_NODE_LIMIT:
+    case QUERY_NODE_REAL_TABLE:
+      return true;
+    case QUERY_NODE_VALUE:
+      return 0 == ((const SValueNode*)pNode)->placeholderNo;
+    case QUERY_NODE_OPERATOR:
+      return isReusableSyntaxNode(((const SOperatorNode*)pNode)->pLeft) &&
+             isReusableSyntaxNode(((const SOperatorNode*)pNode)->pRight);
+    case QUERY_NODE_LOGIC_CONDITION:
+      return isReusableSyntaxList(((const SLogicConditionNode*)pNode)->pParameterList);
+    case QUERY_NODE_FUNCTION:
+      return isReusableSyntaxList(((const SFunctionNode*)pNode)->pParameterList);
+    case QUERY_NODE_NODE_LIST:
+      return isReusableSyntaxList(((const SNodeListNode*)pNode)->pNodeList);
+    case QUERY_NODE_GROUPING_SET:
+      return isReusableSyntaxList(((const SGroupingSetNode*)pNode)->pParameterList);
+    case QUERY_NODE_ORDER_BY_EXPR:
+      return isReusableSyntaxNode(((const SOrderByExprNode*)pNode)->pExpr);
+    case QUERY_NODE_WHEN_THEN:
+      return isReusableSyntaxNode(((const SWhenThenNode*)pNode)->pWhen) &&
+             isReusableSyntaxNode(((const SWhenThenNode*)pNode)->pThen);
+    case QUERY_NODE_CASE_WHEN: {
+      const SCaseWhenNode* pCaseWhen = (const SCaseWhenNode*)pNode;
+      return isReusableSyntaxNode(pCaseWhen->pCase) && isReusableSyntaxNode(pCaseWhen->pElse) &&
+             isReusableSyntaxList(pCaseWhen->pWhenThenList);
+    }
+    case QUERY_NODE_INTERVAL_WINDOW: {
+      const SIntervalWindowNode* pInterval = (const SIntervalWindowNode*)pNode;
+      return isReusableSyntaxNode(pInterval->pCol) && isReusableSyntaxNode(pInterval->pInterval) &&
+             isReusableSyntaxNode(pInterval->pOffset) && isReusableSyntaxNode(pInterval->pSliding) &&
+             isReusableSyntaxNode(pInterval->pFill);
+    }
+    case QUERY_NODE_FILL:
+      return isReusableSyntaxNode(((const SFillNode*)pNode)->pValues) &&
+             isReusableSyntaxNode(((const SFillNode*)pNode)->pWStartTs);
+    case QUERY_NODE_STATE_WINDOW:
+      return isReusableSyntaxNode(((const SStateWindowNode*)pNode)->pCol) &&
+             isReusableSyntaxNode(((const SStateWindowNode*)pNode)->pExpr);
+    case QUERY_NODE_SESSION_WINDOW:
+      return true;
+    case QUERY_NODE_EVENT_WINDOW: {
+      const SEventWindowNode* pEvent = (const SEventWindowNode*)pNode;
+      return isReusableSyntaxNode(pEvent->pCol) && isReusableSyntaxNode(pEvent->pStartCond) &&
+             isReusableSyntaxNode(pEvent->pEndCond);
+    }
+    case QUERY_NODE_COUNT_WINDOW:
+      return isReusableSyntaxNode(((const SCountWindowNode*)pNode)->pCol);
+    case QUERY_NODE_SELECT_STMT: {
+      // subqueries, joins and stream clauses are not cached
+      const SSelectStmt* pSelect = (const SSelectStmt*)pNode;
+      return QUERY_NODE_REAL_TABLE == nodeType(pSelect->pFromTable) && NULL == pSelect->pTags &&
+             NULL == pSelect->pSubtable && NULL == pSelect->pHint &&
+             isReusableSyntaxList(pSelect->pProjectionList) && isReusableSyntaxNode(pSelect->pWhere) &&
+             isReusableSyntaxList(pSelect->pPartitionByList) && isReusableSyntaxNode(pSelect->pWindow) &&
+             isReusableSyntaxList(pSelect->pGroupByList) && isReusableSyntaxNode(pSelect->pHaving) &&
+             isReusableSyntaxNode(pSelect->pRange) && isReusableSyntaxNode(pSelect->pEvery) &&
+             isReusableSyntaxNode(pSelect->pFill) && isReusableSyntaxList(pSelect->pOrderByList) &&
+             isReusableSyntaxNode((const SNode*)pSelect->pLimit) && isReusableSyntaxNode((const SNode*)pSelect->pSlimit);
+    }
+    default:
+      break;
+  }
+  return false;
+}
+
+bool qIsReusableSqlSyntax(const SQuery* pQuery) {
+  return NULL != pQuery && NULL != pQuery->pRoot && 0 == pQuery->placeholderNum &&
+         QUERY_NODE_SELECT_STMT == nodeType(pQuery->pRoot) && isReusableSyntaxNode(pQuery->pRoot);
+}
+
+int32_t qCloneSqlSyntax(SParseContext* pCxt, const SNode* pRoot, SQuery** pQuery, struct SCatalogReq* pCatalogReq) {
+  SParseMetaCache metaCache = {0};
+  SNode*          pNewRoot = NULL;
+  SArray*         pPlaceholderValues = NULL;
+  int32_t         code = nodesAcquireAllocator(pCxt->allocatorId);
+  if (TSDB_CODE_SUCCESS == code) {
+    code = nodesCloneNode(pRoot, &pNewRoot);
+  }
+  if (TSDB_CODE_SUCCESS == code) {
+    code = buildQueryAfterParse(pQuery, pNewRoot, 0, &pPlaceholderValues);
+    if (TSDB_CODE_SUCCESS != code) {
+      nodesDestroyNode(pNewRoot);
+    }
+  }
+  if (TSDB_CODE_SUCCESS == code) {
+    code = collectMetaKey(pCxt, *pQuery, &metaCache);
+  }
+  if (TSDB_CODE_SUCCESS == code) {
+    code = buildCatalogReq(&metaCache, pCatalogReq);
+  }
+  destoryParseMetaCache(&metaCache, true);
+  (void)nodesReleaseAllocator(pCxt->allocatorId);
+  terrno = code;
+  return code;
+}
+
 int32_t qAnalyseSqlSemantic(SParseContext* pCxt, const struct SCatalogReq* pCatalogReq,
                             const struct SMetaData* pMetaData, SQuery* pQuery) {
   SParseMetaCache metaCache = {0};
@@ -535,6 +652,83 @@ int32_t qStmtBindParams2(SQuery* pQuery, TAOS_STMT2_BIND* pParams, int32_t colId
   return code;
 }
 
+typedef struct SPlanReusableCxt {
+  int32_t placeholders;     // placeholder values found
+  int32_t filterValues;     // placeholder values compared with an ordinary column
+  bool    hasTimeFunc;      // now() and today() are folded at translation
+} SPlanReusableCxt;
+
+static bool isPlaceholderValue(const SNode* pNode) {
+  return NULL != pNode && QUERY_NODE_VALUE == nodeType(pNode) && ((const SValueNode*)pNode)->placeholderNo > 0;
+}
+
+// the primary key feeds the scan time range and is excluded, the other columns are only filtered at execution
+static bool isFilterOnlyColumn(const SNode* pNode) {
+  return NULL != pNode && QUERY_NODE_COLUMN == nodeType(pNode) && !((const SColumnNode*)pNode)->isPrimTs &&
+         !((const SColumnNode*)pNode)->isPk && PRIMARYKEY_TIMESTAMP_COL_ID != ((const SColumnNode*)pNode)->colId;
+}
+
+static EDealRes checkPlanReusableNode(SNode* pNode, void* pContext) {
+  SPlanReusableCxt* pCxt = pContext;
+  if (isPlaceholderValue(pNode)) {
+    ++pCxt->placeholders;
+  } else if (QUERY_NODE_FUNCTION == nodeType(pNode)) {
+    EFunctionType type = fmGetFuncType(((SFunctionNode*)pNode)->functionName);
+    pCxt->hasTimeFunc = pCxt->hasTimeFunc || FUNCTION_TYPE_NOW == type || FUNCTION_TYPE_TODAY == type;
+  } else if (QUERY_NODE_OPERATOR == nodeType(pNode)) {
+    SOperatorNode* pOp = (SOperatorNode*)pNode;
+    switch (pOp->opType) {
+      case OP_TYPE_GREATER_THAN:
+      case OP_TYPE_GREATER_EQUAL:
+      case OP_TYPE_LOWER_THAN:
+      case OP_TYPE_LOWER_EQUAL:
+      case OP_TYPE_EQUAL:
+      case OP_TYPE_NOT_EQUAL:
+        if ((isPlaceholderValue(pOp->pLeft) && isFilterOnlyColumn(pOp->pRight)) ||
+            (isPlaceholderValue(pOp->pRight) && isFilterOnlyColumn(pOp->pLeft))) {
+          ++pCxt->filterValues;
+        }
+        break;
+      default:
+        break;
+    }
+  }
+  return DEAL_RES_CONTINUE;
+}
+
+bool qStmtIsPlanReusable(const SQuery* pQuery) {
+  if (NULL == pQuery->pRoot || NULL == pQuery->pPrepareRoot || QUERY_NODE_SELECT_STMT != nodeType(pQuery->pRoot) ||
+      QUERY_EXEC_MODE_SCHEDULE != pQuery->execMode) {
+    return false;
+  }
+
+  SSelectStmt* pSelect = (SSelectStmt*)pQuery->pRoot;
+  if (NULL == pSelect->pFromTable || QUERY_NODE_REAL_TABLE != nodeType(pSelect->pFromTable) ||
+      NULL == ((SRealTableNode*)pSelect->pFromTable)->pMeta ||
+      TSDB_SYSTEM_TABLE == ((SRealTableNode*)pSelect->pFromTable)->pMeta->tableType || NULL != pSelect->pRange ||
+      NULL != pSelect->pEvery || pSelect->isEmptyResult) {
+    return false;
+  }
+
+  // the time functions are already folded in pRoot
+  SPlanReusableCxt cxt = {0};
+  if (QUERY_NODE_SELECT_STMT == nodeType(pQuery->pPrepareRoot)) {
+    nodesWalkSelectStmt((SSelectStmt*)pQuery->pPrepareRoot, SQL_CLAUSE_FROM, checkPlanReusableNode, &cxt);
+  }
+  if (cxt.hasTimeFunc) {
+    return false;
+  }
+
+  // every placeholder must be a plain filter of the where clause
+  (void)memset(&cxt, 0, sizeof(cxt));
+  nodesWalkSelectStmt(pSelect, SQL_CLAUSE_WHERE, checkPlanReusableNode, &cxt);
+  if (cxt.placeholders > 0) {
+    return false;
+  }
+  nodesWalkExpr(pSelect->pWhere, checkPlanReusableNode, &cxt);
+  return cxt.placeholders == cxt.filterValues && cxt.placeholders == pQuery->placeholderNum;
+}
+
 int32_t qStmtParseQuerySql(SParseContext* pCxt, SQuery* pQuery) {
   int32_t code = translate(pCxt, pQuery, NULL);
   if (TSDB_CODE_SUCCESS == code) {
@@ -14,8 +14,10 @@
  */
 
 #include <gtest/gtest.h>
+#include <fstream>
 
 #include "parTestUtil.h"
+#include "tglobal.h"
 
 using namespace std;
 
@@ -28,7 +30,7 @@ namespace ParserTest {
 //       [(field1_name, ...)]
 //       VALUES (field1_value, ...) [(field1_value2, ...) ...] | FILE csv_file_path
 //   [...];
-class ParserInsertTest : public ParserTestBase {};
+class ParserInsertTest : public ParserDdlTest {};
 
 // INSERT INTO tb_name [(field1_name, ...)] VALUES (field1_value, ...)
 TEST_F(ParserInsertTest, singleTableSingleRowTest) {
@@ -84,4 +86,76 @@ TEST_F(ParserInsertTest, autoCreateTableTest) {
       "st1s2 (ts, c1, c2) USING st1 TAGS(2, 'abc', now) VALUES (now+1s, 2, 'shanghai')");
 }
 
+// plain literals are parsed without the tokenizer, everything else still goes through it
+TEST_F(ParserInsertTest, plainValueTest) {
+  useDb("root", "test");
+
+  run("INSERT INTO t1 VALUES (1700000000000, -1, 'beijing', 1234567, 1.5, -0.25)"
+      "(1700000000001,2,\"shanghai\",null,3.,4) (1700000000002 , NULL , '' , 0 , 5 , 6 )");
+
+  run("INSERT INTO t1 VALUES (1700000000000, 1, 'bei''jing', 3, 1e3, -4)"
+      "(now+1s, '2', 'shang\\thai', 1234567890123456789, .5, '6')");
+
+  run("INSERT INTO t1 VALUES (1700000000000, 2147483648, 'beijing', 3, 4, 5)", TSDB_CODE_TSC_SQL_SYNTAX_ERROR);
+
+  run("INSERT INTO t1 VALUES (null, 1, 'beijing', 3, 4, 5)", TSDB_CODE_TSC_SQL_SYNTAX_ERROR);
+
+  run("INSERT INTO t1 VALUES (1700000000000, 1, 'beijing', 3, 4 5)", TSDB_CODE_TSC_SQL_SYNTAX_ERROR);
+}
+
+// the meta of st1 is looked up once and reused by the following child tables
+TEST_F(ParserInsertTest, autoCreateSameSuperTableTest) {
+  useDb("root", "test");
+
+  run("INSERT INTO "
+      "st1s1 USING st1 TAGS(1, 'wxy', now) VALUES (1700000000000, 1, 'beijing') "
+      "st1s2 USING st1 TAGS(2, 'abc', now) VALUES (1700000000001, 2, 'shanghai') "
+      "st2s1 USING st2 TAGS('{\"k\": 1}') VALUES (1700000000002, 3, 'guangzhou') "
+      "st1s3 USING st1 (tag1) TAGS(3) VALUES (1700000000003, 4, 'shenzhen')");
+}
+
+// INSERT INTO tb_name FILE csv_file_path, parsed by one and by several threads
+TEST_F(ParserInsertTest, fileParallelTest) {
+  useDb("root", "test");
+
+  const char*   csvFile = "parInsertFileTest.csv";
+  const int32_t numOfRows = 200000;
+  {
+    std::ofstream out(csvFile);
+    out << "ts,c1,c2,c3,c4,c5\n";  // header line, skipped because it can not be parsed
+    for (int32_t i = 0; i < numOfRows; ++i) {
+      out << (1700000000000LL + i) << "," << i << ",'beijing" << i % 100 << "'," << i * 7LL << "," << i * 0.5 << ","
+          << (i % 3 == 0 ? "null" : "1.25") << "\n";
+    }
+  }
+
+  // the submit requests built from the file, one per vgroup
+  auto getSubmitData = [&](int32_t threads) {
+    vector<string> data;
+    setCheckDdlFunc([&](const SQuery* pQuery, ParserStage stage) {
+      ASSERT_EQ(nodeType(pQuery->pRoot), QUERY_NODE_VNODE_MODIFY_STMT);
+      SVnodeModifyOpStmt* pStmt = (SVnodeModifyOpStmt*)pQuery->pRoot;
+      ASSERT_EQ(pStmt->totalRowsNum, numOfRows);
+      ASSERT_NE(pStmt->pDataBlocks, nullptr);
+      data.clear();
+      for (int32_t i = 0; i < taosArrayGetSize(pStmt->pDataBlocks); ++i) {
+        SVgDataBlocks* pVgData = (SVgDataBlocks*)taosArrayGetP(pStmt->pDataBlocks, i);
+        data.emplace_back((const char*)pVgData->pData, pVgData->size);
+      }
+    });
+    int32_t savedThreads = tsInsertFileParseThreads;
+    tsInsertFileParseThreads = threads;
+    run(string("INSERT INTO t1 FILE '") + csvFile + "'");
+    tsInsertFileParseThreads = savedThreads;
+    setCheckDdlFunc(nullptr);
+    return data;
+  };
+
+  vector<string> serial = getSubmitData(1);
+  vector<string> parallel = getSubmitData(4);
+  ASSERT_FALSE(serial.empty());
+  ASSERT_EQ(serial, parallel);
+  (void)remove(csvFile);
+}
+
 }  // namespace ParserTest
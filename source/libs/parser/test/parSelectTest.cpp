@@ -511,4 +511,27 @@ TEST_F(ParserSelectTest, joinSemanticCheck) {
   run("SELECT count(*) FROM t1 a join t1 b on a.ts=b.ts where a.ts=b.ts");
 }
 
+// the syntax tree of a plain query is cached by the client and translated again from a copy
+TEST_F(ParserSelectTest, syntaxCache) {
+  useDb("root", "test");
+
+  runSyntaxCache("SELECT c1, c2 FROM t1 WHERE c1 > 10 AND c2 LIKE 'ab%' ORDER BY ts DESC LIMIT 10 OFFSET 2");
+
+  runSyntaxCache("SELECT COUNT(*), SUM(c1) FROM st1 PARTITION BY tbname SLIMIT 3 SOFFSET 1 LIMIT 5");
+
+  runSyntaxCache("SELECT _WSTART, AVG(c1) FROM t1 WHERE ts > '2022-01-01 00:00:00' INTERVAL(10s, 5s) SLIDING(5s) "
+                 "FILL(VALUE, 0) ORDER BY 1");
+
+  runSyntaxCache("SELECT c2, COUNT(*) FROM t1 GROUP BY c2 HAVING COUNT(*) > 1");
+
+  runSyntaxCache("SELECT CASE WHEN c1 > 0 THEN 'p' WHEN c1 < 0 THEN 'n' ELSE 'z' END, c1 + 1 FROM t1 "
+                 "WHERE c1 IN (1, 2, 3)");
+
+  runSyntaxCache("SELECT COUNT(*) FROM t1 STATE_WINDOW(c1)");
+
+  runSyntaxCache("SELECT COUNT(*) FROM t1 SESSION(ts, 10s)");
+
+  runSyntaxCache("SELECT COUNT(*) FROM t1 EVENT_WINDOW START WITH c1 > 0 END WITH c1 < 0");
+}
+
 }  // namespace ParserTest
@@ -98,6 +98,55 @@ class ParserTestBaseImpl {
     }
   }
 
+  // the tree of a reusable query is cloned before it is translated, as the client syntax cache does, then a new query
+  // is built from the copy with qCloneSqlSyntax, both must give the same catalog request and translated tree
+  void runSyntaxCache(const string& sql) {
+    reset(TSDB_CODE_SUCCESS, PARSER_STAGE_TRANSLATE, TEST_INTERFACE_ASYNC_API);
+    try {
+      unique_ptr<SParseContext, function<void(SParseContext*)> > cxt(new SParseContext(), destoryParseContext);
+      setParseContext(sql, cxt.get());
+
+      unique_ptr<SCatalogReq, void (*)(SCatalogReq*)> catalogReq(new SCatalogReq(),
+                                                                 MockCatalogService::destoryCatalogReq);
+      unique_ptr<SQuery*, void (*)(SQuery**)> query((SQuery**)taosMemoryCalloc(1, sizeof(SQuery*)), destroyQuery);
+      doParseSqlSyntax(cxt.get(), query.get(), catalogReq.get());
+      ASSERT_TRUE(qIsReusableSqlSyntax(*(query.get())));
+      string parsedAst = res_.parsedAst_;
+
+      SNode* pCached = nullptr;
+      DO_WITH_THROW(nodesCloneNode, (*(query.get()))->pRoot, &pCached);
+      unique_ptr<SNode, void (*)(SNode*)> cached(pCached, nodesDestroyNode);
+      ASSERT_EQ(toString(pCached), parsedAst);
+
+      unique_ptr<SMetaData, void (*)(SMetaData*)> metaData(new SMetaData(), MockCatalogService::destoryMetaData);
+      doGetAllMeta(catalogReq.get(), metaData.get());
+      doAnalyseSqlSemantic(cxt.get(), catalogReq.get(), metaData.get(), *(query.get()));
+      string translatedAst = res_.calcConstAst_;
+
+      unique_ptr<SCatalogReq, void (*)(SCatalogReq*)> cloneCatalogReq(new SCatalogReq(),
+                                                                      MockCatalogService::destoryCatalogReq);
+      unique_ptr<SQuery*, void (*)(SQuery**)> cloneQuery((SQuery**)taosMemoryCalloc(1, sizeof(SQuery*)),
+                                                         destroyQuery);
+      DO_WITH_THROW(qCloneSqlSyntax, cxt.get(), pCached, cloneQuery.get(), cloneCatalogReq.get());
+      ASSERT_NE(*(cloneQuery.get()), nullptr);
+      ASSERT_EQ(toString((*(cloneQuery.get()))->pRoot), parsedAst);
+      ASSERT_EQ(taosArrayGetSize(cloneCatalogReq->pTableMeta), taosArrayGetSize(catalogReq->pTableMeta));
+      ASSERT_EQ(taosArrayGetSize(cloneCatalogReq->pTableHash), taosArrayGetSize(catalogReq->pTableHash));
+      ASSERT_EQ(taosArrayGetSize(cloneCatalogReq->pDbVgroup), taosArrayGetSize(catalogReq->pDbVgroup));
+
+      unique_ptr<SMetaData, void (*)(SMetaData*)> cloneMetaData(new SMetaData(), MockCatalogService::destoryMetaData);
+      doGetAllMeta(cloneCatalogReq.get(), cloneMetaData.get());
+      doAnalyseSqlSemantic(cxt.get(), cloneCatalogReq.get(), cloneMetaData.get(), *(cloneQuery.get()));
+      ASSERT_EQ(res_.calcConstAst_, translatedAst);
+
+      // the cached tree is left untouched and can be cloned again
+      ASSERT_EQ(toString(pCached), parsedAst);
+    } catch (...) {
+      dump();
+      throw;
+    }
+  }
+
  private:
   struct caseEnv {
     string  acctId_;
@@ -323,6 +372,7 @@ class ParserTestBaseImpl {
       if (qIsInsertValuesSql(cxt.pSql, cxt.sqlLen)) {
         unique_ptr<SQuery*, void (*)(SQuery**)> query((SQuery**)taosMemoryCalloc(1, sizeof(SQuery*)), destroyQuery);
         doParseInsertSql(&cxt, query.get(), nullptr, nullptr);
+        checkQuery(*(query.get()), PARSER_STAGE_PARSE);
       } else {
         unique_ptr<SQuery*, void (*)(SQuery**)> query((SQuery**)taosMemoryCalloc(1, sizeof(SQuery*)), destroyQuery);
         doParse(&cxt, query.get());
@@ -557,6 +607,8 @@ void ParserTestBase::run(const std::string& sql, int32_t expect, ParserStage che
   return impl_->run(sql, expect, checkStage);
 }
 
+void ParserTestBase::runSyntaxCache(const std::string& sql) { return impl_->runSyntaxCache(sql); }
+
 void ParserTestBase::checkDdl(const SQuery* pQuery, ParserStage stage) { return; }
 
 }  // namespace ParserTest
@@ -40,6 +40,7 @@ class ParserTestBase : public testing::Test {
   void login(const std::string& user);
   void useDb(const std::string& acctId, const std::string& db);
   void run(const std::string& sql, int32_t expect = TSDB_CODE_SUCCESS, ParserStage checkStage = PARSER_STAGE_TRANSLATE);
+  void runSyntaxCache(const std::string& sql);
 
   virtual void checkDdl(const SQuery* pQuery, ParserStage stage);
 
@@ -61,6 +61,35 @@ bool        keysHasTbname(SNodeList* pKeys);
 SFunctionNode* createGroupKeyAggFunc(SColumnNode* pGroupCol);
 int32_t getTimeRangeFromNode(SNode** pPrimaryKeyCond, STimeWindow* pTimeRange, bool* pIsStrict);
 int32_t tagScanSetExecutionMode(SScanLogicNode* pScan);
+int32_t getScanTableSplitNum(const SPlanContext* pCxt, const SScanLogicNode* pScan);
+int32_t getPartTableScanSplitNum(const SPlanContext* pCxt, const SScanLogicNode* pScan, const SVgroupInfo* pVgroup);
+
+#define SPLIT_FLAG_MASK(n) (1 << n)
+
+#define SPLIT_FLAG_STABLE_SPLIT     SPLIT_FLAG_MASK(0)
+#define SPLIT_FLAG_INSERT_SPLIT     SPLIT_FLAG_MASK(1)
+#define SPLIT_FLAG_PART_TABLE_SPLIT SPLIT_FLAG_MASK(2)  // each group of the subplan is made of the rows of one table
+
+#define SPLIT_FLAG_SET_MASK(val, mask)  (val) |= (mask)
+#define SPLIT_FLAG_TEST_MASK(val, mask) (((val) & (mask)) != 0)
+
+// Without statistics of the tables at hand, the cost model falls back to these assumptions.
+#define PLAN_COST_TABLE_ROWS        10000  // rows of a table in the whole time range
+#define PLAN_COST_VGROUP_TABLES     100    // child tables of a super table in a vgroup
+#define PLAN_COST_EQUAL_SEL         0.1
+#define PLAN_COST_RANGE_SEL         0.3333
+#define PLAN_COST_LIKE_SEL          0.25
+#define PLAN_COST_DEFAULT_SEL       0.5
+#define PLAN_COST_GROUP_RATIO       0.1    // output rows of a group by or a window relative to the input
+#define PLAN_COST_HASH_BUILD_ROWS   1000000
+#define PLAN_COST_HASH_PROBE_RATIO  16     // the probe side must be this much larger than the build side
+
+#define PLAN_MAX_PART_TABLE_SPLITS  64
+
+double  estimateCondSelectivity(const SNode* pCond);
+int64_t estimateLogicNodeRows(const SLogicNode* pNode);
+int32_t estimateLogicNodeRowSize(const SLogicNode* pNode);
+void    setJoinInputStat(SJoinLogicNode* pJoin);
 
 #define CLONE_LIMIT 1
 #define CLONE_SLIMIT 1 << 1
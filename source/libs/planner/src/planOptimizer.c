@@ -5536,6 +5536,25 @@ static int32_t sortNonPriKeyOptimize(SOptimizeContext* pCxt, SLogicSubplan* pLog
   return TSDB_CODE_SUCCESS;
 }
 
+// Without the hint, a hash join is chosen only when the estimates show a small build side against a much larger probe
+// side, which then needs no global sort by timestamp. It is limited to the inputs of order insensitive consumers, so
+// the results of plain joins keep their timestamp order.
+static bool hashJoinOptPreferredByCost(SJoinLogicNode* pJoin) {
+  SLogicNode* pParent = pJoin->node.pParent;
+  if (JOIN_TYPE_INNER != pJoin->joinType || JOIN_STYPE_NONE != pJoin->subType || NULL != pJoin->pTagEqCond ||
+      NULL != pJoin->pJLimit || pJoin->isLowLevelJoin || NULL == pParent ||
+      DATA_ORDER_LEVEL_NONE != pParent->requireDataOrder ||
+      (QUERY_NODE_LOGIC_PLAN_AGG != nodeType(pParent) && QUERY_NODE_LOGIC_PLAN_PARTITION != nodeType(pParent))) {
+    return false;
+  }
+
+  int64_t left = estimateLogicNodeRows((SLogicNode*)nodesListGetNode(pJoin->node.pChildren, 0));
+  int64_t right = estimateLogicNodeRows((SLogicNode*)nodesListGetNode(pJoin->node.pChildren, 1));
+  int64_t build = TMIN(left, right);
+  int64_t probe = TMAX(left, right);
+  return build > 0 && build <= PLAN_COST_HASH_BUILD_ROWS && probe / PLAN_COST_HASH_PROBE_RATIO >= build;
+}
+
 static bool hashJoinOptShouldBeOptimized(SLogicNode* pNode, void* pCtx) {
   bool res = false;
   if (QUERY_NODE_LOGIC_PLAN_JOIN != nodeType(pNode)) {
@@ -5546,12 +5565,12 @@ static bool hashJoinOptShouldBeOptimized(SLogicNode* pNode, void* pCtx) {
   if (pJoin->joinAlgo != JOIN_ALGO_UNKNOWN) {
     return res;
   }
-  
-  if (!pJoin->hashJoinHint) {
+
+  if ((JOIN_STYPE_NONE != pJoin->subType && JOIN_STYPE_OUTER != pJoin->subType) || JOIN_TYPE_FULL == pJoin->joinType || pNode->pChildren->length != 2 ) {
     goto _return;
   }
 
-  if ((JOIN_STYPE_NONE != pJoin->subType && JOIN_STYPE_OUTER != pJoin->subType) || JOIN_TYPE_FULL == pJoin->joinType || pNode->pChildren->length != 2 ) {
+  if (!pJoin->hashJoinHint && !hashJoinOptPreferredByCost(pJoin)) {
     goto _return;
   }
 
@@ -5655,6 +5674,18 @@ static int32_t hashJoinOptRewriteJoin(SOptimizeContext* pCxt, SLogicNode* pNode,
   int32_t code = TSDB_CODE_SUCCESS;
 
   pJoin->joinAlgo = JOIN_ALGO_HASH;
+  setJoinInputStat(pJoin);
+
+  // the hint has already dropped the order requirement, a join chosen by cost drops it here
+  if (!pJoin->hashJoinHint) {
+    planDebug("hash join chosen by cost, estimated input rows:%" PRId64 "/%" PRId64, pJoin->inputStat[0].inputRowNum,
+              pJoin->inputStat[1].inputRowNum);
+    pJoin->node.requireDataOrder = DATA_ORDER_LEVEL_NONE;
+    code = adjustLogicNodeDataRequirement(pNode, pJoin->node.requireDataOrder);
+    if (TSDB_CODE_SUCCESS != code) {
+      return code;
+    }
+  }
 
   if (NULL != pJoin->pColOnCond) {
 #if 0  
@@ -5862,6 +5893,7 @@ static bool stbJoinOptShouldBeOptimized(SLogicNode* pNode, void* pCtx) {
   SJoinLogicNode* pJoin = (SJoinLogicNode*)pNode;
   if (pJoin->joinAlgo == JOIN_ALGO_UNKNOWN) {
     pJoin->joinAlgo = JOIN_ALGO_MERGE;
+    setJoinInputStat(pJoin);
   }
 
   if (JOIN_STYPE_NONE != pJoin->subType || pJoin->isSingleTableJoin || NULL == pJoin->pTagEqCond || pNode->pChildren->length != 2 
@@ -6036,6 +6068,7 @@ static int32_t stbJoinOptCreateTagHashJoinNode(SLogicNode* pOrig, SNodeList* pCh
   nodesDestroyList(pCols);
 
   if (TSDB_CODE_SUCCESS == code) {
+    setJoinInputStat(pJoin);
     *ppLogic = (SLogicNode*)pJoin;    
     OPTIMIZE_FLAG_SET_MASK(pJoin->node.optimizedFlag, OPTIMIZE_FLAG_STB_JOIN);
   } else {
@@ -801,6 +801,8 @@ static int32_t createTableScanPhysiNode(SPhysiPlanContext* pCxt, SSubplan* pSubp
   pTableScan->needCountEmptyTable = pScanLogicNode->isCountByTag;
   pTableScan->paraTablesSort = pScanLogicNode->paraTablesSort;
   pTableScan->smallDataTsSort = pScanLogicNode->smallDataTsSort;
+  pTableScan->tableSplitIdx = pScanLogicNode->tableSplitIdx;
+  pTableScan->tableSplitNum = pScanLogicNode->tableSplitNum;
 
   code = createScanPhysiNodeFinalize(pCxt, pSubplan, pScanLogicNode, (SScanPhysiNode*)pTableScan, pPhyNode);
   if (TSDB_CODE_SUCCESS == code) {
@@ -1563,11 +1565,22 @@ static int32_t createHashJoinPhysiNode(SPhysiPlanContext* pCxt, SNodeList* pChil
 
 static int32_t createJoinPhysiNode(SPhysiPlanContext* pCxt, SNodeList* pChildren, SJoinLogicNode* pJoinLogicNode,
                                    SPhysiNode** pPhyNode) {
+  int32_t code = TSDB_CODE_SUCCESS;
   switch (pJoinLogicNode->joinAlgo) {
     case JOIN_ALGO_MERGE:
-      return createMergeJoinPhysiNode(pCxt, pChildren, pJoinLogicNode, pPhyNode);
+      code = createMergeJoinPhysiNode(pCxt, pChildren, pJoinLogicNode, pPhyNode);
+      if (TSDB_CODE_SUCCESS == code) {
+        memcpy(((SSortMergeJoinPhysiNode*)*pPhyNode)->inputStat, pJoinLogicNode->inputStat,
+               sizeof(pJoinLogicNode->inputStat));
+      }
+      return code;
     case JOIN_ALGO_HASH:
-      return createHashJoinPhysiNode(pCxt, pChildren, pJoinLogicNode, pPhyNode);
+      code = createHashJoinPhysiNode(pCxt, pChildren, pJoinLogicNode, pPhyNode);
+      if (TSDB_CODE_SUCCESS == code) {
+        memcpy(((SHashJoinPhysiNode*)*pPhyNode)->inputStat, pJoinLogicNode->inputStat,
+               sizeof(pJoinLogicNode->inputStat));
+      }
+      return code;
     default:
       planError("Invalid join algorithm:%d", pJoinLogicNode->joinAlgo);
       break;
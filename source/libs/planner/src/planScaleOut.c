@@ -68,19 +68,65 @@ static int32_t setScanVgroup(SLogicNode* pNode, const SVgroupInfo* pVgroup) {
   return doSetScanVgroup(pNode, pVgroup, &found);
 }
 
-static int32_t scaleOutByVgroups(SScaleOutContext* pCxt, SLogicSubplan* pSubplan, int32_t level, SNodeList* pGroup) {
+// the scan at the end of a single child chain, the same one the splitter counts the channels of the merge by
+static SScanLogicNode* getSplitScan(SLogicNode* pNode) {
+  if (QUERY_NODE_LOGIC_PLAN_SCAN == nodeType(pNode)) {
+    return (SScanLogicNode*)pNode;
+  }
+  if (1 == LIST_LENGTH(pNode->pChildren)) {
+    return getSplitScan((SLogicNode*)nodesListGetNode(pNode->pChildren, 0));
+  }
+  return NULL;
+}
+
+static int32_t getTableSplitNum(SScaleOutContext* pCxt, SLogicSubplan* pSubplan, int32_t level,
+                                const SVgroupInfo* pVgroup) {
+  // the splits of the top level subplan would have no parent to merge them
+  if (0 == level) {
+    return 1;
+  }
+  SScanLogicNode* pScan = getSplitScan(pSubplan->pNode);
+  if (NULL == pScan) {
+    return 1;
+  }
+  if (SPLIT_FLAG_TEST_MASK(pSubplan->splitFlag, SPLIT_FLAG_PART_TABLE_SPLIT)) {
+    return getPartTableScanSplitNum(pCxt->pPlanCxt, pScan, pVgroup);
+  }
+  return getScanTableSplitNum(pCxt->pPlanCxt, pScan);
+}
+
+static int32_t setScanTableSplit(SLogicNode* pNode, int32_t splitIdx, int32_t splitNum) {
+  SScanLogicNode* pScan = getSplitScan(pNode);
+  if (NULL == pScan) {
+    return TSDB_CODE_PLAN_INTERNAL_ERROR;
+  }
+  pScan->tableSplitIdx = splitIdx;
+  pScan->tableSplitNum = splitNum;
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t scaleOutByVgroups(SScaleOutContext* pCxt, SLogicSubplan* pSubplan, int32_t level, bool splitTables,
+                                 SNodeList* pGroup) {
   int32_t code = TSDB_CODE_SUCCESS;
   for (int32_t i = 0; i < pSubplan->pVgroupList->numOfVgroups; ++i) {
-    SLogicSubplan* pNewSubplan = singleCloneSubLogicPlan(pCxt, pSubplan, level);
-    if (NULL == pNewSubplan) {
-      return terrno;
-    }
-    code = setScanVgroup(pNewSubplan->pNode, pSubplan->pVgroupList->vgroups + i);
-    if (TSDB_CODE_SUCCESS == code) {
-      code = nodesListStrictAppend(pGroup, (SNode*)pNewSubplan);
-    }
-    if (TSDB_CODE_SUCCESS != code) {
-      break;
+    int32_t splitNum = splitTables ? getTableSplitNum(pCxt, pSubplan, level, pSubplan->pVgroupList->vgroups + i) : 1;
+    for (int32_t j = 0; j < splitNum; ++j) {
+      SLogicSubplan* pNewSubplan = singleCloneSubLogicPlan(pCxt, pSubplan, level);
+      if (NULL == pNewSubplan) {
+        return terrno;
+      }
+      code = setScanVgroup(pNewSubplan->pNode, pSubplan->pVgroupList->vgroups + i);
+      if (TSDB_CODE_SUCCESS == code && splitNum > 1) {
+        code = setScanTableSplit(pNewSubplan->pNode, j, splitNum);
+      }
+      if (TSDB_CODE_SUCCESS == code) {
+        code = nodesListStrictAppend(pGroup, (SNode*)pNewSubplan);
+      } else {
+        nodesDestroyNode((SNode*)pNewSubplan);
+      }
+      if (TSDB_CODE_SUCCESS != code) {
+        return code;
+      }
     }
   }
   return code;
@@ -119,14 +165,14 @@ static int32_t scaleOutForInsert(SScaleOutContext* pCxt, SLogicSubplan* pSubplan
 static int32_t scaleOutForModify(SScaleOutContext* pCxt, SLogicSubplan* pSubplan, int32_t level, SNodeList* pGroup) {
   SVnodeModifyLogicNode* pNode = (SVnodeModifyLogicNode*)pSubplan->pNode;
   if (MODIFY_TABLE_TYPE_DELETE == pNode->modifyType) {
-    return scaleOutByVgroups(pCxt, pSubplan, level, pGroup);
+    return scaleOutByVgroups(pCxt, pSubplan, level, false, pGroup);
   }
   return scaleOutForInsert(pCxt, pSubplan, level, pGroup);
 }
 
 static int32_t scaleOutForScan(SScaleOutContext* pCxt, SLogicSubplan* pSubplan, int32_t level, SNodeList* pGroup) {
   if (pSubplan->pVgroupList && !pCxt->pPlanCxt->streamQuery) {
-    return scaleOutByVgroups(pCxt, pSubplan, level, pGroup);
+    return scaleOutByVgroups(pCxt, pSubplan, level, true, pGroup);
   } else {
     return scaleOutForMerge(pCxt, pSubplan, level, pGroup);
   }
@@ -17,14 +17,6 @@
 #include "planInt.h"
 #include "tglobal.h"
 
-#define SPLIT_FLAG_MASK(n) (1 << n)
-
-#define SPLIT_FLAG_STABLE_SPLIT SPLIT_FLAG_MASK(0)
-#define SPLIT_FLAG_INSERT_SPLIT SPLIT_FLAG_MASK(1)
-
-#define SPLIT_FLAG_SET_MASK(val, mask)  (val) |= (mask)
-#define SPLIT_FLAG_TEST_MASK(val, mask) (((val) & (mask)) != 0)
-
 typedef struct SSplitContext {
   SPlanContext* pPlanCxt;
   uint64_t      queryId;
@@ -601,12 +593,13 @@ static int32_t stbSplCreatePartMidWindowNode(SWindowLogicNode* pMergeWindow, SLo
   return code;
 }
 
-static int32_t stbSplGetNumOfVgroups(SLogicNode* pNode) {
+static int32_t stbSplGetNumOfVgroups(const SPlanContext* pPlanCxt, SLogicNode* pNode) {
   if (QUERY_NODE_LOGIC_PLAN_SCAN == nodeType(pNode)) {
-    return ((SScanLogicNode*)pNode)->pVgroupList->numOfVgroups;
+    SScanLogicNode* pScan = (SScanLogicNode*)pNode;
+    return pScan->pVgroupList->numOfVgroups * getScanTableSplitNum(pPlanCxt, pScan);
   } else {
     if (1 == LIST_LENGTH(pNode->pChildren)) {
-      return stbSplGetNumOfVgroups((SLogicNode*)nodesListGetNode(pNode->pChildren, 0));
+      return stbSplGetNumOfVgroups(pPlanCxt, (SLogicNode*)nodesListGetNode(pNode->pChildren, 0));
     }
   }
   return 0;
@@ -658,7 +651,7 @@ static int32_t stbSplCreateMergeNode(SSplitContext* pCxt, SLogicSubplan* pSubpla
     return code;
   }
   pMerge->needSort = needSort;
-  pMerge->numOfChannels = stbSplGetNumOfVgroups(pPartChild);
+  pMerge->numOfChannels = stbSplGetNumOfVgroups(pCxt->pPlanCxt, pPartChild);
   pMerge->srcGroupId = pCxt->groupId;
   pMerge->srcEndGroupId = pCxt->groupId;
   pMerge->node.precision = pPartChild->precision;
@@ -984,8 +977,9 @@ static int32_t stbSplSplitWindowForPartTable(SSplitContext* pCxt, SStableSplitIn
   }
   if (TSDB_CODE_SUCCESS == code) {
     pExchange->seqRecvData = stbSplNeedSeqRecvData((SLogicNode*)pExchange);
-    code = nodesListMakeStrictAppend(&pInfo->pSubplan->pChildren,
-                                     (SNode*)splCreateScanSubplan(pCxt, pInfo->pSplitNode, SPLIT_FLAG_STABLE_SPLIT));
+    code = nodesListMakeStrictAppend(
+        &pInfo->pSubplan->pChildren,
+        (SNode*)splCreateScanSubplan(pCxt, pInfo->pSplitNode, SPLIT_FLAG_STABLE_SPLIT | SPLIT_FLAG_PART_TABLE_SPLIT));
   }
   pInfo->pSubplan->subplanType = SUBPLAN_TYPE_MERGE;
   ++(pCxt->groupId);
@@ -1054,8 +1048,9 @@ static int32_t stbSplCreatePartAggNode(SAggLogicNode* pMergeAgg, SLogicNode** pO
 static int32_t stbSplSplitAggNodeForPartTable(SSplitContext* pCxt, SStableSplitInfo* pInfo) {
   int32_t code = splCreateExchangeNodeForSubplan(pCxt, pInfo->pSubplan, pInfo->pSplitNode, SUBPLAN_TYPE_MERGE);
   if (TSDB_CODE_SUCCESS == code) {
-    code = nodesListMakeStrictAppend(&pInfo->pSubplan->pChildren,
-                                     (SNode*)splCreateScanSubplan(pCxt, pInfo->pSplitNode, SPLIT_FLAG_STABLE_SPLIT));
+    code = nodesListMakeStrictAppend(
+        &pInfo->pSubplan->pChildren,
+        (SNode*)splCreateScanSubplan(pCxt, pInfo->pSplitNode, SPLIT_FLAG_STABLE_SPLIT | SPLIT_FLAG_PART_TABLE_SPLIT));
   }
   ++(pCxt->groupId);
   return code;
@@ -17,6 +17,7 @@
 #include "planInt.h"
 #include "scalar.h"
 #include "filter.h"
+#include "tglobal.h"
 
 static char* getUsageErrFormat(int32_t errCode) {
   switch (errCode) {
@@ -716,6 +717,229 @@ int32_t tagScanSetExecutionMode(SScanLogicNode* pScan) {
   return TSDB_CODE_SUCCESS;
 }
 
+// The super table scan of each vgroup can be split into several tasks, each of which scans a disjoint subset of the
+// child tables. The parent merges them exactly as it merges the scans of different vgroups.
+static bool scanCanSplitByTable(bool streamQuery, const SScanLogicNode* pScan) {
+  return !streamQuery && NULL != pScan->pVgroupList && !pScan->node.dynamicOp && TSDB_SUPER_TABLE == pScan->tableType &&
+         (SCAN_TYPE_TABLE == pScan->scanType || SCAN_TYPE_TABLE_MERGE == pScan->scanType);
+}
+
+int32_t getScanTableSplitNum(const SPlanContext* pCxt, const SScanLogicNode* pScan) {
+  if (pCxt->vnodeParallelism <= 1 || !scanCanSplitByTable(pCxt->streamQuery, pScan)) {
+    return 1;
+  }
+  return pCxt->vnodeParallelism;
+}
+
+/*
+ * The groups of an aggregation partitioned by table never span two tasks and their results are only exchanged, so
+ * the splits of a vgroup need not match the other vgroups. A vgroup is split by its number of child tables.
+ */
+int32_t getPartTableScanSplitNum(const SPlanContext* pCxt, const SScanLogicNode* pScan, const SVgroupInfo* pVgroup) {
+  int32_t splitNum = getScanTableSplitNum(pCxt, pScan);
+  if (pCxt->partTableShardSize <= 0 || !scanCanSplitByTable(pCxt->streamQuery, pScan)) {
+    return splitNum;
+  }
+
+  // as for the cost, a vgroup without a known number of tables is assumed to hold a few of them
+  int64_t vgTables = (pVgroup->numOfTable > 0) ? (int64_t)pVgroup->numOfTable * TSDB_TABLE_NUM_UNIT
+                                               : PLAN_COST_VGROUP_TABLES;
+  double  sel = estimateCondSelectivity(pScan->pTagIndexCond) * estimateCondSelectivity(pScan->pTagCond);
+  int64_t tables = (int64_t)(vgTables * sel);
+  int64_t shards = (tables + pCxt->partTableShardSize - 1) / pCxt->partTableShardSize;
+  return (int32_t)TMAX(splitNum, TMIN(shards, PLAN_MAX_PART_TABLE_SPLITS));
+}
+
+double estimateCondSelectivity(const SNode* pCond) {
+  if (NULL == pCond) {
+    return 1.0;
+  }
+
+  switch (nodeType(pCond)) {
+    case QUERY_NODE_LOGIC_CONDITION: {
+      const SLogicConditionNode* pLogic = (const SLogicConditionNode*)pCond;
+      SNode*                     pNode = NULL;
+      double                     sel = 1.0;
+      if (LOGIC_COND_TYPE_AND == pLogic->condType) {
+        FOREACH(pNode, pLogic->pParameterList) { sel *= estimateCondSelectivity(pNode); }
+        return sel;
+      }
+      if (LOGIC_COND_TYPE_OR == pLogic->condType) {
+        FOREACH(pNode, pLogic->pParameterList) { sel *= 1.0 - estimateCondSelectivity(pNode); }
+        return 1.0 - sel;
+      }
+      return 1.0 - estimateCondSelectivity(nodesListGetNode(pLogic->pParameterList, 0));
+    }
+    case QUERY_NODE_OPERATOR: {
+      const SOperatorNode* pOp = (const SOperatorNode*)pCond;
+      switch (pOp->opType) {
+        case OP_TYPE_EQUAL:
+        case OP_TYPE_IS_NULL:
+          return PLAN_COST_EQUAL_SEL;
+        case OP_TYPE_NOT_EQUAL:
+        case OP_TYPE_IS_NOT_NULL:
+        case OP_TYPE_NOT_IN:
+          return 1.0 - PLAN_COST_EQUAL_SEL;
+        case OP_TYPE_GREATER_THAN:
+        case OP_TYPE_GREATER_EQUAL:
+        case OP_TYPE_LOWER_THAN:
+        case OP_TYPE_LOWER_EQUAL:
+          return PLAN_COST_RANGE_SEL;
+        case OP_TYPE_IN: {
+          int32_t num = (NULL != pOp->pRight && QUERY_NODE_NODE_LIST == nodeType(pOp->pRight))
+                            ? LIST_LENGTH(((SNodeListNode*)pOp->pRight)->pNodeList)
+                            : 1;
+          return TMIN(PLAN_COST_DEFAULT_SEL, num * PLAN_COST_EQUAL_SEL);
+        }
+        case OP_TYPE_LIKE:
+        case OP_TYPE_MATCH:
+          return PLAN_COST_LIKE_SEL;
+        case OP_TYPE_NOT_LIKE:
+        case OP_TYPE_NMATCH:
+          return 1.0 - PLAN_COST_LIKE_SEL;
+        default:
+          break;
+      }
+      break;
+    }
+    default:
+      break;
+  }
+  return PLAN_COST_DEFAULT_SEL;
+}
+
+static double estimateTimeRangeSelectivity(const STimeWindow* pRange) {
+  if (pRange->skey > pRange->ekey) {
+    return 0;
+  }
+
+  bool lower = (INT64_MIN != pRange->skey);
+  bool upper = (INT64_MAX != pRange->ekey);
+  if (lower && upper) {
+    return PLAN_COST_EQUAL_SEL;
+  }
+  return (lower || upper) ? PLAN_COST_RANGE_SEL : 1.0;
+}
+
+static int64_t estimateScanTables(const SScanLogicNode* pScan) {
+  if (TSDB_SUPER_TABLE != pScan->tableType) {
+    return 1;
+  }
+
+  // the catalog only knows the number of tables of each vgroup roughly
+  int64_t tables = 0;
+  int32_t vgNum = (NULL != pScan->pVgroupList) ? pScan->pVgroupList->numOfVgroups : 1;
+  for (int32_t i = 0; i < vgNum; ++i) {
+    int32_t num = (NULL != pScan->pVgroupList) ? pScan->pVgroupList->vgroups[i].numOfTable : 0;
+    tables += (num > 0) ? (int64_t)num * TSDB_TABLE_NUM_UNIT : PLAN_COST_VGROUP_TABLES;
+  }
+
+  double sel = estimateCondSelectivity(pScan->pTagIndexCond) * estimateCondSelectivity(pScan->pTagCond);
+  return TMAX(1, (int64_t)(tables * sel));
+}
+
+static int64_t estimateScanRows(const SScanLogicNode* pScan) {
+  int64_t tables = estimateScanTables(pScan);
+  switch (pScan->scanType) {
+    case SCAN_TYPE_TAG:
+    case SCAN_TYPE_LAST_ROW:
+    case SCAN_TYPE_BLOCK_INFO:
+      return tables;
+    case SCAN_TYPE_TABLE_COUNT:
+      return 1;
+    default:
+      break;
+  }
+
+  double rows = (double)tables * PLAN_COST_TABLE_ROWS * estimateTimeRangeSelectivity(&pScan->scanRange) *
+                estimateCondSelectivity(pScan->node.pConditions);
+  return TMAX(1, (int64_t)rows);
+}
+
+static int64_t estimateJoinRows(const SJoinLogicNode* pJoin) {
+  if (LIST_LENGTH(pJoin->node.pChildren) != 2) {
+    return 1;
+  }
+
+  int64_t left = estimateLogicNodeRows((SLogicNode*)nodesListGetNode(pJoin->node.pChildren, 0));
+  int64_t right = estimateLogicNodeRows((SLogicNode*)nodesListGetNode(pJoin->node.pChildren, 1));
+  double  rows = 0;
+  switch (pJoin->joinType) {
+    case JOIN_TYPE_INNER:
+      // a row matches at most one row of each table on the primary timestamp
+      rows = (NULL != pJoin->pPrimKeyEqCond) ? TMIN(left, right) : (double)left * right;
+      rows *= estimateCondSelectivity(pJoin->pColEqCond) * estimateCondSelectivity(pJoin->pColOnCond);
+      break;
+    case JOIN_TYPE_LEFT:
+      rows = left;
+      break;
+    case JOIN_TYPE_RIGHT:
+      rows = right;
+      break;
+    case JOIN_TYPE_FULL:
+      rows = (double)left + right;
+      break;
+    default:
+      rows = TMAX(left, right);
+      break;
+  }
+  return TMAX(1, (int64_t)TMIN(rows, (double)INT64_MAX / 2));
+}
+
+static int64_t estimateChildrenRows(const SLogicNode* pNode) {
+  int64_t rows = 0;
+  SNode*  pChild = NULL;
+  FOREACH(pChild, pNode->pChildren) { rows += estimateLogicNodeRows((SLogicNode*)pChild); }
+  return rows;
+}
+
+int64_t estimateLogicNodeRows(const SLogicNode* pNode) {
+  int64_t rows = 0;
+  switch (nodeType(pNode)) {
+    case QUERY_NODE_LOGIC_PLAN_SCAN:
+      // the scan conditions are already counted
+      return estimateScanRows((const SScanLogicNode*)pNode);
+    case QUERY_NODE_LOGIC_PLAN_JOIN:
+      rows = estimateJoinRows((const SJoinLogicNode*)pNode);
+      break;
+    case QUERY_NODE_LOGIC_PLAN_AGG:
+      rows = (NULL == ((const SAggLogicNode*)pNode)->pGroupKeys)
+                 ? 1
+                 : TMAX(1, (int64_t)(estimateChildrenRows(pNode) * PLAN_COST_GROUP_RATIO));
+      break;
+    case QUERY_NODE_LOGIC_PLAN_WINDOW:
+      rows = TMAX(1, (int64_t)(estimateChildrenRows(pNode) * PLAN_COST_GROUP_RATIO));
+      break;
+    default:
+      rows = estimateChildrenRows(pNode);
+      break;
+  }
+
+  rows = TMAX(1, (int64_t)(rows * estimateCondSelectivity(pNode->pConditions)));
+  if (NULL != pNode->pLimit) {
+    const SLimitNode* pLimit = (const SLimitNode*)pNode->pLimit;
+    if (pLimit->limit >= 0) {
+      rows = TMIN(rows, pLimit->limit + TMAX(0, pLimit->offset));
+    }
+  }
+  return rows;
+}
+
+int32_t estimateLogicNodeRowSize(const SLogicNode* pNode) {
+  int32_t size = 0;
+  SNode*  pTarget = NULL;
+  FOREACH(pTarget, pNode->pTargets) { size += ((SExprNode*)pTarget)->resType.bytes; }
+  return size;
+}
+
+void setJoinInputStat(SJoinLogicNode* pJoin) {
+  for (int32_t i = 0; i < 2 && i < LIST_LENGTH(pJoin->node.pChildren); ++i) {
+    SLogicNode* pChild = (SLogicNode*)nodesListGetNode(pJoin->node.pChildren, i);
+    pJoin->inputStat[i].inputRowNum = estimateLogicNodeRows(pChild);
+    pJoin->inputStat[i].inputRowSize = estimateLogicNodeRowSize(pChild);
+  }
+}
+
 bool isColRefExpr(const SColumnNode* pCol, const SExprNode* pExpr) {
   if (pCol->projRefIdx > 0) return pCol->projRefIdx == pExpr->projIdx;
 
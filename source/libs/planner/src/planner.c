@@ -47,6 +47,9 @@ int32_t qCreateQueryPlan(SPlanContext* pCxt, SQueryPlan** pPlan, SArray* pExecNo
   SLogicSubplan*   pLogicSubplan = NULL;
   SQueryLogicPlan* pLogicPlan = NULL;
 
+  pCxt->vnodeParallelism = tsQueryVnodeParallelism;
+  pCxt->partTableShardSize = tsQueryPartTableShardSize;
+
   int32_t code = nodesAcquireAllocator(pCxt->allocatorId);
   if (TSDB_CODE_SUCCESS == code) {
     code = createLogicPlan(pCxt, &pLogicSubplan);
@@ -184,3 +187,294 @@ SQueryPlan* qStringToQueryPlan(const char* pStr) {
 }
 
 void qDestroyQueryPlan(SQueryPlan* pPlan) { nodesDestroyNode((SNode*)pPlan); }
+
+typedef struct SPlanTemplateSubplan {
+  char*          pMsg;
+  int32_t        msgLen;
+  int32_t        level;
+  SQueryNodeStat execNodeStat;  // not part of the subplan msg
+  SArray*        pValueSlots;   // SArray<int16_t>, placeholder number of each collected value node, 0 for constants
+  SArray*        pChildren;     // SArray<int32_t>, indexes of the child subplans
+} SPlanTemplateSubplan;
+
+struct SPlanTemplate {
+  int32_t      numOfLevels;
+  int32_t      numOfSubplans;
+  SExplainInfo explainInfo;
+  SArray*      pSubplans;  // SArray<SPlanTemplateSubplan>, level by level
+};
+
+typedef struct SCollectValuesCxt {
+  SArray* pValues;
+  int32_t code;
+} SCollectValuesCxt;
+
+static EDealRes collectValueNode(SNode* pNode, void* pContext) {
+  SCollectValuesCxt* pCxt = pContext;
+  if (QUERY_NODE_VALUE == nodeType(pNode) && NULL == taosArrayPush(pCxt->pValues, &pNode)) {
+    pCxt->code = terrno;
+    return DEAL_RES_ERROR;
+  }
+  return DEAL_RES_CONTINUE;
+}
+
+static void collectPhysiNodeValues(SPhysiNode* pNode, SCollectValuesCxt* pCxt) {
+  nodesWalkExpr(pNode->pConditions, collectValueNode, pCxt);
+  SNode* pChild = NULL;
+  FOREACH(pChild, pNode->pChildren) { collectPhysiNodeValues((SPhysiNode*)pChild, pCxt); }
+}
+
+// The value nodes of the filter conditions, which is where the parser lets placeholders reach the plan. The order
+// only depends on the plan structure, so it is the same for a subplan and its copy decoded from the msg.
+static int32_t collectSubplanValues(SSubplan* pSubplan, SArray* pValues) {
+  SCollectValuesCxt cxt = {.pValues = pValues, .code = TSDB_CODE_SUCCESS};
+  taosArrayClear(pValues);
+  nodesWalkExpr(pSubplan->pTagCond, collectValueNode, &cxt);
+  nodesWalkExpr(pSubplan->pTagIndexCond, collectValueNode, &cxt);
+  if (NULL != pSubplan->pNode) {
+    collectPhysiNodeValues(pSubplan->pNode, &cxt);
+  }
+  return cxt.code;
+}
+
+static int32_t rebindPlaceholderValue(SValueNode* pDst, const SValueNode* pSrc) {
+  SValueNode* pNew = NULL;
+  int32_t     code = nodesCloneNode((const SNode*)pSrc, (SNode**)&pNew);
+  if (TSDB_CODE_SUCCESS == code) {
+    // keep the alias and slot of the plan node, the old value leaves with pNew
+    TSWAP(pDst->node.resType, pNew->node.resType);
+    TSWAP(pDst->literal, pNew->literal);
+    TSWAP(pDst->datum, pNew->datum);
+    TSWAP(pDst->isNull, pNew->isNull);
+    TSWAP(pDst->translate, pNew->translate);
+    TSWAP(pDst->typeData, pNew->typeData);
+    nodesDestroyNode((SNode*)pNew);
+  }
+  return code;
+}
+
+void qDestroyPlanTemplate(SPlanTemplate* pTemplate) {
+  if (NULL == pTemplate) {
+    return;
+  }
+  int32_t num = taosArrayGetSize(pTemplate->pSubplans);
+  for (int32_t i = 0; i < num; ++i) {
+    SPlanTemplateSubplan* pSubplan = taosArrayGet(pTemplate->pSubplans, i);
+    taosMemoryFree(pSubplan->pMsg);
+    taosArrayDestroy(pSubplan->pValueSlots);
+    taosArrayDestroy(pSubplan->pChildren);
+  }
+  taosArrayDestroy(pTemplate->pSubplans);
+  taosMemoryFree(pTemplate);
+}
+
+static int32_t getSubplanIndex(const SArray* pSubplans, const SSubplan* pSubplan) {
+  int32_t num = taosArrayGetSize(pSubplans);
+  for (int32_t i = 0; i < num; ++i) {
+    if (pSubplan == *(SSubplan**)taosArrayGet(pSubplans, i)) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+static int32_t createTemplateSubplan(const SArray* pSubplans, SSubplan* pSubplan, int32_t level, SArray* pValues,
+                                     int32_t placeholderNum, int32_t* pPlaceholderRefs, SPlanTemplateSubplan* pTmpl) {
+  pTmpl->level = level;
+  pTmpl->execNodeStat = pSubplan->execNodeStat;
+  pTmpl->pValueSlots = taosArrayInit(8, sizeof(int16_t));
+  pTmpl->pChildren = taosArrayInit(4, sizeof(int32_t));
+  if (NULL == pTmpl->pValueSlots || NULL == pTmpl->pChildren) {
+    return terrno;
+  }
+
+  int32_t code = collectSubplanValues(pSubplan, pValues);
+  for (int32_t i = 0; TSDB_CODE_SUCCESS == code && i < taosArrayGetSize(pValues); ++i) {
+    int16_t placeholderNo = (*(SValueNode**)taosArrayGet(pValues, i))->placeholderNo;
+    if (placeholderNo > 0) {
+      // refs[placeholderNum] counts the unknown placeholders
+      ++pPlaceholderRefs[TMIN(placeholderNo, placeholderNum + 1) - 1];
+    }
+    if (NULL == taosArrayPush(pTmpl->pValueSlots, &placeholderNo)) {
+      code = terrno;
+    }
+  }
+
+  SNode* pChild = NULL;
+  FOREACH(pChild, pSubplan->pChildren) {
+    int32_t index = getSubplanIndex(pSubplans, (SSubplan*)pChild);
+    if (TSDB_CODE_SUCCESS == code && (index < 0 || NULL == taosArrayPush(pTmpl->pChildren, &index))) {
+      code = index < 0 ? TSDB_CODE_PLAN_INTERNAL_ERROR : terrno;
+    }
+  }
+  if (TSDB_CODE_SUCCESS == code) {
+    code = nodesNodeToMsg((const SNode*)pSubplan, &pTmpl->pMsg, &pTmpl->msgLen);
+  }
+  return code;
+}
+
+int32_t qCreatePlanTemplate(const SQueryPlan* pPlan, int32_t placeholderNum, SPlanTemplate** pTemplate) {
+  *pTemplate = NULL;
+  if (NULL != pPlan->pPostPlan || EXPLAIN_MODE_DISABLE != pPlan->explainInfo.mode) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  SPlanTemplate* pTmpl = taosMemoryCalloc(1, sizeof(SPlanTemplate));
+  SArray*        pSubplans = taosArrayInit(pPlan->numOfSubplans, POINTER_BYTES);
+  SArray*        pValues = taosArrayInit(8, POINTER_BYTES);
+  int32_t*       pPlaceholderRefs = taosMemoryCalloc(placeholderNum + 1, sizeof(int32_t));
+  int32_t        code = TSDB_CODE_SUCCESS;
+  if (NULL == pTmpl || NULL == pSubplans || NULL == pValues || NULL == pPlaceholderRefs) {
+    code = terrno;
+  }
+  if (TSDB_CODE_SUCCESS == code) {
+    pTmpl->numOfLevels = LIST_LENGTH(pPlan->pSubplans);
+    pTmpl->numOfSubplans = pPlan->numOfSubplans;
+    pTmpl->explainInfo = pPlan->explainInfo;
+    pTmpl->pSubplans = taosArrayInit(pPlan->numOfSubplans, sizeof(SPlanTemplateSubplan));
+    if (NULL == pTmpl->pSubplans) {
+      code = terrno;
+    }
+  }
+
+  SNode* pLevel = NULL;
+  SNode* pSubplan = NULL;
+  FOREACH(pLevel, pPlan->pSubplans) {
+    FOREACH(pSubplan, ((SNodeListNode*)pLevel)->pNodeList) {
+      if (TSDB_CODE_SUCCESS == code && NULL == taosArrayPush(pSubplans, &pSubplan)) {
+        code = terrno;
+      }
+    }
+  }
+
+  int32_t level = 0;
+  FOREACH(pLevel, pPlan->pSubplans) {
+    FOREACH(pSubplan, ((SNodeListNode*)pLevel)->pNodeList) {
+      SPlanTemplateSubplan tmplSubplan = {0};
+      if (TSDB_CODE_SUCCESS == code) {
+        code = createTemplateSubplan(pSubplans, (SSubplan*)pSubplan, level, pValues, placeholderNum, pPlaceholderRefs,
+                                     &tmplSubplan);
+      }
+      if (TSDB_CODE_SUCCESS == code && NULL == taosArrayPush(pTmpl->pSubplans, &tmplSubplan)) {
+        code = terrno;
+      }
+      if (TSDB_CODE_SUCCESS != code) {
+        taosMemoryFree(tmplSubplan.pMsg);
+        taosArrayDestroy(tmplSubplan.pValueSlots);
+        taosArrayDestroy(tmplSubplan.pChildren);
+      }
+    }
+    ++level;
+  }
+
+  // a placeholder missing from the conditions was consumed while planning, e.g. folded into a constant
+  bool reusable = (NULL != pPlaceholderRefs && 0 == pPlaceholderRefs[placeholderNum]);
+  for (int32_t i = 0; reusable && i < placeholderNum; ++i) {
+    reusable = (pPlaceholderRefs[i] > 0);
+  }
+
+  if (TSDB_CODE_SUCCESS == code && reusable) {
+    *pTemplate = pTmpl;
+    pTmpl = NULL;
+  }
+  qDestroyPlanTemplate(pTmpl);
+  taosArrayDestroy(pSubplans);
+  taosArrayDestroy(pValues);
+  taosMemoryFree(pPlaceholderRefs);
+  return code;
+}
+
+static int32_t buildSubplanFromTemplate(const SPlanTemplateSubplan* pTmpl, uint64_t queryId,
+                                        const SArray* pPlaceholderValues, SArray* pValues, SSubplan** ppSubplan) {
+  SSubplan* pSubplan = NULL;
+  int32_t   code = nodesMsgToNode(pTmpl->pMsg, pTmpl->msgLen, (SNode**)&pSubplan);
+  if (TSDB_CODE_SUCCESS == code) {
+    pSubplan->id.queryId = queryId;
+    pSubplan->execNodeStat = pTmpl->execNodeStat;
+    code = collectSubplanValues(pSubplan, pValues);
+  }
+  if (TSDB_CODE_SUCCESS == code && taosArrayGetSize(pValues) != taosArrayGetSize(pTmpl->pValueSlots)) {
+    code = TSDB_CODE_PLAN_INTERNAL_ERROR;
+  }
+  for (int32_t i = 0; TSDB_CODE_SUCCESS == code && i < taosArrayGetSize(pValues); ++i) {
+    int16_t placeholderNo = *(int16_t*)taosArrayGet(pTmpl->pValueSlots, i);
+    if (placeholderNo > 0) {
+      SValueNode* pValue = *(SValueNode**)taosArrayGet(pValues, i);
+      code = rebindPlaceholderValue(pValue, taosArrayGetP(pPlaceholderValues, placeholderNo - 1));
+      pValue->placeholderNo = placeholderNo;
+    }
+  }
+  if (TSDB_CODE_SUCCESS == code) {
+    *ppSubplan = pSubplan;
+  } else {
+    nodesDestroyNode((SNode*)pSubplan);
+  }
+  return code;
+}
+
+static int32_t linkTemplateSubplans(const SPlanTemplate* pTemplate, SArray* pSubplans) {
+  int32_t code = TSDB_CODE_SUCCESS;
+  for (int32_t i = 0; TSDB_CODE_SUCCESS == code && i < taosArrayGetSize(pSubplans); ++i) {
+    const SPlanTemplateSubplan* pTmpl = taosArrayGet(pTemplate->pSubplans, i);
+    SSubplan*                   pParent = taosArrayGetP(pSubplans, i);
+    for (int32_t j = 0; TSDB_CODE_SUCCESS == code && j < taosArrayGetSize(pTmpl->pChildren); ++j) {
+      SSubplan* pChild = taosArrayGetP(pSubplans, *(int32_t*)taosArrayGet(pTmpl->pChildren, j));
+      code = nodesListMakeAppend(&pParent->pChildren, (SNode*)pChild);
+      if (TSDB_CODE_SUCCESS == code) {
+        code = nodesListMakeAppend(&pChild->pParents, (SNode*)pParent);
+      }
+    }
+  }
+  return code;
+}
+
+int32_t qBuildPlanFromTemplate(const SPlanTemplate* pTemplate, uint64_t queryId, const SArray* pPlaceholderValues,
+                               SQueryPlan** pPlan) {
+  SQueryPlan* pNewPlan = NULL;
+  SArray*     pSubplans = taosArrayInit(pTemplate->numOfSubplans, POINTER_BYTES);
+  SArray*     pValues = taosArrayInit(8, POINTER_BYTES);
+  int32_t     code = (NULL == pSubplans || NULL == pValues) ? terrno : TSDB_CODE_SUCCESS;
+  if (TSDB_CODE_SUCCESS == code) {
+    code = nodesMakeNode(QUERY_NODE_PHYSICAL_PLAN, (SNode**)&pNewPlan);
+  }
+  if (TSDB_CODE_SUCCESS == code) {
+    pNewPlan->queryId = queryId;
+    pNewPlan->numOfSubplans = pTemplate->numOfSubplans;
+    pNewPlan->explainInfo = pTemplate->explainInfo;
+  }
+
+  SNodeListNode* pLevel = NULL;
+  int32_t        level = -1;
+  for (int32_t i = 0; TSDB_CODE_SUCCESS == code && i < taosArrayGetSize(pTemplate->pSubplans); ++i) {
+    const SPlanTemplateSubplan* pTmpl = taosArrayGet(pTemplate->pSubplans, i);
+    if (pTmpl->level != level) {
+      level = pTmpl->level;
+      code = nodesMakeNode(QUERY_NODE_NODE_LIST, (SNode**)&pLevel);
+      if (TSDB_CODE_SUCCESS == code) {
+        code = nodesListMakeStrictAppend(&pNewPlan->pSubplans, (SNode*)pLevel);
+      }
+    }
+    SSubplan* pSubplan = NULL;
+    if (TSDB_CODE_SUCCESS == code) {
+      code = buildSubplanFromTemplate(pTmpl, queryId, pPlaceholderValues, pValues, &pSubplan);
+    }
+    if (TSDB_CODE_SUCCESS == code) {
+      code = nodesListMakeStrictAppend(&pLevel->pNodeList, (SNode*)pSubplan);
+    }
+    if (TSDB_CODE_SUCCESS == code && NULL == taosArrayPush(pSubplans, &pSubplan)) {
+      code = terrno;
+    }
+  }
+  if (TSDB_CODE_SUCCESS == code) {
+    code = linkTemplateSubplans(pTemplate, pSubplans);
+  }
+
+  if (TSDB_CODE_SUCCESS == code) {
+    *pPlan = pNewPlan;
+  } else {
+    nodesDestroyNode((SNode*)pNewPlan);
+  }
+  taosArrayDestroy(pSubplans);
+  taosArrayDestroy(pValues);
+  return code;
+}
@@ -18,7 +18,55 @@
 
 using namespace std;
 
-class PlanJoinTest : public PlannerTestBase {};
+namespace {
+
+const SHashJoinPhysiNode* findHashJoin(const SPhysiNode* pNode) {
+  if (QUERY_NODE_PHYSICAL_PLAN_HASH_JOIN == nodeType(pNode)) {
+    return (const SHashJoinPhysiNode*)pNode;
+  }
+  SNode* pChild = NULL;
+  FOREACH(pChild, pNode->pChildren) {
+    const SHashJoinPhysiNode* pJoin = findHashJoin((const SPhysiNode*)pChild);
+    if (NULL != pJoin) {
+      return pJoin;
+    }
+  }
+  return NULL;
+}
+
+}  // namespace
+
+class PlanJoinTest : public PlannerTestBase {
+ protected:
+  // the input the hash join of the last plan builds on, as the executor chooses it from the estimates, -1 if the
+  // plan has no hash join
+  int32_t hashJoinBuildSide() {
+    SQueryPlan* pPlan = NULL;
+    if (TSDB_CODE_SUCCESS != nodesStringToNode(physiPlan().c_str(), (SNode**)&pPlan)) {
+      return -2;
+    }
+
+    const SHashJoinPhysiNode* pJoin = NULL;
+    SNode*                    pLevel = NULL;
+    FOREACH(pLevel, pPlan->pSubplans) {
+      SNode* pSubplan = NULL;
+      FOREACH(pSubplan, ((SNodeListNode*)pLevel)->pNodeList) {
+        if (NULL == pJoin) {
+          pJoin = findHashJoin(((SSubplan*)pSubplan)->pNode);
+        }
+      }
+    }
+
+    int32_t side = -1;
+    if (NULL != pJoin) {
+      double left = (double)pJoin->inputStat[0].inputRowNum * TMAX(1, pJoin->inputStat[0].inputRowSize);
+      double right = (double)pJoin->inputStat[1].inputRowNum * TMAX(1, pJoin->inputStat[1].inputRowSize);
+      side = (left <= right) ? 0 : 1;
+    }
+    nodesDestroyNode((SNode*)pPlan);
+    return side;
+  }
+};
 
 TEST_F(PlanJoinTest, basic) {
   useDb("root", "test");
@@ -58,3 +106,25 @@ TEST_F(PlanJoinTest, multiJoin) {
 
   run("SELECT t1.c1, t2.c1 FROM st1s1 t1 JOIN st1s2 t2 ON t1.ts = t2.ts JOIN st1s3 t3 ON t1.ts = t3.ts");
 }
+
+TEST_F(PlanJoinTest, costBasedHashJoin) {
+  useDb("root", "test");
+
+  // the child table is much smaller than the super table, the join feeds an aggregate
+  run("SELECT COUNT(*) FROM st1s1 t1 JOIN st2 t2 ON t1.ts = t2.ts");
+  ASSERT_EQ(hashJoinBuildSide(), 0);
+
+  run("SELECT COUNT(*) FROM st2 t1 JOIN st1s1 t2 ON t1.ts = t2.ts");
+  ASSERT_EQ(hashJoinBuildSide(), 1);
+
+  run("SELECT t2.c1, COUNT(*) FROM st1s1 t1 JOIN st2 t2 ON t1.ts = t2.ts AND t1.ts > now - 1d GROUP BY t2.c1");
+  ASSERT_EQ(hashJoinBuildSide(), 0);
+
+  // inputs of about the same size
+  run("SELECT COUNT(*) FROM st1 t1 JOIN st2 t2 ON t1.ts = t2.ts");
+  ASSERT_EQ(hashJoinBuildSide(), -1);
+
+  // the rows of a plain join keep their timestamp order
+  run("SELECT t1.c1, t2.c1 FROM st1s1 t1 JOIN st2 t2 ON t1.ts = t2.ts");
+  ASSERT_EQ(hashJoinBuildSide(), -1);
+}
@@ -13,11 +13,89 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+
 #include "planTestUtil.h"
+#include "planner.h"
+#include "tglobal.h"
 
 using namespace std;
 
-class PlanSuperTableTest : public PlannerTestBase {};
+namespace {
+
+struct SPlanLimit {
+  bool    slimit;
+  int64_t limit;
+  int64_t offset;
+
+  bool operator==(const SPlanLimit& other) const {
+    return slimit == other.slimit && limit == other.limit && offset == other.offset;
+  }
+};
+
+void collectLimits(const SPhysiNode* pNode, vector<SPlanLimit>& limits) {
+  if (NULL != pNode->pLimit) {
+    const SLimitNode* pLimit = (const SLimitNode*)pNode->pLimit;
+    limits.push_back({false, pLimit->limit, pLimit->offset});
+  }
+  if (NULL != pNode->pSlimit) {
+    const SLimitNode* pSlimit = (const SLimitNode*)pNode->pSlimit;
+    limits.push_back({true, pSlimit->limit, pSlimit->offset});
+  }
+  SNode* pChild = NULL;
+  FOREACH(pChild, pNode->pChildren) { collectLimits((const SPhysiNode*)pChild, limits); }
+}
+
+// the subplans of a physical plan and the limits they apply, as far as the partitioning by table is concerned
+struct SPlanShape {
+  int32_t            scanSubplans = 0;
+  vector<SPlanLimit> topLimits;   // the limits of the top level subplan
+  vector<SPlanLimit> scanLimits;  // the limits of all scan subplans
+
+  bool hasTopLimit(const SPlanLimit& limit) const {
+    return std::find(topLimits.begin(), topLimits.end(), limit) != topLimits.end();
+  }
+
+  // no scan subplan drops rows or groups that the top level subplan may still return, -1: no limit of this kind
+  bool scanLimitsCover(int64_t rows, int64_t groups) const {
+    for (const SPlanLimit& limit : scanLimits) {
+      int64_t least = limit.slimit ? groups : rows;
+      if (least < 0 || 0 != limit.offset || limit.limit < least) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+}  // namespace
+
+class PlanSuperTableTest : public PlannerTestBase {
+ protected:
+  SPlanShape planShape() {
+    SPlanShape  shape;
+    SQueryPlan* pPlan = NULL;
+    if (TSDB_CODE_SUCCESS != nodesStringToNode(physiPlan().c_str(), (SNode**)&pPlan)) {
+      return shape;
+    }
+
+    SNode* pLevel = NULL;
+    FOREACH(pLevel, pPlan->pSubplans) {
+      SNode* pNode = NULL;
+      FOREACH(pNode, ((SNodeListNode*)pLevel)->pNodeList) {
+        SSubplan* pSubplan = (SSubplan*)pNode;
+        if (0 == pSubplan->level) {
+          collectLimits(pSubplan->pNode, shape.topLimits);
+        } else if (SUBPLAN_TYPE_SCAN == pSubplan->subplanType) {
+          ++shape.scanSubplans;
+          collectLimits(pSubplan->pNode, shape.scanLimits);
+        }
+      }
+    }
+    nodesDestroyNode((SNode*)pPlan);
+    return shape;
+  }
+};
 
 TEST_F(PlanSuperTableTest, pseudoCol) {
   useDb("root", "test");
@@ -40,3 +118,56 @@ TEST_F(PlanSuperTableTest, orderBy) {
 
   run("SELECT -1 * c1, c1 FROM st1 ORDER BY -1 * c1");
 }
+
+TEST_F(PlanSuperTableTest, vnodeParallelism) {
+  useDb("root", "test");
+
+  tsQueryVnodeParallelism = 4;
+
+  run("SELECT * FROM st1");
+
+  run("SELECT COUNT(*) FROM st1 INTERVAL(10s)");
+
+  run("SELECT c1, COUNT(*) FROM st1 PARTITION BY TBNAME");
+
+  tsQueryVnodeParallelism = 1;
+}
+
+TEST_F(PlanSuperTableTest, partTableShard) {
+  useDb("root", "test");
+
+  int32_t shardSize = tsQueryPartTableShardSize;
+  const char* sqls[] = {
+      "SELECT TBNAME, _WSTART, COUNT(*) FROM st1 PARTITION BY TBNAME INTERVAL(10s)",
+      "SELECT TBNAME, COUNT(*) FROM st1 GROUP BY TBNAME",
+      "SELECT TBNAME, _WSTART, COUNT(*) FROM st1 PARTITION BY TBNAME INTERVAL(10s) SLIMIT 2 SOFFSET 1 LIMIT 3 OFFSET 1",
+      "SELECT TBNAME, COUNT(*) FROM st1 GROUP BY TBNAME LIMIT 5 OFFSET 2"};
+
+  // the catalog of the tests knows no table counts, so each vgroup is estimated at PLAN_COST_VGROUP_TABLES tables
+  for (const char* sql : sqls) {
+    tsQueryPartTableShardSize = 0;
+    run(sql);
+    SPlanShape off = planShape();
+
+    tsQueryPartTableShardSize = 50;
+    run(sql);
+    SPlanShape sharded = planShape();
+
+    ASSERT_GT(off.scanSubplans, 0) << sql;
+    ASSERT_EQ(sharded.scanSubplans, off.scanSubplans * 2) << sql;
+    ASSERT_EQ(sharded.topLimits, off.topLimits) << sql;
+  }
+
+  // each shard returns whole groups, the limits and offsets are applied once above the exchange
+  SPlanShape shape = planShape();
+  ASSERT_TRUE(shape.hasTopLimit({false, 5, 2}));
+  ASSERT_TRUE(shape.scanLimitsCover(5 + 2, -1));
+
+  run(sqls[2]);
+  shape = planShape();
+  ASSERT_TRUE(shape.hasTopLimit({true, 2, 1}));
+  ASSERT_TRUE(shape.hasTopLimit({false, 3, 1}));
+  ASSERT_TRUE(shape.scanLimitsCover(3 + 1, 2 + 1));
+
+  tsQueryPartTableShardSize = shardSize;
+}
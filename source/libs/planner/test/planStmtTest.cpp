@@ -181,3 +181,71 @@ TEST_F(PlanStmtTest, multiExec) {
   exec();
   destoryBindParams(pBindParams, 1);
 }
+
+// the placeholders only filter ordinary columns, the plan of the first execution is rebuilt for the later values
+TEST_F(PlanStmtTest, planTemplate) {
+  useDb("root", "test");
+
+  prepare("SELECT * FROM t1 WHERE c1 = ? AND c2 = ?");
+  TAOS_MULTI_BIND* pBindParams = createBindParams(2);
+  (void)buildIntegerParam(pBindParams, 0, 10, TSDB_DATA_TYPE_INT);
+  (void)buildStringParam(pBindParams, 1, "abc", TSDB_DATA_TYPE_VARCHAR, strlen("abc"));
+  bindParams(pBindParams, -1);
+  exec();
+  ASSERT_TRUE(planReusable());
+  destoryBindParams(pBindParams, 2);
+
+  pBindParams = createBindParams(2);
+  (void)buildIntegerParam(pBindParams, 0, 20, TSDB_DATA_TYPE_INT);
+  (void)buildStringParam(pBindParams, 1, "xyzw", TSDB_DATA_TYPE_VARCHAR, strlen("xyzw"));
+  bindParams(pBindParams, -1);
+  exec();
+  ASSERT_TRUE(planReusable());
+  destoryBindParams(pBindParams, 2);
+
+  // the super table is scanned by a subplan per vgroup and merged
+  prepare("SELECT COUNT(*) FROM st1 WHERE c1 > ? PARTITION BY tbname");
+  pBindParams = buildIntegerParam(createBindParams(1), 0, 1, TSDB_DATA_TYPE_INT);
+  bindParams(pBindParams, -1);
+  exec();
+  ASSERT_TRUE(planReusable());
+  destoryBindParams(pBindParams, 1);
+  pBindParams = buildIntegerParam(createBindParams(1), 0, 5, TSDB_DATA_TYPE_INT);
+  bindParams(pBindParams, -1);
+  exec();
+  ASSERT_TRUE(planReusable());
+  destoryBindParams(pBindParams, 1);
+}
+
+// placeholders that drive the scan range, the table list or a projection are planned at every execution
+TEST_F(PlanStmtTest, planTemplateNotReusable) {
+  useDb("root", "test");
+
+  prepare("SELECT * FROM t1 WHERE ts > ?");
+  TAOS_MULTI_BIND* pBindParams = buildIntegerParam(createBindParams(1), 0, 1700000000000LL, TSDB_DATA_TYPE_TIMESTAMP);
+  bindParams(pBindParams, -1);
+  exec();
+  ASSERT_FALSE(planReusable());
+  destoryBindParams(pBindParams, 1);
+
+  prepare("SELECT * FROM st1 WHERE tbname = ?");
+  pBindParams = buildStringParam(createBindParams(1), 0, "st1s1", TSDB_DATA_TYPE_VARCHAR, strlen("st1s1"));
+  bindParams(pBindParams, -1);
+  exec();
+  ASSERT_FALSE(planReusable());
+  destoryBindParams(pBindParams, 1);
+
+  prepare("SELECT * FROM t1 WHERE c1 > ? AND ts < NOW()");
+  pBindParams = buildIntegerParam(createBindParams(1), 0, 10, TSDB_DATA_TYPE_INT);
+  bindParams(pBindParams, -1);
+  exec();
+  ASSERT_FALSE(planReusable());
+  destoryBindParams(pBindParams, 1);
+
+  prepare("SELECT c1 + ? FROM t1");
+  pBindParams = buildIntegerParam(createBindParams(1), 0, 10, TSDB_DATA_TYPE_INT);
+  bindParams(pBindParams, -1);
+  exec();
+  ASSERT_FALSE(planReusable());
+  destoryBindParams(pBindParams, 1);
+}
@@ -202,6 +202,10 @@ class PlannerTestBaseImpl {
     }
   }
 
+  bool planReusable() { return stmtEnv_.planReusable_; }
+
+  string physiPlan() { return res_.physiPlan_; }
+
   void exec() {
     if (caseEnv_.numOfSkipSql_ > 0) {
       --(caseEnv_.numOfSkipSql_);
@@ -234,6 +238,8 @@ class PlannerTestBaseImpl {
 
       checkPlanMsg((SNode*)pPlan);
 
+      checkPlanTemplate(pPlan);
+
       dump(g_dumpModule);
     } catch (...) {
       dump(DUMP_MODULE_ALL);
@@ -256,9 +262,14 @@ class PlannerTestBaseImpl {
     string            sql_;
     array<char, 1024> msgBuf_;
     SQuery*           pQuery_;
+    SPlanTemplate*    pTemplate_;
+    bool              planReusable_;
 
-    stmtEnv() : pQuery_(nullptr) {}
-    ~stmtEnv() { qDestroyQuery(pQuery_); }
+    stmtEnv() : pQuery_(nullptr), pTemplate_(nullptr), planReusable_(false) {}
+    ~stmtEnv() {
+      qDestroyQuery(pQuery_);
+      qDestroyPlanTemplate(pTemplate_);
+    }
   };
 
   struct stmtRes {
@@ -285,6 +296,10 @@ class PlannerTestBaseImpl {
     stmtEnv_.sql_.clear();
     stmtEnv_.msgBuf_.fill(0);
     qDestroyQuery(stmtEnv_.pQuery_);
+    stmtEnv_.pQuery_ = nullptr;
+    qDestroyPlanTemplate(stmtEnv_.pTemplate_);
+    stmtEnv_.pTemplate_ = nullptr;
+    stmtEnv_.planReusable_ = false;
 
     res_.ast_.clear();
     res_.boundAst_.clear();
@@ -432,6 +447,8 @@ class PlannerTestBaseImpl {
   void setPlanContext(SQuery* pQuery, SPlanContext* pCxt) {
     pCxt->queryId = 1;
     pCxt->pUser = caseEnv_.user_.c_str();
+    pCxt->vnodeParallelism = tsQueryVnodeParallelism;
+    pCxt->partTableShardSize = tsQueryPartTableShardSize;
     if (QUERY_NODE_CREATE_TOPIC_STMT == nodeType(pQuery->pRoot)) {
       SCreateTopicStmt* pStmt = (SCreateTopicStmt*)pQuery->pRoot;
       pCxt->pAstRoot = pStmt->pQuery;
@@ -513,6 +530,60 @@ class PlannerTestBaseImpl {
     taosMemoryFreeClear(pStr);
   }
 
+  vector<string> toSubplanMsgs(const SQueryPlan* pPlan) {
+    vector<string> msgs;
+    SNode*         pLevel = nullptr;
+    FOREACH(pLevel, pPlan->pSubplans) {
+      SNode* pSubplan = nullptr;
+      FOREACH(pSubplan, ((SNodeListNode*)pLevel)->pNodeList) {
+        char*   pMsg = nullptr;
+        int32_t len = 0;
+        DO_WITH_THROW(nodesNodeToMsg, pSubplan, &pMsg, &len)
+        msgs.emplace_back(pMsg, len);
+        taosMemoryFreeClear(pMsg);
+      }
+    }
+    return msgs;
+  }
+
+  // The first execution of a reusable statement saves its plan as a template, as the stmt2 plan cache does. The
+  // later executions must get the same plan from the template and their values as from planning them.
+  void checkPlanTemplate(SQueryPlan* pPlan) {
+    SQuery* pQuery = stmtEnv_.pQuery_;
+    stmtEnv_.planReusable_ = qStmtIsPlanReusable(pQuery);
+    if (!stmtEnv_.planReusable_) {
+      qDestroyPlanTemplate(stmtEnv_.pTemplate_);
+      stmtEnv_.pTemplate_ = nullptr;
+      return;
+    }
+
+    if (nullptr != stmtEnv_.pTemplate_) {
+      SQueryPlan* pNewPlan = nullptr;
+      DO_WITH_THROW(qBuildPlanFromTemplate, stmtEnv_.pTemplate_, pPlan->queryId, pQuery->pPlaceholderValues,
+                    &pNewPlan)
+      unique_ptr<SQueryPlan, void (*)(SQueryPlan*)> newPlan(pNewPlan, qDestroyQueryPlan);
+      ASSERT_EQ(pNewPlan->numOfSubplans, pPlan->numOfSubplans);
+      ASSERT_EQ(LIST_LENGTH(pNewPlan->pSubplans), LIST_LENGTH(pPlan->pSubplans));
+      ASSERT_EQ(toSubplanMsgs(pNewPlan), toSubplanMsgs(pPlan));
+      return;
+    }
+
+    // explain and post plans are never saved
+    SPlanTemplate* pTemplate = nullptr;
+    EExplainMode   mode = pPlan->explainInfo.mode;
+    pPlan->explainInfo.mode = EXPLAIN_MODE_ANALYZE;
+    DO_WITH_THROW(qCreatePlanTemplate, pPlan, pQuery->placeholderNum, &pTemplate)
+    pPlan->explainInfo.mode = mode;
+    ASSERT_EQ(pTemplate, nullptr);
+    pPlan->pPostPlan = pPlan;
+    DO_WITH_THROW(qCreatePlanTemplate, pPlan, pQuery->placeholderNum, &pTemplate)
+    pPlan->pPostPlan = nullptr;
+    ASSERT_EQ(pTemplate, nullptr);
+
+    DO_WITH_THROW(qCreatePlanTemplate, pPlan, pQuery->placeholderNum, &stmtEnv_.pTemplate_)
+    ASSERT_NE(stmtEnv_.pTemplate_, nullptr);
+  }
+
   caseEnv caseEnv_;
   stmtEnv stmtEnv_;
   stmtRes res_;
@@ -535,3 +606,7 @@ void PlannerTestBase::bindParams(TAOS_MULTI_BIND* pParams, int32_t colIdx) {
 }
 
 void PlannerTestBase::exec() { return impl_->exec(); }
+
+bool PlannerTestBase::planReusable() { return impl_->planReusable(); }
+
+std::string PlannerTestBase::physiPlan() { return impl_->physiPlan(); }
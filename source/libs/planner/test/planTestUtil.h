@@ -36,6 +36,10 @@ class PlannerTestBase : public testing::Test {
   void prepare(const std::string& sql);
   void bindParams(TAOS_MULTI_BIND* pParams, int32_t colIdx);
   void exec();
+  // whether the plan of the last execution can be rebuilt from a template for other values
+  bool planReusable();
+  // the physical plan of the last execution, in json
+  std::string physiPlan();
 
  private:
   std::unique_ptr<PlannerTestBaseImpl> impl_;
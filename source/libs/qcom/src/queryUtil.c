@@ -154,10 +154,16 @@ int32_t initTaskQueue() {
 
 int32_t cleanupTaskQueue() {
   tQueryAutoQWorkerCleanup(&taskQueue.wrokrerPool);
+  taskQueue.pTaskQueue = NULL;
   return 0;
 }
 
 int32_t taosAsyncExec(__async_exec_fn_t execFn, void* execParam, int32_t* code) {
+  if (NULL == taskQueue.pTaskQueue) {
+    qError("task queue is not initialized");
+    return TSDB_CODE_APP_ERROR;
+  }
+
   SSchedMsg* pSchedMsg; 
   int32_t rc = taosAllocateQitem(sizeof(SSchedMsg), DEF_QITEM, 0, (void **)&pSchedMsg);
   if (rc) return rc;
@@ -166,7 +172,11 @@ int32_t taosAsyncExec(__async_exec_fn_t execFn, void* execParam, int32_t* code)
   pSchedMsg->thandle = execParam;
   pSchedMsg->msg = code;
 
-  return taosWriteQitem(taskQueue.pTaskQueue, pSchedMsg);
+  rc = taosWriteQitem(taskQueue.pTaskQueue, pSchedMsg);
+  if (rc) {
+    taosFreeQitem(pSchedMsg);
+  }
+  return rc;
 }
 
 int32_t taosAsyncWait() {
@@ -25,6 +25,7 @@ extern "C" {
 #include "plannodes.h"
 #include "qworker.h"
 #include "tlockfree.h"
+#include "tlrucache.h"
 #include "tref.h"
 #include "trpc.h"
 #include "ttimer.h"
@@ -36,6 +37,10 @@ extern "C" {
 #define QW_DEFAULT_HEARTBEAT_MSEC   5000
 #define QW_SCH_TIMEOUT_MSEC         180000
 #define QW_MIN_RES_ROWS             16384
+#define QW_RES_CACHE_KEY_LEN        16
+#define QW_RES_CACHE_ENTRY_RATIO    8  // an entry takes at most 1/8 of the result cache
+#define QW_ADMISSION_MEM_RATIO      0.9  // new tasks are rejected above this usage of queryNodeMemBudget
+#define QW_MAX_FLUSH_BLOCKS         32   // low latency mode ends when this many blocks are flushed at once
 
 enum {
   QW_PHASE_PRE_QUERY = 1,
@@ -106,6 +111,34 @@ typedef struct SQWPhaseOutput {
 #endif
 } SQWPhaseOutput;
 
+enum {
+  QW_RES_CACHE_NONE = 0,
+  QW_RES_CACHE_COLLECT,  // results are collected and cached if the data read is unchanged at the end
+  QW_RES_CACHE_HIT,      // results are replayed from the cache instead of executing the task
+};
+
+typedef int32_t (*qwGetDataVerFp)(void *pVnode, const STimeWindow *pWindow, int64_t *pVer);
+
+typedef struct SQWResCacheCtx {
+  int8_t         status;
+  int8_t         partial;  // a runtime range narrowed the scans, set by the fetch while the task may be running
+  uint8_t        key[QW_RES_CACHE_KEY_LEN];  // md5 of the subplan without the query id
+  STimeWindow    window;                      // time range of all the scans of the subplan
+  int64_t        version;                     // data version of the window when the task started
+  int64_t        size;
+  SArray        *pBlocks;    // SSDataBlock*
+  SArray        *pTbInfo;    // STbVerInfo of the cached task, returned in the query rsp of a hit
+  int32_t        replayIdx;  // next block to put into the sink on a hit
+  void          *pVnode;
+  qwGetDataVerFp getDataVerFp;
+} SQWResCacheCtx;
+
+typedef struct SQWResCacheEntry {
+  int64_t version;
+  SArray *pBlocks;  // SSDataBlock*
+  SArray *pTbInfo;  // STbVerInfo
+} SQWResCacheEntry;
+
 typedef struct SQWTaskStatus {
   int64_t refId;  // job's refId
   int32_t code;
@@ -121,8 +154,12 @@ typedef struct SQWTaskCtx {
   int8_t   needFetch;
   int8_t   localExec;
   int8_t   dynamicTask;
+  int8_t   fetchPeakMem;  // the consumer asks for the peak memory trailer in the fetch rsp
   int32_t  queryMsgType;
   int32_t  fetchMsgType;
+  int32_t  fetchCredit;  // max blocks in the fetch rsp granted by the consumer, 0: QW_MIN_RES_ROWS
+  int32_t  flushBlocks;  // low latency mode: blocks put into the sink before the task yields, 0: until it is full
+  int32_t  maxFollowerLag;  // max lag of the vnode the task was admitted with on a follower, -1: leader only
   int32_t  level;
   int32_t  dynExecId;
   uint64_t sId;
@@ -145,7 +182,10 @@ typedef struct SQWTaskCtx {
   SArray *explainRes;
   void   *taskHandle;
   void   *sinkHandle;
-  SArray *tbInfo;  // STbVerInfo
+  void   *sinkPlan;  // SSubplan the sink refers to, only kept when no task owns it
+  SArray *tbInfo;    // STbVerInfo
+
+  SQWResCacheCtx resCache;
 } SQWTaskCtx;
 
 typedef struct SQWSchStatus {
@@ -178,6 +218,9 @@ typedef struct SQWMsgStat {
 typedef struct SQWRTStat {
   uint64_t startTaskNum;
   uint64_t stopTaskNum;
+  uint64_t resCacheHit;
+  uint64_t resCacheMiss;
+  uint64_t memRejected;
 } SQWRTStat;
 
 typedef struct SQWStat {
@@ -200,6 +243,7 @@ typedef struct SQWorker {
   SMsgCb    msgCb;
   SQWStat   stat;
   int32_t  *destroyed;
+  SLRUCache *resCache;  // key: SQWResCacheCtx.key, value: SQWResCacheEntry, vnode only
 
   int8_t nodeStopped;
 } SQWorker;
@@ -257,6 +301,8 @@ typedef struct SQWorkerMgmt {
 #define QW_FETCH_RUNNING(ctx)     ((ctx)->inFetch)
 #define QW_QUERY_NOT_STARTED(ctx) (QW_GET_PHASE(ctx) == -1)
 
+#define QW_FETCH_RSP_TRAILER_LEN(ctx) (((ctx) && (ctx)->fetchPeakMem) ? FETCH_RSP_PEAK_MEM_LEN : 0)
+
 #define QW_SET_QTID(id, qId, tId, eId)                              \
   do {                                                              \
     *(uint64_t *)(id) = (qId);                                      \
@@ -421,10 +467,12 @@ int32_t qwOpenRef(void);
 void    qwSetHbParam(int64_t refId, SQWHbParam **pParam);
 int32_t qwUpdateTimeInQueue(SQWorker *mgmt, int64_t ts, EQueueType type);
 int64_t qwGetTimeInQueue(SQWorker *mgmt, EQueueType type);
+int32_t qwCheckMemPressure(QW_FPARAMS_DEF);
 void    qwClearExpiredSch(SQWorker *mgmt, SArray *pExpiredSch);
 int32_t qwAcquireScheduler(SQWorker *mgmt, uint64_t sId, int32_t rwType, SQWSchStatus **sch);
 void    qwFreeTaskCtx(SQWTaskCtx *ctx);
 int32_t qwHandleTaskComplete(QW_FPARAMS_DEF, SQWTaskCtx *ctx);
+int32_t qwExecTask(QW_FPARAMS_DEF, SQWTaskCtx *ctx, bool *queryStop);
 
 void    qwDbgDumpMgmtInfo(SQWorker *mgmt);
 int32_t qwDbgValidateStatus(QW_FPARAMS_DEF, int8_t oriStatus, int8_t newStatus, bool *ignore, bool dynamicTask);
@@ -435,6 +483,14 @@ void    qwDbgSimulateSleep(void);
 void    qwDbgSimulateDead(QW_FPARAMS_DEF, SQWTaskCtx *ctx, bool *rsped);
 int32_t qwSendExplainResponse(QW_FPARAMS_DEF, SQWTaskCtx *ctx);
 
+int32_t qwInitResCache(SQWorker *mgmt);
+void    qwDestroyResCache(SQWorker *mgmt);
+int32_t qwPrepareResCache(QW_FPARAMS_DEF, SQWTaskCtx *ctx, SReadHandle *handle, SSubplan *plan);
+int32_t qwCollectResCacheBlock(QW_FPARAMS_DEF, SQWTaskCtx *ctx, SSDataBlock *pBlock);
+int32_t qwReplayResCache(QW_FPARAMS_DEF, SQWTaskCtx *ctx, bool *pDone);
+void    qwSaveResCache(QW_FPARAMS_DEF, SQWTaskCtx *ctx);
+void    qwClearResCacheCtx(SQWResCacheCtx *pCache);
+
 #ifdef __cplusplus
 }
 #endif
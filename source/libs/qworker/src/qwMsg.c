@@ -432,6 +432,52 @@ int32_t qWorkerPreprocessQueryMsg(void *qWorkerMgmt, SRpcMsg *pMsg, bool chkGran
   return TSDB_CODE_SUCCESS;
 }
 
+int32_t qWorkerGetQueryMaxFollowerLag(SRpcMsg *pMsg, int32_t *pMaxLag) {
+  if (NULL == pMsg || NULL == pMaxLag) {
+    QW_ERR_RET(TSDB_CODE_QRY_INVALID_INPUT);
+  }
+
+  SSubQueryMsg msg = {0};
+  if (tDeserializeSSubQueryMsgHead(pMsg->pCont, pMsg->contLen, &msg) < 0) {
+    qError("tDeserializeSSubQueryMsgHead failed, contLen:%d", pMsg->contLen);
+    QW_ERR_RET(TSDB_CODE_QRY_INVALID_INPUT);
+  }
+
+  *pMaxLag = msg.maxFollowerLag;
+
+  return TSDB_CODE_SUCCESS;
+}
+
+int32_t qWorkerIsFollowerFetch(void *qWorkerMgmt, SRpcMsg *pMsg, bool *pFollower) {
+  if (NULL == qWorkerMgmt || NULL == pMsg || NULL == pFollower) {
+    QW_ERR_RET(TSDB_CODE_QRY_INVALID_INPUT);
+  }
+
+  SQWorker    *mgmt = (SQWorker *)qWorkerMgmt;
+  SResFetchReq req = {0};
+  if (tDeserializeSResFetchReq(pMsg->pCont, pMsg->contLen, &req) < 0) {
+    qError("tDeserializeSResFetchReq failed, contLen:%d", pMsg->contLen);
+    QW_ERR_RET(TSDB_CODE_QRY_INVALID_INPUT);
+  }
+  qDestroyOperatorParam(req.pOpParam);
+
+  uint64_t    sId = req.sId;
+  uint64_t    qId = req.queryId;
+  uint64_t    tId = req.taskId;
+  int64_t     rId = 0;
+  int32_t     eId = req.execId;
+  SQWTaskCtx *ctx = NULL;
+
+  // the lag was checked when the task was admitted, a task unknown here is left to the leader
+  *pFollower = false;
+  if (TSDB_CODE_SUCCESS == qwAcquireTaskCtx(QW_FPARAMS(), &ctx)) {
+    *pFollower = (ctx->maxFollowerLag >= 0);
+    qwReleaseTaskCtx(mgmt, ctx);
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
 int32_t qWorkerAbortPreprocessQueryMsg(void *qWorkerMgmt, SRpcMsg *pMsg) {
   if (NULL == qWorkerMgmt || NULL == pMsg) {
     QW_ERR_RET(TSDB_CODE_QRY_INVALID_INPUT);
@@ -488,6 +534,8 @@ int32_t qWorkerProcessQueryMsg(void *node, void *qWorkerMgmt, SRpcMsg *pMsg, int
   qwMsg.msgInfo.taskType = msg.taskType;
   qwMsg.msgInfo.needFetch = msg.needFetch;
   qwMsg.msgInfo.compressMsg = msg.compress;
+  qwMsg.msgInfo.lowLatency = msg.lowLatency;
+  qwMsg.msgInfo.maxFollowerLag = msg.maxFollowerLag;
 
   QW_SCH_TASK_DLOG("processQuery start, node:%p, type:%s, compress:%d, handle:%p, SQL:%s", node, TMSG_INFO(pMsg->msgType),
                    msg.compress, pMsg->info.handle, msg.sql);
@@ -558,6 +606,10 @@ int32_t qWorkerProcessFetchMsg(void *node, void *qWorkerMgmt, SRpcMsg *pMsg, int
   int32_t  eId = req.execId;
 
   SQWMsg qwMsg = {.node = node, .msg = req.pOpParam, .msgLen = 0, .connInfo = pMsg->info, .msgType = pMsg->msgType};
+  qwMsg.msgInfo.fetchCredit = req.credit;
+  qwMsg.msgInfo.hasRuntimeRange = req.hasRuntimeRange;
+  qwMsg.msgInfo.runtimeRange = req.runtimeRange;
+  qwMsg.msgInfo.fetchPeakMem = req.withPeakMem;
 
   QW_SCH_TASK_DLOG("processFetch start, node:%p, handle:%p", node, pMsg->info.handle);
 
@@ -0,0 +1,372 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "dataSinkMgt.h"
+#include "functionMgt.h"
+#include "planner.h"
+#include "qwInt.h"
+#include "tdatablock.h"
+#include "tglobal.h"
+#include "tmd5.h"
+
+/*
+ * Results of the scan subplans whose scans all read a time range that is only in the file sets. Such a result stays
+ * valid until the file sets or the metas of the vnode are edited, so the same subplan of a later query replays it
+ * instead of scanning again.
+ */
+
+static EDealRes qwResCacheCheckFunc(SNode *pNode, void *pContext) {
+  if (QUERY_NODE_FUNCTION == nodeType(pNode)) {
+    SFunctionNode *pFunc = (SFunctionNode *)pNode;
+    if (FUNCTION_TYPE_RAND == pFunc->funcType || FUNCTION_TYPE_NOW == pFunc->funcType ||
+        FUNCTION_TYPE_TODAY == pFunc->funcType || fmIsUserDefinedFunc(pFunc->funcId) ||
+        fmIsSystemInfoFunc(pFunc->funcId)) {
+      *(bool *)pContext = false;
+      return DEAL_RES_END;
+    }
+  }
+  return DEAL_RES_CONTINUE;
+}
+
+static bool qwResCacheDeterministic(SNodeList *pList) {
+  bool res = true;
+  nodesWalkExprs(pList, qwResCacheCheckFunc, &res);
+  return res;
+}
+
+static bool qwResCacheablePlan(SPhysiNode *pNode, STimeWindow *pWindow, bool *pHasAgg) {
+  if (pNode->dynamicOp || NULL != pNode->pSlimit) {
+    return false;
+  }
+
+  bool   res = true;
+  nodesWalkExpr(pNode->pConditions, qwResCacheCheckFunc, &res);
+  if (!res) {
+    return false;
+  }
+
+  switch (nodeType(pNode)) {
+    case QUERY_NODE_PHYSICAL_PLAN_TABLE_SCAN:
+    case QUERY_NODE_PHYSICAL_PLAN_TABLE_MERGE_SCAN: {
+      STableScanPhysiNode *pScan = (STableScanPhysiNode *)pNode;
+      if (!qwResCacheDeterministic(pScan->scan.pScanPseudoCols)) {
+        return false;
+      }
+      pWindow->skey = TMIN(pWindow->skey, pScan->scanRange.skey);
+      pWindow->ekey = TMAX(pWindow->ekey, pScan->scanRange.ekey);
+      return true;
+    }
+    case QUERY_NODE_PHYSICAL_PLAN_HASH_AGG: {
+      SAggPhysiNode *pAgg = (SAggPhysiNode *)pNode;
+      *pHasAgg = true;
+      res = qwResCacheDeterministic(pAgg->pExprs) && qwResCacheDeterministic(pAgg->pAggFuncs);
+      break;
+    }
+    case QUERY_NODE_PHYSICAL_PLAN_HASH_INTERVAL:
+    case QUERY_NODE_PHYSICAL_PLAN_MERGE_ALIGNED_INTERVAL: {
+      SWindowPhysiNode *pWin = (SWindowPhysiNode *)pNode;
+      *pHasAgg = true;
+      res = qwResCacheDeterministic(pWin->pExprs) && qwResCacheDeterministic(pWin->pFuncs);
+      break;
+    }
+    case QUERY_NODE_PHYSICAL_PLAN_PROJECT:
+      res = qwResCacheDeterministic(((SProjectPhysiNode *)pNode)->pProjections);
+      break;
+    case QUERY_NODE_PHYSICAL_PLAN_PARTITION:
+      res = qwResCacheDeterministic(((SPartitionPhysiNode *)pNode)->pExprs);
+      break;
+    case QUERY_NODE_PHYSICAL_PLAN_SORT:
+      res = qwResCacheDeterministic(((SSortPhysiNode *)pNode)->pExprs);
+      break;
+    default:
+      return false;
+  }
+
+  if (!res || LIST_LENGTH(pNode->pChildren) == 0) {
+    return false;
+  }
+
+  SNode *pChild = NULL;
+  FOREACH(pChild, pNode->pChildren) {
+    if (!qwResCacheablePlan((SPhysiNode *)pChild, pWindow, pHasAgg)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static int32_t qwResCacheGenKey(SSubplan *plan, uint8_t *pKey) {
+  char   *pStr = NULL;
+  int32_t len = 0;
+
+  // the same subplan of different queries only differs in the query id
+  uint64_t queryId = plan->id.queryId;
+  plan->id.queryId = 0;
+  int32_t code = qSubPlanToMsg(plan, &pStr, &len);
+  plan->id.queryId = queryId;
+  if (TSDB_CODE_SUCCESS != code) {
+    return code;
+  }
+
+  T_MD5_CTX context = {0};
+  tMD5Init(&context);
+  tMD5Update(&context, (uint8_t *)pStr, (uint32_t)len);
+  tMD5Final(&context);
+  TAOS_MEMCPY(pKey, context.digest, QW_RES_CACHE_KEY_LEN);
+
+  taosMemoryFree(pStr);
+  return TSDB_CODE_SUCCESS;
+}
+
+static void qwDestroyResCacheBlocks(SArray *pBlocks) { taosArrayDestroyP(pBlocks, (FDelete)blockDataDestroy); }
+
+static void qwFreeResCacheEntry(const void *key, size_t keyLen, void *value, void *ud) {
+  SQWResCacheEntry *pEntry = value;
+  qwDestroyResCacheBlocks(pEntry->pBlocks);
+  taosArrayDestroy(pEntry->pTbInfo);
+  taosMemoryFree(pEntry);
+}
+
+static int32_t qwCopyResCacheBlocks(const SArray *pSrc, SArray **ppDst) {
+  int32_t num = taosArrayGetSize(pSrc);
+  SArray *pDst = taosArrayInit(TMAX(num, 1), POINTER_BYTES);
+  if (NULL == pDst) {
+    return terrno;
+  }
+
+  for (int32_t i = 0; i < num; ++i) {
+    SSDataBlock *pBlock = NULL;
+    int32_t      code = createOneDataBlock(taosArrayGetP(pSrc, i), true, &pBlock);
+    if (TSDB_CODE_SUCCESS == code && NULL == taosArrayPush(pDst, &pBlock)) {
+      blockDataDestroy(pBlock);
+      code = terrno;
+    }
+    if (TSDB_CODE_SUCCESS != code) {
+      qwDestroyResCacheBlocks(pDst);
+      return code;
+    }
+  }
+
+  *ppDst = pDst;
+  return TSDB_CODE_SUCCESS;
+}
+
+static size_t qwResCacheCapacity() { return (size_t)tsQueryResultCacheSize * 1024 * 1024; }
+
+int32_t qwInitResCache(SQWorker *mgmt) {
+  mgmt->resCache = taosLRUCacheInit(qwResCacheCapacity(), -1, 0.5);
+  if (NULL == mgmt->resCache) {
+    return terrno;
+  }
+  taosLRUCacheSetStrictCapacity(mgmt->resCache, false);
+  return TSDB_CODE_SUCCESS;
+}
+
+void qwDestroyResCache(SQWorker *mgmt) {
+  if (mgmt->resCache) {
+    taosLRUCacheEraseUnrefEntries(mgmt->resCache);
+    taosLRUCacheCleanup(mgmt->resCache);
+    mgmt->resCache = NULL;
+  }
+}
+
+void qwClearResCacheCtx(SQWResCacheCtx *pCache) {
+  qwDestroyResCacheBlocks(pCache->pBlocks);
+  pCache->pBlocks = NULL;
+  taosArrayDestroy(pCache->pTbInfo);
+  pCache->pTbInfo = NULL;
+  pCache->replayIdx = 0;
+  pCache->size = 0;
+  pCache->status = QW_RES_CACHE_NONE;
+}
+
+int32_t qwPrepareResCache(QW_FPARAMS_DEF, SQWTaskCtx *ctx, SReadHandle *handle, SSubplan *plan) {
+  SQWResCacheCtx *pCache = &ctx->resCache;
+  size_t          capacity = qwResCacheCapacity();
+
+  if (NULL == mgmt->resCache || 0 == capacity || NULL == handle || NULL == handle->vnode ||
+      NULL == handle->api.tsdReader.tsdGetHistoryDataVer || ctx->explain || !ctx->needFetch ||
+      SUBPLAN_TYPE_SCAN != plan->subplanType || NULL == plan->pNode) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  STimeWindow window = {.skey = INT64_MAX, .ekey = INT64_MIN};
+  bool        hasAgg = false;
+  if (!qwResCacheablePlan(plan->pNode, &window, &hasAgg) || !hasAgg || window.skey > window.ekey) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  int64_t version = -1;
+  QW_ERR_RET(handle->api.tsdReader.tsdGetHistoryDataVer(handle->vnode, &window, &version));
+  if (version < 0) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  QW_ERR_RET(qwResCacheGenKey(plan, pCache->key));
+
+  if (taosLRUCacheGetCapacity(mgmt->resCache) != capacity) {
+    taosLRUCacheSetCapacity(mgmt->resCache, capacity);
+  }
+
+  pCache->window = window;
+  pCache->version = version;
+  pCache->pVnode = handle->vnode;
+  pCache->getDataVerFp = handle->api.tsdReader.tsdGetHistoryDataVer;
+  pCache->status = QW_RES_CACHE_COLLECT;
+
+  LRUHandle *pHandle = taosLRUCacheLookup(mgmt->resCache, pCache->key, QW_RES_CACHE_KEY_LEN);
+  if (pHandle) {
+    SQWResCacheEntry *pEntry = taosLRUCacheValue(mgmt->resCache, pHandle);
+    int32_t           code = TSDB_CODE_SUCCESS;
+    if (pEntry->version == version) {
+      code = qwCopyResCacheBlocks(pEntry->pBlocks, &pCache->pBlocks);
+      if (TSDB_CODE_SUCCESS == code && pEntry->pTbInfo) {
+        pCache->pTbInfo = taosArrayDup(pEntry->pTbInfo, NULL);
+        if (NULL == pCache->pTbInfo) {
+          code = terrno;
+        }
+      }
+      if (TSDB_CODE_SUCCESS == code) {
+        pCache->status = QW_RES_CACHE_HIT;
+      }
+    }
+    (void)taosLRUCacheRelease(mgmt->resCache, pHandle, false);
+    QW_ERR_RET(code);
+  }
+
+  if (QW_RES_CACHE_HIT == pCache->status) {
+    QW_STAT_INC(mgmt->stat.rtStat.resCacheHit, 1);
+  } else {
+    QW_STAT_INC(mgmt->stat.rtStat.resCacheMiss, 1);
+  }
+
+  QW_TASK_DLOG("result cache %s, version:%" PRId64 ", window:[%" PRId64 ", %" PRId64 "], hit:%" PRIu64
+               ", miss:%" PRIu64,
+               QW_RES_CACHE_HIT == pCache->status ? "hit" : "miss", version, window.skey, window.ekey,
+               QW_STAT_GET(mgmt->stat.rtStat.resCacheHit), QW_STAT_GET(mgmt->stat.rtStat.resCacheMiss));
+  return TSDB_CODE_SUCCESS;
+}
+
+int32_t qwCollectResCacheBlock(QW_FPARAMS_DEF, SQWTaskCtx *ctx, SSDataBlock *pBlock) {
+  SQWResCacheCtx *pCache = &ctx->resCache;
+  if (QW_RES_CACHE_COLLECT != pCache->status) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  // the result of a dynamic task depends on the params of each fetch
+  if (ctx->dynamicTask) {
+    qwClearResCacheCtx(pCache);
+    return TSDB_CODE_SUCCESS;
+  }
+
+  pCache->size += blockDataGetSize(pBlock);
+  if (pCache->size > qwResCacheCapacity() / QW_RES_CACHE_ENTRY_RATIO) {
+    QW_TASK_DLOG("result too large to cache, size:%" PRId64, pCache->size);
+    qwClearResCacheCtx(pCache);
+    return TSDB_CODE_SUCCESS;
+  }
+
+  if (NULL == pCache->pBlocks) {
+    pCache->pBlocks = taosArrayInit(4, POINTER_BYTES);
+    if (NULL == pCache->pBlocks) {
+      return terrno;
+    }
+  }
+
+  SSDataBlock *pCopy = NULL;
+  QW_ERR_RET(createOneDataBlock(pBlock, true, &pCopy));
+  if (NULL == taosArrayPush(pCache->pBlocks, &pCopy)) {
+    blockDataDestroy(pCopy);
+    return terrno;
+  }
+  return TSDB_CODE_SUCCESS;
+}
+
+// Like the exec loop, it stops once the sink is full and goes on from there when the consumer has fetched
+int32_t qwReplayResCache(QW_FPARAMS_DEF, SQWTaskCtx *ctx, bool *pDone) {
+  SQWResCacheCtx *pCache = &ctx->resCache;
+  int32_t         num = taosArrayGetSize(pCache->pBlocks);
+  int32_t         start = pCache->replayIdx;
+  bool            qcontinue = true;
+
+  while (qcontinue && pCache->replayIdx < num) {
+    SInputData inputData = {.pData = taosArrayGetP(pCache->pBlocks, pCache->replayIdx)};
+    int32_t    code = dsPutDataBlock(ctx->sinkHandle, &inputData, &qcontinue);
+    if (code) {
+      QW_TASK_ELOG("dsPutDataBlock failed, code:%x - %s", code, tstrerror(code));
+      QW_ERR_RET(code);
+    }
+    pCache->replayIdx++;
+  }
+
+  QW_TASK_DLOG("cached blocks [%d, %d) of %d put into sink", start, pCache->replayIdx, num);
+  *pDone = (pCache->replayIdx >= num);
+  if (*pDone) {
+    qwClearResCacheCtx(pCache);
+  }
+  return TSDB_CODE_SUCCESS;
+}
+
+void qwSaveResCache(QW_FPARAMS_DEF, SQWTaskCtx *ctx) {
+  SQWResCacheCtx *pCache = &ctx->resCache;
+  if (QW_RES_CACHE_COLLECT != pCache->status) {
+    return;
+  }
+
+  if (atomic_load_8(&pCache->partial)) {
+    QW_TASK_DLOG_E("result not cached since a runtime range was pushed down");
+    qwClearResCacheCtx(pCache);
+    return;
+  }
+
+  // the data may have been changed while the task was running
+  int64_t version = -1;
+  int32_t code = pCache->getDataVerFp(pCache->pVnode, &pCache->window, &version);
+  if (TSDB_CODE_SUCCESS != code || version != pCache->version) {
+    QW_TASK_DLOG("result not cached since data changed, version:%" PRId64 ", now:%" PRId64, pCache->version, version);
+    qwClearResCacheCtx(pCache);
+    return;
+  }
+
+  SQWResCacheEntry *pEntry = taosMemoryCalloc(1, sizeof(SQWResCacheEntry));
+  if (NULL == pEntry) {
+    qwClearResCacheCtx(pCache);
+    return;
+  }
+
+  if (ctx->tbInfo) {
+    pEntry->pTbInfo = taosArrayDup(ctx->tbInfo, NULL);
+    if (NULL == pEntry->pTbInfo) {
+      taosMemoryFree(pEntry);
+      qwClearResCacheCtx(pCache);
+      return;
+    }
+  }
+
+  pEntry->version = pCache->version;
+  pEntry->pBlocks = pCache->pBlocks;
+  pCache->pBlocks = NULL;
+
+  size_t    charge = sizeof(SQWResCacheEntry) + pCache->size;
+  LRUStatus status = taosLRUCacheInsert(mgmt->resCache, pCache->key, QW_RES_CACHE_KEY_LEN, pEntry, charge,
+                                        qwFreeResCacheEntry, NULL, NULL, TAOS_LRU_PRIORITY_LOW, NULL);
+  if (TAOS_LRU_STATUS_OK != status && TAOS_LRU_STATUS_OK_OVERWRITTEN != status) {
+    QW_TASK_DLOG("failed to cache result, status:%d", status);
+  } else {
+    QW_TASK_DLOG("result cached, size:%" PRId64 ", version:%" PRId64, pCache->size, pCache->version);
+  }
+
+  qwClearResCacheCtx(pCache);
+}
@@ -6,6 +6,7 @@
 #include "qwMsg.h"
 #include "qworker.h"
 #include "tcommon.h"
+#include "tglobal.h"
 #include "tmsg.h"
 #include "tname.h"
 
@@ -315,7 +316,11 @@ void qwFreeTaskCtx(SQWTaskCtx *ctx) {
     qDebug("sink handle destroyed");
   }
 
+  nodesDestroyNode((SNode *)ctx->sinkPlan);
+  ctx->sinkPlan = NULL;
+
   taosArrayDestroy(ctx->tbInfo);
+  qwClearResCacheCtx(&ctx->resCache);
 }
 
 static void freeExplainExecItem(void *param) {
@@ -390,6 +395,7 @@ int32_t qwDropTaskCtx(QW_FPARAMS_DEF) {
 
   atomic_store_ptr(&ctx->taskHandle, NULL);
   atomic_store_ptr(&ctx->sinkHandle, NULL);
+  ctx->sinkPlan = NULL;
 
   QW_SET_EVENT_PROCESSED(ctx, QW_EVENT_DROP);
 
@@ -614,6 +620,8 @@ void qwDestroyImpl(void *pMgmt) {
   }
   taosHashCleanup(mgmt->schHash);
 
+  qwDestroyResCache(mgmt);
+
   *mgmt->destroyed = 1;
 
   taosMemoryFree(mgmt);
@@ -681,6 +689,29 @@ int64_t qwGetTimeInQueue(SQWorker *mgmt, EQueueType type) {
   return -1;
 }
 
+int32_t qwCheckMemPressure(QW_FPARAMS_DEF) {
+  if (tsQueryNodeMemBudget <= 0) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  int64_t       used = 0, limit = 0;
+  SDataSinkStat sinkStat = {0};
+  qGetQueryMemUsage(&used, &limit);
+  if (TSDB_CODE_SUCCESS == dsDataSinkGetCacheSize(&sinkStat)) {
+    used += sinkStat.cachedSize;
+  }
+
+  limit = tsQueryNodeMemBudget * 1048576L;
+  if (used < limit * QW_ADMISSION_MEM_RATIO) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  QW_STAT_INC(mgmt->stat.rtStat.memRejected, 1);
+  QW_TASK_WLOG("task rejected since query memory usage %" PRId64 " reaches the budget %" PRId64 ", rejected:%" PRIu64,
+               used, limit, QW_STAT_GET(mgmt->stat.rtStat.memRejected));
+  return TSDB_CODE_QRY_MEMORY_PRESSURE;
+}
+
 void qwClearExpiredSch(SQWorker *mgmt, SArray *pExpiredSch) {
   int32_t code = TSDB_CODE_SUCCESS;
   int32_t num = taosArrayGetSize(pExpiredSch);
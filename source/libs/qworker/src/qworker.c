@@ -129,12 +129,23 @@ int32_t qwSendQueryRsp(QW_FPARAMS_DEF, int32_t msgType, SQWTaskCtx *ctx, int32_t
   return TSDB_CODE_SUCCESS;
 }
 
+static void qwSetTaskLowLatency(QW_FPARAMS_DEF, SQWTaskCtx *ctx, int8_t lowLatency) {
+  if (!lowLatency || !ctx->needFetch || ctx->dynamicTask) {
+    return;
+  }
+
+  ctx->flushBlocks = 1;
+  qSetTaskLowLatency(ctx->taskHandle);
+  QW_TASK_DLOG_E("task runs in low latency mode");
+}
+
 int32_t qwExecTask(QW_FPARAMS_DEF, SQWTaskCtx *ctx, bool *queryStop) {
   int32_t        code = 0;
   bool           qcontinue = true;
   uint64_t       useconds = 0;
   int32_t        i = 0;
   int32_t        execNum = 0;
+  int32_t        putBlocks = 0;
   qTaskInfo_t    taskHandle = ctx->taskHandle;
   DataSinkHandle sinkHandle = ctx->sinkHandle;
   SLocalFetch    localFetch = {(void *)mgmt, ctx->localExec, qWorkerProcessLocalFetch, ctx->explainRes};
@@ -147,6 +158,21 @@ int32_t qwExecTask(QW_FPARAMS_DEF, SQWTaskCtx *ctx, bool *queryStop) {
     return TSDB_CODE_SUCCESS;
   }
 
+  if (QW_RES_CACHE_HIT == ctx->resCache.status) {
+    bool replayDone = false;
+    QW_ERR_RET(qwReplayResCache(QW_FPARAMS(), ctx, &replayDone));
+    if (replayDone) {
+      QW_ERR_RET(qwHandleTaskComplete(QW_FPARAMS(), ctx));
+      dsEndPut(sinkHandle, 0);
+    }
+
+    if (queryStop) {
+      *queryStop = true;
+    }
+
+    return TSDB_CODE_SUCCESS;
+  }
+
   SArray *pResList = taosArrayInit(4, POINTER_BYTES);
   if (NULL == pResList) {
     QW_ERR_RET(terrno);
@@ -191,6 +217,9 @@ int32_t qwExecTask(QW_FPARAMS_DEF, SQWTaskCtx *ctx, bool *queryStop) {
       }
 
       QW_TASK_DLOG("data put into sink, rows:%" PRId64 ", continueExecTask:%d", pRes->info.rows, qcontinue);
+      ++putBlocks;
+
+      QW_ERR_JRET(qwCollectResCacheBlock(QW_FPARAMS(), ctx, pRes));
     }
 
     if (numOfResBlock == 0 || (hasMore == false)) {
@@ -201,6 +230,7 @@ int32_t qwExecTask(QW_FPARAMS_DEF, SQWTaskCtx *ctx, bool *queryStop) {
           QW_TASK_DLOG("qExecTask done, useconds:%" PRIu64, useconds);
         }
 
+        qwSaveResCache(QW_FPARAMS(), ctx);
         QW_ERR_JRET(qwHandleTaskComplete(QW_FPARAMS(), ctx));
       } else {
         if (numOfResBlock == 0) {
@@ -229,6 +259,13 @@ int32_t qwExecTask(QW_FPARAMS_DEF, SQWTaskCtx *ctx, bool *queryStop) {
       break;
     }
 
+    // yield with the first blocks in the sink, so the consumer gets them at once, and flush twice as many next time
+    if (ctx->flushBlocks > 0 && putBlocks >= ctx->flushBlocks) {
+      QW_TASK_DLOG("%d blocks flushed in low latency mode", putBlocks);
+      ctx->flushBlocks = (ctx->flushBlocks >= QW_MAX_FLUSH_BLOCKS) ? 0 : ctx->flushBlocks * 2;
+      break;
+    }
+
     if (ctx->needFetch && (!ctx->queryRsped) && execNum >= QW_DEFAULT_SHORT_RUN_TIMES) {
       break;
     }
@@ -409,13 +446,24 @@ int32_t qwGetQueryResFromSink(QW_FPARAMS_DEF, SQWTaskCtx *ctx, int32_t *dataLen,
       break;
     }
 
-    if (pOutput->numOfRows >= QW_MIN_RES_ROWS) {
+    if (ctx->fetchCredit > 0) {
+      if (pOutput->numOfBlocks >= ctx->fetchCredit) {
+        QW_TASK_DLOG("task fetched blocks %d rows %" PRId64 " reaches the credit", pOutput->numOfBlocks,
+                     pOutput->numOfRows);
+        break;
+      }
+    } else if (pOutput->numOfRows >= QW_MIN_RES_ROWS) {
       QW_TASK_DLOG("task fetched blocks %d rows %" PRId64 " reaches the min rows", pOutput->numOfBlocks,
                    pOutput->numOfRows);
       break;
     }
   }
 
+  if (pRsp && ctx->fetchPeakMem) {
+    QW_ERR_RET(qwMallocFetchRsp(!ctx->localExec, *dataLen + FETCH_RSP_PEAK_MEM_LEN, &pRsp));
+    tPutFetchRspPeakMem(pRsp, *dataLen, qGetTaskPeakMem(ctx->taskHandle));
+  }
+
   *rspMsg = pRsp;
   return TSDB_CODE_SUCCESS;
 }
@@ -488,7 +536,8 @@ int32_t qwQuickRspFetchReq(QW_FPARAMS_DEF, SQWTaskCtx *ctx, SQWMsg *qwMsg, int32
       qwMsg->connInfo = ctx->dataConnInfo;
       QW_SET_EVENT_PROCESSED(ctx, QW_EVENT_FETCH);
 
-      QW_ERR_RET(qwBuildAndSendFetchRsp(ctx->fetchMsgType + 1, &qwMsg->connInfo, rsp, dataLen, code));
+      QW_ERR_RET(qwBuildAndSendFetchRsp(ctx->fetchMsgType + 1, &qwMsg->connInfo, rsp,
+                                        dataLen + QW_FETCH_RSP_TRAILER_LEN(ctx), code));
       rsp = NULL;
 
       QW_TASK_DLOG("fetch rsp send, handle:%p, code:%x - %s, dataLen:%d", qwMsg->connInfo.handle, code, tstrerror(code),
@@ -762,6 +811,9 @@ int32_t qwProcessQuery(QW_FPARAMS_DEF, SQWMsg *qwMsg, char *sql) {
   ctx->needFetch = qwMsg->msgInfo.needFetch;
   ctx->queryMsgType = qwMsg->msgType;
   ctx->localExec = false;
+  ctx->maxFollowerLag = qwMsg->msgInfo.maxFollowerLag;
+
+  QW_ERR_JRET(qwCheckMemPressure(QW_FPARAMS()));
 
   code = qMsgToSubplan(qwMsg->msg, qwMsg->msgLen, &plan);
   if (TSDB_CODE_SUCCESS != code) {
@@ -770,30 +822,53 @@ int32_t qwProcessQuery(QW_FPARAMS_DEF, SQWMsg *qwMsg, char *sql) {
     QW_ERR_JRET(code);
   }
 
-  tsEnableRandErr = true;
-  code = qCreateExecTask(qwMsg->node, mgmt->nodeId, tId, plan, &pTaskInfo, &sinkHandle, qwMsg->msgInfo.compressMsg, sql,
-                         OPTR_EXEC_MODEL_BATCH);
-  tsEnableRandErr = false;
-  
-  sql = NULL;
-  if (code) {
-    QW_TASK_ELOG("qCreateExecTask failed, code:%x - %s", code, tstrerror(code));
-    qDestroyTask(pTaskInfo);
-    QW_ERR_JRET(code);
+  code = qwPrepareResCache(QW_FPARAMS(), ctx, qwMsg->node, plan);
+  if (TSDB_CODE_SUCCESS != code) {
+    QW_TASK_WLOG("prepare result cache failed, code:%x - %s", code, tstrerror(code));
+    qwClearResCacheCtx(&ctx->resCache);
   }
 
-  if (NULL == sinkHandle || NULL == pTaskInfo) {
-    QW_TASK_ELOG("create task result error, taskHandle:%p, sinkHandle:%p", pTaskInfo, sinkHandle);
-    qDestroyTask(pTaskInfo);
-    QW_ERR_JRET(TSDB_CODE_APP_ERROR);
-  }
+  // a hit only replays the cached blocks into the sink, no task is needed
+  if (QW_RES_CACHE_HIT == ctx->resCache.status) {
+    code = qCreateExecSink(qwMsg->node, plan, &sinkHandle, qwMsg->msgInfo.compressMsg);
+    if (code) {
+      QW_TASK_ELOG("qCreateExecSink failed, code:%x - %s", code, tstrerror(code));
+      nodesDestroyNode((SNode *)plan);
+      QW_ERR_JRET(code);
+    }
 
-  ctx->level = plan->level;
-  ctx->dynamicTask = qIsDynamicExecTask(pTaskInfo);
-  atomic_store_ptr(&ctx->taskHandle, pTaskInfo);
-  atomic_store_ptr(&ctx->sinkHandle, sinkHandle);
+    ctx->level = plan->level;
+    ctx->dynamicTask = false;
+    ctx->sinkPlan = plan;
+    atomic_store_ptr(&ctx->sinkHandle, sinkHandle);
+    TSWAP(ctx->tbInfo, ctx->resCache.pTbInfo);
+  } else {
+    tsEnableRandErr = true;
+    code = qCreateExecTask(qwMsg->node, mgmt->nodeId, tId, plan, &pTaskInfo, &sinkHandle, qwMsg->msgInfo.compressMsg,
+                           sql, OPTR_EXEC_MODEL_BATCH);
+    tsEnableRandErr = false;
+
+    sql = NULL;
+    if (code) {
+      QW_TASK_ELOG("qCreateExecTask failed, code:%x - %s", code, tstrerror(code));
+      qDestroyTask(pTaskInfo);
+      QW_ERR_JRET(code);
+    }
+
+    if (NULL == sinkHandle || NULL == pTaskInfo) {
+      QW_TASK_ELOG("create task result error, taskHandle:%p, sinkHandle:%p", pTaskInfo, sinkHandle);
+      qDestroyTask(pTaskInfo);
+      QW_ERR_JRET(TSDB_CODE_APP_ERROR);
+    }
 
-  QW_ERR_JRET(qwSaveTbVersionInfo(pTaskInfo, ctx));
+    ctx->level = plan->level;
+    ctx->dynamicTask = qIsDynamicExecTask(pTaskInfo);
+    atomic_store_ptr(&ctx->taskHandle, pTaskInfo);
+    atomic_store_ptr(&ctx->sinkHandle, sinkHandle);
+
+    QW_ERR_JRET(qwSaveTbVersionInfo(pTaskInfo, ctx));
+    qwSetTaskLowLatency(QW_FPARAMS(), ctx, qwMsg->msgInfo.lowLatency);
+  }
 
   if (!ctx->dynamicTask) {
     QW_ERR_JRET(qwExecTask(QW_FPARAMS(), ctx, NULL));
@@ -861,7 +936,8 @@ int32_t qwProcessCQuery(QW_FPARAMS_DEF, SQWMsg *qwMsg) {
         qwMsg->connInfo = ctx->dataConnInfo;
         QW_SET_EVENT_PROCESSED(ctx, QW_EVENT_FETCH);
 
-        QW_ERR_JRET(qwBuildAndSendFetchRsp(ctx->fetchMsgType + 1, &qwMsg->connInfo, rsp, dataLen, code));
+        QW_ERR_JRET(qwBuildAndSendFetchRsp(ctx->fetchMsgType + 1, &qwMsg->connInfo, rsp,
+                                           dataLen + QW_FETCH_RSP_TRAILER_LEN(ctx), code));
         rsp = NULL;
 
         QW_TASK_DLOG("fetch rsp send, handle:%p, code:%x - %s, dataLen:%d", qwMsg->connInfo.handle, code,
@@ -926,8 +1002,15 @@ int32_t qwProcessFetch(QW_FPARAMS_DEF, SQWMsg *qwMsg) {
   QW_ERR_JRET(qwGetTaskCtx(QW_FPARAMS(), &ctx));
 
   ctx->fetchMsgType = qwMsg->msgType;
+  ctx->fetchCredit = qwMsg->msgInfo.fetchCredit;
+  ctx->fetchPeakMem = qwMsg->msgInfo.fetchPeakMem;
   ctx->dataConnInfo = qwMsg->connInfo;
 
+  if (qwMsg->msgInfo.hasRuntimeRange && ctx->taskHandle) {
+    atomic_store_8(&ctx->resCache.partial, 1);
+    QW_ERR_JRET(qUpdateTaskRuntimeRange(ctx->taskHandle, &qwMsg->msgInfo.runtimeRange));
+  }
+
   if (qwMsg->msg) {
     code = qwStartDynamicTaskNewExec(QW_FPARAMS(), ctx, qwMsg);
     goto _return;
@@ -989,7 +1072,8 @@ _return:
     }
 
     if (!rsped) {
-      code = qwBuildAndSendFetchRsp(qwMsg->msgType + 1, &qwMsg->connInfo, rsp, dataLen, code);
+      code = qwBuildAndSendFetchRsp(qwMsg->msgType + 1, &qwMsg->connInfo, rsp,
+                                    dataLen + QW_FETCH_RSP_TRAILER_LEN(ctx), code);
       if (TSDB_CODE_SUCCESS != code) {
         QW_TASK_ELOG("fetch rsp send fail, msgType:%s, handle:%p, code:%x - %s, dataLen:%d", TMSG_INFO(qwMsg->msgType + 1),
                      qwMsg->connInfo.handle, code, tstrerror(code), dataLen);
@@ -1359,6 +1443,10 @@ int32_t qWorkerInit(int8_t nodeType, int32_t nodeId, void **qWorkerMgmt, const S
     QW_ERR_JRET(TSDB_CODE_OUT_OF_MEMORY);
   }
 
+  if (NODE_TYPE_VNODE == nodeType) {
+    QW_ERR_JRET(qwInitResCache(mgmt));
+  }
+
   mgmt->nodeType = nodeType;
   mgmt->nodeId = nodeId;
   if (pMsgCb) {
@@ -1396,6 +1484,7 @@ _return:
     taosHashCleanup(mgmt->schHash);
     taosHashCleanup(mgmt->ctxHash);
     taosTmrCleanUp(mgmt->timer);
+    qwDestroyResCache(mgmt);
     taosMemoryFreeClear(mgmt);
 
     (void)atomic_sub_fetch_32(&gQwMgmt.qwNum, 1);
@@ -1434,6 +1523,13 @@ void qWorkerDestroy(void **qWorkerMgmt) {
   }
 }
 
+void qWorkerGetResCacheStat(void *qWorkerMgmt, SQWorkerStat *pStat) {
+  SQWorker *mgmt = (SQWorker *)qWorkerMgmt;
+  pStat->resCacheHit = QW_STAT_GET(mgmt->stat.rtStat.resCacheHit);
+  pStat->resCacheMiss = QW_STAT_GET(mgmt->stat.rtStat.resCacheMiss);
+  pStat->resCacheSize = mgmt->resCache ? taosLRUCacheGetUsage(mgmt->resCache) : 0;
+}
+
 int32_t qWorkerGetStat(SReadHandle *handle, void *qWorkerMgmt, SQWorkerStat *pStat) {
   if (NULL == handle || NULL == qWorkerMgmt || NULL == pStat) {
     QW_RET(TSDB_CODE_QRY_INVALID_INPUT);
@@ -1452,6 +1548,8 @@ int32_t qWorkerGetStat(SReadHandle *handle, void *qWorkerMgmt, SQWorkerStat *pSt
   pStat->notifyProcessed = QW_STAT_GET(mgmt->stat.msgStat.notifyProcessed);
   pStat->hbProcessed = QW_STAT_GET(mgmt->stat.msgStat.hbProcessed);
   pStat->deleteProcessed = QW_STAT_GET(mgmt->stat.msgStat.deleteProcessed);
+  pStat->memRejected = QW_STAT_GET(mgmt->stat.rtStat.memRejected);
+  qWorkerGetResCacheStat(qWorkerMgmt, pStat);
 
   pStat->numOfQueryInQueue = handle->pMsgCb->qsizeFp(handle->pMsgCb->mgmt, mgmt->nodeId, QUERY_QUEUE);
   pStat->numOfFetchInQueue = handle->pMsgCb->qsizeFp(handle->pMsgCb->mgmt, mgmt->nodeId, FETCH_QUEUE);
@@ -1507,6 +1605,7 @@ int32_t qWorkerProcessLocalQuery(void *pMgmt, uint64_t sId, uint64_t qId, uint64
   ctx->level = plan->level;
   atomic_store_ptr(&ctx->taskHandle, pTaskInfo);
   atomic_store_ptr(&ctx->sinkHandle, sinkHandle);
+  qwSetTaskLowLatency(QW_FPARAMS(), ctx, qwMsg->msgInfo.lowLatency);
 
   QW_ERR_JRET(qwExecTask(QW_FPARAMS(), ctx, NULL));
 
@@ -1543,6 +1642,7 @@ int32_t qWorkerProcessLocalFetch(void *pMgmt, uint64_t sId, uint64_t qId, uint64
 
   ctx->fetchMsgType = TDMT_SCH_MERGE_FETCH;
   ctx->explainRes = explainRes;
+  ctx->fetchPeakMem = true;  // a local rsp always carries the trailer
 
   SOutputData sOutput = {0};
 
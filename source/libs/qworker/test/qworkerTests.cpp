@@ -15,6 +15,7 @@
 
 #include <gtest/gtest.h>
 #include <iostream>
+#include <vector>
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wwrite-strings"
@@ -35,6 +36,7 @@
 #include "dataSinkMgt.h"
 #include "executor.h"
 #include "planner.h"
+#include "qwMsg.h"
 #include "qworker.h"
 #include "stub.h"
 #include "taos.h"
@@ -444,6 +446,47 @@ int32_t qwtGetDataBlock(DataSinkHandle handle, SOutputData *pOutput) {
 
 void qwtDestroyDataSinker(DataSinkHandle handle) {}
 
+// a sink that always holds qwtTestCreditSinkBlocks blocks of QW_TEST_CREDIT_BLOCK_ROWS rows and never ends
+#define QW_TEST_CREDIT_BLOCK_ROWS 100
+#define QW_TEST_CREDIT_BLOCK_LEN  64
+int32_t qwtTestCreditSinkBlocks = 0;
+
+void qwtCreditGetDataLength(DataSinkHandle handle, int64_t *pLen, int64_t *pRawLen, bool *pQueryEnd) {
+  *pLen = (qwtTestCreditSinkBlocks > 0) ? QW_TEST_CREDIT_BLOCK_LEN : 0;
+  *pRawLen = *pLen;
+  *pQueryEnd = false;
+}
+
+int32_t qwtCreditGetDataBlock(DataSinkHandle handle, SOutputData *pOutput) {
+  if (qwtTestCreditSinkBlocks <= 0) {
+    pOutput->numOfRows = 0;
+    pOutput->bufStatus = DS_BUF_EMPTY;
+    return 0;
+  }
+
+  qwtTestCreditSinkBlocks--;
+  pOutput->numOfRows = QW_TEST_CREDIT_BLOCK_ROWS;
+  pOutput->numOfCols = 1;
+  pOutput->queryEnd = false;
+  pOutput->bufStatus = (qwtTestCreditSinkBlocks > 0) ? DS_BUF_LOW : DS_BUF_EMPTY;
+  pOutput->precision = 1;
+  return 0;
+}
+
+// the query memory and the cached sink data charged on the node by the running tasks
+int64_t qwtTestQueryMemUsed = 0;
+int64_t qwtTestSinkCachedSize = 0;
+
+void qwtGetQueryMemUsage(int64_t *pUsed, int64_t *pLimit) {
+  *pUsed = qwtTestQueryMemUsed;
+  *pLimit = 0;
+}
+
+int32_t qwtDataSinkGetCacheSize(SDataSinkStat *pStat) {
+  pStat->cachedSize = qwtTestSinkCachedSize;
+  return 0;
+}
+
 void stubSetStringToPlan() {
   static Stub stub;
   stub.set(qStringToSubplan, qwtStringToPlan);
@@ -884,6 +927,158 @@ void *fetchQueueThread(void *param) {
   return NULL;
 }
 
+
+// the result cache: a data version set by the test and a sink that takes qwtTestResCacheSinkCap blocks per round
+int64_t qwtTestDataVer = 1;
+int32_t qwtTestResCacheSinkCap = 0;
+int32_t qwtTestResCachePutBlocks = 0;
+int64_t qwtTestResCachePutRows = 0;
+
+int32_t qwtGetHistoryDataVer(void *pVnode, const STimeWindow *pWindow, int64_t *pVer) {
+  *pVer = qwtTestDataVer;
+  return 0;
+}
+
+int32_t qwtResCachePutDataBlock(DataSinkHandle handle, const SInputData *pInput, bool *pContinue) {
+  qwtTestResCachePutBlocks++;
+  qwtTestResCachePutRows += pInput->pData->info.rows;
+  *pContinue = (qwtTestResCacheSinkCap <= 0 || qwtTestResCachePutBlocks % qwtTestResCacheSinkCap != 0);
+  return 0;
+}
+
+// a task that never ends, each execution returns one block
+SSDataBlock *qwtTestFlushBlock = NULL;
+int32_t      qwtTestFlushExecNum = 0;
+
+int32_t qwtFlushExecTaskOpt(qTaskInfo_t tinfo, SArray *pResList, uint64_t *useconds, bool *hasMore,
+                            SLocalFetch *pLocal) {
+  taosArrayClear(pResList);
+  if (NULL == taosArrayPush(pResList, &qwtTestFlushBlock)) {
+    return terrno;
+  }
+  *hasMore = true;
+  *useconds = 0;
+  qwtTestFlushExecNum++;
+  return 0;
+}
+
+// agg(table scan of uid on [skey, ekey]), the subplan of a vnode that the cache takes, or the bare scan
+SSubplan *qwtBuildResCachePlan(uint64_t uid, TSKEY skey, TSKEY ekey, bool withAgg = true) {
+  SSubplan            *pPlan = NULL;
+  SAggPhysiNode       *pAgg = NULL;
+  STableScanPhysiNode *pScan = NULL;
+  SDataDispatcherNode *pSink = NULL;
+  assert(0 == nodesMakeNode(QUERY_NODE_PHYSICAL_SUBPLAN, (SNode **)&pPlan));
+  assert(0 == nodesMakeNode(QUERY_NODE_PHYSICAL_PLAN_HASH_AGG, (SNode **)&pAgg));
+  assert(0 == nodesMakeNode(QUERY_NODE_PHYSICAL_PLAN_TABLE_SCAN, (SNode **)&pScan));
+  assert(0 == nodesMakeNode(QUERY_NODE_PHYSICAL_PLAN_DISPATCH, (SNode **)&pSink));
+
+  pScan->scan.uid = uid;
+  pScan->scan.tableType = TSDB_CHILD_TABLE;
+  pScan->scanRange.skey = skey;
+  pScan->scanRange.ekey = ekey;
+  if (withAgg) {
+    assert(0 == nodesListMakeStrictAppend(&pAgg->node.pChildren, (SNode *)pScan));
+    pPlan->pNode = (SPhysiNode *)pAgg;
+  } else {
+    nodesDestroyNode((SNode *)pAgg);
+    pPlan->pNode = (SPhysiNode *)pScan;
+  }
+
+  pPlan->id.queryId = atomic_add_fetch_64(&qwtTestQueryId, 1);
+  pPlan->subplanType = SUBPLAN_TYPE_SCAN;
+  pPlan->level = 1;
+  pPlan->pDataSink = (SDataSinkNode *)pSink;
+  return pPlan;
+}
+
+SSDataBlock *qwtBuildResCacheBlock(int32_t rows, int64_t base) {
+  SSDataBlock *pBlock = NULL;
+  assert(0 == createDataBlock(&pBlock));
+  SColumnInfoData col = createColumnInfoData(TSDB_DATA_TYPE_BIGINT, sizeof(int64_t), 1);
+  assert(0 == blockDataAppendColInfo(pBlock, &col));
+  assert(0 == blockDataEnsureCapacity(pBlock, rows));
+  SColumnInfoData *pCol = (SColumnInfoData *)taosArrayGet(pBlock->pDataBlock, 0);
+  for (int32_t i = 0; i < rows; ++i) {
+    int64_t v = base + i;
+    assert(0 == colDataSetVal(pCol, i, (const char *)&v, false));
+  }
+  pBlock->info.rows = rows;
+  return pBlock;
+}
+
+class QWResCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    cacheSize = tsQueryResultCacheSize;
+    tsQueryResultCacheSize = 1;
+    qwtTestDataVer = 1;
+    qwtTestResCacheSinkCap = 0;
+    qwtTestResCachePutBlocks = 0;
+    qwtTestResCachePutRows = 0;
+    ASSERT_EQ(qwInitResCache(&mgmt), 0);
+
+    handle.vnode = (void *)0x1;
+    handle.api.tsdReader.tsdGetHistoryDataVer = qwtGetHistoryDataVer;
+
+    stub.set(dsPutDataBlock, qwtResCachePutDataBlock);
+#ifdef LINUX
+    AddrAny                       any("libexecutor.so");
+    std::map<std::string, void *> result;
+    any.get_global_func_addr_dynsym("^dsPutDataBlock$", result);
+    for (const auto &f : result) {
+      stub.set(f.second, qwtResCachePutDataBlock);
+    }
+#endif
+  }
+
+  void TearDown() override {
+    qwDestroyResCache(&mgmt);
+    tsQueryResultCacheSize = cacheSize;
+  }
+
+  // runs a task of plan until the cache has been looked up, a miss then produces blocks of rows
+  int8_t runTask(SSubplan *pPlan, int32_t blocks = 1, int32_t rows = 10, bool dynamicTask = false) {
+    SQWTaskCtx ctx = {0};
+    ctx.needFetch = true;
+    ctx.sinkHandle = (void *)0x1;
+    EXPECT_EQ(qwPrepareResCache(&mgmt, 1, 1, 1, 0, 0, &ctx, &handle, pPlan), 0);
+    int8_t status = ctx.resCache.status;
+
+    if (QW_RES_CACHE_HIT == status) {
+      // no task reports the table versions of a replayed result, they come with the entry
+      EXPECT_EQ(taosArrayGetSize(ctx.resCache.pTbInfo), 1);
+      STbVerInfo *pInfo = (STbVerInfo *)taosArrayGet(ctx.resCache.pTbInfo, 0);
+      EXPECT_TRUE(pInfo && 0 == strcmp(pInfo->tbFName, "1.db.tb") && pInfo->sversion == 3);
+      bool done = false;
+      while (!done) {
+        EXPECT_EQ(qwReplayResCache(&mgmt, 1, 1, 1, 0, 0, &ctx, &done), 0);
+      }
+      EXPECT_EQ(ctx.resCache.status, QW_RES_CACHE_NONE);
+    } else {
+      STbVerInfo tbInfo = {.sversion = 3, .tversion = 1};
+      tstrncpy(tbInfo.tbFName, "1.db.tb", sizeof(tbInfo.tbFName));
+      ctx.tbInfo = taosArrayInit(1, sizeof(STbVerInfo));
+      EXPECT_TRUE(ctx.tbInfo && taosArrayPush(ctx.tbInfo, &tbInfo));
+      ctx.dynamicTask = dynamicTask;
+      for (int32_t i = 0; i < blocks; ++i) {
+        SSDataBlock *pBlock = qwtBuildResCacheBlock(rows, i * rows);
+        EXPECT_EQ(qwCollectResCacheBlock(&mgmt, 1, 1, 1, 0, 0, &ctx, pBlock), 0);
+        blockDataDestroy(pBlock);
+      }
+      qwSaveResCache(&mgmt, 1, 1, 1, 0, 0, &ctx);
+    }
+
+    taosArrayDestroy(ctx.tbInfo);
+    qwClearResCacheCtx(&ctx.resCache);
+    return status;
+  }
+
+  int32_t    cacheSize = 0;
+  SQWorker   mgmt = {0};
+  SReadHandle handle = {0};
+  Stub       stub;
+};
 }  // namespace
 
 TEST(seqTest, normalCase) {
@@ -1398,6 +1593,364 @@ TEST(rcTest, dropTest) {
   qWorkerDestroy(&mgmt);
 }
 
+// the fetch rsp carries at most the granted credit of blocks, without a credit it reads on until QW_MIN_RES_ROWS
+TEST(fetchTest, creditCase) {
+  Stub stub;
+  stub.set(dsGetDataLength, qwtCreditGetDataLength);
+  stub.set(dsGetDataBlock, qwtCreditGetDataBlock);
+#ifdef LINUX
+  {
+    AddrAny                       any("libexecutor.so");
+    std::map<std::string, void *> result;
+    any.get_global_func_addr_dynsym("^dsGetDataLength$", result);
+    for (const auto &f : result) {
+      stub.set(f.second, qwtCreditGetDataLength);
+    }
+    result.clear();
+    any.get_global_func_addr_dynsym("^dsGetDataBlock$", result);
+    for (const auto &f : result) {
+      stub.set(f.second, qwtCreditGetDataBlock);
+    }
+  }
+#endif
+
+  struct {
+    int32_t credit;
+    int32_t sinkBlocks;
+    int32_t expectBlocks;
+  } cases[] = {
+      {3, 10, 3},
+      {1, 10, 1},
+      {20, 10, 10},
+      {0, 10, 10},
+      {0, QW_MIN_RES_ROWS / QW_TEST_CREDIT_BLOCK_ROWS + 10, QW_MIN_RES_ROWS / QW_TEST_CREDIT_BLOCK_ROWS + 1},
+  };
+
+  for (const auto &c : cases) {
+    SQWTaskCtx ctx = {0};
+    ctx.sinkHandle = (void *)0x1;
+    ctx.localExec = true;
+    ctx.level = 1;
+    ctx.fetchCredit = c.credit;
+    qwtTestCreditSinkBlocks = c.sinkBlocks;
+
+    int32_t     dataLen = 0;
+    int32_t     rawLen = 0;
+    void       *rsp = NULL;
+    SOutputData output = {0};
+    int32_t code = qwGetQueryResFromSink(NULL, 1, 1, 1, 0, 0, &ctx, &dataLen, &rawLen, &rsp, &output);
+    ASSERT_EQ(code, 0);
+    ASSERT_NE(rsp, nullptr);
+    ASSERT_EQ(output.numOfBlocks, c.expectBlocks) << "credit " << c.credit;
+    ASSERT_EQ(output.numOfRows, (int64_t)c.expectBlocks * QW_TEST_CREDIT_BLOCK_ROWS);
+    ASSERT_EQ(dataLen, c.expectBlocks * (QW_TEST_CREDIT_BLOCK_LEN + PAYLOAD_PREFIX_LEN));
+    ASSERT_EQ(qwtTestCreditSinkBlocks, c.sinkBlocks - c.expectBlocks);
+    taosMemoryFree(rsp);
+  }
+}
+
+// a new task is rejected once the query memory and the cached sink data reach the admission ratio of the budget
+TEST(admissionTest, memPressure) {
+  Stub stub;
+  stub.set(qGetQueryMemUsage, qwtGetQueryMemUsage);
+  stub.set(dsDataSinkGetCacheSize, qwtDataSinkGetCacheSize);
+#ifdef LINUX
+  {
+    AddrAny                       any("libexecutor.so");
+    std::map<std::string, void *> result;
+    any.get_global_func_addr_dynsym("^qGetQueryMemUsage$", result);
+    for (const auto &f : result) {
+      stub.set(f.second, qwtGetQueryMemUsage);
+    }
+    result.clear();
+    any.get_global_func_addr_dynsym("^dsDataSinkGetCacheSize$", result);
+    for (const auto &f : result) {
+      stub.set(f.second, qwtDataSinkGetCacheSize);
+    }
+  }
+#endif
+
+  int32_t  budget = tsQueryNodeMemBudget;
+  SQWorker mgmt = {0};
+  int64_t  limit = 100 * 1048576L;
+
+  // no budget, no admission control
+  tsQueryNodeMemBudget = 0;
+  qwtTestQueryMemUsed = limit * 2;
+  qwtTestSinkCachedSize = 0;
+  ASSERT_EQ(qwCheckMemPressure(&mgmt, 1, 1, 1, 0, 0), TSDB_CODE_SUCCESS);
+
+  tsQueryNodeMemBudget = 100;
+  qwtTestQueryMemUsed = (int64_t)(limit * QW_ADMISSION_MEM_RATIO) - 1;
+  ASSERT_EQ(qwCheckMemPressure(&mgmt, 1, 1, 1, 0, 0), TSDB_CODE_SUCCESS);
+  ASSERT_EQ(QW_STAT_GET(mgmt.stat.rtStat.memRejected), 0);
+
+  qwtTestQueryMemUsed = (int64_t)(limit * QW_ADMISSION_MEM_RATIO);
+  ASSERT_EQ(qwCheckMemPressure(&mgmt, 1, 1, 1, 0, 0), TSDB_CODE_QRY_MEMORY_PRESSURE);
+  ASSERT_EQ(QW_STAT_GET(mgmt.stat.rtStat.memRejected), 1);
+
+  // the cached sink data counts as well
+  qwtTestQueryMemUsed = limit / 2;
+  qwtTestSinkCachedSize = limit / 2;
+  ASSERT_EQ(qwCheckMemPressure(&mgmt, 1, 1, 2, 0, 0), TSDB_CODE_QRY_MEMORY_PRESSURE);
+  ASSERT_EQ(QW_STAT_GET(mgmt.stat.rtStat.memRejected), 2);
+
+  qwtTestSinkCachedSize = 0;
+  ASSERT_EQ(qwCheckMemPressure(&mgmt, 1, 1, 3, 0, 0), TSDB_CODE_SUCCESS);
+  ASSERT_EQ(QW_STAT_GET(mgmt.stat.rtStat.memRejected), 2);
+
+  tsQueryNodeMemBudget = budget;
+}
+
+TEST_F(QWResCacheTest, hitAndMiss) {
+  SSubplan *pPlan = qwtBuildResCachePlan(100, 0, 1000);
+  ASSERT_EQ(runTask(pPlan, 3, 10), QW_RES_CACHE_COLLECT);
+  ASSERT_EQ(QW_STAT_GET(mgmt.stat.rtStat.resCacheMiss), 1);
+
+  // the same subplan of another query replays the blocks
+  pPlan->id.queryId = atomic_add_fetch_64(&qwtTestQueryId, 1);
+  ASSERT_EQ(runTask(pPlan), QW_RES_CACHE_HIT);
+  ASSERT_EQ(QW_STAT_GET(mgmt.stat.rtStat.resCacheHit), 1);
+  ASSERT_EQ(qwtTestResCachePutBlocks, 3);
+  ASSERT_EQ(qwtTestResCachePutRows, 30);
+  ASSERT_EQ(runTask(pPlan), QW_RES_CACHE_HIT);
+
+  // another table or range is another entry
+  SSubplan *pOther = qwtBuildResCachePlan(101, 0, 1000);
+  ASSERT_EQ(runTask(pOther), QW_RES_CACHE_COLLECT);
+  nodesDestroyNode((SNode *)pOther);
+  pOther = qwtBuildResCachePlan(100, 0, 999);
+  ASSERT_EQ(runTask(pOther), QW_RES_CACHE_COLLECT);
+  nodesDestroyNode((SNode *)pOther);
+
+  nodesDestroyNode((SNode *)pPlan);
+}
+
+// the counters the vnode reports to the monitor
+TEST_F(QWResCacheTest, stat) {
+  SQWorkerStat stat = {0};
+  qWorkerGetResCacheStat(&mgmt, &stat);
+  ASSERT_EQ(stat.resCacheHit, 0);
+  ASSERT_EQ(stat.resCacheMiss, 0);
+  ASSERT_EQ(stat.resCacheSize, 0);
+
+  SSubplan *pPlan = qwtBuildResCachePlan(100, 0, 1000);
+  ASSERT_EQ(runTask(pPlan, 3, 10), QW_RES_CACHE_COLLECT);
+  qWorkerGetResCacheStat(&mgmt, &stat);
+  ASSERT_EQ(stat.resCacheHit, 0);
+  ASSERT_EQ(stat.resCacheMiss, 1);
+  ASSERT_GT(stat.resCacheSize, 0);
+  uint64_t size = stat.resCacheSize;
+
+  pPlan->id.queryId = atomic_add_fetch_64(&qwtTestQueryId, 1);
+  ASSERT_EQ(runTask(pPlan), QW_RES_CACHE_HIT);
+  qWorkerGetResCacheStat(&mgmt, &stat);
+  ASSERT_EQ(stat.resCacheHit, 1);
+  ASSERT_EQ(stat.resCacheMiss, 1);
+  ASSERT_EQ(stat.resCacheSize, size);
+
+  SSubplan *pOther = qwtBuildResCachePlan(101, 0, 1000);
+  ASSERT_EQ(runTask(pOther, 2, 10), QW_RES_CACHE_COLLECT);
+  qWorkerGetResCacheStat(&mgmt, &stat);
+  ASSERT_EQ(stat.resCacheMiss, 2);
+  ASSERT_GT(stat.resCacheSize, size);
+
+  nodesDestroyNode((SNode *)pOther);
+  nodesDestroyNode((SNode *)pPlan);
+}
+
+TEST_F(QWResCacheTest, replayRespectsSink) {
+  SSubplan *pPlan = qwtBuildResCachePlan(100, 0, 1000);
+  ASSERT_EQ(runTask(pPlan, 5, 10), QW_RES_CACHE_COLLECT);
+
+  SQWTaskCtx ctx = {0};
+  ctx.needFetch = true;
+  ctx.sinkHandle = (void *)0x1;
+  ASSERT_EQ(qwPrepareResCache(&mgmt, 1, 1, 1, 0, 0, &ctx, &handle, pPlan), 0);
+  ASSERT_EQ(ctx.resCache.status, QW_RES_CACHE_HIT);
+
+  // the sink is full after every 2 blocks, the replay goes on from there on the next round
+  qwtTestResCacheSinkCap = 2;
+  bool done = false;
+  ASSERT_EQ(qwReplayResCache(&mgmt, 1, 1, 1, 0, 0, &ctx, &done), 0);
+  ASSERT_FALSE(done);
+  ASSERT_EQ(qwtTestResCachePutBlocks, 2);
+  ASSERT_EQ(qwReplayResCache(&mgmt, 1, 1, 1, 0, 0, &ctx, &done), 0);
+  ASSERT_FALSE(done);
+  ASSERT_EQ(qwtTestResCachePutBlocks, 4);
+  ASSERT_EQ(qwReplayResCache(&mgmt, 1, 1, 1, 0, 0, &ctx, &done), 0);
+  ASSERT_TRUE(done);
+  ASSERT_EQ(qwtTestResCachePutBlocks, 5);
+  ASSERT_EQ(qwtTestResCachePutRows, 50);
+  ASSERT_EQ(ctx.resCache.status, QW_RES_CACHE_NONE);
+
+  nodesDestroyNode((SNode *)pPlan);
+}
+
+TEST_F(QWResCacheTest, invalidation) {
+  SSubplan *pPlan = qwtBuildResCachePlan(100, 0, 1000);
+  ASSERT_EQ(runTask(pPlan), QW_RES_CACHE_COLLECT);
+  ASSERT_EQ(runTask(pPlan), QW_RES_CACHE_HIT);
+
+  // a commit or a meta write renews the data version
+  qwtTestDataVer = 2;
+  ASSERT_EQ(runTask(pPlan), QW_RES_CACHE_COLLECT);
+  ASSERT_EQ(runTask(pPlan), QW_RES_CACHE_HIT);
+
+  // the memtables overlap the window, nothing is looked up or cached
+  qwtTestDataVer = -1;
+  ASSERT_EQ(runTask(pPlan), QW_RES_CACHE_NONE);
+  qwtTestDataVer = 2;
+  ASSERT_EQ(runTask(pPlan), QW_RES_CACHE_HIT);
+
+  // the data changes while the task runs, its result is not cached
+  qwtTestDataVer = 3;
+  SQWTaskCtx ctx = {0};
+  ctx.needFetch = true;
+  ASSERT_EQ(qwPrepareResCache(&mgmt, 1, 1, 1, 0, 0, &ctx, &handle, pPlan), 0);
+  ASSERT_EQ(ctx.resCache.status, QW_RES_CACHE_COLLECT);
+  SSDataBlock *pBlock = qwtBuildResCacheBlock(10, 0);
+  ASSERT_EQ(qwCollectResCacheBlock(&mgmt, 1, 1, 1, 0, 0, &ctx, pBlock), 0);
+  blockDataDestroy(pBlock);
+  qwtTestDataVer = 4;
+  qwSaveResCache(&mgmt, 1, 1, 1, 0, 0, &ctx);
+  ASSERT_EQ(runTask(pPlan), QW_RES_CACHE_COLLECT);
+  ASSERT_EQ(runTask(pPlan), QW_RES_CACHE_HIT);
+
+  nodesDestroyNode((SNode *)pPlan);
+}
+
+TEST_F(QWResCacheTest, notCacheable) {
+  SSubplan *pPlan = qwtBuildResCachePlan(100, 0, 1000);
+
+  // the result of a dynamic task is never kept
+  ASSERT_EQ(runTask(pPlan, 1, 10, true), QW_RES_CACHE_COLLECT);
+  ASSERT_EQ(runTask(pPlan), QW_RES_CACHE_COLLECT);
+  ASSERT_EQ(runTask(pPlan), QW_RES_CACHE_HIT);
+
+  // a runtime range pushed down by a join narrows the result
+  SSubplan *pOther = qwtBuildResCachePlan(101, 0, 1000);
+  SQWTaskCtx ctx = {0};
+  ctx.needFetch = true;
+  ASSERT_EQ(qwPrepareResCache(&mgmt, 1, 1, 1, 0, 0, &ctx, &handle, pOther), 0);
+  ctx.resCache.partial = 1;
+  SSDataBlock *pBlock = qwtBuildResCacheBlock(10, 0);
+  ASSERT_EQ(qwCollectResCacheBlock(&mgmt, 1, 1, 1, 0, 0, &ctx, pBlock), 0);
+  blockDataDestroy(pBlock);
+  qwSaveResCache(&mgmt, 1, 1, 1, 0, 0, &ctx);
+  ASSERT_EQ(runTask(pOther), QW_RES_CACHE_COLLECT);
+  nodesDestroyNode((SNode *)pOther);
+
+  // a dynamic scan, a scan without aggregation
+  pOther = qwtBuildResCachePlan(102, 0, 1000);
+  ((SPhysiNode *)nodesListGetNode(pOther->pNode->pChildren, 0))->dynamicOp = true;
+  ASSERT_EQ(runTask(pOther), QW_RES_CACHE_NONE);
+  nodesDestroyNode((SNode *)pOther);
+  pOther = qwtBuildResCachePlan(102, 0, 1000, false);
+  ASSERT_EQ(runTask(pOther), QW_RES_CACHE_NONE);
+  nodesDestroyNode((SNode *)pOther);
+
+  // explain, or a result nobody fetches
+  SQWTaskCtx ctx2 = {0};
+  ctx2.explain = true;
+  ctx2.needFetch = true;
+  ASSERT_EQ(qwPrepareResCache(&mgmt, 1, 1, 1, 0, 0, &ctx2, &handle, pPlan), 0);
+  ASSERT_EQ(ctx2.resCache.status, QW_RES_CACHE_NONE);
+  ctx2.explain = false;
+  ctx2.needFetch = false;
+  ASSERT_EQ(qwPrepareResCache(&mgmt, 1, 1, 1, 0, 0, &ctx2, &handle, pPlan), 0);
+  ASSERT_EQ(ctx2.resCache.status, QW_RES_CACHE_NONE);
+
+  nodesDestroyNode((SNode *)pPlan);
+}
+
+TEST_F(QWResCacheTest, lruEviction) {
+  // each result is about 1/10 of the 1MB cache, below the 1/8 an entry may take
+  const int32_t rows = 1024 * 1024 / 10 / sizeof(int64_t);
+  const int32_t num = 30;
+
+  std::vector<SSubplan *> plans;
+  for (int32_t i = 0; i < num; ++i) {
+    plans.push_back(qwtBuildResCachePlan(1000 + i, 0, 1000));
+    ASSERT_EQ(runTask(plans[i], 1, rows), QW_RES_CACHE_COLLECT);
+  }
+  ASSERT_LE(taosLRUCacheGetUsage(mgmt.resCache), (size_t)1024 * 1024 * 2);
+
+  // the latest results stay, the oldest are evicted
+  ASSERT_EQ(runTask(plans[num - 1]), QW_RES_CACHE_HIT);
+  ASSERT_EQ(runTask(plans[0]), QW_RES_CACHE_COLLECT);
+
+  // a result larger than 1/8 of the cache is never kept
+  SSubplan *pLarge = qwtBuildResCachePlan(999, 0, 1000);
+  ASSERT_EQ(runTask(pLarge, 2, rows), QW_RES_CACHE_COLLECT);
+  ASSERT_EQ(runTask(pLarge), QW_RES_CACHE_COLLECT);
+  nodesDestroyNode((SNode *)pLarge);
+
+  for (auto pPlan : plans) {
+    nodesDestroyNode((SNode *)pPlan);
+  }
+}
+
+// in low latency mode each round of a task yields after 1, 2, 4 ... QW_MAX_FLUSH_BLOCKS blocks, then fills the sink
+TEST(flushTest, lowLatencyCase) {
+  Stub stub;
+  stub.set(qExecTaskOpt, qwtFlushExecTaskOpt);
+  stub.set(dsPutDataBlock, qwtResCachePutDataBlock);
+#ifdef LINUX
+  {
+    AddrAny                       any("libexecutor.so");
+    std::map<std::string, void *> result;
+    any.get_global_func_addr_dynsym("^qExecTaskOpt$", result);
+    for (const auto &f : result) {
+      stub.set(f.second, qwtFlushExecTaskOpt);
+    }
+    result.clear();
+    any.get_global_func_addr_dynsym("^dsPutDataBlock$", result);
+    for (const auto &f : result) {
+      stub.set(f.second, qwtResCachePutDataBlock);
+    }
+  }
+#endif
+
+  const int32_t sinkCap = QW_MAX_FLUSH_BLOCKS + 18;
+  qwtTestFlushBlock = qwtBuildResCacheBlock(10, 0);
+  qwtTestResCacheSinkCap = sinkCap;
+
+  for (int8_t lowLatency = 0; lowLatency <= 1; ++lowLatency) {
+    SQWTaskCtx ctx = {0};
+    ctx.taskHandle = (void *)0x1;
+    ctx.sinkHandle = (void *)0x1;
+    ctx.queryRsped = true;
+    ctx.flushBlocks = lowLatency;
+
+    std::vector<int32_t> expect;
+    if (lowLatency) {
+      for (int32_t blocks = 1; blocks <= QW_MAX_FLUSH_BLOCKS; blocks *= 2) {
+        expect.push_back(blocks);
+      }
+    }
+    expect.push_back(sinkCap);
+    expect.push_back(sinkCap);
+
+    std::vector<int32_t> actual;
+    for (size_t i = 0; i < expect.size(); ++i) {
+      qwtTestResCachePutBlocks = 0;
+      qwtTestFlushExecNum = 0;
+      bool queryStop = false;
+      ASSERT_EQ(qwExecTask(NULL, 1, 1, 1, 0, 0, &ctx, &queryStop), 0);
+      ASSERT_EQ(qwtTestFlushExecNum, qwtTestResCachePutBlocks);
+      ASSERT_EQ(queryStop, qwtTestResCachePutBlocks == sinkCap);
+      actual.push_back(qwtTestResCachePutBlocks);
+    }
+    ASSERT_EQ(actual, expect) << "lowLatency " << (int32_t)lowLatency;
+    ASSERT_EQ(ctx.flushBlocks, 0);
+  }
+
+  qwtTestResCacheSinkCap = 0;
+  blockDataDestroy(qwtTestFlushBlock);
+  qwtTestFlushBlock = NULL;
+}
+
 int main(int argc, char **argv) {
   taosSeedRand(taosGetTimestampSec());
   testing::InitGoogleTest(&argc, argv);
@@ -33,6 +33,7 @@ typedef struct SScalarCtx {
   bool               dual;       /* whether select stmt has from stmt */
   SArray*            pBlockList; /* element is SSDataBlock* */
   SHashObj*          pRes;       /* element is SScalarParam */
+  SHashObj*          pFused;     /* element is SSclFusedExpr*, NULL for the inner nodes of a fused expression */
   void*              param;      // additional parameter (meta actually) for acquire value such as tbname/tags values
   SOperatorValueType type;
 } SScalarCtx;
@@ -147,6 +148,21 @@ int32_t vectorCompareImpl(SScalarParam* pLeft, SScalarParam* pRight, SScalarPara
                           int32_t _ord, int32_t optr);
 int32_t vectorCompare(SScalarParam* pLeft, SScalarParam* pRight, SScalarParam *pOut, int32_t _ord, int32_t optr);
 
+// type specialized compare kernels writing one int8 (0/1) per row, see sclcompare.c
+#define SCL_SEL_COMPARE_MIN_ROWS 16
+
+bool    vectorSelCompareSupported(int32_t type, int32_t optr);
+void    vectorSelCompareColConst(int32_t type, int32_t optr, const void* pCol, const void* pVal, int32_t numOfRows,
+                                 int8_t* pRes);
+void    vectorSelCompareConstCol(int32_t type, int32_t optr, const void* pVal, const void* pCol, int32_t numOfRows,
+                                 int8_t* pRes);
+void    vectorSelCompareColCol(int32_t type, int32_t optr, const void* pLeft, const void* pRight, int32_t numOfRows,
+                               int8_t* pRes);
+void    vectorSelClearNull(int8_t* pRes, const char* nullBitmap, int32_t start, int32_t numOfRows);
+void    vectorSelAnd(int8_t* pRes, const int8_t* pSel, int32_t numOfRows);
+void    vectorSelOr(int8_t* pRes, const int8_t* pSel, int32_t numOfRows);
+int32_t vectorSelCount(const int8_t* pRes, int32_t numOfRows);
+
 #ifdef __cplusplus
 }
 #endif
@@ -3534,6 +3534,110 @@ static FORCE_INLINE int32_t filterExecuteImplNotNull(void *pinfo, int32_t numOfR
   FLT_RET(TSDB_CODE_SUCCESS);
 }
 
+static bool filterUnitSelSupported(SFilterComUnit *cunit) {
+  if (cunit->optr == OP_TYPE_IS_NULL || cunit->optr == OP_TYPE_IS_NOT_NULL) {
+    return true;
+  }
+
+  if (cunit->valData == NULL) {
+    return false;
+  }
+
+  if (cunit->rfunc >= 0) {
+    return vectorSelCompareSupported(cunit->dataType, OP_TYPE_GREATER_THAN);
+  }
+
+  return vectorSelCompareSupported(cunit->dataType, cunit->optr);
+}
+
+// evaluate one unit over the whole block with the typed compare kernels, pTmp is only used by two sided ranges
+static void filterExecuteUnitSel(SFilterComUnit *cunit, int32_t numOfRows, int8_t *p, int8_t *pTmp) {
+  SColumnInfoData *pCol = (SColumnInfoData *)cunit->colData;
+
+  if (cunit->optr == OP_TYPE_IS_NULL || cunit->optr == OP_TYPE_IS_NOT_NULL) {
+    bool isNullOptr = (cunit->optr == OP_TYPE_IS_NULL);
+    for (int32_t i = 0; i < numOfRows; ++i) {
+      p[i] = (colDataIsNull(pCol, 0, i, NULL) == isNullOptr);
+    }
+    return;
+  }
+
+  if (cunit->rfunc >= 0) {
+    int32_t lowerOptr = 0, upperOptr = 0;
+    switch (cunit->rfunc) {
+      case 0:
+        lowerOptr = OP_TYPE_GREATER_THAN;
+        upperOptr = OP_TYPE_LOWER_THAN;
+        break;
+      case 1:
+        lowerOptr = OP_TYPE_GREATER_THAN;
+        upperOptr = OP_TYPE_LOWER_EQUAL;
+        break;
+      case 2:
+        lowerOptr = OP_TYPE_GREATER_EQUAL;
+        upperOptr = OP_TYPE_LOWER_THAN;
+        break;
+      case 3:
+        lowerOptr = OP_TYPE_GREATER_EQUAL;
+        upperOptr = OP_TYPE_LOWER_EQUAL;
+        break;
+      case 4:
+        lowerOptr = OP_TYPE_GREATER_THAN;
+        break;
+      case 5:
+        lowerOptr = OP_TYPE_GREATER_EQUAL;
+        break;
+      case 6:
+        upperOptr = OP_TYPE_LOWER_THAN;
+        break;
+      default:
+        upperOptr = OP_TYPE_LOWER_EQUAL;
+        break;
+    }
+
+    if (lowerOptr && upperOptr) {
+      vectorSelCompareColConst(cunit->dataType, lowerOptr, pCol->pData, cunit->valData, numOfRows, p);
+      vectorSelCompareColConst(cunit->dataType, upperOptr, pCol->pData, cunit->valData2, numOfRows, pTmp);
+      vectorSelAnd(p, pTmp, numOfRows);
+    } else if (lowerOptr) {
+      vectorSelCompareColConst(cunit->dataType, lowerOptr, pCol->pData, cunit->valData, numOfRows, p);
+    } else {
+      vectorSelCompareColConst(cunit->dataType, upperOptr, pCol->pData, cunit->valData2, numOfRows, p);
+    }
+  } else {
+    vectorSelCompareColConst(cunit->dataType, cunit->optr, pCol->pData, cunit->valData, numOfRows, p);
+  }
+
+  if (pCol->hasNull) {
+    vectorSelClearNull(p, pCol->nullbitmap, 0, numOfRows);
+  }
+}
+
+static FORCE_INLINE bool filterCanExecuteUnitSel(SFilterComUnit *cunit, int32_t numOfRows) {
+  SColumnInfoData *pCol = (SColumnInfoData *)cunit->colData;
+  return numOfRows >= SCL_SEL_COMPARE_MIN_ROWS && pCol != NULL && pCol->info.type == cunit->dataType &&
+         filterUnitSelSupported(cunit);
+}
+
+static int32_t filterExecuteSingleUnitSel(SFilterComUnit *cunit, int32_t numOfRows, int8_t *p,
+                                          int32_t *numOfQualified, bool *all) {
+  int8_t *pTmp = NULL;
+  if (cunit->rfunc >= 0 && cunit->rfunc < 4) {
+    pTmp = taosMemoryMalloc(numOfRows);
+    if (pTmp == NULL) {
+      FLT_ERR_RET(terrno);
+    }
+  }
+
+  filterExecuteUnitSel(cunit, numOfRows, p, pTmp);
+  taosMemoryFree(pTmp);
+
+  int32_t num = vectorSelCount(p, numOfRows);
+  *numOfQualified += num;
+  *all = (num == numOfRows);
+  FLT_RET(TSDB_CODE_SUCCESS);
+}
+
 int32_t filterExecuteImplRange(void *pinfo, int32_t numOfRows, SColumnInfoData *pRes, SColumnDataAgg *statis,
                             int16_t numOfCols, int32_t *numOfQualified, bool *all) {
   SFilterInfo  *info = (SFilterInfo *)pinfo;
@@ -3551,6 +3655,9 @@ int32_t filterExecuteImplRange(void *pinfo, int32_t numOfRows, SColumnInfoData *
   }
 
   int8_t *p = (int8_t *)pRes->pData;
+  if (filterCanExecuteUnitSel(&info->cunits[0], numOfRows)) {
+    return filterExecuteSingleUnitSel(&info->cunits[0], numOfRows, p, numOfQualified, all);
+  }
 
   for (int32_t i = 0; i < numOfRows; ++i) {
     SColumnInfoData *pData = info->cunits[0].colData;
@@ -3586,6 +3693,9 @@ int32_t filterExecuteImplMisc(void *pinfo, int32_t numOfRows, SColumnInfoData *p
   }
 
   int8_t *p = (int8_t *)pRes->pData;
+  if (filterCanExecuteUnitSel(&info->cunits[info->groups[0].unitIdxs[0]], numOfRows)) {
+    return filterExecuteSingleUnitSel(&info->cunits[info->groups[0].unitIdxs[0]], numOfRows, p, numOfQualified, all);
+  }
 
   for (int32_t i = 0; i < numOfRows; ++i) {
     uint32_t uidx = info->groups[0].unitIdxs[0];
@@ -3717,6 +3827,57 @@ int32_t filterExecuteImpl(void *pinfo, int32_t numOfRows, SColumnInfoData *pRes,
   FLT_RET(TSDB_CODE_SUCCESS);
 }
 
+// evaluate every unit over the whole block, AND the units of a group and OR the groups
+int32_t filterExecuteImplVec(void *pinfo, int32_t numOfRows, SColumnInfoData *pRes, SColumnDataAgg *statis,
+                             int16_t numOfCols, int32_t *numOfQualified, bool *all) {
+  SFilterInfo *info = (SFilterInfo *)pinfo;
+  int32_t      result = 0;
+
+  for (uint32_t u = 0; u < info->unitNum; ++u) {
+    if (!filterCanExecuteUnitSel(&info->cunits[u], numOfRows)) {
+      return filterExecuteImpl(pinfo, numOfRows, pRes, statis, numOfCols, numOfQualified, all);
+    }
+  }
+
+  *all = true;
+  FLT_ERR_RET(filterExecuteBasedOnStatis(info, numOfRows, pRes, statis, numOfCols, all, &result));
+  if (result == 0) {
+    FLT_RET(TSDB_CODE_SUCCESS);
+  }
+
+  int8_t *p = (int8_t *)pRes->pData;
+  int8_t *pBuf = taosMemoryMalloc(numOfRows * 3);
+  if (pBuf == NULL) {
+    FLT_ERR_RET(terrno);
+  }
+  int8_t *pGroup = pBuf;
+  int8_t *pUnit = pBuf + numOfRows;
+  int8_t *pTmp = pBuf + numOfRows * 2;
+
+  (void)memset(p, 0, numOfRows);
+  for (uint32_t g = 0; g < info->groupNum; ++g) {
+    SFilterGroup *group = &info->groups[g];
+    for (uint32_t u = 0; u < group->unitNum; ++u) {
+      SFilterComUnit *cunit = &info->cunits[group->unitIdxs[u]];
+      if (u == 0) {
+        filterExecuteUnitSel(cunit, numOfRows, pGroup, pTmp);
+      } else {
+        filterExecuteUnitSel(cunit, numOfRows, pUnit, pTmp);
+        vectorSelAnd(pGroup, pUnit, numOfRows);
+      }
+    }
+
+    vectorSelOr(p, pGroup, numOfRows);
+  }
+
+  taosMemoryFree(pBuf);
+
+  int32_t num = vectorSelCount(p, numOfRows);
+  *numOfQualified += num;
+  *all = (num == numOfRows);
+  FLT_RET(TSDB_CODE_SUCCESS);
+}
+
 int32_t filterSetExecFunc(SFilterInfo *info) {
   if (FILTER_ALL_RES(info)) {
     info->func = filterExecuteImplAll;
@@ -3729,7 +3890,13 @@ int32_t filterSetExecFunc(SFilterInfo *info) {
   }
 
   if (info->unitNum > 1) {
-    info->func = filterExecuteImpl;
+    info->func = filterExecuteImplVec;
+    for (uint32_t u = 0; u < info->unitNum; ++u) {
+      if (!filterUnitSelSupported(&info->cunits[u])) {
+        info->func = filterExecuteImpl;
+        break;
+      }
+    }
     return TSDB_CODE_SUCCESS;
   }
 
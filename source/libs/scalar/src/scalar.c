@@ -1,4 +1,5 @@
 #include "scalar.h"
+#include "filterInt.h"
 #include "function.h"
 #include "functionMgt.h"
 #include "nodes.h"
@@ -914,6 +915,583 @@ _return:
   SCL_RET(code);
 }
 
+/*
+ * Fused evaluation of arithmetic expressions. A tree of +, -, *, / and unary minus (optionally below one compare) is
+ * compiled into a post-ordered node list and evaluated batch by batch in one pass, without materializing a column for
+ * every intermediate operator and without per-row type dispatch. Integer sub-expressions stay in int64 as long as the
+ * magnitude bound fits in the double mantissa, so the result is the same as computing everything in double.
+ */
+#define SCL_FUSED_MAX_NODES      32
+#define SCL_FUSED_BATCH_ROWS     1024
+#define SCL_FUSED_INT_EXACT_BITS 53
+
+#define SCL_FUSED_OP_LEAF -1
+#define SCL_FUSED_OP_CAST -2
+
+typedef enum ESclFusedKind {
+  SCL_FUSED_RAW = 0,  // leaf read in place by the root compare
+  SCL_FUSED_I64,
+  SCL_FUSED_F64,
+} ESclFusedKind;
+
+typedef struct SSclFusedNode {
+  SNode       *pNode;
+  int32_t      op;
+  int8_t       kind;
+  int8_t       bits;  // upper bound of the integer magnitude in bits, for SCL_FUSED_I64
+  int16_t      left;
+  int16_t      right;
+  SScalarParam param;  // leaf input of the current block
+} SSclFusedNode;
+
+typedef struct SSclFusedExpr {
+  int32_t       nodeNum;
+  SSclFusedNode nodes[SCL_FUSED_MAX_NODES];  // post order, the last one is the root
+} SSclFusedExpr;
+
+static bool sclFusedIsValueType(int32_t type) {
+  switch (type) {
+    case TSDB_DATA_TYPE_BOOL:
+    case TSDB_DATA_TYPE_TINYINT:
+    case TSDB_DATA_TYPE_SMALLINT:
+    case TSDB_DATA_TYPE_INT:
+    case TSDB_DATA_TYPE_BIGINT:
+    case TSDB_DATA_TYPE_UTINYINT:
+    case TSDB_DATA_TYPE_USMALLINT:
+    case TSDB_DATA_TYPE_UINT:
+    case TSDB_DATA_TYPE_UBIGINT:
+    case TSDB_DATA_TYPE_FLOAT:
+    case TSDB_DATA_TYPE_DOUBLE:
+      return true;
+    default:
+      return false;
+  }
+}
+
+static bool sclFusedIsLeaf(SNode *pNode) {
+  switch (nodeType(pNode)) {
+    case QUERY_NODE_VALUE:
+    case QUERY_NODE_COLUMN:
+    case QUERY_NODE_FUNCTION:
+    case QUERY_NODE_OPERATOR:
+    case QUERY_NODE_LOGIC_CONDITION:
+    case QUERY_NODE_CASE_WHEN:
+      return sclFusedIsValueType(((SExprNode *)pNode)->resType.type);
+    default:
+      return false;
+  }
+}
+
+static bool sclFusedIsMathOp(SNode *pNode) {
+  if (QUERY_NODE_OPERATOR != nodeType(pNode)) {
+    return false;
+  }
+
+  SOperatorNode *pOp = (SOperatorNode *)pNode;
+  if (TSDB_DATA_TYPE_DOUBLE != pOp->node.resType.type || NULL == pOp->pLeft || !sclFusedIsLeaf(pOp->pLeft)) {
+    return false;
+  }
+
+  switch (pOp->opType) {
+    case OP_TYPE_MINUS:
+      return true;
+    case OP_TYPE_ADD:
+    case OP_TYPE_SUB:
+    case OP_TYPE_MULTI:
+    case OP_TYPE_DIV:
+      return NULL != pOp->pRight && sclFusedIsLeaf(pOp->pRight);
+    default:
+      return false;
+  }
+}
+
+static bool sclFusedIsCompareOp(SNode *pNode) {
+  if (QUERY_NODE_OPERATOR != nodeType(pNode)) {
+    return false;
+  }
+
+  SOperatorNode *pOp = (SOperatorNode *)pNode;
+  switch (pOp->opType) {
+    case OP_TYPE_GREATER_THAN:
+    case OP_TYPE_GREATER_EQUAL:
+    case OP_TYPE_LOWER_THAN:
+    case OP_TYPE_LOWER_EQUAL:
+    case OP_TYPE_EQUAL:
+    case OP_TYPE_NOT_EQUAL:
+      break;
+    default:
+      return false;
+  }
+
+  if (TSDB_DATA_TYPE_BOOL != pOp->node.resType.type || NULL == pOp->pLeft || NULL == pOp->pRight ||
+      !sclFusedIsLeaf(pOp->pLeft) || !sclFusedIsLeaf(pOp->pRight)) {
+    return false;
+  }
+
+  bool leftMath = sclFusedIsMathOp(pOp->pLeft);
+  bool rightMath = sclFusedIsMathOp(pOp->pRight);
+  // a side read in place is compared with the double of the other side, which has no compare function for bool
+  return (leftMath || rightMath) && (leftMath || IS_NUMERIC_TYPE(((SExprNode *)pOp->pLeft)->resType.type)) &&
+         (rightMath || IS_NUMERIC_TYPE(((SExprNode *)pOp->pRight)->resType.type));
+}
+
+static int8_t sclFusedLeafBits(SNode *pNode) {
+  int32_t type = ((SExprNode *)pNode)->resType.type;
+  if (QUERY_NODE_VALUE == nodeType(pNode) && !((SValueNode *)pNode)->isNull) {
+    void    *pData = nodesGetValueFromNode((SValueNode *)pNode);
+    uint64_t v = 0;
+    if (IS_SIGNED_NUMERIC_TYPE(type)) {
+      int64_t i = 0;
+      GET_TYPED_DATA(i, int64_t, type, pData);
+      v = (i < 0) ? -(uint64_t)i : (uint64_t)i;
+    } else if (IS_UNSIGNED_NUMERIC_TYPE(type) || TSDB_DATA_TYPE_BOOL == type) {
+      GET_TYPED_DATA(v, uint64_t, type, pData);
+    } else {
+      return 64;
+    }
+    return (v == 0) ? 0 : (int8_t)(64 - BUILDIN_CLZL(v));
+  }
+
+  switch (type) {
+    case TSDB_DATA_TYPE_BOOL:
+      return 1;
+    case TSDB_DATA_TYPE_TINYINT:
+      return 8;
+    case TSDB_DATA_TYPE_UTINYINT:
+      return 8;
+    case TSDB_DATA_TYPE_SMALLINT:
+    case TSDB_DATA_TYPE_USMALLINT:
+      return 16;
+    case TSDB_DATA_TYPE_INT:
+    case TSDB_DATA_TYPE_UINT:
+      return 32;
+    default:
+      return 64;
+  }
+}
+
+static bool sclFusedAppend(SSclFusedExpr *pExpr, SNode *pNode, int32_t op, int8_t kind, int8_t bits, int16_t left,
+                           int16_t right, int16_t *pIdx) {
+  if (pExpr->nodeNum >= SCL_FUSED_MAX_NODES) {
+    return false;
+  }
+
+  SSclFusedNode *pFused = &pExpr->nodes[pExpr->nodeNum];
+  pFused->pNode = pNode;
+  pFused->op = op;
+  pFused->kind = kind;
+  pFused->bits = bits;
+  pFused->left = left;
+  pFused->right = right;
+  *pIdx = (int16_t)pExpr->nodeNum++;
+  return true;
+}
+
+static bool sclFusedToF64(SSclFusedExpr *pExpr, int16_t *pIdx) {
+  if (SCL_FUSED_I64 != pExpr->nodes[*pIdx].kind) {
+    return true;
+  }
+
+  return sclFusedAppend(pExpr, NULL, SCL_FUSED_OP_CAST, SCL_FUSED_F64, 0, *pIdx, -1, pIdx);
+}
+
+static bool sclFusedBuildMath(SSclFusedExpr *pExpr, SNode *pNode, int16_t *pIdx) {
+  if (!sclFusedIsMathOp(pNode)) {
+    int8_t bits = sclFusedLeafBits(pNode);
+    int8_t kind = (bits <= SCL_FUSED_INT_EXACT_BITS) ? SCL_FUSED_I64 : SCL_FUSED_F64;
+    return sclFusedAppend(pExpr, pNode, SCL_FUSED_OP_LEAF, kind, bits, -1, -1, pIdx);
+  }
+
+  SOperatorNode *pOp = (SOperatorNode *)pNode;
+  int16_t        left = -1, right = -1;
+  if (!sclFusedBuildMath(pExpr, pOp->pLeft, &left)) {
+    return false;
+  }
+  if (OP_TYPE_MINUS != pOp->opType && !sclFusedBuildMath(pExpr, pOp->pRight, &right)) {
+    return false;
+  }
+
+  int32_t lbits = pExpr->nodes[left].bits;
+  int32_t rbits = (right >= 0) ? pExpr->nodes[right].bits : 0;
+  int32_t bits = 64;
+  switch (pOp->opType) {
+    case OP_TYPE_ADD:
+    case OP_TYPE_SUB:
+      bits = TMAX(lbits, rbits) + 1;
+      break;
+    case OP_TYPE_MULTI:
+      bits = lbits + rbits;
+      break;
+    case OP_TYPE_MINUS:
+      bits = lbits;
+      break;
+    default:
+      break;
+  }
+
+  bool isInt = (OP_TYPE_DIV != pOp->opType) && bits <= SCL_FUSED_INT_EXACT_BITS &&
+               SCL_FUSED_I64 == pExpr->nodes[left].kind && (right < 0 || SCL_FUSED_I64 == pExpr->nodes[right].kind);
+  if (!isInt) {
+    if (!sclFusedToF64(pExpr, &left) || (right >= 0 && !sclFusedToF64(pExpr, &right))) {
+      return false;
+    }
+  }
+
+  return sclFusedAppend(pExpr, pNode, pOp->opType, isInt ? SCL_FUSED_I64 : SCL_FUSED_F64, isInt ? bits : 64, left,
+                        right, pIdx);
+}
+
+static int32_t sclFusedCompile(SOperatorNode *pOp, SSclFusedExpr **ppExpr) {
+  *ppExpr = NULL;
+  if (!sclFusedIsMathOp((SNode *)pOp) && !sclFusedIsCompareOp((SNode *)pOp)) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  SSclFusedExpr *pExpr = taosMemoryCalloc(1, sizeof(SSclFusedExpr));
+  if (NULL == pExpr) {
+    SCL_ERR_RET(terrno);
+  }
+
+  bool    ok = true;
+  int16_t idx = -1;
+  if (sclFusedIsMathOp((SNode *)pOp)) {
+    ok = sclFusedBuildMath(pExpr, (SNode *)pOp, &idx) && sclFusedToF64(pExpr, &idx);
+  } else {
+    int16_t side[2] = {-1, -1};
+    SNode  *pSide[2] = {pOp->pLeft, pOp->pRight};
+    for (int32_t i = 0; i < 2 && ok; ++i) {
+      if (sclFusedIsMathOp(pSide[i])) {
+        ok = sclFusedBuildMath(pExpr, pSide[i], &side[i]) && sclFusedToF64(pExpr, &side[i]);
+      } else {
+        ok = sclFusedAppend(pExpr, pSide[i], SCL_FUSED_OP_LEAF, SCL_FUSED_RAW, 64, -1, -1, &side[i]);
+      }
+    }
+    ok = ok && sclFusedAppend(pExpr, (SNode *)pOp, pOp->opType, SCL_FUSED_RAW, 0, side[0], side[1], &idx);
+  }
+
+  if (!ok) {
+    taosMemoryFree(pExpr);
+    return TSDB_CODE_SUCCESS;
+  }
+
+  *ppExpr = pExpr;
+  return TSDB_CODE_SUCCESS;
+}
+
+static void sclFusedFreeExpr(void *p) { taosMemoryFree(*(SSclFusedExpr **)p); }
+
+static EDealRes sclFusedWalker(SNode *pNode, void *pContext) {
+  SScalarCtx *ctx = (SScalarCtx *)pContext;
+  if (QUERY_NODE_OPERATOR != nodeType(pNode)) {
+    return DEAL_RES_CONTINUE;
+  }
+
+  SSclFusedExpr *pExpr = NULL;
+  ctx->code = sclFusedCompile((SOperatorNode *)pNode, &pExpr);
+  if (ctx->code) {
+    return DEAL_RES_ERROR;
+  }
+  if (NULL == pExpr) {
+    return DEAL_RES_CONTINUE;
+  }
+
+  if (taosHashPut(ctx->pFused, &pNode, POINTER_BYTES, &pExpr, POINTER_BYTES)) {
+    taosMemoryFree(pExpr);
+    ctx->code = terrno;
+    return DEAL_RES_ERROR;
+  }
+
+  // the inner operators are evaluated by the root, the leaves are still computed by the normal walk
+  SSclFusedExpr *pNull = NULL;
+  for (int32_t i = 0; i < pExpr->nodeNum - 1; ++i) {
+    SSclFusedNode *pFused = &pExpr->nodes[i];
+    if (SCL_FUSED_OP_CAST == pFused->op) {
+      continue;
+    }
+    if (SCL_FUSED_OP_LEAF != pFused->op) {
+      if (taosHashPut(ctx->pFused, &pFused->pNode, POINTER_BYTES, &pNull, POINTER_BYTES)) {
+        ctx->code = terrno;
+        return DEAL_RES_ERROR;
+      }
+      continue;
+    }
+    if (QUERY_NODE_VALUE != nodeType(pFused->pNode) && QUERY_NODE_COLUMN != nodeType(pFused->pNode)) {
+      nodesWalkExpr(pFused->pNode, sclFusedWalker, ctx);
+      if (ctx->code) {
+        return DEAL_RES_ERROR;
+      }
+    }
+  }
+
+  return DEAL_RES_IGNORE_CHILD;
+}
+
+#define SCL_FUSED_LOAD(_dst, _st, _src, _isConst, _n)             \
+  do {                                                           \
+    const _st *_s = (const _st *)(_src);                         \
+    if (_isConst) {                                              \
+      for (int32_t _i = 0; _i < (_n); ++_i) (_dst)[_i] = _s[0];  \
+    } else {                                                     \
+      for (int32_t _i = 0; _i < (_n); ++_i) (_dst)[_i] = _s[_i]; \
+    }                                                            \
+  } while (0)
+
+#define SCL_FUSED_LOAD_TYPE(_dst, _type, _src, _isConst, _n)      \
+  do {                                                           \
+    switch (_type) {                                             \
+      case TSDB_DATA_TYPE_BOOL:                                  \
+      case TSDB_DATA_TYPE_TINYINT:                               \
+        SCL_FUSED_LOAD(_dst, int8_t, _src, _isConst, _n);        \
+        break;                                                   \
+      case TSDB_DATA_TYPE_SMALLINT:                              \
+        SCL_FUSED_LOAD(_dst, int16_t, _src, _isConst, _n);       \
+        break;                                                   \
+      case TSDB_DATA_TYPE_INT:                                   \
+        SCL_FUSED_LOAD(_dst, int32_t, _src, _isConst, _n);       \
+        break;                                                   \
+      case TSDB_DATA_TYPE_BIGINT:                                \
+        SCL_FUSED_LOAD(_dst, int64_t, _src, _isConst, _n);       \
+        break;                                                   \
+      case TSDB_DATA_TYPE_UTINYINT:                              \
+        SCL_FUSED_LOAD(_dst, uint8_t, _src, _isConst, _n);       \
+        break;                                                   \
+      case TSDB_DATA_TYPE_USMALLINT:                             \
+        SCL_FUSED_LOAD(_dst, uint16_t, _src, _isConst, _n);      \
+        break;                                                   \
+      case TSDB_DATA_TYPE_UINT:                                  \
+        SCL_FUSED_LOAD(_dst, uint32_t, _src, _isConst, _n);      \
+        break;                                                   \
+      case TSDB_DATA_TYPE_UBIGINT:                               \
+        SCL_FUSED_LOAD(_dst, uint64_t, _src, _isConst, _n);      \
+        break;                                                   \
+      case TSDB_DATA_TYPE_FLOAT:                                 \
+        SCL_FUSED_LOAD(_dst, float, _src, _isConst, _n);         \
+        break;                                                   \
+      default:                                                   \
+        SCL_FUSED_LOAD(_dst, double, _src, _isConst, _n);        \
+        break;                                                   \
+    }                                                            \
+  } while (0)
+
+#define SCL_FUSED_BINARY(_t, _expr)                                      \
+  do {                                                                   \
+    const _t *l = (const _t *)(regs + pFused->left * batch);             \
+    const _t *r = (const _t *)(regs + pFused->right * batch);            \
+    _t       *o = (_t *)(regs + idx * batch);                            \
+    for (int32_t i = 0; i < n; ++i) o[i] = (_expr);                      \
+  } while (0)
+
+static void sclFusedExecNode(SSclFusedExpr *pExpr, int32_t idx, int64_t *regs, int32_t batch, int32_t start,
+                             int32_t n, int32_t rowNum, char *nullBitmap) {
+  SSclFusedNode *pFused = &pExpr->nodes[idx];
+  int64_t       *pI64 = regs + idx * batch;
+  double        *pF64 = (double *)pI64;
+
+  switch (pFused->op) {
+    case SCL_FUSED_OP_LEAF: {
+      SColumnInfoData *pCol = pFused->param.columnData;
+      bool             isConst = (1 == pFused->param.numOfRows && rowNum > 1);
+      const char      *pSrc = pCol->pData + (isConst ? 0 : (int64_t)start * pCol->info.bytes);
+      if (SCL_FUSED_I64 == pFused->kind) {
+        SCL_FUSED_LOAD_TYPE(pI64, pCol->info.type, pSrc, isConst, n);
+      } else if (SCL_FUSED_F64 == pFused->kind) {
+        SCL_FUSED_LOAD_TYPE(pF64, pCol->info.type, pSrc, isConst, n);
+      }
+      break;
+    }
+    case SCL_FUSED_OP_CAST: {
+      const int64_t *pSrc = regs + pFused->left * batch;
+      for (int32_t i = 0; i < n; ++i) pF64[i] = (double)pSrc[i];
+      break;
+    }
+    case OP_TYPE_ADD:
+      if (SCL_FUSED_I64 == pFused->kind) {
+        SCL_FUSED_BINARY(int64_t, l[i] + r[i]);
+      } else {
+        SCL_FUSED_BINARY(double, l[i] + r[i]);
+      }
+      break;
+    case OP_TYPE_SUB:
+      if (SCL_FUSED_I64 == pFused->kind) {
+        SCL_FUSED_BINARY(int64_t, l[i] - r[i]);
+      } else {
+        SCL_FUSED_BINARY(double, l[i] - r[i]);
+      }
+      break;
+    case OP_TYPE_MULTI:
+      if (SCL_FUSED_I64 == pFused->kind) {
+        SCL_FUSED_BINARY(int64_t, l[i] * r[i]);
+      } else {
+        SCL_FUSED_BINARY(double, l[i] * r[i]);
+      }
+      break;
+    case OP_TYPE_DIV: {
+      const double *l = (const double *)(regs + pFused->left * batch);
+      const double *r = (const double *)(regs + pFused->right * batch);
+      for (int32_t i = 0; i < n; ++i) {
+        if (r[i] == 0) {  // divide by 0 is null
+          colDataSetNull_f(nullBitmap, start + i);
+          pF64[i] = 0;
+        } else {
+          pF64[i] = l[i] / r[i];
+        }
+      }
+      break;
+    }
+    case OP_TYPE_MINUS:
+      if (SCL_FUSED_I64 == pFused->kind) {
+        const int64_t *l = regs + pFused->left * batch;
+        for (int32_t i = 0; i < n; ++i) pI64[i] = -l[i];
+      } else {
+        const double *l = (const double *)(regs + pFused->left * batch);
+        for (int32_t i = 0; i < n; ++i) pF64[i] = (l[i] == 0) ? 0 : -l[i];
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+static void *sclFusedGetCompareData(SSclFusedExpr *pExpr, int16_t idx, int64_t *regs, int32_t batch, int32_t start,
+                                    int32_t i, int32_t rowNum) {
+  SSclFusedNode *pFused = &pExpr->nodes[idx];
+  if (SCL_FUSED_RAW != pFused->kind) {
+    return regs + idx * batch + i;
+  }
+
+  SColumnInfoData *pCol = pFused->param.columnData;
+  bool             isConst = (1 == pFused->param.numOfRows && rowNum > 1);
+  return pCol->pData + (isConst ? 0 : (int64_t)(start + i) * pCol->info.bytes);
+}
+
+static int32_t sclExecFused(SSclFusedExpr *pExpr, SScalarCtx *ctx, SScalarParam *output) {
+  int32_t        code = TSDB_CODE_SUCCESS;
+  int32_t        rowNum = 0;
+  int64_t       *regs = NULL;
+  char          *nullBitmap = NULL;
+  SSclFusedNode *pRoot = &pExpr->nodes[pExpr->nodeNum - 1];
+  bool           isCompare = (SCL_FUSED_RAW == pRoot->kind);
+  bool           allNull = false;
+
+  for (int32_t i = 0; i < pExpr->nodeNum; ++i) {
+    SSclFusedNode *pFused = &pExpr->nodes[i];
+    if (SCL_FUSED_OP_LEAF == pFused->op) {
+      SCL_ERR_JRET(sclInitParam(pFused->pNode, &pFused->param, ctx, &rowNum));
+      if (!sclFusedIsValueType(pFused->param.columnData->info.type)) {
+        sclError("invalid fused expression input type:%d", pFused->param.columnData->info.type);
+        SCL_ERR_JRET(TSDB_CODE_QRY_INVALID_INPUT);
+      }
+    }
+  }
+
+  SCL_ERR_JRET(sclCreateColumnInfoData(&((SExprNode *)pRoot->pNode)->resType, rowNum, output));
+  output->numOfRows = rowNum;
+  if (0 == rowNum) {
+    goto _return;
+  }
+
+  // null of any input makes the row null, merge the null bitmaps of all inputs at once
+  nullBitmap = taosMemoryCalloc(1, BitmapLen(rowNum));
+  if (NULL == nullBitmap) {
+    SCL_ERR_JRET(terrno);
+  }
+  for (int32_t i = 0; i < pExpr->nodeNum; ++i) {
+    SSclFusedNode *pFused = &pExpr->nodes[i];
+    if (SCL_FUSED_OP_LEAF != pFused->op || !pFused->param.columnData->hasNull) {
+      continue;
+    }
+
+    SColumnInfoData *pCol = pFused->param.columnData;
+    if (1 == pFused->param.numOfRows && rowNum > 1) {
+      allNull = allNull || colDataIsNull_f(pCol->nullbitmap, 0);
+      continue;
+    }
+    for (int32_t b = 0; b < BitmapLen(rowNum); ++b) {
+      nullBitmap[b] |= pCol->nullbitmap[b];
+    }
+  }
+
+  if (allNull) {
+    if (!isCompare) {
+      colDataSetNNULL(output->columnData, 0, rowNum);
+    }
+    output->numOfQualified = 0;
+    goto _return;
+  }
+
+  int32_t batch = TMIN(rowNum, SCL_FUSED_BATCH_ROWS);
+  regs = taosMemoryMalloc((int64_t)pExpr->nodeNum * batch * sizeof(int64_t));
+  if (NULL == regs) {
+    SCL_ERR_JRET(terrno);
+  }
+
+  __compar_fn_t fp = NULL;
+  if (isCompare) {
+    SSclFusedNode *pLeft = &pExpr->nodes[pRoot->left];
+    SSclFusedNode *pRight = &pExpr->nodes[pRoot->right];
+    int32_t        lType = (SCL_FUSED_RAW == pLeft->kind) ? GET_PARAM_TYPE(&pLeft->param) : TSDB_DATA_TYPE_DOUBLE;
+    int32_t        rType = (SCL_FUSED_RAW == pRight->kind) ? GET_PARAM_TYPE(&pRight->param) : TSDB_DATA_TYPE_DOUBLE;
+    if (!IS_NUMERIC_TYPE(lType) || !IS_NUMERIC_TYPE(rType)) {
+      sclError("invalid fused compare input type:%d, %d", lType, rType);
+      SCL_ERR_JRET(TSDB_CODE_QRY_INVALID_INPUT);
+    }
+    if (lType == rType) {
+      SCL_ERR_JRET(filterGetCompFunc(&fp, lType, pRoot->op));
+    } else {
+      fp = filterGetCompFuncEx(lType, rType, pRoot->op);
+    }
+    if (NULL == fp) {
+      sclError("no compare function for fused compare input type:%d, %d", lType, rType);
+      SCL_ERR_JRET(TSDB_CODE_QRY_INVALID_INPUT);
+    }
+  }
+
+  for (int32_t start = 0; start < rowNum; start += batch) {
+    int32_t n = TMIN(batch, rowNum - start);
+    for (int32_t i = 0; i < pExpr->nodeNum - (isCompare ? 1 : 0); ++i) {
+      sclFusedExecNode(pExpr, i, regs, batch, start, n, rowNum, nullBitmap);
+    }
+
+    if (isCompare) {
+      bool *pRes = (bool *)output->columnData->pData + start;
+      for (int32_t i = 0; i < n; ++i) {
+        if (colDataIsNull_f(nullBitmap, start + i)) {
+          pRes[i] = false;
+          continue;
+        }
+        pRes[i] = filterDoCompare(fp, pRoot->op,
+                                  sclFusedGetCompareData(pExpr, pRoot->left, regs, batch, start, i, rowNum),
+                                  sclFusedGetCompareData(pExpr, pRoot->right, regs, batch, start, i, rowNum));
+        output->numOfQualified += pRes[i];
+      }
+    } else {
+      (void)memcpy(output->columnData->pData + (int64_t)start * sizeof(double), regs + (pExpr->nodeNum - 1) * batch,
+                   n * sizeof(double));
+    }
+  }
+
+  if (!isCompare) {
+    for (int32_t b = 0; b < BitmapLen(rowNum); ++b) {
+      if (nullBitmap[b]) {
+        (void)memcpy(output->columnData->nullbitmap, nullBitmap, BitmapLen(rowNum));
+        output->columnData->hasNull = true;
+        break;
+      }
+    }
+  }
+
+_return:
+  for (int32_t i = 0; i < pExpr->nodeNum; ++i) {
+    if (SCL_FUSED_OP_LEAF == pExpr->nodes[i].op) {
+      sclFreeParam(&pExpr->nodes[i].param);
+      (void)memset(&pExpr->nodes[i].param, 0, sizeof(SScalarParam));
+    }
+  }
+  taosMemoryFree(regs);
+  taosMemoryFree(nullBitmap);
+  SCL_RET(code);
+}
+
 int32_t sclExecCaseWhen(SCaseWhenNode *node, SScalarCtx *ctx, SScalarParam *output) {
   int32_t       code = 0;
   SScalarParam *pCase = NULL;
@@ -1533,6 +2111,24 @@ EDealRes sclWalkOperator(SNode *pNode, SScalarCtx *ctx) {
   return DEAL_RES_CONTINUE;
 }
 
+static EDealRes sclWalkFused(SNode *pNode, SSclFusedExpr *pExpr, SScalarCtx *ctx) {
+  SScalarParam output = {0};
+
+  ctx->code = sclExecFused(pExpr, ctx, &output);
+  if (ctx->code) {
+    sclFreeParam(&output);
+    return DEAL_RES_ERROR;
+  }
+
+  if (taosHashPut(ctx->pRes, &pNode, POINTER_BYTES, &output, sizeof(output))) {
+    ctx->code = TSDB_CODE_OUT_OF_MEMORY;
+    sclFreeParam(&output);
+    return DEAL_RES_ERROR;
+  }
+
+  return DEAL_RES_CONTINUE;
+}
+
 EDealRes sclWalkTarget(SNode *pNode, SScalarCtx *ctx) {
   STargetNode *target = (STargetNode *)pNode;
 
@@ -1622,6 +2218,10 @@ EDealRes sclCalcWalker(SNode *pNode, void *pContext) {
 
   SScalarCtx *ctx = (SScalarCtx *)pContext;
   if (QUERY_NODE_OPERATOR == nodeType(pNode)) {
+    SSclFusedExpr **ppExpr = ctx->pFused ? (SSclFusedExpr **)taosHashGet(ctx->pFused, &pNode, POINTER_BYTES) : NULL;
+    if (ppExpr) {
+      return (NULL == *ppExpr) ? DEAL_RES_CONTINUE : sclWalkFused(pNode, *ppExpr, ctx);
+    }
     return sclWalkOperator(pNode, ctx);
   }
 
@@ -1794,6 +2394,16 @@ int32_t scalarCalculate(SNode *pNode, SArray *pBlockList, SScalarParam *pDst) {
     SCL_ERR_RET(terrno);
   }
 
+  ctx.pFused = taosHashInit(SCL_DEFAULT_OP_NUM, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BIGINT), false, HASH_NO_LOCK);
+  if (NULL == ctx.pFused) {
+    sclError("taosHashInit failed, num:%d", SCL_DEFAULT_OP_NUM);
+    SCL_ERR_JRET(terrno);
+  }
+  taosHashSetFreeFp(ctx.pFused, sclFusedFreeExpr);
+
+  nodesWalkExpr(pNode, sclFusedWalker, (void *)&ctx);
+  SCL_ERR_JRET(ctx.code);
+
   nodesWalkExprPostOrder(pNode, sclCalcWalker, (void *)&ctx);
   SCL_ERR_JRET(ctx.code);
 
@@ -1823,6 +2433,7 @@ int32_t scalarCalculate(SNode *pNode, SArray *pBlockList, SScalarParam *pDst) {
 
 _return:
   sclFreeRes(ctx.pRes);
+  taosHashCleanup(ctx.pFused);
   return code;
 }
 
@@ -0,0 +1,429 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "os.h"
+#include "function.h"
+#include "querynodes.h"
+#include "sclInt.h"
+#include "tdatablock.h"
+#include "ttypes.h"
+
+/*
+ * Type specialized compare kernels which write the selection vector (one int8 per row, 0 or 1) directly,
+ * instead of calling a __compar_fn_t for every row. Only integer types are handled here, since float and
+ * double compares use the tolerance based FLT_EQUAL semantic of compareFloatVal/compareDoubleVal.
+ */
+
+#define SEL_B(m, k)  ((uint64_t)(((m) >> (k)) & 1) << ((k) * 8))
+#define SEL_B8(m)    (SEL_B(m, 0) | SEL_B(m, 1) | SEL_B(m, 2) | SEL_B(m, 3) | SEL_B(m, 4) | SEL_B(m, 5) | SEL_B(m, 6) | SEL_B(m, 7))
+#define SEL_R2(n)    SEL_B8(n), SEL_B8((n) + 1)
+#define SEL_R4(n)    SEL_R2(n), SEL_R2((n) + 2)
+#define SEL_R8(n)    SEL_R4(n), SEL_R4((n) + 4)
+#define SEL_R16(n)   SEL_R8(n), SEL_R8((n) + 8)
+#define SEL_R32(n)   SEL_R16(n), SEL_R16((n) + 16)
+#define SEL_R64(n)   SEL_R32(n), SEL_R32((n) + 32)
+#define SEL_R128(n)  SEL_R64(n), SEL_R64((n) + 64)
+
+// the i-th byte of gSelExpand[m] is the i-th bit of m
+static const uint64_t gSelExpand[256] = {SEL_R128(0), SEL_R128(128)};
+
+static FORCE_INLINE void selStoreBits8(int8_t *pRes, uint32_t bits) {
+  uint64_t v = gSelExpand[bits & 0xFF];
+  (void)memcpy(pRes, &v, sizeof(v));
+}
+
+static FORCE_INLINE int32_t selMirrorOptr(int32_t optr) {
+  switch (optr) {
+    case OP_TYPE_GREATER_THAN:
+      return OP_TYPE_LOWER_THAN;
+    case OP_TYPE_GREATER_EQUAL:
+      return OP_TYPE_LOWER_EQUAL;
+    case OP_TYPE_LOWER_THAN:
+      return OP_TYPE_GREATER_THAN;
+    case OP_TYPE_LOWER_EQUAL:
+      return OP_TYPE_GREATER_EQUAL;
+    default:
+      return optr;
+  }
+}
+
+bool vectorSelCompareSupported(int32_t type, int32_t optr) {
+  switch (optr) {
+    case OP_TYPE_GREATER_THAN:
+    case OP_TYPE_GREATER_EQUAL:
+    case OP_TYPE_LOWER_THAN:
+    case OP_TYPE_LOWER_EQUAL:
+    case OP_TYPE_EQUAL:
+    case OP_TYPE_NOT_EQUAL:
+      break;
+    default:
+      return false;
+  }
+
+  switch (type) {
+    case TSDB_DATA_TYPE_BOOL:
+    case TSDB_DATA_TYPE_TINYINT:
+    case TSDB_DATA_TYPE_SMALLINT:
+    case TSDB_DATA_TYPE_INT:
+    case TSDB_DATA_TYPE_BIGINT:
+    case TSDB_DATA_TYPE_TIMESTAMP:
+    case TSDB_DATA_TYPE_UTINYINT:
+    case TSDB_DATA_TYPE_USMALLINT:
+    case TSDB_DATA_TYPE_UINT:
+    case TSDB_DATA_TYPE_UBIGINT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+#ifdef __AVX2__
+// GE/LE/NE are computed as the negation of LT/GT/EQ
+#define SEL_AVX2_CMP(_cmpgt, _cmpeq, _x, _y, _optr, _m, _neg) \
+  do {                                                       \
+    switch (_optr) {                                         \
+      case OP_TYPE_GREATER_THAN:                             \
+        _m = _cmpgt(_x, _y);                                 \
+        break;                                               \
+      case OP_TYPE_LOWER_EQUAL:                              \
+        _m = _cmpgt(_x, _y);                                 \
+        _neg = true;                                         \
+        break;                                               \
+      case OP_TYPE_LOWER_THAN:                               \
+        _m = _cmpgt(_y, _x);                                 \
+        break;                                               \
+      case OP_TYPE_GREATER_EQUAL:                            \
+        _m = _cmpgt(_y, _x);                                 \
+        _neg = true;                                         \
+        break;                                               \
+      case OP_TYPE_EQUAL:                                    \
+        _m = _cmpeq(_x, _y);                                 \
+        break;                                               \
+      default:                                               \
+        _m = _cmpeq(_x, _y);                                 \
+        _neg = true;                                         \
+        break;                                               \
+    }                                                        \
+  } while (0)
+
+static int32_t selCompareI8AVX2(const int8_t *pLeft, const int8_t *pRight, bool rightConst, bool isUnsigned,
+                                int32_t optr, int32_t numOfRows, int8_t *pRes) {
+  const __m256i bias = _mm256_set1_epi8(isUnsigned ? INT8_MIN : 0);
+  const __m256i c = _mm256_xor_si256(_mm256_set1_epi8(pRight[0]), bias);
+  int32_t       i = 0;
+  for (; i + 32 <= numOfRows; i += 32) {
+    __m256i x = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(pLeft + i)), bias);
+    __m256i y = rightConst ? c : _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(pRight + i)), bias);
+    __m256i m;
+    bool    neg = false;
+    SEL_AVX2_CMP(_mm256_cmpgt_epi8, _mm256_cmpeq_epi8, x, y, optr, m, neg);
+    uint32_t bits = (uint32_t)_mm256_movemask_epi8(m);
+    if (neg) bits = ~bits;
+    selStoreBits8(pRes + i, bits);
+    selStoreBits8(pRes + i + 8, bits >> 8);
+    selStoreBits8(pRes + i + 16, bits >> 16);
+    selStoreBits8(pRes + i + 24, bits >> 24);
+  }
+  return i;
+}
+
+static int32_t selCompareI32AVX2(const int32_t *pLeft, const int32_t *pRight, bool rightConst, bool isUnsigned,
+                                 int32_t optr, int32_t numOfRows, int8_t *pRes) {
+  const __m256i bias = _mm256_set1_epi32(isUnsigned ? INT32_MIN : 0);
+  const __m256i c = _mm256_xor_si256(_mm256_set1_epi32(pRight[0]), bias);
+  int32_t       i = 0;
+  for (; i + 8 <= numOfRows; i += 8) {
+    __m256i x = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(pLeft + i)), bias);
+    __m256i y = rightConst ? c : _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(pRight + i)), bias);
+    __m256i m;
+    bool    neg = false;
+    SEL_AVX2_CMP(_mm256_cmpgt_epi32, _mm256_cmpeq_epi32, x, y, optr, m, neg);
+    uint32_t bits = (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(m));
+    selStoreBits8(pRes + i, neg ? ~bits : bits);
+  }
+  return i;
+}
+
+static int32_t selCompareI64AVX2(const int64_t *pLeft, const int64_t *pRight, bool rightConst, bool isUnsigned,
+                                 int32_t optr, int32_t numOfRows, int8_t *pRes) {
+  const __m256i bias = _mm256_set1_epi64x(isUnsigned ? INT64_MIN : 0);
+  const __m256i c = _mm256_xor_si256(_mm256_set1_epi64x(pRight[0]), bias);
+  int32_t       i = 0;
+  for (; i + 8 <= numOfRows; i += 8) {
+    uint32_t bits = 0;
+    bool     neg = false;
+    for (int32_t k = 0; k < 2; ++k) {
+      __m256i x = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(pLeft + i + k * 4)), bias);
+      __m256i y = rightConst ? c : _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(pRight + i + k * 4)), bias);
+      __m256i m;
+      neg = false;
+      SEL_AVX2_CMP(_mm256_cmpgt_epi64, _mm256_cmpeq_epi64, x, y, optr, m, neg);
+      bits |= ((uint32_t)_mm256_movemask_pd(_mm256_castsi256_pd(m))) << (k * 4);
+    }
+    selStoreBits8(pRes + i, neg ? ~bits : bits);
+  }
+  return i;
+}
+#endif
+
+#if defined(__AVX512F__)
+static FORCE_INLINE int32_t selAVX512Predicate(int32_t optr) {
+  switch (optr) {
+    case OP_TYPE_GREATER_THAN:
+      return _MM_CMPINT_NLE;
+    case OP_TYPE_GREATER_EQUAL:
+      return _MM_CMPINT_NLT;
+    case OP_TYPE_LOWER_THAN:
+      return _MM_CMPINT_LT;
+    case OP_TYPE_LOWER_EQUAL:
+      return _MM_CMPINT_LE;
+    case OP_TYPE_EQUAL:
+      return _MM_CMPINT_EQ;
+    default:
+      return _MM_CMPINT_NE;
+  }
+}
+
+static int32_t selCompareI32AVX512(const int32_t *pLeft, const int32_t *pRight, bool rightConst, bool isUnsigned,
+                                   int32_t optr, int32_t numOfRows, int8_t *pRes) {
+  const __m512i c = _mm512_set1_epi32(pRight[0]);
+  int32_t       i = 0;
+#define SEL_AVX512_I32_LOOP(_pred)                                                                             \
+  for (; i + 16 <= numOfRows; i += 16) {                                                                       \
+    __m512i   x = _mm512_loadu_si512((const void *)(pLeft + i));                                              \
+    __m512i   y = rightConst ? c : _mm512_loadu_si512((const void *)(pRight + i));                            \
+    __mmask16 m = isUnsigned ? _mm512_cmp_epu32_mask(x, y, _pred) : _mm512_cmp_epi32_mask(x, y, _pred);       \
+    selStoreBits8(pRes + i, m);                                                                                \
+    selStoreBits8(pRes + i + 8, m >> 8);                                                                       \
+  }
+  switch (selAVX512Predicate(optr)) {
+    case _MM_CMPINT_NLE:
+      SEL_AVX512_I32_LOOP(_MM_CMPINT_NLE);
+      break;
+    case _MM_CMPINT_NLT:
+      SEL_AVX512_I32_LOOP(_MM_CMPINT_NLT);
+      break;
+    case _MM_CMPINT_LT:
+      SEL_AVX512_I32_LOOP(_MM_CMPINT_LT);
+      break;
+    case _MM_CMPINT_LE:
+      SEL_AVX512_I32_LOOP(_MM_CMPINT_LE);
+      break;
+    case _MM_CMPINT_EQ:
+      SEL_AVX512_I32_LOOP(_MM_CMPINT_EQ);
+      break;
+    default:
+      SEL_AVX512_I32_LOOP(_MM_CMPINT_NE);
+      break;
+  }
+#undef SEL_AVX512_I32_LOOP
+  return i;
+}
+
+static int32_t selCompareI64AVX512(const int64_t *pLeft, const int64_t *pRight, bool rightConst, bool isUnsigned,
+                                   int32_t optr, int32_t numOfRows, int8_t *pRes) {
+  const __m512i c = _mm512_set1_epi64(pRight[0]);
+  int32_t       i = 0;
+#define SEL_AVX512_I64_LOOP(_pred)                                                                            \
+  for (; i + 8 <= numOfRows; i += 8) {                                                                        \
+    __m512i  x = _mm512_loadu_si512((const void *)(pLeft + i));                                              \
+    __m512i  y = rightConst ? c : _mm512_loadu_si512((const void *)(pRight + i));                            \
+    __mmask8 m = isUnsigned ? _mm512_cmp_epu64_mask(x, y, _pred) : _mm512_cmp_epi64_mask(x, y, _pred);       \
+    selStoreBits8(pRes + i, m);                                                                               \
+  }
+  switch (selAVX512Predicate(optr)) {
+    case _MM_CMPINT_NLE:
+      SEL_AVX512_I64_LOOP(_MM_CMPINT_NLE);
+      break;
+    case _MM_CMPINT_NLT:
+      SEL_AVX512_I64_LOOP(_MM_CMPINT_NLT);
+      break;
+    case _MM_CMPINT_LT:
+      SEL_AVX512_I64_LOOP(_MM_CMPINT_LT);
+      break;
+    case _MM_CMPINT_LE:
+      SEL_AVX512_I64_LOOP(_MM_CMPINT_LE);
+      break;
+    case _MM_CMPINT_EQ:
+      SEL_AVX512_I64_LOOP(_MM_CMPINT_EQ);
+      break;
+    default:
+      SEL_AVX512_I64_LOOP(_MM_CMPINT_NE);
+      break;
+  }
+#undef SEL_AVX512_I64_LOOP
+  return i;
+}
+#endif
+
+static int32_t selCompareSIMD(int32_t type, int32_t optr, const void *pLeft, const void *pRight, bool rightConst,
+                              int32_t numOfRows, int8_t *pRes) {
+  bool isUnsigned = IS_UNSIGNED_NUMERIC_TYPE(type);
+  switch (tDataTypes[type].bytes) {
+    case sizeof(int8_t):
+#ifdef __AVX2__
+      if (tsSIMDEnable && tsAVX2Supported) {
+        return selCompareI8AVX2(pLeft, pRight, rightConst, isUnsigned, optr, numOfRows, pRes);
+      }
+#endif
+      break;
+    case sizeof(int32_t):
+#if defined(__AVX512F__)
+      if (tsSIMDEnable && tsAVX512Supported && tsAVX512Enable) {
+        return selCompareI32AVX512(pLeft, pRight, rightConst, isUnsigned, optr, numOfRows, pRes);
+      }
+#endif
+#ifdef __AVX2__
+      if (tsSIMDEnable && tsAVX2Supported) {
+        return selCompareI32AVX2(pLeft, pRight, rightConst, isUnsigned, optr, numOfRows, pRes);
+      }
+#endif
+      break;
+    case sizeof(int64_t):
+#if defined(__AVX512F__)
+      if (tsSIMDEnable && tsAVX512Supported && tsAVX512Enable) {
+        return selCompareI64AVX512(pLeft, pRight, rightConst, isUnsigned, optr, numOfRows, pRes);
+      }
+#endif
+#ifdef __AVX2__
+      if (tsSIMDEnable && tsAVX2Supported) {
+        return selCompareI64AVX2(pLeft, pRight, rightConst, isUnsigned, optr, numOfRows, pRes);
+      }
+#endif
+      break;
+    default:
+      break;
+  }
+
+  return 0;
+}
+
+#define SEL_CMP_LOOP(_t, _op)                                                                        \
+  do {                                                                                               \
+    const _t *_l = (const _t *)pLeft;                                                                \
+    const _t *_r = (const _t *)pRight;                                                               \
+    if (rightConst) {                                                                                \
+      const _t _v = _r[0];                                                                           \
+      for (int32_t i = start; i < numOfRows; ++i) pRes[i] = (_l[i] _op _v);                          \
+    } else {                                                                                         \
+      for (int32_t i = start; i < numOfRows; ++i) pRes[i] = (_l[i] _op _r[i]);                       \
+    }                                                                                                \
+  } while (0)
+
+#define SEL_CMP_TYPE(_t)              \
+  do {                                \
+    switch (optr) {                   \
+      case OP_TYPE_GREATER_THAN:      \
+        SEL_CMP_LOOP(_t, >);          \
+        break;                        \
+      case OP_TYPE_GREATER_EQUAL:     \
+        SEL_CMP_LOOP(_t, >=);         \
+        break;                        \
+      case OP_TYPE_LOWER_THAN:        \
+        SEL_CMP_LOOP(_t, <);          \
+        break;                        \
+      case OP_TYPE_LOWER_EQUAL:       \
+        SEL_CMP_LOOP(_t, <=);         \
+        break;                        \
+      case OP_TYPE_EQUAL:             \
+        SEL_CMP_LOOP(_t, ==);         \
+        break;                        \
+      default:                        \
+        SEL_CMP_LOOP(_t, !=);         \
+        break;                        \
+    }                                 \
+  } while (0)
+
+static void selCompare(int32_t type, int32_t optr, const void *pLeft, const void *pRight, bool rightConst,
+                       int32_t numOfRows, int8_t *pRes) {
+  int32_t start = selCompareSIMD(type, optr, pLeft, pRight, rightConst, numOfRows, pRes);
+
+  switch (type) {
+    case TSDB_DATA_TYPE_BOOL:
+    case TSDB_DATA_TYPE_TINYINT:
+      SEL_CMP_TYPE(int8_t);
+      break;
+    case TSDB_DATA_TYPE_SMALLINT:
+      SEL_CMP_TYPE(int16_t);
+      break;
+    case TSDB_DATA_TYPE_INT:
+      SEL_CMP_TYPE(int32_t);
+      break;
+    case TSDB_DATA_TYPE_BIGINT:
+    case TSDB_DATA_TYPE_TIMESTAMP:
+      SEL_CMP_TYPE(int64_t);
+      break;
+    case TSDB_DATA_TYPE_UTINYINT:
+      SEL_CMP_TYPE(uint8_t);
+      break;
+    case TSDB_DATA_TYPE_USMALLINT:
+      SEL_CMP_TYPE(uint16_t);
+      break;
+    case TSDB_DATA_TYPE_UINT:
+      SEL_CMP_TYPE(uint32_t);
+      break;
+    default:
+      SEL_CMP_TYPE(uint64_t);
+      break;
+  }
+}
+
+void vectorSelCompareColConst(int32_t type, int32_t optr, const void *pCol, const void *pVal, int32_t numOfRows,
+                              int8_t *pRes) {
+  selCompare(type, optr, pCol, pVal, true, numOfRows, pRes);
+}
+
+void vectorSelCompareConstCol(int32_t type, int32_t optr, const void *pVal, const void *pCol, int32_t numOfRows,
+                              int8_t *pRes) {
+  selCompare(type, selMirrorOptr(optr), pCol, pVal, true, numOfRows, pRes);
+}
+
+void vectorSelCompareColCol(int32_t type, int32_t optr, const void *pLeft, const void *pRight, int32_t numOfRows,
+                            int8_t *pRes) {
+  selCompare(type, optr, pLeft, pRight, false, numOfRows, pRes);
+}
+
+void vectorSelClearNull(int8_t *pRes, const char *nullBitmap, int32_t start, int32_t numOfRows) {
+  for (int32_t i = start; i < start + numOfRows;) {
+    if ((i & 0x07) == 0 && i + 8 <= start + numOfRows && nullBitmap[i >> 3] == 0) {
+      i += 8;
+      continue;
+    }
+    if (colDataIsNull_f(nullBitmap, i)) {
+      pRes[i - start] = 0;
+    }
+    ++i;
+  }
+}
+
+void vectorSelAnd(int8_t *pRes, const int8_t *pSel, int32_t numOfRows) {
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    pRes[i] &= pSel[i];
+  }
+}
+
+void vectorSelOr(int8_t *pRes, const int8_t *pSel, int32_t numOfRows) {
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    pRes[i] |= pSel[i];
+  }
+}
+
+int32_t vectorSelCount(const int8_t *pRes, int32_t numOfRows) {
+  int32_t num = 0;
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    num += pRes[i];
+  }
+  return num;
+}
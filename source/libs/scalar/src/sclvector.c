@@ -1875,10 +1875,60 @@ _return:
   SCL_RET(code);
 }
 
+static bool doVectorSelCompare(SScalarParam *pLeft, SScalarParam *pRight, SScalarParam *pOut, int32_t startIndex,
+                               int32_t numOfRows, int32_t step, int32_t optr, int32_t *num) {
+  int32_t type = GET_PARAM_TYPE(pLeft);
+  int32_t rows = numOfRows - startIndex;
+  if (step != 1 || startIndex < 0 || rows < SCL_SEL_COMPARE_MIN_ROWS || type != GET_PARAM_TYPE(pRight) ||
+      !vectorSelCompareSupported(type, optr)) {
+    return false;
+  }
+
+  SColumnInfoData *pLeftCol = pLeft->columnData;
+  SColumnInfoData *pRightCol = pRight->columnData;
+  bool             leftConst = (pLeft->numOfRows == 1 && numOfRows > 1);
+  bool             rightConst = (pRight->numOfRows == 1 && numOfRows > 1);
+  if ((leftConst && rightConst) || (!leftConst && pLeft->numOfRows < numOfRows) ||
+      (!rightConst && pRight->numOfRows < numOfRows)) {
+    return false;
+  }
+
+  int8_t *pRes = (int8_t *)pOut->columnData->pData + startIndex;
+  int32_t bytes = tDataTypes[type].bytes;
+  if ((leftConst && pLeftCol->hasNull && colDataIsNull_f(pLeftCol->nullbitmap, 0)) ||
+      (rightConst && pRightCol->hasNull && colDataIsNull_f(pRightCol->nullbitmap, 0))) {
+    (void)memset(pRes, 0, rows);
+    return true;
+  }
+
+  if (leftConst) {
+    vectorSelCompareConstCol(type, optr, pLeftCol->pData, pRightCol->pData + startIndex * bytes, rows, pRes);
+  } else if (rightConst) {
+    vectorSelCompareColConst(type, optr, pLeftCol->pData + startIndex * bytes, pRightCol->pData, rows, pRes);
+  } else {
+    vectorSelCompareColCol(type, optr, pLeftCol->pData + startIndex * bytes, pRightCol->pData + startIndex * bytes,
+                           rows, pRes);
+  }
+
+  if (!leftConst && pLeftCol->hasNull) {
+    vectorSelClearNull(pRes, pLeftCol->nullbitmap, startIndex, rows);
+  }
+  if (!rightConst && pRightCol->hasNull) {
+    vectorSelClearNull(pRes, pRightCol->nullbitmap, startIndex, rows);
+  }
+
+  *num += vectorSelCount(pRes, rows);
+  return true;
+}
+
 int32_t doVectorCompareImpl(SScalarParam *pLeft, SScalarParam *pRight, SScalarParam *pOut, int32_t startIndex,
                             int32_t numOfRows, int32_t step, __compar_fn_t fp, int32_t optr, int32_t *num) {
   bool   *pRes = (bool *)pOut->columnData->pData;
   int32_t code = TSDB_CODE_SUCCESS;
+  if (doVectorSelCompare(pLeft, pRight, pOut, startIndex, numOfRows, step, optr, num)) {
+    return code;
+  }
+
   if (IS_MATHABLE_TYPE(GET_PARAM_TYPE(pLeft)) && IS_MATHABLE_TYPE(GET_PARAM_TYPE(pRight))) {
     if (!(pLeft->columnData->hasNull || pRight->columnData->hasNull)) {
       for (int32_t i = startIndex; i < numOfRows && i >= 0; i += step) {
@@ -1894,6 +1894,110 @@ TEST(columnTest, smallint_value_add_int_column) {
   nodesDestroyNode(opNode);
 }
 
+TEST(columnTest, fused_int_column_arith_chain) {
+  SNode       *pCol = NULL, *pMul = NULL, *pSub = NULL, *pDiv = NULL, *opNode = NULL, *pVal = NULL;
+  int32_t      colv[5] = {0, -5, 4, 23, 100};
+  int32_t      mulv = 3, subv = 1;
+  double       divv = 2.5;
+  double       eRes[5] = {0};
+  SSDataBlock *src = NULL;
+  int32_t      rowNum = sizeof(colv) / sizeof(colv[0]);
+  int32_t      code = TSDB_CODE_SUCCESS;
+  for (int32_t i = 0; i < rowNum; ++i) {
+    eRes[i] = ((double)colv[i] * mulv - subv) / divv;
+  }
+
+  // ((col * 3) - 1) / 2.5
+  code = scltMakeColumnNode(&pCol, &src, TSDB_DATA_TYPE_INT, sizeof(int32_t), rowNum, colv);
+  ASSERT_EQ(code, TSDB_CODE_SUCCESS);
+  code = scltMakeValueNode(&pVal, TSDB_DATA_TYPE_INT, &mulv);
+  ASSERT_EQ(code, TSDB_CODE_SUCCESS);
+  code = scltMakeOpNode(&pMul, OP_TYPE_MULTI, TSDB_DATA_TYPE_DOUBLE, pCol, pVal);
+  ASSERT_EQ(code, TSDB_CODE_SUCCESS);
+  code = scltMakeValueNode(&pVal, TSDB_DATA_TYPE_INT, &subv);
+  ASSERT_EQ(code, TSDB_CODE_SUCCESS);
+  code = scltMakeOpNode(&pSub, OP_TYPE_SUB, TSDB_DATA_TYPE_DOUBLE, pMul, pVal);
+  ASSERT_EQ(code, TSDB_CODE_SUCCESS);
+  code = scltMakeValueNode(&pVal, TSDB_DATA_TYPE_DOUBLE, &divv);
+  ASSERT_EQ(code, TSDB_CODE_SUCCESS);
+  code = scltMakeOpNode(&pDiv, OP_TYPE_DIV, TSDB_DATA_TYPE_DOUBLE, pSub, pVal);
+  ASSERT_EQ(code, TSDB_CODE_SUCCESS);
+  opNode = pDiv;
+
+  SArray *blockList = taosArrayInit(2, POINTER_BYTES);
+  ASSERT_NE(blockList, nullptr);
+  ASSERT_NE(taosArrayPush(blockList, &src), nullptr);
+  SColumnInfo colInfo = createColumnInfo(1, TSDB_DATA_TYPE_DOUBLE, sizeof(double));
+  int16_t     dataBlockId = 0, slotId = 0;
+  code = scltAppendReservedSlot(blockList, &dataBlockId, &slotId, true, rowNum, &colInfo);
+  ASSERT_EQ(code, TSDB_CODE_SUCCESS);
+  code = scltMakeTargetNode(&opNode, dataBlockId, slotId, opNode);
+  ASSERT_EQ(code, TSDB_CODE_SUCCESS);
+
+  code = scalarCalculate(opNode, blockList, NULL);
+  ASSERT_EQ(code, TSDB_CODE_SUCCESS);
+
+  SSDataBlock *res = *(SSDataBlock **)taosArrayGetLast(blockList);
+  ASSERT_EQ(res->info.rows, rowNum);
+  SColumnInfoData *column = (SColumnInfoData *)taosArrayGetLast(res->pDataBlock);
+  ASSERT_EQ(column->info.type, TSDB_DATA_TYPE_DOUBLE);
+  for (int32_t i = 0; i < rowNum; ++i) {
+    ASSERT_FALSE(colDataIsNull_s(column, i));
+    ASSERT_EQ(*((double *)colDataGetData(column, i)), eRes[i]);
+  }
+
+  taosArrayDestroyEx(blockList, scltFreeDataBlock);
+  nodesDestroyNode(opNode);
+}
+
+// a bool operand can't be read in place by the fused compare, the compare is evaluated the normal way
+TEST(columnTest, fused_bool_column_greater_int_column_arith) {
+  SNode       *pBool = NULL, *pInt = NULL, *pMul = NULL, *pVal = NULL, *opNode = NULL;
+  bool         boolv[5] = {true, false, true, false, true};
+  int32_t      intv[5] = {0, 0, 1, 2, -3};
+  int32_t      mulv = 2;
+  bool         eRes[5] = {true, false, false, false, true};
+  SSDataBlock *src = NULL;
+  int32_t      rowNum = sizeof(intv) / sizeof(intv[0]);
+  int32_t      code = TSDB_CODE_SUCCESS;
+
+  // bool_col > int_col * 2
+  code = scltMakeColumnNode(&pBool, &src, TSDB_DATA_TYPE_BOOL, sizeof(bool), rowNum, boolv);
+  ASSERT_EQ(code, TSDB_CODE_SUCCESS);
+  code = scltMakeColumnNode(&pInt, &src, TSDB_DATA_TYPE_INT, sizeof(int32_t), rowNum, intv);
+  ASSERT_EQ(code, TSDB_CODE_SUCCESS);
+  code = scltMakeValueNode(&pVal, TSDB_DATA_TYPE_INT, &mulv);
+  ASSERT_EQ(code, TSDB_CODE_SUCCESS);
+  code = scltMakeOpNode(&pMul, OP_TYPE_MULTI, TSDB_DATA_TYPE_DOUBLE, pInt, pVal);
+  ASSERT_EQ(code, TSDB_CODE_SUCCESS);
+  code = scltMakeOpNode(&opNode, OP_TYPE_GREATER_THAN, TSDB_DATA_TYPE_BOOL, pBool, pMul);
+  ASSERT_EQ(code, TSDB_CODE_SUCCESS);
+
+  SArray *blockList = taosArrayInit(1, POINTER_BYTES);
+  ASSERT_NE(blockList, nullptr);
+  ASSERT_NE(taosArrayPush(blockList, &src), nullptr);
+  SColumnInfo colInfo = createColumnInfo(1, TSDB_DATA_TYPE_BOOL, sizeof(bool));
+  int16_t     dataBlockId = 0, slotId = 0;
+  code = scltAppendReservedSlot(blockList, &dataBlockId, &slotId, true, rowNum, &colInfo);
+  ASSERT_EQ(code, TSDB_CODE_SUCCESS);
+  code = scltMakeTargetNode(&opNode, dataBlockId, slotId, opNode);
+  ASSERT_EQ(code, TSDB_CODE_SUCCESS);
+
+  code = scalarCalculate(opNode, blockList, NULL);
+  ASSERT_EQ(code, TSDB_CODE_SUCCESS);
+
+  SSDataBlock *res = *(SSDataBlock **)taosArrayGetLast(blockList);
+  ASSERT_EQ(res->info.rows, rowNum);
+  SColumnInfoData *column = (SColumnInfoData *)taosArrayGetLast(res->pDataBlock);
+  ASSERT_EQ(column->info.type, TSDB_DATA_TYPE_BOOL);
+  for (int32_t i = 0; i < rowNum; ++i) {
+    ASSERT_EQ(*((bool *)colDataGetData(column, i)), eRes[i]);
+  }
+
+  taosArrayDestroyEx(blockList, scltFreeDataBlock);
+  nodesDestroyNode(opNode);
+}
+
 TEST(columnTest, bigint_column_multi_binary_column) {
   SNode  *pLeft = NULL, *pRight = NULL, *opNode = NULL;
   int64_t leftv[5] = {1, 2, 3, 4, 5};
@@ -2102,6 +2206,49 @@ TEST(columnTest, smallint_column_greater_double_value) {
   nodesDestroyNode(opNode);
 }
 
+TEST(columnTest, bigint_column_greater_equal_bigint_value) {
+  SNode       *pLeft = NULL, *pRight = NULL, *opNode = NULL;
+  int64_t      leftv[40] = {0};
+  int64_t      rightv = 17;
+  bool         eRes[40] = {0};
+  SSDataBlock *src = NULL;
+  int32_t      rowNum = sizeof(leftv) / sizeof(leftv[0]);
+  int32_t      code = TSDB_CODE_SUCCESS;
+  for (int32_t i = 0; i < rowNum; ++i) {
+    leftv[i] = (i % 2) ? i : -i;
+    eRes[i] = (leftv[i] >= rightv);
+  }
+  code = scltMakeColumnNode(&pLeft, &src, TSDB_DATA_TYPE_BIGINT, sizeof(int64_t), rowNum, leftv);
+  ASSERT_EQ(code, TSDB_CODE_SUCCESS);
+  code = scltMakeValueNode(&pRight, TSDB_DATA_TYPE_BIGINT, &rightv);
+  ASSERT_EQ(code, TSDB_CODE_SUCCESS);
+  code = scltMakeOpNode(&opNode, OP_TYPE_GREATER_EQUAL, TSDB_DATA_TYPE_BOOL, pLeft, pRight);
+  ASSERT_EQ(code, TSDB_CODE_SUCCESS);
+
+  SArray *blockList = taosArrayInit(1, POINTER_BYTES);
+  ASSERT_NE(blockList, nullptr);
+  ASSERT_NE(taosArrayPush(blockList, &src), nullptr);
+  SColumnInfo colInfo = createColumnInfo(1, TSDB_DATA_TYPE_BOOL, sizeof(bool));
+  int16_t     dataBlockId = 0, slotId = 0;
+  code = scltAppendReservedSlot(blockList, &dataBlockId, &slotId, true, rowNum, &colInfo);
+  ASSERT_EQ(code, TSDB_CODE_SUCCESS);
+  code = scltMakeTargetNode(&opNode, dataBlockId, slotId, opNode);
+  ASSERT_EQ(code, TSDB_CODE_SUCCESS);
+
+  code = scalarCalculate(opNode, blockList, NULL);
+  ASSERT_EQ(code, TSDB_CODE_SUCCESS);
+
+  SSDataBlock *res = *(SSDataBlock **)taosArrayGetLast(blockList);
+  ASSERT_EQ(res->info.rows, rowNum);
+  SColumnInfoData *column = (SColumnInfoData *)taosArrayGetLast(res->pDataBlock);
+  ASSERT_EQ(column->info.type, TSDB_DATA_TYPE_BOOL);
+  for (int32_t i = 0; i < rowNum; ++i) {
+    ASSERT_EQ(*((bool *)colDataGetData(column, i)), eRes[i]);
+  }
+  taosArrayDestroyEx(blockList, scltFreeDataBlock);
+  nodesDestroyNode(opNode);
+}
+
 TEST(columnTest, int_column_in_double_list) {
   SNode       *pLeft = NULL, *pRight = NULL, *listNode = NULL, *opNode = NULL;
   int32_t      leftv[5] = {1, 2, 3, 4, 5};
@@ -229,6 +229,7 @@ typedef struct SSchTask {
   int32_t         delayExecMs;     // task execution delay time
   tmr_h           delayTimer;      // task delay execution timer
   SSchRedirectCtx redirectCtx;     // task redirect context
+  int64_t         admitStartTs;    // first admission rejection of the task, 0 if it is not rejected
   bool            waitRetry;       // wait for retry
   int32_t         execId;          // task current execute index
   int32_t         failedExecId;    // last failed task execute index
@@ -259,6 +260,8 @@ typedef struct SSchJobAttr {
   bool         needFetch;
   bool         needFlowCtrl;
   bool         localExec;
+  int32_t      maxFollowerLag;
+  bool         lowLatency;
 } SSchJobAttr;
 
 typedef struct {
@@ -303,6 +306,7 @@ typedef struct SSchJob {
   bool                 fetched;
   bool                 noMoreRetry;
   int64_t              resNumOfRows;  // from int32_t to int64_t
+  int64_t              peakMem;       // max peak memory in the fetch rsp trailers
   SSchResInfo          userRes;
   char                *sql;
   SQueryProfileSummary summary;
@@ -334,6 +338,8 @@ extern SSchedulerMgmt schMgmt;
   (((task)->plan->subplanType == SUBPLAN_TYPE_SCAN) || ((task)->plan->subplanType == SUBPLAN_TYPE_MODIFY))
 #define SCH_IS_LEAF_TASK(_job, _task) (((_task)->level->level + 1) == (_job)->levelNum)
 #define SCH_IS_DATA_MERGE_TASK(task)  (!SCH_IS_DATA_BIND_TASK(task))
+#define SCH_FOLLOWER_READ_ENABLED(_job, _task) \
+  ((_job)->attr.maxFollowerLag >= 0 && SCH_IS_QUERY_JOB(_job) && SCH_IS_DATA_BIND_QRY_TASK(_task))
 #define SCH_IS_LOCAL_EXEC_TASK(_job, _task)                                          \
   ((_job)->attr.localExec && SCH_IS_QUERY_JOB(_job) && (!SCH_IS_INSERT_JOB(_job)) && \
    (!SCH_IS_DATA_BIND_QRY_TASK(_task)))
@@ -404,6 +410,8 @@ extern SSchedulerMgmt schMgmt;
   (SCH_REDIRECT_MSGTYPE(_msgType) &&                                                               \
    (NEED_SCHEDULER_REDIRECT_ERROR(_code) || SCH_LOW_LEVEL_NETWORK_ERR((_job), (_task), (_code)) || \
     SCH_TASK_RETRY_NETWORK_ERR((_task), (_code))))
+#define SCH_TASK_NEED_ADMISSION_RETRY(_msgType, _code) \
+  (((_msgType) == TDMT_SCH_QUERY || (_msgType) == TDMT_SCH_MERGE_QUERY) && QUERY_ADMISSION_RETRY_ERROR(_code))
 #define SCH_TASK_NEED_RETRY(_msgType, _code) \
   ((SCH_REDIRECT_MSGTYPE(_msgType) && SCH_NETWORK_ERR(_code)) || (_code) == TSDB_CODE_SCH_TIMEOUT_ERROR)
 
@@ -632,6 +640,7 @@ int32_t  schSwitchJobStatus(SSchJob *pJob, int32_t status, void *param);
 int32_t  schHandleOpBeginEvent(int64_t jobId, SSchJob **job, SCH_OP_TYPE type, SSchedulerReq *pReq);
 int32_t  schHandleOpEndEvent(SSchJob *pJob, SCH_OP_TYPE type, SSchedulerReq *pReq, int32_t errCode);
 int32_t  schHandleTaskRetry(SSchJob *pJob, SSchTask *pTask);
+int32_t  schHandleTaskAdmissionRetry(SSchJob *pJob, SSchTask *pTask, SDataBuf *pData, int32_t rspCode);
 void     schUpdateJobErrCode(SSchJob *pJob, int32_t errCode);
 int32_t  schTaskCheckSetRetry(SSchJob *pJob, SSchTask *pTask, int32_t errCode, bool *needRetry);
 int32_t  schProcessOnJobFailure(SSchJob *pJob, int32_t errCode);
@@ -647,7 +656,7 @@ void     schDirectPostJobRes(SSchedulerReq *pReq, int32_t errCode);
 int32_t  schHandleJobFailure(SSchJob *pJob, int32_t errCode);
 int32_t  schHandleJobDrop(SSchJob *pJob, int32_t errCode);
 bool     schChkCurrentOp(SSchJob *pJob, int32_t op, int8_t sync);
-int32_t  schProcessFetchRsp(SSchJob *pJob, SSchTask *pTask, char *msg, int32_t rspCode);
+int32_t  schProcessFetchRsp(SSchJob *pJob, SSchTask *pTask, char *msg, int32_t msgLen, int32_t rspCode);
 int32_t  schProcessExplainRsp(SSchJob *pJob, SSchTask *pTask, SExplainRsp *rsp);
 int32_t  schHandleJobRetry(SSchJob *pJob, SSchTask *pTask, SDataBuf *pMsg, int32_t rspCode);
 int32_t  schChkResetJobRetry(SSchJob *pJob, int32_t rspCode);
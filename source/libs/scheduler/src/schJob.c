@@ -17,6 +17,7 @@
 #include "command.h"
 #include "query.h"
 #include "schInt.h"
+#include "tglobal.h"
 #include "tmsg.h"
 #include "tref.h"
 #include "trpc.h"
@@ -827,6 +828,8 @@ int32_t schInitJob(int64_t *pJobId, SSchedulerReq *pReq) {
 
   pJob->attr.explainMode = pReq->pDag->explainInfo.mode;
   pJob->attr.localExec = pReq->localReq;
+  pJob->attr.maxFollowerLag = tsQueryMaxFollowerLag;
+  pJob->attr.lowLatency = tsQueryLowLatency;
   pJob->conn = *pReq->pConn;
   if (pReq->sql) {
     pJob->sql = taosStrdup(pReq->sql);
@@ -17,6 +17,7 @@
 #include "command.h"
 #include "query.h"
 #include "schInt.h"
+#include "tdatablock.h"
 #include "tglobal.h"
 #include "tmisce.h"
 #include "tmsg.h"
@@ -75,7 +76,7 @@ int32_t schValidateRspMsgType(SSchJob *pJob, SSchTask *pTask, int32_t msgType) {
   return TSDB_CODE_SUCCESS;
 }
 
-int32_t schProcessFetchRsp(SSchJob *pJob, SSchTask *pTask, char *msg, int32_t rspCode) {
+int32_t schProcessFetchRsp(SSchJob *pJob, SSchTask *pTask, char *msg, int32_t msgLen, int32_t rspCode) {
   SRetrieveTableRsp *rsp = (SRetrieveTableRsp *)msg;
   int32_t code = 0;
   
@@ -112,6 +113,11 @@ int32_t schProcessFetchRsp(SSchJob *pJob, SSchTask *pTask, char *msg, int32_t rs
     SCH_ERR_JRET(TSDB_CODE_SCH_STATUS_ERROR);
   }
   
+  int64_t peakMem = tGetFetchRspPeakMem(rsp, htonl(rsp->compLen), msgLen);
+  if (peakMem > atomic_load_64(&pJob->peakMem)) {
+    (void)atomic_store_64(&pJob->peakMem, peakMem);
+  }
+
   atomic_store_ptr(&pJob->fetchRes, rsp);
   (void)atomic_add_fetch_64(&pJob->resNumOfRows, htobe64(rsp->numOfRows));
   
@@ -413,7 +419,7 @@ int32_t schProcessResponseMsg(SSchJob *pJob, SSchTask *pTask, int32_t execId, SD
     }
     case TDMT_SCH_FETCH_RSP:
     case TDMT_SCH_MERGE_FETCH_RSP: {
-      code = schProcessFetchRsp(pJob, pTask, pMsg->pData, rspCode);
+      code = schProcessFetchRsp(pJob, pTask, pMsg->pData, (int32_t)pMsg->len, rspCode);
       pMsg->pData = NULL;
       SCH_ERR_JRET(code);
       break;
@@ -458,11 +464,14 @@ int32_t schHandleResponseMsg(SSchJob *pJob, SSchTask *pTask, int32_t execId, SDa
   int32_t reqType = IsReq(pMsg) ? pMsg->msgType : (pMsg->msgType - 1);
   if (SCH_JOB_NEED_RETRY(pJob, pTask, reqType, rspCode)) {
     SCH_RET(schHandleJobRetry(pJob, pTask, (SDataBuf *)pMsg, rspCode));
+  } else if (SCH_TASK_NEED_ADMISSION_RETRY(reqType, rspCode)) {
+    SCH_RET(schHandleTaskAdmissionRetry(pJob, pTask, (SDataBuf *)pMsg, rspCode));
   } else if (SCH_TASKSET_NEED_RETRY(pJob, pTask, reqType, rspCode)) {
     SCH_RET(schHandleTaskSetRetry(pJob, pTask, (SDataBuf *)pMsg, rspCode));
   }
 
   pTask->redirectCtx.inRedirect = false;
+  pTask->admitStartTs = 0;
 
   SCH_RET(schProcessResponseMsg(pJob, pTask, execId, pMsg, rspCode));
 
@@ -1180,11 +1189,16 @@ int32_t schBuildAndSendMsg(SSchJob *pJob, SSchTask *pTask, SQueryNodeAddr *addr,
       qMsg.sql = pJob->sql;
       qMsg.msgLen = pTask->msgLen;
       qMsg.msg = pTask->msg;
+      qMsg.maxFollowerLag = (TDMT_SCH_QUERY == msgType && SCH_FOLLOWER_READ_ENABLED(pJob, pTask))
+                                ? pJob->attr.maxFollowerLag
+                                : -1;
+      qMsg.lowLatency = pJob->attr.lowLatency;
 
       if (strcmp(tsLocalFqdn, GET_ACTIVE_EP(&addr->epSet)->fqdn) == 0) {
-        qMsg.compress = 0;
+        qMsg.compress = BLOCK_COMPRESS_NONE;
       } else {
-        qMsg.compress = 1;
+        // servers that do not know the columnar format fall back to LZ4 on any non zero value
+        qMsg.compress = tsQueryColumnarCompress ? BLOCK_COMPRESS_COLUMNAR : BLOCK_COMPRESS_LZ4;
       }
 
       msgSize = tSerializeSSubQueryMsg(NULL, 0, &qMsg);
@@ -1224,6 +1238,7 @@ int32_t schBuildAndSendMsg(SSchJob *pJob, SSchTask *pTask, SQueryNodeAddr *addr,
       req.queryId = pJob->queryId;
       req.taskId = pTask->taskId;
       req.execId = pTask->execId;
+      req.withPeakMem = 1;
 
       msgSize = tSerializeSResFetchReq(NULL, 0, &req);
       if (msgSize < 0) {
@@ -770,6 +770,67 @@ int32_t schHandleTaskRetry(SSchJob *pJob, SSchTask *pTask) {
   return TSDB_CODE_SUCCESS;
 }
 
+int32_t schChkUpdateAdmissionDelay(SSchJob *pJob, SSchTask *pTask, int32_t rspCode) {
+  int64_t nowTs = taosGetTimestampMs();
+  if (0 == pTask->admitStartTs) {
+    pTask->admitStartTs = nowTs;
+    pTask->delayExecMs = tsRedirectPeriod;
+    return TSDB_CODE_SUCCESS;
+  }
+
+  int64_t lastTime = nowTs - pTask->admitStartTs;
+  if (lastTime > tsMaxRetryWaitTime) {
+    SCH_TASK_DLOG("task no more admission retry since timeout, now:%" PRId64 ", start:%" PRId64 ", max:%d", nowTs,
+                  pTask->admitStartTs, tsMaxRetryWaitTime);
+    SCH_ERR_RET(rspCode);
+  }
+
+  int64_t delayMs = (int64_t)pTask->delayExecMs * tsRedirectFactor;
+  if (delayMs > tsRedirectMaxPeriod) {
+    delayMs = tsRedirectMaxPeriod;
+  }
+
+  int64_t leftTime = tsMaxRetryWaitTime - lastTime;
+  pTask->delayExecMs = (int32_t)(leftTime < delayMs ? leftTime : delayMs);
+
+  return TSDB_CODE_SUCCESS;
+}
+
+// The exec node rejects the task until its memory pressure goes down, so the task is launched again on the same
+// node after a growing delay instead of being redirected with its task set.
+int32_t schHandleTaskAdmissionRetry(SSchJob *pJob, SSchTask *pTask, SDataBuf *pData, int32_t rspCode) {
+  int32_t code = 0;
+
+  taosMemoryFreeClear(pData->pData);
+  taosMemoryFreeClear(pData->pEpSet);
+
+  SCH_ERR_JRET(schChkUpdateAdmissionDelay(pJob, pTask, rspCode));
+
+  SCH_TASK_DLOG("task will be launched again on the same node, delayExec:%d, code:%s", pTask->delayExecMs,
+                tstrerror(rspCode));
+
+  (void)atomic_sub_fetch_32(&pTask->level->taskLaunchedNum, 1);
+
+  schDropTaskOnExecNode(pJob, pTask);
+  taosHashClear(pTask->execNodes);
+  (void)schRemoveTaskFromExecList(pJob, pTask);  // ignore error
+  SCH_SET_TASK_STATUS(pTask, JOB_TASK_STATUS_INIT);
+
+  if (SCH_TASK_NEED_FLOW_CTRL(pJob, pTask)) {
+    SCH_ERR_JRET(schLaunchTasksInFlowCtrlList(pJob, pTask));
+  }
+
+  schDeregisterTaskHb(pJob, pTask);
+
+  SCH_ERR_JRET(schDelayLaunchTask(pJob, pTask));
+
+  return TSDB_CODE_SUCCESS;
+
+_return:
+
+  SCH_RET(schProcessOnTaskFailure(pJob, pTask, code));
+}
+
 int32_t schSetAddrsFromNodeList(SSchJob *pJob, SSchTask *pTask) {
   int32_t addNum = 0;
   int32_t nodeNum = 0;
@@ -826,6 +887,16 @@ int32_t schSetTaskCandidateAddrs(SSchJob *pJob, SSchTask *pTask) {
 
     SCH_TASK_DLOG("use execNode in plan as candidate addr, numOfEps:%d", pTask->plan->execNode.epSet.numOfEps);
 
+    if (SCH_FOLLOWER_READ_ENABLED(pJob, pTask)) {
+      SQueryNodeAddr *addr = taosArrayGet(pTask->candidateAddrs, 0);
+      if (addr && addr->epSet.numOfEps > 1) {
+        // spread tasks over all replicas, a too stale follower will redirect the task to the leader
+        addr->epSet.inUse = taosRand() % addr->epSet.numOfEps;
+        SCH_TASK_DLOG("follower read enabled, maxLag:%d, use ep %d/%d", pJob->attr.maxFollowerLag,
+                      addr->epSet.inUse, addr->epSet.numOfEps);
+      }
+    }
+
     return TSDB_CODE_SUCCESS;
   }
 
@@ -1135,6 +1206,7 @@ int32_t schLaunchLocalTask(SSchJob *pJob, SSchTask *pTask) {
   qwMsg.msgInfo.taskType = TASK_TYPE_TEMP;
   qwMsg.msgInfo.explain = SCH_IS_EXPLAIN_JOB(pJob);
   qwMsg.msgInfo.needFetch = SCH_TASK_NEED_FETCH(pTask);
+  qwMsg.msgInfo.lowLatency = pJob->attr.lowLatency;
   qwMsg.msg = pTask->plan;
   qwMsg.msgType = pTask->plan->msgType;
   qwMsg.connInfo.handle = pJob->conn.pTrans;
@@ -1415,7 +1487,12 @@ int32_t schExecLocalFetch(SSchJob *pJob, SSchTask *pTask) {
     explainRes = NULL;
   }
 
-  SCH_ERR_RET(schProcessFetchRsp(pJob, pTask, pRsp, TSDB_CODE_SUCCESS));
+  // a local rsp always carries the peak memory trailer
+  int32_t rspLen = 0;
+  if (pRsp) {
+    rspLen = sizeof(SRetrieveTableRsp) + htonl(((SRetrieveTableRsp *)pRsp)->compLen) + FETCH_RSP_PEAK_MEM_LEN;
+  }
+  SCH_ERR_RET(schProcessFetchRsp(pJob, pTask, pRsp, rspLen, TSDB_CODE_SUCCESS));
 
 _return:
 
@@ -136,6 +136,20 @@ _return:
   SCH_RET(schHandleOpEndEvent(pJob, SCH_OP_GET_STATUS, NULL, code));
 }
 
+// the max peak memory reported by the fetch rsps of the job so far, 0 if the job is gone
+int64_t schedulerGetJobPeakMem(int64_t jobId) {
+  SSchJob *pJob = NULL;
+  (void)schAcquireJob(jobId, &pJob);
+  if (NULL == pJob) {
+    return 0;
+  }
+
+  int64_t peakMem = atomic_load_64(&pJob->peakMem);
+  (void)schReleaseJob(jobId);
+
+  return peakMem;
+}
+
 void schedulerStopQueryHb(void *pTrans) {
   if (NULL == pTrans) {
     return;
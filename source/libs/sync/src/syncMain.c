@@ -578,6 +578,60 @@ bool syncIsReadyForRead(int64_t rid) {
   return ready;
 }
 
+bool syncNodeIsReadyForStaleRead(SSyncNode* pSyncNode, int64_t maxLag) {
+  if (pSyncNode == NULL) {
+    terrno = TSDB_CODE_SYN_INTERNAL_ERROR;
+    sError("sync ready for stale read error");
+    return false;
+  }
+
+  if (pSyncNode->state != TAOS_SYNC_STATE_FOLLOWER && pSyncNode->state != TAOS_SYNC_STATE_LEARNER) {
+    terrno = TSDB_CODE_SYN_NOT_LEADER;
+    return false;
+  }
+
+  // without a known leader the replicated index can't be trusted
+  if (pSyncNode->leaderCache.addr == 0 || pSyncNode->pLogBuf == NULL) {
+    terrno = TSDB_CODE_SYN_NOT_LEADER;
+    return false;
+  }
+
+  // a follower cut off from the leader can't tell how far behind it is
+  int64_t recvTime = syncIndexMgrGetRecvTime(pSyncNode->pNextIndex, &pSyncNode->leaderCache);
+  int64_t lease = (int64_t)SYNC_STALE_READ_LEASE_HBS * pSyncNode->heartbeatTimerMS;
+  int64_t elapsed = taosGetTimestampMs() - recvTime;
+  if (recvTime <= 0 || elapsed > lease) {
+    sTrace("vgId:%d, not ready for stale read, no heartbeat from leader in %" PRId64 "ms, lease:%" PRId64 "ms",
+           pSyncNode->vgId, elapsed, lease);
+    terrno = TSDB_CODE_SYN_NOT_LEADER;
+    return false;
+  }
+
+  SyncIndex lastIndex = TMAX(pSyncNode->commitIndex, pSyncNode->pLogBuf->matchIndex);
+  SyncIndex appliedIndex = pSyncNode->pFsm->FpAppliedIndexCb(pSyncNode->pFsm);
+  if (lastIndex - appliedIndex > maxLag) {
+    sTrace("vgId:%d, not ready for stale read, last index:%" PRId64 ", applied index:%" PRId64 ", max lag:%" PRId64,
+           pSyncNode->vgId, lastIndex, appliedIndex, maxLag);
+    terrno = TSDB_CODE_SYN_NOT_LEADER;
+    return false;
+  }
+
+  return true;
+}
+
+bool syncIsReadyForStaleRead(int64_t rid, int64_t maxLag) {
+  SSyncNode* pSyncNode = syncNodeAcquire(rid);
+  if (pSyncNode == NULL) {
+    sError("sync ready for stale read error");
+    return false;
+  }
+
+  bool ready = syncNodeIsReadyForStaleRead(pSyncNode, maxLag);
+
+  syncNodeRelease(pSyncNode);
+  return ready;
+}
+
 #ifdef BUILD_NO_CALL
 bool syncSnapshotSending(int64_t rid) {
   SSyncNode* pSyncNode = syncNodeAcquire(rid);
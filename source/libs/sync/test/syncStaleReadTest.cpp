@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include "syncIndexMgr.h"
+#include "syncInt.h"
+#include "syncPipeline.h"
+#include "syncUtil.h"
+
+namespace {
+
+int32_t   replicaNum = 3;
+SyncIndex appliedIndex = 0;
+
+SyncIndex appliedIndexCb(const SSyncFSM* pFsm) { return appliedIndex; }
+
+class SyncStaleReadTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    memset(&node, 0, sizeof(node));
+    memset(&fsm, 0, sizeof(fsm));
+    memset(&logBuf, 0, sizeof(logBuf));
+
+    node.vgId = 1234;
+    node.replicaNum = replicaNum;
+    node.totalReplicaNum = replicaNum;
+    for (int32_t i = 0; i < replicaNum; ++i) {
+      SNodeInfo info = {.clusterId = 1, .nodeId = i + 1};
+      node.replicasId[i].addr = SYNC_ADDR(&info);
+      node.replicasId[i].vgId = node.vgId;
+    }
+    node.myRaftId = node.replicasId[1];
+    node.leaderCache = node.replicasId[0];
+    node.state = TAOS_SYNC_STATE_FOLLOWER;
+    node.heartbeatTimerMS = 1000;
+    node.commitIndex = 100;
+
+    fsm.FpAppliedIndexCb = appliedIndexCb;
+    node.pFsm = &fsm;
+    logBuf.matchIndex = 100;
+    node.pLogBuf = &logBuf;
+
+    node.pNextIndex = syncIndexMgrCreate(&node);
+    ASSERT_NE(node.pNextIndex, nullptr);
+    appliedIndex = 100;
+  }
+
+  void TearDown() override { syncIndexMgrDestroy(node.pNextIndex); }
+
+  void leaderHeartbeatAgo(int64_t ms) {
+    syncIndexMgrSetRecvTime(node.pNextIndex, &node.leaderCache, taosGetTimestampMs() - ms);
+  }
+
+  SSyncNode      node;
+  SSyncFSM       fsm;
+  SSyncLogBuffer logBuf;
+};
+
+}  // namespace
+
+TEST_F(SyncStaleReadTest, recentLeaderHeartbeat) {
+  leaderHeartbeatAgo(0);
+  ASSERT_TRUE(syncNodeIsReadyForStaleRead(&node, 0));
+
+  appliedIndex = 90;
+  ASSERT_FALSE(syncNodeIsReadyForStaleRead(&node, 5));
+  ASSERT_TRUE(syncNodeIsReadyForStaleRead(&node, 10));
+}
+
+TEST_F(SyncStaleReadTest, partitionedFollower) {
+  // the follower still remembers the leader, but has not heard from it since the partition
+  leaderHeartbeatAgo(SYNC_STALE_READ_LEASE_HBS * node.heartbeatTimerMS + 1000);
+  ASSERT_FALSE(syncNodeIsReadyForStaleRead(&node, 0));
+  ASSERT_FALSE(syncNodeIsReadyForStaleRead(&node, INT64_MAX));
+
+  // back in contact
+  leaderHeartbeatAgo(0);
+  ASSERT_TRUE(syncNodeIsReadyForStaleRead(&node, INT64_MAX));
+}
+
+TEST_F(SyncStaleReadTest, noLeaderOrNotFollower) {
+  leaderHeartbeatAgo(0);
+
+  node.state = TAOS_SYNC_STATE_CANDIDATE;
+  ASSERT_FALSE(syncNodeIsReadyForStaleRead(&node, INT64_MAX));
+
+  node.state = TAOS_SYNC_STATE_FOLLOWER;
+  memset(&node.leaderCache, 0, sizeof(node.leaderCache));
+  ASSERT_FALSE(syncNodeIsReadyForStaleRead(&node, INT64_MAX));
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define _DEFAULT_SOURCE
+#include "tmembudget.h"
+
+static void memBudgetUpdatePeak(SMemBudget *pBudget, int64_t used) {
+  int64_t peak = atomic_load_64(&pBudget->peak);
+  while (used > peak) {
+    int64_t old = atomic_val_compare_exchange_64(&pBudget->peak, peak, used);
+    if (old == peak) {
+      break;
+    }
+    peak = old;
+  }
+}
+
+void memBudgetInit(SMemBudget *pBudget, int64_t limit, SMemBudget *pParent) {
+  pBudget->limit = limit;
+  pBudget->used = 0;
+  pBudget->peak = 0;
+  pBudget->pParent = pParent;
+}
+
+bool memBudgetTryAcquire(SMemBudget *pBudget, int64_t size) {
+  SMemBudget *p = pBudget;
+  for (; p != NULL; p = p->pParent) {
+    int64_t limit = atomic_load_64(&p->limit);
+    int64_t used = atomic_add_fetch_64(&p->used, size);
+    if (limit > 0 && used > limit) {
+      break;
+    }
+    memBudgetUpdatePeak(p, used);
+  }
+
+  if (p == NULL) {
+    return true;
+  }
+
+  // roll back the levels acquired so far, including the one exceeding its limit
+  for (SMemBudget *q = pBudget; q != p->pParent; q = q->pParent) {
+    (void)atomic_sub_fetch_64(&q->used, size);
+  }
+  return false;
+}
+
+void memBudgetAcquire(SMemBudget *pBudget, int64_t size) {
+  for (SMemBudget *p = pBudget; p != NULL; p = p->pParent) {
+    memBudgetUpdatePeak(p, atomic_add_fetch_64(&p->used, size));
+  }
+}
+
+void memBudgetRelease(SMemBudget *pBudget, int64_t size) {
+  for (SMemBudget *p = pBudget; p != NULL; p = p->pParent) {
+    (void)atomic_sub_fetch_64(&p->used, size);
+  }
+}
+
+int64_t memBudgetGetUsed(const SMemBudget *pBudget) {
+  return (pBudget == NULL) ? 0 : atomic_load_64((int64_t *)&pBudget->used);
+}
+
+int64_t memBudgetGetPeak(const SMemBudget *pBudget) {
+  return (pBudget == NULL) ? 0 : atomic_load_64((int64_t *)&pBudget->peak);
+}
+
+double memBudgetGetUsage(const SMemBudget *pBudget) {
+  if (pBudget == NULL) {
+    return 0;
+  }
+
+  int64_t limit = atomic_load_64((int64_t *)&pBudget->limit);
+  return (limit <= 0) ? 0 : (double)atomic_load_64((int64_t *)&pBudget->used) / limit;
+}
@@ -49,8 +49,16 @@ struct SDiskbasedBuf {
   char*               id;           // for debug purpose
   bool                printStatis;  // Print statistics info when closing this buffer.
   SDiskbasedBufStatis statis;
+  SMemBudget*         pBudget;  // in-memory pages are charged to it, pages are spilled once it is used up
 };
 
+static void freeBufPageData(SDiskbasedBuf* pBuf, void** ppData) {
+  if (*ppData != NULL) {
+    memBudgetRelease(pBuf->pBudget, pBuf->pageSize);
+    taosMemoryFreeClear(*ppData);
+  }
+}
+
 static int32_t createDiskFile(SDiskbasedBuf* pBuf) {
   if (pBuf->path == NULL) {  // prepare the file name when needed it
     char path[PATH_MAX] = {0};
@@ -420,12 +428,25 @@ static char* doExtractPage(SDiskbasedBuf* pBuf) {
       uWarn("no available buf pages, current:%d, max:%d, reason: %s, %s", listNEles(pBuf->lruList), pBuf->inMemPages,
             terrstr(), pBuf->id)
     }
-  } else {
-    availablePage =
-        taosMemoryCalloc(1, getAllocPageSize(pBuf->pageSize));  // add extract bytes in case of zipped buffer increased.
-    if (availablePage == NULL) {
-      terrno = TSDB_CODE_OUT_OF_MEMORY;
+
+    return availablePage;
+  }
+
+  // at least 2 pages are kept in memory. Beyond that, once the budget is used up, an unreferenced in-memory page is
+  // flushed to disk and reused, if there is none the budget is exceeded.
+  if (listNEles(pBuf->lruList) < 2 || !memBudgetTryAcquire(pBuf->pBudget, pBuf->pageSize)) {
+    if (listNEles(pBuf->lruList) >= 2 && getEldestUnrefedPage(pBuf) != NULL) {
+      return evictBufPage(pBuf);
     }
+
+    memBudgetAcquire(pBuf->pBudget, pBuf->pageSize);
+  }
+
+  availablePage =
+      taosMemoryCalloc(1, getAllocPageSize(pBuf->pageSize));  // add extract bytes in case of zipped buffer increased.
+  if (availablePage == NULL) {
+    memBudgetRelease(pBuf->pBudget, pBuf->pageSize);
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
   }
 
   return availablePage;
@@ -450,7 +471,7 @@ void* getNewBufPage(SDiskbasedBuf* pBuf, int32_t* pageId) {
     code = lruListPushFront(pBuf->lruList, pi);
     if (TSDB_CODE_SUCCESS != code) {
       taosMemoryFree(pi);
-      taosMemoryFree(availablePage);
+      freeBufPageData(pBuf, (void**)&availablePage);
       terrno = code;
       return NULL;
     }
@@ -461,7 +482,7 @@ void* getNewBufPage(SDiskbasedBuf* pBuf, int32_t* pageId) {
     // register page id info
     pi = registerNewPageInfo(pBuf, *pageId);
     if (pi == NULL) {
-      taosMemoryFree(availablePage);
+      freeBufPageData(pBuf, (void**)&availablePage);
       return NULL;
     }
 
@@ -475,7 +496,7 @@ void* getNewBufPage(SDiskbasedBuf* pBuf, int32_t* pageId) {
     if (TSDB_CODE_SUCCESS == code) {
       pBuf->totalBufSize += pBuf->pageSize;
     } else {
-      taosMemoryFree(availablePage);
+      freeBufPageData(pBuf, (void**)&availablePage);
       SPageInfo **pLast = taosArrayPop(pBuf->pIdList);
       int32_t ret = tSimpleHashRemove(pBuf->all, pageId, sizeof(int32_t));
       if (ret != TSDB_CODE_SUCCESS) {
@@ -548,8 +569,7 @@ void* getBufPage(SDiskbasedBuf* pBuf, int32_t id) {
 
     int32_t code = lruListPushFront(pBuf->lruList, *pi);
     if (TSDB_CODE_SUCCESS != code) {
-      taosMemoryFree((*pi)->pData);
-      (*pi)->pData = NULL;
+      freeBufPageData(pBuf, &(*pi)->pData);
       terrno = code;
       return NULL;
     }
@@ -559,8 +579,7 @@ void* getBufPage(SDiskbasedBuf* pBuf, int32_t id) {
     if (HAS_DATA_IN_DISK(*pi)) {
       int32_t code = loadPageFromDisk(pBuf, *pi);
       if (code != 0) {
-        taosMemoryFree((*pi)->pData);
-        (*pi)->pData = NULL;
+        freeBufPageData(pBuf, &(*pi)->pData);
         terrno = code;
         return NULL;
       }
@@ -653,7 +672,7 @@ void destroyDiskbasedBuf(SDiskbasedBuf* pBuf) {
   size_t n = taosArrayGetSize(pBuf->pIdList);
   for (int32_t i = 0; i < n; ++i) {
     SPageInfo* pi = taosArrayGetP(pBuf->pIdList, i);
-    taosMemoryFreeClear(pi->pData);
+    freeBufPageData(pBuf, &pi->pData);
     taosMemoryFreeClear(pi);
   }
 
@@ -702,6 +721,18 @@ int32_t setBufPageCompressOnDisk(SDiskbasedBuf* pBuf, bool comp) {
   return TSDB_CODE_SUCCESS;
 }
 
+void setBufPageMemBudget(SDiskbasedBuf* pBuf, SMemBudget* pBudget) {
+  if (pBuf == NULL) {
+    return;
+  }
+
+  // the pages allocated so far are moved to the new budget
+  int64_t size = (int64_t)listNEles(pBuf->lruList) * pBuf->pageSize;
+  memBudgetRelease(pBuf->pBudget, size);
+  memBudgetAcquire(pBudget, size);
+  pBuf->pBudget = pBudget;
+}
+
 int32_t dBufSetBufPageRecycled(SDiskbasedBuf* pBuf, void* pPage) {
   SPageInfo* ppi = getPageInfoFromPayload(pPage);
 
@@ -715,7 +746,7 @@ int32_t dBufSetBufPageRecycled(SDiskbasedBuf* pBuf, void* pPage) {
 
   // add this pageinfo into the free page info list
   SListNode* pNode = tdListPopNode(pBuf->lruList, ppi->pn);
-  taosMemoryFreeClear(ppi->pData);
+  freeBufPageData(pBuf, &ppi->pData);
   taosMemoryFreeClear(pNode);
   ppi->pn = NULL;
   return TSDB_CODE_SUCCESS;
@@ -755,7 +786,7 @@ void clearDiskbasedBuf(SDiskbasedBuf* pBuf) {
   size_t n = taosArrayGetSize(pBuf->pIdList);
   for (int32_t i = 0; i < n; ++i) {
     SPageInfo* pi = taosArrayGetP(pBuf->pIdList, i);
-    taosMemoryFreeClear(pi->pData);
+    freeBufPageData(pBuf, &pi->pData);
     taosMemoryFreeClear(pi);
   }
 
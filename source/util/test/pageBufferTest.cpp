@@ -220,6 +220,55 @@ void testFlushAndReadBackBuffer() {
   taosMemoryFree(rowData);
 }
 
+void memBudgetSpillTest() {
+  SMemBudget node = {0};
+  SMemBudget task = {0};
+  memBudgetInit(&node, 0, NULL);
+  memBudgetInit(&task, 3 * 4096, &node);
+
+  SDiskbasedBuf* pBuf = NULL;
+  int32_t        ret = createDiskbasedBuf(&pBuf, 4096, 4096 * 16, "", TD_TMP_DIR_PATH);
+  ASSERT_EQ(ret, 0);
+  setBufPageMemBudget(pBuf, &task);
+
+  int32_t pageIds[10] = {0};
+  for (int32_t i = 0; i < 10; ++i) {
+    SFilePage* pPg = (SFilePage*)getNewBufPage(pBuf, &pageIds[i]);
+    ASSERT_TRUE(pPg != NULL);
+    pPg->num = i + 1;
+    setBufPageDirty(pPg, true);
+    releaseBufPage(pBuf, pPg);
+
+    // the pages beyond the budget are spilled instead of allocated
+    ASSERT_LE(memBudgetGetUsed(&task), 3 * 4096);
+    ASSERT_EQ(memBudgetGetUsed(&node), memBudgetGetUsed(&task));
+  }
+
+  ASSERT_EQ(memBudgetGetPeak(&task), 3 * 4096);
+  ASSERT_TRUE(isAllDataInMemBuf(pBuf) == false);
+
+  for (int32_t i = 0; i < 10; ++i) {
+    SFilePage* pPg = (SFilePage*)getBufPage(pBuf, pageIds[i]);
+    ASSERT_TRUE(pPg != NULL);
+    ASSERT_EQ(pPg->num, i + 1);
+    releaseBufPage(pBuf, pPg);
+  }
+
+  destroyDiskbasedBuf(pBuf);
+  ASSERT_EQ(memBudgetGetUsed(&task), 0);
+  ASSERT_EQ(memBudgetGetUsed(&node), 0);
+
+  // a child budget is limited by its parent
+  memBudgetInit(&node, 4096, NULL);
+  memBudgetInit(&task, 0, &node);
+  ASSERT_TRUE(memBudgetTryAcquire(&task, 4096));
+  ASSERT_FALSE(memBudgetTryAcquire(&task, 1));
+  ASSERT_EQ(memBudgetGetUsed(&task), 4096);
+  ASSERT_DOUBLE_EQ(memBudgetGetUsage(&node), 1.0);
+  memBudgetRelease(&task, 4096);
+  ASSERT_EQ(memBudgetGetUsed(&node), 0);
+}
+
 }  // namespace
 
 TEST(testCase, resultBufferTest) {
@@ -228,6 +277,7 @@ TEST(testCase, resultBufferTest) {
   writeDownTest();
   recyclePageTest();
   testFlushAndReadBackBuffer();
+  memBudgetSpillTest();
 }
 
 #pragma GCC diagnostic pop
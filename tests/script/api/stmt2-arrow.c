@@ -0,0 +1,199 @@
+// bind rows of a child table with taos_stmt2_bind_arrow and check them back with a query
+// columns with no null, some nulls and only nulls are bound, for both fixed and variable width types
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "taos.h"
+
+#define ROWS 6
+#define COLS 5
+
+static int failed = 0;
+
+#define CHECK(_expr, ...)          \
+  do {                             \
+    if (!(_expr)) {                \
+      printf("check failed: ");    \
+      printf(__VA_ARGS__);         \
+      printf("\n");                \
+      failed = 1;                  \
+    }                              \
+  } while (0)
+
+void do_query(TAOS* taos, const char* sql) {
+  TAOS_RES* result = taos_query(taos, sql);
+  int       code = taos_errno(result);
+  if (code) {
+    printf("failed to query: %s, reason:%s\n", sql, taos_errstr(result));
+    taos_free_result(result);
+    exit(1);
+  }
+  taos_free_result(result);
+}
+
+static void init_array(struct ArrowArray* pArray, int64_t nullCount, int64_t nBuffers, const void** buffers) {
+  memset(pArray, 0, sizeof(*pArray));
+  pArray->length = ROWS;
+  pArray->null_count = nullCount;
+  pArray->n_buffers = nBuffers;
+  pArray->buffers = buffers;
+}
+
+static void init_schema(struct ArrowSchema* pSchema, const char* format, const char* name) {
+  memset(pSchema, 0, sizeof(*pSchema));
+  pSchema->format = format;
+  pSchema->name = name;
+  pSchema->flags = ARROW_FLAG_NULLABLE;
+}
+
+// the rows expected back
+static int64_t     gTs[ROWS];
+static int32_t     gInt[ROWS] = {10, 0, -30, 0, 50, 60};
+static const char  gIntNull[ROWS] = {0, 1, 0, 1, 0, 0};
+static double      gDouble[ROWS] = {1.5, -2.25, 3.0, 0, 1e10, -7.125};
+static const char* gBinary[ROWS] = {"a", NULL, "", "abcdefghij", NULL, "xyz"};
+
+void do_stmt(TAOS* taos) {
+  do_query(taos, "drop database if exists arrow_db");
+  do_query(taos, "create database arrow_db");
+  do_query(taos, "create table arrow_db.stb (ts timestamp, i int, d double, b binary(32), nn int) tags(t int)");
+
+  for (int i = 0; i < ROWS; ++i) {
+    gTs[i] = 1591060628000LL + i;
+  }
+
+  // validity bitmaps, least significant bit first, a set bit is a value
+  uint8_t intValid = 0, binaryValid = 0, noneValid = 0;
+  for (int i = 0; i < ROWS; ++i) {
+    if (!gIntNull[i]) intValid |= (uint8_t)(1 << i);
+    if (gBinary[i]) binaryValid |= (uint8_t)(1 << i);
+  }
+
+  // the null slot of row 4 owns bytes, which must be skipped
+  char    binaryData[64] = {0};
+  int32_t binaryOffsets[ROWS + 1] = {0};
+  int32_t pos = 0;
+  for (int i = 0; i < ROWS; ++i) {
+    const char* v = gBinary[i] ? gBinary[i] : (i == 4 ? "junk" : "");
+    memcpy(binaryData + pos, v, strlen(v));
+    pos += (int32_t)strlen(v);
+    binaryOffsets[i + 1] = pos;
+  }
+  int32_t noneData[ROWS] = {0};
+
+  const void* tsBufs[2] = {NULL, gTs};
+  const void* intBufs[2] = {&intValid, gInt};
+  const void* doubleBufs[2] = {NULL, gDouble};
+  const void* binaryBufs[3] = {&binaryValid, binaryOffsets, binaryData};
+  const void* noneBufs[2] = {&noneValid, noneData};
+  const void* structBufs[1] = {NULL};
+
+  struct ArrowSchema  schemas[COLS], root;
+  struct ArrowArray   arrays[COLS], rootArray;
+  struct ArrowSchema* schemaChildren[COLS];
+  struct ArrowArray*  arrayChildren[COLS];
+  init_schema(&schemas[0], "tsm:", "ts");
+  init_schema(&schemas[1], "i", "i");
+  init_schema(&schemas[2], "g", "d");
+  init_schema(&schemas[3], "u", "b");
+  init_schema(&schemas[4], "i", "nn");
+  init_array(&arrays[0], 0, 2, tsBufs);
+  init_array(&arrays[1], 2, 2, intBufs);
+  init_array(&arrays[2], 0, 2, doubleBufs);
+  init_array(&arrays[3], 2, 3, binaryBufs);
+  init_array(&arrays[4], ROWS, 2, noneBufs);
+  for (int i = 0; i < COLS; ++i) {
+    schemaChildren[i] = &schemas[i];
+    arrayChildren[i] = &arrays[i];
+  }
+  init_schema(&root, "+s", "");
+  root.n_children = COLS;
+  root.children = schemaChildren;
+  init_array(&rootArray, 0, 1, structBufs);
+  rootArray.n_children = COLS;
+  rootArray.children = arrayChildren;
+
+  int                    t = 1;
+  char*                  tbs[1] = {"tb"};
+  TAOS_STMT2_BIND        tag = {TSDB_DATA_TYPE_INT, &t, NULL, NULL, 1};
+  TAOS_STMT2_BIND*       tags[1] = {&tag};
+  struct ArrowArray*     rows[1] = {&rootArray};
+  TAOS_STMT2_ARROW_BINDV bindv = {1, tbs, tags, &root, rows};
+
+  TAOS_STMT2_OPTION option = {0, true, false, NULL, NULL};
+  TAOS_STMT2*       stmt = taos_stmt2_init(taos, &option);
+  const char*       sql = "insert into arrow_db.? using arrow_db.stb tags(?) values(?,?,?,?,?)";
+  if (taos_stmt2_prepare(stmt, sql, 0) != 0) {
+    printf("failed to execute taos_stmt2_prepare. error:%s\n", taos_stmt2_error(stmt));
+    exit(1);
+  }
+  if (taos_stmt2_bind_arrow(stmt, &bindv) != 0) {
+    printf("failed to execute taos_stmt2_bind_arrow. error:%s\n", taos_stmt2_error(stmt));
+    exit(1);
+  }
+  int affected = 0;
+  if (taos_stmt2_exec(stmt, &affected) != 0) {
+    printf("failed to execute insert statement. error:%s\n", taos_stmt2_error(stmt));
+    exit(1);
+  }
+  CHECK(affected == ROWS, "affected rows %d", affected);
+  taos_stmt2_close(stmt);
+}
+
+void check_rows(TAOS* taos) {
+  TAOS_RES* res = taos_query(taos, "select ts, i, d, b, nn from arrow_db.tb order by ts");
+  if (taos_errno(res)) {
+    printf("failed to query, reason:%s\n", taos_errstr(res));
+    exit(1);
+  }
+
+  TAOS_ROW row = NULL;
+  int      r = 0;
+  while ((row = taos_fetch_row(res)) != NULL) {
+    int* lengths = taos_fetch_lengths(res);
+    if (r >= ROWS) {
+      r++;
+      continue;
+    }
+
+    CHECK(row[0] && *(int64_t*)row[0] == gTs[r], "ts of row %d", r);
+    if (gIntNull[r]) {
+      CHECK(row[1] == NULL, "i of row %d is not null", r);
+    } else {
+      CHECK(row[1] && *(int32_t*)row[1] == gInt[r], "i of row %d", r);
+    }
+    CHECK(row[2] && *(double*)row[2] == gDouble[r], "d of row %d", r);
+    if (gBinary[r] == NULL) {
+      CHECK(row[3] == NULL, "b of row %d is not null", r);
+    } else {
+      CHECK(row[3] && lengths[3] == (int)strlen(gBinary[r]) && 0 == memcmp(row[3], gBinary[r], lengths[3]),
+            "b of row %d", r);
+    }
+    CHECK(row[4] == NULL, "nn of row %d is not null", r);
+    r++;
+  }
+  CHECK(r == ROWS, "%d rows read", r);
+  taos_free_result(res);
+}
+
+int main() {
+  TAOS* taos = taos_connect("localhost", "root", "taosdata", "", 0);
+  if (!taos) {
+    printf("failed to connect to db, reason:%s\n", taos_errstr(taos));
+    exit(1);
+  }
+
+  do_stmt(taos);
+  check_rows(taos);
+  taos_close(taos);
+  taos_cleanup();
+
+  if (failed) {
+    printf("stmt2 arrow test failed\n");
+    exit(1);
+  }
+  printf("stmt2 arrow test passed\n");
+  return 0;
+}